@@ -0,0 +1,148 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark compares the broad-phase queries of the dynamic AABB tree and of the wide AABB
+ * tree (WorldSettings::isWideAABBTreeEnabled). It measures the throughput of the world raycasts
+ * in a large scene and the time of the world updates where many bodies move without contacts.
+ *
+ * Usage: broadphasequeriesbenchmark [nbBodies] [nbRays] [nbSteps]
+ */
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Raycast callback that only keeps the closest hit
+class ClosestHitCallback : public RaycastCallback {
+
+    public:
+
+        uint32 nbHits = 0;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            nbHits++;
+            return info.hitFraction;
+        }
+};
+
+// State of the pseudo-random number generator
+static uint32 randomState = 12345;
+
+// Return a pseudo-random number in [min, max]
+decimal random(decimal min, decimal max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (max - min) * decimal(randomState >> 8) / decimal(1u << 24);
+}
+
+// Run the benchmark with a given broad-phase tree
+void runBenchmark(bool isWideAABBTreeEnabled, uint32 nbBodies, uint32 nbRays, uint32 nbSteps) {
+
+    randomState = 12345;
+
+    PhysicsCommon physicsCommon;
+
+    PhysicsWorld::WorldSettings settings;
+    settings.isWideAABBTreeEnabled = isWideAABBTreeEnabled;
+    settings.isSleepingEnabled = false;
+    PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+    world->setIsGravityEnabled(false);
+
+    BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+    SphereShape* sphereShape = physicsCommon.createSphereShape(decimal(0.5));
+
+    // Scatter bodies in a large cube (half of them are moving)
+    const decimal size = decimal(2.0) * std::cbrt(decimal(nbBodies));
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        const Vector3 position(random(-size, size), random(-size, size), random(-size, size));
+        RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+        if (i % 2 == 0) {
+            body->setType(BodyType::STATIC);
+            body->addCollider(boxShape, Transform::identity());
+        }
+        else {
+            body->addCollider(sphereShape, Transform::identity());
+            body->setLinearVelocity(Vector3(random(-2, 2), random(-2, 2), random(-2, 2)));
+        }
+    }
+
+    const decimal timeStep = decimal(1.0) / decimal(60.0);
+    world->update(timeStep);
+
+    // World updates
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint32 s=0; s < nbSteps; s++) {
+        world->update(timeStep);
+    }
+    const std::chrono::duration<double> updateTime = std::chrono::steady_clock::now() - startTime;
+
+    // Raycasts
+    std::vector<Ray> rays;
+    for (uint32 r=0; r < nbRays; r++) {
+        rays.push_back(Ray(Vector3(random(-size, size), random(-size, size), random(-size, size)),
+                           Vector3(random(-size, size), random(-size, size), random(-size, size))));
+    }
+
+    ClosestHitCallback callback;
+    startTime = std::chrono::steady_clock::now();
+    for (uint32 r=0; r < nbRays; r++) {
+        world->raycast(rays[r], &callback);
+    }
+    const std::chrono::duration<double> raycastTime = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << std::setw(14) << (isWideAABBTreeEnabled ? "Wide tree" : "Binary tree")
+              << std::setw(16) << std::fixed << std::setprecision(3) << 1000.0 * updateTime.count() / nbSteps
+              << std::setw(16) << std::setprecision(1) << nbRays / raycastTime.count()
+              << std::setw(10) << callback.nbHits << std::endl;
+
+    physicsCommon.destroyPhysicsWorld(world);
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 nbBodies = argc > 1 ? uint32(std::atoi(argv[1])) : 20000;
+    const uint32 nbRays = argc > 2 ? uint32(std::atoi(argv[2])) : 100000;
+    const uint32 nbSteps = argc > 3 ? uint32(std::atoi(argv[3])) : 60;
+
+    std::cout << "Bodies: " << nbBodies << ", rays: " << nbRays << ", steps: " << nbSteps
+              << ", SIMD lanes: " << SimdDecimal::NB_LANES << std::endl;
+    std::cout << std::setw(14) << "Tree" << std::setw(16) << "Update (ms)" << std::setw(16) << "Raycasts/s" << std::setw(10) << "Hits" << std::endl;
+
+    runBenchmark(false, nbBodies, nbRays, nbSteps);
+    runBenchmark(true, nbBodies, nbRays, nbSteps);
+
+    return 0;
+}
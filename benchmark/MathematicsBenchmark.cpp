@@ -0,0 +1,128 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark measures the throughput of the hot operations of the mathematics classes
+ * (transform composition, quaternion rotation, matrix product and inverse, cross and dot
+ * products). Compile the library with and without the RP3D_SIMD_ENABLED option to compare
+ * the SIMD operations with the scalar operations.
+ *
+ * Usage: mathematicsbenchmark [nbItems] [nbRepetitions]
+ */
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// State of the pseudo-random number generator
+static uint32 randomState = 12345;
+
+// Return a pseudo-random number in [min, max]
+decimal random(decimal min, decimal max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (max - min) * decimal(randomState >> 8) / decimal(1u << 24);
+}
+
+// Run an operation on all the items several times and print the number of operations per second
+template<typename Operation>
+void runBenchmark(const char* name, uint32 nbItems, uint32 nbRepetitions, Operation operation) {
+
+    decimal checksum = 0;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (uint32 r=0; r < nbRepetitions; r++) {
+        for (uint32 i=0; i < nbItems; i++) {
+            checksum += operation(i);
+        }
+    }
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - startTime;
+
+    // The checksum is printed so that the operations are not removed by the compiler
+    std::cout << std::setw(24) << name << std::setw(16) << std::fixed << std::setprecision(1)
+              << 1e-6 * double(nbItems) * nbRepetitions / time.count() << std::setw(16) << std::setprecision(3) << checksum << std::endl;
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 nbItems = argc > 1 ? uint32(std::atoi(argv[1])) : 4096;
+    const uint32 nbRepetitions = argc > 2 ? uint32(std::atoi(argv[2])) : 2000;
+
+    std::vector<Vector3> vectors;
+    std::vector<Quaternion> quaternions;
+    std::vector<Transform> transforms;
+    std::vector<Matrix3x3> matrices;
+    for (uint32 i=0; i < nbItems + 1; i++) {
+        vectors.push_back(Vector3(random(-10, 10), random(-10, 10), random(-10, 10)));
+        Quaternion quaternion(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+        quaternion.normalize();
+        quaternions.push_back(quaternion);
+        transforms.push_back(Transform(vectors[i], quaternion));
+        matrices.push_back(quaternion.getMatrix() * decimal(2.0) + Matrix3x3::identity());
+    }
+
+#ifdef IS_RP3D_SIMD_ENABLED
+    std::cout << "SIMD operations: enabled";
+#else
+    std::cout << "SIMD operations: disabled";
+#endif
+    std::cout << ", items: " << nbItems << ", repetitions: " << nbRepetitions << ", decimal bytes: " << sizeof(decimal) << std::endl;
+    std::cout << std::setw(24) << "Operation" << std::setw(16) << "Mops/s" << std::setw(16) << "Checksum" << std::endl;
+
+    runBenchmark("Transform composition", nbItems, nbRepetitions, [&](uint32 i) {
+        const Transform transform = transforms[i] * transforms[i + 1];
+        return transform.getPosition().x + transform.getOrientation().w;
+    });
+    runBenchmark("Transform point", nbItems, nbRepetitions, [&](uint32 i) {
+        return (transforms[i] * vectors[i + 1]).y;
+    });
+    runBenchmark("Quaternion product", nbItems, nbRepetitions, [&](uint32 i) {
+        return (quaternions[i] * quaternions[i + 1]).z;
+    });
+    runBenchmark("Quaternion rotation", nbItems, nbRepetitions, [&](uint32 i) {
+        return (quaternions[i] * vectors[i + 1]).x;
+    });
+    runBenchmark("Matrix product", nbItems, nbRepetitions, [&](uint32 i) {
+        return (matrices[i] * matrices[i + 1])[1][2];
+    });
+    runBenchmark("Matrix inverse", nbItems, nbRepetitions, [&](uint32 i) {
+        return matrices[i].getInverse()[2][0];
+    });
+    runBenchmark("Cross product", nbItems, nbRepetitions, [&](uint32 i) {
+        return vectors[i].cross(vectors[i + 1]).z;
+    });
+    runBenchmark("Dot product", nbItems, nbRepetitions, [&](uint32 i) {
+        return vectors[i].dot(vectors[i + 1]);
+    });
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark measures the throughput of the narrow-phase collision detection with the
+ * PhysicsWorld::testOverlap() and PhysicsWorld::testCollision() queries on dense grids of
+ * bodies with one or two shape types (alternating in the grid). Most of the broad-phase pairs
+ * are tested by the narrow-phase and only some of them are colliding. It also measures the
+ * average PhysicsWorld::update() time of simulated scenes (a stack of cubes similar to the cube
+ * stack scene of the testbed and piles of boxes and of convex meshes falling on a floor). The scenes
+ * are also simulated without sleeping, with and without the narrow-phase temporal coherence.
+ *
+ * Usage: narrowphasebenchmark [gridSize] [nbRepetitions] [nbSteps]
+ */
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Overlap callback that counts the overlapping pairs
+class CountOverlapCallback : public OverlapCallback {
+
+    public:
+
+        uint32 nbPairs = 0;
+
+        virtual void onOverlap(CallbackData& callbackData) override {
+            nbPairs += callbackData.getNbOverlappingPairs();
+        }
+};
+
+// Collision callback that counts the contact points
+class CountContactsCallback : public CollisionCallback {
+
+    public:
+
+        uint32 nbContactPoints = 0;
+
+        virtual void onContact(const CallbackData& callbackData) override {
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+                nbContactPoints += callbackData.getContactPair(p).getNbContactPoints();
+            }
+        }
+};
+
+// State of the pseudo-random number generator
+static uint32 randomState = 12345;
+
+// Return a pseudo-random number in [min, max]
+decimal random(decimal min, decimal max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (max - min) * decimal(randomState >> 8) / decimal(1u << 24);
+}
+
+// Return a convex mesh with vertices on a sphere
+ConvexMesh* createSphereConvexMesh(PhysicsCommon& physicsCommon, uint32 nbPoints, decimal radius) {
+
+    std::vector<float> points;
+    while (points.size() < 3 * nbPoints) {
+        const Vector3 point(random(-1, 1), random(-1, 1), random(-1, 1));
+        if (point.lengthSquare() < decimal(0.01) || point.lengthSquare() > decimal(1.0)) continue;
+        const Vector3 surfacePoint = radius * point.getUnit();
+        points.push_back(float(surfacePoint.x));
+        points.push_back(float(surfacePoint.y));
+        points.push_back(float(surfacePoint.z));
+    }
+
+    VertexArray vertexArray(points.data(), 3 * sizeof(float), nbPoints, VertexArray::DataType::VERTEX_FLOAT_TYPE);
+    std::vector<Message> messages;
+    return physicsCommon.createConvexMesh(vertexArray, messages);
+}
+
+// Run the queries on a grid of bodies with two collision shapes (alternating in the grid)
+void runBenchmark(const char* name, PhysicsCommon& physicsCommon, CollisionShape* shape1, CollisionShape* shape2,
+                  uint32 gridSize, uint32 nbRepetitions) {
+
+    PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+    world->setIsGravityEnabled(false);
+
+    // Grid of bodies with a spacing such that roughly half of the broad-phase pairs are colliding
+    for (uint32 i=0; i < gridSize; i++) {
+        for (uint32 j=0; j < gridSize; j++) {
+            for (uint32 k=0; k < gridSize; k++) {
+                const Vector3 position(decimal(i) * decimal(1.9) + random(-0.1, 0.1), decimal(j) * decimal(1.9) + random(-0.1, 0.1),
+                                       decimal(k) * decimal(1.9) + random(-0.1, 0.1));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(random(-0.2, 0.2), random(-0.2, 0.2), random(-0.2, 0.2))));
+                body->setIsAllowedToSleep(false);
+                body->addCollider((i + j + k) % 2 == 0 ? shape1 : shape2, Transform::identity());
+            }
+        }
+    }
+
+    // Compute the broad-phase pairs
+    world->update(decimal(1.0 / 60.0));
+
+    CountOverlapCallback overlapCallback;
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint32 r=0; r < nbRepetitions; r++) {
+        overlapCallback.nbPairs = 0;
+        world->testOverlap(overlapCallback);
+    }
+    const std::chrono::duration<double> overlapTime = std::chrono::steady_clock::now() - startTime;
+
+    CountContactsCallback contactsCallback;
+    startTime = std::chrono::steady_clock::now();
+    for (uint32 r=0; r < nbRepetitions; r++) {
+        contactsCallback.nbContactPoints = 0;
+        world->testCollision(contactsCallback);
+    }
+    const std::chrono::duration<double> collisionTime = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << std::setw(24) << name << std::setw(16) << std::fixed << std::setprecision(3) << 1e3 * overlapTime.count() / nbRepetitions
+              << std::setw(16) << 1e3 * collisionTime.count() / nbRepetitions << std::setw(12) << overlapCallback.nbPairs
+              << std::setw(12) << contactsCallback.nbContactPoints << std::endl;
+
+    physicsCommon.destroyPhysicsWorld(world);
+}
+
+// Simulate a scene and print the average update time of the world
+void runSceneBenchmark(const char* name, PhysicsCommon& physicsCommon, PhysicsWorld* world, uint32 nbSteps) {
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (uint32 s=0; s < nbSteps; s++) {
+        world->update(decimal(1.0 / 60.0));
+    }
+    const std::chrono::duration<double> updateTime = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << std::setw(24) << name << std::setw(16) << std::fixed << std::setprecision(3)
+              << 1e3 * updateTime.count() / nbSteps << std::endl;
+
+    physicsCommon.destroyPhysicsWorld(world);
+}
+
+// Create a pyramid of cubes on a floor (similar to the cube stack scene of the testbed)
+PhysicsWorld* createCubeStackWorld(PhysicsCommon& physicsCommon, BoxShape* boxShape, BoxShape* floorShape, uint32 nbFloors,
+                                   const PhysicsWorld::WorldSettings& settings = PhysicsWorld::WorldSettings()) {
+
+    PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+
+    RigidBody* floor = world->createRigidBody(Transform::identity());
+    floor->setType(BodyType::STATIC);
+    floor->addCollider(floorShape, Transform::identity());
+
+    for (uint32 i=nbFloors; i > 0; i--) {
+        for (uint32 j=0; j < i; j++) {
+            const Vector3 position((-decimal(i) * decimal(0.5) + decimal(j)) * decimal(2.1), decimal(2.0) + decimal(nbFloors - i) * decimal(2.1), 0);
+            RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+            body->addCollider(boxShape, Transform::identity());
+        }
+    }
+
+    return world;
+}
+
+// Create a pile of bodies falling on a floor (similar to the pile scene of the testbed)
+PhysicsWorld* createPileWorld(PhysicsCommon& physicsCommon, CollisionShape* shape, CollisionShape* floorShape, uint32 nbBodies,
+                              const PhysicsWorld::WorldSettings& settings = PhysicsWorld::WorldSettings()) {
+
+    PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+
+    RigidBody* floor = world->createRigidBody(Transform::identity());
+    floor->setType(BodyType::STATIC);
+    floor->addCollider(floorShape, Transform::identity());
+
+    // Layers of 5x5 bodies with random orientations above the floor
+    for (uint32 i=0; i < nbBodies; i++) {
+        const Vector3 position(decimal(i % 5) * decimal(2.5), decimal(4.0) + decimal(i / 25) * decimal(2.5), decimal((i / 5) % 5) * decimal(2.5));
+        RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(random(-1, 1), random(-1, 1), random(-1, 1))));
+        body->addCollider(shape, Transform::identity());
+    }
+
+    return world;
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 gridSize = argc > 1 ? uint32(std::atoi(argv[1])) : 24;
+    const uint32 nbRepetitions = argc > 2 ? uint32(std::atoi(argv[2])) : 20;
+    const uint32 nbSteps = argc > 3 ? uint32(std::atoi(argv[3])) : 600;
+
+    PhysicsCommon physicsCommon;
+
+    std::cout << "Bodies: " << gridSize * gridSize * gridSize << ", repetitions: " << nbRepetitions << std::endl;
+    std::cout << std::setw(24) << "Shapes" << std::setw(16) << "Overlap (ms)" << std::setw(16) << "Collision (ms)"
+              << std::setw(12) << "Pairs" << std::setw(12) << "Contacts" << std::endl;
+
+    SphereShape* sphereShape = physicsCommon.createSphereShape(decimal(1.0));
+    CapsuleShape* capsuleShape = physicsCommon.createCapsuleShape(decimal(0.6), decimal(0.8));
+    BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(decimal(0.95), decimal(0.95), decimal(0.95)));
+    ConvexMeshShape* convexMeshShape = physicsCommon.createConvexMeshShape(createSphereConvexMesh(physicsCommon, 128, decimal(1.0)));
+
+    runBenchmark("Sphere vs sphere", physicsCommon, sphereShape, sphereShape, gridSize, nbRepetitions);
+    runBenchmark("Capsule vs capsule", physicsCommon, capsuleShape, capsuleShape, gridSize, nbRepetitions);
+    runBenchmark("Box vs box", physicsCommon, boxShape, boxShape, gridSize, nbRepetitions);
+    runBenchmark("Sphere vs convex mesh", physicsCommon, sphereShape, convexMeshShape, gridSize, nbRepetitions);
+    runBenchmark("Capsule vs convex mesh", physicsCommon, capsuleShape, convexMeshShape, gridSize, nbRepetitions);
+
+    std::cout << std::endl << "Steps: " << nbSteps << std::endl;
+    std::cout << std::setw(24) << "Scene" << std::setw(16) << "Update (ms)" << std::endl;
+
+    BoxShape* cubeShape = physicsCommon.createBoxShape(Vector3(1, 1, 1));
+    BoxShape* floorShape = physicsCommon.createBoxShape(Vector3(50, 1, 50));
+
+    runSceneBenchmark("Cube stack", physicsCommon, createCubeStackWorld(physicsCommon, cubeShape, floorShape, 15), nbSteps);
+    runSceneBenchmark("Box pile", physicsCommon, createPileWorld(physicsCommon, boxShape, floorShape, 400), nbSteps);
+    runSceneBenchmark("Convex mesh pile", physicsCommon, createPileWorld(physicsCommon, convexMeshShape, floorShape, 200), nbSteps);
+
+    // Same scenes without sleeping (all the resting pairs are tested every frame) with and without
+    // the narrow-phase temporal coherence
+    PhysicsWorld::WorldSettings awakeSettings;
+    awakeSettings.isSleepingEnabled = false;
+    PhysicsWorld::WorldSettings coherenceSettings = awakeSettings;
+    coherenceSettings.isNarrowPhaseTemporalCoherenceEnabled = true;
+
+    runSceneBenchmark("Cube stack (awake)", physicsCommon, createCubeStackWorld(physicsCommon, cubeShape, floorShape, 15, awakeSettings), nbSteps);
+    runSceneBenchmark("Cube stack (coherence)", physicsCommon, createCubeStackWorld(physicsCommon, cubeShape, floorShape, 15, coherenceSettings), nbSteps);
+    runSceneBenchmark("Box pile (awake)", physicsCommon, createPileWorld(physicsCommon, boxShape, floorShape, 400, awakeSettings), nbSteps);
+    runSceneBenchmark("Box pile (coherence)", physicsCommon, createPileWorld(physicsCommon, boxShape, floorShape, 400, coherenceSettings), nbSteps);
+    runSceneBenchmark("Mesh pile (awake)", physicsCommon, createPileWorld(physicsCommon, convexMeshShape, floorShape, 200, awakeSettings), nbSteps);
+    runSceneBenchmark("Mesh pile (coherence)", physicsCommon, createPileWorld(physicsCommon, convexMeshShape, floorShape, 200, coherenceSettings), nbSteps);
+
+    // Piles of bodies falling on a bumpy height field (convex vs triangle tests)
+    const int terrainGridSize = 101;
+    std::vector<float> terrainHeights(terrainGridSize * terrainGridSize);
+    for (int i=0; i < terrainGridSize * terrainGridSize; i++) {
+        terrainHeights[i] = float(random(0, decimal(0.6)));
+    }
+    std::vector<Message> messages;
+    HeightField* terrain = physicsCommon.createHeightField(terrainGridSize, terrainGridSize, terrainHeights.data(),
+                                                           HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+    HeightFieldShape* terrainShape = physicsCommon.createHeightFieldShape(terrain);
+
+    runSceneBenchmark("Box pile (terrain)", physicsCommon, createPileWorld(physicsCommon, boxShape, terrainShape, 400, awakeSettings), nbSteps);
+    runSceneBenchmark("Capsule pile (terrain)", physicsCommon, createPileWorld(physicsCommon, capsuleShape, terrainShape, 400, awakeSettings), nbSteps);
+    runSceneBenchmark("Sphere pile (terrain)", physicsCommon, createPileWorld(physicsCommon, sphereShape, terrainShape, 400, awakeSettings), nbSteps);
+
+    return 0;
+}
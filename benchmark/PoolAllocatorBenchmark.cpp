@@ -0,0 +1,121 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark compares the throughput of the PoolAllocator (that locks a mutex on each call)
+ * with the ConcurrentPoolAllocator (per-thread caches and lock-free global lists) when small
+ * objects are allocated and released by 1, 4 and 16 threads at the same time.
+ *
+ * Usage: poolallocatorbenchmark [nbOperationsPerThread]
+ */
+
+// Libraries
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Number of objects that are alive at the same time in each thread
+const uint32 NB_LIVE_OBJECTS = 256;
+
+// Allocate and release small objects of random sizes with the pool allocator of a memory manager
+void allocateAndRelease(MemoryManager& memoryManager, uint32 nbOperations, uint32 seed) {
+
+    void* objects[NB_LIVE_OBJECTS] = {};
+    size_t sizes[NB_LIVE_OBJECTS] = {};
+
+    uint32 random = seed;
+    for (uint32 i=0; i < nbOperations; i++) {
+
+        random = random * 1664525u + 1013904223u;
+        const uint32 index = (random >> 8) % NB_LIVE_OBJECTS;
+
+        if (objects[index] != nullptr) {
+            memoryManager.release(MemoryManager::AllocationType::Pool, objects[index], sizes[index]);
+        }
+
+        sizes[index] = 16 + (random >> 20) % 496;
+        objects[index] = memoryManager.allocate(MemoryManager::AllocationType::Pool, sizes[index]);
+    }
+
+    for (uint32 i=0; i < NB_LIVE_OBJECTS; i++) {
+        if (objects[i] != nullptr) {
+            memoryManager.release(MemoryManager::AllocationType::Pool, objects[i], sizes[i]);
+        }
+    }
+}
+
+// Run the benchmark with a given number of threads and return the number of operations per second
+double runBenchmark(bool useConcurrentPoolAllocator, uint32 nbThreads, uint32 nbOperationsPerThread) {
+
+    MemoryManager memoryManager(nullptr, 0, useConcurrentPoolAllocator);
+
+    // Warm up the allocator
+    allocateAndRelease(memoryManager, nbOperationsPerThread / 10, 0);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32 t=0; t < nbThreads; t++) {
+        threads.emplace_back(allocateAndRelease, std::ref(memoryManager), nbOperationsPerThread, t + 1);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    return double(nbThreads) * nbOperationsPerThread / elapsedTime.count();
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 nbOperationsPerThread = argc > 1 ? uint32(std::atoi(argv[1])) : 2000000;
+
+    std::cout << "Operations per thread: " << nbOperationsPerThread << std::endl;
+    std::cout << std::setw(8) << "Threads" << std::setw(20) << "PoolAllocator" << std::setw(24) << "ConcurrentPoolAllocator"
+              << std::setw(10) << "Speedup" << std::endl;
+    std::cout << std::setw(8) << "" << std::setw(20) << "(Mop/s)" << std::setw(24) << "(Mop/s)" << std::endl;
+
+    const uint32 nbThreadsToMeasure[] = {1, 4, 16};
+    for (uint32 nbThreads : nbThreadsToMeasure) {
+
+        const double poolThroughput = runBenchmark(false, nbThreads, nbOperationsPerThread) / 1.0e6;
+        const double concurrentThroughput = runBenchmark(true, nbThreads, nbOperationsPerThread) / 1.0e6;
+
+        std::cout << std::setw(8) << nbThreads << std::setw(20) << std::fixed << std::setprecision(2) << poolThroughput
+                  << std::setw(24) << concurrentThroughput << std::setw(10) << (concurrentThroughput / poolThroughput) << std::endl;
+    }
+
+    return 0;
+}
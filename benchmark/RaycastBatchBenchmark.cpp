@@ -0,0 +1,217 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark compares the throughput of the single raycasts (PhysicsWorld::raycast()) with the
+ * batched raycasts (PhysicsWorld::raycastBatch()) serial and in parallel. The rays are coherent
+ * lidar-like scans of a scene with a height field, a large concave mesh and many convex bodies.
+ *
+ * Usage: raycastbatchbenchmark [nbSensors] [nbWorkers] [nbRepetitions]
+ */
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Raycast callback that only keeps the closest hit
+class ClosestHitCallback : public RaycastCallback {
+
+    public:
+
+        bool isHit = false;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            isHit = true;
+            return info.hitFraction;
+        }
+};
+
+// Number of vertical channels of a lidar sensor
+const uint32 NB_CHANNELS = 32;
+
+// Number of rays of a channel
+const uint32 NB_AZIMUTHS = 1024;
+
+// Range of a lidar sensor
+const decimal SENSOR_RANGE = decimal(60.0);
+
+// State of the pseudo-random number generator
+static uint32 randomState = 12345;
+
+// Return a pseudo-random number in [min, max]
+decimal random(decimal min, decimal max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (max - min) * decimal(randomState >> 8) / decimal(1u << 24);
+}
+
+// Return the number of hits of an array of hits
+uint32 computeNbHits(const std::vector<RaycastHit>& hits) {
+    uint32 nbHits = 0;
+    for (size_t i=0; i < hits.size(); i++) {
+        if (hits[i].isHit()) nbHits++;
+    }
+    return nbHits;
+}
+
+// Print a line of the results
+void printResult(const char* name, uint32 nbRays, double time, uint32 nbHits) {
+    std::cout << std::setw(24) << name << std::setw(16) << std::fixed << std::setprecision(0) << nbRays / time
+              << std::setw(10) << nbHits << std::endl;
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 nbSensors = argc > 1 ? uint32(std::atoi(argv[1])) : 8;
+    const uint32 nbWorkers = argc > 2 ? uint32(std::atoi(argv[2])) : 0;
+    const uint32 nbRepetitions = argc > 3 ? uint32(std::atoi(argv[3])) : 5;
+
+    PhysicsCommon physicsCommon;
+
+    DefaultTaskScheduler* taskScheduler = physicsCommon.createDefaultTaskScheduler(nbWorkers);
+
+    PhysicsWorld::WorldSettings settings;
+    settings.taskScheduler = taskScheduler;
+    PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+
+    // Height field terrain
+    const int nbTerrainCells = 128;
+    std::vector<float> heights(nbTerrainCells * nbTerrainCells);
+    for (int i=0; i < nbTerrainCells; i++) {
+        for (int j=0; j < nbTerrainCells; j++) {
+            heights[i * nbTerrainCells + j] = 2.0f * std::sin(float(i) * 0.1f) * std::cos(float(j) * 0.13f);
+        }
+    }
+    std::vector<Message> messages;
+    HeightField* heightField = physicsCommon.createHeightField(nbTerrainCells, nbTerrainCells, heights.data(),
+                                                               HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+    RigidBody* terrain = world->createRigidBody(Transform::identity());
+    terrain->setType(BodyType::STATIC);
+    terrain->addCollider(physicsCommon.createHeightFieldShape(heightField), Transform::identity());
+
+    // Large concave mesh (wavy grid above a part of the terrain)
+    const int nbMeshCells = 64;
+    std::vector<Vector3> meshVertices;
+    std::vector<uint32> meshIndices;
+    for (int i=0; i <= nbMeshCells; i++) {
+        for (int j=0; j <= nbMeshCells; j++) {
+            meshVertices.push_back(Vector3(decimal(i) * decimal(0.5), decimal(0.5) * std::sin(decimal(i + j) * decimal(0.3)), decimal(j) * decimal(0.5)));
+        }
+    }
+    for (int i=0; i < nbMeshCells; i++) {
+        for (int j=0; j < nbMeshCells; j++) {
+            const uint32 v = uint32(i * (nbMeshCells + 1) + j);
+            meshIndices.push_back(v); meshIndices.push_back(v + 1); meshIndices.push_back(v + nbMeshCells + 1);
+            meshIndices.push_back(v + 1); meshIndices.push_back(v + nbMeshCells + 2); meshIndices.push_back(v + nbMeshCells + 1);
+        }
+    }
+    TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ? TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE :
+                                                                            TriangleVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+    TriangleVertexArray vertexArray(uint32(meshVertices.size()), meshVertices.data(), sizeof(Vector3),
+                                    uint32(meshIndices.size() / 3), meshIndices.data(), 3 * sizeof(uint32),
+                                    vertexType, TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+    TriangleMesh* triangleMesh = physicsCommon.createTriangleMesh(vertexArray, messages);
+    RigidBody* meshBody = world->createRigidBody(Transform(Vector3(-40, 6, -40), Quaternion::identity()));
+    meshBody->setType(BodyType::STATIC);
+    meshBody->addCollider(physicsCommon.createConcaveMeshShape(triangleMesh), Transform::identity());
+
+    // Convex bodies scattered on the terrain
+    BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(1, 2, 1));
+    SphereShape* sphereShape = physicsCommon.createSphereShape(decimal(1.0));
+    for (uint32 i=0; i < 2000; i++) {
+        RigidBody* body = world->createRigidBody(Transform(Vector3(random(-60, 60), random(3, 6), random(-60, 60)),
+                                                           Quaternion::fromEulerAngles(0, random(0, PI_RP3D), 0)));
+        body->setType(BodyType::STATIC);
+        body->addCollider(i % 3 == 0 ? static_cast<CollisionShape*>(sphereShape) : boxShape, Transform::identity());
+    }
+
+    world->update(decimal(1.0 / 60.0));
+
+    // Lidar scans (the consecutive rays of a channel are coherent)
+    std::vector<Ray> rays;
+    for (uint32 s=0; s < nbSensors; s++) {
+        const Vector3 sensorPosition(random(-50, 50), 8, random(-50, 50));
+        for (uint32 c=0; c < NB_CHANNELS; c++) {
+            const decimal pitch = decimal(-0.5) + decimal(0.55) * decimal(c) / decimal(NB_CHANNELS);
+            for (uint32 a=0; a < NB_AZIMUTHS; a++) {
+                const decimal yaw = decimal(2.0) * PI_RP3D * decimal(a) / decimal(NB_AZIMUTHS);
+                const Vector3 direction(std::cos(pitch) * std::cos(yaw), std::sin(pitch), std::cos(pitch) * std::sin(yaw));
+                rays.push_back(Ray(sensorPosition, sensorPosition + SENSOR_RANGE * direction));
+            }
+        }
+    }
+    const uint32 nbRays = uint32(rays.size()) * nbRepetitions;
+
+    std::cout << "Rays: " << rays.size() << ", repetitions: " << nbRepetitions << ", workers: "
+              << taskScheduler->getNbWorkers() << ", SIMD lanes: " << SimdDecimal::NB_LANES << std::endl;
+    std::cout << std::setw(24) << "Raycasts" << std::setw(16) << "Rays/s" << std::setw(10) << "Hits" << std::endl;
+
+    // Single raycasts
+    uint32 nbHits = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint32 r=0; r < nbRepetitions; r++) {
+        nbHits = 0;
+        for (size_t i=0; i < rays.size(); i++) {
+            ClosestHitCallback callback;
+            world->raycast(rays[i], &callback);
+            if (callback.isHit) nbHits++;
+        }
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - startTime;
+    printResult("Single (closest)", nbRays, time.count(), nbHits);
+
+    // Batched raycasts
+    const struct { const char* name; RaycastBatchMode mode; bool isParallel; } batches[] = {
+        {"Batch (closest)", RaycastBatchMode::CLOSEST_HIT, false},
+        {"Batch parallel (closest)", RaycastBatchMode::CLOSEST_HIT, true},
+        {"Batch (first)", RaycastBatchMode::FIRST_HIT, false},
+        {"Batch parallel (first)", RaycastBatchMode::FIRST_HIT, true},
+    };
+
+    std::vector<RaycastHit> hits;
+    for (const auto& batch : batches) {
+
+        startTime = std::chrono::steady_clock::now();
+        for (uint32 r=0; r < nbRepetitions; r++) {
+            world->raycastBatch(rays, hits, batch.mode, 0xFFFF, batch.isParallel);
+        }
+        time = std::chrono::steady_clock::now() - startTime;
+        printResult(batch.name, nbRays, time.count(), computeNbHits(hits));
+    }
+
+    physicsCommon.destroyPhysicsWorld(world);
+    physicsCommon.destroyDefaultTaskScheduler(taskScheduler);
+
+    return 0;
+}
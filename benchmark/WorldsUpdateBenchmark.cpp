@@ -0,0 +1,125 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+/*
+ * This benchmark measures the throughput of the PhysicsCommon::updatePhysicsWorlds() method
+ * that updates many small independent physics worlds in parallel. The same set of worlds (each
+ * with its own memory manager) is updated with an increasing number of workers.
+ *
+ * Usage: worldsupdatebenchmark [nbWorlds] [nbBodiesPerWorld] [nbSteps] [maxNbWorkers]
+ */
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+// ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Update the worlds in parallel and return the number of world updates per second
+double runBenchmark(uint32 nbWorlds, uint32 nbBodiesPerWorld, uint32 nbSteps, uint32 nbWorkers) {
+
+    PhysicsCommon physicsCommon;
+    physicsCommon.setTaskScheduler(physicsCommon.createDefaultTaskScheduler(nbWorkers));
+
+    BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+    BoxShape* floorShape = physicsCommon.createBoxShape(Vector3(20, 0.5, 20));
+
+    PhysicsWorld::WorldSettings settings;
+    settings.hasOwnMemoryManager = true;
+
+    // Create the worlds with a pile of boxes falling on a floor
+    std::vector<PhysicsWorld*> worlds;
+    for (uint32 w=0; w < nbWorlds; w++) {
+
+        PhysicsWorld* world = physicsCommon.createPhysicsWorld(settings);
+
+        RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+        floor->setType(BodyType::STATIC);
+        floor->addCollider(floorShape, Transform::identity());
+
+        for (uint32 i=0; i < nbBodiesPerWorld; i++) {
+            const Vector3 position(decimal(i % 5) * decimal(1.5), decimal(1 + i / 25) * decimal(1.1), decimal((i / 5) % 5) * decimal(1.5));
+            RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.1) * (i % 3), 0)));
+            body->addCollider(boxShape, Transform::identity());
+        }
+
+        worlds.push_back(world);
+    }
+
+    const decimal timeStep = decimal(1.0) / decimal(60.0);
+
+    // Warm up the allocators
+    physicsCommon.updatePhysicsWorlds(worlds, timeStep);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (uint32 s=0; s < nbSteps; s++) {
+        physicsCommon.updatePhysicsWorlds(worlds, timeStep);
+    }
+
+    const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    return double(nbWorlds) * nbSteps / elapsedTime.count();
+}
+
+// Main function
+int main(int argc, char** argv) {
+
+    const uint32 nbWorlds = argc > 1 ? uint32(std::atoi(argv[1])) : 128;
+    const uint32 nbBodiesPerWorld = argc > 2 ? uint32(std::atoi(argv[2])) : 50;
+    const uint32 nbSteps = argc > 3 ? uint32(std::atoi(argv[3])) : 120;
+    const uint32 maxNbWorkers = argc > 4 ? uint32(std::atoi(argv[4])) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Worlds: " << nbWorlds << ", bodies per world: " << nbBodiesPerWorld << ", steps: " << nbSteps << std::endl;
+    std::cout << std::setw(8) << "Workers" << std::setw(20) << "World updates/s" << std::setw(10) << "Speedup" << std::endl;
+
+    // Numbers of workers to measure (powers of two and the maximum number of workers)
+    std::vector<uint32> nbWorkersToMeasure;
+    for (uint32 nbWorkers = 1; nbWorkers < maxNbWorkers; nbWorkers *= 2) {
+        nbWorkersToMeasure.push_back(nbWorkers);
+    }
+    nbWorkersToMeasure.push_back(maxNbWorkers);
+
+    double baseThroughput = 0.0;
+    for (uint32 nbWorkers : nbWorkersToMeasure) {
+
+        const double throughput = runBenchmark(nbWorlds, nbBodiesPerWorld, nbSteps, nbWorkers);
+
+        if (nbWorkers == 1) {
+            baseThroughput = throughput;
+        }
+
+        std::cout << std::setw(8) << nbWorkers << std::setw(20) << std::fixed << std::setprecision(1) << throughput
+                  << std::setw(10) << std::setprecision(2) << throughput / baseThroughput << std::endl;
+    }
+
+    return 0;
+}
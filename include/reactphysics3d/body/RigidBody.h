@@ -51,6 +51,11 @@ class RigidBody : public Body {
 
     protected :
 
+        // -------------------- Attributes -------------------- //
+
+        /// Double-buffered snapshots of the transform of the body at the end of the last updates of the world
+        Transform mTransformsSnapshots[2];
+
         // -------------------- Methods -------------------- //
 
         /// Awake the disabled neighbor bodies
@@ -90,6 +95,9 @@ class RigidBody : public Body {
         /// Set the current position and orientation
         virtual void setTransform(const Transform& transform) override;
 
+        /// Return the position and orientation of the body at the end of the last update of the world
+        const Transform& getTransformSnapshot() const;
+
         /// Return the mass of the body
         decimal getMass() const;
 
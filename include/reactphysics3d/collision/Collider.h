@@ -75,6 +75,12 @@ class Collider {
         /// changed by the user
         void setHasCollisionShapeChangedSize(bool hasCollisionShapeChangedSize);
 
+        /// Raycast method with feedback information (the temporary memory is allocated with the allocator in parameter)
+        bool raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator);
+
+        /// Raycast method for a packet of rays with feedback information
+        uint32 raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, MemoryAllocator& allocator);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -190,6 +196,8 @@ class Collider {
         friend class CollisionShape;
         friend class ContactManifoldSet;
 		friend class MiddlePhaseTriangleCallback;
+        friend struct RaycastTest;
+        friend class BroadPhaseRaycastPacketCallback;
 
 };
 
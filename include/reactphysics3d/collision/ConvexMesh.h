@@ -59,6 +59,12 @@ class ConvexMesh {
         /// All the vertices of the mesh
         Array<Vector3> mVertices;
 
+        /// Coordinates x, y and z of the vertices (padded with copies of the first vertex to a
+        /// multiple of the number of SIMD lanes) for the SIMD search of the support vertex
+        Array<decimal> mVerticesX;
+        Array<decimal> mVerticesY;
+        Array<decimal> mVerticesZ;
+
         /// Array with the face normals
         Array<Vector3> mFacesNormals;
 
@@ -125,6 +131,12 @@ class ConvexMesh {
         /// Return the local inertia tensor of the mesh
         Vector3 getLocalInertiaTensor(decimal mass, Vector3 scale) const;
 
+        /// Return the index of the vertex with the largest dot product in a direction (testing all the vertices)
+        uint32 computeSupportVertexIndex(const Vector3& direction) const;
+
+        /// Return the index of the vertex with the largest dot product in a direction (hill-climbing from a start vertex)
+        uint32 computeSupportVertexIndex(const Vector3& direction, uint32 startVertexIndex) const;
+
         // ---------- Friendship ---------- //
 
         friend class PhysicsCommon;
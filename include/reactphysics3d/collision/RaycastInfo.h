@@ -36,6 +36,7 @@ namespace reactphysics3d {
 class Body;
 class Collider;
 class CollisionShape;
+class MemoryAllocator;
 struct Ray;
 
 // Structure RaycastInfo
@@ -86,6 +87,58 @@ struct RaycastInfo {
         RaycastInfo& operator=(const RaycastInfo& raycastInfo) = delete;
 };
 
+/// Hit reported for each ray by a batched raycast (PhysicsWorld::raycastBatch())
+enum class RaycastBatchMode {
+
+    /// The closest hit of the ray
+    CLOSEST_HIT,
+
+    /// The first hit found for the ray (not necessarily the closest one). The ray stops after this hit.
+    FIRST_HIT
+};
+
+// Structure RaycastHit
+/**
+ * This structure contains the hit of a ray of a batched raycast. If the ray
+ * did not hit any collider, the collider and the body are nullptr.
+ */
+struct RaycastHit {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Hit point in world-space coordinates
+        Vector3 worldPoint;
+
+        /// Surface normal at hit point in world-space coordinates
+        Vector3 worldNormal;
+
+        /// Fraction distance of the hit point between point1 and point2 of the ray
+        decimal hitFraction;
+
+        /// Hit triangle index (only used for triangles mesh and -1 otherwise)
+        int triangleIndex;
+
+        /// Pointer to the hit collision body
+        Body* body;
+
+        /// Pointer to the hit collider
+        Collider* collider;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        RaycastHit() : hitFraction(-1), triangleIndex(-1), body(nullptr), collider(nullptr) {
+
+        }
+
+        /// Return true if the ray has hit a collider
+        bool isHit() const {
+            return collider != nullptr;
+        }
+};
+
 // Class RaycastCallback
 /**
  * This class can be used to register a callback for ray casting queries.
@@ -131,9 +184,12 @@ struct RaycastTest {
         /// User callback class
         RaycastCallback* userCallback;
 
+        /// Memory allocator for the temporary memory of the raycast
+        MemoryAllocator& allocator;
+
         /// Constructor
-        RaycastTest(RaycastCallback* callback) {
-            userCallback = callback;
+        RaycastTest(RaycastCallback* callback, MemoryAllocator& memoryAllocator)
+            : userCallback(callback), allocator(memoryAllocator) {
 
         }
 
@@ -89,7 +89,7 @@ class TriangleMesh {
         bool init(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages);
 
         /// Report all shapes overlapping with the AABB given in parameter.
-        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes);
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& allocator) const;
 
         /// Remove the ununsed vertices (because they are not used in any triangles or are part of discarded triangles)
         void removeUnusedVertices(Array<bool>& areUsedVertices);
@@ -98,7 +98,10 @@ class TriangleMesh {
         int32 getDynamicAABBTreeNodeDataInt(int32 nodeID) const;
 
         /// Ray casting method
-        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& allocator) const;
+
+        /// Ray casting method for a packet of rays
+        void raycastPacket(const Ray* rays, uint32 raysMask, DynamicAABBTreeRaycastPacketCallback& callback, MemoryAllocator& allocator) const;
 
     public:
 
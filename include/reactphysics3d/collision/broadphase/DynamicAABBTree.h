@@ -132,6 +132,23 @@ class DynamicAABBTreeRaycastCallback {
 
 };
 
+// Class DynamicAABBTreeRaycastPacketCallback
+/**
+ * Raycast callback in the Dynamic AABB Tree called when the AABB of a leaf
+ * node is hit by some rays of a packet of rays.
+ */
+class DynamicAABBTreeRaycastPacketCallback {
+
+    public:
+
+        // Called when the AABB of a leaf node is hit by the rays of a packet that are in the mask. The
+        // maximum fractions of the rays can be reduced and the returned mask contains the rays that must stop.
+        virtual uint32 raycastBroadPhaseShape(int32 nodeId, uint32 raysMask, decimal* raysMaxFractions)=0;
+
+        virtual ~DynamicAABBTreeRaycastPacketCallback() = default;
+
+};
+
 // Class DynamicAABBTree
 /**
  * This class implements a dynamic AABB tree that is used for broad-phase
@@ -247,15 +264,28 @@ class DynamicAABBTree {
         /// Report all shapes overlapping with the AABB given in parameter.
         void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int>& overlappingNodes) const;
 
+        /// Report all shapes overlapping with the AABB given in parameter (the stack of nodes to visit uses the allocator in parameter)
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int>& overlappingNodes, MemoryAllocator& stackAllocator) const;
+
         /// Ray casting method
         void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
 
+        /// Ray casting method (the stack of nodes to visit uses the allocator in parameter)
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const;
+
+        /// Ray casting method for a packet of rays that traverse the tree together
+        void raycastPacket(const Ray* rays, uint32 raysMask, DynamicAABBTreeRaycastPacketCallback& callback,
+                           MemoryAllocator& stackAllocator) const;
+
         /// Compute the height of the tree
         int computeHeight();
 
         /// Return the root AABB of the tree
         const AABB& getRootAABB() const;
 
+        /// Return the number of allocated nodes in the tree
+        int32 getNbAllocatedNodes() const;
+
         /// Clear all the nodes and reset the tree
         void reset();
 
@@ -266,6 +296,9 @@ class DynamicAABBTree {
 
 #endif
 
+        // -------------------- Friendship -------------------- //
+
+        friend class WideAABBTree;
 };
 
 // Return true if the node is a leaf of the tree
@@ -298,6 +331,11 @@ RP3D_FORCE_INLINE const AABB& DynamicAABBTree::getRootAABB() const {
     return getFatAABB(mRootNodeID);
 }
 
+// Return the number of allocated nodes in the tree (the node IDs are smaller than this number)
+RP3D_FORCE_INLINE int32 DynamicAABBTree::getNbAllocatedNodes() const {
+    return mNbAllocatedNodes;
+}
+
 // Add an object into the tree. This method creates a new leaf node in the tree and
 // returns the ID of the corresponding node.
 RP3D_FORCE_INLINE int32 DynamicAABBTree::addObject(const AABB& aabb, uint32 data) {
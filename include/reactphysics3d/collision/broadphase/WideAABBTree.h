@@ -0,0 +1,171 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_WIDE_AABB_TREE_H
+#define REACTPHYSICS3D_WIDE_AABB_TREE_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#include <reactphysics3d/containers/Array.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class MemoryAllocator;
+class Profiler;
+
+// Structure WideTreeNode
+/**
+ * This structure represents a node of the wide AABB tree. A node has up to
+ * NB_MAX_CHILDREN children and the AABBs of the children are stored in the node as
+ * structure of arrays so that they can all be tested with a few SIMD instructions.
+ */
+struct WideTreeNode {
+
+    // -------------------- Constants -------------------- //
+
+    /// Maximum number of children of a node
+    static constexpr uint32 NB_MAX_CHILDREN = SimdDecimal::NB_LANES;
+
+    // -------------------- Attributes -------------------- //
+
+    /// Minimum x, y and z coordinates of the AABBs of the children
+    decimal minX[NB_MAX_CHILDREN];
+    decimal minY[NB_MAX_CHILDREN];
+    decimal minZ[NB_MAX_CHILDREN];
+
+    /// Maximum x, y and z coordinates of the AABBs of the children
+    decimal maxX[NB_MAX_CHILDREN];
+    decimal maxY[NB_MAX_CHILDREN];
+    decimal maxZ[NB_MAX_CHILDREN];
+
+    /// Index of each child in the array of wide nodes (or ID of the leaf node in
+    /// the dynamic AABB tree if the child is a leaf)
+    int32 children[NB_MAX_CHILDREN];
+
+    /// Bit mask of the children that are leaves
+    uint32 leavesMask;
+
+    /// Bit mask of the children of the node (the children are always the first lanes)
+    uint32 childrenMask;
+};
+
+// Class WideAABBTree
+/**
+ * This class implements a wide bounding volume hierarchy that is built from a dynamic
+ * AABB tree. Each node of the binary dynamic AABB tree is collapsed with its descendants
+ * into a node with up to SimdDecimal::NB_LANES children. A node visit of a query then tests
+ * the AABBs of all the children at once with SIMD instructions. The leaves of the wide tree
+ * are the leaf nodes of the dynamic AABB tree and the queries report the same leaf node IDs.
+ * The wide tree has to be built again each time the dynamic AABB tree has changed.
+ */
+class WideAABBTree {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Dynamic AABB tree from which the wide tree is built
+        const DynamicAABBTree& mDynamicAABBTree;
+
+        /// Nodes of the tree (the root node is the first one)
+        Array<WideTreeNode> mNodes;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Pointer to the profiler
+        Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Return a bit mask of the children of a node whose AABB overlaps with an AABB
+        static uint32 testChildrenOverlap(const WideTreeNode& node, const SimdDecimal* aabbMin, const SimdDecimal* aabbMax);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        WideAABBTree(MemoryAllocator& allocator, const DynamicAABBTree& dynamicAABBTree);
+
+        /// Destructor
+        ~WideAABBTree() = default;
+
+        /// Deleted copy-constructor
+        WideAABBTree(const WideAABBTree& tree) = delete;
+
+        /// Deleted assignment operator
+        WideAABBTree& operator=(const WideAABBTree& tree) = delete;
+
+        /// Build the wide tree from the current state of the dynamic AABB tree
+        void build();
+
+        /// Report all shapes overlapping with all the shapes in the array in parameter
+        void reportAllShapesOverlappingWithShapes(const Array<int32>& nodesToTest, uint32 startIndex,
+                                                  size_t endIndex, Array<Pair<int32, int32>>& outOverlappingNodes) const;
+
+        /// Report all shapes overlapping with the AABB given in parameter (the stack of nodes to visit uses the allocator in parameter)
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& stackAllocator) const;
+
+        /// Ray casting method (the stack of nodes to visit uses the allocator in parameter)
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const;
+
+        /// Return the number of nodes in the tree
+        uint32 getNbNodes() const;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Set the profiler
+        void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+// Return the number of nodes in the tree
+RP3D_FORCE_INLINE uint32 WideAABBTree::getNbNodes() const {
+    return static_cast<uint32>(mNodes.size());
+}
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+RP3D_FORCE_INLINE void WideAABBTree::setProfiler(Profiler* profiler) {
+    mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
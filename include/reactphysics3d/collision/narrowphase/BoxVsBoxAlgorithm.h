@@ -0,0 +1,100 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+#define	REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
+#include <reactphysics3d/mathematics/mathematics.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+struct NarrowPhaseInfoBatch;
+
+// Class BoxVsBoxAlgorithm
+/**
+ * This class is used to compute the narrow-phase collision detection
+ * between two box collision shapes. It runs the separating axis test on
+ * the 15 possible axes (3 face normals of each box and the 9 cross products
+ * of their edges) with closed-form projections of the boxes. The contact
+ * points of a face contact are computed by clipping the incident face of
+ * one box with the reference face rectangle of the other box. Like the
+ * SAT algorithm, the face axes are favored over the edge axes and the faces
+ * of the first box are favored over the faces of the second box for stability.
+ */
+class BoxVsBoxAlgorithm : public NarrowPhaseAlgorithm {
+
+    protected :
+
+        // -------------------- Constants -------------------- //
+
+        /// Relative and absolute bias used to make sure the face axes are
+        /// favored over the edge axes (same values as the SAT algorithm)
+        static const decimal SEPARATING_AXIS_RELATIVE_TOLERANCE;
+        static const decimal SEPARATING_AXIS_ABSOLUTE_TOLERANCE;
+
+        /// Maximum number of vertices of the clipped incident face (each of the four clipping
+        /// planes adds at most one vertex to the convex polygon)
+        static const uint32 MAX_NB_CLIPPED_VERTICES = 8;
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the contact points of a face contact (in the local-space of the reference box)
+        bool computeFaceContactPoints(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex, bool isReferenceBox1,
+                                      const Vector3& referenceHalfExtents, const Vector3& incidentHalfExtents,
+                                      const Transform& incidentToReference, uint32 referenceAxis, decimal referenceSign,
+                                      const Vector3& normalWorld) const;
+
+        /// Clip a polygon with the plane coordinate[axis] * sign <= limit
+        static uint32 clipPolygon(const Vector3* inputVertices, uint32 nbInputVertices, uint32 axis, decimal sign,
+                                  decimal limit, Vector3* outputVertices);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BoxVsBoxAlgorithm() = default;
+
+        /// Destructor
+        virtual ~BoxVsBoxAlgorithm() override = default;
+
+        /// Deleted copy-constructor
+        BoxVsBoxAlgorithm(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Deleted assignment operator
+        BoxVsBoxAlgorithm& operator=(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Compute the narrow-phase collision detection between two boxes
+        bool testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
+                           uint32 batchNbItems, MemoryAllocator& memoryAllocator);
+};
+
+}
+
+#endif
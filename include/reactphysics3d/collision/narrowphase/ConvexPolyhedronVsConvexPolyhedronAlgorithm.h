@@ -42,12 +42,25 @@ struct NarrowPhaseInfoBatch;
  * between two convex polyhedra. Here we do not use the GJK algorithm but
  * we run the SAT algorithm to get the contact points and normal.
  * This is based on the "Robust Contact Creation for Physics Simulation"
- * presentation by Dirk Gregorius.
+ * presentation by Dirk Gregorius. For the polyhedra with many edges, the
+ * GJK and EPA algorithms can be used instead of SAT.
  */
 class ConvexPolyhedronVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm {
 
     protected :
 
+        // -------------------- Constants -------------------- //
+
+        /// Minimum cosine of the angle between the EPA normal and a face normal of a polyhedron
+        /// to compute the contact points by clipping the faces (instead of the single EPA point)
+        static const decimal FACE_CONTACT_MIN_COS_ANGLE;
+
+        // -------------------- Methods -------------------- //
+
+        /// Replace the contact point computed by EPA with the contact points of a face contact
+        void computeFaceContactPointsFromEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex,
+                                             MemoryAllocator& memoryAllocator) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -67,6 +80,10 @@ class ConvexPolyhedronVsConvexPolyhedronAlgorithm : public NarrowPhaseAlgorithm
         /// Compute the narrow-phase collision detection between two convex polyhedra
         bool testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
                            bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator);
+
+        /// Compute the narrow-phase collision detection between two convex polyhedra with the GJK and EPA algorithms
+        bool testCollisionWithGJKAndEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
+                                        bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator);
 };
 
 }
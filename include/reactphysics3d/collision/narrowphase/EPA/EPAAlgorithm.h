@@ -0,0 +1,190 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_EPA_ALGORITHM_H
+#define REACTPHYSICS3D_EPA_ALGORITHM_H
+
+// Libraries
+#include <reactphysics3d/mathematics/mathematics.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+struct NarrowPhaseInfoBatch;
+struct LastFrameCollisionInfo;
+class ConvexShape;
+class Profiler;
+class VoronoiSimplex;
+
+// Class EPAAlgorithm
+/**
+ * This class implements the Expanding Polytope Algorithm (EPA) to compute the penetration
+ * depth and the contact points between two convex shapes that overlap even without their
+ * margins. The algorithm starts with the final simplex of the GJK algorithm (which contains
+ * the origin) and expands a polytope inside the Minkowski difference of the two shapes until
+ * the face of the polytope that is the closest to the origin is on the boundary of the Minkowski
+ * difference. This implementation is based on the book "Collision Detection in Interactive
+ * 3D Environments" by Gino van den Bergen. The polytope is stored in fixed size arrays. If the
+ * polytope becomes degenerated or too large, the algorithm fails and the caller must use
+ * another algorithm (SAT) to compute the contact.
+ */
+class EPAAlgorithm {
+
+    private :
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of vertices of the polytope
+        static const uint32 MAX_NB_VERTICES = 128;
+
+        /// Maximum number of faces of the polytope
+        static const uint32 MAX_NB_FACES = 2 * MAX_NB_VERTICES;
+
+        /// Maximum distance between the closest face of the polytope and the boundary
+        /// of the Minkowski difference when the algorithm terminates
+        static const decimal TOLERANCE;
+
+        // -------------------- Structures -------------------- //
+
+        /// Triangular face of the polytope (the vertices are counter clockwise when
+        /// seen from the outside of the polytope)
+        struct Face {
+
+            /// Indices of the three vertices of the face
+            uint32 vertexIndices[3];
+
+            /// Unit normal of the face (pointing outside of the polytope)
+            Vector3 normal;
+
+            /// Distance between the origin and the plane of the face
+            decimal distance;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Vertices of the polytope (points of the Minkowski difference A-B)
+        Vector3 mVertices[MAX_NB_VERTICES];
+
+        /// Support points of the shape 1 of the vertices (in local-space of shape 1)
+        Vector3 mSupportPoints1[MAX_NB_VERTICES];
+
+        /// Support points of the shape 2 of the vertices (in local-space of shape 1)
+        Vector3 mSupportPoints2[MAX_NB_VERTICES];
+
+        /// Number of vertices of the polytope
+        uint32 mNbVertices;
+
+        /// Faces of the polytope
+        Face mFaces[MAX_NB_FACES];
+
+        /// Number of faces of the polytope
+        uint32 mNbFaces;
+
+        /// Edges of the horizon (vertex indices) when a new vertex is added to the polytope
+        uint32 mHorizonEdges[MAX_NB_VERTICES][2];
+
+        /// Number of edges of the horizon
+        uint32 mNbHorizonEdges;
+
+        /// Shapes of the current collision test
+        const ConvexShape* mShape1;
+        const ConvexShape* mShape2;
+
+        /// Transform from the local-space of shape 2 to the local-space of shape 1
+        Transform mShape2ToShape1;
+
+        /// Rotation of a direction from the local-space of shape 1 to the local-space of shape 2
+        Quaternion mRotateToShape2;
+
+        /// Last frame collision info of the current collision test (cached support vertices)
+        LastFrameCollisionInfo* mLastFrameCollisionInfo;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Pointer to the profiler
+        Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the support point of the Minkowski difference in a given direction
+        void computeSupportPoint(const Vector3& direction, Vector3& outSupportPoint1, Vector3& outSupportPoint2) const;
+
+        /// Add a vertex to the polytope if it increases the dimension of the initial simplex
+        bool addSimplexVertex(const Vector3& supportPoint1, const Vector3& supportPoint2);
+
+        /// Build the initial tetrahedron of the polytope from the final simplex of GJK
+        bool createInitialPolytope(const VoronoiSimplex& simplex);
+
+        /// Add a face to the polytope
+        bool addFace(uint32 vertexIndex1, uint32 vertexIndex2, uint32 vertexIndex3);
+
+        /// Add an edge to the horizon (or remove it if the opposite edge is already in the horizon)
+        bool addHorizonEdge(uint32 vertexIndex1, uint32 vertexIndex2);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        EPAAlgorithm() = default;
+
+        /// Destructor
+        ~EPAAlgorithm() = default;
+
+        /// Deleted copy-constructor
+        EPAAlgorithm(const EPAAlgorithm& algorithm) = delete;
+
+        /// Deleted assignment operator
+        EPAAlgorithm& operator=(const EPAAlgorithm& algorithm) = delete;
+
+        /// Compute the penetration depth and the contact point of two overlapping convex shapes
+        bool computePenetrationDepthAndContactPoints(const VoronoiSimplex& simplex, const ConvexShape* shape1, const ConvexShape* shape2,
+                                                     const Transform& shape2ToShape1, const Quaternion& rotateToShape2,
+                                                     NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        /// Set the profiler
+        void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+RP3D_FORCE_INLINE void EPAAlgorithm::setProfiler(Profiler* profiler) {
+    mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
@@ -57,7 +57,9 @@ constexpr int MAX_ITERATIONS_GJK_RAYCAST = 32;
  * the object intersects in their margins, the penetration depth is quickly
  * computed using the GJK algorithm on the original objects (without margin).
  * If the original objects (without margin) intersect, we exit GJK and run
- * the SAT algorithm to get contacts and collision data.
+ * the SAT algorithm to get contacts and collision data. Alternatively, the
+ * penetration depth of the original objects can be computed with the EPA
+ * algorithm starting from the final simplex of GJK.
  */
 class GJKAlgorithm {
 
@@ -65,6 +67,10 @@ class GJKAlgorithm {
 
         // -------------------- Attributes -------------------- //
 
+        /// True if the penetration depth of the original objects (without margin) is computed
+        /// with the EPA algorithm when they intersect
+        bool mComputePenetrationDepthWithEPA;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -79,13 +85,17 @@ class GJKAlgorithm {
         enum class GJKResult {
             SEPARATED,              // The two shapes are separated outside the margin
             COLLIDE_IN_MARGIN,      // The two shapes overlap only in the margin (shallow penetration)
-            INTERPENETRATE          // The two shapes overlap event without the margin (deep penetration)
+            INTERPENETRATE,         // The two shapes overlap event without the margin (deep penetration)
+            INTERPENETRATE_EPA      // The two shapes overlap without the margin and EPA has computed the penetration depth
         };
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        GJKAlgorithm() = default;
+        GJKAlgorithm(bool computePenetrationDepthWithEPA = false)
+            : mComputePenetrationDepthWithEPA(computePenetrationDepthWithEPA) {
+
+        }
 
         /// Destructor
         ~GJKAlgorithm() = default;
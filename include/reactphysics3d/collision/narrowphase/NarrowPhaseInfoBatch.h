@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <reactphysics3d/collision/ContactPointInfo.h>
+#include <reactphysics3d/collision/shapes/ConvexShape.h>
 #include <reactphysics3d/configuration.h>
 
 /// Namespace ReactPhysics3D
@@ -40,84 +41,145 @@ struct LastFrameCollisionInfo;
 struct ContactManifoldInfo;
 struct ContactPointInfo;
 
+// Struct NarrowPhaseTriangle
+/**
+ * This structure contains a triangle of a concave shape (triangle mesh or height field) that has to
+ * be tested against a convex shape during the narrow-phase. The triangles of a convex vs concave pair
+ * are stored contiguously in a single memory block. A TriangleShape is only created on the stack of
+ * the testing thread while the triangle is tested by a narrow-phase algorithm.
+ */
+struct NarrowPhaseTriangle {
+
+    /// Vertices of the triangle (in local-space of the concave shape)
+    Vector3 vertices[3];
+
+    /// Normals of the three vertices (for smooth mesh collision)
+    Vector3 verticesNormals[3];
+
+    /// Id of the triangle in the concave shape
+    uint32 id;
+};
+
 // Struct NarrowPhaseInfoBatch
 /**
  * This structure collects all the potential collisions from the middle-phase algorithm
- * that have to be tested during narrow-phase collision detection.
+ * that have to be tested during narrow-phase collision detection. The data of the collision
+ * tests is stored as a structure of arrays. The hot columns (transforms, margins of the shapes
+ * and results) are stored first in a single buffer such that the primitive algorithms stream
+ * through contiguous memory. The contact points of the collision tests are stored in the last
+ * (cold) column of the buffer with a fixed number of contact points per test such that the
+ * workers of the narrow-phase add contact points without allocating memory. For a test with a triangle of a concave shape, the
+ * collision shape of the triangle is nullptr and the triangle is stored in the triangles column.
  */
 struct NarrowPhaseInfoBatch {
 
-    struct NarrowPhaseInfo {
+    protected:
 
-        /// Broadphase overlapping pairs ids
-        uint64 overlappingPairId;
+        // -------------------- Constants -------------------- //
 
-        /// Entity of the first collider to test collision with
-        Entity colliderEntity1;
+        /// Number of collision tests to allocate at the beginning
+        static const uint32 INIT_NB_ALLOCATED_OBJECTS = 16;
 
-        /// Entity of the second collider to test collision with
-        Entity colliderEntity2;
+        /// Size (in bytes) of the data of a single collision test
+        static const size_t OBJECT_DATA_SIZE;
 
-        /// Collision info of the previous frame
-        LastFrameCollisionInfo* lastFrameCollisionInfo;
+        // -------------------- Attributes -------------------- //
 
-        /// Memory allocator for the collision shape (Used to release TriangleShape memory in destructor)
-        MemoryAllocator* collisionShapeAllocator;
+        /// Reference to the memory allocator
+        MemoryAllocator& mMemoryAllocator;
 
-        /// Shape local to world transform of sphere 1
-        Transform shape1ToWorldTransform;
+        /// Reference to all the broad-phase overlapping pairs
+        OverlappingPairs& mOverlappingPairs;
 
-        /// Shape local to world transform of sphere 2
-        Transform shape2ToWorldTransform;
+        /// Cached capacity
+        uint32 mCachedCapacity = 0;
 
-        /// Pointer to the first collision shapes to test collision with
-        CollisionShape* collisionShape1;
+        /// Number of collision tests in the batch
+        uint32 mNbObjects = 0;
 
-        /// Pointer to the second collision shapes to test collision with
-        CollisionShape* collisionShape2;
+        /// Number of allocated collision tests
+        uint32 mNbAllocatedObjects = 0;
 
-        /// True if we need to report contacts (false for triggers for instance)
-        bool reportContacts;
+        /// Buffer with the data of the collision tests
+        void* mBuffer = nullptr;
 
-        /// Result of the narrow-phase collision detection test
-        bool isColliding;
+        /// Header of a memory block with the triangles of a convex vs concave pair (the triangles follow the header)
+        struct TriangleBlock {
 
-        /// Number of contact points
-        uint8 nbContactPoints;
+            /// Next block of the batch
+            TriangleBlock* next;
 
-        /// Array of contact points created during the narrow-phase
-        ContactPointInfo contactPoints[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO];
+            /// Allocator of the block
+            MemoryAllocator* allocator;
 
-        /// Constructor
-        NarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator,
-                             const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform, CollisionShape* shape1,
-                             CollisionShape* shape2, bool needToReportContacts)
-                      : overlappingPairId(pairId), colliderEntity1(collider1), colliderEntity2(collider2), lastFrameCollisionInfo(lastFrameInfo),
-                         collisionShapeAllocator(&shapeAllocator), shape1ToWorldTransform(shape1ToWorldTransform),
-                         shape2ToWorldTransform(shape2ToWorldTransform), collisionShape1(shape1),
-                        collisionShape2(shape2), reportContacts(needToReportContacts), isColliding(false), nbContactPoints(0) {
+            /// Size (in bytes) of the block
+            size_t sizeBytes;
+        };
 
-        }
-    };
+        /// Linked list of the memory blocks with the triangles of the collision tests
+        TriangleBlock* mTriangleBlocks = nullptr;
 
-    protected:
+        /// Number of collision tests with a triangle
+        uint32 mNbTriangleObjects = 0;
 
-        /// Reference to the memory allocator
-        MemoryAllocator& mMemoryAllocator;
+        // -------------------- Methods -------------------- //
 
-        /// Reference to all the broad-phase overlapping pairs
-        OverlappingPairs& mOverlappingPairs;
+        /// Allocate memory for a given number of collision tests
+        void allocate(uint32 nbObjectsToAllocate);
 
-        /// Cached capacity
-        uint32 mCachedCapacity = 0;
-
-        /// TriangleShape allocated size
-        static const size_t mTriangleShapeAllocatedSize;
+        /// Release the buffer of the collision tests
+        void releaseBuffer();
 
     public:
 
-        /// For each collision test, we keep some meta data
-        Array<NarrowPhaseInfo> narrowPhaseInfos;
+        // -------------------- Attributes -------------------- //
+
+        /// Shape local to world transform of the first shapes
+        Transform* shape1ToWorldTransforms = nullptr;
+
+        /// Shape local to world transform of the second shapes
+        Transform* shape2ToWorldTransforms = nullptr;
+
+        /// Pointers to the first collision shapes to test collision with
+        CollisionShape** collisionShapes1 = nullptr;
+
+        /// Pointers to the second collision shapes to test collision with
+        CollisionShape** collisionShapes2 = nullptr;
+
+        /// Margins of the first collision shapes (the radius of a sphere or a capsule)
+        decimal* shape1Margins = nullptr;
+
+        /// Margins of the second collision shapes (the radius of a sphere or a capsule)
+        decimal* shape2Margins = nullptr;
+
+        /// True if we need to report contacts (false for triggers for instance)
+        bool* reportContacts = nullptr;
+
+        /// Result of the narrow-phase collision detection test
+        bool* isColliding = nullptr;
+
+        /// Number of contact points of each collision test
+        uint8* nbContactPoints = nullptr;
+
+        /// Broadphase overlapping pairs ids
+        uint64* overlappingPairIds = nullptr;
+
+        /// Entities of the first colliders to test collision with
+        Entity* colliderEntities1 = nullptr;
+
+        /// Entities of the second colliders to test collision with
+        Entity* colliderEntities2 = nullptr;
+
+        /// Collision infos of the previous frame
+        LastFrameCollisionInfo** lastFrameCollisionInfos = nullptr;
+
+        /// Triangles of the concave shapes to test collision with (nullptr if the two shapes are convex)
+        const NarrowPhaseTriangle** triangles = nullptr;
+
+        /// Contact points created during the narrow-phase (a fixed number of contact points for each collision test)
+        ContactPointInfo (*contactPoints)[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO] = nullptr;
+
+        // -------------------- Methods -------------------- //
 
         /// Constructor
         NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator);
@@ -125,14 +187,34 @@ struct NarrowPhaseInfoBatch {
         /// Destructor
         ~NarrowPhaseInfoBatch();
 
+        /// Deleted copy-constructor
+        NarrowPhaseInfoBatch(const NarrowPhaseInfoBatch& batch) = delete;
+
+        /// Deleted assignment operator
+        NarrowPhaseInfoBatch& operator=(const NarrowPhaseInfoBatch& batch) = delete;
+
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                                       CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                                      bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                                                      bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo);
+
+        /// Add a convex shape and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+        void addTriangleNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, ConvexShape* convexShape,
+                                        const NarrowPhaseTriangle* triangle, bool isShape1Convex, const Transform& shape1Transform,
+                                        const Transform& shape2Transform, bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo);
+
+        /// Allocate a memory block for the triangles of a convex vs concave pair (released in clear())
+        NarrowPhaseTriangle* allocateTriangles(uint32 nbTriangles, MemoryAllocator& allocator);
+
+        /// Move the narrow-phase infos of another batch at the end of this batch
+        void addNarrowPhaseInfos(NarrowPhaseInfoBatch& batch);
 
         /// Return the number of objects in the batch
         uint32 getNbObjects() const;
 
+        /// Return the number of collision tests with a triangle in the batch
+        uint32 getNbTriangleObjects() const;
+
         /// Add a new contact point
         void addContactPoint(uint32 index, const Vector3& contactNormal, decimal penDepth,
                              const Vector3& localPt1, const Vector3& localPt2);
@@ -149,39 +231,99 @@ struct NarrowPhaseInfoBatch {
 
 /// Return the number of objects in the batch
 RP3D_FORCE_INLINE uint32 NarrowPhaseInfoBatch::getNbObjects() const {
-    return static_cast<uint32>(narrowPhaseInfos.size());
+    return mNbObjects;
+}
+
+// Return the number of collision tests with a triangle in the batch
+RP3D_FORCE_INLINE uint32 NarrowPhaseInfoBatch::getNbTriangleObjects() const {
+    return mNbTriangleObjects;
 }
 
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                               CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator) {
+                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo) {
+
+    assert(shape1->isConvex() && shape2->isConvex());
+
+    // Allocate memory if necessary
+    if (mNbObjects == mNbAllocatedObjects) {
+        allocate(mNbAllocatedObjects > 0 ? 2 * mNbAllocatedObjects : INIT_NB_ALLOCATED_OBJECTS);
+    }
+
+    const uint32 index = mNbObjects;
+
+    new (shape1ToWorldTransforms + index) Transform(shape1Transform);
+    new (shape2ToWorldTransforms + index) Transform(shape2Transform);
+    collisionShapes1[index] = shape1;
+    collisionShapes2[index] = shape2;
+    shape1Margins[index] = static_cast<ConvexShape*>(shape1)->getMargin();
+    shape2Margins[index] = static_cast<ConvexShape*>(shape2)->getMargin();
+    reportContacts[index] = needToReportContacts;
+    isColliding[index] = false;
+    nbContactPoints[index] = 0;
+    overlappingPairIds[index] = pairId;
+    new (colliderEntities1 + index) Entity(collider1);
+    new (colliderEntities2 + index) Entity(collider2);
+    lastFrameCollisionInfos[index] = lastFrameInfo;
+    triangles[index] = nullptr;
+
+    mNbObjects++;
+}
+
+// Add a convex shape and a triangle of a concave shape to be tested during narrow-phase collision detection into the batch
+/// The collision shape of the triangle is nullptr in the batch (the triangle has no margin)
+RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addTriangleNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, ConvexShape* convexShape,
+                                                                        const NarrowPhaseTriangle* triangle, bool isShape1Convex,
+                                                                        const Transform& shape1Transform, const Transform& shape2Transform,
+                                                                        bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo) {
+
+    // Allocate memory if necessary
+    if (mNbObjects == mNbAllocatedObjects) {
+        allocate(mNbAllocatedObjects > 0 ? 2 * mNbAllocatedObjects : INIT_NB_ALLOCATED_OBJECTS);
+    }
 
-    // Create a meta data object
-    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shapeAllocator, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
+    const uint32 index = mNbObjects;
+
+    new (shape1ToWorldTransforms + index) Transform(shape1Transform);
+    new (shape2ToWorldTransforms + index) Transform(shape2Transform);
+    collisionShapes1[index] = isShape1Convex ? convexShape : nullptr;
+    collisionShapes2[index] = isShape1Convex ? nullptr : convexShape;
+    shape1Margins[index] = isShape1Convex ? convexShape->getMargin() : decimal(0.0);
+    shape2Margins[index] = isShape1Convex ? decimal(0.0) : convexShape->getMargin();
+    reportContacts[index] = needToReportContacts;
+    isColliding[index] = false;
+    nbContactPoints[index] = 0;
+    overlappingPairIds[index] = pairId;
+    new (colliderEntities1 + index) Entity(collider1);
+    new (colliderEntities2 + index) Entity(collider2);
+    lastFrameCollisionInfos[index] = lastFrameInfo;
+    triangles[index] = triangle;
+
+    mNbObjects++;
+    mNbTriangleObjects++;
 }
 
 // Add a new contact point
+/// This method can be called from a worker thread of the task scheduler
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addContactPoint(uint32 index, const Vector3& contactNormal, decimal penDepth, const Vector3& localPt1, const Vector3& localPt2) {
 
     assert(penDepth > decimal(0.0));
+    assert(index < mNbObjects);
 
-    if (narrowPhaseInfos[index].nbContactPoints < NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO) {
+    if (nbContactPoints[index] < NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO) {
 
         assert(contactNormal.length() > 0.8f);
 
         // Add it into the array of contact points
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].normal = contactNormal;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].penetrationDepth = penDepth;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].localPoint1 = localPt1;
-        narrowPhaseInfos[index].contactPoints[narrowPhaseInfos[index].nbContactPoints].localPoint2 = localPt2;
-        narrowPhaseInfos[index].nbContactPoints++;
+        new (contactPoints[index] + nbContactPoints[index]) ContactPointInfo{contactNormal, localPt1, localPt2, penDepth};
+        nbContactPoints[index]++;
     }
 }
 
 // Reset the remaining contact points
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::resetContactPoints(uint32 index) {
-    narrowPhaseInfos[index].nbContactPoints = 0;
+    nbContactPoints[index] = 0;
 }
 
 }
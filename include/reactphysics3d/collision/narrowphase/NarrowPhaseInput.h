@@ -59,17 +59,25 @@ class NarrowPhaseInput {
         NarrowPhaseInfoBatch mSphereVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mCapsuleVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronBatch;
+        NarrowPhaseInfoBatch mBoxVsBoxBatch;
+        NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronGJKBatch;
+
+        /// Batch of the pairs that reuse their previous contact points (they are not tested)
+        NarrowPhaseInfoBatch mCachedContactsBatch;
 
     public:
 
-        /// Constructor
+        /// Constructor (the contact points allocator must be thread-safe)
         NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs);
 
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                         CollisionShape* shape2, const Transform& shape1Transform,
                         const Transform& shape2Transform, NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
-                        LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                        LastFrameCollisionInfo* lastFrameInfo);
+
+        /// Get a reference to the batch of the convex shape vs triangle tests of a given algorithm
+        NarrowPhaseInfoBatch& getConvexVsTriangleBatch(NarrowPhaseAlgorithmType narrowPhaseAlgorithmType);
 
         /// Get a reference to the sphere vs sphere batch
         NarrowPhaseInfoBatch& getSphereVsSphereBatch();
@@ -89,6 +97,18 @@ class NarrowPhaseInput {
         /// Get a reference to the convex polyhedron vs convex polyhedron batch
         NarrowPhaseInfoBatch& getConvexPolyhedronVsConvexPolyhedronBatch();
 
+        /// Get a reference to the box vs box batch
+        NarrowPhaseInfoBatch& getBoxVsBoxBatch();
+
+        /// Get a reference to the convex polyhedron vs convex polyhedron batch (GJK and EPA algorithms)
+        NarrowPhaseInfoBatch& getConvexPolyhedronVsConvexPolyhedronGJKBatch();
+
+        /// Get a reference to the batch of the pairs that reuse their previous contact points
+        NarrowPhaseInfoBatch& getCachedContactsBatch();
+
+        /// Move the narrow-phase tests of another input at the end of the batches of this input
+        void addNarrowPhaseInput(NarrowPhaseInput& narrowPhaseInput);
+
         /// Reserve memory for the containers with cached capacity
         void reserveMemory();
 
@@ -127,30 +147,50 @@ RP3D_FORCE_INLINE NarrowPhaseInfoBatch &NarrowPhaseInput::getConvexPolyhedronVsC
    return mConvexPolyhedronVsConvexPolyhedronBatch;
 }
 
+// Get a reference to the box vs box batch contacts
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getBoxVsBoxBatch() {
+   return mBoxVsBoxBatch;
+}
+
+// Get a reference to the convex polyhedron vs convex polyhedron batch (GJK and EPA algorithms)
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getConvexPolyhedronVsConvexPolyhedronGJKBatch() {
+   return mConvexPolyhedronVsConvexPolyhedronGJKBatch;
+}
+
+// Get a reference to the batch of the pairs that reuse their previous contact points
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getCachedContactsBatch() {
+   return mCachedContactsBatch;
+}
+
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
                                           const Transform& shape1Transform, const Transform& shape2Transform,
-                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo,
-                                          MemoryAllocator& shapeAllocator) {
+                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo) {
 
     switch (narrowPhaseAlgorithmType) {
         case NarrowPhaseAlgorithmType::SphereVsSphere:
-            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsCapsule:
-            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsCapsule:
-            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
-            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
-            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
-            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
+            break;
+        case NarrowPhaseAlgorithmType::BoxVsBox:
+            mBoxVsBoxBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
+            break;
+        case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronGJK:
+            mConvexPolyhedronVsConvexPolyhedronGJKBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::NoCollisionTest:
             // Must never happen
@@ -158,5 +198,21 @@ RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entit
             break;
     }
 }
+
+// Get a reference to the batch of the convex shape vs triangle tests of a given algorithm
+/// The triangles of a concave shape are tested with the algorithms of the convex polyhedrons
+RP3D_FORCE_INLINE NarrowPhaseInfoBatch& NarrowPhaseInput::getConvexVsTriangleBatch(NarrowPhaseAlgorithmType narrowPhaseAlgorithmType) {
+
+    switch (narrowPhaseAlgorithmType) {
+        case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
+            return mSphereVsConvexPolyhedronBatch;
+        case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
+            return mCapsuleVsConvexPolyhedronBatch;
+        default:
+            assert(narrowPhaseAlgorithmType == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron);
+            return mConvexPolyhedronVsConvexPolyhedronBatch;
+    }
+}
+
 }
 #endif
@@ -129,12 +129,6 @@ class SATAlgorithm {
                                                                  const Vector3& edgeDirectionCapsuleSpace,
                                                                  const Transform& polyhedronToCapsuleTransform, Vector3& outAxis) const;
 
-        /// Compute the contact points between two faces of two convex polyhedra.
-        bool computePolyhedronVsPolyhedronFaceContactPoints(bool isMinPenetrationFaceNormalPolyhedron1, const ConvexPolyhedronShape* polyhedron1,
-                                                            const ConvexPolyhedronShape* polyhedron2, const Transform& polyhedron1ToPolyhedron2,
-                                                            const Transform& polyhedron2ToPolyhedron1, uint32 minFaceIndex,
-                                                            NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const;
-
 
     public :
 
@@ -173,6 +167,12 @@ class SATAlgorithm {
         /// Test collision between two convex meshes
         bool testCollisionConvexPolyhedronVsConvexPolyhedron(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems) const;
 
+        /// Compute the contact points between two faces of two convex polyhedra.
+        bool computePolyhedronVsPolyhedronFaceContactPoints(bool isMinPenetrationFaceNormalPolyhedron1, const ConvexPolyhedronShape* polyhedron1,
+                                                            const ConvexPolyhedronShape* polyhedron2, const Transform& polyhedron1ToPolyhedron2,
+                                                            const Transform& polyhedron2ToPolyhedron1, uint32 minFaceIndex,
+                                                            NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -94,6 +94,10 @@ class CollisionShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const=0;
 
+        /// Raycast method for a packet of rays with feedback information
+        virtual uint32 raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, Collider* collider,
+                                     MemoryAllocator& allocator) const;
+
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const = 0;
 
@@ -115,6 +115,54 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
 #endif
 };
 
+/// Class ConcaveMeshRaycastPacketCallback
+class ConcaveMeshRaycastPacketCallback : public DynamicAABBTreeRaycastPacketCallback {
+
+    private :
+
+        const ConcaveMeshShape& mConcaveMeshShape;
+        Collider* mCollider;
+        RaycastInfo* mRaycastInfos;
+        const Ray* mRays;
+        uint32 mHitRaysMask;
+        MemoryAllocator& mAllocator;
+        const Vector3& mMeshScale;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Pointer to the profiler
+		Profiler* mProfiler;
+
+#endif
+
+    public:
+
+        // Constructor
+        ConcaveMeshRaycastPacketCallback(const ConcaveMeshShape& concaveMeshShape, Collider* collider, RaycastInfo* raycastInfos,
+                                         const Ray* rays, const Vector3& meshScale, MemoryAllocator& allocator)
+            : mConcaveMeshShape(concaveMeshShape), mCollider(collider), mRaycastInfos(raycastInfos), mRays(rays),
+              mHitRaysMask(0), mAllocator(allocator), mMeshScale(meshScale) {
+
+        }
+
+        /// Raycast the triangle of a leaf node with the rays of the packet that hit its AABB
+        virtual uint32 raycastBroadPhaseShape(int32 nodeId, uint32 raysMask, decimal* raysMaxFractions) override;
+
+        /// Return the mask of the rays that hit a triangle
+        uint32 getHitRaysMask() const {
+            return mHitRaysMask;
+        }
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Set the profiler
+		void setProfiler(Profiler* profiler) {
+			mProfiler = profiler;
+		}
+
+#endif
+};
+
 // Class ConcaveMeshShape
 /**
  * This class represents a static concave mesh shape. Note that collision detection
@@ -144,6 +192,10 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const override;
 
+        /// Raycast method for a packet of rays with feedback information
+        virtual uint32 raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, Collider* collider,
+                                     MemoryAllocator& allocator) const override;
+
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const override;
 
@@ -218,6 +270,7 @@ class ConcaveMeshShape : public ConcaveShape {
 
         friend class ConvexTriangleAABBOverlapCallback;
         friend class ConcaveMeshRaycastCallback;
+        friend class ConcaveMeshRaycastPacketCallback;
         friend class PhysicsCommon;
         friend class DebugRenderer;
 };
@@ -49,6 +49,12 @@ class ConvexMeshShape : public ConvexPolyhedronShape {
 
     protected :
 
+        // -------------------- Constants -------------------- //
+
+        /// Minimum number of vertices of the mesh to search the support vertex with hill-climbing
+        /// (for smaller meshes, testing all the vertices with SIMD instructions is faster)
+        static const uint32 MIN_NB_VERTICES_HILL_CLIMBING = 32;
+
         // -------------------- Attributes -------------------- //
 
         /// Convex mesh
@@ -68,6 +74,10 @@ class ConvexMeshShape : public ConvexPolyhedronShape {
         /// Return a local support point in a given direction without the object margin.
         virtual Vector3 getLocalSupportPointWithoutMargin(const Vector3& direction) const override;
 
+        /// Return a local support point in a given direction without the object margin, starting
+        /// the search at a cached vertex of the shape (the cached vertex is updated)
+        virtual Vector3 getLocalSupportPointWithoutMarginFromVertex(const Vector3& direction, uint32& vertexIndex) const override;
+
         /// Return true if a point is inside the collision shape
         virtual bool testPointInside(const Vector3& localPoint, Collider* collider) const override;
 
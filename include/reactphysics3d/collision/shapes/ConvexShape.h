@@ -54,6 +54,10 @@ class ConvexShape : public CollisionShape {
         /// Return a local support point in a given direction without the object margin
         virtual Vector3 getLocalSupportPointWithoutMargin(const Vector3& direction) const=0;
 
+        /// Return a local support point in a given direction without the object margin, starting
+        /// the search at a cached vertex of the shape (the cached vertex is updated)
+        virtual Vector3 getLocalSupportPointWithoutMarginFromVertex(const Vector3& direction, uint32& vertexIndex) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -79,6 +83,7 @@ class ConvexShape : public CollisionShape {
         // -------------------- Friendship -------------------- //
 
         friend class GJKAlgorithm;
+        friend class EPAAlgorithm;
         friend class SATAlgorithm;
 };
 
@@ -184,6 +184,7 @@ class TriangleShape : public ConvexPolyhedronShape {
         // ---------- Friendship ---------- //
 
         friend class ConcaveMeshRaycastCallback;
+        friend class ConcaveMeshRaycastPacketCallback;
         friend class TriangleOverlapCallback;
         friend class MiddlePhaseTriangleCallback;
         friend class HeightField;
@@ -140,6 +140,7 @@ class BodyComponents : public Components {
         // -------------------- Friendship -------------------- //
 
         friend class Body;
+        friend class PhysicsWorld;
 };
 
 // Add a collider to a body component
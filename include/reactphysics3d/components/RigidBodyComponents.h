@@ -150,9 +150,6 @@ class RigidBodyComponents : public Components {
         /// For each body, the array of joints entities the body is part of
         Array<Entity>* mJoints;
 
-        /// For each body, the array of the indices of contact pairs in which the body is involved
-        Array<uint>* mContactPairs;
-
         /// For each body, the vector of lock translation vectors
         Vector3* mLinearLockAxisFactors;
 
@@ -341,6 +338,12 @@ class RigidBodyComponents : public Components {
         /// Set the split angular velocity of an entity
         void setSplitAngularVelocity(Entity bodyEntity, const Vector3& splitAngularVelocity);
 
+        /// Write the constrained velocities of the component at a given index if it is a dynamic body
+        void updateConstrainedVelocitiesOfDynamicBody(uint32 index, const Vector3& linearVelocity, const Vector3& angularVelocity);
+
+        /// Write the split velocities of the component at a given index if it is a dynamic body
+        void updateSplitVelocitiesOfDynamicBody(uint32 index, const Vector3& splitLinearVelocity, const Vector3& splitAngularVelocity);
+
         /// Set the constrained position of an entity
         void setConstrainedPosition(Entity bodyEntity, const Vector3& constrainedPosition);
 
@@ -374,12 +377,6 @@ class RigidBodyComponents : public Components {
         /// Remove a joint from a body component
         void removeJointFromBody(Entity bodyEntity, Entity jointEntity);
 
-        /// A an associated contact pairs into the contact pairs array of the body
-        void addContacPair(Entity bodyEntity, uint32 contactPairIndex);
-
-        /// Remove all the contact pairs of a body
-        void removeAllContacPairs(Entity bodyEntity);
-
         // -------------------- Friendship -------------------- //
 
         friend class PhysicsWorld;
@@ -855,18 +852,31 @@ RP3D_FORCE_INLINE void RigidBodyComponents::removeJointFromBody(Entity bodyEntit
     mJoints[mMapEntityToComponentIndex[bodyEntity]].remove(jointEntity);
 }
 
-// A an associated contact pairs into the contact pairs array of the body
-RP3D_FORCE_INLINE void RigidBodyComponents::addContacPair(Entity bodyEntity, uint32 contactPairIndex) {
+// Write the constrained velocities of the component at a given index if it is a dynamic body
+/// The solvers never change the velocities of static and kinematic bodies (zero inverse mass and
+/// inertia). Skipping them allows a static body shared by several islands to be used by
+/// islands that are solved in parallel.
+RP3D_FORCE_INLINE void RigidBodyComponents::updateConstrainedVelocitiesOfDynamicBody(uint32 index, const Vector3& linearVelocity,
+                                                                                    const Vector3& angularVelocity) {
 
-    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
-    mContactPairs[mMapEntityToComponentIndex[bodyEntity]].add(contactPairIndex);
+    assert(index < mNbComponents);
+
+    if (mBodyTypes[index] == BodyType::DYNAMIC) {
+        mConstrainedLinearVelocities[index] = linearVelocity;
+        mConstrainedAngularVelocities[index] = angularVelocity;
+    }
 }
 
-// Remove all the contact pairs of a body
-RP3D_FORCE_INLINE void RigidBodyComponents::removeAllContacPairs(Entity bodyEntity) {
+// Write the split velocities of the component at a given index if it is a dynamic body
+RP3D_FORCE_INLINE void RigidBodyComponents::updateSplitVelocitiesOfDynamicBody(uint32 index, const Vector3& splitLinearVelocity,
+                                                                              const Vector3& splitAngularVelocity) {
 
-    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
-    mContactPairs[mMapEntityToComponentIndex[bodyEntity]].clear();
+    assert(index < mNbComponents);
+
+    if (mBodyTypes[index] == BodyType::DYNAMIC) {
+        mSplitLinearVelocities[index] = splitLinearVelocity;
+        mSplitAngularVelocities[index] = splitAngularVelocity;
+    }
 }
 
 }
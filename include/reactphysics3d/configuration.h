@@ -148,6 +148,39 @@ constexpr decimal SAME_CONTACT_POINT_DISTANCE_THRESHOLD = decimal(0.01);
 /// Global alignment (in bytes) that all allocators must enforce
 constexpr uint8 GLOBAL_ALIGNMENT = 16;
 
+/// Number of items processed by a single task when a loop over components is executed in parallel
+constexpr uint32 PARALLEL_FOR_CHUNK_SIZE = 256;
+
+/// Number of moved colliders tested against the broad-phase tree by a single task
+constexpr uint32 BROAD_PHASE_CHUNK_SIZE = 64;
+
+/// Number of convex vs convex overlapping pairs processed by a single task of the middle-phase
+constexpr uint32 MIDDLE_PHASE_CONVEX_PAIRS_CHUNK_SIZE = 256;
+
+/// Number of convex vs concave overlapping pairs processed by a single task of the middle-phase
+constexpr uint32 MIDDLE_PHASE_CONCAVE_PAIRS_CHUNK_SIZE = 8;
+
+/// Number of narrow-phase collision tests of a batch processed by a single task
+constexpr uint32 NARROW_PHASE_CHUNK_SIZE = 32;
+
+/// Maximum number of triangle shapes created on the stack at the same time to test the triangles of a narrow-phase batch
+constexpr uint32 NARROW_PHASE_TRIANGLES_SUB_RANGE_SIZE = 16;
+
+/// Minimum number of constraints (contact manifolds and joints) solved by a single task when the islands are solved in parallel
+constexpr uint32 PARALLEL_ISLANDS_BATCH_MIN_NB_CONSTRAINTS = 64;
+
+/// Minimum number of contact manifolds in an island to partition its contacts into colors that are solved in parallel
+constexpr uint32 GRAPH_COLORING_MIN_NB_CONTACT_MANIFOLDS = 256;
+
+/// Number of contact manifolds of a color processed by a single task
+constexpr uint32 PARALLEL_COLOR_CHUNK_SIZE = 32;
+
+/// Number of rays of a batched raycast processed by a single task (multiple of the size of a ray packet)
+constexpr uint32 RAYCAST_BATCH_CHUNK_SIZE = 64;
+
+/// Initial size (in bytes) of the frame allocator of each worker of the task scheduler
+constexpr size_t INIT_WORKER_FRAME_ALLOCATOR_NB_BYTES = 65536;
+
 /// Current version of ReactPhysics3D
 const std::string RP3D_VERSION = std::string("0.10.0");
 
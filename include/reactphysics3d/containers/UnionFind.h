@@ -0,0 +1,181 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_UNION_FIND_H
+#define REACTPHYSICS3D_UNION_FIND_H
+
+// Libraries
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+
+namespace reactphysics3d {
+
+// Class UnionFind
+/**
+ * This class represents a fixed number of elements [0, n) partitioned into disjoint sets.
+ * The merge() and find() methods can be called concurrently from several threads. The
+ * root of two merged sets is always the smallest of the two roots. Therefore, the root of
+ * a set is its smallest element, whatever the order in which the sets have been merged.
+ */
+class UnionFind {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Reference to the memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// For each element, index of its parent element (an element is a root if it is its own parent)
+        std::atomic<uint32>* mParents;
+
+        /// Number of elements
+        uint32 mNbElements;
+
+        /// Number of allocated elements (an integral multiple of the alignment)
+        uint32 mNbAllocatedElements;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor (each element is in its own set)
+        UnionFind(MemoryAllocator& allocator, uint32 nbElements)
+            : mAllocator(allocator), mParents(nullptr), mNbElements(nbElements),
+              mNbAllocatedElements(static_cast<uint32>(std::ceil(nbElements / float(GLOBAL_ALIGNMENT))) * GLOBAL_ALIGNMENT) {
+
+            if (mNbElements > 0) {
+
+                mParents = static_cast<std::atomic<uint32>*>(mAllocator.allocate(mNbAllocatedElements * sizeof(std::atomic<uint32>)));
+                assert(mParents != nullptr);
+
+                for (uint32 i=0; i < mNbElements; i++) {
+                    new (mParents + i) std::atomic<uint32>(i);
+                }
+            }
+        }
+
+        /// Destructor
+        ~UnionFind() {
+
+            if (mNbElements > 0) {
+
+                for (uint32 i=0; i < mNbElements; i++) {
+                    mParents[i].~atomic<uint32>();
+                }
+
+                mAllocator.release(mParents, mNbAllocatedElements * sizeof(std::atomic<uint32>));
+            }
+        }
+
+        /// Deleted copy-constructor
+        UnionFind(const UnionFind& unionFind) = delete;
+
+        /// Deleted assignment operator
+        UnionFind& operator=(const UnionFind& unionFind) = delete;
+
+        /// Return the root of the set of an element
+        uint32 find(uint32 element) {
+
+            assert(element < mNbElements);
+
+            uint32 parent = mParents[element].load(std::memory_order_acquire);
+            while (parent != element) {
+
+                // Path halving: make the element point to its grand-parent. If another thread
+                // has modified the parent in the meantime, its new parent is also an ancestor
+                const uint32 grandParent = mParents[parent].load(std::memory_order_acquire);
+                if (grandParent != parent) {
+                    mParents[element].compare_exchange_weak(parent, grandParent, std::memory_order_acq_rel);
+                }
+
+                element = grandParent;
+                parent = mParents[element].load(std::memory_order_acquire);
+            }
+
+            return element;
+        }
+
+        /// Merge the sets of two elements
+        void merge(uint32 element1, uint32 element2) {
+
+            while (true) {
+
+                uint32 root1 = find(element1);
+                uint32 root2 = find(element2);
+
+                if (root1 == root2) return;
+
+                // The largest root is linked under the smallest one
+                if (root1 < root2) {
+                    std::swap(root1, root2);
+                }
+
+                // The link only succeeds if root1 is still a root (it might have
+                // been linked under another root by another thread)
+                uint32 expected = root1;
+                if (mParents[root1].compare_exchange_strong(expected, root2, std::memory_order_acq_rel)) {
+                    return;
+                }
+
+                element1 = root1;
+                element2 = root2;
+            }
+        }
+
+        /// Make each element point directly to the root of its set.
+        /// This method must not be called concurrently with merge()
+        void flatten() {
+
+            // Since the parent of an element is never larger than the element,
+            // the parents are always flattened before their children
+            for (uint32 i=0; i < mNbElements; i++) {
+
+                const uint32 parent = mParents[i].load(std::memory_order_relaxed);
+                assert(parent <= i);
+                mParents[i].store(mParents[parent].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+
+        /// Return the root of the set of an element after a call to flatten()
+        uint32 getFlattenedRoot(uint32 element) const {
+
+            assert(element < mNbElements);
+            return mParents[element].load(std::memory_order_relaxed);
+        }
+
+        /// Return the number of elements
+        uint32 getNbElements() const {
+            return mNbElements;
+        }
+};
+
+}
+
+#endif
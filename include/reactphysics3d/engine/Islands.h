@@ -52,6 +52,9 @@ struct Islands {
         /// Number of items in the bodyEntities array in the previous frame
         uint32 mNbBodyEntitiesPreviousFrame;
 
+        /// Number of items in the jointEntities array in the previous frame
+        uint32 mNbJointEntitiesPreviousFrame;
+
         /// Maximum number of bodies in a single island in the previous frame
         uint32 mNbMaxBodiesInIslandPreviousFrame;
 
@@ -78,13 +81,24 @@ struct Islands {
         /// For each island, total number of bodies in the island
         Array<uint32> nbBodiesInIsland;
 
+        /// Array of all the entities of the joints in the islands (stored sequentially)
+        Array<Entity> jointEntities;
+
+        /// For each island we store the starting index of the joints of that island in the "jointEntities" array
+        Array<uint32> startJointEntitiesIndex;
+
+        /// For each island, total number of joints in the island
+        Array<uint32> nbJointsInIsland;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
         Islands(MemoryAllocator& allocator)
-            :mNbIslandsPreviousFrame(16), mNbBodyEntitiesPreviousFrame(32), mNbMaxBodiesInIslandPreviousFrame(0), mNbMaxBodiesInIslandCurrentFrame(0),
+            :mNbIslandsPreviousFrame(16), mNbBodyEntitiesPreviousFrame(32), mNbJointEntitiesPreviousFrame(0),
+             mNbMaxBodiesInIslandPreviousFrame(0), mNbMaxBodiesInIslandCurrentFrame(0),
              contactManifoldsIndices(allocator), nbContactManifolds(allocator),
-             bodyEntities(allocator), startBodyEntitiesIndex(allocator), nbBodiesInIsland(allocator) {
+             bodyEntities(allocator), startBodyEntitiesIndex(allocator), nbBodiesInIsland(allocator),
+             jointEntities(allocator), startJointEntitiesIndex(allocator), nbJointsInIsland(allocator) {
 
         }
 
@@ -111,6 +125,8 @@ struct Islands {
             nbContactManifolds.add(0);
             startBodyEntitiesIndex.add(static_cast<uint32>(bodyEntities.size()));
             nbBodiesInIsland.add(0);
+            startJointEntitiesIndex.add(static_cast<uint32>(jointEntities.size()));
+            nbJointsInIsland.add(0);
 
             if (islandIndex > 0 && nbBodiesInIsland[islandIndex-1] > mNbMaxBodiesInIslandCurrentFrame) {
                 mNbMaxBodiesInIslandCurrentFrame = nbBodiesInIsland[islandIndex-1];
@@ -128,6 +144,16 @@ struct Islands {
             nbBodiesInIsland[islandIndex - 1]++;
         }
 
+        /// Add a joint into the last created island
+        void addJointToIsland(Entity jointEntity) {
+
+            const uint32 islandIndex = static_cast<uint32>(contactManifoldsIndices.size());
+            assert(islandIndex > 0);
+
+            jointEntities.add(jointEntity);
+            nbJointsInIsland[islandIndex - 1]++;
+        }
+
         /// Reserve memory for the current frame
         void reserveMemory() {
 
@@ -135,8 +161,11 @@ struct Islands {
             nbContactManifolds.reserve(mNbIslandsPreviousFrame);
             startBodyEntitiesIndex.reserve(mNbIslandsPreviousFrame);
             nbBodiesInIsland.reserve(mNbIslandsPreviousFrame);
+            startJointEntitiesIndex.reserve(mNbIslandsPreviousFrame);
+            nbJointsInIsland.reserve(mNbIslandsPreviousFrame);
 
             bodyEntities.reserve(mNbBodyEntitiesPreviousFrame);
+            jointEntities.reserve(mNbJointEntitiesPreviousFrame);
         }
 
         /// Clear all the islands
@@ -152,12 +181,16 @@ struct Islands {
             mNbIslandsPreviousFrame = nbIslands;
             mNbMaxBodiesInIslandCurrentFrame = 0;
             mNbBodyEntitiesPreviousFrame = static_cast<uint32>(bodyEntities.size());
+            mNbJointEntitiesPreviousFrame = static_cast<uint32>(jointEntities.size());
 
             contactManifoldsIndices.clear(true);
             nbContactManifolds.clear(true);
             bodyEntities.clear(true);
             startBodyEntitiesIndex.clear(true);
             nbBodiesInIsland.clear(true);
+            jointEntities.clear(true);
+            startJointEntitiesIndex.clear(true);
+            nbJointsInIsland.clear(true);
         }
 
         uint32 getNbMaxBodiesInIslandPreviousFrame() const {
@@ -28,6 +28,7 @@
 
 // Libraries
 #include <reactphysics3d/collision/Collider.h>
+#include <reactphysics3d/collision/ContactPointInfo.h>
 #include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/containers/Pair.h>
 #include <reactphysics3d/containers/Set.h>
@@ -37,6 +38,7 @@
 #include <reactphysics3d/components/BodyComponents.h>
 #include <reactphysics3d/components/RigidBodyComponents.h>
 #include <cstddef>
+#include <algorithm>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -76,6 +78,10 @@ struct LastFrameCollisionInfo {
     /// Previous separating axis
     Vector3 gjkSeparatingAxis;
 
+    /// Previous support vertices of the two shapes (start of the hill-climbing of the convex meshes)
+    uint32 gjkSupportVertexIndex1;
+    uint32 gjkSupportVertexIndex2;
+
     // SAT Algorithm
     bool satIsAxisFacePolyhedron1;
     bool satIsAxisFacePolyhedron2;
@@ -86,12 +92,27 @@ struct LastFrameCollisionInfo {
     /// Constructor
     LastFrameCollisionInfo()
         :isValid(false), isObsolete(false), wasColliding(false), wasUsingGJK(false), wasUsingSAT(false), gjkSeparatingAxis(Vector3(0, 1, 0)),
+         gjkSupportVertexIndex1(0), gjkSupportVertexIndex2(0),
          satIsAxisFacePolyhedron1(false), satIsAxisFacePolyhedron2(false), satMinAxisFaceIndex(0),
          satMinEdge1Index(0), satMinEdge2Index(0) {
 
     }
 };
 
+// Structure TriangleLastFrameCollisionInfo
+/**
+ * This structure contains the collision info about the last frame of a
+ * triangle of the concave shape of a convex vs concave overlapping pair.
+ */
+struct TriangleLastFrameCollisionInfo {
+
+    /// Id of the triangle in the concave shape
+    uint32 triangleId;
+
+    /// Collision info about the last frame
+    LastFrameCollisionInfo lastFrameInfo;
+};
+
 // Class OverlappingPairs
 /**
  * This class contains pairs of two colliders that are overlapping
@@ -159,16 +180,32 @@ class OverlappingPairs {
         // Overlapping pair between two convex colliders
         struct ConvexOverlappingPair : public OverlappingPair {
 
+            /// Maximum number of contact points that are cached for the narrow-phase temporal coherence
+            static constexpr uint8 NB_MAX_CACHED_CONTACT_POINTS = 4;
+
             /// Temporal coherence collision data for each overlapping collision shapes of this pair.
             /// Temporal coherence data store collision information about the last frame.
             /// If two convex shapes overlap, we have a single collision data but if one shape is concave,
             /// we might have collision data for several overlapping triangles.
             LastFrameCollisionInfo lastFrameCollisionInfo;
 
+            /// Transform from the local-space of collider 2 to the local-space of collider 1 at the
+            /// last narrow-phase test of the pair (narrow-phase temporal coherence)
+            Transform cachedRelativeTransform;
+
+            /// Number of contact points cached at the last narrow-phase test of the pair (zero if
+            /// the contact points cannot be reused)
+            uint8 nbCachedContactPoints;
+
+            /// Contact points cached at the last narrow-phase test of the pair (the normals are
+            /// in local-space of collider 1)
+            ContactPointInfo cachedContactPoints[NB_MAX_CACHED_CONTACT_POINTS];
+
             /// Constructor
             ConvexOverlappingPair(uint64 pairId, int32 broadPhaseId1, int32 broadPhaseId2, Entity collider1, Entity collider2,
                             NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool isEnabled)
-              : OverlappingPair(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, narrowPhaseAlgorithmType, isEnabled) {
+              : OverlappingPair(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, narrowPhaseAlgorithmType, isEnabled),
+                nbCachedContactPoints(0) {
 
             }
         };
@@ -178,109 +215,111 @@ class OverlappingPairs {
 
             private:
 
-                MemoryAllocator* mPoolAllocator;
+                /// Return the last frame collision info of a triangle in the first infos of the array (or nullptr if there is none)
+                TriangleLastFrameCollisionInfo* findLastFrameInfo(uint32 triangleId, uint64 nbInfos) {
+
+                    TriangleLastFrameCollisionInfo* infosStart = nbInfos > 0 ? &(lastFrameCollisionInfos[0]) : nullptr;
+                    TriangleLastFrameCollisionInfo* infosEnd = infosStart + nbInfos;
+                    TriangleLastFrameCollisionInfo* it = std::lower_bound(infosStart, infosEnd, triangleId,
+                                                                          [](const TriangleLastFrameCollisionInfo& info, uint32 id) {
+                                                                              return info.triangleId < id;
+                                                                          });
+                    return (it != infosEnd && it->triangleId == triangleId) ? it : nullptr;
+                }
 
             public:
 
                 /// True if the first shape of the pair is convex
                 bool isShape1Convex;
 
-                /// Temporal coherence collision data for each overlapping collision shapes of this pair.
-                /// Temporal coherence data store collision information about the last frame.
-                /// If two convex shapes overlap, we have a single collision data but if one shape is concave,
-                /// we might have collision data for several overlapping triangles. The key in the map is the
-                /// shape Ids of the two collision shapes.
-                Map<uint64, LastFrameCollisionInfo*> lastFrameCollisionInfos;
+                /// Temporal coherence collision data for each overlapping triangle of the concave shape of this pair.
+                /// Temporal coherence data store collision information about the last frame. The infos are stored
+                /// contiguously and sorted by triangle id such that the info of a triangle is found with a binary
+                /// search and that no memory is allocated for each triangle.
+                Array<TriangleLastFrameCollisionInfo> lastFrameCollisionInfos;
 
                 /// Constructor
                 ConcaveOverlappingPair(uint64 pairId, int32 broadPhaseId1, int32 broadPhaseId2, Entity collider1, Entity collider2,
                                 NarrowPhaseAlgorithmType narrowPhaseAlgorithmType,
-                                bool isShape1Convex, MemoryAllocator& poolAllocator, MemoryAllocator& heapAllocator, bool isEnabled,
+                                bool isShape1Convex, MemoryAllocator& heapAllocator, bool isEnabled,
                                 bool allocateLastFrameCollisionInfos = true)
-                  : OverlappingPair(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, narrowPhaseAlgorithmType, isEnabled), mPoolAllocator(&poolAllocator),
+                  : OverlappingPair(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, narrowPhaseAlgorithmType, isEnabled),
                     isShape1Convex(isShape1Convex), lastFrameCollisionInfos(heapAllocator, allocateLastFrameCollisionInfos ? 16 : 0) {
 
                 }
 
                 // Destroy all the LastFrameCollisionInfo objects
                 void destroyLastFrameCollisionInfos() {
+                    lastFrameCollisionInfos.clear(true);
+                }
 
-                    for (auto it = lastFrameCollisionInfos.begin(); it != lastFrameCollisionInfos.end(); ++it) {
+                // Return the last frame collision infos of some triangles and add the ones that do not exist yet
+                /// The returned pointers are valid until the last frame collision infos of the pair are modified again
+                void addLastFrameInfosIfNecessary(const uint32* triangleIds, uint32 nbTriangles, LastFrameCollisionInfo** outLastFrameInfos) {
 
-                        // Call the destructor
-                        it->second->LastFrameCollisionInfo::~LastFrameCollisionInfo();
+                    // Find the existing collision infos (they are not obsolete anymore) and add
+                    // the missing ones at the end of the array
+                    const uint64 nbExistingInfos = lastFrameCollisionInfos.size();
+                    for (uint32 i=0; i < nbTriangles; i++) {
 
-                        // Release memory
-                        mPoolAllocator->release(it->second, sizeof(LastFrameCollisionInfo));
+                        TriangleLastFrameCollisionInfo* info = findLastFrameInfo(triangleIds[i], nbExistingInfos);
+                        if (info != nullptr) {
+                            info->lastFrameInfo.isObsolete = false;
+                        }
+                        else {
+                            lastFrameCollisionInfos.add(TriangleLastFrameCollisionInfo{triangleIds[i], LastFrameCollisionInfo()});
+                        }
                     }
 
-                    lastFrameCollisionInfos.clear();
-                }
-
-                // Add a new last frame collision info if it does not exist for the given shapes already
-                LastFrameCollisionInfo* addLastFrameInfoIfNecessary(uint32 shapeId1, uint32 shapeId2) {
+                    const uint64 nbInfos = lastFrameCollisionInfos.size();
 
-                    uint32 maxShapeId = shapeId1;
-                    uint32 minShapeId = shapeId2;
-                    if (shapeId1 < shapeId2) {
-                       maxShapeId = shapeId2;
-                       minShapeId = shapeId1;
+                    // Sort the infos by triangle id again if some infos have been added
+                    if (nbInfos > nbExistingInfos) {
+                        std::sort(&(lastFrameCollisionInfos[0]), &(lastFrameCollisionInfos[0]) + nbInfos,
+                                  [](const TriangleLastFrameCollisionInfo& info1, const TriangleLastFrameCollisionInfo& info2) {
+                                      return info1.triangleId < info2.triangleId;
+                                  });
                     }
 
-                    // Try to get the corresponding last frame collision info
-                    const uint64 shapesId = pairNumbers(maxShapeId, minShapeId);
-
-                    // If there is no collision info for those two shapes already
-                    auto it = lastFrameCollisionInfos.find(shapesId);
-                    if (it == lastFrameCollisionInfos.end()) {
-
-                        // Make sure capacity is an integral multiple of alignment
-                        const size_t allocatedMemory = (size_t)std::ceil(sizeof(LastFrameCollisionInfo) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
-
-                        LastFrameCollisionInfo* lastFrameInfo = new (mPoolAllocator->allocate(allocatedMemory)) LastFrameCollisionInfo();
-
-                        // Add it into the map of collision infos
-                        lastFrameCollisionInfos.add(Pair<uint64, LastFrameCollisionInfo*>(shapesId, lastFrameInfo));
-
-                        return lastFrameInfo;
+                    for (uint32 i=0; i < nbTriangles; i++) {
+                        TriangleLastFrameCollisionInfo* info = findLastFrameInfo(triangleIds[i], nbInfos);
+                        assert(info != nullptr);
+                        outLastFrameInfos[i] = &(info->lastFrameInfo);
                     }
-                    else {
+                }
 
-                       // The existing collision info is not obsolete
-                       it->second->isObsolete = false;
+                // Return the last frame collision info of a given triangle (or nullptr if there is none)
+                /// Contrary to addLastFrameInfosIfNecessary(), this method does not modify the pair
+                LastFrameCollisionInfo* getLastFrameInfo(uint32 triangleId) const {
 
-                       return it->second;
-                    }
+                    // The info is returned as non-const because it is given to the narrow-phase (that only reads it
+                    // in the concurrent queries mode)
+                    TriangleLastFrameCollisionInfo* info = const_cast<ConcaveOverlappingPair*>(this)->findLastFrameInfo(triangleId, lastFrameCollisionInfos.size());
+                    return info != nullptr ? &(info->lastFrameInfo) : nullptr;
                 }
 
                 /// Clear the obsolete LastFrameCollisionInfo objects
                 void clearObsoleteLastFrameInfos() {
 
-                    // For each last frame collision info
-                    for (auto it = lastFrameCollisionInfos.begin(); it != lastFrameCollisionInfos.end(); ) {
-
-                        // If the collision info is obsolete
-                        if (it->second->isObsolete) {
-
-                            // Call the destructor
-                            it->second->LastFrameCollisionInfo::~LastFrameCollisionInfo();
+                    // Move the infos that are not obsolete at the beginning of the array (in the same order)
+                    const uint64 nbInfos = lastFrameCollisionInfos.size();
+                    uint64 nbKeptInfos = 0;
+                    for (uint64 i=0; i < nbInfos; i++) {
 
-                            // Make sure capacity is an integral multiple of alignment
-                            const size_t allocatedMemory = (size_t)std::ceil(sizeof(LastFrameCollisionInfo) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
-
-                            // Release memory
-                            mPoolAllocator->release(it->second, allocatedMemory);
-
-                            it = lastFrameCollisionInfos.remove(it);
-                        }
-                        else {  // If the collision info is not obsolete
+                        // If the collision info is not obsolete
+                        if (!lastFrameCollisionInfos[i].lastFrameInfo.isObsolete) {
 
                             // Do not delete it but mark it as obsolete
-                            it->second->isObsolete = true;
-
-                            ++it;
+                            lastFrameCollisionInfos[nbKeptInfos] = lastFrameCollisionInfos[i];
+                            lastFrameCollisionInfos[nbKeptInfos].lastFrameInfo.isObsolete = true;
+                            nbKeptInfos++;
                         }
                     }
+
+                    // Remove the obsolete infos at the end of the array
+                    while (lastFrameCollisionInfos.size() > nbKeptInfos) {
+                        lastFrameCollisionInfos.removeAt(lastFrameCollisionInfos.size() - 1);
+                    }
                 }
         };
 
@@ -421,6 +460,9 @@ class OverlappingPairs {
         /// Return a reference to an overlapping pair
         OverlappingPair* getOverlappingPair(uint64 pairId);
 
+        /// Return a pointer to a convex vs convex overlapping pair (nullptr if the pair is not convex)
+        ConvexOverlappingPair* getConvexOverlappingPair(uint64 pairId);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Set the profiler
@@ -482,6 +524,21 @@ RP3D_FORCE_INLINE OverlappingPairs::OverlappingPair* OverlappingPairs::getOverla
     return nullptr;
 }
 
+// Return a pointer to a convex vs convex overlapping pair (nullptr if the pair is not convex)
+RP3D_FORCE_INLINE OverlappingPairs::ConvexOverlappingPair* OverlappingPairs::getConvexOverlappingPair(uint64 pairId) {
+
+    auto it = mMapConvexPairIdToPairIndex.find(pairId);
+    if (it != mMapConvexPairIdToPairIndex.end()) {
+        return &(mConvexPairs[static_cast<uint32>(it->second)]);
+    }
+    it = mMapDisabledConvexPairIdToPairIndex.find(pairId);
+    if (it != mMapDisabledConvexPairIdToPairIndex.end()) {
+        return &(mDisabledConvexPairs[static_cast<uint32>(it->second)]);
+    }
+
+    return nullptr;
+}
+
 // Return true if a given pair is disabled (both bodies of the pair are disabled)
 RP3D_FORCE_INLINE bool OverlappingPairs::isPairDisabled(uint64 pairId) const {
     return mMapDisabledConvexPairIdToPairIndex.containsKey(pairId) || mMapDisabledConcavePairIdToPairIndex.containsKey(pairId);
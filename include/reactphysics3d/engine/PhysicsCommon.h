@@ -39,6 +39,7 @@
 #include <reactphysics3d/collision/ConvexMesh.h>
 #include <reactphysics3d/collision/HeightField.h>
 #include <reactphysics3d/utils/DefaultLogger.h>
+#include <reactphysics3d/utils/DefaultTaskScheduler.h>
 #include <reactphysics3d/collision/PolygonVertexArray.h>
 #include <reactphysics3d/collision/VertexArray.h>
 
@@ -101,6 +102,12 @@ class PhysicsCommon {
         /// Set of default loggers
         Set<DefaultLogger*> mDefaultLoggers;
 
+        /// Task scheduler used by the physics worlds that do not specify their own scheduler
+        TaskScheduler* mTaskScheduler;
+
+        /// Set of default task schedulers
+        Set<DefaultTaskScheduler*> mDefaultTaskSchedulers;
+
         /// Half-edge structure of a box polyhedron
         HalfEdgeStructure mBoxShapeHalfEdgeStructure;
 
@@ -148,6 +155,9 @@ class PhysicsCommon {
         /// Delete a default logger
         void deleteDefaultLogger(DefaultLogger* logger);
 
+        /// Delete a default task scheduler
+        void deleteDefaultTaskScheduler(DefaultTaskScheduler* taskScheduler);
+
         /// Initialize the half-edge structure of a BoxShape
         void initBoxShapeHalfEdgeStructure();
 
@@ -173,7 +183,7 @@ class PhysicsCommon {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        PhysicsCommon(MemoryAllocator* baseMemoryAllocator = nullptr);
+        PhysicsCommon(MemoryAllocator* baseMemoryAllocator = nullptr, bool useConcurrentPoolAllocator = false);
 
         /// Destructor
         ~PhysicsCommon();
@@ -184,6 +194,9 @@ class PhysicsCommon {
         /// Destroy an instance of PhysicsWorld
         void destroyPhysicsWorld(PhysicsWorld* world);
 
+        /// Update several physics worlds in parallel
+        void updatePhysicsWorlds(const std::vector<PhysicsWorld*>& worlds, decimal timeStep);
+
         /// Create and return a sphere collision shape
         SphereShape* createSphereShape(const decimal radius);
 
@@ -256,6 +269,18 @@ class PhysicsCommon {
         /// Set the logger
         static void setLogger(Logger* logger);
 
+        /// Create and return a new default task scheduler
+        DefaultTaskScheduler* createDefaultTaskScheduler(uint32 nbWorkers = 0);
+
+        /// Destroy a default task scheduler
+        void destroyDefaultTaskScheduler(DefaultTaskScheduler* taskScheduler);
+
+        /// Return the task scheduler used by the physics worlds
+        TaskScheduler* getTaskScheduler() const;
+
+        /// Set the task scheduler used by the physics worlds created after this call
+        void setTaskScheduler(TaskScheduler* taskScheduler);
+
 
         // ---------- Friendship ---------- //
 
@@ -280,6 +305,27 @@ RP3D_FORCE_INLINE void PhysicsCommon::setLogger(Logger* logger) {
     mLogger = logger;
 }
 
+// Return the task scheduler used by the physics worlds
+/**
+ * @return A pointer to the task scheduler (nullptr if no physics world has been created yet
+ *         and no scheduler has been set)
+ */
+RP3D_FORCE_INLINE TaskScheduler* PhysicsCommon::getTaskScheduler() const {
+    return mTaskScheduler;
+}
+
+// Set the task scheduler used by the physics worlds created after this call
+/// If no task scheduler is set, a default task scheduler with a single worker is created with the
+/// first physics world. Set a task scheduler with several workers (see createDefaultTaskScheduler())
+/// to execute the work of the physics worlds with several threads. A physics world can also use its
+/// own scheduler (see WorldSettings::taskScheduler).
+/**
+ * @param taskScheduler A pointer to the task scheduler to use
+ */
+RP3D_FORCE_INLINE void PhysicsCommon::setTaskScheduler(TaskScheduler* taskScheduler) {
+    mTaskScheduler = taskScheduler;
+}
+
 // Use this macro to log something
 #define RP3D_LOG(physicsWorldName, level, category, message, filename, lineNumber) if (reactphysics3d::PhysicsCommon::getLogger() != nullptr) PhysicsCommon::getLogger()->log(level, physicsWorldName, category, message, filename, lineNumber)
 
@@ -51,7 +51,13 @@
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/engine/Islands.h>
 #include <reactphysics3d/utils/DebugRenderer.h>
+#include <reactphysics3d/utils/TaskScheduler.h>
 #include <sstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -119,6 +125,43 @@ class PhysicsWorld {
             /// than the value bellow, the manifold are considered to be similar.
             decimal cosAngleSimilarContactManifold;
 
+            /// Task scheduler used to execute the parallel work of the world. If nullptr, the
+            /// task scheduler of the PhysicsCommon object is used (a single worker by default).
+            /// The task scheduler must not be destroyed before the world.
+            TaskScheduler* taskScheduler;
+
+            /// True if the islands are solved in parallel by the contact and constraint solvers
+            bool isParallelIslandSolverEnabled;
+
+            /// True if the contacts of the large islands are partitioned into colors that are solved in parallel.
+            /// The results then differ slightly from the default solver because the contacts are solved in another order.
+            bool isGraphColoringContactSolverEnabled;
+
+            /// True if the world uses its own memory allocators instead of the allocators of the PhysicsCommon object.
+            /// The memory allocators are then never shared with other worlds that are updated at the same time.
+            bool hasOwnMemoryManager;
+
+            /// True if the contacts of the islands partitioned into colors are solved several at a time with SIMD
+            /// instructions. This setting has no effect if the library is not compiled with the
+            /// RP3D_SIMD_CONTACT_SOLVER_ENABLED option.
+            bool isSimdContactSolverEnabled;
+
+            /// True if the broad-phase queries (overlapping pairs and raycasts) use a wide AABB tree where each node
+            /// tests the AABBs of several children at once with SIMD instructions. The wide tree is built again from
+            /// the dynamic AABB tree when the colliders have moved. The overlapping pairs are then found in another order.
+            bool isWideAABBTreeEnabled;
+
+            /// True if the contact points of a convex pair of colliders are reused (re-projected with the current transforms)
+            /// instead of running the narrow-phase collision test when the two colliders have almost not moved relative to
+            /// each other since their last narrow-phase test. This is useful for the resting bodies that are not sleeping.
+            bool isNarrowPhaseTemporalCoherenceEnabled;
+
+            /// Maximum relative translation (in meters) of two colliders since their last narrow-phase test to reuse their contact points
+            decimal temporalCoherenceDistanceThreshold;
+
+            /// Maximum relative rotation angle (in radians) of two colliders since their last narrow-phase test to reuse their contact points
+            decimal temporalCoherenceAngleThreshold;
+
             WorldSettings() {
 
                 worldName = "";
@@ -134,6 +177,15 @@ class PhysicsWorld {
                 defaultSleepLinearVelocity = decimal(0.02);
                 defaultSleepAngularVelocity = decimal(3.0) * (PI_RP3D / decimal(180.0));
                 cosAngleSimilarContactManifold = decimal(0.95);
+                taskScheduler = nullptr;
+                isParallelIslandSolverEnabled = true;
+                isGraphColoringContactSolverEnabled = false;
+                hasOwnMemoryManager = false;
+                isSimdContactSolverEnabled = true;
+                isWideAABBTreeEnabled = false;
+                isNarrowPhaseTemporalCoherenceEnabled = false;
+                temporalCoherenceDistanceThreshold = decimal(0.001);
+                temporalCoherenceAngleThreshold = decimal(0.002);
             }
 
             ~WorldSettings() = default;
@@ -156,11 +208,54 @@ class PhysicsWorld {
                 ss << "defaultSleepLinearVelocity=" << defaultSleepLinearVelocity << std::endl;
                 ss << "defaultSleepAngularVelocity=" << defaultSleepAngularVelocity << std::endl;
                 ss << "cosAngleSimilarContactManifold=" << cosAngleSimilarContactManifold << std::endl;
+                ss << "taskScheduler=" << (taskScheduler != nullptr ? "custom" : "default") << std::endl;
+                ss << "isParallelIslandSolverEnabled=" << isParallelIslandSolverEnabled << std::endl;
+                ss << "isGraphColoringContactSolverEnabled=" << isGraphColoringContactSolverEnabled << std::endl;
+                ss << "hasOwnMemoryManager=" << hasOwnMemoryManager << std::endl;
+                ss << "isSimdContactSolverEnabled=" << isSimdContactSolverEnabled << std::endl;
+                ss << "isWideAABBTreeEnabled=" << isWideAABBTreeEnabled << std::endl;
+                ss << "isNarrowPhaseTemporalCoherenceEnabled=" << isNarrowPhaseTemporalCoherenceEnabled << std::endl;
+                ss << "temporalCoherenceDistanceThreshold=" << temporalCoherenceDistanceThreshold << std::endl;
+                ss << "temporalCoherenceAngleThreshold=" << temporalCoherenceAngleThreshold << std::endl;
 
                 return ss.str();
             }
         };
 
+        // Class UpdateHandle
+        /**
+         * This class is returned by PhysicsWorld::updateAsync() to check whether the
+         * asynchronous update of the world is finished or to wait for its completion.
+         */
+        class UpdateHandle {
+
+            private:
+
+                // -------------------- Attributes -------------------- //
+
+                /// Pointer to the world that is updated
+                PhysicsWorld* mWorld;
+
+                /// Index of the asynchronous update in the world (starting at 1)
+                uint64 mUpdateIndex;
+
+            public:
+
+                // -------------------- Methods -------------------- //
+
+                /// Constructor
+                UpdateHandle(PhysicsWorld* world = nullptr, uint64 updateIndex = 0)
+                    : mWorld(world), mUpdateIndex(updateIndex) {
+
+                }
+
+                /// Return true if the update is finished
+                bool isDone() const;
+
+                /// Wait until the update is finished
+                void wait() const;
+        };
+
     protected :
 
         // -------------------- Attributes -------------------- //
@@ -171,6 +266,9 @@ class PhysicsWorld {
         /// Configuration of the physics world
         WorldSettings mConfig;
 
+        /// Task scheduler used to execute the parallel work of the world
+        TaskScheduler& mTaskScheduler;
+
         /// Entity Manager for the ECS
         EntityManager mEntityManager;
 
@@ -270,10 +368,33 @@ class PhysicsWorld {
         /// becomes smaller than the sleep velocity.
         decimal mTimeBeforeSleep;
 
+        /// Index (0 or 1) of the transforms snapshots of the rigid bodies that can currently be read
+        std::atomic<uint32> mTransformsSnapshotIndex;
+
+        /// True if the transforms snapshots of the rigid bodies are updated at the end of each update
+        /// (only once updateAsync() has been called)
+        std::atomic<bool> mIsTransformsSnapshotsEnabled;
+
+        /// Thread that executes the last asynchronous update of the world
+        std::thread mAsyncUpdateThread;
+
+        /// Mutex used to wait for the end of an asynchronous update
+        std::mutex mAsyncUpdateMutex;
+
+        /// Condition variable used to notify the end of an asynchronous update
+        std::condition_variable mAsyncUpdateDoneCondition;
+
+        /// Number of asynchronous updates that have been started
+        uint64 mNbStartedAsyncUpdates;
+
+        /// Number of asynchronous updates that are finished
+        std::atomic<uint64> mNbFinishedAsyncUpdates;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsCommon, const WorldSettings& worldSettings = WorldSettings(), Profiler* profiler = nullptr);
+        PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsCommon, TaskScheduler& taskScheduler,
+                     const WorldSettings& worldSettings = WorldSettings(), Profiler* profiler = nullptr);
 
         /// Notify the world if a body is disabled (slepping or inactive) or not
         void setBodyDisabled(Entity entity, bool isDisabled);
@@ -284,6 +405,15 @@ class PhysicsWorld {
         /// Solve the contacts and constraints
         void solveContactsAndConstraints(decimal timeStep);
 
+        /// Solve the contacts and joints of the islands in parallel
+        void solveIslandsContactsAndConstraints(decimal timeStep);
+
+        /// Solve the contacts and joints of a single island
+        void solveIslandContactsAndConstraints(uint32 islandIndex);
+
+        /// Return true if the contacts of an island are partitioned into colors by the contact solver
+        bool isColoredIsland(uint32 islandIndex) const;
+
         /// Solve the position error correction of the constraints
         void solvePositionCorrection();
 
@@ -302,6 +432,18 @@ class PhysicsWorld {
         /// Update the world inverse inertia tensors of rigid bodies
         void updateBodiesInverseWorldInertiaTensors();
 
+        /// Execute the simulation step of an update of the world
+        void updateSimulation(decimal timeStep);
+
+        /// Write the current transforms of the rigid bodies into their next snapshot and make it readable
+        void updateTransformsSnapshots();
+
+        /// Return true if an asynchronous update of the world is running
+        bool isAsyncUpdateRunning() const;
+
+        /// Wait until the asynchronous update with a given index is finished
+        void waitAsyncUpdate(uint64 updateIndex);
+
         /// Destructor
         ~PhysicsWorld();
 
@@ -315,6 +457,11 @@ class PhysicsWorld {
         /// Ray cast method
         void raycast(const Ray& ray, RaycastCallback* raycastCallback, unsigned short raycastWithCategoryMaskBits = 0xFFFF) const;
 
+        /// Ray cast method for a batch of rays
+        void raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHits,
+                          RaycastBatchMode mode = RaycastBatchMode::CLOSEST_HIT,
+                          unsigned short raycastWithCategoryMaskBits = 0xFFFF, bool isParallel = false) const;
+
         /// Return true if two bodies overlap (collide)
         bool testOverlap(Body* body1, Body* body2);
 
@@ -333,6 +480,15 @@ class PhysicsWorld {
         /// Test collision and report contacts between each colliding bodies in the world
         void testCollision(CollisionCallback& callback);
 
+        /// Enter the mode where the raycast(), testOverlap() and testCollision() methods can be called concurrently
+        void beginConcurrentQueries();
+
+        /// Leave the mode where the world queries can be called concurrently
+        void endConcurrentQueries();
+
+        /// Return true if the world queries can currently be called concurrently
+        bool isInConcurrentQueriesMode() const;
+
         /// Return a reference to the memory manager of the world
         MemoryManager& getMemoryManager();
 
@@ -351,6 +507,9 @@ class PhysicsWorld {
         /// Update the physics simulation
         void update(decimal timeStep);
 
+        /// Start an update of the physics simulation on another thread and return immediately
+        UpdateHandle updateAsync(decimal timeStep);
+
         /// Get the number of iterations for the velocity constraint solver
         uint16 getNbIterationsVelocitySolver() const;
 
@@ -489,6 +648,29 @@ RP3D_FORCE_INLINE void PhysicsWorld::raycast(const Ray& ray,
     mCollisionDetection.raycast(raycastCallback, ray, raycastWithCategoryMaskBits);
 }
 
+// Enter the mode where the raycast(), testOverlap() and testCollision() methods can be called concurrently
+/// Between the calls to beginConcurrentQueries() and endConcurrentQueries(), several threads can query the
+/// world at the same time. Each query uses its own scratch memory and does not modify the collision detection
+/// state of the world. The world must not be modified nor updated during this period. Note that the queries
+/// are not thread-safe if the library is compiled with the profiler enabled.
+RP3D_FORCE_INLINE void PhysicsWorld::beginConcurrentQueries() {
+    mCollisionDetection.beginConcurrentQueries();
+}
+
+// Leave the mode where the world queries can be called concurrently
+/// All the queries must be finished before this method is called.
+RP3D_FORCE_INLINE void PhysicsWorld::endConcurrentQueries() {
+    mCollisionDetection.endConcurrentQueries();
+}
+
+// Return true if the world queries can currently be called concurrently
+/**
+ * @return True if the world is between beginConcurrentQueries() and endConcurrentQueries()
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::isInConcurrentQueriesMode() const {
+    return mCollisionDetection.isInConcurrentQueriesMode();
+}
+
 // Test collision and report contacts between two bodies.
 /// Use this method if you only want to get all the contacts between two bodies.
 /// All the contacts will be reported using the callback object in paramater.
@@ -551,6 +733,12 @@ RP3D_FORCE_INLINE void PhysicsWorld::testOverlap(OverlapCallback& overlapCallbac
     mCollisionDetection.testOverlap(overlapCallback);
 }
 
+// Return true if the contacts of an island are partitioned into colors by the contact solver
+RP3D_FORCE_INLINE bool PhysicsWorld::isColoredIsland(uint32 islandIndex) const {
+    return mConfig.isGraphColoringContactSolverEnabled &&
+           mIslands.nbContactManifolds[islandIndex] >= GRAPH_COLORING_MIN_NB_CONTACT_MANIFOLDS;
+}
+
 // Return a reference to the memory manager of the world
 RP3D_FORCE_INLINE MemoryManager& PhysicsWorld::getMemoryManager() {
     return mMemoryManager;
@@ -672,6 +860,27 @@ RP3D_FORCE_INLINE uint32 PhysicsWorld::getNbRigidBodies() const {
    return static_cast<uint32>(mRigidBodies.size());
 }
 
+// Return true if an asynchronous update of the world is running
+RP3D_FORCE_INLINE bool PhysicsWorld::isAsyncUpdateRunning() const {
+    return mNbFinishedAsyncUpdates.load(std::memory_order_acquire) != mNbStartedAsyncUpdates;
+}
+
+// Return true if the update is finished
+/**
+ * @return True if the asynchronous update has been executed
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::UpdateHandle::isDone() const {
+    return mWorld == nullptr || mWorld->mNbFinishedAsyncUpdates.load(std::memory_order_acquire) >= mUpdateIndex;
+}
+
+// Wait until the update is finished
+/// The handle must not be used anymore once the world has been destroyed
+RP3D_FORCE_INLINE void PhysicsWorld::UpdateHandle::wait() const {
+    if (mWorld != nullptr) {
+        mWorld->waitAsyncUpdate(mUpdateIndex);
+    }
+}
+
 // Return true if the debug rendering is enabled
 /**
  * @return True if the debug rendering is enabled and false otherwise
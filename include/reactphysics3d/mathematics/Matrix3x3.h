@@ -300,6 +300,23 @@ RP3D_FORCE_INLINE Matrix3x3 operator*(const Matrix3x3& matrix, decimal nb) {
 
 // Overloaded operator for matrix multiplication
 RP3D_FORCE_INLINE Matrix3x3 operator*(const Matrix3x3& matrix1, const Matrix3x3& matrix2) {
+
+#ifdef IS_RP3D_SIMD_ENABLED
+
+    // Each row of the product is a linear combination of the rows of the second matrix
+    const SimdVector rows2[3] = {SimdVector::load3(&matrix2.mRows[0].x), SimdVector::load3(&matrix2.mRows[1].x),
+                                 SimdVector::load3(&matrix2.mRows[2].x)};
+
+    Matrix3x3 result;
+    for (int i=0; i < 3; i++) {
+        (SimdVector(matrix1.mRows[i].x) * rows2[0] + SimdVector(matrix1.mRows[i].y) * rows2[1] +
+         SimdVector(matrix1.mRows[i].z) * rows2[2]).store3(&result.mRows[i].x);
+    }
+
+    return result;
+
+#else
+
     return Matrix3x3(matrix1.mRows[0][0]*matrix2.mRows[0][0] + matrix1.mRows[0][1] *
                      matrix2.mRows[1][0] + matrix1.mRows[0][2]*matrix2.mRows[2][0],
                      matrix1.mRows[0][0]*matrix2.mRows[0][1] + matrix1.mRows[0][1] *
@@ -318,6 +335,8 @@ RP3D_FORCE_INLINE Matrix3x3 operator*(const Matrix3x3& matrix1, const Matrix3x3&
                      matrix2.mRows[1][1] + matrix1.mRows[2][2]*matrix2.mRows[2][1],
                      matrix1.mRows[2][0]*matrix2.mRows[0][2] + matrix1.mRows[2][1] *
                      matrix2.mRows[1][2] + matrix1.mRows[2][2]*matrix2.mRows[2][2]);
+
+#endif
 }
 
 // Overloaded operator for multiplication with a vector
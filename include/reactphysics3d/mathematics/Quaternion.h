@@ -348,6 +348,14 @@ RP3D_FORCE_INLINE Quaternion Quaternion::operator*(decimal nb) const {
 // Overloaded operator for the multiplication of two quaternions
 RP3D_FORCE_INLINE Quaternion Quaternion::operator*(const Quaternion& quaternion) const {
 
+#ifdef IS_RP3D_SIMD_ENABLED
+
+    Quaternion result;
+    SimdVector::quaternionProduct(SimdVector::load(&x), SimdVector::load(&quaternion.x)).store(&result.x);
+    return result;
+
+#else
+
     /* The followin code is equivalent to this
     return Quaternion(w * quaternion.w - getVectorV().dot(quaternion.getVectorV()),
                           w * quaternion.getVectorV() + quaternion.w * getVectorV() +
@@ -358,12 +366,22 @@ RP3D_FORCE_INLINE Quaternion Quaternion::operator*(const Quaternion& quaternion)
                       w * quaternion.y + quaternion.w * y + z * quaternion.x - x * quaternion.z,
                       w * quaternion.z + quaternion.w * z + x * quaternion.y - y * quaternion.x,
                       w * quaternion.w - x * quaternion.x - y * quaternion.y - z * quaternion.z);
+
+#endif
 }
 
 // Overloaded operator for the multiplication with a vector.
 /// This methods rotates a point given the rotation of a quaternion.
 RP3D_FORCE_INLINE Vector3 Quaternion::operator*(const Vector3& point) const {
 
+#ifdef IS_RP3D_SIMD_ENABLED
+
+    Vector3 result;
+    SimdVector::transform(SimdVector::load(&x), SimdVector(0), SimdVector::load3(&point.x)).store3(&result.x);
+    return result;
+
+#else
+
     /* The following code is equivalent to this
      * Quaternion p(point.x, point.y, point.z, 0.0);
      * return (((*this) * p) * getConjugate()).getVectorV();
@@ -376,6 +394,8 @@ RP3D_FORCE_INLINE Vector3 Quaternion::operator*(const Vector3& point) const {
     return Vector3(w * prodX - prodY * z + prodZ * y - prodW * x,
                    w * prodY - prodZ * x + prodX * z - prodW * y,
                    w * prodZ - prodX * y + prodY * x - prodW * z);
+
+#endif
 }
 
 // Overloaded operator for equality condition
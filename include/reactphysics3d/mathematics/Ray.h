@@ -55,6 +55,11 @@ struct Ray {
 
         // -------------------- Methods -------------------- //
 
+        /// Constructor (the two points are at the origin)
+        Ray() : maxFraction(decimal(1.0)) {
+
+        }
+
         /// Constructor with arguments
         Ray(const Vector3& p1, const Vector3& p2, decimal maxFrac = decimal(1.0))
            : point1(p1), point2(p2), maxFraction(maxFrac) {
@@ -0,0 +1,339 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SIMD_DECIMAL_H
+#define REACTPHYSICS3D_SIMD_DECIMAL_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+
+// Select the SIMD instruction set from the flags of the compiler
+#if defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    #if defined(__AVX__)
+        #define RP3D_SIMD_AVX
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define RP3D_SIMD_SSE
+    #endif
+#else
+    #if defined(__AVX__)
+        #define RP3D_SIMD_AVX
+    #elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #define RP3D_SIMD_SSE
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define RP3D_SIMD_NEON
+    #endif
+#endif
+
+#if defined(RP3D_SIMD_AVX)
+    #include <immintrin.h>
+#elif defined(RP3D_SIMD_SSE)
+    #include <emmintrin.h>
+#elif defined(RP3D_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class SimdDecimal
+/**
+ * This class represents a pack of decimal values that are processed with a single SIMD
+ * instruction. The instruction set (AVX, SSE or NEON) is selected from the flags of the
+ * compiler. Without any of those instruction sets, the lanes are processed one at a time.
+ * The arithmetic operations of a lane give the same results as the scalar operations.
+ */
+class SimdDecimal {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of decimal values in a pack
+#if defined(RP3D_SIMD_AVX)
+        static constexpr uint32 NB_LANES = sizeof(__m256) / sizeof(decimal);
+#elif defined(RP3D_SIMD_SSE)
+        static constexpr uint32 NB_LANES = sizeof(__m128) / sizeof(decimal);
+#else
+        static constexpr uint32 NB_LANES = 4;
+#endif
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Values of the lanes
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+        __m256d mValue;
+#elif defined(RP3D_SIMD_AVX)
+        __m256 mValue;
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+        __m128d mValue;
+#elif defined(RP3D_SIMD_SSE)
+        __m128 mValue;
+#elif defined(RP3D_SIMD_NEON)
+        float32x4_t mValue;
+#else
+        decimal mValues[NB_LANES];
+#endif
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor (the lanes are not initialized)
+        SimdDecimal() = default;
+
+        /// Constructor with the same value in all the lanes
+        explicit SimdDecimal(decimal value);
+
+        /// Return a pack with the values of an array of NB_LANES decimals (without alignment requirement)
+        static SimdDecimal load(const decimal* values);
+
+        /// Write the values of the lanes into an array of NB_LANES decimals (without alignment requirement)
+        void store(decimal* values) const;
+
+        /// Overloaded operator for addition with assignment
+        SimdDecimal& operator+=(const SimdDecimal& pack);
+
+        /// Overloaded operator for substraction with assignment
+        SimdDecimal& operator-=(const SimdDecimal& pack);
+
+        // -------------------- Friends -------------------- //
+
+        friend SimdDecimal operator+(const SimdDecimal& pack1, const SimdDecimal& pack2);
+        friend SimdDecimal operator-(const SimdDecimal& pack1, const SimdDecimal& pack2);
+        friend SimdDecimal operator-(const SimdDecimal& pack);
+        friend SimdDecimal operator*(const SimdDecimal& pack1, const SimdDecimal& pack2);
+        friend SimdDecimal min(const SimdDecimal& pack1, const SimdDecimal& pack2);
+        friend SimdDecimal max(const SimdDecimal& pack1, const SimdDecimal& pack2);
+        friend uint32 lessOrEqualMask(const SimdDecimal& pack1, const SimdDecimal& pack2);
+};
+
+// Constructor with the same value in all the lanes
+RP3D_FORCE_INLINE SimdDecimal::SimdDecimal(decimal value) {
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    mValue = _mm256_set1_pd(value);
+#elif defined(RP3D_SIMD_AVX)
+    mValue = _mm256_set1_ps(value);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    mValue = _mm_set1_pd(value);
+#elif defined(RP3D_SIMD_SSE)
+    mValue = _mm_set1_ps(value);
+#elif defined(RP3D_SIMD_NEON)
+    mValue = vdupq_n_f32(value);
+#else
+    for (uint32 i=0; i < NB_LANES; i++) mValues[i] = value;
+#endif
+}
+
+// Return a pack with the values of an array of NB_LANES decimals
+RP3D_FORCE_INLINE SimdDecimal SimdDecimal::load(const decimal* values) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_loadu_pd(values);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_loadu_ps(values);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_loadu_pd(values);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_loadu_ps(values);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vld1q_f32(values);
+#else
+    for (uint32 i=0; i < NB_LANES; i++) pack.mValues[i] = values[i];
+#endif
+    return pack;
+}
+
+// Write the values of the lanes into an array of NB_LANES decimals
+RP3D_FORCE_INLINE void SimdDecimal::store(decimal* values) const {
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    _mm256_storeu_pd(values, mValue);
+#elif defined(RP3D_SIMD_AVX)
+    _mm256_storeu_ps(values, mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    _mm_storeu_pd(values, mValue);
+#elif defined(RP3D_SIMD_SSE)
+    _mm_storeu_ps(values, mValue);
+#elif defined(RP3D_SIMD_NEON)
+    vst1q_f32(values, mValue);
+#else
+    for (uint32 i=0; i < NB_LANES; i++) values[i] = mValues[i];
+#endif
+}
+
+// Overloaded operator for addition
+RP3D_FORCE_INLINE SimdDecimal operator+(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_add_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_add_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_add_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_add_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vaddq_f32(pack1.mValue, pack2.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) pack.mValues[i] = pack1.mValues[i] + pack2.mValues[i];
+#endif
+    return pack;
+}
+
+// Overloaded operator for substraction
+RP3D_FORCE_INLINE SimdDecimal operator-(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_sub_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_sub_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_sub_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_sub_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vsubq_f32(pack1.mValue, pack2.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) pack.mValues[i] = pack1.mValues[i] - pack2.mValues[i];
+#endif
+    return pack;
+}
+
+// Overloaded operator for the negative of a pack (the sign bit of each lane is flipped)
+RP3D_FORCE_INLINE SimdDecimal operator-(const SimdDecimal& pack) {
+    SimdDecimal result;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    result.mValue = _mm256_xor_pd(pack.mValue, _mm256_set1_pd(-0.0));
+#elif defined(RP3D_SIMD_AVX)
+    result.mValue = _mm256_xor_ps(pack.mValue, _mm256_set1_ps(-0.0f));
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    result.mValue = _mm_xor_pd(pack.mValue, _mm_set1_pd(-0.0));
+#elif defined(RP3D_SIMD_SSE)
+    result.mValue = _mm_xor_ps(pack.mValue, _mm_set1_ps(-0.0f));
+#elif defined(RP3D_SIMD_NEON)
+    result.mValue = vnegq_f32(pack.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) result.mValues[i] = -pack.mValues[i];
+#endif
+    return result;
+}
+
+// Overloaded operator for multiplication
+RP3D_FORCE_INLINE SimdDecimal operator*(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_mul_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_mul_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_mul_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_mul_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vmulq_f32(pack1.mValue, pack2.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) pack.mValues[i] = pack1.mValues[i] * pack2.mValues[i];
+#endif
+    return pack;
+}
+
+// Return the minimum of two packs (lane by lane)
+RP3D_FORCE_INLINE SimdDecimal min(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_min_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_min_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_min_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_min_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vminq_f32(pack1.mValue, pack2.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) pack.mValues[i] = pack1.mValues[i] < pack2.mValues[i] ? pack1.mValues[i] : pack2.mValues[i];
+#endif
+    return pack;
+}
+
+// Return the maximum of two packs (lane by lane)
+RP3D_FORCE_INLINE SimdDecimal max(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+    SimdDecimal pack;
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm256_max_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_AVX)
+    pack.mValue = _mm256_max_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    pack.mValue = _mm_max_pd(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_SSE)
+    pack.mValue = _mm_max_ps(pack1.mValue, pack2.mValue);
+#elif defined(RP3D_SIMD_NEON)
+    pack.mValue = vmaxq_f32(pack1.mValue, pack2.mValue);
+#else
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) pack.mValues[i] = pack1.mValues[i] > pack2.mValues[i] ? pack1.mValues[i] : pack2.mValues[i];
+#endif
+    return pack;
+}
+
+// Return a bit mask where the bit i is set if the lane i of the first pack is smaller or equal to the lane i of the second pack
+/// The comparison is false if one of the two values is NaN
+RP3D_FORCE_INLINE uint32 lessOrEqualMask(const SimdDecimal& pack1, const SimdDecimal& pack2) {
+#if defined(RP3D_SIMD_AVX) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    return static_cast<uint32>(_mm256_movemask_pd(_mm256_cmp_pd(pack1.mValue, pack2.mValue, _CMP_LE_OQ)));
+#elif defined(RP3D_SIMD_AVX)
+    return static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(pack1.mValue, pack2.mValue, _CMP_LE_OQ)));
+#elif defined(RP3D_SIMD_SSE) && defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    return static_cast<uint32>(_mm_movemask_pd(_mm_cmple_pd(pack1.mValue, pack2.mValue)));
+#elif defined(RP3D_SIMD_SSE)
+    return static_cast<uint32>(_mm_movemask_ps(_mm_cmple_ps(pack1.mValue, pack2.mValue)));
+#elif defined(RP3D_SIMD_NEON)
+    const uint32x4_t comparison = vcleq_f32(pack1.mValue, pack2.mValue);
+    return (vgetq_lane_u32(comparison, 0) & 1) | (vgetq_lane_u32(comparison, 1) & 2) |
+           (vgetq_lane_u32(comparison, 2) & 4) | (vgetq_lane_u32(comparison, 3) & 8);
+#else
+    uint32 mask = 0;
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+        if (pack1.mValues[i] <= pack2.mValues[i]) mask |= (1u << i);
+    }
+    return mask;
+#endif
+}
+
+// Overloaded operator for addition with assignment
+RP3D_FORCE_INLINE SimdDecimal& SimdDecimal::operator+=(const SimdDecimal& pack) {
+    *this = *this + pack;
+    return *this;
+}
+
+// Overloaded operator for substraction with assignment
+RP3D_FORCE_INLINE SimdDecimal& SimdDecimal::operator-=(const SimdDecimal& pack) {
+    *this = *this - pack;
+    return *this;
+}
+
+}
+
+#endif
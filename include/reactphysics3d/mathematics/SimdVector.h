@@ -0,0 +1,385 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SIMD_VECTOR_H
+#define REACTPHYSICS3D_SIMD_VECTOR_H
+
+// Libraries
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+
+// Select the registers of a vector of four decimals from the instruction set of the compiler. In double
+// precision, the four lanes are stored in a single AVX register only if the AVX2 lane permutations
+// are available and in two SSE2 registers otherwise.
+#if defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+    #if defined(RP3D_SIMD_AVX) && defined(__AVX2__)
+        #define RP3D_SIMD_VECTOR_AVX2
+    #elif defined(RP3D_SIMD_AVX) || defined(RP3D_SIMD_SSE)
+        #define RP3D_SIMD_VECTOR_SSE2
+    #endif
+#else
+    #if defined(RP3D_SIMD_AVX) || defined(RP3D_SIMD_SSE)
+        #define RP3D_SIMD_VECTOR_SSE
+    #elif defined(RP3D_SIMD_NEON)
+        #define RP3D_SIMD_VECTOR_NEON
+    #endif
+#endif
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class SimdVector
+/**
+ * This class represents a vector of four decimal values (x, y, z, w) stored in SIMD registers. It is
+ * used by the mathematics classes (Vector3, Quaternion, Matrix3x3 and Transform) to compute their hot
+ * operations when the library is compiled with the RP3D_SIMD_ENABLED option. A 3D vector is stored
+ * in the lanes x, y and z (the lane w is then not used) and a quaternion is stored in the four lanes.
+ * The operations compute the same products and sums in the same order as the scalar operations of the
+ * mathematics classes. Therefore, their results are the same as the scalar results (up to the sign of
+ * a zero), except if the compiler contracts the scalar operations into fused multiply-add instructions.
+ * In this case, the results differ by a few units in the last place (a relative tolerance of 1e-5 in
+ * single precision and of 1e-12 in double precision is used by the unit tests).
+ */
+class SimdVector {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Values of the lanes
+#if defined(RP3D_SIMD_VECTOR_SSE)
+        __m128 mValue;
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+        __m256d mValue;
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+        __m128d mLow;
+        __m128d mHigh;
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+        float32x4_t mValue;
+#else
+        decimal mValues[4];
+#endif
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor (the lanes are not initialized)
+        SimdVector() = default;
+
+        /// Constructor with the values of the four lanes
+        SimdVector(decimal x, decimal y, decimal z, decimal w);
+
+        /// Constructor with the same value in all the lanes
+        explicit SimdVector(decimal value);
+
+        /// Return a vector with the values of an array of four decimals (without alignment requirement)
+        static SimdVector load(const decimal* values);
+
+        /// Write the values of the lanes into an array of four decimals (without alignment requirement)
+        void store(decimal* values) const;
+
+        /// Return a vector with the values of an array of three decimals (the lane w is zero)
+        static SimdVector load3(const decimal* values);
+
+        /// Write the values of the lanes x, y and z into an array of three decimals
+        void store3(decimal* values) const;
+
+        /// Return the value of the lane x
+        decimal getX() const;
+
+        /// Return a vector with the lanes I0, I1, I2 and I3 of this vector
+        template<int I0, int I1, int I2, int I3>
+        SimdVector shuffle() const;
+
+        /// Return the dot product of the x, y and z lanes of two vectors
+        static decimal dot(const SimdVector& vector1, const SimdVector& vector2);
+
+        /// Return the cross product of the x, y and z lanes of two vectors (the lane w is not used)
+        static SimdVector cross(const SimdVector& vector1, const SimdVector& vector2);
+
+        /// Return the product of two quaternions
+        static SimdVector quaternionProduct(const SimdVector& quaternion1, const SimdVector& quaternion2);
+
+        /// Return a translation plus a vector rotated by a unit quaternion (the lane w is not used)
+        static SimdVector transform(const SimdVector& quaternion, const SimdVector& translation, const SimdVector& vector);
+
+        // -------------------- Friends -------------------- //
+
+        friend SimdVector operator+(const SimdVector& vector1, const SimdVector& vector2);
+        friend SimdVector operator-(const SimdVector& vector1, const SimdVector& vector2);
+        friend SimdVector operator*(const SimdVector& vector1, const SimdVector& vector2);
+};
+
+// Constructor with the values of the four lanes
+RP3D_FORCE_INLINE SimdVector::SimdVector(decimal x, decimal y, decimal z, decimal w) {
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    mValue = _mm_setr_ps(x, y, z, w);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    mValue = _mm256_setr_pd(x, y, z, w);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    mLow = _mm_setr_pd(x, y);
+    mHigh = _mm_setr_pd(z, w);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    const float values[4] = {x, y, z, w};
+    mValue = vld1q_f32(values);
+#else
+    mValues[0] = x;
+    mValues[1] = y;
+    mValues[2] = z;
+    mValues[3] = w;
+#endif
+}
+
+// Constructor with the same value in all the lanes
+RP3D_FORCE_INLINE SimdVector::SimdVector(decimal value) {
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    mValue = _mm_set1_ps(value);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    mValue = _mm256_set1_pd(value);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    mLow = _mm_set1_pd(value);
+    mHigh = mLow;
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    mValue = vdupq_n_f32(value);
+#else
+    for (int i=0; i < 4; i++) mValues[i] = value;
+#endif
+}
+
+// Return a vector with the values of an array of four decimals
+RP3D_FORCE_INLINE SimdVector SimdVector::load(const decimal* values) {
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_loadu_ps(values);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_loadu_pd(values);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_loadu_pd(values);
+    vector.mHigh = _mm_loadu_pd(values + 2);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vld1q_f32(values);
+#else
+    for (int i=0; i < 4; i++) vector.mValues[i] = values[i];
+#endif
+    return vector;
+}
+
+// Write the values of the lanes into an array of four decimals
+RP3D_FORCE_INLINE void SimdVector::store(decimal* values) const {
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    _mm_storeu_ps(values, mValue);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    _mm256_storeu_pd(values, mValue);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    _mm_storeu_pd(values, mLow);
+    _mm_storeu_pd(values + 2, mHigh);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vst1q_f32(values, mValue);
+#else
+    for (int i=0; i < 4; i++) values[i] = mValues[i];
+#endif
+}
+
+// Return a vector with the values of an array of three decimals
+/// The memory after the three decimals is not read
+RP3D_FORCE_INLINE SimdVector SimdVector::load3(const decimal* values) {
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values)), _mm_load_ss(values + 2));
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(values)), _mm_load_sd(values + 2), 1);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_loadu_pd(values);
+    vector.mHigh = _mm_load_sd(values + 2);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vcombine_f32(vld1_f32(values), vld1_lane_f32(values + 2, vdup_n_f32(0), 0));
+#else
+    for (int i=0; i < 3; i++) vector.mValues[i] = values[i];
+    vector.mValues[3] = decimal(0.0);
+#endif
+    return vector;
+}
+
+// Write the values of the lanes x, y and z into an array of three decimals
+/// The memory after the three decimals is not written
+RP3D_FORCE_INLINE void SimdVector::store3(decimal* values) const {
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    _mm_storel_pi(reinterpret_cast<__m64*>(values), mValue);
+    _mm_store_ss(values + 2, _mm_movehl_ps(mValue, mValue));
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    _mm_storeu_pd(values, _mm256_castpd256_pd128(mValue));
+    _mm_store_sd(values + 2, _mm256_extractf128_pd(mValue, 1));
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    _mm_storeu_pd(values, mLow);
+    _mm_store_sd(values + 2, mHigh);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vst1_f32(values, vget_low_f32(mValue));
+    vst1q_lane_f32(values + 2, mValue, 2);
+#else
+    for (int i=0; i < 3; i++) values[i] = mValues[i];
+#endif
+}
+
+// Return the value of the lane x
+RP3D_FORCE_INLINE decimal SimdVector::getX() const {
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    return _mm_cvtss_f32(mValue);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    return _mm_cvtsd_f64(_mm256_castpd256_pd128(mValue));
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    return _mm_cvtsd_f64(mLow);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    return vgetq_lane_f32(mValue, 0);
+#else
+    return mValues[0];
+#endif
+}
+
+// Return a vector with the lanes I0, I1, I2 and I3 of this vector
+template<int I0, int I1, int I2, int I3>
+RP3D_FORCE_INLINE SimdVector SimdVector::shuffle() const {
+
+    static_assert(I0 >= 0 && I0 < 4 && I1 >= 0 && I1 < 4 && I2 >= 0 && I2 < 4 && I3 >= 0 && I3 < 4, "Invalid lane index");
+
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_shuffle_ps(mValue, mValue, _MM_SHUFFLE(I3, I2, I1, I0));
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_permute4x64_pd(mValue, I0 | (I1 << 2) | (I2 << 4) | (I3 << 6));
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_shuffle_pd(I0 < 2 ? mLow : mHigh, I1 < 2 ? mLow : mHigh, (I0 & 1) | ((I1 & 1) << 1));
+    vector.mHigh = _mm_shuffle_pd(I2 < 2 ? mLow : mHigh, I3 < 2 ? mLow : mHigh, (I2 & 1) | ((I3 & 1) << 1));
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vdupq_n_f32(vgetq_lane_f32(mValue, I0));
+    vector.mValue = vsetq_lane_f32(vgetq_lane_f32(mValue, I1), vector.mValue, 1);
+    vector.mValue = vsetq_lane_f32(vgetq_lane_f32(mValue, I2), vector.mValue, 2);
+    vector.mValue = vsetq_lane_f32(vgetq_lane_f32(mValue, I3), vector.mValue, 3);
+#else
+    vector.mValues[0] = mValues[I0];
+    vector.mValues[1] = mValues[I1];
+    vector.mValues[2] = mValues[I2];
+    vector.mValues[3] = mValues[I3];
+#endif
+    return vector;
+}
+
+// Overloaded operator for addition
+RP3D_FORCE_INLINE SimdVector operator+(const SimdVector& vector1, const SimdVector& vector2) {
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_add_ps(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_add_pd(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_add_pd(vector1.mLow, vector2.mLow);
+    vector.mHigh = _mm_add_pd(vector1.mHigh, vector2.mHigh);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vaddq_f32(vector1.mValue, vector2.mValue);
+#else
+    for (int i=0; i < 4; i++) vector.mValues[i] = vector1.mValues[i] + vector2.mValues[i];
+#endif
+    return vector;
+}
+
+// Overloaded operator for substraction
+RP3D_FORCE_INLINE SimdVector operator-(const SimdVector& vector1, const SimdVector& vector2) {
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_sub_ps(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_sub_pd(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_sub_pd(vector1.mLow, vector2.mLow);
+    vector.mHigh = _mm_sub_pd(vector1.mHigh, vector2.mHigh);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vsubq_f32(vector1.mValue, vector2.mValue);
+#else
+    for (int i=0; i < 4; i++) vector.mValues[i] = vector1.mValues[i] - vector2.mValues[i];
+#endif
+    return vector;
+}
+
+// Overloaded operator for multiplication (lane by lane)
+RP3D_FORCE_INLINE SimdVector operator*(const SimdVector& vector1, const SimdVector& vector2) {
+    SimdVector vector;
+#if defined(RP3D_SIMD_VECTOR_SSE)
+    vector.mValue = _mm_mul_ps(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_AVX2)
+    vector.mValue = _mm256_mul_pd(vector1.mValue, vector2.mValue);
+#elif defined(RP3D_SIMD_VECTOR_SSE2)
+    vector.mLow = _mm_mul_pd(vector1.mLow, vector2.mLow);
+    vector.mHigh = _mm_mul_pd(vector1.mHigh, vector2.mHigh);
+#elif defined(RP3D_SIMD_VECTOR_NEON)
+    vector.mValue = vmulq_f32(vector1.mValue, vector2.mValue);
+#else
+    for (int i=0; i < 4; i++) vector.mValues[i] = vector1.mValues[i] * vector2.mValues[i];
+#endif
+    return vector;
+}
+
+// Return the dot product of the x, y and z lanes of two vectors
+/// The products are summed in the order x, y and z as in Vector3::dot()
+RP3D_FORCE_INLINE decimal SimdVector::dot(const SimdVector& vector1, const SimdVector& vector2) {
+    const SimdVector products = vector1 * vector2;
+    return ((products + products.shuffle<1, 1, 1, 1>()) + products.shuffle<2, 2, 2, 2>()).getX();
+}
+
+// Return the cross product of the x, y and z lanes of two vectors
+RP3D_FORCE_INLINE SimdVector SimdVector::cross(const SimdVector& vector1, const SimdVector& vector2) {
+    return vector1.shuffle<1, 2, 0, 3>() * vector2.shuffle<2, 0, 1, 3>() -
+           vector1.shuffle<2, 0, 1, 3>() * vector2.shuffle<1, 2, 0, 3>();
+}
+
+// Return the product of two quaternions
+/// The lanes of the product are computed as in Quaternion::operator*(). The negative products of the
+/// lane w are added instead of being substracted (which gives the same result).
+RP3D_FORCE_INLINE SimdVector SimdVector::quaternionProduct(const SimdVector& quaternion1, const SimdVector& quaternion2) {
+
+    const SimdVector signs(1, 1, 1, -1);
+
+    return ((quaternion1.shuffle<3, 3, 3, 3>() * quaternion2 +
+             (quaternion1.shuffle<0, 1, 2, 0>() * signs) * quaternion2.shuffle<3, 3, 3, 0>()) +
+             (quaternion1.shuffle<1, 2, 0, 1>() * signs) * quaternion2.shuffle<2, 0, 1, 1>()) -
+             quaternion1.shuffle<2, 0, 1, 2>() * quaternion2.shuffle<1, 2, 0, 2>();
+}
+
+// Return a translation plus a vector rotated by a unit quaternion
+/// The rotation is computed as in Quaternion::operator*(const Vector3&) with the translation added
+/// first as in Transform::operator*(const Transform&). The lane w of the vector must be zero.
+RP3D_FORCE_INLINE SimdVector SimdVector::transform(const SimdVector& quaternion, const SimdVector& translation, const SimdVector& vector) {
+
+    // Product of the quaternion with the quaternion (vector, 0)
+    const SimdVector product = quaternionProduct(quaternion, vector);
+
+    // Vector part of the product with the conjugate of the quaternion
+    return ((translation + quaternion.shuffle<3, 3, 3, 3>() * product -
+             product.shuffle<1, 2, 0, 3>() * quaternion.shuffle<2, 0, 1, 3>()) +
+             product.shuffle<2, 0, 1, 3>() * quaternion.shuffle<1, 2, 0, 3>()) -
+             product.shuffle<3, 3, 3, 3>() * quaternion;
+}
+
+}
+
+#endif
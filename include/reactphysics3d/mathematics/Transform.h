@@ -191,12 +191,31 @@ RP3D_FORCE_INLINE bool Transform::isValid() const {
 
 // Return the transformed vector
 RP3D_FORCE_INLINE Vector3 Transform::operator*(const Vector3& vector) const {
+#ifdef IS_RP3D_SIMD_ENABLED
+    Vector3 result;
+    (SimdVector::transform(SimdVector::load(&mOrientation.x), SimdVector(0), SimdVector::load3(&vector.x)) +
+     SimdVector::load3(&mPosition.x)).store3(&result.x);
+    return result;
+#else
     return (mOrientation * vector) + mPosition;
+#endif
 }
 
 // Operator of multiplication of a transform with another one
 RP3D_FORCE_INLINE Transform Transform::operator*(const Transform& transform2) const {
 
+#ifdef IS_RP3D_SIMD_ENABLED
+
+    const SimdVector orientation1 = SimdVector::load(&mOrientation.x);
+
+    Transform result;
+    SimdVector::transform(orientation1, SimdVector::load3(&mPosition.x), SimdVector::load3(&transform2.mPosition.x)).store3(&result.mPosition.x);
+    SimdVector::quaternionProduct(orientation1, SimdVector::load(&transform2.mOrientation.x)).store(&result.mOrientation.x);
+
+    return result;
+
+#else
+
     // The following code is equivalent to this
     //return Transform(mPosition + mOrientation * transform2.mPosition,
     //                 mOrientation * transform2.mOrientation);
@@ -221,6 +240,8 @@ RP3D_FORCE_INLINE Transform Transform::operator*(const Transform& transform2) co
                        + mOrientation.x * transform2.mOrientation.y - mOrientation.y * transform2.mOrientation.x,
                       mOrientation.w * transform2.mOrientation.w - mOrientation.x * transform2.mOrientation.x
                        - mOrientation.y * transform2.mOrientation.y - mOrientation.z * transform2.mOrientation.z));
+
+#endif
 }
 
 // Return true if the two transforms are equal
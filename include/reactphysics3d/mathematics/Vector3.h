@@ -34,6 +34,10 @@
 #include <reactphysics3d/mathematics/mathematics_common.h>
 #include <reactphysics3d/configuration.h>
 
+#ifdef IS_RP3D_SIMD_ENABLED
+    #include <reactphysics3d/mathematics/SimdVector.h>
+#endif
+
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
 
@@ -205,14 +209,24 @@ RP3D_FORCE_INLINE decimal Vector3::lengthSquare() const {
 
 // Scalar product of two vectors (RP3D_FORCE_INLINE)
 RP3D_FORCE_INLINE decimal Vector3::dot(const Vector3& vector) const {
+#ifdef IS_RP3D_SIMD_ENABLED
+    return SimdVector::dot(SimdVector::load3(&x), SimdVector::load3(&vector.x));
+#else
     return (x*vector.x + y*vector.y + z*vector.z);
+#endif
 }
 
 // Cross product of two vectors (RP3D_FORCE_INLINE)
 RP3D_FORCE_INLINE Vector3 Vector3::cross(const Vector3& vector) const {
+#ifdef IS_RP3D_SIMD_ENABLED
+    Vector3 result;
+    SimdVector::cross(SimdVector::load3(&x), SimdVector::load3(&vector.x)).store3(&result.x);
+    return result;
+#else
     return Vector3(y * vector.z - z * vector.y,
                    z * vector.x - x * vector.z,
                    x * vector.y - y * vector.x);
+#endif
 }
 
 // Normalize the vector
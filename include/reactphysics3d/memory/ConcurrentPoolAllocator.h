@@ -0,0 +1,203 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CONCURRENT_POOL_ALLOCATOR_H
+#define REACTPHYSICS3D_CONCURRENT_POOL_ALLOCATOR_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <atomic>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class ConcurrentPoolAllocator
+/**
+ * This class is a pool allocator (with the same memory units sizes as the PoolAllocator)
+ * that can be used by many threads at the same time without locking a mutex. Each thread
+ * allocates and releases memory units using its own cache of free memory units. When the
+ * cache of a thread is empty, it is refilled with a batch of free memory units from global
+ * lock-free lists and when it contains too many free units, a batch is sent back to those global
+ * lists. The base allocator is only used when a new memory block is needed.
+ */
+class ConcurrentPoolAllocator : public MemoryAllocator {
+
+    private :
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure MemoryUnit
+        /**
+         * Represent a free memory unit. The free memory units are grouped into
+         * batches that are linked together in the global lists of free units.
+         */
+        struct MemoryUnit {
+
+            public :
+
+                // -------------------- Attributes -------------------- //
+
+                /// Pointer to the next memory unit of the batch
+                MemoryUnit* nextUnit;
+
+                /// Pointer to the first memory unit of the next batch (only for the first unit of a batch)
+                MemoryUnit* nextBatch;
+        };
+
+        // Structure MemoryBlock
+        /**
+         * A memory block is a large piece of memory that is allocated once and that
+         * is divided into multiple memory units.
+         */
+        struct alignas(GLOBAL_ALIGNMENT) MemoryBlock {
+
+            public :
+
+                // -------------------- Attributes -------------------- //
+
+                /// Pointer to the memory of the block
+                void* memory;
+
+                /// Pointer to the next allocated memory block
+                MemoryBlock* nextBlock;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of heaps
+        static const int NB_HEAPS = 128;
+
+        /// Minimum unit size
+        static const size_t MIN_UNIT_SIZE = GLOBAL_ALIGNMENT;
+
+        /// Maximum memory unit size. An allocation request larger than this size
+        /// is forwarded to the base allocator.
+        static const size_t MAX_UNIT_SIZE = NB_HEAPS * MIN_UNIT_SIZE;
+
+        /// Size of a memory block
+        static const size_t BLOCK_SIZE = 16 * MAX_UNIT_SIZE;
+
+        /// Number of memory units in a batch sent back from a thread cache to the global lists
+        static const uint32 BATCH_SIZE = 32;
+
+        /// Number of thread caches
+        static const uint32 NB_THREAD_CACHES = 64;
+
+        // Structure ThreadCache
+        /**
+         * Free memory units of each heap that are only used by a single thread at a time
+         * (aligned so that its size is a multiple of the global alignment)
+         */
+        struct alignas(GLOBAL_ALIGNMENT) ThreadCache {
+
+            public :
+
+                // -------------------- Attributes -------------------- //
+
+                /// True if a thread is currently using the cache
+                std::atomic_flag isUsed = ATOMIC_FLAG_INIT;
+
+                /// Pointers to the first free memory unit for each heap
+                MemoryUnit* freeUnits[NB_HEAPS] = {};
+
+                /// Number of free memory units for each heap
+                uint32 nbFreeUnits[NB_HEAPS] = {};
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Base memory allocator
+        MemoryAllocator& mBaseAllocator;
+
+        /// Global lock-free lists of batches of free memory units for each heap
+        std::atomic<MemoryUnit*> mFreeBatches[NB_HEAPS];
+
+        /// Caches of free memory units of the threads
+        std::atomic<ThreadCache*> mThreadCaches[NB_THREAD_CACHES];
+
+        /// Lock-free list of the allocated memory blocks
+        std::atomic<MemoryBlock*> mMemoryBlocks;
+
+#ifndef NDEBUG
+        /// This variable is incremented by one when the allocate() method has been
+        /// called and decreased by one when the release() method has been called.
+        /// This variable is used in debug mode to check that the allocate() and release()
+        /// methods are called the same number of times
+        std::atomic<int> mNbTimesAllocateMethodCalled;
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the index of the calling thread
+        static uint32 getThreadIndex();
+
+        /// Return the index of the heap that handles allocations of a given size
+        static int getHeapIndex(size_t size);
+
+        /// Try to take the cache of the calling thread (return nullptr if it is used by another thread)
+        ThreadCache* acquireThreadCache();
+
+        /// Make a thread cache available again
+        void releaseThreadCache(ThreadCache* cache);
+
+        /// Take a batch of free memory units from the global list of a heap
+        MemoryUnit* popBatch(int heapIndex, uint32& nbUnits);
+
+        /// Add a linked list of batches of free memory units into the global list of a heap
+        void pushBatches(int heapIndex, MemoryUnit* firstBatch, MemoryUnit* lastBatch);
+
+        /// Allocate a new memory block and return its linked list of memory units
+        MemoryUnit* allocateMemoryBlock(int heapIndex, uint32& nbUnits);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ConcurrentPoolAllocator(MemoryAllocator& baseAllocator);
+
+        /// Destructor
+        virtual ~ConcurrentPoolAllocator() override;
+
+        /// Assignment operator
+        ConcurrentPoolAllocator& operator=(ConcurrentPoolAllocator& allocator) = delete;
+
+        /// Allocate memory of a given size (in bytes) and return a pointer to the
+        /// allocated memory.
+        virtual void* allocate(size_t size) override;
+
+        /// Release previously allocated memory.
+        virtual void release(void* pointer, size_t size) override;
+};
+
+// Return the index of the heap that handles allocations of a given size
+RP3D_FORCE_INLINE int ConcurrentPoolAllocator::getHeapIndex(size_t size) {
+    return static_cast<int>((size - 1) / MIN_UNIT_SIZE);
+}
+
+}
+
+#endif
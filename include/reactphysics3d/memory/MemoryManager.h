@@ -29,8 +29,11 @@
 // Libraries
 #include <reactphysics3d/memory/DefaultAllocator.h>
 #include <reactphysics3d/memory/PoolAllocator.h>
+#include <reactphysics3d/memory/ConcurrentPoolAllocator.h>
 #include <reactphysics3d/memory/HeapAllocator.h>
 #include <reactphysics3d/memory/SingleFrameAllocator.h>
+#include <reactphysics3d/containers/Array.h>
+#include <mutex>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -45,7 +48,12 @@ class MemoryAllocator;
  * allocated specified by the user. The HeapAllocator is used on top of the base allocator.
  * The SingleFrameAllocator is used for memory that is allocated only during a frame and the PoolAllocator
  * is used to allocated objects of small size. Both SingleFrameAllocator and PoolAllocator will fall back to
- * HeapAllocator if an allocation request cannot be fulfilled.
+ * HeapAllocator if an allocation request cannot be fulfilled. The scratch allocators are single frame
+ * allocators that are used by a single thread at a time (for instance by concurrent world queries). The workers
+ * frame allocators are single frame allocators (without mutex) that are each used by a single worker of the task
+ * scheduler during the parallel stages of a frame. They are reset together with the single frame allocator.
+ * The ConcurrentPoolAllocator can be selected instead of the PoolAllocator when the pool memory is
+ * allocated by many threads at the same time.
  */
 class MemoryManager {
 
@@ -63,9 +71,24 @@ class MemoryManager {
        /// Memory pool allocator
        PoolAllocator mPoolAllocator;
 
+       /// Memory pool allocator with per-thread caches
+       ConcurrentPoolAllocator mConcurrentPoolAllocator;
+
+       /// True if the concurrent pool allocator is used instead of the pool allocator
+       bool mIsConcurrentPoolAllocatorUsed;
+
        /// Single frame stack allocator
        SingleFrameAllocator mSingleFrameAllocator;
 
+       /// Mutex to protect the array of free scratch allocators
+       std::mutex mScratchAllocatorsMutex;
+
+       /// Scratch allocators that are not currently used by a thread
+       Array<SingleFrameAllocator*> mFreeScratchAllocators;
+
+       /// Single frame allocators of the workers of the task scheduler
+       Array<SingleFrameAllocator*> mWorkersFrameAllocators;
+
     public:
 
         /// Memory allocation types
@@ -77,10 +100,10 @@ class MemoryManager {
        };
 
        /// Constructor
-       MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory = 0);
+       MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory = 0, bool useConcurrentPoolAllocator = false);
 
        /// Destructor
-       ~MemoryManager() = default;
+       ~MemoryManager();
 
         /// Allocate memory of a given type
         void* allocate(AllocationType allocationType, size_t size);
@@ -88,8 +111,14 @@ class MemoryManager {
         /// Release previously allocated memory.
         void release(AllocationType allocationType, void* pointer, size_t size);
 
+        /// Return the base allocator
+        MemoryAllocator& getBaseAllocator();
+
         /// Return the pool allocator
-        PoolAllocator& getPoolAllocator();
+        MemoryAllocator& getPoolAllocator();
+
+        /// Return true if the concurrent pool allocator is used instead of the pool allocator
+        bool isConcurrentPoolAllocatorUsed() const;
 
         /// Return the single frame stack allocator
         SingleFrameAllocator& getSingleFrameAllocator();
@@ -97,8 +126,20 @@ class MemoryManager {
         /// Return the heap allocator
         HeapAllocator& getHeapAllocator();
 
-        /// Reset the single frame allocator
+        /// Reset the single frame allocator and the workers frame allocators
         void resetFrameAllocator();
+
+        /// Make sure that there is a frame allocator for each worker of a task scheduler
+        void reserveWorkersFrameAllocators(uint32 nbWorkers);
+
+        /// Return the frame allocator of a worker of the task scheduler
+        SingleFrameAllocator& getWorkerFrameAllocator(uint32 workerIndex);
+
+        /// Return a scratch allocator that will only be used by the calling thread until it is released
+        SingleFrameAllocator& acquireScratchAllocator();
+
+        /// Reset a scratch allocator and make it available to the other threads
+        void releaseScratchAllocator(SingleFrameAllocator& allocator);
 };
 
 // Allocate memory of a given type
@@ -108,7 +149,8 @@ RP3D_FORCE_INLINE void* MemoryManager::allocate(AllocationType allocationType, s
 
     switch (allocationType) {
        case AllocationType::Base: allocatedMemory = mBaseAllocator->allocate(size); break;
-       case AllocationType::Pool: allocatedMemory =  mPoolAllocator.allocate(size); break;
+       case AllocationType::Pool: allocatedMemory = mIsConcurrentPoolAllocatorUsed ? mConcurrentPoolAllocator.allocate(size) :
+                                                                                      mPoolAllocator.allocate(size); break;
        case AllocationType::Heap: allocatedMemory =  mHeapAllocator.allocate(size); break;
        case AllocationType::Frame: allocatedMemory =  mSingleFrameAllocator.allocate(size); break;
     }
@@ -123,17 +165,37 @@ RP3D_FORCE_INLINE void MemoryManager::release(AllocationType allocationType, voi
 
     switch (allocationType) {
        case AllocationType::Base: mBaseAllocator->release(pointer, size); break;
-       case AllocationType::Pool: mPoolAllocator.release(pointer, size); break;
+       case AllocationType::Pool:
+           if (mIsConcurrentPoolAllocatorUsed) {
+               mConcurrentPoolAllocator.release(pointer, size);
+           }
+           else {
+               mPoolAllocator.release(pointer, size);
+           }
+           break;
        case AllocationType::Heap: mHeapAllocator.release(pointer, size); break;
        case AllocationType::Frame: mSingleFrameAllocator.release(pointer, size); break;
     }
 }
 
+// Return the base allocator
+RP3D_FORCE_INLINE MemoryAllocator& MemoryManager::getBaseAllocator() {
+   return *mBaseAllocator;
+}
+
 // Return the pool allocator
-RP3D_FORCE_INLINE PoolAllocator& MemoryManager::getPoolAllocator() {
+RP3D_FORCE_INLINE MemoryAllocator& MemoryManager::getPoolAllocator() {
+   if (mIsConcurrentPoolAllocatorUsed) {
+       return mConcurrentPoolAllocator;
+   }
    return mPoolAllocator;
 }
 
+// Return true if the concurrent pool allocator is used instead of the pool allocator
+RP3D_FORCE_INLINE bool MemoryManager::isConcurrentPoolAllocatorUsed() const {
+   return mIsConcurrentPoolAllocatorUsed;
+}
+
 // Return the single frame stack allocator
 RP3D_FORCE_INLINE SingleFrameAllocator& MemoryManager::getSingleFrameAllocator() {
    return mSingleFrameAllocator;
@@ -144,9 +206,20 @@ RP3D_FORCE_INLINE HeapAllocator& MemoryManager::getHeapAllocator() {
    return mHeapAllocator;
 }
 
-// Reset the single frame allocator
+// Reset the single frame allocator and the workers frame allocators
 RP3D_FORCE_INLINE void MemoryManager::resetFrameAllocator() {
    mSingleFrameAllocator.reset();
+   for (uint64 i=0; i < mWorkersFrameAllocators.size(); i++) {
+       mWorkersFrameAllocators[i]->reset();
+   }
+}
+
+// Return the frame allocator of a worker of the task scheduler
+/// The allocator is not thread-safe and must only be used by the worker with this index. Its memory is
+/// valid until the next call to resetFrameAllocator(). The memory can be released by any thread.
+RP3D_FORCE_INLINE SingleFrameAllocator& MemoryManager::getWorkerFrameAllocator(uint32 workerIndex) {
+   assert(workerIndex < mWorkersFrameAllocators.size());
+   return *(mWorkersFrameAllocators[workerIndex]);
 }
 
 }
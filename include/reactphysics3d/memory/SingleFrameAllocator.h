@@ -37,7 +37,10 @@ namespace reactphysics3d {
 // Class SingleFrameAllocator
 /**
  * This class represent a memory allocator used to efficiently allocate
- * memory on the heap that is used during a single frame.
+ * memory on the heap that is used during a single frame. The size of its
+ * memory block is adapted at each reset from the amount of memory that has
+ * been allocated during the previous frame (its high-water mark). An allocator that
+ * is only used by a single thread at a time can be created without its mutex.
  */
 class SingleFrameAllocator : public MemoryAllocator {
 
@@ -46,16 +49,25 @@ class SingleFrameAllocator : public MemoryAllocator {
         // -------------------- Constants -------------------- //
 
         /// Initial size (in bytes) of the single frame allocator
-        size_t INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES = 1048576; // 1Mb
+        static const size_t INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES = 1048576; // 1Mb
+
+        /// Number of consecutive frames that must use less than a quarter of the memory block before it is shrunk
+        static const uint32 NB_FRAMES_BEFORE_SHRINK = 60;
 
         // -------------------- Attributes -------------------- //
 
         /// Mutex
         std::mutex mMutex;
 
+        /// True if the allocations are protected by the mutex
+        const bool mIsThreadSafe;
+
         /// Reference to the base memory allocator
         MemoryAllocator& mBaseAllocator;
 
+        /// Minimum size (in bytes) of the memory block
+        const size_t mInitSizeBytes;
+
         /// Total size (in bytes) of memory of the allocator
         size_t mTotalSizeBytes;
 
@@ -65,15 +77,24 @@ class SingleFrameAllocator : public MemoryAllocator {
         /// Pointer to the next available memory location in the buffer
         size_t mCurrentOffset;
 
-        /// True if we need to allocate more memory in the next reset() call
-        bool mNeedToAllocatedMore;
+        /// Number of bytes allocated with the base allocator in the current frame because the block was full
+        size_t mNbOverflowBytes;
+
+        /// Number of consecutive frames that have used less than a quarter of the memory block
+        uint32 mNbUnderusedFrames;
+
+        // -------------------- Methods -------------------- //
+
+        /// Replace the memory block by a new one with a given size
+        void resizeMemoryBlock(size_t newSizeBytes);
 
     public :
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        SingleFrameAllocator(MemoryAllocator& baseAllocator);
+        SingleFrameAllocator(MemoryAllocator& baseAllocator, bool isThreadSafe = true,
+                             size_t initSizeBytes = INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES);
 
         /// Destructor
         virtual ~SingleFrameAllocator() override;
@@ -89,8 +110,16 @@ class SingleFrameAllocator : public MemoryAllocator {
 
         /// Reset the marker of the current allocated memory
         virtual void reset();
+
+        /// Return the size (in bytes) of the memory block of the allocator
+        size_t getTotalSizeBytes() const;
 };
 
+// Return the size (in bytes) of the memory block of the allocator
+RP3D_FORCE_INLINE size_t SingleFrameAllocator::getTotalSizeBytes() const {
+    return mTotalSizeBytes;
+}
+
 }
 
 #endif
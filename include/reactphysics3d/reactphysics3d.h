@@ -68,6 +68,7 @@
 #include <reactphysics3d/constraint/FixedJoint.h>
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/utils/Message.h>
+#include <reactphysics3d/utils/DefaultTaskScheduler.h>
 
 /// Alias to the ReactPhysics3D namespace
 namespace rp3d = reactphysics3d;
@@ -28,11 +28,13 @@
 
 // Libraries
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/broadphase/WideAABBTree.h>
 #include <reactphysics3d/containers/LinkedList.h>
 #include <reactphysics3d/containers/Set.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/components/TransformComponents.h>
 #include <reactphysics3d/components/RigidBodyComponents.h>
+#include <reactphysics3d/collision/RaycastInfo.h>
 #include <cstring>
 
 /// Namespace ReactPhysics3D
@@ -45,6 +47,7 @@ class Body;
 class Collider;
 class MemoryManager;
 class Profiler;
+class TaskScheduler;
 
 // class AABBOverlapCallback
 class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
@@ -97,13 +100,56 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
 
 };
 
+// Class BroadPhaseRaycastPacketCallback
+/**
+ * Callback called when the AABB of a leaf node of the broad-phase Dynamic
+ * AABB Tree is hit by some rays of a packet of a batched raycast.
+ */
+class BroadPhaseRaycastPacketCallback : public DynamicAABBTreeRaycastPacketCallback {
+
+    private :
+
+        const DynamicAABBTree& mDynamicAABBTree;
+
+        unsigned short mRaycastWithCategoryMaskBits;
+
+        /// Rays of the packet
+        const Ray* mRays;
+
+        /// Hits of the rays of the packet
+        RaycastHit* mHits;
+
+        /// Hit to report for each ray
+        RaycastBatchMode mMode;
+
+        /// Memory allocator for the temporary memory of the raycast
+        MemoryAllocator& mAllocator;
+
+    public:
+
+        // Constructor
+        BroadPhaseRaycastPacketCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
+                                        const Ray* rays, RaycastHit* hits, RaycastBatchMode mode, MemoryAllocator& allocator)
+            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+              mRays(rays), mHits(hits), mMode(mode), mAllocator(allocator) {
+
+        }
+
+        // Destructor
+        virtual ~BroadPhaseRaycastPacketCallback() override = default;
+
+        // Called for a broad-phase shape that has to be tested by some rays of the packet
+        virtual uint32 raycastBroadPhaseShape(int32 nodeId, uint32 raysMask, decimal* raysMaxFractions) override;
+};
+
 // Class BroadPhaseSystem
 /**
  * This class represents the broad-phase collision detection. The
  * goal of the broad-phase collision detection is to compute the pairs of colliders
  * that have their AABBs overlapping. Only those pairs of bodies will be tested
  * later for collision during the narrow-phase collision detection. A dynamic AABB
- * tree data structure is used for fast broad-phase collision detection.
+ * tree data structure is used for fast broad-phase collision detection. Optionally, the
+ * queries can use a wide AABB tree that is built from the dynamic AABB tree.
  */
 class BroadPhaseSystem {
 
@@ -114,6 +160,15 @@ class BroadPhaseSystem {
         /// Dynamic AABB tree
         DynamicAABBTree mDynamicAABBTree;
 
+        /// Wide AABB tree built from the dynamic AABB tree
+        WideAABBTree mWideAABBTree;
+
+        /// True if the broad-phase queries use the wide AABB tree
+        bool mIsWideAABBTreeEnabled;
+
+        /// True if the wide AABB tree has been built from the current state of the dynamic AABB tree
+        bool mIsWideAABBTreeUpToDate;
+
         /// Reference to the colliders components
         ColliderComponents& mCollidersComponents;
 
@@ -173,7 +228,7 @@ class BroadPhaseSystem {
         void updateCollider(Entity colliderEntity);
 
         /// Update the broad-phase state of all the enabled colliders
-        void updateColliders();
+        void updateColliders(MemoryManager& memoryManager, TaskScheduler& taskScheduler);
 
         /// Add a collider in the array of colliders that have moved in the last simulation step
         /// and that need to be tested again for broad-phase overlapping.
@@ -184,7 +239,7 @@ class BroadPhaseSystem {
         void removeMovedCollider(int broadPhaseID);
 
         /// Compute all the overlapping pairs of collision shapes
-        void computeOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes);
+        void computeOverlappingPairs(MemoryManager& memoryManager, TaskScheduler& taskScheduler, Array<Pair<int32, int32>>& overlappingNodes);
 
         /// Return the collider corresponding to the broad-phase node id in parameter
         Collider* getColliderForBroadPhaseId(int broadPhaseId) const;
@@ -198,6 +253,13 @@ class BroadPhaseSystem {
         /// Ray casting method
         void raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Ray casting method for a packet of rays of a batched raycast
+        void raycastPacket(const Ray* rays, uint32 raysMask, RaycastHit* hits, RaycastBatchMode mode,
+                           unsigned short raycastWithCategoryMaskBits, MemoryAllocator& allocator) const;
+
+        /// Enable or disable the wide AABB tree for the broad-phase queries
+        void setIsWideAABBTreeEnabled(bool isEnabled);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -225,12 +287,19 @@ RP3D_FORCE_INLINE Collider* BroadPhaseSystem::getColliderForBroadPhaseId(int bro
     return static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(broadPhaseId));
 }
 
+// Enable or disable the wide AABB tree for the broad-phase queries
+RP3D_FORCE_INLINE void BroadPhaseSystem::setIsWideAABBTreeEnabled(bool isEnabled) {
+    mIsWideAABBTreeEnabled = isEnabled;
+    mIsWideAABBTreeUpToDate = false;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
 RP3D_FORCE_INLINE void BroadPhaseSystem::setProfiler(Profiler* profiler) {
 	mProfiler = profiler;
 	mDynamicAABBTree.setProfiler(profiler);
+	mWideAABBTree.setProfiler(profiler);
 }
 
 #endif
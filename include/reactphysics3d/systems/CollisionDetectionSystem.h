@@ -166,12 +166,12 @@ class CollisionDetectionSystem {
         /// Number of potential contact points in the previous frame
         uint32 mNbPreviousPotentialContactPoints;
 
+        /// True if the world queries can be called concurrently (see PhysicsWorld::beginConcurrentQueries())
+        bool mIsInConcurrentQueriesMode;
+
         /// Reference to the half-edge structure of the triangle polyhedron
         HalfEdgeStructure& mTriangleHalfEdgeStructure;
 
-        /// Allocated size for a triangle shape
-        static const size_t mTriangleShapeAllocatedSize;
-
 #ifdef IS_RP3D_PROFILING_ENABLED
 
     /// Pointer to the profiler
@@ -187,21 +187,40 @@ class CollisionDetectionSystem {
         /// Compute the middle-phase collision detection
         void computeMiddlePhase(NarrowPhaseInput& narrowPhaseInput, bool needToReportContacts, bool isWorldQuery);
 
+        /// Compute the middle-phase collision detection for a range of convex vs convex overlapping pairs
+        void computeConvexPairsMiddlePhase(uint64 startPairIndex, uint64 nbPairs, NarrowPhaseInput& narrowPhaseInput,
+                                           bool needToReportContacts, bool isWorldQuery);
+
+        /// Add the cached contact points of a convex pair that has almost not moved since its last narrow-phase test
+        bool addCachedContactPoints(OverlappingPairs::ConvexOverlappingPair& overlappingPair, CollisionShape* shape1, CollisionShape* shape2,
+                                    const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform,
+                                    decimal cosHalfAngleThreshold, NarrowPhaseInput& narrowPhaseInput) const;
+
+        /// Cache the contact points of the convex pairs tested during the narrow-phase (temporal coherence)
+        void updateCachedContactPoints();
+
+        /// Compute the middle-phase collision detection for a range of convex vs concave overlapping pairs
+        void computeConcavePairsMiddlePhase(uint64 startPairIndex, uint64 nbPairs, NarrowPhaseInput& narrowPhaseInput,
+                                            MemoryAllocator& shapeAllocator, bool needToReportContacts, bool isWorldQuery);
+
         // Compute the middle-phase collision detection
         void computeMiddlePhaseCollisionSnapshot(Array<uint64>& convexPairs, Array<uint64>& concavePairs, NarrowPhaseInput& narrowPhaseInput,
-                                                 bool reportContacts);
+                                                 bool reportContacts, MemoryAllocator& allocator);
 
         /// Compute the narrow-phase collision detection
         void computeNarrowPhase();
 
         /// Compute the narrow-phase collision detection for the testOverlap() methods.
-        bool computeNarrowPhaseOverlapSnapshot(NarrowPhaseInput& narrowPhaseInput, OverlapCallback* callback);
+        bool computeNarrowPhaseOverlapSnapshot(NarrowPhaseInput& narrowPhaseInput, OverlapCallback* callback, MemoryAllocator& allocator);
 
         /// Compute the narrow-phase collision detection for the testCollision() methods
-        bool computeNarrowPhaseCollisionSnapshot(NarrowPhaseInput& narrowPhaseInput, CollisionCallback& callback);
+        bool computeNarrowPhaseCollisionSnapshot(NarrowPhaseInput& narrowPhaseInput, CollisionCallback& callback, MemoryAllocator& allocator);
+
+        /// Replace the last frame collision infos of the narrow-phase tests by private copies
+        LastFrameCollisionInfo* copyLastFrameCollisionInfos(NarrowPhaseInput& narrowPhaseInput, MemoryAllocator& allocator, uint32& nbInfos) const;
 
         /// Process the potential contacts after narrow-phase collision detection
-        void computeOverlapSnapshotContactPairs(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>& contactPairs) const;
+        void computeOverlapSnapshotContactPairs(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>& contactPairs, MemoryAllocator& allocator) const;
 
         /// Convert the potential contact into actual contacts
         void computeOverlapSnapshotContactPairs(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, Array<ContactPair>& contactPairs,
@@ -231,6 +250,14 @@ class CollisionDetectionSystem {
         /// Execute the narrow-phase collision detection algorithm on batches
         bool testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator);
 
+        /// Execute the narrow-phase collision detection algorithm on a range of items of a batch
+        bool testNarrowPhaseCollision(NarrowPhaseAlgorithmType algorithmType, NarrowPhaseInfoBatch& batch, uint32 batchStartIndex,
+                                      uint32 batchNbItems, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator);
+
+        /// Execute a narrow-phase collision detection algorithm on a range of items whose collision shapes are all set
+        bool testNarrowPhaseAlgorithm(NarrowPhaseAlgorithmType algorithmType, NarrowPhaseInfoBatch& batch, uint32 batchStartIndex,
+                                      uint32 batchNbItems, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator);
+
         /// Compute the concave vs convex middle-phase algorithm for a given pair of bodies
         void computeConvexVsConcaveMiddlePhase(OverlappingPairs::ConcaveOverlappingPair& overlappingPair, MemoryAllocator& allocator,
                                                NarrowPhaseInput& narrowPhaseInput, bool reportContacts);
@@ -246,7 +273,8 @@ class CollisionDetectionSystem {
 
         /// Process the potential contacts after narrow-phase collision detection
         void processAllPotentialContacts(NarrowPhaseInput& narrowPhaseInput, bool updateLastFrameInfo, Array<ContactPointInfo>& potentialContactPoints,
-                                         Array<ContactManifoldInfo>& potentialContactManifolds, Array<ContactPair>* contactPairs);
+                                         Array<ContactManifoldInfo>& potentialContactManifolds, Array<ContactPair>* contactPairs,
+                                         MemoryAllocator& allocator);
 
         /// Reduce the potential contact manifolds and contact points of the overlapping pair contacts
         void reducePotentialContactManifolds(Array<ContactPair>* contactPairs, Array<ContactManifoldInfo>& potentialContactManifolds,
@@ -255,9 +283,6 @@ class CollisionDetectionSystem {
         /// Create the actual contact manifolds and contacts points (from potential contacts) for a given contact pair
         void createContacts();
 
-        /// Add the contact pairs to the corresponding bodies
-        void addContactPairsToBodies();
-
         /// Compute the map from contact pairs ids to contact pair for the next frame
         void computeMapPreviousContactPairs();
 
@@ -300,6 +325,9 @@ class CollisionDetectionSystem {
         /// Filter the overlapping pairs to keep only the pairs where two given bodies are involved
         void filterOverlappingPairs(Entity body1Entity, Entity body2Entity, Array<uint64>& convexPairs, Array<uint64>& concavePairs) const;
 
+        /// Filter the overlapping pairs to keep only the pairs where both colliders are world query colliders
+        void filterWorldQueryOverlappingPairs(Array<uint64>& convexPairs, Array<uint64>& concavePairs) const;
+
         /// Remove an element in an array (and replace it by the last one in the array)
         void removeItemAtInArray(uint array[], uint8 index, uint8& arraySize) const;
 
@@ -357,10 +385,23 @@ class CollisionDetectionSystem {
         /// Compute the collision detection
         void computeCollisionDetection();
 
+        /// Enter the mode where the world queries can be called concurrently
+        void beginConcurrentQueries();
+
+        /// Leave the mode where the world queries can be called concurrently
+        void endConcurrentQueries();
+
+        /// Return true if the world queries can currently be called concurrently
+        bool isInConcurrentQueriesMode() const;
+
         /// Ray casting method
         void raycast(RaycastCallback* raycastCallback, const Ray& ray,
                      unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Ray casting method for a batch of rays
+        void raycastBatch(const Ray* rays, uint32 nbRays, RaycastHit* outHits, RaycastBatchMode mode,
+                          unsigned short raycastWithCategoryMaskBits, bool isParallel) const;
+
         /// Return true if two bodies (collide) overlap
         bool testOverlap(Body* body1, Body* body2);
 
@@ -406,6 +447,11 @@ class CollisionDetectionSystem {
         friend class DebugRenderer;
 };
 
+// Return true if the world queries can currently be called concurrently
+RP3D_FORCE_INLINE bool CollisionDetectionSystem::isInConcurrentQueriesMode() const {
+    return mIsInConcurrentQueriesMode;
+}
+
 // Return a reference to the collision dispatch configuration
 RP3D_FORCE_INLINE CollisionDispatch& CollisionDetectionSystem::getCollisionDispatch() {
     return mCollisionDispatch;
@@ -457,11 +503,6 @@ RP3D_FORCE_INLINE void CollisionDetectionSystem::updateCollider(Entity colliderE
     mBroadPhaseSystem.updateCollider(colliderEntity);
 }
 
-// Update all the enabled colliders
-RP3D_FORCE_INLINE void CollisionDetectionSystem::updateColliders() {
-    mBroadPhaseSystem.updateColliders();
-}
-
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -33,6 +33,7 @@
 #include <reactphysics3d/systems/SolveFixedJointSystem.h>
 #include <reactphysics3d/systems/SolveHingeJointSystem.h>
 #include <reactphysics3d/systems/SolveSliderJointSystem.h>
+#include <reactphysics3d/containers/Array.h>
 
 namespace reactphysics3d {
 
@@ -147,6 +148,19 @@ class ConstraintSolverSystem {
 
     private :
 
+        // Structure IslandJoint
+        /**
+         * A joint of an island to solve
+         */
+        struct IslandJoint {
+
+            /// Type of the joint
+            JointType type;
+
+            /// Index of the joint in the components of its type of joint
+            uint32 componentIndex;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Current time step
@@ -173,18 +187,57 @@ class ConstraintSolverSystem {
         /// Solver for the SliderJoint constraints
         SolveSliderJointSystem mSolveSliderJointSystem;
 
+        /// Reference to the joint components
+        JointComponents& mJointComponents;
+
+        /// Reference to the ball-and-socket joint components
+        BallAndSocketJointComponents& mBallAndSocketJointComponents;
+
+        /// Reference to the fixed joint components
+        FixedJointComponents& mFixedJointComponents;
+
+        /// Reference to the hinge joint components
+        HingeJointComponents& mHingeJointComponents;
+
+        /// Reference to the slider joint components
+        SliderJointComponents& mSliderJointComponents;
+
+        /// Joints of all the islands (the joints of an island are stored sequentially in the order of the solver)
+        Array<IslandJoint> mIslandsJoints;
+
+        /// For each island (plus one group for the joints that are not in any island), index of its first joint in
+        /// the mIslandsJoints array. The last item is the total number of joints.
+        Array<uint32> mIslandsJointsStartIndex;
+
+        /// Temporary array with the group index of each enabled joint (in the order of the solver)
+        Array<uint32> mJointsGroupIndex;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
 		Profiler* mProfiler;
 #endif
 
+        // -------------------- Methods -------------------- //
+
+        /// Set the time step and warm starting parameters and initialize the joints before solving
+        void initBeforeSolve(decimal dt);
+
+        /// Compute the joints of each island
+        void computeIslandsJoints();
+
+        /// Warm start a single joint
+        void warmstartJoint(const IslandJoint& joint);
+
+        /// Solve the velocity constraint of a single joint
+        void solveVelocityConstraintJoint(const IslandJoint& joint);
+
     public :
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ConstraintSolverSystem(PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
+        ConstraintSolverSystem(PhysicsWorld& world, MemoryAllocator& allocator, Islands& islands, RigidBodyComponents& rigidBodyComponents,
                                TransformComponents& transformComponents,
                                JointComponents& jointComponents,
                                BallAndSocketJointComponents& ballAndSocketJointComponents,
@@ -197,9 +250,18 @@ class ConstraintSolverSystem {
         /// Initialize the constraint solver
         void initialize(decimal dt);
 
+        /// Initialize the constraint solver to solve the islands separately
+        void initializeForIslands(decimal dt);
+
+        /// Warm start the joints of a given island
+        void warmstartIsland(uint32 islandIndex);
+
         /// Solve the constraints
         void solveVelocityConstraints();
 
+        /// Solve the velocity constraints of the joints of a given island
+        void solveVelocityConstraintsIsland(uint32 islandIndex);
+
         /// Solve the position constraints
         void solvePositionConstraints();
 
@@ -32,6 +32,11 @@
 #include <reactphysics3d/mathematics/Matrix3x3.h>
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/engine/Material.h>
+#include <reactphysics3d/collision/ContactManifold.h>
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#endif
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -39,7 +44,6 @@ namespace reactphysics3d {
 // Declarations
 class ContactPoint;
 class Joint;
-class ContactManifold;
 class MemoryManager;
 class Profiler;
 class Island;
@@ -51,6 +55,7 @@ class BodyComponents;
 class DynamicsComponents;
 class RigidBodyComponents;
 class ColliderComponents;
+class TaskScheduler;
 
 // Class ContactSolverSystem
 /**
@@ -120,6 +125,11 @@ class ColliderComponents;
  * constraints at the center of the contact manifold, we need two constraints for tangential
  * friction but also another twist friction constraint to prevent spin of the body around the
  * contact manifold center.
+ *
+ * When the library is compiled with the RP3D_SIMD_CONTACT_SOLVER_ENABLED option, the contact
+ * manifolds of a color (that never share a dynamic body) are grouped into batches that store
+ * their constraints as structures of arrays. The manifolds of a batch are then solved at the
+ * same time with SIMD instructions (one manifold per lane).
  */
 class ContactSolverSystem {
 
@@ -275,6 +285,193 @@ class ContactSolverSystem {
             int8 nbContacts;
         };
 
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+        // Structure SimdVector3
+        /**
+         * Vectors of all the lanes of a batch loaded into SIMD registers
+         */
+        struct SimdVector3 {
+
+            SimdDecimal x;
+            SimdDecimal y;
+            SimdDecimal z;
+        };
+
+        // Structure LanesVector3
+        /**
+         * Vectors of all the lanes of a batch stored as a structure of arrays
+         */
+        struct LanesVector3 {
+
+            decimal x[SimdDecimal::NB_LANES];
+            decimal y[SimdDecimal::NB_LANES];
+            decimal z[SimdDecimal::NB_LANES];
+
+            /// Set the vector of a lane
+            void setLane(uint32 lane, const Vector3& vector) {
+                x[lane] = vector.x;
+                y[lane] = vector.y;
+                z[lane] = vector.z;
+            }
+
+            /// Return the vector of a lane
+            Vector3 getLane(uint32 lane) const {
+                return Vector3(x[lane], y[lane], z[lane]);
+            }
+
+            /// Load the vectors of all the lanes
+            SimdVector3 load() const {
+                return {SimdDecimal::load(x), SimdDecimal::load(y), SimdDecimal::load(z)};
+            }
+
+            /// Store the vectors of all the lanes
+            void store(const SimdVector3& vector) {
+                vector.x.store(x);
+                vector.y.store(y);
+                vector.z.store(z);
+            }
+        };
+
+        // Structure ContactPointsLanes
+        /**
+         * Contact points with the same index in the contact manifolds of a batch. The lanes of
+         * the manifolds with less contact points have a zero inverse mass and do nothing.
+         */
+        struct ContactPointsLanes {
+
+            /// Normal vectors of the contacts
+            LanesVector3 normal;
+
+            /// Vectors from the body 1 center to the contact points
+            LanesVector3 r1;
+
+            /// Vectors from the body 2 center to the contact points
+            LanesVector3 r2;
+
+            /// Cross products of r1 with the contact normals
+            LanesVector3 i1TimesR1CrossN;
+
+            /// Cross products of r2 with the contact normals
+            LanesVector3 i2TimesR2CrossN;
+
+            /// Penetration depth biases
+            decimal biasPenetrationDepth[SimdDecimal::NB_LANES];
+
+            /// Velocity restitution biases
+            decimal restitutionBias[SimdDecimal::NB_LANES];
+
+            /// Inverses of the matrix K for the penetration
+            decimal inversePenetrationMass[SimdDecimal::NB_LANES];
+
+            /// Accumulated normal impulses
+            decimal penetrationImpulse[SimdDecimal::NB_LANES];
+
+            /// Accumulated split impulses for penetration correction
+            decimal penetrationSplitImpulse[SimdDecimal::NB_LANES];
+        };
+
+        // Structure ContactManifoldsBatch
+        /**
+         * Contact manifolds of a color that are solved together with SIMD instructions. The
+         * constraints are copied from the ContactManifoldSolver and ContactPointSolver structures
+         * after the warm starting. The unused lanes of the last batch of a color are zero.
+         */
+        struct ContactManifoldsBatch {
+
+            /// Index of the first manifold of the batch in the mColorsManifolds array
+            uint32 colorsManifoldsStartIndex;
+
+            /// Number of used lanes
+            uint32 nbLanes;
+
+            /// Largest number of contact points in the manifolds of the batch
+            uint32 maxNbContacts;
+
+            /// Indices of body 1 in the dynamics components arrays
+            uint32 rigidBodyComponentIndexBody1[SimdDecimal::NB_LANES];
+
+            /// Indices of body 2 in the dynamics components arrays
+            uint32 rigidBodyComponentIndexBody2[SimdDecimal::NB_LANES];
+
+            /// Inverses of the mass of body 1
+            decimal massInverseBody1[SimdDecimal::NB_LANES];
+
+            /// Inverses of the mass of body 2
+            decimal massInverseBody2[SimdDecimal::NB_LANES];
+
+            /// Linear lock axis factors of body 1
+            LanesVector3 linearLockAxisFactorBody1;
+
+            /// Linear lock axis factors of body 2
+            LanesVector3 linearLockAxisFactorBody2;
+
+            /// Angular lock axis factors of body 1
+            LanesVector3 angularLockAxisFactorBody1;
+
+            /// Angular lock axis factors of body 2
+            LanesVector3 angularLockAxisFactorBody2;
+
+            /// Rows of the inverse inertia tensors of body 1
+            LanesVector3 inverseInertiaTensorBody1[3];
+
+            /// Rows of the inverse inertia tensors of body 2
+            LanesVector3 inverseInertiaTensorBody2[3];
+
+            /// Mix friction coefficients
+            decimal frictionCoefficient[SimdDecimal::NB_LANES];
+
+            /// Average normal vectors of the contact manifolds
+            LanesVector3 normal;
+
+            /// R1 vectors for the friction constraints
+            LanesVector3 r1Friction;
+
+            /// R2 vectors for the friction constraints
+            LanesVector3 r2Friction;
+
+            /// Cross products of r1 with 1st friction vector
+            LanesVector3 r1CrossT1;
+
+            /// Cross products of r1 with 2nd friction vector
+            LanesVector3 r1CrossT2;
+
+            /// Cross products of r2 with 1st friction vector
+            LanesVector3 r2CrossT1;
+
+            /// Cross products of r2 with 2nd friction vector
+            LanesVector3 r2CrossT2;
+
+            /// First friction directions
+            LanesVector3 frictionVector1;
+
+            /// Second friction directions
+            LanesVector3 frictionVector2;
+
+            /// Matrix K for the first friction constraint
+            decimal inverseFriction1Mass[SimdDecimal::NB_LANES];
+
+            /// Matrix K for the second friction constraint
+            decimal inverseFriction2Mass[SimdDecimal::NB_LANES];
+
+            /// Matrix K for the twist friction constraint
+            decimal inverseTwistFrictionMass[SimdDecimal::NB_LANES];
+
+            /// First friction direction impulses
+            decimal friction1Impulse[SimdDecimal::NB_LANES];
+
+            /// Second friction direction impulses
+            decimal friction2Impulse[SimdDecimal::NB_LANES];
+
+            /// Twist friction impulses
+            decimal frictionTwistImpulse[SimdDecimal::NB_LANES];
+
+            /// Contact points of the manifolds
+            ContactPointsLanes contactPoints[ContactManifold::MAX_CONTACT_POINTS_IN_MANIFOLD];
+        };
+
+#endif
+
         // -------------------- Constants --------------------- //
 
         /// Beta value for the penetration depth position correction without split impulses
@@ -286,6 +483,10 @@ class ContactSolverSystem {
         /// Slop distance (allowed penetration distance between bodies)
         static const decimal SLOP;
 
+        /// Maximum number of colors whose contact manifolds are solved in parallel. The contact
+        /// manifolds that do not fit in those colors are put in a last color that is solved sequentially.
+        static const uint32 NB_MAX_PARALLEL_COLORS;
+
         // -------------------- Attributes -------------------- //
 
         /// Memory manager
@@ -294,6 +495,9 @@ class ContactSolverSystem {
         /// Physics world
         PhysicsWorld& mWorld;
 
+        /// Task scheduler used to solve the contact manifolds of a color in parallel
+        TaskScheduler& mTaskScheduler;
+
         /// Current time step
         decimal mTimeStep;
 
@@ -333,6 +537,32 @@ class ContactSolverSystem {
         /// True if the split impulse position correction is active
         bool mIsSplitImpulseActive;
 
+        /// Indices of the contact manifolds of the colored island (grouped by color)
+        Array<uint32> mColorsManifolds;
+
+        /// For each color, index of its first contact manifold in the mColorsManifolds array
+        /// (the last item is the number of contact manifolds of the colored island)
+        Array<uint32> mColorsStartIndex;
+
+        /// Color of each contact manifold of the colored island
+        Array<uint8> mManifoldsColor;
+
+        /// For each rigid body component, bit mask of the colors of its contact manifolds
+        Array<uint64> mBodiesColorsMasks;
+
+        /// True if the colors are solved with SIMD instructions (if the library is compiled with it)
+        bool mIsSimdSolverEnabled;
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+        /// Batches of contact manifolds of the colored island (grouped by color)
+        Array<ContactManifoldsBatch> mColorsBatches;
+
+        /// For each color, index of its first batch in the mColorsBatches array
+        Array<uint32> mColorsBatchesStartIndex;
+
+#endif
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -357,12 +587,49 @@ class ContactSolverSystem {
         /// Warm start the solver.
         void warmStart();
 
+        /// Warm start the contact manifolds in a given range
+        void warmStartManifolds(uint32 startManifoldIndex, uint32 nbManifolds);
+
+        /// Solve the contact manifolds in a given range
+        void solveManifolds(uint32 startManifoldIndex, uint32 nbManifolds);
+
+        /// Initialize the constraints of the contact manifolds in a given range
+        void initializeManifolds(uint32 startManifoldIndex, uint32 nbManifolds);
+
+        /// Warm start a single contact manifold
+        void warmStartManifold(uint32 c);
+
+        /// Solve a single contact manifold
+        void solveManifold(uint32 c);
+
+        /// Partition the contact manifolds in a given range into colors
+        void computeColors(uint32 startManifoldIndex, uint32 nbManifolds);
+
+        /// Warm start or solve the contact manifolds of a color
+        void solveColor(uint32 colorIndex, bool isWarmStart);
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+        /// Group the contact manifolds of the colors into batches solved with SIMD instructions
+        void initializeColorsBatches();
+
+        /// Copy the constraints of the contact manifolds of a batch into the batch
+        void initializeBatch(ContactManifoldsBatch& batch);
+
+        /// Solve the contact manifolds of a batch with SIMD instructions
+        void solveBatch(ContactManifoldsBatch& batch);
+
+        /// Copy the accumulated impulses of the batches back into the contact manifolds and points
+        void storeColorsBatchesImpulses();
+
+#endif
+
    public:
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ContactSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, Islands& islands, BodyComponents& bodyComponents,
+        ContactSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, TaskScheduler& taskScheduler, Islands& islands, BodyComponents& bodyComponents,
                       RigidBodyComponents& rigidBodyComponents, ColliderComponents& colliderComponents, decimal& restitutionVelocityThreshold);
 
         /// Destructor
@@ -371,9 +638,24 @@ class ContactSolverSystem {
         /// Initialize the contact constraints
         void init(Array<ContactManifold>* contactManifolds, Array<ContactPoint>* contactPoints, decimal timeStep);
 
+        /// Allocate the contact constraints of the current frame
+        void allocate(Array<ContactManifold>* contactManifolds, Array<ContactPoint>* contactPoints, decimal timeStep);
+
         /// Initialize the constraint solver for a given island
         void initializeForIsland(uint32 islandIndex);
 
+        /// Warm start the contacts of a given island
+        void warmStartIsland(uint32 islandIndex);
+
+        /// Solve the contacts of a given island
+        void solveIsland(uint32 islandIndex);
+
+        /// Initialize and warm start the contacts of a large island partitioned into colors
+        void initializeForColoredIsland(uint32 islandIndex);
+
+        /// Solve the contacts of the colored island
+        void solveColoredIsland();
+
         /// Store the computed impulses to use them to
         /// warm start the solver at the next iteration
         void storeImpulses();
@@ -390,6 +672,9 @@ class ContactSolverSystem {
         /// Activate or Deactivate the split impulses for contacts
         void setIsSplitImpulseActive(bool isActive);
 
+        /// Enable or disable the SIMD solver of the colored islands
+        void setIsSimdSolverEnabled(bool isEnabled);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -408,6 +693,12 @@ RP3D_FORCE_INLINE void ContactSolverSystem::setIsSplitImpulseActive(bool isActiv
     mIsSplitImpulseActive = isActive;
 }
 
+// Enable or disable the SIMD solver of the colored islands
+/// This has no effect if the library is not compiled with the RP3D_SIMD_CONTACT_SOLVER_ENABLED option
+RP3D_FORCE_INLINE void ContactSolverSystem::setIsSimdSolverEnabled(bool isEnabled) {
+    mIsSimdSolverEnabled = isEnabled;
+}
+
 // Compute the collision restitution factor from the restitution factor of each collider
 RP3D_FORCE_INLINE decimal ContactSolverSystem::computeMixedRestitutionFactor(const Material& material1, const Material& material2) const {
 
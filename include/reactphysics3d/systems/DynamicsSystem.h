@@ -36,6 +36,7 @@
 namespace reactphysics3d {
 
 class PhysicsWorld;
+class TaskScheduler;
 
 // Class DynamicsSystem
 /**
@@ -51,6 +52,9 @@ class DynamicsSystem {
         /// Physics world
         PhysicsWorld& mWorld;
 
+        /// Task scheduler used to process the bodies in parallel
+        TaskScheduler& mTaskScheduler;
+
         /// Reference to the collision body components
         BodyComponents& mBodyComponents;
 
@@ -80,7 +84,7 @@ class DynamicsSystem {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        DynamicsSystem(PhysicsWorld& world, BodyComponents& bodyComponents,
+        DynamicsSystem(PhysicsWorld& world, TaskScheduler& taskScheduler, BodyComponents& bodyComponents,
                        RigidBodyComponents& rigidBodyComponents, TransformComponents& transformComponents,
                        ColliderComponents& colliderComponents, bool& isGravityEnabled, Vector3& gravity);
 
@@ -106,9 +110,6 @@ class DynamicsSystem {
         /// Reset the external force and torque applied to the bodies
         void resetBodiesForceAndTorque();
 
-        /// Reset the split velocities of the bodies
-        void resetSplitVelocities();
-
 };
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -113,9 +113,15 @@ class SolveHingeJointSystem {
         /// Warm start the constraint (apply the previous impulse at the beginning of the step)
          void warmstart();
 
+        /// Warm start the constraint of the joint at a given index in the components arrays
+        void warmstartJoint(uint32 i);
+
         /// Solve the velocity constraint
         void solveVelocityConstraint();
 
+        /// Solve the velocity constraint of the joint at a given index in the components arrays
+        void solveVelocityConstraintJoint(uint32 i);
+
         /// Solve the position constraint (for position error correction)
         void solvePositionConstraint();
 
@@ -0,0 +1,186 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_DEFAULT_TASK_SCHEDULER_H
+#define REACTPHYSICS3D_DEFAULT_TASK_SCHEDULER_H
+
+// Libraries
+#include <reactphysics3d/utils/TaskScheduler.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class DefaultTaskScheduler
+/**
+ * This class is the default task scheduler of the library. It is a work-stealing thread pool.
+ * The calling thread of a parallel-for is used as the first worker and (nbWorkers - 1)
+ * threads are created for the other workers. At the beginning of a parallel-for, each worker
+ * receives a contiguous range of chunks. A worker processes its own chunks from the front of
+ * its range and, once it has no more work, it steals chunks from the back of the ranges of the
+ * other workers. With a single worker, the chunks are executed in order on the calling thread
+ * exactly like a sequential loop. A parallel-for submitted from inside a task of the same
+ * scheduler is executed sequentially by the current worker.
+ */
+class DefaultTaskScheduler : public TaskScheduler {
+
+    private:
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure WorkQueue
+        /**
+         * Range of chunks that remain to be processed by a worker
+         */
+        struct WorkQueue {
+
+            /// Mutex to protect the range (it can be modified by thieves)
+            std::mutex mutex;
+
+            /// Index of the next chunk to process by the owner of the queue
+            uint32 startChunk = 0;
+
+            /// Index after the last chunk of the queue (chunks are stolen from here)
+            uint32 endChunk = 0;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Number of workers (including the calling thread)
+        uint32 mNbWorkers;
+
+        /// Array with the (mNbWorkers - 1) worker threads
+        std::thread* mThreads;
+
+        /// Array with the work queue of each worker
+        WorkQueue* mWorkQueues;
+
+        /// Mutex used to make sure that a single parallel-for is running at a time
+        std::mutex mSubmitMutex;
+
+        /// Mutex to protect the state of the current parallel-for
+        std::mutex mMutex;
+
+        /// Condition variable used to wake up the worker threads
+        std::condition_variable mWorkAvailableCondition;
+
+        /// Condition variable used to notify the calling thread that the workers are done
+        std::condition_variable mWorkDoneCondition;
+
+        /// Function of the current parallel-for
+        const ParallelForFunction* mFunction;
+
+        /// Number of items of the current parallel-for
+        uint32 mNbItems;
+
+        /// Chunk size of the current parallel-for
+        uint32 mChunkSize;
+
+        /// Index that is incremented each time a new parallel-for is started
+        uint64 mJobIndex;
+
+        /// Number of worker threads that have not finished the current parallel-for yet
+        uint32 mNbBusyWorkerThreads;
+
+        /// True if the worker threads need to terminate
+        bool mIsQuitting;
+
+        /// Scheduler of the task currently executed by this thread (if any)
+        static thread_local const DefaultTaskScheduler* mCurrentScheduler;
+
+        /// Index of the worker that corresponds to this thread in the current scheduler
+        static thread_local uint32 mCurrentWorkerIndex;
+
+        // -------------------- Methods -------------------- //
+
+        /// Main loop of a worker thread
+        void runWorkerThread(uint32 workerIndex);
+
+        /// Process chunks of the current parallel-for until there is no more work
+        void executeChunks(uint32 workerIndex);
+
+        /// Take the next chunk of the work queue of a worker
+        bool popChunk(uint32 workerIndex, uint32& chunkIndex);
+
+        /// Steal a chunk from the work queue of another worker
+        bool stealChunk(uint32 workerIndex, uint32& chunkIndex);
+
+        /// Return the size to allocate for an array (an integral multiple of the global alignment)
+        static size_t computeAllocatedSize(size_t size);
+
+        /// Execute a single chunk of the current parallel-for
+        void executeChunk(const ParallelForFunction& function, uint32 chunkIndex, uint32 nbItems,
+                          uint32 chunkSize, uint32 workerIndex);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        DefaultTaskScheduler(MemoryAllocator& allocator, uint32 nbWorkers = 0);
+
+        /// Destructor
+        virtual ~DefaultTaskScheduler() override;
+
+        /// Assignment operator
+        DefaultTaskScheduler& operator=(DefaultTaskScheduler& taskScheduler) = delete;
+
+        /// Return the number of workers (including the calling thread) that execute the tasks
+        virtual uint32 getNbWorkers() const override;
+
+        /// Call the function for each chunk of the range [0, nbItems[ and return once all the chunks have been processed
+        virtual void parallelFor(uint32 nbItems, uint32 chunkSize, const ParallelForFunction& function) override;
+};
+
+// Return the number of workers (including the calling thread) that execute the tasks
+RP3D_FORCE_INLINE uint32 DefaultTaskScheduler::getNbWorkers() const {
+    return mNbWorkers;
+}
+
+// Return the size to allocate for an array (an integral multiple of the global alignment)
+RP3D_FORCE_INLINE size_t DefaultTaskScheduler::computeAllocatedSize(size_t size) {
+    return ((size + GLOBAL_ALIGNMENT - 1) / GLOBAL_ALIGNMENT) * GLOBAL_ALIGNMENT;
+}
+
+// Execute a single chunk of the current parallel-for
+RP3D_FORCE_INLINE void DefaultTaskScheduler::executeChunk(const ParallelForFunction& function, uint32 chunkIndex, uint32 nbItems,
+                                                          uint32 chunkSize, uint32 workerIndex) {
+
+    const uint32 startIndex = chunkIndex * chunkSize;
+    const uint32 endIndex = std::min(nbItems, startIndex + chunkSize);
+
+    function(TaskRange{chunkIndex, startIndex, endIndex, workerIndex});
+}
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TASK_SCHEDULER_H
+#define REACTPHYSICS3D_TASK_SCHEDULER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <functional>
+#include <cassert>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class TaskScheduler
+/**
+ * This abstract class is the base class of the task schedulers used by a physics world to
+ * execute some parts of its work in parallel. The work is submitted as a parallel-for over
+ * a range of items that is split into chunks of a given size. The way a range is split into
+ * chunks only depends on the number of items and on the chunk size (never on the number of
+ * workers). Therefore, results written per chunk can be merged in a deterministic order.
+ * You can implement this interface to execute the tasks of the library in your own job system.
+ */
+class TaskScheduler {
+
+    public:
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure TaskRange
+        /**
+         * Range of items processed by a single task of a parallel-for
+         */
+        struct TaskRange {
+
+            /// Index of the chunk in the parallel-for
+            uint32 chunkIndex;
+
+            /// Index of the first item of the chunk
+            uint32 startIndex;
+
+            /// Index after the last item of the chunk
+            uint32 endIndex;
+
+            /// Index (in range [0, getNbWorkers()[) of the worker that executes the chunk
+            uint32 workerIndex;
+        };
+
+        /// Function called for each chunk of a parallel-for
+        using ParallelForFunction = std::function<void(const TaskRange& range)>;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        TaskScheduler() = default;
+
+        /// Destructor
+        virtual ~TaskScheduler() = default;
+
+        /// Assignment operator
+        TaskScheduler& operator=(TaskScheduler& taskScheduler) = delete;
+
+        /// Return the number of workers (including the calling thread) that execute the tasks
+        virtual uint32 getNbWorkers() const=0;
+
+        /// Call the function for each chunk of the range [0, nbItems[ and return once all the chunks
+        /// have been processed. Two chunks of a same parallel-for are never executed
+        /// concurrently by the same worker.
+        virtual void parallelFor(uint32 nbItems, uint32 chunkSize, const ParallelForFunction& function)=0;
+
+        /// Return the number of chunks of a parallel-for over a given number of items
+        static uint32 computeNbChunks(uint32 nbItems, uint32 chunkSize);
+};
+
+// Return the number of chunks of a parallel-for over a given number of items
+/**
+ * @param nbItems Number of items of the parallel-for
+ * @param chunkSize Maximum number of items in a chunk
+ * @return The number of chunks
+ */
+RP3D_FORCE_INLINE uint32 TaskScheduler::computeNbChunks(uint32 nbItems, uint32 chunkSize) {
+    assert(chunkSize > 0);
+    return (nbItems + chunkSize - 1) / chunkSize;
+}
+
+}
+
+#endif
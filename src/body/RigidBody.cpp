@@ -41,6 +41,27 @@ using namespace reactphysics3d;
 */
 RigidBody::RigidBody(PhysicsWorld& world, Entity entity) : Body(world, entity) {
 
+    const Transform& transform = mWorld.mTransformComponents.getTransform(mEntity);
+    mTransformsSnapshots[0] = transform;
+    mTransformsSnapshots[1] = transform;
+}
+
+// Return the position and orientation of the body at the end of the last update of the world
+/// Contrary to getTransform(), this method can be called from any thread while an asynchronous update
+/// of the world is running (see PhysicsWorld::updateAsync()). The returned transform is not modified until
+/// the end of the next update of the world. The transform set with setTransform() is only visible in the
+/// snapshot after the next update. The snapshots are only maintained once the world has been updated with
+/// PhysicsWorld::updateAsync(). Before that, this method returns the current transform of the body.
+/**
+ * @return The transform of the body in the snapshot of the last update of the world
+ */
+const Transform& RigidBody::getTransformSnapshot() const {
+
+    if (!mWorld.mIsTransformsSnapshotsEnabled.load(std::memory_order_acquire)) {
+        return getTransform();
+    }
+
+    return mTransformsSnapshots[mWorld.mTransformsSnapshotIndex.load(std::memory_order_acquire)];
 }
 
 // Return the type of the body
@@ -27,6 +27,7 @@
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/utils/Logger.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
 #include <reactphysics3d/engine/PhysicsCommon.h>
@@ -172,6 +173,12 @@ const Transform& Collider::getLocalToBodyTransform() const {
  * @return True if the ray hits the collision shape
  */
 bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
+    return raycast(ray, raycastInfo, mMemoryManager.getPoolAllocator());
+}
+
+// Raycast method with feedback information
+/// This method can be called concurrently from several threads if each one uses its own allocator
+bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator) {
 
     // If the corresponding body is not active, it cannot be hit by rays
     if (!mBody->isActive()) return false;
@@ -182,7 +189,7 @@ bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
     Ray rayLocal(worldToLocalTransform * ray.point1, worldToLocalTransform * ray.point2, ray.maxFraction);
 
     const CollisionShape* collisionShape = mBody->mWorld.mCollidersComponents.getCollisionShape(mEntity);
-    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, mMemoryManager.getPoolAllocator());
+    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, allocator);
 
     // Convert the raycast info into world-space
     raycastInfo.worldPoint = localToWorldTransform * raycastInfo.worldPoint;
@@ -192,6 +199,40 @@ bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
     return isHit;
 }
 
+// Raycast method for a packet of rays with feedback information
+/// The rays whose bits are set in the mask are tested and the bit i of the returned mask is set if the
+/// ray i hits the collider. This method can be called concurrently from several threads if each one uses
+/// its own allocator.
+uint32 Collider::raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, MemoryAllocator& allocator) {
+
+    // If the corresponding body is not active, it cannot be hit by rays
+    if (!mBody->isActive()) return 0;
+
+    // Convert the rays into the local-space of the collision shape
+    const Transform& localToWorldTransform = mBody->mWorld.mCollidersComponents.getLocalToWorldTransform(mEntity);
+    const Transform worldToLocalTransform = localToWorldTransform.getInverse();
+    Ray raysLocal[SimdDecimal::NB_LANES];
+    for (uint32 i=0; raysMask >> i != 0; i++) {
+        if ((raysMask & (1u << i)) != 0) {
+            raysLocal[i] = Ray(worldToLocalTransform * rays[i].point1, worldToLocalTransform * rays[i].point2, rays[i].maxFraction);
+        }
+    }
+
+    const CollisionShape* collisionShape = mBody->mWorld.mCollidersComponents.getCollisionShape(mEntity);
+    const uint32 hitRaysMask = collisionShape->raycastPacket(raysLocal, raysMask, raycastInfos, this, allocator);
+
+    // Convert the raycast infos into world-space
+    for (uint32 i=0; hitRaysMask >> i != 0; i++) {
+        if ((hitRaysMask & (1u << i)) != 0) {
+            raycastInfos[i].worldPoint = localToWorldTransform * raycastInfos[i].worldPoint;
+            raycastInfos[i].worldNormal = localToWorldTransform.getOrientation() * raycastInfos[i].worldNormal;
+            raycastInfos[i].worldNormal.normalize();
+        }
+    }
+
+    return hitRaysMask;
+}
+
 // Return the collision category bits
 /**
  * @return The collision category bits mask of the collider
@@ -211,6 +252,12 @@ unsigned short Collider::getCollideWithMaskBits() const {
 // Notify the collider that the size of the collision shape has been changed by the user
 void Collider::setHasCollisionShapeChangedSize(bool hasCollisionShapeChangedSize) {
     mBody->mWorld.mCollidersComponents.setHasCollisionShapeChangedSize(mEntity, hasCollisionShapeChangedSize);
+
+    // The cached contact points of the overlapping pairs of the collider are not valid anymore. They are
+    // removed now because the flag is reset by the broad-phase before the middle-phase is computed
+    if (hasCollisionShapeChangedSize) {
+        mBody->mWorld.mCollisionDetection.notifyOverlappingPairsToTestOverlap(this);
+    }
 }
 
 // Set a new material for this rigid body
@@ -30,6 +30,7 @@
 #include <reactphysics3d/utils/DefaultLogger.h>
 #include <reactphysics3d/engine/PhysicsCommon.h>
 #include <reactphysics3d/utils/Message.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <cstdlib>
 #include <vector>
 
@@ -43,7 +44,8 @@ using namespace reactphysics3d;
  */
 ConvexMesh::ConvexMesh(MemoryAllocator& allocator)
                : mMemoryAllocator(allocator), mHalfEdgeStructure(allocator, 6, 8, 24),
-                 mVertices(allocator), mFacesNormals(allocator), mVolume(0) {
+                 mVertices(allocator), mVerticesX(allocator), mVerticesY(allocator),
+                 mVerticesZ(allocator), mFacesNormals(allocator), mVolume(0) {
 
 }
 
@@ -101,6 +103,19 @@ bool ConvexMesh::copyVertices(const PolygonVertexArray& polygonVertexArray, std:
     if (getNbVertices() > 0) {
 
         mCentroid /= static_cast<decimal>(getNbVertices());
+
+        // Copy the coordinates of the vertices for the SIMD search of the support vertex (the
+        // padding vertices are copies of the first vertex so that they are never the only maximum)
+        const uint32 nbPaddedVertices = ((getNbVertices() + SimdDecimal::NB_LANES - 1) / SimdDecimal::NB_LANES) * SimdDecimal::NB_LANES;
+        mVerticesX.reserve(nbPaddedVertices);
+        mVerticesY.reserve(nbPaddedVertices);
+        mVerticesZ.reserve(nbPaddedVertices);
+        for (uint32 i=0; i < nbPaddedVertices; i++) {
+            const Vector3& vertex = mVertices[i < getNbVertices() ? i : 0];
+            mVerticesX.add(vertex.x);
+            mVerticesY.add(vertex.y);
+            mVerticesZ.add(vertex.z);
+        }
     }
     else {
 
@@ -262,3 +277,90 @@ void ConvexMesh::computeVolume() {
 
     mVolume = std::abs(sum) / decimal(3.0);
 }
+
+// Return the index of the vertex with the largest dot product in a direction (testing all the vertices)
+/// The dot products are computed with SIMD instructions in a first pass to find the largest
+/// dot product. A second pass returns the first vertex with this dot product (which is the same
+/// vertex as the one of a scalar loop over the vertices).
+uint32 ConvexMesh::computeSupportVertexIndex(const Vector3& direction) const {
+
+    assert(getNbVertices() > 0);
+
+    const SimdDecimal directionX(direction.x);
+    const SimdDecimal directionY(direction.y);
+    const SimdDecimal directionZ(direction.z);
+    const uint32 nbPaddedVertices = static_cast<uint32>(mVerticesX.size());
+
+    // Compute the largest dot product of each lane
+    SimdDecimal maxDotProducts(-DECIMAL_LARGEST);
+    for (uint32 i=0; i < nbPaddedVertices; i += SimdDecimal::NB_LANES) {
+        const SimdDecimal dotProducts = directionX * SimdDecimal::load(&mVerticesX[i]) + directionY * SimdDecimal::load(&mVerticesY[i]) +
+                                        directionZ * SimdDecimal::load(&mVerticesZ[i]);
+        maxDotProducts = max(maxDotProducts, dotProducts);
+    }
+
+    decimal lanes[SimdDecimal::NB_LANES];
+    maxDotProducts.store(lanes);
+    decimal maxDotProduct = lanes[0];
+    for (uint32 l=1; l < SimdDecimal::NB_LANES; l++) {
+        maxDotProduct = std::max(maxDotProduct, lanes[l]);
+    }
+
+    // Find the first vertex with the largest dot product
+    const SimdDecimal maxDotProductPack(maxDotProduct);
+    for (uint32 i=0; i < nbPaddedVertices; i += SimdDecimal::NB_LANES) {
+        const SimdDecimal dotProducts = directionX * SimdDecimal::load(&mVerticesX[i]) + directionY * SimdDecimal::load(&mVerticesY[i]) +
+                                        directionZ * SimdDecimal::load(&mVerticesZ[i]);
+        const uint32 mask = lessOrEqualMask(maxDotProductPack, dotProducts);
+        if (mask != 0) {
+            uint32 lane = 0;
+            while ((mask & (1u << lane)) == 0) lane++;
+            return i + lane < getNbVertices() ? i + lane : 0;
+        }
+    }
+
+    // The dot products are not comparable (NaN direction)
+    return 0;
+}
+
+// Return the index of the vertex with the largest dot product in a direction (hill-climbing from a start vertex)
+/// We move from the current vertex to an adjacent vertex (using the half-edge structure) with a larger
+/// dot product until none of the adjacent vertices is better. Because the mesh is convex, this local
+/// maximum is the global one. When the start vertex is the support vertex of a close direction (previous
+/// GJK iteration or previous frame), only a few vertices are visited.
+uint32 ConvexMesh::computeSupportVertexIndex(const Vector3& direction, uint32 startVertexIndex) const {
+
+    assert(startVertexIndex < getNbVertices());
+
+    uint32 vertexIndex = startVertexIndex;
+    decimal maxDotProduct = direction.dot(mVertices[vertexIndex]);
+
+    bool isMaxFound = false;
+    while (!isMaxFound) {
+
+        isMaxFound = true;
+
+        // For each half-edge starting at the current vertex
+        const uint32 firstEdgeIndex = mHalfEdgeStructure.getVertex(vertexIndex).edgeIndex;
+        uint32 edgeIndex = firstEdgeIndex;
+        do {
+
+            const HalfEdgeStructure::Edge& twinEdge = mHalfEdgeStructure.getHalfEdge(mHalfEdgeStructure.getHalfEdge(edgeIndex).twinEdgeIndex);
+
+            // If the vertex at the end of the edge is better, we move to it
+            const decimal dotProduct = direction.dot(mVertices[twinEdge.vertexIndex]);
+            if (dotProduct > maxDotProduct) {
+                maxDotProduct = dotProduct;
+                vertexIndex = twinEdge.vertexIndex;
+                isMaxFound = false;
+                break;
+            }
+
+            // Next half-edge starting at the current vertex
+            edgeIndex = twinEdge.nextEdgeIndex;
+
+        } while (edgeIndex != firstEdgeIndex);
+    }
+
+    return vertexIndex;
+}
@@ -35,7 +35,7 @@ decimal RaycastTest::raycastAgainstShape(Collider* shape, const Ray& ray) {
 
     // Ray casting test against the collision shape
     RaycastInfo raycastInfo;
-    bool isHit = shape->raycast(ray, raycastInfo);
+    bool isHit = shape->raycast(ray, raycastInfo, allocator);
 
     // If the ray hit the collision shape
     if (isHit) {
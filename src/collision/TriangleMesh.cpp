@@ -332,8 +332,8 @@ void TriangleMesh::computeVerticesNormals() {
 }
 
 // Report all shapes overlapping with the AABB given in parameter.
-void TriangleMesh::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes) {
-    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+void TriangleMesh::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& allocator) const {
+    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes, allocator);
 }
 
 // Return the integer data of leaf node of the dynamic AABB tree
@@ -342,6 +342,11 @@ int32 TriangleMesh::getDynamicAABBTreeNodeDataInt(int32 nodeID) const {
 }
 
 // Ray casting method
-void TriangleMesh::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
-    mDynamicAABBTree.raycast(ray, callback);
+void TriangleMesh::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& allocator) const {
+    mDynamicAABBTree.raycast(ray, callback, allocator);
+}
+
+// Ray casting method for a packet of rays
+void TriangleMesh::raycastPacket(const Ray* rays, uint32 raysMask, DynamicAABBTreeRaycastPacketCallback& callback, MemoryAllocator& allocator) const {
+    mDynamicAABBTree.raycastPacket(rays, raysMask, callback, allocator);
 }
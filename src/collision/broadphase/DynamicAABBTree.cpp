@@ -27,6 +27,7 @@
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
 #include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <reactphysics3d/utils/Profiler.h>
 
 using namespace reactphysics3d;
@@ -639,11 +640,18 @@ void DynamicAABBTree::reportAllShapesOverlappingWithShapes(const Array<int32>& n
 
 // Report all shapes overlapping with the AABB given in parameter.
 void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes) const {
+    reportAllShapesOverlappingWithAABB(aabb, overlappingNodes, mAllocator);
+}
+
+// Report all shapes overlapping with the AABB given in parameter.
+/// This method does not modify the tree. It can be called concurrently from several
+/// threads if each one uses its own allocator for the stack of nodes to visit.
+void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& stackAllocator) const {
 
     RP3D_PROFILE("DynamicAABBTree::reportAllShapesOverlappingWithAABB()", mProfiler);
 
     // Create a stack with the nodes to visit
-    Stack<int32> stack(mAllocator, 64);
+    Stack<int32> stack(stackAllocator, 64);
     stack.push(mRootNodeID);
 
     // While there are still nodes to visit
@@ -682,6 +690,13 @@ void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array
 
 // Ray casting method
 void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+    raycast(ray, callback, mAllocator);
+}
+
+// Ray casting method
+/// This method does not modify the tree. It can be called concurrently from several
+/// threads if each one uses its own allocator for the stack of nodes to visit.
+void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const {
 
     RP3D_PROFILE("DynamicAABBTree::raycast()", mProfiler);
 
@@ -691,7 +706,7 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& ca
     const Vector3 rayDirection = ray.point2 - ray.point1;
     const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
 
-    Stack<int32> stack(mAllocator, 128);
+    Stack<int32> stack(stackAllocator, 128);
     stack.push(mRootNodeID);
 
     // Walk through the tree from the root looking for colliders
@@ -746,6 +761,112 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& ca
     }
 }
 
+// Ray casting method for a packet of rays that traverse the tree together
+/// The rays of the packet (at most SimdDecimal::NB_LANES rays whose bits are set in the mask) are
+/// tested against the AABB of a node with SIMD instructions and a node is visited as long as one of the
+/// rays hits it. Therefore, the rays should be coherent (similar origins and directions). The children
+/// of a node are visited in the mean direction of the rays. This method does not modify the tree.
+/// It can be called concurrently from several threads if each one uses its own allocator for the stack
+/// of nodes to visit.
+void DynamicAABBTree::raycastPacket(const Ray* rays, uint32 raysMask, DynamicAABBTreeRaycastPacketCallback& callback,
+                                    MemoryAllocator& stackAllocator) const {
+
+    RP3D_PROFILE("DynamicAABBTree::raycastPacket()", mProfiler);
+
+    assert(raysMask < (1u << SimdDecimal::NB_LANES));
+
+    // Compute the origins, the inverse directions and the maximum fractions of the rays. A zero
+    // component of a direction is replaced by a large value instead of an infinity so that a ray
+    // lying exactly on a slab plane does not produce a NaN.
+    decimal originsX[SimdDecimal::NB_LANES], originsY[SimdDecimal::NB_LANES], originsZ[SimdDecimal::NB_LANES];
+    decimal inverseDirectionsX[SimdDecimal::NB_LANES], inverseDirectionsY[SimdDecimal::NB_LANES], inverseDirectionsZ[SimdDecimal::NB_LANES];
+    decimal maxFractions[SimdDecimal::NB_LANES];
+    Vector3 meanDirection(0, 0, 0);
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+
+        if ((raysMask & (1u << i)) != 0) {
+
+            const Vector3 rayDirection = rays[i].point2 - rays[i].point1;
+            originsX[i] = rays[i].point1.x;
+            originsY[i] = rays[i].point1.y;
+            originsZ[i] = rays[i].point1.z;
+            inverseDirectionsX[i] = rayDirection.x == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.x;
+            inverseDirectionsY[i] = rayDirection.y == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.y;
+            inverseDirectionsZ[i] = rayDirection.z == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.z;
+            maxFractions[i] = rays[i].maxFraction;
+            meanDirection += rayDirection;
+        }
+        else {
+            originsX[i] = originsY[i] = originsZ[i] = decimal(0.0);
+            inverseDirectionsX[i] = inverseDirectionsY[i] = inverseDirectionsZ[i] = decimal(1.0);
+            maxFractions[i] = decimal(-1.0);
+        }
+    }
+
+    const SimdDecimal rayOrigin[3] = {SimdDecimal::load(originsX), SimdDecimal::load(originsY), SimdDecimal::load(originsZ)};
+    const SimdDecimal rayDirectionInverse[3] = {SimdDecimal::load(inverseDirectionsX), SimdDecimal::load(inverseDirectionsY),
+                                                SimdDecimal::load(inverseDirectionsZ)};
+    const SimdDecimal zero(decimal(0.0));
+
+    uint32 activeRaysMask = raysMask;
+
+    Stack<int32> stack(stackAllocator, 128);
+    stack.push(mRootNodeID);
+
+    // Walk through the tree from the root looking for colliders
+    // that overlap with the rays AABB
+    while (stack.size() > 0) {
+
+        // Get the next node in the stack
+        const int32 nodeID = stack.pop();
+
+        // If it is a null node, skip it
+        if (nodeID == TreeNode::NULL_TREE_NODE) continue;
+
+        // Get the corresponding node
+        const TreeNode* node = mNodes + nodeID;
+
+        // Test which rays of the packet intersect with the current node AABB
+        const Vector3& aabbMin = node->aabb.getMin();
+        const Vector3& aabbMax = node->aabb.getMax();
+        const SimdDecimal t1X = (SimdDecimal(aabbMin.x) - rayOrigin[0]) * rayDirectionInverse[0];
+        const SimdDecimal t2X = (SimdDecimal(aabbMax.x) - rayOrigin[0]) * rayDirectionInverse[0];
+        const SimdDecimal t1Y = (SimdDecimal(aabbMin.y) - rayOrigin[1]) * rayDirectionInverse[1];
+        const SimdDecimal t2Y = (SimdDecimal(aabbMax.y) - rayOrigin[1]) * rayDirectionInverse[1];
+        const SimdDecimal t1Z = (SimdDecimal(aabbMin.z) - rayOrigin[2]) * rayDirectionInverse[2];
+        const SimdDecimal t2Z = (SimdDecimal(aabbMax.z) - rayOrigin[2]) * rayDirectionInverse[2];
+
+        const SimdDecimal tMin = max(max(min(t1X, t2X), min(t1Y, t2Y)), max(min(t1Z, t2Z), zero));
+        const SimdDecimal tMax = min(min(max(t1X, t2X), max(t1Y, t2Y)), min(max(t1Z, t2Z), SimdDecimal::load(maxFractions)));
+
+        const uint32 hitRaysMask = activeRaysMask & lessOrEqualMask(tMin, tMax);
+        if (hitRaysMask == 0) continue;
+
+        // If the node is a leaf of the tree
+        if (node->isLeaf()) {
+
+            // Call the callback that will raycast again the broad-phase shape with the rays
+            // and stop the rays requested by the callback
+            activeRaysMask &= ~callback.raycastBroadPhaseShape(nodeID, hitRaysMask, maxFractions);
+
+            if (activeRaysMask == 0) return;
+        }
+        else {  // If the node has children
+
+            // Push its children in the stack so that the closest one in the mean direction of the rays is visited first
+            const Vector3 childrenCentersDifference = mNodes[node->children[1]].aabb.getCenter() - mNodes[node->children[0]].aabb.getCenter();
+            if (childrenCentersDifference.dot(meanDirection) > decimal(0.0)) {
+                stack.push(node->children[1]);
+                stack.push(node->children[0]);
+            }
+            else {
+                stack.push(node->children[0]);
+                stack.push(node->children[1]);
+            }
+        }
+    }
+}
+
 #ifndef NDEBUG
 
 // Check if the tree structure is valid (for debugging purpose)
@@ -0,0 +1,350 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/WideAABBTree.h>
+#include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/mathematics/Ray.h>
+#include <reactphysics3d/utils/Profiler.h>
+
+using namespace reactphysics3d;
+
+// Constructor
+WideAABBTree::WideAABBTree(MemoryAllocator& allocator, const DynamicAABBTree& dynamicAABBTree)
+             : mAllocator(allocator), mDynamicAABBTree(dynamicAABBTree), mNodes(allocator) {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    mProfiler = nullptr;
+
+#endif
+
+}
+
+// Build the wide tree from the current state of the dynamic AABB tree
+/// Each node of the wide tree is created from a node of the dynamic AABB tree by replacing
+/// the internal node with the largest surface area by its two children until the node has
+/// NB_MAX_CHILDREN children (or only leaves). The fat AABBs of the leaves are copied so that the
+/// queries report exactly the same leaf nodes as the queries of the dynamic AABB tree.
+void WideAABBTree::build() {
+
+    RP3D_PROFILE("WideAABBTree::build()", mProfiler);
+
+    mNodes.clear();
+
+    const TreeNode* binaryNodes = mDynamicAABBTree.mNodes;
+    const int32 rootNodeID = mDynamicAABBTree.mRootNodeID;
+    if (rootNodeID == TreeNode::NULL_TREE_NODE) return;
+
+    // Nodes of the dynamic AABB tree to collapse with the index of the corresponding wide node
+    Array<Pair<int32, uint32>> nodesToCollapse(mAllocator, 64);
+
+    mNodes.add(WideTreeNode());
+    nodesToCollapse.add(Pair<int32, uint32>(rootNodeID, 0));
+
+    while (nodesToCollapse.size() > 0) {
+
+        const Pair<int32, uint32> nodeToCollapse = nodesToCollapse[nodesToCollapse.size() - 1];
+        nodesToCollapse.removeAt(nodesToCollapse.size() - 1);
+
+        // Compute the nodes of the dynamic AABB tree that will be the children of the wide node
+        int32 childrenIDs[WideTreeNode::NB_MAX_CHILDREN];
+        uint32 nbChildren = 1;
+        childrenIDs[0] = nodeToCollapse.first;
+
+        while (nbChildren < WideTreeNode::NB_MAX_CHILDREN) {
+
+            // Find the internal node with the largest surface area
+            int32 largestChildIndex = -1;
+            decimal largestArea = decimal(-1.0);
+            for (uint32 i=0; i < nbChildren; i++) {
+
+                const TreeNode& child = binaryNodes[childrenIDs[i]];
+                if (!child.isLeaf()) {
+
+                    const Vector3 extent = child.aabb.getMax() - child.aabb.getMin();
+                    const decimal area = extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+                    if (area > largestArea) {
+                        largestArea = area;
+                        largestChildIndex = static_cast<int32>(i);
+                    }
+                }
+            }
+
+            // If all the children are leaves
+            if (largestChildIndex == -1) break;
+
+            // Replace the internal node by its two children
+            const TreeNode& largestChild = binaryNodes[childrenIDs[largestChildIndex]];
+            childrenIDs[largestChildIndex] = largestChild.children[0];
+            childrenIDs[nbChildren] = largestChild.children[1];
+            nbChildren++;
+        }
+
+        WideTreeNode node;
+        node.leavesMask = 0;
+        node.childrenMask = 0;
+
+        for (uint32 i=0; i < WideTreeNode::NB_MAX_CHILDREN; i++) {
+
+            if (i < nbChildren) {
+
+                const TreeNode& child = binaryNodes[childrenIDs[i]];
+                node.minX[i] = child.aabb.getMin().x;
+                node.minY[i] = child.aabb.getMin().y;
+                node.minZ[i] = child.aabb.getMin().z;
+                node.maxX[i] = child.aabb.getMax().x;
+                node.maxY[i] = child.aabb.getMax().y;
+                node.maxZ[i] = child.aabb.getMax().z;
+                node.childrenMask |= (1u << i);
+
+                // If the child is a leaf, we store the ID of the leaf node
+                if (child.isLeaf()) {
+                    node.children[i] = childrenIDs[i];
+                    node.leavesMask |= (1u << i);
+                }
+                else {  // If the child is an internal node, it will be collapsed into a new wide node
+
+                    node.children[i] = static_cast<int32>(mNodes.size());
+                    nodesToCollapse.add(Pair<int32, uint32>(childrenIDs[i], static_cast<uint32>(mNodes.size())));
+                    mNodes.add(WideTreeNode());
+                }
+            }
+            else {  // Empty lane (the lane is never reported because of the children mask)
+
+                node.minX[i] = node.minY[i] = node.minZ[i] = DECIMAL_LARGEST;
+                node.maxX[i] = node.maxY[i] = node.maxZ[i] = -DECIMAL_LARGEST;
+                node.children[i] = TreeNode::NULL_TREE_NODE;
+            }
+        }
+
+        mNodes[nodeToCollapse.second] = node;
+    }
+}
+
+// Return a bit mask of the children of a node whose AABB overlaps with an AABB
+RP3D_FORCE_INLINE uint32 WideAABBTree::testChildrenOverlap(const WideTreeNode& node, const SimdDecimal* aabbMin,
+                                                           const SimdDecimal* aabbMax) {
+
+    return node.childrenMask &
+           lessOrEqualMask(SimdDecimal::load(node.minX), aabbMax[0]) & lessOrEqualMask(aabbMin[0], SimdDecimal::load(node.maxX)) &
+           lessOrEqualMask(SimdDecimal::load(node.minY), aabbMax[1]) & lessOrEqualMask(aabbMin[1], SimdDecimal::load(node.maxY)) &
+           lessOrEqualMask(SimdDecimal::load(node.minZ), aabbMax[2]) & lessOrEqualMask(aabbMin[2], SimdDecimal::load(node.maxZ));
+}
+
+/// Take an array of shapes to be tested for broad-phase overlap and return an array of pair of overlapping shapes
+void WideAABBTree::reportAllShapesOverlappingWithShapes(const Array<int32>& nodesToTest, uint32 startIndex,
+                                                        size_t endIndex, Array<Pair<int32, int32>>& outOverlappingNodes) const {
+
+    RP3D_PROFILE("WideAABBTree::reportAllShapesOverlappingWithShapes()", mProfiler);
+
+    if (mNodes.size() == 0) return;
+
+    // Create a stack with the wide nodes to visit
+    Stack<uint32> stack(mAllocator, 64);
+
+    // For each shape to be tested for overlap
+    for (uint32 i=startIndex; i < endIndex; i++) {
+
+        assert(nodesToTest[i] != -1);
+
+        const AABB& shapeAABB = mDynamicAABBTree.getFatAABB(nodesToTest[i]);
+        const SimdDecimal aabbMin[3] = {SimdDecimal(shapeAABB.getMin().x), SimdDecimal(shapeAABB.getMin().y), SimdDecimal(shapeAABB.getMin().z)};
+        const SimdDecimal aabbMax[3] = {SimdDecimal(shapeAABB.getMax().x), SimdDecimal(shapeAABB.getMax().y), SimdDecimal(shapeAABB.getMax().z)};
+
+        stack.push(0);
+
+        // While there are still nodes to visit
+        while (stack.size() > 0) {
+
+            const WideTreeNode& node = mNodes[stack.pop()];
+
+            // Test the AABBs of all the children of the node at once
+            const uint32 overlappingChildren = testChildrenOverlap(node, aabbMin, aabbMax);
+
+            for (uint32 c=0; c < WideTreeNode::NB_MAX_CHILDREN; c++) {
+
+                if ((overlappingChildren & (1u << c)) == 0) continue;
+
+                // If the child is a leaf
+                if ((node.leavesMask & (1u << c)) != 0) {
+
+                    // Add the node in the array of overlapping nodes
+                    outOverlappingNodes.add(Pair<int32, int32>(nodesToTest[i], node.children[c]));
+                }
+                else {
+
+                    // We need to visit the child
+                    stack.push(static_cast<uint32>(node.children[c]));
+                }
+            }
+        }
+    }
+}
+
+// Report all shapes overlapping with the AABB given in parameter.
+/// This method does not modify the tree. It can be called concurrently from several
+/// threads if each one uses its own allocator for the stack of nodes to visit.
+void WideAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& stackAllocator) const {
+
+    RP3D_PROFILE("WideAABBTree::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    if (mNodes.size() == 0) return;
+
+    const SimdDecimal aabbMin[3] = {SimdDecimal(aabb.getMin().x), SimdDecimal(aabb.getMin().y), SimdDecimal(aabb.getMin().z)};
+    const SimdDecimal aabbMax[3] = {SimdDecimal(aabb.getMax().x), SimdDecimal(aabb.getMax().y), SimdDecimal(aabb.getMax().z)};
+
+    // Create a stack with the wide nodes to visit
+    Stack<uint32> stack(stackAllocator, 64);
+    stack.push(0);
+
+    // While there are still nodes to visit
+    while (stack.size() > 0) {
+
+        const WideTreeNode& node = mNodes[stack.pop()];
+
+        // Test the AABBs of all the children of the node at once
+        const uint32 overlappingChildren = testChildrenOverlap(node, aabbMin, aabbMax);
+
+        for (uint32 c=0; c < WideTreeNode::NB_MAX_CHILDREN; c++) {
+
+            if ((overlappingChildren & (1u << c)) == 0) continue;
+
+            // If the child is a leaf
+            if ((node.leavesMask & (1u << c)) != 0) {
+                overlappingNodes.add(node.children[c]);
+            }
+            else {
+                stack.push(static_cast<uint32>(node.children[c]));
+            }
+        }
+    }
+}
+
+// Ray casting method
+/// The children hit by the ray are visited from the closest one to the farthest one so that the
+/// maximum fraction of the ray shrinks as early as possible. This method does not modify the tree.
+/// It can be called concurrently from several threads if each one uses its own allocator for the stack
+/// of nodes to visit.
+void WideAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const {
+
+    RP3D_PROFILE("WideAABBTree::raycast()", mProfiler);
+
+    if (mNodes.size() == 0) return;
+
+    decimal maxFraction = ray.maxFraction;
+
+    // Compute the inverse ray direction. A zero component is replaced by a large value instead of an
+    // infinity so that a ray lying exactly on a slab plane does not produce a NaN that would be
+    // handled differently by the SIMD min/max instructions.
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    const SimdDecimal rayDirectionInverse[3] = {
+        SimdDecimal(rayDirection.x == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.x),
+        SimdDecimal(rayDirection.y == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.y),
+        SimdDecimal(rayDirection.z == decimal(0.0) ? DECIMAL_LARGEST : decimal(1.0) / rayDirection.z)};
+    const SimdDecimal rayOrigin[3] = {SimdDecimal(ray.point1.x), SimdDecimal(ray.point1.y), SimdDecimal(ray.point1.z)};
+    const SimdDecimal zero(decimal(0.0));
+
+    Stack<uint32> stack(stackAllocator, 128);
+    stack.push(0);
+
+    // Walk through the tree from the root looking for colliders
+    // that overlap with the ray AABB
+    while (stack.size() > 0) {
+
+        const WideTreeNode& node = mNodes[stack.pop()];
+
+        // Compute the intersection of the ray with the slabs of the AABBs of all the children
+        const SimdDecimal t1X = (SimdDecimal::load(node.minX) - rayOrigin[0]) * rayDirectionInverse[0];
+        const SimdDecimal t2X = (SimdDecimal::load(node.maxX) - rayOrigin[0]) * rayDirectionInverse[0];
+        const SimdDecimal t1Y = (SimdDecimal::load(node.minY) - rayOrigin[1]) * rayDirectionInverse[1];
+        const SimdDecimal t2Y = (SimdDecimal::load(node.maxY) - rayOrigin[1]) * rayDirectionInverse[1];
+        const SimdDecimal t1Z = (SimdDecimal::load(node.minZ) - rayOrigin[2]) * rayDirectionInverse[2];
+        const SimdDecimal t2Z = (SimdDecimal::load(node.maxZ) - rayOrigin[2]) * rayDirectionInverse[2];
+
+        const SimdDecimal tMin = max(max(min(t1X, t2X), min(t1Y, t2Y)), max(min(t1Z, t2Z), zero));
+        const SimdDecimal tMax = min(min(max(t1X, t2X), max(t1Y, t2Y)), min(max(t1Z, t2Z), SimdDecimal(maxFraction)));
+
+        const uint32 hitChildren = node.childrenMask & lessOrEqualMask(tMin, tMax);
+        if (hitChildren == 0) continue;
+
+        decimal tMinValues[WideTreeNode::NB_MAX_CHILDREN];
+        tMin.store(tMinValues);
+
+        // Sort the children hit by the ray from the closest one to the farthest one
+        uint32 hitChildrenLanes[WideTreeNode::NB_MAX_CHILDREN];
+        uint32 nbHitChildren = 0;
+        for (uint32 c=0; c < WideTreeNode::NB_MAX_CHILDREN; c++) {
+
+            if ((hitChildren & (1u << c)) == 0) continue;
+
+            uint32 i = nbHitChildren;
+            while (i > 0 && tMinValues[hitChildrenLanes[i - 1]] > tMinValues[c]) {
+                hitChildrenLanes[i] = hitChildrenLanes[i - 1];
+                i--;
+            }
+            hitChildrenLanes[i] = c;
+            nbHitChildren++;
+        }
+
+        // Raycast the leaves from the closest one
+        for (uint32 i=0; i < nbHitChildren; i++) {
+
+            const uint32 c = hitChildrenLanes[i];
+            if ((node.leavesMask & (1u << c)) == 0) continue;
+
+            // The maximum fraction might have been reduced by a closer leaf
+            if (tMinValues[c] > maxFraction) break;
+
+            Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
+            // Call the callback that will raycast again the broad-phase shape
+            const decimal hitFraction = callback.raycastBroadPhaseShape(node.children[c], rayTemp);
+
+            // If the user returned a hitFraction of zero, it means that
+            // the raycasting should stop here
+            if (hitFraction == decimal(0.0)) {
+                return;
+            }
+
+            // If the user returned a positive fraction, we update the maxFraction value
+            if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+                maxFraction = hitFraction;
+            }
+
+            // If the user returned a negative fraction, we continue
+            // the raycasting as if the collider did not exist
+        }
+
+        // Push the internal children in the stack so that the closest one is visited first
+        for (uint32 i=nbHitChildren; i > 0; i--) {
+
+            const uint32 c = hitChildrenLanes[i - 1];
+            if ((node.leavesMask & (1u << c)) == 0 && tMinValues[c] <= maxFraction) {
+                stack.push(static_cast<uint32>(node.children[c]));
+            }
+        }
+    }
+}
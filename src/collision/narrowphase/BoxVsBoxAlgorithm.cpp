@@ -0,0 +1,357 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxAlgorithm.h>
+#include <reactphysics3d/collision/shapes/BoxShape.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Static variables initialization
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_RELATIVE_TOLERANCE = decimal(1.002);
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_ABSOLUTE_TOLERANCE = decimal(0.0005);
+
+// Compute the narrow-phase collision detection between two boxes
+/// The separating axis test is done in the local-space of the first box where the
+/// projections of the two boxes on an axis are computed directly from their half-extents.
+bool BoxVsBoxAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex, uint32 batchNbItems,
+                                      MemoryAllocator& /*memoryAllocator*/) {
+
+    RP3D_PROFILE("BoxVsBoxAlgorithm::testCollision()", mProfiler);
+
+    bool isCollisionFound = false;
+
+    // For each item in the batch
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        assert(narrowPhaseInfoBatch.nbContactPoints[batchIndex] == 0);
+        assert(!narrowPhaseInfoBatch.isColliding[batchIndex]);
+        assert(narrowPhaseInfoBatch.collisionShapes1[batchIndex]->getName() == CollisionShapeName::BOX);
+        assert(narrowPhaseInfoBatch.collisionShapes2[batchIndex]->getName() == CollisionShapeName::BOX);
+
+        // The boxes are tested with SAT (for the previous frame info)
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
+        lastFrameCollisionInfo->wasUsingSAT = true;
+        lastFrameCollisionInfo->wasUsingGJK = false;
+
+        const Vector3& halfExtents1 = static_cast<const BoxShape*>(narrowPhaseInfoBatch.collisionShapes1[batchIndex])->getHalfExtents();
+        const Vector3& halfExtents2 = static_cast<const BoxShape*>(narrowPhaseInfoBatch.collisionShapes2[batchIndex])->getHalfExtents();
+        const Transform& transform1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex];
+        const Transform& transform2 = narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
+
+        // Center and axes of the box 2 in the local-space of box 1
+        const Transform box2ToBox1 = transform1.getInverse() * transform2;
+        const Vector3& center2 = box2ToBox1.getPosition();
+        const Matrix3x3 rotation = box2ToBox1.getOrientation().getMatrix();
+        const Vector3 axes2[3] = {rotation.getColumn(0), rotation.getColumn(1), rotation.getColumn(2)};
+        const Matrix3x3 absRotation(std::abs(rotation[0][0]), std::abs(rotation[0][1]), std::abs(rotation[0][2]),
+                                    std::abs(rotation[1][0]), std::abs(rotation[1][1]), std::abs(rotation[1][2]),
+                                    std::abs(rotation[2][0]), std::abs(rotation[2][1]), std::abs(rotation[2][2]));
+
+        // Test the face normals of the box 1 for separating axis
+        decimal penetrationDepth1 = DECIMAL_LARGEST;
+        uint32 faceAxis1 = 0;
+        bool isSeparated = false;
+        for (uint32 i=0; i < 3; i++) {
+
+            const decimal penetrationDepth = halfExtents1[i] + halfExtents2.dot(absRotation[i]) - std::abs(center2[i]);
+            if (penetrationDepth <= decimal(0.0)) {
+                isSeparated = true;
+                break;
+            }
+            if (penetrationDepth < penetrationDepth1) {
+                penetrationDepth1 = penetrationDepth;
+                faceAxis1 = i;
+            }
+        }
+        if (isSeparated) continue;
+
+        // Test the face normals of the box 2 for separating axis
+        decimal penetrationDepth2 = DECIMAL_LARGEST;
+        uint32 faceAxis2 = 0;
+        for (uint32 j=0; j < 3; j++) {
+
+            const decimal penetrationDepth = halfExtents2[j] + halfExtents1.dot(absRotation.getColumn(j)) - std::abs(center2.dot(axes2[j]));
+            if (penetrationDepth <= decimal(0.0)) {
+                isSeparated = true;
+                break;
+            }
+            if (penetrationDepth < penetrationDepth2) {
+                penetrationDepth2 = penetrationDepth;
+                faceAxis2 = j;
+            }
+        }
+        if (isSeparated) continue;
+
+        // If the two penetration depths are almost the same, we prefer the face of box 1 for
+        // consistency between frames (see the SAT algorithm)
+        const bool isMinPenetrationFaceBox1 = penetrationDepth1 < penetrationDepth2 * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE;
+        decimal minPenetrationDepth = std::min(penetrationDepth1, penetrationDepth2);
+        bool isMinPenetrationFaceNormal = true;
+        uint32 minEdgeAxis1 = 0;
+        uint32 minEdgeAxis2 = 0;
+
+        // Test the cross products of the edges of the two boxes for separating axis
+        for (uint32 i=0; i < 3 && !isSeparated; i++) {
+
+            Vector3 edgeDirection1(0, 0, 0);
+            edgeDirection1[i] = decimal(1.0);
+
+            for (uint32 j=0; j < 3; j++) {
+
+                const Vector3 axis = edgeDirection1.cross(axes2[j]);
+
+                // If the two edges are parallel, the axis is skipped
+                const decimal axisLengthSquare = axis.lengthSquare();
+                if (axisLengthSquare < decimal(0.00001)) continue;
+
+                const decimal projectionRadius1 = halfExtents1.x * std::abs(axis.x) + halfExtents1.y * std::abs(axis.y) + halfExtents1.z * std::abs(axis.z);
+                const decimal projectionRadius2 = halfExtents2.x * std::abs(axis.dot(axes2[0])) + halfExtents2.y * std::abs(axis.dot(axes2[1])) +
+                                                  halfExtents2.z * std::abs(axis.dot(axes2[2]));
+                const decimal penetrationDepth = (projectionRadius1 + projectionRadius2 - std::abs(center2.dot(axis))) / std::sqrt(axisLengthSquare);
+
+                if (penetrationDepth <= decimal(0.0)) {
+                    isSeparated = true;
+                    break;
+                }
+
+                // We favor the face axes over the edge axes because face contacts have more contact points (see the SAT algorithm)
+                if ((isMinPenetrationFaceNormal && penetrationDepth * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE < minPenetrationDepth) ||
+                    (!isMinPenetrationFaceNormal && penetrationDepth < minPenetrationDepth)) {
+
+                    minPenetrationDepth = penetrationDepth;
+                    isMinPenetrationFaceNormal = false;
+                    minEdgeAxis1 = i;
+                    minEdgeAxis2 = j;
+                }
+            }
+        }
+        if (isSeparated) continue;
+
+        // Here we know the boxes are overlapping on all the axes. If we do not need the contact points, we are done
+        if (!narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+            narrowPhaseInfoBatch.isColliding[batchIndex] = true;
+            isCollisionFound = true;
+            continue;
+        }
+
+        // If the minimum separating axis is a face normal
+        if (isMinPenetrationFaceNormal) {
+
+            bool contactsFound;
+            if (isMinPenetrationFaceBox1) {
+
+                // The reference face is the face of box 1 facing box 2
+                const decimal referenceSign = center2[faceAxis1] >= decimal(0.0) ? decimal(1.0) : decimal(-1.0);
+                Vector3 referenceNormal(0, 0, 0);
+                referenceNormal[faceAxis1] = referenceSign;
+                const Vector3 normalWorld = transform1.getOrientation() * referenceNormal;
+
+                contactsFound = computeFaceContactPoints(narrowPhaseInfoBatch, batchIndex, true, halfExtents1, halfExtents2, box2ToBox1,
+                                                         faceAxis1, referenceSign, normalWorld);
+            }
+            else {
+
+                // The reference face is the face of box 2 facing box 1
+                const Transform box1ToBox2 = box2ToBox1.getInverse();
+                const decimal referenceSign = box1ToBox2.getPosition()[faceAxis2] >= decimal(0.0) ? decimal(1.0) : decimal(-1.0);
+                Vector3 referenceNormal(0, 0, 0);
+                referenceNormal[faceAxis2] = referenceSign;
+                const Vector3 normalWorld = -(transform2.getOrientation() * referenceNormal);
+
+                contactsFound = computeFaceContactPoints(narrowPhaseInfoBatch, batchIndex, false, halfExtents2, halfExtents1, box1ToBox2,
+                                                         faceAxis2, referenceSign, normalWorld);
+            }
+
+            // There should be clipping points here. If it is not the case, it might be
+            // because of a numerical issue
+            if (!contactsFound) continue;
+        }
+        else {    // If we have an edge vs edge contact
+
+            Vector3 edgeDirection1(0, 0, 0);
+            edgeDirection1[minEdgeAxis1] = decimal(1.0);
+
+            // Separating axis going from box 1 to box 2
+            Vector3 axis = edgeDirection1.cross(axes2[minEdgeAxis2]).getUnit();
+            if (axis.dot(center2) < decimal(0.0)) {
+                axis = -axis;
+            }
+
+            // Edge of box 1 (parallel to the edge axis) that is the farthest in the axis direction
+            Vector3 edge1Center(0, 0, 0);
+            for (uint32 k=0; k < 3; k++) {
+                if (k != minEdgeAxis1) {
+                    edge1Center[k] = axis[k] >= decimal(0.0) ? halfExtents1[k] : -halfExtents1[k];
+                }
+            }
+            const Vector3 edge1A = edge1Center - halfExtents1[minEdgeAxis1] * edgeDirection1;
+            const Vector3 edge1B = edge1Center + halfExtents1[minEdgeAxis1] * edgeDirection1;
+
+            // Edge of box 2 (parallel to the edge axis) that is the farthest in the opposite axis direction
+            Vector3 edge2Center = center2;
+            for (uint32 k=0; k < 3; k++) {
+                if (k != minEdgeAxis2) {
+                    edge2Center -= (axis.dot(axes2[k]) >= decimal(0.0) ? halfExtents2[k] : -halfExtents2[k]) * axes2[k];
+                }
+            }
+            const Vector3 edge2A = edge2Center - halfExtents2[minEdgeAxis2] * axes2[minEdgeAxis2];
+            const Vector3 edge2B = edge2Center + halfExtents2[minEdgeAxis2] * axes2[minEdgeAxis2];
+
+            // Compute the closest points between the two edges (in the local-space of box 1)
+            Vector3 closestPointEdge1, closestPointEdge2;
+            computeClosestPointBetweenTwoSegments(edge1A, edge1B, edge2A, edge2B, closestPointEdge1, closestPointEdge2);
+
+            // Create the contact point
+            narrowPhaseInfoBatch.addContactPoint(batchIndex, transform1.getOrientation() * axis, minPenetrationDepth,
+                                                 closestPointEdge1, box2ToBox1.getInverse() * closestPointEdge2);
+        }
+
+        narrowPhaseInfoBatch.isColliding[batchIndex] = true;
+        isCollisionFound = true;
+    }
+
+    return isCollisionFound;
+}
+
+// Compute the contact points of a face contact (in the local-space of the reference box)
+/// The incident face (the face of the incident box that is the most anti-parallel to the reference
+/// face normal) is clipped with the four side planes of the reference face. The clipped points
+/// below the reference face are the contact points. The method returns true if contact points
+/// have been found.
+bool BoxVsBoxAlgorithm::computeFaceContactPoints(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex, bool isReferenceBox1,
+                                                 const Vector3& referenceHalfExtents, const Vector3& incidentHalfExtents,
+                                                 const Transform& incidentToReference, uint32 referenceAxis, decimal referenceSign,
+                                                 const Vector3& normalWorld) const {
+
+    RP3D_PROFILE("BoxVsBoxAlgorithm::computeFaceContactPoints()", mProfiler);
+
+    const Matrix3x3 incidentRotation = incidentToReference.getOrientation().getMatrix();
+
+    // Find the incident face (the incident box axis that is the most parallel to the reference normal)
+    uint32 incidentAxis = 0;
+    decimal maxAbsDotProduct = decimal(-1.0);
+    for (uint32 k=0; k < 3; k++) {
+        const decimal absDotProduct = std::abs(incidentRotation[referenceAxis][k]);
+        if (absDotProduct > maxAbsDotProduct) {
+            maxAbsDotProduct = absDotProduct;
+            incidentAxis = k;
+        }
+    }
+    const decimal incidentSign = referenceSign * incidentRotation[referenceAxis][incidentAxis] > decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+
+    // Compute the vertices of the incident face
+    const uint32 incidentAxisU = (incidentAxis + 1) % 3;
+    const uint32 incidentAxisV = (incidentAxis + 2) % 3;
+    const Vector3 faceCenter = incidentToReference.getPosition() + (incidentSign * incidentHalfExtents[incidentAxis]) * incidentRotation.getColumn(incidentAxis);
+    const Vector3 faceEdgeU = incidentHalfExtents[incidentAxisU] * incidentRotation.getColumn(incidentAxisU);
+    const Vector3 faceEdgeV = incidentHalfExtents[incidentAxisV] * incidentRotation.getColumn(incidentAxisV);
+
+    Vector3 vertices1[MAX_NB_CLIPPED_VERTICES];
+    Vector3 vertices2[MAX_NB_CLIPPED_VERTICES];
+    vertices1[0] = faceCenter + faceEdgeU + faceEdgeV;
+    vertices1[1] = faceCenter - faceEdgeU + faceEdgeV;
+    vertices1[2] = faceCenter - faceEdgeU - faceEdgeV;
+    vertices1[3] = faceCenter + faceEdgeU - faceEdgeV;
+
+    // Clip the incident face with the four side planes of the reference face
+    const uint32 referenceAxisU = (referenceAxis + 1) % 3;
+    const uint32 referenceAxisV = (referenceAxis + 2) % 3;
+    uint32 nbVertices = 4;
+    nbVertices = clipPolygon(vertices1, nbVertices, referenceAxisU, decimal(1.0), referenceHalfExtents[referenceAxisU], vertices2);
+    nbVertices = clipPolygon(vertices2, nbVertices, referenceAxisU, decimal(-1.0), referenceHalfExtents[referenceAxisU], vertices1);
+    nbVertices = clipPolygon(vertices1, nbVertices, referenceAxisV, decimal(1.0), referenceHalfExtents[referenceAxisV], vertices2);
+    nbVertices = clipPolygon(vertices2, nbVertices, referenceAxisV, decimal(-1.0), referenceHalfExtents[referenceAxisV], vertices1);
+
+    // We only keep the clipped points that are below the reference face
+    const Transform referenceToIncident = incidentToReference.getInverse();
+    const decimal referenceFaceOffset = referenceSign * referenceHalfExtents[referenceAxis];
+    bool contactPointsFound = false;
+    for (uint32 i=0; i < nbVertices; i++) {
+
+        // Compute the penetration depth of this contact point (can be different from the minimum
+        // penetration depth which is the maximal penetration depth of any contact point)
+        const decimal penetrationDepth = referenceSign * (referenceFaceOffset - vertices1[i][referenceAxis]);
+
+        // If the clip point is below the reference face
+        if (penetrationDepth > decimal(0.0)) {
+
+            contactPointsFound = true;
+
+            // Project the contact point onto the reference face
+            Vector3 contactPointReference = vertices1[i];
+            contactPointReference[referenceAxis] = referenceFaceOffset;
+
+            // Convert the clip incident box vertex into the incident box local-space
+            const Vector3 contactPointIncident = referenceToIncident * vertices1[i];
+
+            // Create a new contact point
+            narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth,
+                                                 isReferenceBox1 ? contactPointReference : contactPointIncident,
+                                                 isReferenceBox1 ? contactPointIncident : contactPointReference);
+        }
+    }
+
+    return contactPointsFound;
+}
+
+// Clip a polygon with the plane coordinate[axis] * sign <= limit
+/// This method implements the Sutherland-Hodgman clipping algorithm for a single
+/// axis-aligned plane and returns the number of vertices of the clipped polygon.
+uint32 BoxVsBoxAlgorithm::clipPolygon(const Vector3* inputVertices, uint32 nbInputVertices, uint32 axis, decimal sign,
+                                      decimal limit, Vector3* outputVertices) {
+
+    if (nbInputVertices == 0) return 0;
+
+    uint32 nbOutputVertices = 0;
+    Vector3 previousVertex = inputVertices[nbInputVertices - 1];
+    decimal previousDistance = sign * previousVertex[axis] - limit;
+
+    for (uint32 i=0; i < nbInputVertices; i++) {
+
+        const Vector3& currentVertex = inputVertices[i];
+        const decimal currentDistance = sign * currentVertex[axis] - limit;
+
+        // If the edge crosses the plane, we add the intersection point (the number of vertices is
+        // checked because of the numerical errors with an almost degenerated polygon)
+        if ((previousDistance <= decimal(0.0)) != (currentDistance <= decimal(0.0)) && nbOutputVertices < MAX_NB_CLIPPED_VERTICES) {
+            const decimal t = previousDistance / (previousDistance - currentDistance);
+            outputVertices[nbOutputVertices++] = previousVertex + t * (currentVertex - previousVertex);
+        }
+
+        // If the current vertex is inside, we keep it
+        if (currentDistance <= decimal(0.0) && nbOutputVertices < MAX_NB_CLIPPED_VERTICES) {
+            outputVertices[nbOutputVertices++] = currentVertex;
+        }
+
+        previousVertex = currentVertex;
+        previousDistance = currentDistance;
+    }
+
+    return nbOutputVertices;
+}
@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
+#include <reactphysics3d/collision/shapes/ConvexPolyhedronShape.h>
 
 using namespace reactphysics3d;
 
@@ -38,6 +39,7 @@ CollisionDispatch::CollisionDispatch(MemoryAllocator& allocator) : mAllocator(al
     mSphereVsConvexPolyAllocatedSize = std::ceil(sizeof(SphereVsConvexPolyhedronAlgorithm) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
     mCapsuleVsConvexPolyAllocatedSize = std::ceil(sizeof(CapsuleVsConvexPolyhedronAlgorithm) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
     mConvexPolyVsConvexPolyAllocatedSize = std::ceil(sizeof(ConvexPolyhedronVsConvexPolyhedronAlgorithm) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+    mBoxVsBoxAllocatedSize = std::ceil(sizeof(BoxVsBoxAlgorithm) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
 
     // Create the default narrow-phase algorithms
     mSphereVsSphereAlgorithm = new (allocator.allocate(mSphereVsSphereAllocatedSize)) SphereVsSphereAlgorithm();
@@ -46,6 +48,7 @@ CollisionDispatch::CollisionDispatch(MemoryAllocator& allocator) : mAllocator(al
     mSphereVsConvexPolyhedronAlgorithm = new (allocator.allocate(mSphereVsConvexPolyAllocatedSize)) SphereVsConvexPolyhedronAlgorithm();
     mCapsuleVsConvexPolyhedronAlgorithm = new (allocator.allocate(mCapsuleVsConvexPolyAllocatedSize)) CapsuleVsConvexPolyhedronAlgorithm();
     mConvexPolyhedronVsConvexPolyhedronAlgorithm = new (allocator.allocate(mConvexPolyVsConvexPolyAllocatedSize)) ConvexPolyhedronVsConvexPolyhedronAlgorithm();
+    mBoxVsBoxAlgorithm = new (allocator.allocate(mBoxVsBoxAllocatedSize)) BoxVsBoxAlgorithm();
 
     // Fill in the collision matrix
     fillInCollisionMatrix();
@@ -73,6 +76,9 @@ CollisionDispatch::~CollisionDispatch() {
     if (mIsConvexPolyhedronVsConvexPolyhedronDefault) {
         mAllocator.release(mConvexPolyhedronVsConvexPolyhedronAlgorithm, mConvexPolyVsConvexPolyAllocatedSize);
     }
+    if (mIsBoxVsBoxDefault) {
+        mAllocator.release(mBoxVsBoxAlgorithm, mBoxVsBoxAllocatedSize);
+    }
 }
 
 // Select and return the narrow-phase collision detection algorithm to
@@ -192,6 +198,17 @@ void CollisionDispatch::setConvexPolyhedronVsConvexPolyhedronAlgorithm(ConvexPol
     fillInCollisionMatrix();
 }
 
+// Set the Box vs Box narrow-phase collision detection algorithm
+void CollisionDispatch::setBoxVsBoxAlgorithm(BoxVsBoxAlgorithm* algorithm) {
+
+    if (mIsBoxVsBoxDefault) {
+        mAllocator.release(mBoxVsBoxAlgorithm, mBoxVsBoxAllocatedSize);
+        mIsBoxVsBoxDefault = false;
+    }
+
+    mBoxVsBoxAlgorithm = algorithm;
+}
+
 
 // Fill-in the collision detection matrix
 void CollisionDispatch::fillInCollisionMatrix() {
@@ -221,5 +238,27 @@ NarrowPhaseAlgorithmType CollisionDispatch::selectNarrowPhaseAlgorithm(const Col
     return mCollisionMatrix[shape1Index][shape2Index];
 }
 
+// Return the corresponding narrow-phase algorithm type to use for two convex collision shapes
+/// The algorithm is selected with the types of the shapes (collision matrix) except for two
+/// boxes that are tested with the dedicated box vs box algorithm and for two convex polyhedra
+/// with many edges that are tested with the GJK and EPA algorithms instead of the SAT algorithm.
+NarrowPhaseAlgorithmType CollisionDispatch::selectNarrowPhaseAlgorithm(const CollisionShape* shape1, const CollisionShape* shape2) const {
 
+    if (shape1->getName() == CollisionShapeName::BOX && shape2->getName() == CollisionShapeName::BOX) {
+        return NarrowPhaseAlgorithmType::BoxVsBox;
+    }
 
+    const NarrowPhaseAlgorithmType algorithmType = selectNarrowPhaseAlgorithm(shape1->getType(), shape2->getType());
+
+    if (algorithmType == NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron) {
+
+        // The cost of the SAT algorithm grows with the number of pairs of edges of the two polyhedra
+        const uint32 nbEdges1 = static_cast<const ConvexPolyhedronShape*>(shape1)->getNbHalfEdges() / 2;
+        const uint32 nbEdges2 = static_cast<const ConvexPolyhedronShape*>(shape2)->getNbHalfEdges() / 2;
+        if (uint64(nbEdges1) * nbEdges2 >= MIN_NB_EDGE_PAIRS_FOR_GJK) {
+            return NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronGJK;
+        }
+    }
+
+    return algorithmType;
+}
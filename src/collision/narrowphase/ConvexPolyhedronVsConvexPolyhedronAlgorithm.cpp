@@ -28,10 +28,17 @@
 #include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/SAT/SATAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/shapes/ConvexPolyhedronShape.h>
+#include <reactphysics3d/collision/ContactPointInfo.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/containers/Array.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
+// Static variables initialization
+const decimal ConvexPolyhedronVsConvexPolyhedronAlgorithm::FACE_CONTACT_MIN_COS_ANGLE = decimal(0.999);
+
 // Compute the narrow-phase collision detection between two convex polyhedra
 // This technique is based on the "Robust Contact Creation for Physics Simulations" presentation
 // by Dirk Gregorius.
@@ -54,7 +61,7 @@ bool ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoB
     for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
 
         // Get the last frame collision info
-        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].lastFrameCollisionInfo;
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
 
         lastFrameCollisionInfo->wasUsingSAT = true;
         lastFrameCollisionInfo->wasUsingGJK = false;
@@ -62,3 +69,139 @@ bool ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollision(NarrowPhaseInfoB
 
     return isCollisionFound;
 }
+
+// Compute the narrow-phase collision detection between two convex polyhedra with the GJK and EPA algorithms
+/// This is used for the polyhedra with many edges because the SAT algorithm tests the cross products of
+/// all the pairs of edges of the two polyhedra. The GJK algorithm finds if the polyhedra overlap and the
+/// EPA algorithm computes the penetration depth and the normal. If the EPA algorithm fails, we run the
+/// SAT algorithm for this pair.
+bool ConvexPolyhedronVsConvexPolyhedronAlgorithm::testCollisionWithGJKAndEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch,
+                                                                             uint32 batchStartIndex, uint32 batchNbItems,
+                                                                             bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& memoryAllocator) {
+
+    // Run the GJK algorithm (with EPA for the overlapping polyhedra)
+    GJKAlgorithm gjkAlgorithm(true);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+
+    gjkAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    Array<GJKAlgorithm::GJKResult> gjkResults(memoryAllocator, batchNbItems);
+    gjkAlgorithm.testCollision(narrowPhaseInfoBatch, batchStartIndex, batchNbItems, gjkResults);
+    assert(gjkResults.size() == batchNbItems);
+
+    bool isCollisionFound = false;
+
+    // For each item in the batch
+    for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        assert(narrowPhaseInfoBatch.collisionShapes1[batchIndex]->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
+        assert(narrowPhaseInfoBatch.collisionShapes2[batchIndex]->getType() == CollisionShapeType::CONVEX_POLYHEDRON);
+
+        // Get the last frame collision info
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
+
+        lastFrameCollisionInfo->wasUsingGJK = true;
+        lastFrameCollisionInfo->wasUsingSAT = false;
+
+        const GJKAlgorithm::GJKResult gjkResult = gjkResults[batchIndex - batchStartIndex];
+
+        if (gjkResult == GJKAlgorithm::GJKResult::SEPARATED) {
+            continue;
+        }
+
+        // If the EPA algorithm has not computed the contact point but we need it
+        if (gjkResult == GJKAlgorithm::GJKResult::INTERPENETRATE && narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+
+            // Run the SAT algorithm to find the separating axis and compute contact points
+            SATAlgorithm satAlgorithm(clipWithPreviousAxisIfStillColliding, memoryAllocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+
+            satAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+            isCollisionFound |= satAlgorithm.testCollisionConvexPolyhedronVsConvexPolyhedron(narrowPhaseInfoBatch, batchIndex, 1);
+
+            lastFrameCollisionInfo->wasUsingGJK = false;
+            lastFrameCollisionInfo->wasUsingSAT = true;
+
+            continue;
+        }
+
+        // If the EPA algorithm has computed the contact point, we try to get a face contact
+        if (gjkResult == GJKAlgorithm::GJKResult::INTERPENETRATE_EPA) {
+            computeFaceContactPointsFromEPA(narrowPhaseInfoBatch, batchIndex, memoryAllocator);
+        }
+
+        narrowPhaseInfoBatch.isColliding[batchIndex] = true;
+        isCollisionFound = true;
+    }
+
+    return isCollisionFound;
+}
+
+// Replace the contact point computed by EPA with the contact points of a face contact
+/// The EPA algorithm only computes a single contact point. If the EPA normal is almost the normal
+/// of a face of one of the two polyhedra, we clip the incident face of the other polyhedron with
+/// this reference face (as in the SAT algorithm) to get a more stable contact manifold.
+void ConvexPolyhedronVsConvexPolyhedronAlgorithm::computeFaceContactPointsFromEPA(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex,
+                                                                                  MemoryAllocator& memoryAllocator) const {
+
+    RP3D_PROFILE("ConvexPolyhedronVsConvexPolyhedronAlgorithm::computeFaceContactPointsFromEPA()", mProfiler);
+
+    assert(narrowPhaseInfoBatch.nbContactPoints[batchIndex] == 1);
+
+    const ContactPointInfo epaContactPoint = narrowPhaseInfoBatch.contactPoints[batchIndex][0];
+
+    const ConvexPolyhedronShape* polyhedron1 = static_cast<const ConvexPolyhedronShape*>(narrowPhaseInfoBatch.collisionShapes1[batchIndex]);
+    const ConvexPolyhedronShape* polyhedron2 = static_cast<const ConvexPolyhedronShape*>(narrowPhaseInfoBatch.collisionShapes2[batchIndex]);
+    const Transform& transform1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex];
+    const Transform& transform2 = narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
+
+    // Find the face of each polyhedron that is the most parallel to the contact normal (going from
+    // polyhedron 1 to polyhedron 2 for the face of polyhedron 1 and the opposite for polyhedron 2)
+    const Vector3 normalPolyhedron1Space = transform1.getOrientation().getInverse() * epaContactPoint.normal;
+    const Vector3 normalPolyhedron2Space = transform2.getOrientation().getInverse() * epaContactPoint.normal;
+    const uint32 faceIndex1 = polyhedron1->findMostAntiParallelFace(-normalPolyhedron1Space);
+    const uint32 faceIndex2 = polyhedron2->findMostAntiParallelFace(normalPolyhedron2Space);
+    const decimal cosAngle1 = polyhedron1->getFaceNormal(faceIndex1).dot(normalPolyhedron1Space);
+    const decimal cosAngle2 = -polyhedron2->getFaceNormal(faceIndex2).dot(normalPolyhedron2Space);
+
+    // We prefer the face of polyhedron 1 (as in the SAT algorithm)
+    const bool isReferenceFacePolyhedron1 = cosAngle1 >= cosAngle2;
+    if (std::max(cosAngle1, cosAngle2) < FACE_CONTACT_MIN_COS_ANGLE) {
+
+        // This is not a face contact, we keep the EPA contact point
+        return;
+    }
+
+    const Transform polyhedron1ToPolyhedron2 = transform2.getInverse() * transform1;
+    const Transform polyhedron2ToPolyhedron1 = polyhedron1ToPolyhedron2.getInverse();
+
+    SATAlgorithm satAlgorithm(false, memoryAllocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+
+    satAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    // Compute the contact points by clipping the faces
+    narrowPhaseInfoBatch.resetContactPoints(batchIndex);
+    if (!satAlgorithm.computePolyhedronVsPolyhedronFaceContactPoints(isReferenceFacePolyhedron1, polyhedron1, polyhedron2,
+                                                                     polyhedron1ToPolyhedron2, polyhedron2ToPolyhedron1,
+                                                                     isReferenceFacePolyhedron1 ? faceIndex1 : faceIndex2,
+                                                                     narrowPhaseInfoBatch, batchIndex)) {
+
+        // If there are no clipping points (numerical issue), we keep the EPA contact point
+        narrowPhaseInfoBatch.addContactPoint(batchIndex, epaContactPoint.normal, epaContactPoint.penetrationDepth,
+                                             epaContactPoint.localPoint1, epaContactPoint.localPoint2);
+    }
+}
@@ -0,0 +1,348 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/EPA/EPAAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/GJK/VoronoiSimplex.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/shapes/ConvexShape.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cassert>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Static variables initialization
+const decimal EPAAlgorithm::TOLERANCE = decimal(0.0001);
+
+// Compute the penetration depth and the contact point of two overlapping convex shapes
+/// The final simplex of the GJK algorithm must contain the origin. The contact point
+/// (in the local-spaces of the shapes) is added to the narrow-phase batch if contacts
+/// have to be reported. The method returns false if the algorithm fails (degenerated
+/// polytope). In this case, nothing is added to the batch.
+bool EPAAlgorithm::computePenetrationDepthAndContactPoints(const VoronoiSimplex& simplex, const ConvexShape* shape1, const ConvexShape* shape2,
+                                                           const Transform& shape2ToShape1, const Quaternion& rotateToShape2,
+                                                           NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchIndex) {
+
+    RP3D_PROFILE("EPAAlgorithm::computePenetrationDepthAndContactPoints()", mProfiler);
+
+    mShape1 = shape1;
+    mShape2 = shape2;
+    mShape2ToShape1 = shape2ToShape1;
+    mRotateToShape2 = rotateToShape2;
+    mLastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
+
+    // Build the initial polytope (a tetrahedron that contains the origin)
+    if (!createInitialPolytope(simplex)) {
+        return false;
+    }
+
+    uint32 closestFaceIndex = 0;
+
+    while (true) {
+
+        // Find the face of the polytope that is the closest to the origin
+        closestFaceIndex = 0;
+        for (uint32 i=1; i < mNbFaces; i++) {
+            if (mFaces[i].distance < mFaces[closestFaceIndex].distance) {
+                closestFaceIndex = i;
+            }
+        }
+        const Vector3 closestFaceNormal = mFaces[closestFaceIndex].normal;
+        const decimal closestFaceDistance = mFaces[closestFaceIndex].distance;
+
+        // Compute the support point of the Minkowski difference in the direction of the face normal
+        Vector3 supportPoint1, supportPoint2;
+        computeSupportPoint(closestFaceNormal, supportPoint1, supportPoint2);
+        const Vector3 w = supportPoint1 - supportPoint2;
+
+        // If the face is on the boundary of the Minkowski difference, we are done. If the polytope
+        // is full, we use the current closest face (approximation of the penetration depth)
+        if (w.dot(closestFaceNormal) - closestFaceDistance <= TOLERANCE || mNbVertices == MAX_NB_VERTICES) {
+            break;
+        }
+
+        // Add the new vertex to the polytope
+        const uint32 newVertexIndex = mNbVertices;
+        mVertices[mNbVertices] = w;
+        mSupportPoints1[mNbVertices] = supportPoint1;
+        mSupportPoints2[mNbVertices] = supportPoint2;
+        mNbVertices++;
+
+        // Remove the faces that can be seen from the new vertex and compute the horizon (the
+        // boundary of the removed faces)
+        mNbHorizonEdges = 0;
+        uint32 i = 0;
+        while (i < mNbFaces) {
+
+            const Face& face = mFaces[i];
+            if (face.normal.dot(w - mVertices[face.vertexIndices[0]]) > decimal(0.0)) {
+
+                if (!addHorizonEdge(face.vertexIndices[0], face.vertexIndices[1]) ||
+                    !addHorizonEdge(face.vertexIndices[1], face.vertexIndices[2]) ||
+                    !addHorizonEdge(face.vertexIndices[2], face.vertexIndices[0])) {
+                    return false;
+                }
+
+                mNbFaces--;
+                mFaces[i] = mFaces[mNbFaces];
+            }
+            else {
+                i++;
+            }
+        }
+
+        // Create the new faces between the horizon and the new vertex
+        for (uint32 e=0; e < mNbHorizonEdges; e++) {
+            if (!addFace(mHorizonEdges[e][0], mHorizonEdges[e][1], newVertexIndex)) {
+                return false;
+            }
+        }
+
+        if (mNbFaces == 0) {
+            return false;
+        }
+    }
+
+    const Face& closestFace = mFaces[closestFaceIndex];
+
+    // If the shapes are only touching (because of numerical errors), there is no penetration depth
+    if (closestFace.distance <= decimal(0.0)) {
+        return false;
+    }
+
+    // Compute the barycentric coordinates of the projection of the origin on the closest face
+    const uint32 a = closestFace.vertexIndices[0];
+    const uint32 b = closestFace.vertexIndices[1];
+    const uint32 c = closestFace.vertexIndices[2];
+    decimal u, v, w;
+    computeBarycentricCoordinatesInTriangle(mVertices[a], mVertices[b], mVertices[c], closestFace.distance * closestFace.normal, u, v, w);
+
+    // Compute the contact points on the two shapes (in local-space of shape 1) with the margins
+    const Vector3 normal = closestFace.normal;
+    Vector3 contactPoint1 = u * mSupportPoints1[a] + v * mSupportPoints1[b] + w * mSupportPoints1[c] + shape1->getMargin() * normal;
+    Vector3 contactPoint2 = u * mSupportPoints2[a] + v * mSupportPoints2[b] + w * mSupportPoints2[c] - shape2->getMargin() * normal;
+    decimal penetrationDepth = closestFace.distance + shape1->getMargin() + shape2->getMargin();
+
+    // Cache the axis for the next frame (this is the separating axis of GJK when the shapes separate)
+    mLastFrameCollisionInfo->gjkSeparatingAxis = -normal;
+
+    // If we need to report contacts
+    if (narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+
+        const Transform& transform1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex];
+        const Transform& transform2 = narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
+        contactPoint2 = shape2ToShape1.getInverse() * contactPoint2;
+        Vector3 normalWorld = transform1.getOrientation() * normal;
+
+        // Compute smooth triangle mesh contact if one of the two collision shapes is a triangle
+        TriangleShape::computeSmoothTriangleMeshContact(shape1, shape2, contactPoint1, contactPoint2, transform1, transform2,
+                                                        penetrationDepth, normalWorld);
+
+        // Add a new contact point
+        narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth, contactPoint1, contactPoint2);
+    }
+
+    return true;
+}
+
+// Compute the support point of the Minkowski difference in a given direction
+/// The support points of the two shapes are returned in the local-space of shape 1
+void EPAAlgorithm::computeSupportPoint(const Vector3& direction, Vector3& outSupportPoint1, Vector3& outSupportPoint2) const {
+
+    outSupportPoint1 = mShape1->getLocalSupportPointWithoutMarginFromVertex(direction, mLastFrameCollisionInfo->gjkSupportVertexIndex1);
+    outSupportPoint2 = mShape2ToShape1 * mShape2->getLocalSupportPointWithoutMarginFromVertex(mRotateToShape2 * (-direction),
+                                                                                             mLastFrameCollisionInfo->gjkSupportVertexIndex2);
+}
+
+// Add a vertex to the polytope if it increases the dimension of the initial simplex
+/// The method returns true if the vertex has been added. A vertex is only added if it is
+/// not on the point, line or plane of the current vertices.
+bool EPAAlgorithm::addSimplexVertex(const Vector3& supportPoint1, const Vector3& supportPoint2) {
+
+    const Vector3 point = supportPoint1 - supportPoint2;
+
+    bool isIncreasingDimension = true;
+    switch (mNbVertices) {
+        case 0:
+            break;
+        case 1:
+            isIncreasingDimension = (point - mVertices[0]).lengthSquare() > MACHINE_EPSILON;
+            break;
+        case 2:
+            isIncreasingDimension = (mVertices[1] - mVertices[0]).cross(point - mVertices[0]).lengthSquare() > MACHINE_EPSILON;
+            break;
+        case 3:
+        {
+            const Vector3 normal = (mVertices[1] - mVertices[0]).cross(mVertices[2] - mVertices[0]);
+            const decimal volume = normal.dot(point - mVertices[0]);
+            isIncreasingDimension = volume * volume > MACHINE_EPSILON * normal.lengthSquare();
+            break;
+        }
+        default:
+            isIncreasingDimension = false;
+    }
+
+    if (isIncreasingDimension) {
+        mVertices[mNbVertices] = point;
+        mSupportPoints1[mNbVertices] = supportPoint1;
+        mSupportPoints2[mNbVertices] = supportPoint2;
+        mNbVertices++;
+    }
+
+    return isIncreasingDimension;
+}
+
+// Build the initial tetrahedron of the polytope from the final simplex of GJK
+/// The GJK simplex can have less than four points (or be degenerated) if the origin is on
+/// its boundary. In this case, we add support points in other directions to obtain a
+/// tetrahedron. The method returns false if no valid tetrahedron containing the origin is found.
+bool EPAAlgorithm::createInitialPolytope(const VoronoiSimplex& simplex) {
+
+    mNbVertices = 0;
+    mNbFaces = 0;
+
+    // Add the points of the GJK simplex
+    Vector3 simplexSupportPoints1[4];
+    Vector3 simplexSupportPoints2[4];
+    Vector3 simplexPoints[4];
+    const int nbSimplexPoints = simplex.getSimplex(simplexSupportPoints1, simplexSupportPoints2, simplexPoints);
+    for (int i=0; i < nbSimplexPoints; i++) {
+        addSimplexVertex(simplexSupportPoints1[i], simplexSupportPoints2[i]);
+    }
+
+    Vector3 supportPoint1, supportPoint2;
+
+    // If we only have a point, we search along the axes of the local-space of shape 1
+    if (mNbVertices <= 1) {
+        const Vector3 directions[6] = {Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0),
+                                       Vector3(0, 0, 1), Vector3(0, 0, -1)};
+        for (uint32 i=0; i < 6 && mNbVertices < 2; i++) {
+            computeSupportPoint(directions[i], supportPoint1, supportPoint2);
+            addSimplexVertex(supportPoint1, supportPoint2);
+        }
+    }
+
+    // If we have a segment, we search in directions orthogonal to the segment
+    if (mNbVertices == 2) {
+        const Vector3 segmentDirection = mVertices[1] - mVertices[0];
+        const Vector3 orthogonal1 = segmentDirection.getOneUnitOrthogonalVector();
+        const Vector3 orthogonal2 = segmentDirection.cross(orthogonal1);
+        const Vector3 directions[4] = {orthogonal1, -orthogonal1, orthogonal2, -orthogonal2};
+        for (uint32 i=0; i < 4 && mNbVertices < 3; i++) {
+            computeSupportPoint(directions[i], supportPoint1, supportPoint2);
+            addSimplexVertex(supportPoint1, supportPoint2);
+        }
+    }
+
+    // If we have a triangle, we search in the directions of the triangle normal
+    if (mNbVertices == 3) {
+        const Vector3 normal = (mVertices[1] - mVertices[0]).cross(mVertices[2] - mVertices[0]);
+        computeSupportPoint(normal, supportPoint1, supportPoint2);
+        if (!addSimplexVertex(supportPoint1, supportPoint2)) {
+            computeSupportPoint(-normal, supportPoint1, supportPoint2);
+            addSimplexVertex(supportPoint1, supportPoint2);
+        }
+    }
+
+    if (mNbVertices != 4) {
+        return false;
+    }
+
+    // Make sure that the vertex 3 is below the face (0, 1, 2) so that the faces are counter clockwise
+    const decimal volume = (mVertices[1] - mVertices[0]).cross(mVertices[2] - mVertices[0]).dot(mVertices[3] - mVertices[0]);
+    if (volume > decimal(0.0)) {
+        std::swap(mVertices[1], mVertices[2]);
+        std::swap(mSupportPoints1[1], mSupportPoints1[2]);
+        std::swap(mSupportPoints2[1], mSupportPoints2[2]);
+    }
+
+    // Create the faces of the tetrahedron
+    if (!addFace(0, 1, 2) || !addFace(0, 3, 1) || !addFace(0, 2, 3) || !addFace(1, 3, 2)) {
+        return false;
+    }
+
+    // The tetrahedron must contain the origin
+    for (uint32 i=0; i < mNbFaces; i++) {
+        if (mFaces[i].distance < -TOLERANCE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Add a face to the polytope
+/// The method returns false if the face is degenerated or if the maximum number of faces is reached
+bool EPAAlgorithm::addFace(uint32 vertexIndex1, uint32 vertexIndex2, uint32 vertexIndex3) {
+
+    if (mNbFaces == MAX_NB_FACES) {
+        return false;
+    }
+
+    const Vector3& a = mVertices[vertexIndex1];
+    const Vector3 normal = (mVertices[vertexIndex2] - a).cross(mVertices[vertexIndex3] - a);
+    const decimal normalLength = normal.length();
+    if (normalLength < MACHINE_EPSILON) {
+        return false;
+    }
+
+    Face& face = mFaces[mNbFaces];
+    face.vertexIndices[0] = vertexIndex1;
+    face.vertexIndices[1] = vertexIndex2;
+    face.vertexIndices[2] = vertexIndex3;
+    face.normal = normal / normalLength;
+    face.distance = face.normal.dot(a);
+    mNbFaces++;
+
+    return true;
+}
+
+// Add an edge to the horizon (or remove it if the opposite edge is already in the horizon)
+/// An edge shared by two removed faces is not on the horizon. The method returns false if
+/// the maximum number of horizon edges is reached.
+bool EPAAlgorithm::addHorizonEdge(uint32 vertexIndex1, uint32 vertexIndex2) {
+
+    for (uint32 i=0; i < mNbHorizonEdges; i++) {
+        if (mHorizonEdges[i][0] == vertexIndex2 && mHorizonEdges[i][1] == vertexIndex1) {
+            mNbHorizonEdges--;
+            mHorizonEdges[i][0] = mHorizonEdges[mNbHorizonEdges][0];
+            mHorizonEdges[i][1] = mHorizonEdges[mNbHorizonEdges][1];
+            return true;
+        }
+    }
+
+    if (mNbHorizonEdges == MAX_NB_VERTICES) {
+        return false;
+    }
+
+    mHorizonEdges[mNbHorizonEdges][0] = vertexIndex1;
+    mHorizonEdges[mNbHorizonEdges][1] = vertexIndex2;
+    mNbHorizonEdges++;
+
+    return true;
+}
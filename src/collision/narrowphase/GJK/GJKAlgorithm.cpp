@@ -33,6 +33,7 @@
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/narrowphase/GJK/VoronoiSimplex.h>
+#include <reactphysics3d/collision/narrowphase/EPA/EPAAlgorithm.h>
 #include <cassert>
 
 // We want to use the ReactPhysics3D namespace
@@ -47,6 +48,8 @@ using namespace reactphysics3d;
 /// algorithm on the enlarged object to obtain a simplex polytope that contains the
 /// origin, they we give that simplex polytope to the EPA algorithm which will compute
 /// the correct penetration depth and contact points between the enlarged objects.
+/// If the EPA algorithm is disabled (or if it fails), the result is INTERPENETRATE and
+/// the caller has to compute the contact with the SAT algorithm.
 void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
                                  uint32 batchNbItems, Array<GJKResult>& gjkResults) {
 
@@ -64,15 +67,15 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         decimal prevDistSquare;
         bool contactFound = false;
 
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1->isConvex());
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2->isConvex());
+        assert(narrowPhaseInfoBatch.collisionShapes1[batchIndex]->isConvex());
+        assert(narrowPhaseInfoBatch.collisionShapes2[batchIndex]->isConvex());
 
-        const ConvexShape* shape1 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
-        const ConvexShape* shape2 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
+        const ConvexShape* shape1 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.collisionShapes1[batchIndex]);
+        const ConvexShape* shape2 = static_cast<const ConvexShape*>(narrowPhaseInfoBatch.collisionShapes2[batchIndex]);
 
         // Get the local-space to world-space transforms
-        const Transform& transform1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape1ToWorldTransform;
-        const Transform& transform2 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape2ToWorldTransform;
+        const Transform& transform1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex];
+        const Transform& transform2 = narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
 
         // Transform a point from local space of body 2 to local
         // space of body 1 (the GJK algorithm is done in local space of body 1)
@@ -83,16 +86,17 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         // space of body 1 into local space of body 2
         Quaternion rotateToBody2 = transform2.getOrientation().getInverse() * transform1.getOrientation();
 
-        // Initialize the margin (sum of margins of both objects)
+        // Initialize the margin (sum of margins of both objects). The margin can only be
+        // zero if the penetration depth of the original objects is computed with EPA
         decimal margin = shape1->getMargin() + shape2->getMargin();
         decimal marginSquare = margin * margin;
-        assert(margin > decimal(0.0));
+        assert(margin > decimal(0.0) || mComputePenetrationDepthWithEPA);
 
         // Create a simplex set
         VoronoiSimplex simplex;
 
         // Get the last collision frame info
-        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].lastFrameCollisionInfo;
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
 
         // Get the previous point V (last cached separating axis)
         Vector3 v;
@@ -112,8 +116,8 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         do {
 
             // Compute the support points for original objects (without margins) A and B
-            suppA = shape1->getLocalSupportPointWithoutMargin(-v);
-            suppB = body2Tobody1 * shape2->getLocalSupportPointWithoutMargin(rotateToBody2 * v);
+            suppA = shape1->getLocalSupportPointWithoutMarginFromVertex(-v, lastFrameCollisionInfo->gjkSupportVertexIndex1);
+            suppB = body2Tobody1 * shape2->getLocalSupportPointWithoutMarginFromVertex(rotateToBody2 * v, lastFrameCollisionInfo->gjkSupportVertexIndex2);
 
             // Compute the support point for the Minkowski difference A-B
             w = suppA - suppB;
@@ -127,7 +131,7 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
                 lastFrameCollisionInfo->gjkSeparatingAxis = v;
 
                 // No intersection, we return
-                assert(gjkResults.size() == batchIndex);
+                assert(gjkResults.size() == batchIndex - batchStartIndex);
                 gjkResults.add(GJKResult::SEPARATED);
                 noIntersection = true;
                 break;
@@ -203,20 +207,20 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
 
             // If the penetration depth is negative (due too numerical errors), there is no contact
             if (penetrationDepth <= decimal(0.0)) {
-                assert(gjkResults.size() == batchIndex);
+                assert(gjkResults.size() == batchIndex - batchStartIndex);
                 gjkResults.add(GJKResult::SEPARATED);
                 continue;
             }
 
             // Do not generate a contact point with zero normal length
             if (normal.lengthSquare() < MACHINE_EPSILON) {
-                assert(gjkResults.size() == batchIndex);
+                assert(gjkResults.size() == batchIndex - batchStartIndex);
                 gjkResults.add(GJKResult::SEPARATED);
                 continue;
             }
 
             // If we need to report contacts
-            if (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].reportContacts) {
+            if (narrowPhaseInfoBatch.reportContacts[batchIndex]) {
 
                 // Compute smooth triangle mesh contact if one of the two collision shapes is a triangle
                 TriangleShape::computeSmoothTriangleMeshContact(shape1, shape2, pA, pB, transform1, transform2,
@@ -226,13 +230,34 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
                 narrowPhaseInfoBatch.addContactPoint(batchIndex, normal, penetrationDepth, pA, pB);
             }
 
-            assert(gjkResults.size() == batchIndex);
+            assert(gjkResults.size() == batchIndex - batchStartIndex);
             gjkResults.add(GJKResult::COLLIDE_IN_MARGIN);
 
             continue;
         }
 
-        assert(gjkResults.size() == batchIndex);
+        // If the original objects intersect and we need the contact points, we compute the
+        // penetration depth with the EPA algorithm starting from the current simplex
+        if (mComputePenetrationDepthWithEPA && narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+
+            EPAAlgorithm epaAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            epaAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+            if (epaAlgorithm.computePenetrationDepthAndContactPoints(simplex, shape1, shape2, body2Tobody1, rotateToBody2,
+                                                                     narrowPhaseInfoBatch, batchIndex)) {
+
+                assert(gjkResults.size() == batchIndex - batchStartIndex);
+                gjkResults.add(GJKResult::INTERPENETRATE_EPA);
+                continue;
+            }
+        }
+
+        assert(gjkResults.size() == batchIndex - batchStartIndex);
         gjkResults.add(GJKResult::INTERPENETRATE);
     }
 }
@@ -26,18 +26,21 @@
 // Libraries
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/ContactPointInfo.h>
-#include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <iostream>
+#include <cstring>
 
 using namespace reactphysics3d;
 
-// TriangleShape allocated size
-const size_t NarrowPhaseInfoBatch::mTriangleShapeAllocatedSize = std::ceil(sizeof(TriangleShape) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+// Size (in bytes) of the data of a single collision test
+const size_t NarrowPhaseInfoBatch::OBJECT_DATA_SIZE = 2 * sizeof(Transform) + 2 * sizeof(CollisionShape*) + 2 * sizeof(decimal) +
+                                                      2 * sizeof(bool) + sizeof(uint8) + sizeof(uint64) + 2 * sizeof(Entity) +
+                                                      sizeof(LastFrameCollisionInfo*) + sizeof(NarrowPhaseTriangle*) +
+                                                      NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO * sizeof(ContactPointInfo);
 
 // Constructor
 NarrowPhaseInfoBatch::NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator)
-                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator){
+                     : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs) {
 
 }
 
@@ -46,40 +49,203 @@ NarrowPhaseInfoBatch::~NarrowPhaseInfoBatch() {
     clear();
 }
 
-// Initialize the containers using cached capacity
-void NarrowPhaseInfoBatch::reserveMemory() {
+// Allocate memory for a given number of collision tests
+/// The data of the current collision tests is copied into the new buffer
+void NarrowPhaseInfoBatch::allocate(uint32 nbObjectsToAllocate) {
+
+    assert(nbObjectsToAllocate > mNbAllocatedObjects);
+
+    // Make sure capacity is an integral multiple of alignment
+    nbObjectsToAllocate = std::ceil(nbObjectsToAllocate / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+
+    // Size for the data of the collision tests (in bytes)
+    const size_t totalSizeBytes = nbObjectsToAllocate * OBJECT_DATA_SIZE + 15 * GLOBAL_ALIGNMENT;
+
+    // Allocate memory
+    void* newBuffer = mMemoryAllocator.allocate(totalSizeBytes);
+    assert(newBuffer != nullptr);
+    assert(reinterpret_cast<uintptr_t>(newBuffer) % GLOBAL_ALIGNMENT == 0);
+
+    // New pointers to the columns (the hot columns first)
+    Transform* newShape1ToWorldTransforms = static_cast<Transform*>(newBuffer);
+    Transform* newShape2ToWorldTransforms = reinterpret_cast<Transform*>(MemoryAllocator::alignAddress(newShape1ToWorldTransforms + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    CollisionShape** newCollisionShapes1 = reinterpret_cast<CollisionShape**>(MemoryAllocator::alignAddress(newShape2ToWorldTransforms + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    CollisionShape** newCollisionShapes2 = reinterpret_cast<CollisionShape**>(MemoryAllocator::alignAddress(newCollisionShapes1 + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    decimal* newShape1Margins = reinterpret_cast<decimal*>(MemoryAllocator::alignAddress(newCollisionShapes2 + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    decimal* newShape2Margins = reinterpret_cast<decimal*>(MemoryAllocator::alignAddress(newShape1Margins + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    bool* newReportContacts = reinterpret_cast<bool*>(MemoryAllocator::alignAddress(newShape2Margins + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    bool* newIsColliding = reinterpret_cast<bool*>(MemoryAllocator::alignAddress(newReportContacts + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    uint8* newNbContactPoints = reinterpret_cast<uint8*>(MemoryAllocator::alignAddress(newIsColliding + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    uint64* newOverlappingPairIds = reinterpret_cast<uint64*>(MemoryAllocator::alignAddress(newNbContactPoints + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    Entity* newColliderEntities1 = reinterpret_cast<Entity*>(MemoryAllocator::alignAddress(newOverlappingPairIds + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    Entity* newColliderEntities2 = reinterpret_cast<Entity*>(MemoryAllocator::alignAddress(newColliderEntities1 + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    LastFrameCollisionInfo** newLastFrameCollisionInfos = reinterpret_cast<LastFrameCollisionInfo**>(MemoryAllocator::alignAddress(newColliderEntities2 + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    const NarrowPhaseTriangle** newTriangles = reinterpret_cast<const NarrowPhaseTriangle**>(MemoryAllocator::alignAddress(newLastFrameCollisionInfos + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    ContactPointInfo (*newContactPoints)[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO] = reinterpret_cast<ContactPointInfo (*)[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO]>(MemoryAllocator::alignAddress(newTriangles + nbObjectsToAllocate, GLOBAL_ALIGNMENT));
+    assert(reinterpret_cast<uintptr_t>(newContactPoints + nbObjectsToAllocate) <= reinterpret_cast<uintptr_t>(newBuffer) + totalSizeBytes);
+
+    // If there was already collision tests before
+    if (mNbObjects > 0) {
+
+        // Copy the data from the previous buffer to the new one
+        memcpy(newShape1ToWorldTransforms, shape1ToWorldTransforms, mNbObjects * sizeof(Transform));
+        memcpy(newShape2ToWorldTransforms, shape2ToWorldTransforms, mNbObjects * sizeof(Transform));
+        memcpy(newCollisionShapes1, collisionShapes1, mNbObjects * sizeof(CollisionShape*));
+        memcpy(newCollisionShapes2, collisionShapes2, mNbObjects * sizeof(CollisionShape*));
+        memcpy(newShape1Margins, shape1Margins, mNbObjects * sizeof(decimal));
+        memcpy(newShape2Margins, shape2Margins, mNbObjects * sizeof(decimal));
+        memcpy(newReportContacts, reportContacts, mNbObjects * sizeof(bool));
+        memcpy(newIsColliding, isColliding, mNbObjects * sizeof(bool));
+        memcpy(newNbContactPoints, nbContactPoints, mNbObjects * sizeof(uint8));
+        memcpy(newOverlappingPairIds, overlappingPairIds, mNbObjects * sizeof(uint64));
+        memcpy(newColliderEntities1, colliderEntities1, mNbObjects * sizeof(Entity));
+        memcpy(newColliderEntities2, colliderEntities2, mNbObjects * sizeof(Entity));
+        memcpy(newLastFrameCollisionInfos, lastFrameCollisionInfos, mNbObjects * sizeof(LastFrameCollisionInfo*));
+        memcpy(newTriangles, triangles, mNbObjects * sizeof(NarrowPhaseTriangle*));
+
+        // Only the contact points that have been added are copied
+        for (uint32 i=0; i < mNbObjects; i++) {
+            memcpy(newContactPoints[i], contactPoints[i], nbContactPoints[i] * sizeof(ContactPointInfo));
+        }
+    }
 
-    narrowPhaseInfos.reserve(mCachedCapacity);
+    // Deallocate previous memory
+    releaseBuffer();
+
+    mBuffer = newBuffer;
+    shape1ToWorldTransforms = newShape1ToWorldTransforms;
+    shape2ToWorldTransforms = newShape2ToWorldTransforms;
+    collisionShapes1 = newCollisionShapes1;
+    collisionShapes2 = newCollisionShapes2;
+    shape1Margins = newShape1Margins;
+    shape2Margins = newShape2Margins;
+    reportContacts = newReportContacts;
+    isColliding = newIsColliding;
+    nbContactPoints = newNbContactPoints;
+    overlappingPairIds = newOverlappingPairIds;
+    colliderEntities1 = newColliderEntities1;
+    colliderEntities2 = newColliderEntities2;
+    lastFrameCollisionInfos = newLastFrameCollisionInfos;
+    triangles = newTriangles;
+    contactPoints = newContactPoints;
+
+    mNbAllocatedObjects = nbObjectsToAllocate;
 }
 
-// Clear all the objects in the batch
-void NarrowPhaseInfoBatch::clear() {
+// Release the buffer of the collision tests
+void NarrowPhaseInfoBatch::releaseBuffer() {
+
+    if (mBuffer != nullptr) {
+        mMemoryAllocator.release(mBuffer, mNbAllocatedObjects * OBJECT_DATA_SIZE + 15 * GLOBAL_ALIGNMENT);
+        mBuffer = nullptr;
+    }
+}
 
-    const uint32 nbNarrowPhaseInfos = static_cast<uint32>(narrowPhaseInfos.size());
-    for (uint32 i=0; i < nbNarrowPhaseInfos; i++) {
+// Move the narrow-phase infos of another batch at the end of this batch
+/// The memory blocks with the triangles of the moved infos are now released by this batch
+void NarrowPhaseInfoBatch::addNarrowPhaseInfos(NarrowPhaseInfoBatch& batch) {
 
-        assert(narrowPhaseInfos[i].nbContactPoints == 0);
+    const uint32 nbObjects = batch.mNbObjects;
 
-        // TODO OPTI : Better manage this
+    if (nbObjects > 0) {
 
-        // Release the memory of the TriangleShape (this memory was allocated in the
-        // MiddlePhaseTriangleCallback::testTriangle() method)
-        if (narrowPhaseInfos[i].collisionShape1->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape1->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape1, mTriangleShapeAllocatedSize);
+        if (mNbObjects + nbObjects > mNbAllocatedObjects) {
+            allocate(std::max(mNbObjects + nbObjects, 2 * mNbAllocatedObjects));
         }
-        if (narrowPhaseInfos[i].collisionShape2->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape2->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape2, mTriangleShapeAllocatedSize);
+
+        memcpy(shape1ToWorldTransforms + mNbObjects, batch.shape1ToWorldTransforms, nbObjects * sizeof(Transform));
+        memcpy(shape2ToWorldTransforms + mNbObjects, batch.shape2ToWorldTransforms, nbObjects * sizeof(Transform));
+        memcpy(collisionShapes1 + mNbObjects, batch.collisionShapes1, nbObjects * sizeof(CollisionShape*));
+        memcpy(collisionShapes2 + mNbObjects, batch.collisionShapes2, nbObjects * sizeof(CollisionShape*));
+        memcpy(shape1Margins + mNbObjects, batch.shape1Margins, nbObjects * sizeof(decimal));
+        memcpy(shape2Margins + mNbObjects, batch.shape2Margins, nbObjects * sizeof(decimal));
+        memcpy(reportContacts + mNbObjects, batch.reportContacts, nbObjects * sizeof(bool));
+        memcpy(isColliding + mNbObjects, batch.isColliding, nbObjects * sizeof(bool));
+        memcpy(nbContactPoints + mNbObjects, batch.nbContactPoints, nbObjects * sizeof(uint8));
+        memcpy(overlappingPairIds + mNbObjects, batch.overlappingPairIds, nbObjects * sizeof(uint64));
+        memcpy(colliderEntities1 + mNbObjects, batch.colliderEntities1, nbObjects * sizeof(Entity));
+        memcpy(colliderEntities2 + mNbObjects, batch.colliderEntities2, nbObjects * sizeof(Entity));
+        memcpy(lastFrameCollisionInfos + mNbObjects, batch.lastFrameCollisionInfos, nbObjects * sizeof(LastFrameCollisionInfo*));
+        memcpy(triangles + mNbObjects, batch.triangles, nbObjects * sizeof(NarrowPhaseTriangle*));
+        for (uint32 i=0; i < nbObjects; i++) {
+            memcpy(contactPoints[mNbObjects + i], batch.contactPoints[i], batch.nbContactPoints[i] * sizeof(ContactPointInfo));
         }
+
+        mNbObjects += nbObjects;
+        mNbTriangleObjects += batch.mNbTriangleObjects;
+    }
+
+    // Take the ownership of the triangle blocks of the other batch
+    if (batch.mTriangleBlocks != nullptr) {
+
+        TriangleBlock* lastBlock = batch.mTriangleBlocks;
+        while (lastBlock->next != nullptr) {
+            lastBlock = lastBlock->next;
+        }
+        lastBlock->next = mTriangleBlocks;
+        mTriangleBlocks = batch.mTriangleBlocks;
+        batch.mTriangleBlocks = nullptr;
+    }
+
+    batch.mNbObjects = 0;
+    batch.mNbTriangleObjects = 0;
+    batch.releaseBuffer();
+    batch.mNbAllocatedObjects = 0;
+}
+
+// Allocate a memory block for the triangles of a convex vs concave pair
+/// The triangles are not initialized. The block is released when the batch is cleared.
+NarrowPhaseTriangle* NarrowPhaseInfoBatch::allocateTriangles(uint32 nbTriangles, MemoryAllocator& allocator) {
+
+    assert(nbTriangles > 0);
+
+    // The triangles are stored after the header of the block
+    const size_t headerSize = std::ceil(sizeof(TriangleBlock) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+    const size_t sizeBytes = headerSize + nbTriangles * sizeof(NarrowPhaseTriangle);
+
+    TriangleBlock* block = static_cast<TriangleBlock*>(allocator.allocate(sizeBytes));
+    assert(reinterpret_cast<uintptr_t>(block) % GLOBAL_ALIGNMENT == 0);
+    block->next = mTriangleBlocks;
+    block->allocator = &allocator;
+    block->sizeBytes = sizeBytes;
+    mTriangleBlocks = block;
+
+    return reinterpret_cast<NarrowPhaseTriangle*>(reinterpret_cast<char*>(block) + headerSize);
+}
+
+// Initialize the containers using cached capacity
+void NarrowPhaseInfoBatch::reserveMemory() {
+
+    if (mCachedCapacity > mNbAllocatedObjects) {
+        allocate(mCachedCapacity);
+    }
+}
+
+// Clear all the objects in the batch
+void NarrowPhaseInfoBatch::clear() {
+
+#ifndef NDEBUG
+    for (uint32 i=0; i < mNbObjects; i++) {
+        assert(nbContactPoints[i] == 0);
+    }
+#endif
+
+    // Release the memory blocks with the triangles of the concave shapes
+    while (mTriangleBlocks != nullptr) {
+        TriangleBlock* block = mTriangleBlocks;
+        mTriangleBlocks = block->next;
+        block->allocator->release(block, block->sizeBytes);
     }
+    mNbTriangleObjects = 0;
 
     // Note that we clear the following containers and we release their allocated memory. Therefore,
     // if the memory allocator is a single frame allocator, the memory is deallocated and will be
     // allocated in the next frame at a possibly different location in memory (remember that the
     // location of the allocated memory of a single frame allocator might change between two frames)
 
-    mCachedCapacity = static_cast<uint32>(narrowPhaseInfos.capacity());
+    mCachedCapacity = mNbAllocatedObjects;
 
-    narrowPhaseInfos.clear(true);
+    mNbObjects = 0;
+    releaseBuffer();
+    mNbAllocatedObjects = 0;
 }
@@ -31,12 +31,30 @@ using namespace reactphysics3d;
 /// Constructor
 NarrowPhaseInput::NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs)
     :mSphereVsSphereBatch(overlappingPairs, allocator), mSphereVsCapsuleBatch(overlappingPairs, allocator),
-     mCapsuleVsCapsuleBatch(overlappingPairs, allocator), mSphereVsConvexPolyhedronBatch(overlappingPairs, allocator),
+     mCapsuleVsCapsuleBatch(overlappingPairs, allocator),
+     mSphereVsConvexPolyhedronBatch(overlappingPairs, allocator),
      mCapsuleVsConvexPolyhedronBatch(overlappingPairs, allocator),
-     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator) {
+     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator),
+     mBoxVsBoxBatch(overlappingPairs, allocator),
+     mConvexPolyhedronVsConvexPolyhedronGJKBatch(overlappingPairs, allocator),
+     mCachedContactsBatch(overlappingPairs, allocator) {
 
 }
 
+// Move the narrow-phase tests of another input at the end of the batches of this input
+void NarrowPhaseInput::addNarrowPhaseInput(NarrowPhaseInput& narrowPhaseInput) {
+
+    mSphereVsSphereBatch.addNarrowPhaseInfos(narrowPhaseInput.mSphereVsSphereBatch);
+    mSphereVsCapsuleBatch.addNarrowPhaseInfos(narrowPhaseInput.mSphereVsCapsuleBatch);
+    mCapsuleVsCapsuleBatch.addNarrowPhaseInfos(narrowPhaseInput.mCapsuleVsCapsuleBatch);
+    mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfos(narrowPhaseInput.mSphereVsConvexPolyhedronBatch);
+    mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfos(narrowPhaseInput.mCapsuleVsConvexPolyhedronBatch);
+    mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfos(narrowPhaseInput.mConvexPolyhedronVsConvexPolyhedronBatch);
+    mBoxVsBoxBatch.addNarrowPhaseInfos(narrowPhaseInput.mBoxVsBoxBatch);
+    mConvexPolyhedronVsConvexPolyhedronGJKBatch.addNarrowPhaseInfos(narrowPhaseInput.mConvexPolyhedronVsConvexPolyhedronGJKBatch);
+    mCachedContactsBatch.addNarrowPhaseInfos(narrowPhaseInput.mCachedContactsBatch);
+}
+
 /// Reserve memory for the containers with cached capacity
 void NarrowPhaseInput::reserveMemory() {
 
@@ -46,6 +64,9 @@ void NarrowPhaseInput::reserveMemory() {
     mSphereVsConvexPolyhedronBatch.reserveMemory();
     mCapsuleVsConvexPolyhedronBatch.reserveMemory();
     mConvexPolyhedronVsConvexPolyhedronBatch.reserveMemory();
+    mBoxVsBoxBatch.reserveMemory();
+    mConvexPolyhedronVsConvexPolyhedronGJKBatch.reserveMemory();
+    mCachedContactsBatch.reserveMemory();
 }
 
 // Clear
@@ -57,4 +78,7 @@ void NarrowPhaseInput::clear() {
     mSphereVsConvexPolyhedronBatch.clear();
     mCapsuleVsConvexPolyhedronBatch.clear();
     mConvexPolyhedronVsConvexPolyhedronBatch.clear();
+    mBoxVsBoxBatch.clear();
+    mConvexPolyhedronVsConvexPolyhedronGJKBatch.clear();
+    mCachedContactsBatch.clear();
 }
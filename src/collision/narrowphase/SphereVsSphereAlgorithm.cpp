@@ -38,22 +38,22 @@ bool SphereVsSphereAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInf
     // For each item in the batch
     for (uint32 batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
 
-        assert(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].nbContactPoints == 0);
-        assert(!narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].isColliding);
+        assert(narrowPhaseInfoBatch.nbContactPoints[batchIndex] == 0);
+        assert(!narrowPhaseInfoBatch.isColliding[batchIndex]);
 
         // Get the local-space to world-space transforms
-        const Transform& transform1 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape1ToWorldTransform;
-        const Transform& transform2 = narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].shape2ToWorldTransform;
+        const Transform& transform1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex];
+        const Transform& transform2 = narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
 
         // Compute the distance between the centers
         Vector3 vectorBetweenCenters = transform2.getPosition() - transform1.getPosition();
         decimal squaredDistanceBetweenCenters = vectorBetweenCenters.lengthSquare();
 
-        const SphereShape* sphereShape1 = static_cast<SphereShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape1);
-        const SphereShape* sphereShape2 = static_cast<SphereShape*>(narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].collisionShape2);
-
-        const decimal sphere1Radius = sphereShape1->getRadius();
-        const decimal sphere2Radius = sphereShape2->getRadius();
+        // The margin of a sphere shape is its radius
+        assert(narrowPhaseInfoBatch.shape1Margins[batchIndex] == static_cast<SphereShape*>(narrowPhaseInfoBatch.collisionShapes1[batchIndex])->getRadius());
+        assert(narrowPhaseInfoBatch.shape2Margins[batchIndex] == static_cast<SphereShape*>(narrowPhaseInfoBatch.collisionShapes2[batchIndex])->getRadius());
+        const decimal sphere1Radius = narrowPhaseInfoBatch.shape1Margins[batchIndex];
+        const decimal sphere2Radius = narrowPhaseInfoBatch.shape2Margins[batchIndex];
 
         // Compute the sum of the radius
         const decimal sumRadiuses = sphere1Radius + sphere2Radius;
@@ -71,7 +71,7 @@ bool SphereVsSphereAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInf
             if (penetrationDepth > 0) {
 
                 // If we need to report contacts
-                if (narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].reportContacts) {
+                if (narrowPhaseInfoBatch.reportContacts[batchIndex]) {
 
                     const Transform transform1Inverse = transform1.getInverse();
                     const Transform transform2Inverse = transform2.getInverse();
@@ -103,7 +103,7 @@ bool SphereVsSphereAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInf
                     narrowPhaseInfoBatch.addContactPoint(batchIndex, normal, penetrationDepth, intersectionOnBody1, intersectionOnBody2);
                 }
 
-                narrowPhaseInfoBatch.narrowPhaseInfos[batchIndex].isColliding = true;
+                narrowPhaseInfoBatch.isColliding[batchIndex] = true;
                 isCollisionFound = true;
             }
         }
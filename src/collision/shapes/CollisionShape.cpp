@@ -28,6 +28,8 @@
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/body/Body.h>
 #include <reactphysics3d/collision/Collider.h>
+#include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/mathematics/Ray.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -92,6 +94,24 @@ AABB CollisionShape::computeTransformedAABB(const Transform& transform) const {
     return aabb;
 }
 
+// Raycast method for a packet of rays with feedback information
+/// Each ray of the packet whose bit is set in the mask is tested against the shape. The bit i of the
+/// returned mask is set if the ray i hits the shape and the hit is then written in raycastInfos[i]. By
+/// default, the rays are tested one at a time. A shape can override this method to test the rays together.
+uint32 CollisionShape::raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, Collider* collider,
+                                     MemoryAllocator& allocator) const {
+
+    uint32 hitRaysMask = 0;
+
+    for (uint32 i=0; raysMask >> i != 0; i++) {
+        if ((raysMask & (1u << i)) != 0 && raycast(rays[i], raycastInfos[i], collider, allocator)) {
+            hitRaysMask |= (1u << i);
+        }
+    }
+
+    return hitRaysMask;
+}
+
 /// Notify all the assign colliders that the size of the collision shape has changed
 void CollisionShape::notifyColliderAboutChangedSize() {
 
@@ -28,6 +28,7 @@
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/collision/TriangleMesh.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <reactphysics3d/utils/Profiler.h>
 
 using namespace reactphysics3d;
@@ -145,7 +146,7 @@ void ConcaveMeshShape::computeOverlappingTriangles(const AABB& localAABB, Array<
 
     // Compute the nodes of the internal AABB tree that are overlapping with the AABB
     Array<int> overlappingNodes(allocator, 64);
-    mTriangleMesh->reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+    mTriangleMesh->reportAllShapesOverlappingWithAABB(aabb, overlappingNodes, allocator);
 
     const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
 
@@ -198,13 +199,46 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
     // Ask the Dynamic AABB Tree to report all AABB nodes that are hit by the ray.
     // The raycastCallback object will then compute ray casting against the triangles
     // in the hit AABBs.
-    mTriangleMesh->raycast(scaledRay, raycastCallback);
+    mTriangleMesh->raycast(scaledRay, raycastCallback, allocator);
 
     raycastCallback.raycastTriangles();
 
     return raycastCallback.getIsHit();
 }
 
+// Raycast method for a packet of rays with feedback information
+/// The rays traverse the triangles tree together and each triangle hit by some rays is only
+/// created once for all of them. The closest hit of each ray is kept.
+uint32 ConcaveMeshShape::raycastPacket(const Ray* rays, uint32 raysMask, RaycastInfo* raycastInfos, Collider* collider,
+                                       MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("ConcaveMeshShape::raycastPacket()", mProfiler);
+
+    // Apply the concave mesh inverse scale factor because the mesh is stored without scaling
+    // inside the dynamic AABB tree
+    const Vector3 inverseScale(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z);
+    Ray scaledRays[SimdDecimal::NB_LANES];
+    for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+        if ((raysMask & (1u << i)) != 0) {
+            scaledRays[i] = Ray(rays[i].point1 * inverseScale, rays[i].point2 * inverseScale, rays[i].maxFraction);
+        }
+    }
+
+    // Create the callback object that will compute ray casting against triangles
+    ConcaveMeshRaycastPacketCallback raycastCallback(*this, collider, raycastInfos, scaledRays, mScale, allocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+	// Set the profiler
+	raycastCallback.setProfiler(mProfiler);
+
+#endif
+
+    mTriangleMesh->raycastPacket(scaledRays, raysMask, raycastCallback, allocator);
+
+    return raycastCallback.getHitRaysMask();
+}
+
 // Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
 decimal ConcaveMeshRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
 
@@ -267,6 +301,62 @@ void ConcaveMeshRaycastCallback::raycastTriangles() {
     }
 }
 
+// Raycast the triangle of a leaf node with the rays of the packet that hit its AABB
+/// The maximum fraction of a ray that hits the triangle is reduced to the hit fraction so that
+/// the farther triangles are not tested anymore by this ray.
+uint32 ConcaveMeshRaycastPacketCallback::raycastBroadPhaseShape(int32 nodeId, uint32 raysMask, decimal* raysMaxFractions) {
+
+    // Get the node data (triangle index and mesh subpart index)
+    const int32 data = mConcaveMeshShape.getDynamicAABBTreeNodeDataInt(nodeId);
+
+    // Get the triangle vertices for this node from the concave mesh shape
+    Vector3 trianglePoints[3];
+    mConcaveMeshShape.getTriangleVertices(data, trianglePoints[0], trianglePoints[1], trianglePoints[2]);
+
+    // Get the vertices normals of the triangle
+    Vector3 verticesNormals[3];
+    mConcaveMeshShape.getTriangleVerticesNormals(data, verticesNormals[0], verticesNormals[1], verticesNormals[2]);
+
+    // Create a triangle collision shape that is tested by all the rays
+    TriangleShape triangleShape(trianglePoints, verticesNormals, mConcaveMeshShape.computeTriangleShapeId(data), mConcaveMeshShape.mTriangleHalfEdgeStructure, mAllocator);
+    triangleShape.setRaycastTestType(mConcaveMeshShape.getRaycastTestType());
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    // Set the profiler to the triangle shape
+    triangleShape.setProfiler(mProfiler);
+
+#endif
+
+    for (uint32 i=0; raysMask >> i != 0; i++) {
+
+        if ((raysMask & (1u << i)) == 0) continue;
+
+        // Ray casting test against the collision shape
+        RaycastInfo raycastInfo;
+        const Ray ray(mRays[i].point1, mRays[i].point2, raysMaxFractions[i]);
+        const bool isTriangleHit = triangleShape.raycast(ray, raycastInfo, mCollider, mAllocator);
+
+        // If the ray hit the collision shape
+        if (isTriangleHit && raycastInfo.hitFraction <= raysMaxFractions[i]) {
+
+            assert(raycastInfo.hitFraction >= decimal(0.0));
+
+            mRaycastInfos[i].body = raycastInfo.body;
+            mRaycastInfos[i].collider = raycastInfo.collider;
+            mRaycastInfos[i].hitFraction = raycastInfo.hitFraction;
+            mRaycastInfos[i].worldPoint = raycastInfo.worldPoint * mMeshScale;
+            mRaycastInfos[i].worldNormal = raycastInfo.worldNormal;
+            mRaycastInfos[i].triangleIndex = data;
+
+            raysMaxFractions[i] = raycastInfo.hitFraction;
+            mHitRaysMask |= (1u << i);
+        }
+    }
+
+    return 0;
+}
+
 // Return the local bounds of the shape in x, y and z directions.
 // This method is used to compute the AABB of the box
 /**
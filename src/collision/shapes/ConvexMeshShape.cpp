@@ -70,35 +70,43 @@ void ConvexMeshShape::computeScaledFacesNormals() {
 }
 
 // Return a local support point in a given direction without the object margin.
-/// If the edges information is not used for collision detection, this method will go through
-/// the whole vertices array and pick up the vertex with the largest dot product in the support
-/// direction. This is an O(n) process with "n" being the number of vertices in the mesh.
-/// However, if the edges information is used, we can cache the previous support vertex and use
-/// it as a start in a hill-climbing (local search) process to find the new support vertex which
-/// will be in most of the cases very close to the previous one. Using hill-climbing, this method
-/// runs in almost constant time.
+/// This method goes through the whole vertices array and picks up the vertex with the largest dot
+/// product in the support direction. This is an O(n) process with "n" being the number of vertices
+/// in the mesh (but the dot products are computed with SIMD instructions).
 Vector3 ConvexMeshShape::getLocalSupportPointWithoutMargin(const Vector3& direction) const {
 
-    decimal maxDotProduct = DECIMAL_SMALLEST;
-    uint32 indexMaxDotProduct = 0;
+    // The support vertex of the scaled mesh is the support vertex of the mesh in the scaled direction
+    const uint32 vertexIndex = mConvexMesh->computeSupportVertexIndex(direction * mScale);
 
-    // For each vertex of the mesh
-    for (uint32 i=0; i<mConvexMesh->getNbVertices(); i++) {
+    // Return the vertex with the largest dot product in the support direction
+    return mConvexMesh->getVertex(vertexIndex) * mScale;
+}
+
+// Return a local support point in a given direction without the object margin, starting the search at a cached vertex
+/// For a mesh with many vertices, we use the cached vertex (previous support vertex) as a start in
+/// a hill-climbing (local search) process along the edges of the mesh to find the new support vertex
+/// which will be in most of the cases very close to the previous one. Using hill-climbing, this method
+/// runs in almost constant time. For a small mesh, all the vertices are tested.
+/**
+ * @param direction Support direction in local-space of the shape
+ * @param vertexIndex Index of the vertex where to start the search (replaced by the index of the support vertex)
+ * @return The support point in local-space of the shape
+ */
+Vector3 ConvexMeshShape::getLocalSupportPointWithoutMarginFromVertex(const Vector3& direction, uint32& vertexIndex) const {
 
-        // Compute the dot product of the current vertex
-        decimal dotProduct = direction.dot(mConvexMesh->getVertex(i));
+    const uint32 nbVertices = mConvexMesh->getNbVertices();
+    const Vector3 scaledDirection = direction * mScale;
 
-        // If the current dot product is larger than the maximum one
-        if (dotProduct > maxDotProduct) {
-            indexMaxDotProduct = i;
-            maxDotProduct = dotProduct;
-        }
+    if (nbVertices < MIN_NB_VERTICES_HILL_CLIMBING) {
+        vertexIndex = mConvexMesh->computeSupportVertexIndex(scaledDirection);
     }
+    else {
 
-    assert(maxDotProduct >= decimal(0.0));
+        // The cached vertex might come from another mesh if the shape of the collider has changed
+        vertexIndex = mConvexMesh->computeSupportVertexIndex(scaledDirection, vertexIndex < nbVertices ? vertexIndex : 0);
+    }
 
-    // Return the vertex with the largest dot product in the support direction
-    return mConvexMesh->getVertex(indexMaxDotProduct) * mScale;
+    return mConvexMesh->getVertex(vertexIndex) * mScale;
 }
 
 // Raycast method with feedback information
@@ -54,3 +54,9 @@ Vector3 ConvexShape::getLocalSupportPointWithMargin(const Vector3& direction) co
 
     return supportPoint;
 }
+
+// Return a local support point in a given direction without the object margin, starting the search at a cached vertex
+/// Only the shapes with many vertices use the cached vertex, the other shapes ignore it.
+Vector3 ConvexShape::getLocalSupportPointWithoutMarginFromVertex(const Vector3& direction, uint32& /*vertexIndex*/) const {
+    return getLocalSupportPointWithoutMargin(direction);
+}
@@ -43,8 +43,8 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + + sizeof(Matrix3x3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Quaternion) + sizeof(Vector3) + sizeof(Vector3) +
-                                sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) + sizeof(Array<uint>) +
-                                sizeof(Vector3) + sizeof(Vector3), 31 * GLOBAL_ALIGNMENT) {
+                                sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) +
+                                sizeof(Vector3) + sizeof(Vector3), 30 * GLOBAL_ALIGNMENT) {
 
 }
 
@@ -120,9 +120,7 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     assert(reinterpret_cast<uintptr_t>(newIsAlreadyInIsland) % GLOBAL_ALIGNMENT == 0);
     Array<Entity>* newJoints = reinterpret_cast<Array<Entity>*>(MemoryAllocator::alignAddress(newIsAlreadyInIsland + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newJoints) % GLOBAL_ALIGNMENT == 0);
-    Array<uint>* newContactPairs = reinterpret_cast<Array<uint>*>(MemoryAllocator::alignAddress(newJoints + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
-    assert(reinterpret_cast<uintptr_t>(newContactPairs) % GLOBAL_ALIGNMENT == 0);
-    Vector3* newLinearLockAxisFactors = reinterpret_cast<Vector3*>(MemoryAllocator::alignAddress(newContactPairs + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    Vector3* newLinearLockAxisFactors = reinterpret_cast<Vector3*>(MemoryAllocator::alignAddress(newJoints + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newLinearLockAxisFactors) % GLOBAL_ALIGNMENT == 0);
     Vector3* newAngularLockAxisFactors = reinterpret_cast<Vector3*>(MemoryAllocator::alignAddress(newLinearLockAxisFactors + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newAngularLockAxisFactors) % GLOBAL_ALIGNMENT == 0);
@@ -160,7 +158,6 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newIsGravityEnabled, mIsGravityEnabled, mNbComponents * sizeof(bool));
         memcpy(newIsAlreadyInIsland, mIsAlreadyInIsland, mNbComponents * sizeof(bool));
         memcpy(newJoints, mJoints, mNbComponents * sizeof(Array<Entity>));
-        memcpy(newContactPairs, mContactPairs, mNbComponents * sizeof(Array<uint>));
         memcpy(newLinearLockAxisFactors, mLinearLockAxisFactors, mNbComponents * sizeof(Vector3));
         memcpy(newAngularLockAxisFactors, mAngularLockAxisFactors, mNbComponents * sizeof(Vector3));
 
@@ -198,7 +195,6 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mIsGravityEnabled = newIsGravityEnabled;
     mIsAlreadyInIsland = newIsAlreadyInIsland;
     mJoints = newJoints;
-    mContactPairs = newContactPairs;
     mLinearLockAxisFactors = newLinearLockAxisFactors;
     mAngularLockAxisFactors = newAngularLockAxisFactors;
 }
@@ -238,7 +234,6 @@ void RigidBodyComponents::addComponent(Entity bodyEntity, bool isDisabled, const
     mIsGravityEnabled[index] = true;
     mIsAlreadyInIsland[index] = false;
     new (mJoints + index) Array<Entity>(mMemoryAllocator);
-    new (mContactPairs + index) Array<uint>(mMemoryAllocator);
     new (mLinearLockAxisFactors + index) Vector3(1, 1, 1);
     new (mAngularLockAxisFactors + index) Vector3(1, 1, 1);
 
@@ -286,7 +281,6 @@ void RigidBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     mIsGravityEnabled[destIndex] = mIsGravityEnabled[srcIndex];
     mIsAlreadyInIsland[destIndex] = mIsAlreadyInIsland[srcIndex];
     new (mJoints + destIndex) Array<Entity>(mJoints[srcIndex]);
-    new (mContactPairs + destIndex) Array<uint>(mContactPairs[srcIndex]);
     new (mLinearLockAxisFactors + destIndex) Vector3(mLinearLockAxisFactors[srcIndex]);
     new (mAngularLockAxisFactors + destIndex) Vector3(mAngularLockAxisFactors[srcIndex]);
 
@@ -333,7 +327,6 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     bool isGravityEnabled1 = mIsGravityEnabled[index1];
     bool isAlreadyInIsland1 = mIsAlreadyInIsland[index1];
     Array<Entity> joints1 = mJoints[index1];
-    Array<uint> contactPairs1 = mContactPairs[index1];
     Vector3 linearLockAxisFactor1(mLinearLockAxisFactors[index1]);
     Vector3 angularLockAxisFactor1(mAngularLockAxisFactors[index1]);
 
@@ -371,7 +364,6 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     mIsGravityEnabled[index2] = isGravityEnabled1;
     mIsAlreadyInIsland[index2] = isAlreadyInIsland1;
     new (mJoints + index2) Array<Entity>(joints1);
-    new (mContactPairs + index2) Array<uint>(contactPairs1);
     new (mLinearLockAxisFactors + index2) Vector3(linearLockAxisFactor1);
     new (mAngularLockAxisFactors + index2) Vector3(angularLockAxisFactor1);
 
@@ -410,7 +402,6 @@ void RigidBodyComponents::destroyComponent(uint32 index) {
     mCentersOfMassLocal[index].~Vector3();
     mCentersOfMassWorld[index].~Vector3();
     mJoints[index].~Array<Entity>();
-    mContactPairs[index].~Array<uint>();
     mLinearLockAxisFactors[index].~Vector3();
     mAngularLockAxisFactors[index].~Vector3();
 }
@@ -361,7 +361,7 @@ void OverlappingPairs::enableConcavePairWithIndex(uint64 pairIndex) {
 
     // Create a new pair to be added into the array of disable pairs
     mConcavePairs.emplace(pair->pairID, pair->broadPhaseId1, pair->broadPhaseId2, pair->collider1, pair->collider2,
-                            pair->narrowPhaseAlgorithmType, pair->isShape1Convex, mPoolAllocator, mHeapAllocator, true);
+                            pair->narrowPhaseAlgorithmType, pair->isShape1Convex, mHeapAllocator, true);
     mConcavePairs[newPairIndex].collidingInCurrentFrame = pair->collidingInCurrentFrame;
     mConcavePairs[newPairIndex].collidingInPreviousFrame = pair->collidingInPreviousFrame;
 
@@ -385,7 +385,7 @@ void OverlappingPairs::disableConcavePairWithIndex(uint64 pairIndex) {
 
     // Create a new pair to be added into the array of disable pairs
     mDisabledConcavePairs.emplace(pair->pairID, pair->broadPhaseId1, pair->broadPhaseId2, pair->collider1, pair->collider2,
-                            pair->narrowPhaseAlgorithmType, pair->isShape1Convex, mPoolAllocator, mHeapAllocator, false, false);
+                            pair->narrowPhaseAlgorithmType, pair->isShape1Convex, mHeapAllocator, false, false);
     mDisabledConcavePairs[newPairIndex].collidingInCurrentFrame = pair->collidingInCurrentFrame;
     mDisabledConcavePairs[newPairIndex].collidingInPreviousFrame = pair->collidingInPreviousFrame;
 
@@ -416,7 +416,7 @@ uint64 OverlappingPairs::addPair(uint32 collider1Index, uint32 collider2Index, b
     if (isConvexVsConvex) {
 
         assert(!mMapConvexPairIdToPairIndex.containsKey(pairId));
-        NarrowPhaseAlgorithmType algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1->getType(), collisionShape2->getType());
+        NarrowPhaseAlgorithmType algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1, collisionShape2);
 
         // Map the entity with the new component lookup index
         mMapConvexPairIdToPairIndex.add(Pair<uint64, uint64>(pairId, mConvexPairs.size()));
@@ -436,7 +436,7 @@ uint64 OverlappingPairs::addPair(uint32 collider1Index, uint32 collider2Index, b
 
         // Create and add a new concave pair
         mConcavePairs.emplace(pairId, broadPhase1Id, broadPhase2Id, collider1Entity, collider2Entity, algorithmType,
-                              isShape1Convex, mPoolAllocator, mHeapAllocator, true);
+                              isShape1Convex, mHeapAllocator, true);
     }
 
     // Add the involved overlapping pair to the two colliders
@@ -37,15 +37,19 @@ Logger* PhysicsCommon::mLogger = nullptr;
 /// Constructor
 /**
  * @param baseMemoryAllocator Pointer to a user custom memory allocator
+ * @param useConcurrentPoolAllocator True if the small objects must be allocated with per-thread caches
+ *                                   instead of a pool allocator that locks a mutex on each call (useful when
+ *                                   many worlds are updated on different threads)
  */
-PhysicsCommon::PhysicsCommon(MemoryAllocator* baseMemoryAllocator)
-              : mMemoryManager(baseMemoryAllocator),
+PhysicsCommon::PhysicsCommon(MemoryAllocator* baseMemoryAllocator, bool useConcurrentPoolAllocator)
+              : mMemoryManager(baseMemoryAllocator, 0, useConcurrentPoolAllocator),
                 mPhysicsWorlds(mMemoryManager.getHeapAllocator()), mSphereShapes(mMemoryManager.getHeapAllocator()),
                 mBoxShapes(mMemoryManager.getHeapAllocator()), mCapsuleShapes(mMemoryManager.getHeapAllocator()),
                 mConvexMeshShapes(mMemoryManager.getHeapAllocator()), mConcaveMeshShapes(mMemoryManager.getHeapAllocator()),
                 mHeightFieldShapes(mMemoryManager.getHeapAllocator()), mConvexMeshes(mMemoryManager.getHeapAllocator()),
                 mTriangleMeshes(mMemoryManager.getHeapAllocator()), mHeightFields(mMemoryManager.getHeapAllocator()),
                 mProfilers(mMemoryManager.getHeapAllocator()), mDefaultLoggers(mMemoryManager.getHeapAllocator()),
+                mTaskScheduler(nullptr), mDefaultTaskSchedulers(mMemoryManager.getHeapAllocator()),
                 mBoxShapeHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 6, 8, 24),
                 mTriangleShapeHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 2, 3, 6) {
 
@@ -199,6 +203,13 @@ void PhysicsCommon::release() {
     }
     mDefaultLoggers.clear();
 
+    // Destroy the default task schedulers
+    for (auto it = mDefaultTaskSchedulers.begin(); it != mDefaultTaskSchedulers.end(); ++it) {
+        deleteDefaultTaskScheduler(*it);
+    }
+    mDefaultTaskSchedulers.clear();
+    mTaskScheduler = nullptr;
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -232,7 +243,28 @@ PhysicsWorld* PhysicsCommon::createPhysicsWorld(const PhysicsWorld::WorldSetting
 
 #endif
 
-    PhysicsWorld* world = new(mMemoryManager.allocate(MemoryManager::AllocationType::Heap, sizeof(PhysicsWorld))) PhysicsWorld(mMemoryManager, *this, worldSettings, profiler);
+    // Select the task scheduler of the world
+    TaskScheduler* taskScheduler = worldSettings.taskScheduler;
+    if (taskScheduler == nullptr) {
+
+        // If no scheduler has been set, we create a default one with a single worker (the world
+        // is then updated on the calling thread only, exactly like without a task scheduler)
+        if (mTaskScheduler == nullptr) {
+            mTaskScheduler = createDefaultTaskScheduler(1);
+        }
+
+        taskScheduler = mTaskScheduler;
+    }
+
+    // Select the memory manager of the world
+    MemoryManager* memoryManager = &mMemoryManager;
+    if (worldSettings.hasOwnMemoryManager) {
+        memoryManager = new (mMemoryManager.allocate(MemoryManager::AllocationType::Heap, sizeof(MemoryManager)))
+                            MemoryManager(&mMemoryManager.getBaseAllocator(), 0, mMemoryManager.isConcurrentPoolAllocatorUsed());
+    }
+
+    PhysicsWorld* world = new(mMemoryManager.allocate(MemoryManager::AllocationType::Heap, sizeof(PhysicsWorld))) PhysicsWorld(*memoryManager, *this, *taskScheduler,
+                                                                                                                                  worldSettings, profiler);
 
     mPhysicsWorlds.add(world);
 
@@ -256,11 +288,70 @@ void PhysicsCommon::destroyPhysicsWorld(PhysicsWorld* world) {
  */
 void PhysicsCommon::deletePhysicsWorld(PhysicsWorld* world) {
 
+   MemoryManager* memoryManager = &(world->mMemoryManager);
+
    // Call the destructor of the world
    world->~PhysicsWorld();
 
    // Release allocated memory
    mMemoryManager.release(MemoryManager::AllocationType::Heap, world, sizeof(PhysicsWorld));
+
+   // Destroy the memory manager of the world if it has its own one
+   if (memoryManager != &mMemoryManager) {
+       memoryManager->~MemoryManager();
+       mMemoryManager.release(MemoryManager::AllocationType::Heap, memoryManager, sizeof(MemoryManager));
+   }
+}
+
+// Update several physics worlds in parallel
+/// Each world with its own memory manager (see WorldSettings::hasOwnMemoryManager) is updated by a
+/// single worker of the task scheduler of the PhysicsCommon object. The parallel work of a world that
+/// uses this task scheduler is then executed by the same worker. The worlds that use the memory manager
+/// of the PhysicsCommon object share its single frame allocator and are therefore updated one after the
+/// other on the calling thread. The worlds must be different and must not be modified or queried during
+/// this call. Note that the worlds are only updated in parallel if a task scheduler with several workers
+/// has been set with setTaskScheduler() (the default task scheduler has a single worker).
+/**
+ * @param worlds The physics worlds to update
+ * @param timeStep The amount of time to step the simulations by (in seconds)
+ */
+void PhysicsCommon::updatePhysicsWorlds(const std::vector<PhysicsWorld*>& worlds, decimal timeStep) {
+
+    // Worlds that can be updated in parallel
+    Array<PhysicsWorld*> parallelWorlds(mMemoryManager.getHeapAllocator(), worlds.size());
+
+    for (uint32 i=0; i < worlds.size(); i++) {
+
+        if (&(worlds[i]->mMemoryManager) != &mMemoryManager) {
+            parallelWorlds.add(worlds[i]);
+        }
+        else {
+            worlds[i]->update(timeStep);
+        }
+    }
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    // The collision shapes can be shared between the worlds and use the profiler of the last world
+    // that used them. Since the profilers are not thread-safe, the worlds are updated one after the other
+    for (uint32 i=0; i < parallelWorlds.size(); i++) {
+        parallelWorlds[i]->update(timeStep);
+    }
+
+#else
+
+    if (mTaskScheduler == nullptr) {
+        mTaskScheduler = createDefaultTaskScheduler(1);
+    }
+
+    mTaskScheduler->parallelFor(static_cast<uint32>(parallelWorlds.size()), 1, [&parallelWorlds, timeStep](const TaskScheduler::TaskRange& range) {
+
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+            parallelWorlds[i]->update(timeStep);
+        }
+    });
+
+#endif
 }
 
 // Create and return a sphere collision shape
@@ -799,6 +890,62 @@ void PhysicsCommon::deleteDefaultLogger(DefaultLogger* logger) {
    mMemoryManager.release(MemoryManager::AllocationType::Pool, logger, sizeof(DefaultLogger));
 }
 
+// Create and return a new default task scheduler
+/**
+ * @param nbWorkers Number of workers (including the calling thread) of the scheduler. If zero,
+ *                  the number of hardware threads of the system is used.
+ * @return A pointer to the created default task scheduler
+ */
+DefaultTaskScheduler* PhysicsCommon::createDefaultTaskScheduler(uint32 nbWorkers) {
+
+    DefaultTaskScheduler* taskScheduler = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(DefaultTaskScheduler)))
+                                              DefaultTaskScheduler(mMemoryManager.getHeapAllocator(), nbWorkers);
+
+    mDefaultTaskSchedulers.add(taskScheduler);
+
+    return taskScheduler;
+}
+
+// Destroy a default task scheduler
+/// The task scheduler is not destroyed if a physics world still uses it
+/**
+ * @param taskScheduler A pointer to the default task scheduler to destroy
+ */
+void PhysicsCommon::destroyDefaultTaskScheduler(DefaultTaskScheduler* taskScheduler) {
+
+    for (auto it = mPhysicsWorlds.begin(); it != mPhysicsWorlds.end(); ++it) {
+
+        if (&((*it)->mTaskScheduler) == taskScheduler) {
+
+            RP3D_LOG("PhysicsCommon", Logger::Level::Error, Logger::Category::PhysicCommon,
+                     "Error when destroying a DefaultTaskScheduler: the task scheduler is still used by a physics world",  __FILE__, __LINE__);
+
+            return;
+        }
+    }
+
+    if (mTaskScheduler == taskScheduler) {
+        mTaskScheduler = nullptr;
+    }
+
+    deleteDefaultTaskScheduler(taskScheduler);
+
+    mDefaultTaskSchedulers.remove(taskScheduler);
+}
+
+// Delete a default task scheduler
+/**
+ * @param taskScheduler A pointer to the default task scheduler to destroy
+ */
+void PhysicsCommon::deleteDefaultTaskScheduler(DefaultTaskScheduler* taskScheduler) {
+
+   // Call the destructor of the task scheduler
+   taskScheduler->~DefaultTaskScheduler();
+
+   // Release allocated memory
+   mMemoryManager.release(MemoryManager::AllocationType::Pool, taskScheduler, sizeof(DefaultTaskScheduler));
+}
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -34,7 +34,7 @@
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/engine/Island.h>
 #include <reactphysics3d/collision/ContactManifold.h>
-#include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/containers/UnionFind.h>
 #include <iostream>
 
 // Namespaces
@@ -48,16 +48,17 @@ uint32 PhysicsWorld::mNbWorlds = 0;
 // Constructor
 /**
  * @param gravity Gravity vector in the world (in meters per second squared)
+ * @param taskScheduler Task scheduler used to execute the parallel work of the world
  * @param worldSettings The settings of the world
  * @param profiler Pointer to the profiler
  */
-PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsCommon, const WorldSettings& worldSettings,
+PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsCommon, TaskScheduler& taskScheduler, const WorldSettings& worldSettings,
 #ifdef IS_RP3D_PROFILING_ENABLED
                            Profiler* profiler)
 #else
                            Profiler* /*profiler*/)
 #endif
-              : mMemoryManager(memoryManager), mConfig(worldSettings), mEntityManager(mMemoryManager.getHeapAllocator()), mDebugRenderer(mMemoryManager.getHeapAllocator()),
+              : mMemoryManager(memoryManager), mConfig(worldSettings), mTaskScheduler(taskScheduler), mEntityManager(mMemoryManager.getHeapAllocator()), mDebugRenderer(mMemoryManager.getHeapAllocator()),
                 mIsDebugRenderingEnabled(false), mIsGravityEnabled(true), mBodyComponents(mMemoryManager.getHeapAllocator()), mRigidBodyComponents(mMemoryManager.getHeapAllocator()),
                 mTransformComponents(mMemoryManager.getHeapAllocator()), mCollidersComponents(mMemoryManager.getHeapAllocator()),
                 mJointsComponents(mMemoryManager.getHeapAllocator()), mBallAndSocketJointsComponents(mMemoryManager.getHeapAllocator()),
@@ -66,17 +67,18 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
                                         mMemoryManager, physicsCommon.mTriangleShapeHalfEdgeStructure),
                 mCollisionBodies(mMemoryManager.getHeapAllocator()), mEventListener(nullptr),
                 mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
-                mContactSolverSystem(mMemoryManager, *this, mIslands, mBodyComponents, mRigidBodyComponents,
+                mContactSolverSystem(mMemoryManager, *this, mTaskScheduler, mIslands, mBodyComponents, mRigidBodyComponents,
                                mCollidersComponents, mConfig.restitutionVelocityThreshold),
-                mConstraintSolverSystem(*this, mIslands, mRigidBodyComponents, mTransformComponents, mJointsComponents,
+                mConstraintSolverSystem(*this, mMemoryManager.getHeapAllocator(), mIslands, mRigidBodyComponents, mTransformComponents, mJointsComponents,
                                         mBallAndSocketJointsComponents, mFixedJointsComponents, mHingeJointsComponents,
                                         mSliderJointsComponents),
-                mDynamicsSystem(*this, mBodyComponents, mRigidBodyComponents, mTransformComponents, mCollidersComponents, mIsGravityEnabled, mConfig.gravity),
+                mDynamicsSystem(*this, mTaskScheduler, mBodyComponents, mRigidBodyComponents, mTransformComponents, mCollidersComponents, mIsGravityEnabled, mConfig.gravity),
                 mNbVelocitySolverIterations(mConfig.defaultVelocitySolverNbIterations),
                 mNbPositionSolverIterations(mConfig.defaultPositionSolverNbIterations), 
                 mIsSleepingEnabled(mConfig.isSleepingEnabled), mRigidBodies(mMemoryManager.getPoolAllocator()),
                 mSleepLinearVelocity(mConfig.defaultSleepLinearVelocity),
-                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep) {
+                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep),
+                mTransformsSnapshotIndex(0), mIsTransformsSnapshotsEnabled(false), mNbStartedAsyncUpdates(0), mNbFinishedAsyncUpdates(0) {
 
     // Automatically generate a name for the world
     if (mName == "") {
@@ -107,6 +109,9 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
 
     mNbWorlds++;
 
+    mContactSolverSystem.setIsSimdSolverEnabled(mConfig.isSimdContactSolverEnabled);
+    mCollisionDetection.mBroadPhaseSystem.setIsWideAABBTreeEnabled(mConfig.isWideAABBTreeEnabled);
+
     mTransformComponents.init();
     mCollidersComponents.init();
     mBodyComponents.init();
@@ -130,6 +135,11 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
 // Destructor
 PhysicsWorld::~PhysicsWorld() {
 
+    // Wait for the end of the last asynchronous update
+    if (mAsyncUpdateThread.joinable()) {
+        mAsyncUpdateThread.join();
+    }
+
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
              "Physics World: Physics world " + mName + " has been destroyed",  __FILE__, __LINE__);
 
@@ -205,6 +215,33 @@ void PhysicsWorld::setJointDisabled(Entity jointEntity, bool isDisabled) {
     }
 }
 
+// Ray cast method for a batch of rays
+/// The hit of each ray is written at the same index in the array of hits (the hit fraction of a ray
+/// that does not hit anything is negative). With the CLOSEST_HIT mode, the closest hit of each ray is
+/// reported and with the FIRST_HIT mode, any hit of the ray is reported (which is faster for visibility
+/// tests). The consecutive rays of the batch are tested together and therefore the batch is faster if
+/// consecutive rays are coherent (close origins and directions). If the batch is parallel, the rays are
+/// tested by the workers of the task scheduler of the world. A parallel batch must not be run from within
+/// a task of the scheduler. The batches always use the dynamic AABB tree of the broad-phase.
+/**
+ * @param rays Array of rays to use for raycasting
+ * @param outHits Array where the hits of the rays are written (resized to the number of rays)
+ * @param mode Hit of each ray to report
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                    bodies to be raycasted
+ * @param isParallel True if the rays must be tested in parallel by the task scheduler
+ */
+void PhysicsWorld::raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHits, RaycastBatchMode mode,
+                                unsigned short raycastWithCategoryMaskBits, bool isParallel) const {
+
+    outHits.resize(rays.size());
+
+    if (rays.empty()) return;
+
+    mCollisionDetection.raycastBatch(rays.data(), static_cast<uint32>(rays.size()), outHits.data(), mode,
+                                     raycastWithCategoryMaskBits, isParallel);
+}
+
 // Return true if two bodies overlap
 /// Use this method if you are not interested in contacts but if you simply want to know
 /// if the two bodies overlap. If you want to get the contacts, you need to use the
@@ -238,6 +275,100 @@ AABB PhysicsWorld::getWorldAABB(const Collider* collider) const {
  */
 void PhysicsWorld::update(decimal timeStep) {
 
+    if (mCollisionDetection.isInConcurrentQueriesMode()) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when updating the world: the world cannot be updated between beginConcurrentQueries() and endConcurrentQueries()",  __FILE__, __LINE__);
+        assert(false);
+        return;
+    }
+
+    if (isAsyncUpdateRunning()) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when updating the world: an asynchronous update of the world is still running",  __FILE__, __LINE__);
+        assert(false);
+        return;
+    }
+
+    updateSimulation(timeStep);
+}
+
+// Start an update of the physics simulation on another thread and return immediately
+/// The simulation step is executed on a separate thread (its parallel work still uses the task scheduler
+/// of the world). While it runs, the world must not be modified nor queried, except for the transforms
+/// snapshots of the rigid bodies (see RigidBody::getTransformSnapshot()) that contain the state at the end
+/// of the previous step and can be read from any thread. The event listener is called from the update
+/// thread. If the previous asynchronous update is not finished yet, this method first waits for it.
+/**
+ * @param timeStep The amount of time to step the simulation by (in seconds)
+ * @return A handle that can be used to check whether the update is finished or to wait for it
+ */
+PhysicsWorld::UpdateHandle PhysicsWorld::updateAsync(decimal timeStep) {
+
+    if (mCollisionDetection.isInConcurrentQueriesMode()) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when updating the world: the world cannot be updated between beginConcurrentQueries() and endConcurrentQueries()",  __FILE__, __LINE__);
+        assert(false);
+        return UpdateHandle();
+    }
+
+    // Wait for the end of the previous asynchronous update
+    if (mAsyncUpdateThread.joinable()) {
+        mAsyncUpdateThread.join();
+    }
+
+    // The transforms snapshots are only maintained once the world is updated asynchronously
+    if (!mIsTransformsSnapshotsEnabled.load(std::memory_order_relaxed)) {
+        updateTransformsSnapshots();
+        mIsTransformsSnapshotsEnabled.store(true, std::memory_order_release);
+    }
+
+    mNbStartedAsyncUpdates++;
+
+    mAsyncUpdateThread = std::thread([this, timeStep]() {
+
+        updateSimulation(timeStep);
+
+        {
+            std::lock_guard<std::mutex> lock(mAsyncUpdateMutex);
+            mNbFinishedAsyncUpdates.store(mNbStartedAsyncUpdates, std::memory_order_release);
+        }
+        mAsyncUpdateDoneCondition.notify_all();
+    });
+
+    return UpdateHandle(this, mNbStartedAsyncUpdates);
+}
+
+// Wait until the asynchronous update with a given index is finished
+void PhysicsWorld::waitAsyncUpdate(uint64 updateIndex) {
+
+    std::unique_lock<std::mutex> lock(mAsyncUpdateMutex);
+    mAsyncUpdateDoneCondition.wait(lock, [this, updateIndex]() {
+        return mNbFinishedAsyncUpdates.load(std::memory_order_relaxed) >= updateIndex;
+    });
+}
+
+// Write the current transforms of the rigid bodies into their next snapshot and make it readable
+/// The snapshot that is currently read is never modified. Therefore, the transforms returned by
+/// RigidBody::getTransformSnapshot() stay valid until the end of the next update of the world.
+void PhysicsWorld::updateTransformsSnapshots() {
+
+    RP3D_PROFILE("PhysicsWorld::updateTransformsSnapshots()", mProfiler);
+
+    const uint32 nextSnapshotIndex = 1 - mTransformsSnapshotIndex.load(std::memory_order_relaxed);
+
+    for (uint32 i=0; i < mRigidBodies.size(); i++) {
+        mRigidBodies[i]->mTransformsSnapshots[nextSnapshotIndex] = mTransformComponents.getTransform(mRigidBodies[i]->getEntity());
+    }
+
+    mTransformsSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
+}
+
+// Execute the simulation step of an update of the world
+void PhysicsWorld::updateSimulation(decimal timeStep) {
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
     // Increment the frame counter of the profiler
@@ -302,6 +433,11 @@ void PhysicsWorld::update(decimal timeStep) {
         mDebugRenderer.computeDebugRenderingPrimitives(*this);
     }
 
+    // Publish the new transforms of the rigid bodies
+    if (mIsTransformsSnapshotsEnabled.load(std::memory_order_relaxed)) {
+        updateTransformsSnapshots();
+    }
+
     // Reset the single frame memory allocator
     mMemoryManager.resetFrameAllocator();
 }
@@ -309,12 +445,18 @@ void PhysicsWorld::update(decimal timeStep) {
 // Update the world inverse inertia tensors of rigid bodies
 void PhysicsWorld::updateBodiesInverseWorldInertiaTensors() {
 
-    uint32 nbComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbComponents; i++) {
-        const Matrix3x3 orientation = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).getOrientation().getMatrix();
+    RP3D_PROFILE("PhysicsWorld::updateBodiesInverseWorldInertiaTensors()", mProfiler);
 
-        RigidBody::computeWorldInertiaTensorInverse(orientation, mRigidBodyComponents.mInverseInertiaTensorsLocal[i], mRigidBodyComponents.mInverseInertiaTensorsWorld[i]);
-    }
+    // Each body only writes its own inertia tensor so the bodies can be processed in parallel
+    const uint32 nbComponents = mRigidBodyComponents.getNbEnabledComponents();
+    mTaskScheduler.parallelFor(nbComponents, PARALLEL_FOR_CHUNK_SIZE, [this](const TaskScheduler::TaskRange& range) {
+
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+            const Matrix3x3 orientation = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).getOrientation().getMatrix();
+
+            RigidBody::computeWorldInertiaTensorInverse(orientation, mRigidBodyComponents.mInverseInertiaTensorsLocal[i], mRigidBodyComponents.mInverseInertiaTensorsWorld[i]);
+        }
+    });
 }
 
 // Solve the contacts and constraints
@@ -322,6 +464,14 @@ void PhysicsWorld::solveContactsAndConstraints(decimal timeStep) {
 
     RP3D_PROFILE("PhysicsWorld::solveContactsAndConstraints()", mProfiler);
 
+    // If the islands can be solved in parallel or the contacts of the large islands are partitioned into colors
+    if ((mConfig.isParallelIslandSolverEnabled && mTaskScheduler.getNbWorkers() > 1 && mIslands.getNbIslands() > 1) ||
+        mConfig.isGraphColoringContactSolverEnabled) {
+
+        solveIslandsContactsAndConstraints(timeStep);
+        return;
+    }
+
     // ---------- Solve velocity constraints for joints and contacts ---------- //
 
     // Initialize the contact solver
@@ -344,6 +494,113 @@ void PhysicsWorld::solveContactsAndConstraints(decimal timeStep) {
     mContactSolverSystem.reset();
 }
 
+// Solve the contacts and joints of the islands in parallel
+/// Two islands never share a dynamic body and the solvers never write the velocities of the static
+/// bodies. Therefore, the islands can be solved independently. The constraints of an island are solved
+/// in the same order as in the sequential solver so that the result does not depend on the number
+/// of workers of the task scheduler. Small consecutive islands are grouped into a single task. The
+/// contacts of the large islands are partitioned into colors that are solved in parallel (if enabled).
+void PhysicsWorld::solveIslandsContactsAndConstraints(decimal timeStep) {
+
+    RP3D_PROFILE("PhysicsWorld::solveIslandsContactsAndConstraints()", mProfiler);
+
+    const uint32 nbIslands = mIslands.getNbIslands();
+
+    // Allocate the contact constraints (they are initialized by the task of each island)
+    mContactSolverSystem.allocate(mCollisionDetection.mCurrentContactManifolds, mCollisionDetection.mCurrentContactPoints, timeStep);
+
+    // Initialize the constraint solver
+    mConstraintSolverSystem.initializeForIslands(timeStep);
+
+    // Solve the enabled joints that are not part of any island
+    mConstraintSolverSystem.warmstartIsland(nbIslands);
+    for (uint32 i=0; i < mNbVelocitySolverIterations; i++) {
+        mConstraintSolverSystem.solveVelocityConstraintsIsland(nbIslands);
+    }
+
+    // Group the consecutive islands into batches with a minimum number of constraints
+    Array<uint32> batchesStartIsland(mMemoryManager.getSingleFrameAllocator(), nbIslands + 1);
+    uint32 nbConstraintsInBatch = 0;
+    for (uint32 i=0; i < nbIslands; i++) {
+
+        // The colored islands are solved afterwards
+        if (isColoredIsland(i)) continue;
+
+        if (nbConstraintsInBatch == 0) {
+            batchesStartIsland.add(i);
+        }
+
+        nbConstraintsInBatch += mIslands.nbContactManifolds[i] + mIslands.nbJointsInIsland[i];
+        if (nbConstraintsInBatch >= PARALLEL_ISLANDS_BATCH_MIN_NB_CONSTRAINTS) {
+            nbConstraintsInBatch = 0;
+        }
+    }
+    const uint32 nbBatches = static_cast<uint32>(batchesStartIsland.size());
+    batchesStartIsland.add(nbIslands);
+
+    // Solve the batches of islands (in parallel only if enabled)
+    const uint32 batchesChunkSize = mConfig.isParallelIslandSolverEnabled ? 1 : std::max(nbBatches, uint32(1));
+    mTaskScheduler.parallelFor(nbBatches, batchesChunkSize, [this, &batchesStartIsland](const TaskScheduler::TaskRange& range) {
+
+        for (uint32 b=range.startIndex; b < range.endIndex; b++) {
+            for (uint32 i=batchesStartIsland[b]; i < batchesStartIsland[b + 1]; i++) {
+
+                if (!isColoredIsland(i)) {
+                    solveIslandContactsAndConstraints(i);
+                }
+            }
+        }
+    });
+
+    // For each large island
+    for (uint32 i=0; i < nbIslands; i++) {
+
+        if (!isColoredIsland(i)) continue;
+
+        // Partition the contacts of the island into colors
+        mContactSolverSystem.initializeForColoredIsland(i);
+
+        mConstraintSolverSystem.warmstartIsland(i);
+
+        // For each iteration of the velocity solver
+        for (uint32 j=0; j < mNbVelocitySolverIterations; j++) {
+
+            mConstraintSolverSystem.solveVelocityConstraintsIsland(i);
+
+            mContactSolverSystem.solveColoredIsland();
+        }
+    }
+
+    mContactSolverSystem.storeImpulses();
+
+    // Reset the contact solver
+    mContactSolverSystem.reset();
+}
+
+// Solve the contacts and joints of a single island
+/// This method is called from a worker thread of the task scheduler
+void PhysicsWorld::solveIslandContactsAndConstraints(uint32 islandIndex) {
+
+    const bool hasContacts = mIslands.nbContactManifolds[islandIndex] > 0;
+
+    if (hasContacts) {
+        mContactSolverSystem.initializeForIsland(islandIndex);
+        mContactSolverSystem.warmStartIsland(islandIndex);
+    }
+
+    mConstraintSolverSystem.warmstartIsland(islandIndex);
+
+    // For each iteration of the velocity solver
+    for (uint32 i=0; i < mNbVelocitySolverIterations; i++) {
+
+        mConstraintSolverSystem.solveVelocityConstraintsIsland(islandIndex);
+
+        if (hasContacts) {
+            mContactSolverSystem.solveIsland(islandIndex);
+        }
+    }
+}
+
 // Solve the position error correction of the constraints
 void PhysicsWorld::solvePositionCorrection() {
 
@@ -687,184 +944,231 @@ void PhysicsWorld::addJointToBodies(Entity body1, Entity body2, Entity joint) {
 /// the contact manifolds and contact points of the same island
 /// to be packed together into linear arrays of manifolds and contacts for better caching.
 /// An island is an isolated group of rigid bodies that have constraints (joints or contacts)
-/// between each other. This method computes the islands at each time step as follows: For each
-/// awake rigid body, we run a Depth First Search (DFS) through the constraint graph of that body
-/// (graph where nodes are the bodies and where the edges are the constraints between the bodies) to
-/// find all the bodies that are connected with it (the bodies that share joints or contacts with
-/// it). Then, we create an island with this group of connected bodies.
+/// between each other. This method computes the islands at each time step as follows: The
+/// bodies of each contact pair and joint are merged (in parallel) into a union-find structure
+/// where each set is a group of connected non-static bodies. Static bodies are never merged
+/// because they do not connect the bodies of an island. Then, an island is created for each set
+/// that contains an awake body and its bodies, contact pairs and joints are packed together
+/// with a counting sort. The islands are ordered by their smallest body index and the contact
+/// pairs and joints of an island by their index so that the islands do not depend on the
+/// number of worker threads.
 void PhysicsWorld::createIslands() {
 
     RP3D_PROFILE("PhysicsWorld::createIslands()", mProfiler);
 
     assert(mProcessContactPairsOrderIslands.size() == 0);
 
-    // Reset all the isAlreadyInIsland variables of bodies and joints
+    MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
+    const Array<ContactPair>& contactPairs = *mCollisionDetection.mCurrentContactPairs;
+
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbComponents();
-    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = false;
-    }
+    const uint32 nbEnabledRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
     const uint32 nbJointsComponents = mJointsComponents.getNbComponents();
-    for (uint32 i=0; i < nbJointsComponents; i++) {
-        mJointsComponents.mIsAlreadyInIsland[i] = false;
-    }
+    const uint32 nbContactPairs = static_cast<uint32>(contactPairs.size());
+    const uint32 INVALID_INDEX = static_cast<uint32>(-1);
 
     // Reserve memory for the islands
     mIslands.reserveMemory();
 
-    // Create a stack for the bodies to visit during the Depth First Search
-    Stack<Entity> bodyEntitiesToVisit(mMemoryManager.getSingleFrameAllocator(), mIslands.getNbMaxBodiesInIslandPreviousFrame());
-
-    // Array of static bodies added to the current island (used to reset the isAlreadyInIsland variable of static bodies)
-    Array<Entity> staticBodiesAddedToIsland(mMemoryManager.getSingleFrameAllocator(), 16);
-
-    uint32 nbTotalManifolds = 0;
-
-    // For each rigid body component
-    for (uint32 b=0; b < mRigidBodyComponents.getNbEnabledComponents(); b++) {
-
-        // If the body has already been added to an island, we go to the next body
-        if (mRigidBodyComponents.mIsAlreadyInIsland[b]) continue;
+    if (nbRigidBodyComponents == 0) return;
 
-        // If the body is static, we go to the next body
-        if (mRigidBodyComponents.mBodyTypes[b] == BodyType::STATIC) continue;
-
-        // If the body does not have any simulation collider, we skip it
-        if (!mBodyComponents.getHasSimulationCollider(mRigidBodyComponents.mRigidBodies[b]->getEntity())) continue;
-
-        // Reset the stack of bodies to visit
-        bodyEntitiesToVisit.clear();
-
-        // Add the body into the stack of bodies to visit
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = true;
-        bodyEntitiesToVisit.push(mRigidBodyComponents.mBodiesEntities[b]);
-
-        // Create the new island
-        uint32 islandIndex = mIslands.addIsland(nbTotalManifolds);
-
-        // While there are still some bodies to visit in the stack
-        while (bodyEntitiesToVisit.size() > 0) {
-
-            // Get the body entity
-            const Entity bodyToVisitEntity = bodyEntitiesToVisit.pop();
-
-            // Add the body into the island
-            mIslands.addBodyToIsland(bodyToVisitEntity);
+    // Map each body entity index to its rigid body component index. This
+    // avoids a lookup in the map of the components for each contact pair
+    uint32 maxEntityIndex = 0;
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        maxEntityIndex = std::max(maxEntityIndex, mRigidBodyComponents.mBodiesEntities[b].getIndex());
+    }
+    Array<uint32> entityToBodyIndex(allocator, maxEntityIndex + 1);
+    entityToBodyIndex.addWithoutInit(maxEntityIndex + 1);
+    for (uint32 i=0; i <= maxEntityIndex; i++) {
+        entityToBodyIndex[i] = INVALID_INDEX;
+    }
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        entityToBodyIndex[mRigidBodyComponents.mBodiesEntities[b].getIndex()] = b;
+    }
 
-            RigidBody* rigidBodyToVisit = mRigidBodyComponents.getRigidBody(bodyToVisitEntity);
+    // Merge the bodies of the contact pairs. Note that a contact pair that is not a trigger is always
+    // between two simulation colliders (see CollisionDetectionSystem::computeMiddlePhase())
+    UnionFind bodiesSets(allocator, nbRigidBodyComponents);
+    mTaskScheduler.parallelFor(nbContactPairs, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
 
-            // Awake the body if it is sleeping (note that this called might change the body index in the mRigidBodyComponents array)
-            rigidBodyToVisit->setIsSleeping(false);
+        for (uint32 p=range.startIndex; p < range.endIndex; p++) {
 
-            // Compute the body index in the array (Note that it could have changed because of the previous call to rigidBodyToVisit->setIsSleeping(false))
-            const uint32 bodyToVisitIndex = mRigidBodyComponents.getEntityIndex(bodyToVisitEntity);
+            const ContactPair& pair = contactPairs[p];
+            if (pair.isTrigger) continue;
 
-            // If the current body is static, we do not want to perform the DFS search across that body
-            if (mRigidBodyComponents.mBodyTypes[bodyToVisitIndex] == BodyType::STATIC) {
+            const uint32 body1Index = entityToBodyIndex[pair.body1Entity.getIndex()];
+            const uint32 body2Index = entityToBodyIndex[pair.body2Entity.getIndex()];
+            assert(body1Index != INVALID_INDEX && body2Index != INVALID_INDEX);
 
-                staticBodiesAddedToIsland.add(bodyToVisitEntity);
+            // A static body does not connect its neighbors
+            if (mRigidBodyComponents.mBodyTypes[body1Index] != BodyType::STATIC &&
+                mRigidBodyComponents.mBodyTypes[body2Index] != BodyType::STATIC) {
 
-                // Go to the next body
-                continue;
+                bodiesSets.merge(body1Index, body2Index);
             }
+        }
+    });
 
-            // If the body is involved in contacts with other bodies
-            // For each contact pair in which the current body is involved
-            const uint32 nbBodyContactPairs = static_cast<uint32>(mRigidBodyComponents.mContactPairs[bodyToVisitIndex].size());
-            for (uint32 p=0; p < nbBodyContactPairs; p++) {
-
-                const uint32 contactPairIndex = mRigidBodyComponents.mContactPairs[bodyToVisitIndex][p];
-                ContactPair& pair = (*mCollisionDetection.mCurrentContactPairs)[contactPairIndex];
-
-                // Check if the current contact pair has already been added into an island
-                if (pair.isAlreadyInIsland) continue;
-
-                pair.isAlreadyInIsland = true;
-
-                const bool isCollider1SimulationCollider = mCollidersComponents.getIsSimulationCollider(pair.collider1Entity);
-                const bool isCollider2SimulationCollider = mCollidersComponents.getIsSimulationCollider(pair.collider2Entity);
-
-                // Check that both colliders are simulation collider
-                if (!isCollider1SimulationCollider || !isCollider2SimulationCollider) {
-                    continue;
-                }
-
-                const Entity otherBodyEntity = pair.body1Entity == bodyToVisitEntity ? pair.body2Entity : pair.body1Entity;
-
-                assert(mCollidersComponents.getIsSimulationCollider(pair.collider1Entity));
-                assert(mCollidersComponents.getIsSimulationCollider(pair.collider2Entity));
-                assert(!mCollidersComponents.getIsTrigger(pair.collider1Entity));
-                assert(!mCollidersComponents.getIsTrigger(pair.collider2Entity));
-
-                uint32 otherBodyIndex;
-                const bool isFound = mRigidBodyComponents.hasComponentGetIndex(otherBodyEntity, otherBodyIndex);
-                assert(isFound);
-
-                // If the body is a simulation collider
-                if (mBodyComponents.getHasSimulationCollider(otherBodyEntity)) {
+    // Merge the bodies of the joints
+    for (uint32 j=0; j < nbJointsComponents; j++) {
 
-                    mProcessContactPairsOrderIslands.add(contactPairIndex);
+        const uint32 body1Index = entityToBodyIndex[mJointsComponents.mBody1Entities[j].getIndex()];
+        const uint32 body2Index = entityToBodyIndex[mJointsComponents.mBody2Entities[j].getIndex()];
 
-                    assert(pair.nbPotentialContactManifolds > 0);
-                    nbTotalManifolds += pair.nbPotentialContactManifolds;
+        if (mRigidBodyComponents.mBodyTypes[body1Index] != BodyType::STATIC &&
+            mRigidBodyComponents.mBodyTypes[body2Index] != BodyType::STATIC) {
 
-                    // Add the contact manifold into the island
-                    mIslands.nbContactManifolds[islandIndex] += pair.nbPotentialContactManifolds;
+            bodiesSets.merge(body1Index, body2Index);
+        }
+    }
 
-                    // Check if the other body has already been added to the island
-                    if (mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex]) continue;
+    bodiesSets.flatten();
 
-                    // Insert the other body into the stack of bodies to visit
-                    bodyEntitiesToVisit.push(otherBodyEntity);
-                    mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex] = true;
-                }
-            }
+    // For each root body, index of the island of its set (an island is only created
+    // for a set that contains an awake non-static body with a simulation collider)
+    Array<uint32> rootsIslandIndex(allocator, nbRigidBodyComponents);
+    rootsIslandIndex.addWithoutInit(nbRigidBodyComponents);
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        rootsIslandIndex[b] = INVALID_INDEX;
+    }
+    const uint32 nbBodyComponents = mBodyComponents.getNbComponents();
+    for (uint32 i=0; i < nbBodyComponents; i++) {
 
-            // For each joint in which the current body is involved
-            const Array<Entity>& joints = mRigidBodyComponents.getJoints(rigidBodyToVisit->getEntity());
-            const uint32 nbBodyJoints = static_cast<uint32>(joints.size());
-            for (uint32 i=0; i < nbBodyJoints; i++) {
+        if (!mBodyComponents.mHasSimulationCollider[i]) continue;
 
-                const uint32 jointComponentIndex = mJointsComponents.getEntityIndex(joints[i]);
+        const uint32 entityIndex = mBodyComponents.mBodiesEntities[i].getIndex();
+        if (entityIndex > maxEntityIndex) continue;
 
-                // Check if the current joint has already been added into an island
-                if (mJointsComponents.mIsAlreadyInIsland[jointComponentIndex]) continue;
+        const uint32 bodyIndex = entityToBodyIndex[entityIndex];
+        if (bodyIndex < nbEnabledRigidBodyComponents && mRigidBodyComponents.mBodyTypes[bodyIndex] != BodyType::STATIC) {
+            rootsIslandIndex[bodiesSets.getFlattenedRoot(bodyIndex)] = 0;
+        }
+    }
+    uint32 nbIslands = 0;
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        if (rootsIslandIndex[b] != INVALID_INDEX) {
+            assert(bodiesSets.getFlattenedRoot(b) == b);
+            rootsIslandIndex[b] = nbIslands++;
+        }
+    }
 
-                // Add the joint into the island
-                mJointsComponents.mIsAlreadyInIsland[jointComponentIndex] = true;
+    if (nbIslands == 0) return;
+
+    // Return the island of a body (or INVALID_INDEX if the body is static or not in an island)
+    auto getBodyIslandIndex = [&](uint32 bodyIndex) {
+        if (mRigidBodyComponents.mBodyTypes[bodyIndex] == BodyType::STATIC) return INVALID_INDEX;
+        return rootsIslandIndex[bodiesSets.getFlattenedRoot(bodyIndex)];
+    };
+
+    // Return the island of a constraint between two bodies (at least one body is not static)
+    auto getConstraintIslandIndex = [&](Entity body1Entity, Entity body2Entity) {
+        const uint32 body1Index = entityToBodyIndex[body1Entity.getIndex()];
+        const uint32 islandIndex = getBodyIslandIndex(body1Index);
+        return islandIndex != INVALID_INDEX ? islandIndex : getBodyIslandIndex(entityToBodyIndex[body2Entity.getIndex()]);
+    };
+
+    // Compute the island of each contact pair and joint
+    Array<uint32> contactPairsIslandIndex(allocator, nbContactPairs);
+    contactPairsIslandIndex.addWithoutInit(nbContactPairs);
+    for (uint32 p=0; p < nbContactPairs; p++) {
+        const ContactPair& pair = contactPairs[p];
+        contactPairsIslandIndex[p] = pair.isTrigger ? INVALID_INDEX : getConstraintIslandIndex(pair.body1Entity, pair.body2Entity);
+    }
+    Array<uint32> jointsIslandIndex(allocator, nbJointsComponents);
+    jointsIslandIndex.addWithoutInit(nbJointsComponents);
+    for (uint32 j=0; j < nbJointsComponents; j++) {
+        jointsIslandIndex[j] = getConstraintIslandIndex(mJointsComponents.mBody1Entities[j], mJointsComponents.mBody2Entities[j]);
+    }
 
-                const Entity body1Entity = mJointsComponents.mBody1Entities[jointComponentIndex];
-                const Entity body2Entity = mJointsComponents.mBody2Entities[jointComponentIndex];
-                const Entity otherBodyEntity = body1Entity == bodyToVisitEntity ? body2Entity : body1Entity;
+    // Count the bodies, contact pairs, contact manifolds and joints of each island
+    Array<uint32> nbBodies(allocator, nbIslands);
+    Array<uint32> nbPairs(allocator, nbIslands);
+    Array<uint32> nbManifolds(allocator, nbIslands);
+    Array<uint32> nbJoints(allocator, nbIslands);
+    for (uint32 i=0; i < nbIslands; i++) {
+        nbBodies.add(0);
+        nbPairs.add(0);
+        nbManifolds.add(0);
+        nbJoints.add(0);
+    }
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        const uint32 islandIndex = getBodyIslandIndex(b);
+        mRigidBodyComponents.mIsAlreadyInIsland[b] = islandIndex != INVALID_INDEX;
+        if (islandIndex != INVALID_INDEX) nbBodies[islandIndex]++;
+    }
+    for (uint32 p=0; p < nbContactPairs; p++) {
+        const uint32 islandIndex = contactPairsIslandIndex[p];
+        if (islandIndex != INVALID_INDEX) {
+            assert(contactPairs[p].nbPotentialContactManifolds > 0);
+            nbPairs[islandIndex]++;
+            nbManifolds[islandIndex] += contactPairs[p].nbPotentialContactManifolds;
+        }
+    }
+    for (uint32 j=0; j < nbJointsComponents; j++) {
+        const uint32 islandIndex = jointsIslandIndex[j];
+        mJointsComponents.mIsAlreadyInIsland[j] = islandIndex != INVALID_INDEX;
+        if (islandIndex != INVALID_INDEX) nbJoints[islandIndex]++;
+    }
 
-                const uint32 otherBodyIndex = mRigidBodyComponents.getEntityIndex(otherBodyEntity);
+    // Create the islands. The counters now become the insertion position of the next item of each island
+    uint32 nbTotalBodies = 0;
+    uint32 nbTotalPairs = 0;
+    uint32 nbTotalManifolds = 0;
+    uint32 nbTotalJoints = 0;
+    for (uint32 i=0; i < nbIslands; i++) {
 
-                // Check if the other body has already been added to the island
-                if (mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex]) continue;
+        mIslands.addIsland(nbTotalManifolds);
+        mIslands.nbContactManifolds[i] = nbManifolds[i];
+        mIslands.startBodyEntitiesIndex[i] = nbTotalBodies;
+        mIslands.nbBodiesInIsland[i] = nbBodies[i];
+        mIslands.startJointEntitiesIndex[i] = nbTotalJoints;
+        mIslands.nbJointsInIsland[i] = nbJoints[i];
+
+        nbTotalManifolds += nbManifolds[i];
+
+        const uint32 nbIslandBodies = nbBodies[i];
+        const uint32 nbIslandPairs = nbPairs[i];
+        const uint32 nbIslandJoints = nbJoints[i];
+        nbBodies[i] = nbTotalBodies;
+        nbPairs[i] = nbTotalPairs;
+        nbJoints[i] = nbTotalJoints;
+        nbTotalBodies += nbIslandBodies;
+        nbTotalPairs += nbIslandPairs;
+        nbTotalJoints += nbIslandJoints;
+    }
 
-                // Insert the other body into the stack of bodies to visit
-                bodyEntitiesToVisit.push(otherBodyEntity);
-                mRigidBodyComponents.mIsAlreadyInIsland[otherBodyIndex] = true;
+    // Scatter the bodies, contact pairs and joints into their islands
+    mIslands.bodyEntities.addWithoutInit(nbTotalBodies);
+    mProcessContactPairsOrderIslands.addWithoutInit(nbTotalPairs);
+    mIslands.jointEntities.addWithoutInit(nbTotalJoints);
+    Array<Entity> bodiesToAwake(allocator);
+    for (uint32 b=0; b < nbRigidBodyComponents; b++) {
+        if (mRigidBodyComponents.mIsAlreadyInIsland[b]) {
+            mIslands.bodyEntities[nbBodies[getBodyIslandIndex(b)]++] = mRigidBodyComponents.mBodiesEntities[b];
+            if (b >= nbEnabledRigidBodyComponents) {
+                bodiesToAwake.add(mRigidBodyComponents.mBodiesEntities[b]);
             }
         }
-
-        // Reset the isAlreadyIsland variable of the static bodies so that they
-        // can also be included in the other islands
-        const uint32 nbStaticBodiesAddedToIsland = static_cast<uint32>(staticBodiesAddedToIsland.size());
-        for (uint32 j=0; j < nbStaticBodiesAddedToIsland; j++) {
-
-            assert(mRigidBodyComponents.getBodyType(staticBodiesAddedToIsland[j]) == BodyType::STATIC);
-            mRigidBodyComponents.setIsAlreadyInIsland(staticBodiesAddedToIsland[j], false);
+    }
+    for (uint32 p=0; p < nbContactPairs; p++) {
+        const uint32 islandIndex = contactPairsIslandIndex[p];
+        if (islandIndex != INVALID_INDEX) {
+            mProcessContactPairsOrderIslands[nbPairs[islandIndex]++] = p;
+        }
+    }
+    for (uint32 j=0; j < nbJointsComponents; j++) {
+        const uint32 islandIndex = jointsIslandIndex[j];
+        if (islandIndex != INVALID_INDEX) {
+            mIslands.jointEntities[nbJoints[islandIndex]++] = mJointsComponents.mJointEntities[j];
         }
-
-        staticBodiesAddedToIsland.clear();
     }
 
-    // Clear the contacts pairs that have been associated to rigid bodies
-    for (uint32 i=0; i < mCollisionDetection.mCurrentContactPairs->size(); i++) {
-       const ContactPair& pair = (*mCollisionDetection.mCurrentContactPairs)[i];
-
-       mRigidBodyComponents.removeAllContacPairs(pair.body1Entity);
-       mRigidBodyComponents.removeAllContacPairs(pair.body2Entity);
+    // Awake the sleeping bodies of the islands. This is done at the end because
+    // it changes the indices of the bodies in the mRigidBodyComponents array
+    const uint32 nbBodiesToAwake = static_cast<uint32>(bodiesToAwake.size());
+    for (uint32 i=0; i < nbBodiesToAwake; i++) {
+        mRigidBodyComponents.getRigidBody(bodiesToAwake[i])->setIsSleeping(false);
     }
 }
 
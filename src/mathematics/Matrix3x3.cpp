@@ -37,6 +37,25 @@ Matrix3x3 Matrix3x3::getInverse(decimal determinant) const {
 
     decimal invDeterminant = decimal(1.0) / determinant;
 
+#ifdef IS_RP3D_SIMD_ENABLED
+
+    // The columns of the inverse matrix are the cross products of the rows of the matrix
+    const SimdVector row0 = SimdVector::load3(&mRows[0].x);
+    const SimdVector row1 = SimdVector::load3(&mRows[1].x);
+    const SimdVector row2 = SimdVector::load3(&mRows[2].x);
+    const SimdVector invDeterminantVector(invDeterminant);
+
+    decimal columns[3][4];
+    (invDeterminantVector * SimdVector::cross(row1, row2)).store(columns[0]);
+    (invDeterminantVector * SimdVector::cross(row2, row0)).store(columns[1]);
+    (invDeterminantVector * SimdVector::cross(row0, row1)).store(columns[2]);
+
+    return Matrix3x3(columns[0][0], columns[1][0], columns[2][0],
+                     columns[0][1], columns[1][1], columns[2][1],
+                     columns[0][2], columns[1][2], columns[2][2]);
+
+#else
+
     Matrix3x3 tempMatrix((mRows[1][1]*mRows[2][2]-mRows[2][1]*mRows[1][2]),
                          -(mRows[0][1]*mRows[2][2]-mRows[2][1]*mRows[0][2]),
                          (mRows[0][1]*mRows[1][2]-mRows[0][2]*mRows[1][1]),
@@ -49,4 +68,6 @@ Matrix3x3 Matrix3x3::getInverse(decimal determinant) const {
 
     // Return the inverse matrix
     return (invDeterminant * tempMatrix);
+
+#endif
 }
@@ -0,0 +1,325 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/memory/ConcurrentPoolAllocator.h>
+#include <cassert>
+#include <new>
+
+using namespace reactphysics3d;
+
+// A free memory unit must fit into the smallest memory unit
+static_assert(2 * sizeof(void*) <= GLOBAL_ALIGNMENT, "A free memory unit must fit into the smallest memory unit");
+
+// Constructor
+ConcurrentPoolAllocator::ConcurrentPoolAllocator(MemoryAllocator& baseAllocator)
+                        : mBaseAllocator(baseAllocator), mMemoryBlocks(nullptr) {
+
+    for (int i=0; i < NB_HEAPS; i++) {
+        mFreeBatches[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    for (uint32 i=0; i < NB_THREAD_CACHES; i++) {
+        mThreadCaches[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+#ifndef NDEBUG
+    mNbTimesAllocateMethodCalled.store(0, std::memory_order_relaxed);
+#endif
+}
+
+// Destructor
+/// No other thread must use the allocator anymore when it is destroyed
+ConcurrentPoolAllocator::~ConcurrentPoolAllocator() {
+
+    // Release the memory blocks
+    MemoryBlock* block = mMemoryBlocks.load(std::memory_order_acquire);
+    while (block != nullptr) {
+        MemoryBlock* nextBlock = block->nextBlock;
+        mBaseAllocator.release(block->memory, BLOCK_SIZE);
+        mBaseAllocator.release(block, sizeof(MemoryBlock));
+        block = nextBlock;
+    }
+
+    // Release the thread caches
+    for (uint32 i=0; i < NB_THREAD_CACHES; i++) {
+        ThreadCache* cache = mThreadCaches[i].load(std::memory_order_acquire);
+        if (cache != nullptr) {
+            cache->~ThreadCache();
+            mBaseAllocator.release(cache, sizeof(ThreadCache));
+        }
+    }
+
+#ifndef NDEBUG
+    // Check that the allocate() and release() methods have been called the same
+    // number of times to avoid memory leaks.
+    assert(mNbTimesAllocateMethodCalled.load(std::memory_order_relaxed) == 0);
+#endif
+}
+
+// Allocate memory of a given size (in bytes) and return a pointer to the
+// allocated memory.
+void* ConcurrentPoolAllocator::allocate(size_t size) {
+
+    assert(size > 0);
+
+    // We cannot allocate zero bytes
+    if (size == 0) return nullptr;
+
+#ifndef NDEBUG
+    mNbTimesAllocateMethodCalled.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    // If we need to allocate more than the maximum memory unit size
+    if (size > MAX_UNIT_SIZE) {
+
+        // Allocate memory using the base allocator
+        void* allocatedMemory = mBaseAllocator.allocate(size);
+
+        // Check that allocated memory is 16-bytes aligned
+        assert(reinterpret_cast<uintptr_t>(allocatedMemory) % GLOBAL_ALIGNMENT == 0);
+
+        return allocatedMemory;
+    }
+
+    const int heapIndex = getHeapIndex(size);
+    assert(heapIndex >= 0 && heapIndex < NB_HEAPS);
+
+    MemoryUnit* unit;
+
+    ThreadCache* cache = acquireThreadCache();
+    if (cache != nullptr) {
+
+        // If the cache of the thread does not have free units anymore, we refill it
+        if (cache->freeUnits[heapIndex] == nullptr) {
+
+            uint32 nbUnits;
+            MemoryUnit* units = popBatch(heapIndex, nbUnits);
+            if (units == nullptr) {
+                units = allocateMemoryBlock(heapIndex, nbUnits);
+            }
+
+            cache->freeUnits[heapIndex] = units;
+            cache->nbFreeUnits[heapIndex] = nbUnits;
+        }
+
+        unit = cache->freeUnits[heapIndex];
+        cache->freeUnits[heapIndex] = unit->nextUnit;
+        cache->nbFreeUnits[heapIndex]--;
+
+        releaseThreadCache(cache);
+    }
+    else {  // If the cache is used by another thread, we directly use the global list
+
+        uint32 nbUnits;
+        unit = popBatch(heapIndex, nbUnits);
+        if (unit == nullptr) {
+            unit = allocateMemoryBlock(heapIndex, nbUnits);
+        }
+
+        // Put the remaining units of the batch back into the global list
+        if (unit->nextUnit != nullptr) {
+            pushBatches(heapIndex, unit->nextUnit, unit->nextUnit);
+        }
+    }
+
+    void* allocatedMemory = static_cast<void*>(unit);
+
+    // Check that allocated memory is 16-bytes aligned
+    assert(reinterpret_cast<uintptr_t>(allocatedMemory) % GLOBAL_ALIGNMENT == 0);
+
+    return allocatedMemory;
+}
+
+// Release previously allocated memory.
+void ConcurrentPoolAllocator::release(void* pointer, size_t size) {
+
+    assert(size > 0);
+
+    // Cannot release a 0-byte allocated memory
+    if (size == 0) return;
+
+#ifndef NDEBUG
+    mNbTimesAllocateMethodCalled.fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+    // If the size is larger than the maximum memory unit size
+    if (size > MAX_UNIT_SIZE) {
+
+        // Release the memory using the base allocator
+        mBaseAllocator.release(pointer, size);
+        return;
+    }
+
+    const int heapIndex = getHeapIndex(size);
+    assert(heapIndex >= 0 && heapIndex < NB_HEAPS);
+
+    MemoryUnit* releasedUnit = static_cast<MemoryUnit*>(pointer);
+
+    ThreadCache* cache = acquireThreadCache();
+    if (cache != nullptr) {
+
+        // Insert the released unit into the cache of the thread
+        releasedUnit->nextUnit = cache->freeUnits[heapIndex];
+        cache->freeUnits[heapIndex] = releasedUnit;
+        cache->nbFreeUnits[heapIndex]++;
+
+        // If the cache contains too many free units, we send a batch back to the global list
+        if (cache->nbFreeUnits[heapIndex] >= 2 * BATCH_SIZE) {
+
+            MemoryUnit* firstUnit = cache->freeUnits[heapIndex];
+            MemoryUnit* lastUnit = firstUnit;
+            for (uint32 i=1; i < BATCH_SIZE; i++) {
+                lastUnit = lastUnit->nextUnit;
+            }
+
+            cache->freeUnits[heapIndex] = lastUnit->nextUnit;
+            cache->nbFreeUnits[heapIndex] -= BATCH_SIZE;
+            lastUnit->nextUnit = nullptr;
+
+            pushBatches(heapIndex, firstUnit, firstUnit);
+        }
+
+        releaseThreadCache(cache);
+    }
+    else {  // If the cache is used by another thread, we directly use the global list
+
+        releasedUnit->nextUnit = nullptr;
+        pushBatches(heapIndex, releasedUnit, releasedUnit);
+    }
+}
+
+// Return the index of the calling thread
+uint32 ConcurrentPoolAllocator::getThreadIndex() {
+
+    static std::atomic<uint32> nbThreads(0);
+    thread_local const uint32 threadIndex = nbThreads.fetch_add(1, std::memory_order_relaxed);
+
+    return threadIndex;
+}
+
+// Try to take the cache of the calling thread (return nullptr if it is used by another thread)
+/// Many threads can be mapped to the same cache. In this case, this method does not wait
+/// and the threads that cannot take the cache will use the global lists instead.
+ConcurrentPoolAllocator::ThreadCache* ConcurrentPoolAllocator::acquireThreadCache() {
+
+    std::atomic<ThreadCache*>& cacheSlot = mThreadCaches[getThreadIndex() % NB_THREAD_CACHES];
+
+    ThreadCache* cache = cacheSlot.load(std::memory_order_acquire);
+
+    // If the cache has not been created yet
+    if (cache == nullptr) {
+
+        ThreadCache* newCache = new (mBaseAllocator.allocate(sizeof(ThreadCache))) ThreadCache();
+
+        // If another thread has created the cache in the meantime, we use its cache
+        if (cacheSlot.compare_exchange_strong(cache, newCache, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            cache = newCache;
+        }
+        else {
+            newCache->~ThreadCache();
+            mBaseAllocator.release(newCache, sizeof(ThreadCache));
+        }
+    }
+
+    if (cache->isUsed.test_and_set(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    return cache;
+}
+
+// Make a thread cache available again
+void ConcurrentPoolAllocator::releaseThreadCache(ThreadCache* cache) {
+    cache->isUsed.clear(std::memory_order_release);
+}
+
+// Take a batch of free memory units from the global list of a heap
+/// The whole global list is taken with a single atomic exchange (so that a batch cannot be
+/// taken by two threads), the first batch is kept and the other ones are put back into the list.
+ConcurrentPoolAllocator::MemoryUnit* ConcurrentPoolAllocator::popBatch(int heapIndex, uint32& nbUnits) {
+
+    nbUnits = 0;
+
+    if (mFreeBatches[heapIndex].load(std::memory_order_relaxed) == nullptr) return nullptr;
+
+    MemoryUnit* batch = mFreeBatches[heapIndex].exchange(nullptr, std::memory_order_acquire);
+    if (batch == nullptr) return nullptr;
+
+    // Put the other batches back into the global list
+    MemoryUnit* otherBatches = batch->nextBatch;
+    if (otherBatches != nullptr) {
+
+        MemoryUnit* lastBatch = otherBatches;
+        while (lastBatch->nextBatch != nullptr) {
+            lastBatch = lastBatch->nextBatch;
+        }
+
+        pushBatches(heapIndex, otherBatches, lastBatch);
+    }
+
+    // Compute the number of units in the batch
+    for (MemoryUnit* unit = batch; unit != nullptr; unit = unit->nextUnit) {
+        nbUnits++;
+    }
+
+    return batch;
+}
+
+// Add a linked list of batches of free memory units into the global list of a heap
+void ConcurrentPoolAllocator::pushBatches(int heapIndex, MemoryUnit* firstBatch, MemoryUnit* lastBatch) {
+
+    MemoryUnit* head = mFreeBatches[heapIndex].load(std::memory_order_relaxed);
+    do {
+        lastBatch->nextBatch = head;
+    }
+    while (!mFreeBatches[heapIndex].compare_exchange_weak(head, firstBatch, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Allocate a new memory block and return its linked list of memory units
+ConcurrentPoolAllocator::MemoryUnit* ConcurrentPoolAllocator::allocateMemoryBlock(int heapIndex, uint32& nbUnits) {
+
+    MemoryBlock* block = static_cast<MemoryBlock*>(mBaseAllocator.allocate(sizeof(MemoryBlock)));
+    block->memory = mBaseAllocator.allocate(BLOCK_SIZE);
+    assert(block->memory != nullptr);
+
+    // Add the block into the list of allocated blocks
+    block->nextBlock = mMemoryBlocks.load(std::memory_order_relaxed);
+    while (!mMemoryBlocks.compare_exchange_weak(block->nextBlock, block, std::memory_order_release, std::memory_order_relaxed));
+
+    // Divide the block into memory units
+    const size_t unitSize = (heapIndex + 1) * MIN_UNIT_SIZE;
+    nbUnits = static_cast<uint32>(BLOCK_SIZE / unitSize);
+    assert(nbUnits * unitSize <= BLOCK_SIZE);
+    char* memoryUnitsStart = static_cast<char*>(block->memory);
+    for (uint32 i=0; i < nbUnits - 1; i++) {
+        MemoryUnit* unit = reinterpret_cast<MemoryUnit*>(memoryUnitsStart + unitSize * i);
+        unit->nextUnit = reinterpret_cast<MemoryUnit*>(memoryUnitsStart + unitSize * (i+1));
+    }
+    MemoryUnit* lastUnit = reinterpret_cast<MemoryUnit*>(memoryUnitsStart + unitSize * (nbUnits - 1));
+    lastUnit->nextUnit = nullptr;
+
+    return reinterpret_cast<MemoryUnit*>(memoryUnitsStart);
+}
@@ -29,10 +29,76 @@
 using namespace reactphysics3d;
 
 // Constructor
-MemoryManager::MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory) :
+/**
+ * @param baseAllocator Pointer to a user custom memory allocator (the default allocator is used if nullptr)
+ * @param initAllocatedMemory Initial size (in bytes) of the memory allocated by the heap allocator
+ * @param useConcurrentPoolAllocator True if the pool memory must be allocated with the ConcurrentPoolAllocator
+ *                                   (per-thread caches without locks) instead of the PoolAllocator
+ */
+MemoryManager::MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory, bool useConcurrentPoolAllocator) :
                mBaseAllocator(baseAllocator == nullptr ? &mDefaultAllocator : baseAllocator),
                mHeapAllocator(*mBaseAllocator, initAllocatedMemory),
-               mPoolAllocator(mHeapAllocator),
-               mSingleFrameAllocator(mHeapAllocator) {
+               mPoolAllocator(mHeapAllocator), mConcurrentPoolAllocator(mHeapAllocator),
+               mIsConcurrentPoolAllocatorUsed(useConcurrentPoolAllocator),
+               mSingleFrameAllocator(mHeapAllocator), mFreeScratchAllocators(mHeapAllocator),
+               mWorkersFrameAllocators(mHeapAllocator) {
 
 }
+
+// Destructor
+MemoryManager::~MemoryManager() {
+
+    // Destroy the scratch allocators (they must all have been released)
+    for (uint64 i=0; i < mFreeScratchAllocators.size(); i++) {
+        mFreeScratchAllocators[i]->~SingleFrameAllocator();
+        mHeapAllocator.release(mFreeScratchAllocators[i], sizeof(SingleFrameAllocator));
+    }
+
+    // Destroy the workers frame allocators
+    for (uint64 i=0; i < mWorkersFrameAllocators.size(); i++) {
+        mWorkersFrameAllocators[i]->~SingleFrameAllocator();
+        mHeapAllocator.release(mWorkersFrameAllocators[i], sizeof(SingleFrameAllocator));
+    }
+}
+
+// Make sure that there is a frame allocator for each worker of a task scheduler
+/// This method must be called before the parallel stage that uses the workers frame allocators
+/// (it is not thread-safe). The memory block of a worker allocator starts small and is then
+/// adapted to the memory used by the worker in the previous frames.
+void MemoryManager::reserveWorkersFrameAllocators(uint32 nbWorkers) {
+
+    while (mWorkersFrameAllocators.size() < nbWorkers) {
+        mWorkersFrameAllocators.add(new (mHeapAllocator.allocate(sizeof(SingleFrameAllocator)))
+                                        SingleFrameAllocator(mHeapAllocator, false, INIT_WORKER_FRAME_ALLOCATOR_NB_BYTES));
+    }
+}
+
+// Return a scratch allocator that will only be used by the calling thread until it is released
+/// A new scratch allocator is created if all the existing ones are currently used by other threads.
+/// Since the memory of a scratch allocator is only used by a single thread, the allocations do
+/// not wait for the other threads.
+SingleFrameAllocator& MemoryManager::acquireScratchAllocator() {
+
+    {
+        std::lock_guard<std::mutex> lock(mScratchAllocatorsMutex);
+
+        if (mFreeScratchAllocators.size() > 0) {
+
+            SingleFrameAllocator* allocator = mFreeScratchAllocators[mFreeScratchAllocators.size() - 1];
+            mFreeScratchAllocators.removeAt(mFreeScratchAllocators.size() - 1);
+            return *allocator;
+        }
+    }
+
+    return *(new (mHeapAllocator.allocate(sizeof(SingleFrameAllocator))) SingleFrameAllocator(mHeapAllocator, false));
+}
+
+// Reset a scratch allocator and make it available to the other threads
+/// All the memory allocated with the scratch allocator must have been released before
+void MemoryManager::releaseScratchAllocator(SingleFrameAllocator& allocator) {
+
+    allocator.reset();
+
+    std::lock_guard<std::mutex> lock(mScratchAllocatorsMutex);
+    mFreeScratchAllocators.add(&allocator);
+}
@@ -28,13 +28,19 @@
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <cstdlib>
 #include <cassert>
+#include <algorithm>
 
 using namespace reactphysics3d;
 
 // Constructor
-SingleFrameAllocator::SingleFrameAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator),
-                                           mTotalSizeBytes(INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES),
-                                           mCurrentOffset(0), mNeedToAllocatedMore(false) {
+/**
+ * @param baseAllocator Allocator used for the memory block and for the allocations that do not fit in it
+ * @param isThreadSafe True if the allocator can be used by several threads at the same time
+ * @param initSizeBytes Initial (and minimum) size (in bytes) of the memory block
+ */
+SingleFrameAllocator::SingleFrameAllocator(MemoryAllocator& baseAllocator, bool isThreadSafe, size_t initSizeBytes)
+                     : mIsThreadSafe(isThreadSafe), mBaseAllocator(baseAllocator), mInitSizeBytes(initSizeBytes),
+                       mTotalSizeBytes(initSizeBytes), mCurrentOffset(0), mNbOverflowBytes(0), mNbUnderusedFrames(0) {
 
     // Allocate a whole block of memory at the beginning
     void* allocatedMemory = mBaseAllocator.allocate(mTotalSizeBytes);
@@ -58,8 +64,11 @@ SingleFrameAllocator::~SingleFrameAllocator() {
 // allocated memory. Allocated memory must be 16-bytes aligned.
 void* SingleFrameAllocator::allocate(size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
+    // Lock the method with a mutex (if the allocator is shared between threads)
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (mIsThreadSafe) {
+        lock.lock();
+    }
 
     // Allocate a little bit more memory to make sure we can return an aligned address
     const size_t totalSize = size + GLOBAL_ALIGNMENT;
@@ -67,8 +76,8 @@ void* SingleFrameAllocator::allocate(size_t size) {
     // Check that there is enough remaining memory in the buffer
     if (mCurrentOffset + totalSize > mTotalSizeBytes) {
 
-        // We need to allocate more memory next time reset() is called
-       mNeedToAllocatedMore = true;
+       // Keep track of the memory that did not fit in the block to resize it in the next reset() call
+       mNbOverflowBytes += totalSize;
 
        // Return default memory allocation
        return mBaseAllocator.allocate(size);
@@ -91,11 +100,9 @@ void* SingleFrameAllocator::allocate(size_t size) {
 }
 
 // Release previously allocated memory.
+/// This method does not modify the state of the allocator and can therefore be called from any thread
 void SingleFrameAllocator::release(void* pointer, size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
     // If allocated memory is not within the single frame allocation range
     char* p = static_cast<char*>(pointer);
     if (p < mMemoryBufferStart || p > mMemoryBufferStart + mTotalSizeBytes) {
@@ -106,27 +113,59 @@ void SingleFrameAllocator::release(void* pointer, size_t size) {
 }
 
 // Reset the marker of the current allocated memory
+/// If the memory allocated during the frame (high-water mark) did not fit in the block, the block is
+/// replaced by one that is large enough. If only a small part of the block has been used during many
+/// consecutive frames, the block is shrunk.
 void SingleFrameAllocator::reset() {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
+    // Lock the method with a mutex (if the allocator is shared between threads)
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (mIsThreadSafe) {
+        lock.lock();
+    }
+
+    const size_t highWaterMark = mCurrentOffset + mNbOverflowBytes;
 
     // If we need to allocate more memory
-    if (mNeedToAllocatedMore) {
+    if (highWaterMark > mTotalSizeBytes) {
 
-        // Release the memory allocated at the beginning
-        mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+        // Grow the block by powers of two until it contains the memory of the previous frame
+        size_t newSizeBytes = mTotalSizeBytes * 2;
+        while (newSizeBytes < highWaterMark) {
+            newSizeBytes *= 2;
+        }
 
-        // Multiply the total memory to allocate by two
-        mTotalSizeBytes *= 2;
+        resizeMemoryBlock(newSizeBytes);
+        mNbUnderusedFrames = 0;
+    }
+    else if (mTotalSizeBytes > mInitSizeBytes && highWaterMark < mTotalSizeBytes / 4) {
 
-        // Allocate a whole block of memory at the beginning
-        mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-        assert(mMemoryBufferStart != nullptr);
+        mNbUnderusedFrames++;
 
-        mNeedToAllocatedMore = false;
+        // If the block has been underused for a long time, we divide its size by two
+        if (mNbUnderusedFrames >= NB_FRAMES_BEFORE_SHRINK) {
+            resizeMemoryBlock(std::max(mTotalSizeBytes / 2, mInitSizeBytes));
+            mNbUnderusedFrames = 0;
+        }
+    }
+    else {
+        mNbUnderusedFrames = 0;
     }
 
     // Reset the current offset at the beginning of the block
     mCurrentOffset = 0;
+    mNbOverflowBytes = 0;
+}
+
+// Replace the memory block by a new one with a given size
+void SingleFrameAllocator::resizeMemoryBlock(size_t newSizeBytes) {
+
+    // Release the memory allocated at the beginning
+    mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+
+    mTotalSizeBytes = newSizeBytes;
+
+    // Allocate a whole block of memory at the beginning
+    mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
+    assert(mMemoryBufferStart != nullptr);
 }
@@ -30,6 +30,8 @@
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/utils/TaskScheduler.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -38,6 +40,8 @@ using namespace reactphysics3d;
 BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection, ColliderComponents& collidersComponents,
                                    TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents)
                     :mDynamicAABBTree(collisionDetection.getMemoryManager().getHeapAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mWideAABBTree(collisionDetection.getMemoryManager().getHeapAllocator(), mDynamicAABBTree),
+                     mIsWideAABBTreeEnabled(false), mIsWideAABBTreeUpToDate(false),
                      mCollidersComponents(collidersComponents), mTransformsComponents(transformComponents),
                      mRigidBodyComponents(rigidBodyComponents), mMovedShapes(collisionDetection.getMemoryManager().getHeapAllocator()),
                      mCollisionDetection(collisionDetection) {
@@ -67,6 +71,8 @@ bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 sha
 }
 
 // Ray casting method
+/// The wide AABB tree is only used if it has been built from the current state of the dynamic AABB
+/// tree (the colliders have not been added, removed or moved since the last broad-phase computation).
 void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const {
 
     RP3D_PROFILE("BroadPhaseSystem::raycast()", mProfiler);
@@ -77,7 +83,25 @@ void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest, unsigne
     const Vector3 rayDirection = ray.point2 - ray.point1;
     const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
 
-    mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback);
+    if (mIsWideAABBTreeEnabled && mIsWideAABBTreeUpToDate) {
+        mWideAABBTree.raycast(ray, broadPhaseRaycastCallback, raycastTest.allocator);
+    }
+    else {
+        mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback, raycastTest.allocator);
+    }
+}
+
+// Ray casting method for a packet of rays of a batched raycast
+/// The rays of the packet traverse the dynamic AABB tree together (the wide AABB tree is only
+/// used for single rays). The hit of each ray is written in the array of hits.
+void BroadPhaseSystem::raycastPacket(const Ray* rays, uint32 raysMask, RaycastHit* hits, RaycastBatchMode mode,
+                                     unsigned short raycastWithCategoryMaskBits, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::raycastPacket()", mProfiler);
+
+    BroadPhaseRaycastPacketCallback broadPhaseRaycastCallback(mDynamicAABBTree, raycastWithCategoryMaskBits, rays, hits, mode, allocator);
+
+    mDynamicAABBTree.raycastPacket(rays, raysMask, broadPhaseRaycastCallback, allocator);
 }
 
 // Add a collider into the broad-phase collision detection
@@ -87,6 +111,7 @@ void BroadPhaseSystem::addCollider(Collider* collider, const AABB& aabb) {
 
     // Add the collision shape into the dynamic AABB tree and get its broad-phase ID
     int nodeId = mDynamicAABBTree.addObject(aabb, collider);
+    mIsWideAABBTreeUpToDate = false;
 
     // Set the broad-phase ID of the collider
     mCollidersComponents.setBroadPhaseId(collider->getEntity(), nodeId);
@@ -107,6 +132,7 @@ void BroadPhaseSystem::removeCollider(Collider* collider) {
 
     // Remove the collision shape from the dynamic AABB tree
     mDynamicAABBTree.removeObject(broadPhaseID);
+    mIsWideAABBTreeUpToDate = false;
 
     // Remove the collision shape into the array of shapes that have moved (or have been created)
     // during the last simulation step
@@ -126,14 +152,77 @@ void BroadPhaseSystem::updateCollider(Entity colliderEntity) {
 }
 
 // Update the broad-phase state of all the enabled colliders
-void BroadPhaseSystem::updateColliders() {
+/// The new world-space AABBs of the colliders are computed in parallel and each chunk only records
+/// the colliders whose AABB is not inside their fat AABB anymore (or whose shape size has changed).
+/// Those colliders are then reinserted into the dynamic AABB tree sequentially in the order of the
+/// chunks. Therefore, the tree does not depend on the number of workers.
+void BroadPhaseSystem::updateColliders(MemoryManager& memoryManager, TaskScheduler& taskScheduler) {
 
     RP3D_PROFILE("BroadPhaseSystem::updateColliders()", mProfiler);
 
-    // Update all the enabled collider components
-    if (mCollidersComponents.getNbEnabledComponents() > 0) {
-        updateCollidersComponents(0, mCollidersComponents.getNbEnabledComponents());
+    const uint32 nbEnabledColliders = mCollidersComponents.getNbEnabledComponents();
+    if (nbEnabledColliders == 0) return;
+
+    // Memory for the array of colliders to reinsert (index of the component and new AABB) of each chunk. The arrays
+    // are created by the tasks with the frame allocator of their worker such that they grow without locking
+    const uint32 nbChunks = TaskScheduler::computeNbChunks(nbEnabledColliders, PARALLEL_FOR_CHUNK_SIZE);
+    memoryManager.reserveWorkersFrameAllocators(taskScheduler.getNbWorkers());
+    MemoryAllocator& allocator = memoryManager.getSingleFrameAllocator();
+    Array<Pair<uint32, AABB>>* chunksCollidersToReinsert = static_cast<Array<Pair<uint32, AABB>>*>(
+                                                               allocator.allocate(nbChunks * sizeof(Array<Pair<uint32, AABB>>)));
+
+    auto computeChunkAABBs = [&](const TaskScheduler::TaskRange& range) {
+
+        Array<Pair<uint32, AABB>>& collidersToReinsert = *(new (chunksCollidersToReinsert + range.chunkIndex)
+                                                           Array<Pair<uint32, AABB>>(memoryManager.getWorkerFrameAllocator(range.workerIndex)));
+
+        for (uint32 i = range.startIndex; i < range.endIndex; i++) {
+
+            const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[i];
+            if (broadPhaseId != -1) {
+
+                const Entity& bodyEntity = mCollidersComponents.mBodiesEntities[i];
+                const Transform& transform = mTransformsComponents.getTransform(bodyEntity);
+
+                // Recompute the world-space AABB of the collision shape
+                const AABB aabb = mCollidersComponents.mCollisionShapes[i]->computeTransformedAABB(transform * mCollidersComponents.mLocalToBodyTransforms[i]);
+
+                // If the size of the collision shape has been changed by the user (the broad-phase AABB
+                // needs to be reset to its new size) or if the AABB is outside of the fat AABB
+                if (mCollidersComponents.mHasCollisionShapeChangedSize[i] || !mDynamicAABBTree.getFatAABB(broadPhaseId).contains(aabb)) {
+                    collidersToReinsert.add(Pair<uint32, AABB>(i, aabb));
+                }
+
+                mCollidersComponents.mHasCollisionShapeChangedSize[i] = false;
+            }
+        }
+    };
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    // The AABB computations are profiled and the profiler is not thread-safe
+    for (uint32 c=0; c < nbChunks; c++) {
+        const uint32 startIndex = c * PARALLEL_FOR_CHUNK_SIZE;
+        computeChunkAABBs(TaskScheduler::TaskRange{c, startIndex, std::min(startIndex + PARALLEL_FOR_CHUNK_SIZE, nbEnabledColliders), 0});
+    }
+
+#else
+
+    taskScheduler.parallelFor(nbEnabledColliders, PARALLEL_FOR_CHUNK_SIZE, computeChunkAABBs);
+
+#endif
+
+    // Reinsert the colliders that have moved out of their fat AABB into the tree
+    for (uint32 c=0; c < nbChunks; c++) {
+        for (uint32 i=0; i < chunksCollidersToReinsert[c].size(); i++) {
+
+            const uint32 index = chunksCollidersToReinsert[c][i].first;
+            updateColliderInternal(mCollidersComponents.mBroadPhaseIds[index], mCollidersComponents.mColliders[index],
+                                   chunksCollidersToReinsert[c][i].second, true);
+        }
+        chunksCollidersToReinsert[c].~Array<Pair<uint32, AABB>>();
     }
+    allocator.release(chunksCollidersToReinsert, nbChunks * sizeof(Array<Pair<uint32, AABB>>));
 }
 
 // Notify the broad-phase that a collision shape has moved and need to be updated
@@ -149,6 +238,8 @@ void BroadPhaseSystem::updateColliderInternal(int32 broadPhaseId, Collider* coll
     // into the tree).
     if (hasBeenReInserted) {
 
+        mIsWideAABBTreeUpToDate = false;
+
         // Add the collision shape into the array of shapes that have moved (or have been created)
         // during the last simulation step
         addMovedCollider(broadPhaseId, collider);
@@ -203,15 +294,93 @@ void BroadPhaseSystem::addMovedCollider(int broadPhaseID, Collider* collider) {
 }
 
 // Compute all the overlapping pairs of collision shapes
-void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes) {
+/// The colliders that have moved are split into chunks that are tested against the tree in
+/// parallel. Each chunk writes its overlapping nodes into its own array and the arrays are
+/// merged in the order of the chunks. A pair of moved colliders is reported by the queries of both
+/// colliders and only the first occurrence is kept (same as the sequential order). Therefore,
+/// the result does not depend on the number of workers. If the wide AABB tree is enabled, it is
+/// built again here if the dynamic AABB tree has changed since the last broad-phase computation.
+void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, TaskScheduler& taskScheduler,
+                                               Array<Pair<int32, int32>>& overlappingNodes) {
 
     RP3D_PROFILE("BroadPhaseSystem::computeOverlappingPairs()", mProfiler);
 
+    if (mIsWideAABBTreeEnabled && !mIsWideAABBTreeUpToDate) {
+        mWideAABBTree.build();
+        mIsWideAABBTreeUpToDate = true;
+    }
+
     // Get the array of the colliders that have moved or have been created in the last frame
     Array<int> shapesToTest = mMovedShapes.toArray(memoryManager.getHeapAllocator());
+    const uint32 nbShapesToTest = static_cast<uint32>(shapesToTest.size());
 
-    // Ask the dynamic AABB tree to report all collision shapes that overlap with the shapes to test
-    mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, 0, static_cast<uint32>(shapesToTest.size()), overlappingNodes);
+    // For each node of the tree, index of the node in the array of moved shapes (or -1 if it has not moved)
+    const int32 nbNodes = mDynamicAABBTree.getNbAllocatedNodes();
+    Array<int32> movedShapesIndex(memoryManager.getSingleFrameAllocator(), nbNodes);
+    for (int32 i=0; i < nbNodes; i++) {
+        movedShapesIndex.add(-1);
+    }
+    for (uint32 i=0; i < nbShapesToTest; i++) {
+        movedShapesIndex[shapesToTest[i]] = static_cast<int32>(i);
+    }
+
+    // Memory for the array of overlapping nodes of each chunk. The arrays are created by the tasks
+    // with the frame allocator of their worker such that they grow without locking
+    const uint32 nbChunks = TaskScheduler::computeNbChunks(nbShapesToTest, BROAD_PHASE_CHUNK_SIZE);
+    memoryManager.reserveWorkersFrameAllocators(taskScheduler.getNbWorkers());
+    MemoryAllocator& allocator = memoryManager.getSingleFrameAllocator();
+    Array<Pair<int32, int32>>* chunksOverlappingNodes = static_cast<Array<Pair<int32, int32>>*>(
+                                                            allocator.allocate(nbChunks * sizeof(Array<Pair<int32, int32>>)));
+
+    auto testChunk = [&](const TaskScheduler::TaskRange& range) {
+
+        Array<Pair<int32, int32>>& chunkOverlappingNodes = *(new (chunksOverlappingNodes + range.chunkIndex)
+                                                             Array<Pair<int32, int32>>(memoryManager.getWorkerFrameAllocator(range.workerIndex)));
+
+        // Ask the tree to report all collision shapes that overlap with the shapes to test
+        if (mIsWideAABBTreeEnabled) {
+            mWideAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, range.startIndex, range.endIndex, chunkOverlappingNodes);
+        }
+        else {
+            mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, range.startIndex, range.endIndex, chunkOverlappingNodes);
+        }
+
+        // Remove the pairs of a node with itself and the pairs already reported by a previous moved shape
+        uint32 nbKeptPairs = 0;
+        for (uint32 i=0; i < chunkOverlappingNodes.size(); i++) {
+
+            const Pair<int32, int32>& nodePair = chunkOverlappingNodes[i];
+            const int32 otherShapeIndex = movedShapesIndex[nodePair.second];
+            if (otherShapeIndex == -1 || otherShapeIndex > movedShapesIndex[nodePair.first]) {
+                chunkOverlappingNodes[nbKeptPairs] = nodePair;
+                nbKeptPairs++;
+            }
+        }
+        while (chunkOverlappingNodes.size() > nbKeptPairs) {
+            chunkOverlappingNodes.removeAt(chunkOverlappingNodes.size() - 1);
+        }
+    };
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    // The tree queries are profiled and the profiler is not thread-safe
+    for (uint32 c=0; c < nbChunks; c++) {
+        const uint32 startIndex = c * BROAD_PHASE_CHUNK_SIZE;
+        testChunk(TaskScheduler::TaskRange{c, startIndex, std::min(startIndex + BROAD_PHASE_CHUNK_SIZE, nbShapesToTest), 0});
+    }
+
+#else
+
+    taskScheduler.parallelFor(nbShapesToTest, BROAD_PHASE_CHUNK_SIZE, testChunk);
+
+#endif
+
+    // Merge the overlapping nodes of the chunks
+    for (uint32 c=0; c < nbChunks; c++) {
+        overlappingNodes.addRange(chunksOverlappingNodes[c]);
+        chunksOverlappingNodes[c].~Array<Pair<int32, int32>>();
+    }
+    allocator.release(chunksOverlappingNodes, nbChunks * sizeof(Array<Pair<int32, int32>>));
 
     // Reset the array of collision shapes that have move (or have been created) during the
     // last simulation step
@@ -243,3 +412,52 @@ decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ra
 
     return hitFraction;
 }
+
+// Called for a broad-phase shape that has to be tested by some rays of the packet
+/// The hit of a ray is kept if it is closer than its previous hit and the maximum fraction of the ray is
+/// reduced to the hit fraction. In the FIRST_HIT mode, the rays that hit the collider must stop.
+uint32 BroadPhaseRaycastPacketCallback::raycastBroadPhaseShape(int32 nodeId, uint32 raysMask, decimal* raysMaxFractions) {
+
+    // Get the collider from the node
+    Collider* collider = static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
+
+    // Check if the raycast filtering mask allows raycast against this shape and if world query is enabled for this collider
+    if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) == 0 || !collider->getIsWorldQueryCollider()) {
+        return 0;
+    }
+
+    // Clip the rays with their current maximum fraction
+    Ray rays[SimdDecimal::NB_LANES];
+    for (uint32 i=0; raysMask >> i != 0; i++) {
+        if ((raysMask & (1u << i)) != 0) {
+            rays[i] = Ray(mRays[i].point1, mRays[i].point2, raysMaxFractions[i]);
+        }
+    }
+
+    // Ray casting test of the rays against the collider
+    RaycastInfo raycastInfos[SimdDecimal::NB_LANES];
+    const uint32 hitRaysMask = collider->raycastPacket(rays, raysMask, raycastInfos, mAllocator);
+
+    uint32 stoppedRaysMask = 0;
+    for (uint32 i=0; hitRaysMask >> i != 0; i++) {
+
+        if ((hitRaysMask & (1u << i)) == 0 || raycastInfos[i].hitFraction > raysMaxFractions[i]) continue;
+
+        RaycastHit& hit = mHits[i];
+        hit.worldPoint = raycastInfos[i].worldPoint;
+        hit.worldNormal = raycastInfos[i].worldNormal;
+        hit.hitFraction = raycastInfos[i].hitFraction;
+        hit.triangleIndex = raycastInfos[i].triangleIndex;
+        hit.body = raycastInfos[i].body;
+        hit.collider = raycastInfos[i].collider;
+
+        raysMaxFractions[i] = raycastInfos[i].hitFraction;
+
+        // A ray stops at its first hit or if the hit cannot get any closer
+        if (mMode == RaycastBatchMode::FIRST_HIT || raycastInfos[i].hitFraction == decimal(0.0)) {
+            stoppedRaysMask |= (1u << i);
+        }
+    }
+
+    return stoppedRaysMask;
+}
@@ -25,6 +25,7 @@
 
 // Libraries
 #include <reactphysics3d/systems/CollisionDetectionSystem.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
 #include <reactphysics3d/collision/OverlapCallback.h>
 #include <reactphysics3d/collision/shapes/BoxShape.h>
@@ -38,6 +39,7 @@
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/TaskScheduler.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/containers/Pair.h>
@@ -48,9 +50,6 @@
 using namespace reactphysics3d;
 using namespace std;
 
-// TriangleShape allocated size
-const size_t CollisionDetectionSystem::mTriangleShapeAllocatedSize = std::ceil(sizeof(TriangleShape) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
-
 // Constructor
 CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, ColliderComponents& collidersComponents,  TransformComponents& transformComponents,
                                                    BodyComponents& bodyComponents, RigidBodyComponents& rigidBodyComponents,
@@ -71,7 +70,8 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
                      mPreviousContactManifolds(&mContactManifolds1), mCurrentContactManifolds(&mContactManifolds2),
                      mContactPoints1(mMemoryManager.getPoolAllocator()), mContactPoints2(mMemoryManager.getPoolAllocator()),
                      mPreviousContactPoints(&mContactPoints1), mCurrentContactPoints(&mContactPoints2),
-                     mNbPreviousPotentialContactManifolds(0), mNbPreviousPotentialContactPoints(0), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
+                     mNbPreviousPotentialContactManifolds(0), mNbPreviousPotentialContactPoints(0), mIsInConcurrentQueriesMode(false),
+                     mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -99,6 +99,31 @@ void CollisionDetectionSystem::computeCollisionDetection() {
     computeNarrowPhase();
 }
 
+// Enter the mode where the world queries can be called concurrently
+/// The broad-phase is computed once here so that the queries only need to read the overlapping pairs
+void CollisionDetectionSystem::beginConcurrentQueries() {
+
+    assert(!mIsInConcurrentQueriesMode);
+
+    // Compute the broad-phase collision detection
+    computeBroadPhase();
+
+    mIsInConcurrentQueriesMode = true;
+}
+
+// Leave the mode where the world queries can be called concurrently
+void CollisionDetectionSystem::endConcurrentQueries() {
+
+    assert(mIsInConcurrentQueriesMode);
+
+    mIsInConcurrentQueriesMode = false;
+}
+
+// Update all the enabled colliders
+void CollisionDetectionSystem::updateColliders() {
+    mBroadPhaseSystem.updateColliders(mMemoryManager, mWorld->mTaskScheduler);
+}
+
 // Compute the broad-phase collision detection
 void CollisionDetectionSystem::computeBroadPhase() {
 
@@ -109,7 +134,7 @@ void CollisionDetectionSystem::computeBroadPhase() {
     // Ask the broad-phase to compute all the shapes overlapping with the shapes that
     // have moved or have been added in the last frame. This call can only add new
     // overlapping pairs in the collision detection.
-    mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, mBroadPhaseOverlappingNodes);
+    mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, mWorld->mTaskScheduler, mBroadPhaseOverlappingNodes);
 
     // Create new overlapping pairs if necessary
     updateOverlappingPairs(mBroadPhaseOverlappingNodes);
@@ -343,6 +368,10 @@ void CollisionDetectionSystem::updateOverlappingPairs(const Array<Pair<int32, in
 }
 
 // Compute the middle-phase collision detection
+/// When the task scheduler has several workers, the convex and concave overlapping pairs are split
+/// into chunks that are processed in parallel. Each chunk fills its own narrow-phase input and the
+/// inputs are then appended to the narrow-phase input in parameter in the order of the chunks. Therefore,
+/// the narrow-phase tests are in the same order as with a single worker.
 void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseInput, bool needToReportContacts, bool isWorldQuery) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeMiddlePhase()", mProfiler);
@@ -353,11 +382,76 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
     // Remove the obsolete last frame collision infos and mark all the others as obsolete
     mOverlappingPairs.clearObsoleteLastFrameCollisionInfos();
 
+    const uint64 nbConvexPairs = mOverlappingPairs.mConvexPairs.size();
+    const uint64 nbConcavePairs = mOverlappingPairs.mConcavePairs.size();
+
+    const uint32 nbConvexChunks = TaskScheduler::computeNbChunks(static_cast<uint32>(nbConvexPairs), MIDDLE_PHASE_CONVEX_PAIRS_CHUNK_SIZE);
+    const uint32 nbConcaveChunks = TaskScheduler::computeNbChunks(static_cast<uint32>(nbConcavePairs), MIDDLE_PHASE_CONCAVE_PAIRS_CHUNK_SIZE);
+    const uint32 nbChunks = nbConvexChunks + nbConcaveChunks;
+
+    // The profiler is not thread-safe and therefore the middle-phase is not parallel when profiling is enabled
+#ifndef IS_RP3D_PROFILING_ENABLED
+
+    if (mWorld->mTaskScheduler.getNbWorkers() > 1 && nbChunks > 1) {
+
+        MemoryAllocator& allocator = mMemoryManager.getSingleFrameAllocator();
+
+        // Each worker allocates the narrow-phase inputs of its chunks from its own frame allocator (without locking)
+        mMemoryManager.reserveWorkersFrameAllocators(mWorld->mTaskScheduler.getNbWorkers());
+
+        // Memory for the narrow-phase input of each chunk (the inputs are created by the tasks)
+        NarrowPhaseInput* chunksNarrowPhaseInputs = static_cast<NarrowPhaseInput*>(allocator.allocate(nbChunks * sizeof(NarrowPhaseInput)));
+
+        mWorld->mTaskScheduler.parallelFor(nbChunks, 1, [&](const TaskScheduler::TaskRange& range) {
+
+            MemoryAllocator& workerAllocator = mMemoryManager.getWorkerFrameAllocator(range.workerIndex);
+
+            for (uint32 c=range.startIndex; c < range.endIndex; c++) {
+
+                new (chunksNarrowPhaseInputs + c) NarrowPhaseInput(workerAllocator, mOverlappingPairs);
+
+                if (c < nbConvexChunks) {
+                    const uint64 startPairIndex = uint64(c) * MIDDLE_PHASE_CONVEX_PAIRS_CHUNK_SIZE;
+                    computeConvexPairsMiddlePhase(startPairIndex, std::min(uint64(MIDDLE_PHASE_CONVEX_PAIRS_CHUNK_SIZE), nbConvexPairs - startPairIndex),
+                                                  chunksNarrowPhaseInputs[c], needToReportContacts, isWorldQuery);
+                }
+                else {
+                    const uint64 startPairIndex = uint64(c - nbConvexChunks) * MIDDLE_PHASE_CONCAVE_PAIRS_CHUNK_SIZE;
+                    computeConcavePairsMiddlePhase(startPairIndex, std::min(uint64(MIDDLE_PHASE_CONCAVE_PAIRS_CHUNK_SIZE), nbConcavePairs - startPairIndex),
+                                                   chunksNarrowPhaseInputs[c], workerAllocator, needToReportContacts, isWorldQuery);
+                }
+            }
+        });
+
+        // Append the narrow-phase tests of the chunks
+        for (uint32 c=0; c < nbChunks; c++) {
+            narrowPhaseInput.addNarrowPhaseInput(chunksNarrowPhaseInputs[c]);
+            chunksNarrowPhaseInputs[c].~NarrowPhaseInput();
+        }
+        allocator.release(chunksNarrowPhaseInputs, nbChunks * sizeof(NarrowPhaseInput));
+
+        return;
+    }
+
+#endif
+
+    computeConvexPairsMiddlePhase(0, nbConvexPairs, narrowPhaseInput, needToReportContacts, isWorldQuery);
+    computeConcavePairsMiddlePhase(0, nbConcavePairs, narrowPhaseInput, mMemoryManager.getSingleFrameAllocator(), needToReportContacts, isWorldQuery);
+}
+
+// Compute the middle-phase collision detection for a range of convex vs convex overlapping pairs
+/// This method can be called from a worker thread of the task scheduler
+void CollisionDetectionSystem::computeConvexPairsMiddlePhase(uint64 startPairIndex, uint64 nbPairs, NarrowPhaseInput& narrowPhaseInput,
+                                                             bool needToReportContacts, bool isWorldQuery) {
+
     const uint32 nbEnabledColliderComponents = mCollidersComponents.getNbEnabledComponents();
 
-    // For each possible convex vs convex pair of bodies
-    const uint64 nbConvexVsConvexPairs = mOverlappingPairs.mConvexPairs.size();
-    for (uint64 i=0; i < nbConvexVsConvexPairs; i++) {
+    // The contact points of the pairs can only be reused during the update of the world
+    const bool isTemporalCoherenceEnabled = mWorld->mConfig.isNarrowPhaseTemporalCoherenceEnabled && !isWorldQuery;
+    const decimal cosHalfAngleThreshold = std::cos(decimal(0.5) * mWorld->mConfig.temporalCoherenceAngleThreshold);
+
+    // For each convex vs convex pair of bodies in the range
+    for (uint64 i=startPairIndex; i < startPairIndex + nbPairs; i++) {
 
         OverlappingPairs::ConvexOverlappingPair& overlappingPair = mOverlappingPairs.mConvexPairs[i];
 
@@ -401,20 +495,97 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
 
                 const bool reportContacts = needToReportContacts && !isCollider1Trigger && !isCollider2Trigger;
 
+                if (isTemporalCoherenceEnabled && reportContacts) {
+
+                    // If the two colliders have almost not moved relative to each other, we reuse the contact points
+                    // of the last narrow-phase test instead of testing the pair again (the cached contact points of the
+                    // pair have been removed if the collision shape of a collider has been resized)
+                    if (addCachedContactPoints(overlappingPair, collisionShape1, collisionShape2,
+                                               mCollidersComponents.mLocalToWorldTransforms[collider1Index],
+                                               mCollidersComponents.mLocalToWorldTransforms[collider2Index],
+                                               cosHalfAngleThreshold, narrowPhaseInput)) {
+                        continue;
+                    }
+
+                    // The contact points will be cached again after the narrow-phase test of the pair
+                    overlappingPair.nbCachedContactPoints = 0;
+                }
+
                 // No middle-phase is necessary, simply create a narrow phase info
                 // for the narrow-phase collision detection
                 narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                                     mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                                     mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                                    algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo,
-                                                    mMemoryManager.getSingleFrameAllocator());
+                                                    algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo);
             }
         }
     }
+}
 
-    // For each possible convex vs concave pair of bodies
-    const uint64 nbConcavePairs = mOverlappingPairs.mConcavePairs.size();
-    for (uint64 i=0; i < nbConcavePairs; i++) {
+// Add the cached contact points of a convex pair that has almost not moved since its last narrow-phase test
+/// The contact points are re-projected with the current transforms of the colliders (their local points do not
+/// change but the normal and the penetration depth are computed again). The method returns false if the pair
+/// has to be tested by the narrow-phase (no cached contact points, too much relative motion or a contact point
+/// that is not penetrating anymore). This method can be called from a worker thread of the task scheduler.
+bool CollisionDetectionSystem::addCachedContactPoints(OverlappingPairs::ConvexOverlappingPair& overlappingPair, CollisionShape* shape1,
+                                                      CollisionShape* shape2, const Transform& shape1ToWorldTransform,
+                                                      const Transform& shape2ToWorldTransform, decimal cosHalfAngleThreshold,
+                                                      NarrowPhaseInput& narrowPhaseInput) const {
+
+    const uint8 nbContactPoints = overlappingPair.nbCachedContactPoints;
+    if (nbContactPoints == 0) {
+        return false;
+    }
+
+    // Compute the relative motion of the two colliders since the last narrow-phase test
+    const Transform relativeTransform = shape1ToWorldTransform.getInverse() * shape2ToWorldTransform;
+    const Vector3 relativeTranslation = relativeTransform.getPosition() - overlappingPair.cachedRelativeTransform.getPosition();
+    const decimal distanceThreshold = mWorld->mConfig.temporalCoherenceDistanceThreshold;
+    if (relativeTranslation.lengthSquare() > distanceThreshold * distanceThreshold) {
+        return false;
+    }
+    const Quaternion relativeRotation = overlappingPair.cachedRelativeTransform.getOrientation().getInverse() * relativeTransform.getOrientation();
+    if (std::abs(relativeRotation.w) < cosHalfAngleThreshold) {
+        return false;
+    }
+
+    // Re-project the cached contact points with the current transforms
+    Vector3 normals[OverlappingPairs::ConvexOverlappingPair::NB_MAX_CACHED_CONTACT_POINTS];
+    decimal penetrationDepths[OverlappingPairs::ConvexOverlappingPair::NB_MAX_CACHED_CONTACT_POINTS];
+    for (uint8 i=0; i < nbContactPoints; i++) {
+
+        const ContactPointInfo& contactPoint = overlappingPair.cachedContactPoints[i];
+        normals[i] = shape1ToWorldTransform.getOrientation() * contactPoint.normal;
+        penetrationDepths[i] = (shape1ToWorldTransform * contactPoint.localPoint1 - shape2ToWorldTransform * contactPoint.localPoint2).dot(normals[i]);
+
+        // If a contact point is not penetrating anymore, the pair has to be tested again
+        if (penetrationDepths[i] <= decimal(0.0)) {
+            return false;
+        }
+    }
+
+    NarrowPhaseInfoBatch& batch = narrowPhaseInput.getCachedContactsBatch();
+    const uint32 batchIndex = batch.getNbObjects();
+    batch.addNarrowPhaseInfo(overlappingPair.pairID, overlappingPair.collider1, overlappingPair.collider2, shape1, shape2,
+                             shape1ToWorldTransform, shape2ToWorldTransform, true, &overlappingPair.lastFrameCollisionInfo);
+    batch.isColliding[batchIndex] = true;
+    for (uint8 i=0; i < nbContactPoints; i++) {
+        const ContactPointInfo& contactPoint = overlappingPair.cachedContactPoints[i];
+        batch.addContactPoint(batchIndex, normals[i], penetrationDepths[i], contactPoint.localPoint1, contactPoint.localPoint2);
+    }
+
+    return true;
+}
+
+// Compute the middle-phase collision detection for a range of convex vs concave overlapping pairs
+/// This method can be called from a worker thread of the task scheduler
+void CollisionDetectionSystem::computeConcavePairsMiddlePhase(uint64 startPairIndex, uint64 nbPairs, NarrowPhaseInput& narrowPhaseInput,
+                                                              MemoryAllocator& shapeAllocator, bool needToReportContacts, bool isWorldQuery) {
+
+    const uint32 nbEnabledColliderComponents = mCollidersComponents.getNbEnabledComponents();
+
+    // For each convex vs concave pair of bodies in the range
+    for (uint64 i=startPairIndex; i < startPairIndex + nbPairs; i++) {
 
         OverlappingPairs::ConcaveOverlappingPair& overlappingPair = mOverlappingPairs.mConcavePairs[i];
 
@@ -451,7 +622,7 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
             // If it is not a world query, we make sure that the two bodies are enabled
             if (isWorldQuery || (!isWorldQuery && (isBody1Enabled || isBody2Enabled))) {
 
-                computeConvexVsConcaveMiddlePhase(overlappingPair, mMemoryManager.getSingleFrameAllocator(), narrowPhaseInput, needToReportContacts);
+                computeConvexVsConcaveMiddlePhase(overlappingPair, shapeAllocator, narrowPhaseInput, needToReportContacts);
 
             }
         }
@@ -459,8 +630,10 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
 }
 
 // Compute the middle-phase collision detection
+/// In the concurrent queries mode, the last frame collision infos of the pairs are not modified
 void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>& convexPairs, Array<uint64>& concavePairs,
-                                                                   NarrowPhaseInput& narrowPhaseInput, bool reportContacts) {
+                                                                   NarrowPhaseInput& narrowPhaseInput, bool reportContacts,
+                                                                   MemoryAllocator& allocator) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeMiddlePhase()", mProfiler);
 
@@ -468,7 +641,9 @@ void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>
     narrowPhaseInput.reserveMemory();
 
     // Remove the obsolete last frame collision infos and mark all the others as obsolete
-    mOverlappingPairs.clearObsoleteLastFrameCollisionInfos();
+    if (!mIsInConcurrentQueriesMode) {
+        mOverlappingPairs.clearObsoleteLastFrameCollisionInfos();
+    }
 
     // For each possible convex vs convex pair of bodies
     const uint64 nbConvexPairs = convexPairs.size();
@@ -499,7 +674,7 @@ void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>
         narrowPhaseInput.addNarrowPhaseTest(pairId, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                                   mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                                   mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo, mMemoryManager.getSingleFrameAllocator());
+                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo);
 
     }
 
@@ -514,7 +689,7 @@ void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>
         assert(mCollidersComponents.getBroadPhaseId(mOverlappingPairs.mConcavePairs[pairIndex].collider2) != -1);
         assert(mCollidersComponents.getBroadPhaseId(mOverlappingPairs.mConcavePairs[pairIndex].collider1) != mCollidersComponents.getBroadPhaseId(mOverlappingPairs.mConcavePairs[pairIndex].collider2));
 
-        computeConvexVsConcaveMiddlePhase(mOverlappingPairs.mConcavePairs[pairIndex], mMemoryManager.getSingleFrameAllocator(), narrowPhaseInput, reportContacts);
+        computeConvexVsConcaveMiddlePhase(mOverlappingPairs.mConcavePairs[pairIndex], allocator, narrowPhaseInput, reportContacts);
     }
 }
 
@@ -570,104 +745,253 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
     const bool isCollider2Trigger = mCollidersComponents.mIsTrigger[collider2Index];
     reportContacts = reportContacts && !isCollider1Trigger && !isCollider2Trigger;
 
-    CollisionShape* shape1 = nullptr;
-    CollisionShape* shape2 = nullptr;
+    const uint32 nbTriangles = static_cast<uint32>(shapeIds.size());
+    if (nbTriangles == 0) {
+        return;
+    }
 
-    if (overlappingPair.isShape1Convex) {
-        shape1 = convexShape;
+    // Copy the overlapping triangles into a single memory block owned by the narrow-phase batch (the triangle
+    // shapes are only created on the stack while the triangles are tested during the narrow-phase)
+    NarrowPhaseInfoBatch& batch = narrowPhaseInput.getConvexVsTriangleBatch(overlappingPair.narrowPhaseAlgorithmType);
+    NarrowPhaseTriangle* triangles = batch.allocateTriangles(nbTriangles, allocator);
+    for (uint32 i=0; i < nbTriangles; i++) {
+
+        for (uint32 v=0; v < 3; v++) {
+            triangles[i].vertices[v] = triangleVertices[i * 3 + v];
+            triangles[i].verticesNormals[v] = triangleVerticesNormals[i * 3 + v];
+        }
+        triangles[i].id = shapeIds[i];
+    }
+
+    // Get the collision infos of the triangles (added to the overlapping pair if not present yet). In the
+    // concurrent queries mode, the pair must not be modified and an info might therefore be missing (nullptr)
+    LastFrameCollisionInfo** lastFrameInfos = static_cast<LastFrameCollisionInfo**>(allocator.allocate(nbTriangles * sizeof(LastFrameCollisionInfo*)));
+    if (mIsInConcurrentQueriesMode) {
+        for (uint32 i=0; i < nbTriangles; i++) {
+            lastFrameInfos[i] = overlappingPair.getLastFrameInfo(shapeIds[i]);
+        }
     }
     else {
-        shape2 = convexShape;
+        overlappingPair.addLastFrameInfosIfNecessary(&(shapeIds[0]), nbTriangles, lastFrameInfos);
+    }
+
+    // Create a narrow phase info for each triangle for the narrow-phase collision detection
+    for (uint32 i=0; i < nbTriangles; i++) {
+        batch.addTriangleNarrowPhaseInfo(overlappingPair.pairID, collider1, collider2, convexShape, &(triangles[i]),
+                                         overlappingPair.isShape1Convex, shape1LocalToWorldTransform, shape2LocalToWorldTransform,
+                                         reportContacts, lastFrameInfos[i]);
     }
 
-    // For each overlapping triangle
-    const uint32 nbShapeIds = static_cast<uint32>(shapeIds.size());
-    for (uint32 i=0; i < nbShapeIds; i++) {
+    allocator.release(lastFrameInfos, nbTriangles * sizeof(LastFrameCollisionInfo*));
+}
 
-        // Create a triangle collision shape (the allocated memory for the TriangleShape will be released in the
-        // destructor of the corresponding NarrowPhaseInfo.
-        TriangleShape* triangleShape = new (allocator.allocate(mTriangleShapeAllocatedSize))
-                                       TriangleShape(&(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), shapeIds[i], mTriangleHalfEdgeStructure, allocator);
+// Execute the narrow-phase collision detection algorithm on batches
+/// The batches are split into chunks that are tested in parallel by the task scheduler. The
+/// contact points of each narrow-phase info are stored in the info itself and are processed
+/// afterwards in the order of the batches. Therefore, the results do not depend on the number
+/// of workers. In the concurrent queries mode, the chunks are tested on the calling thread.
+bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput,
+                                                        bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator) {
 
-    #ifdef IS_RP3D_PROFILING_ENABLED
+    const uint32 nbBatches = 8;
 
+    // Get the narrow-phase batches to test for collision for contacts
+    NarrowPhaseInfoBatch* batches[nbBatches] = {&narrowPhaseInput.getSphereVsSphereBatch(), &narrowPhaseInput.getSphereVsCapsuleBatch(),
+                                                &narrowPhaseInput.getCapsuleVsCapsuleBatch(), &narrowPhaseInput.getSphereVsConvexPolyhedronBatch(),
+                                                &narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch(),
+                                                &narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch(), &narrowPhaseInput.getBoxVsBoxBatch(),
+                                                &narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronGJKBatch()};
+    const NarrowPhaseAlgorithmType algorithmTypes[nbBatches] = {NarrowPhaseAlgorithmType::SphereVsSphere, NarrowPhaseAlgorithmType::SphereVsCapsule,
+                                                                NarrowPhaseAlgorithmType::CapsuleVsCapsule, NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron,
+                                                                NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron,
+                                                                NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron, NarrowPhaseAlgorithmType::BoxVsBox,
+                                                                NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronGJK};
 
-        // Set the profiler to the triangle shape
-        triangleShape->setProfiler(mProfiler);
+    // Compute the index of the first chunk of each batch
+    uint32 batchesStartChunk[nbBatches + 1];
+    batchesStartChunk[0] = 0;
+    for (uint32 b=0; b < nbBatches; b++) {
+        batchesStartChunk[b + 1] = batchesStartChunk[b] + TaskScheduler::computeNbChunks(batches[b]->getNbObjects(), NARROW_PHASE_CHUNK_SIZE);
+    }
+    const uint32 nbChunks = batchesStartChunk[nbBatches];
 
-    #endif
+    // Result of the collision tests of each chunk
+    Array<bool> isChunkColliding(allocator, nbChunks);
+    for (uint32 c=0; c < nbChunks; c++) {
+        isChunkColliding.add(false);
+    }
 
-        if (overlappingPair.isShape1Convex) {
-            shape2 = triangleShape;
-        }
-        else {
-            shape1 = triangleShape;
+    auto testChunk = [&](uint32 chunkIndex, MemoryAllocator& chunkAllocator) {
+
+        // Find the batch of the chunk
+        uint32 b = 0;
+        while (chunkIndex >= batchesStartChunk[b + 1]) {
+            b++;
         }
 
-        // Add a collision info for the two collision shapes into the overlapping pair (if not present yet)
-        LastFrameCollisionInfo* lastFrameInfo = overlappingPair.addLastFrameInfoIfNecessary(shape1->getId(), shape2->getId());
+        const uint32 batchStartIndex = (chunkIndex - batchesStartChunk[b]) * NARROW_PHASE_CHUNK_SIZE;
+        const uint32 batchNbItems = std::min(NARROW_PHASE_CHUNK_SIZE, batches[b]->getNbObjects() - batchStartIndex);
 
-        // Create a narrow phase info for the narrow-phase collision detection
-        narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
-                                            shape1LocalToWorldTransform, shape2LocalToWorldTransform,
-                                            overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo, allocator);
-    }
-}
+        isChunkColliding[chunkIndex] = testNarrowPhaseCollision(algorithmTypes[b], *(batches[b]), batchStartIndex, batchNbItems,
+                                                                clipWithPreviousAxisIfStillColliding, chunkAllocator);
+    };
 
-// Execute the narrow-phase collision detection algorithm on batches
-bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput,
-                                                        bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator) {
+#ifdef IS_RP3D_PROFILING_ENABLED
 
-    bool contactFound = false;
+    // The narrow-phase algorithms use the profiler which is not thread-safe. Therefore, the chunks are
+    // tested on the current thread when the profiling is enabled
+    for (uint32 c=0; c < nbChunks; c++) {
+        testChunk(c, allocator);
+    }
 
-    // Get the narrow-phase collision detection algorithms for each kind of collision shapes
-    SphereVsSphereAlgorithm* sphereVsSphereAlgo = mCollisionDispatch.getSphereVsSphereAlgorithm();
-    SphereVsCapsuleAlgorithm* sphereVsCapsuleAlgo = mCollisionDispatch.getSphereVsCapsuleAlgorithm();
-    CapsuleVsCapsuleAlgorithm* capsuleVsCapsuleAlgo = mCollisionDispatch.getCapsuleVsCapsuleAlgorithm();
-    SphereVsConvexPolyhedronAlgorithm* sphereVsConvexPolyAlgo = mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm();
-    CapsuleVsConvexPolyhedronAlgorithm* capsuleVsConvexPolyAlgo = mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm();
-    ConvexPolyhedronVsConvexPolyhedronAlgorithm* convexPolyVsConvexPolyAlgo = mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm();
+#else
 
-    // get the narrow-phase batches to test for collision for contacts
-    NarrowPhaseInfoBatch& sphereVsSphereBatchContacts = narrowPhaseInput.getSphereVsSphereBatch();
-    NarrowPhaseInfoBatch& sphereVsCapsuleBatchContacts = narrowPhaseInput.getSphereVsCapsuleBatch();
-    NarrowPhaseInfoBatch& capsuleVsCapsuleBatchContacts = narrowPhaseInput.getCapsuleVsCapsuleBatch();
-    NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatchContacts = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
-    NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatchContacts = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
-    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatchContacts = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
+    if (mIsInConcurrentQueriesMode) {
 
-    // Compute the narrow-phase collision detection for each kind of collision shapes (for contacts)
-    if (sphereVsSphereBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsSphereAlgo->testCollision(sphereVsSphereBatchContacts, 0, sphereVsSphereBatchContacts.getNbObjects(), allocator);
+        for (uint32 c=0; c < nbChunks; c++) {
+            testChunk(c, allocator);
+        }
     }
-    if (sphereVsCapsuleBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsCapsuleAlgo->testCollision(sphereVsCapsuleBatchContacts, 0, sphereVsCapsuleBatchContacts.getNbObjects(), allocator);
+    else {
+
+        // Each worker allocates the temporary memory of its chunks from its own frame allocator (without locking)
+        mMemoryManager.reserveWorkersFrameAllocators(mWorld->mTaskScheduler.getNbWorkers());
+
+        mWorld->mTaskScheduler.parallelFor(nbChunks, 1, [&](const TaskScheduler::TaskRange& range) {
+
+            MemoryAllocator& workerAllocator = mMemoryManager.getWorkerFrameAllocator(range.workerIndex);
+
+            for (uint32 c=range.startIndex; c < range.endIndex; c++) {
+                testChunk(c, workerAllocator);
+            }
+        });
     }
-    if (capsuleVsCapsuleBatchContacts.getNbObjects() > 0) {
-        contactFound |= capsuleVsCapsuleAlgo->testCollision(capsuleVsCapsuleBatchContacts, 0, capsuleVsCapsuleBatchContacts.getNbObjects(), allocator);
+
+#endif
+
+    bool contactFound = false;
+    for (uint32 c=0; c < nbChunks; c++) {
+        contactFound |= isChunkColliding[c];
     }
-    if (sphereVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsConvexPolyAlgo->testCollision(sphereVsConvexPolyhedronBatchContacts, 0, sphereVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+
+    return contactFound;
+}
+
+// Execute the narrow-phase collision detection algorithm on a range of items of a batch
+/// The triangles of the convex vs concave pairs are stored in the batch without collision shape. A
+/// triangle shape is therefore created on the stack for each triangle of a sub-range of items and is
+/// destroyed once the sub-range has been tested. This method can be called from a worker thread of
+/// the task scheduler.
+bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseAlgorithmType algorithmType, NarrowPhaseInfoBatch& batch, uint32 batchStartIndex,
+                                                        uint32 batchNbItems, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator) {
+
+    if (batch.getNbTriangleObjects() == 0) {
+        return testNarrowPhaseAlgorithm(algorithmType, batch, batchStartIndex, batchNbItems, clipWithPreviousAxisIfStillColliding, allocator);
     }
-    if (capsuleVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= capsuleVsConvexPolyAlgo->testCollision(capsuleVsConvexPolyhedronBatchContacts, 0, capsuleVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+
+    // Memory for the triangle shapes of a sub-range
+    alignas(TriangleShape) unsigned char triangleShapesMemory[NARROW_PHASE_TRIANGLES_SUB_RANGE_SIZE * sizeof(TriangleShape)];
+    TriangleShape* triangleShapes = reinterpret_cast<TriangleShape*>(triangleShapesMemory);
+
+    bool isColliding = false;
+
+    const uint32 batchEndIndex = batchStartIndex + batchNbItems;
+    for (uint32 subRangeStartIndex = batchStartIndex; subRangeStartIndex < batchEndIndex; subRangeStartIndex += NARROW_PHASE_TRIANGLES_SUB_RANGE_SIZE) {
+
+        const uint32 subRangeNbItems = std::min(NARROW_PHASE_TRIANGLES_SUB_RANGE_SIZE, batchEndIndex - subRangeStartIndex);
+
+        // Create the triangle shapes of the sub-range
+        for (uint32 i=0; i < subRangeNbItems; i++) {
+
+            const uint32 batchIndex = subRangeStartIndex + i;
+            const NarrowPhaseTriangle* triangle = batch.triangles[batchIndex];
+            if (triangle != nullptr) {
+
+                TriangleShape* triangleShape = new (triangleShapes + i) TriangleShape(triangle->vertices, triangle->verticesNormals, triangle->id,
+                                                                                     mTriangleHalfEdgeStructure, allocator);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+                // Set the profiler to the triangle shape
+                triangleShape->setProfiler(mProfiler);
+
+#endif
+
+                if (batch.collisionShapes1[batchIndex] == nullptr) {
+                    batch.collisionShapes1[batchIndex] = triangleShape;
+                }
+                else {
+                    assert(batch.collisionShapes2[batchIndex] == nullptr);
+                    batch.collisionShapes2[batchIndex] = triangleShape;
+                }
+            }
+        }
+
+        isColliding |= testNarrowPhaseAlgorithm(algorithmType, batch, subRangeStartIndex, subRangeNbItems, clipWithPreviousAxisIfStillColliding, allocator);
+
+        // Destroy the triangle shapes of the sub-range
+        for (uint32 i=0; i < subRangeNbItems; i++) {
+
+            const uint32 batchIndex = subRangeStartIndex + i;
+            if (batch.triangles[batchIndex] != nullptr) {
+
+                if (batch.collisionShapes1[batchIndex] == triangleShapes + i) {
+                    batch.collisionShapes1[batchIndex] = nullptr;
+                }
+                else {
+                    batch.collisionShapes2[batchIndex] = nullptr;
+                }
+                triangleShapes[i].~TriangleShape();
+            }
+        }
     }
-    if (convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= convexPolyVsConvexPolyAlgo->testCollision(convexPolyhedronVsConvexPolyhedronBatchContacts, 0, convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+
+    return isColliding;
+}
+
+// Execute a narrow-phase collision detection algorithm on a range of items whose collision shapes are all set
+/// This method can be called from a worker thread of the task scheduler
+bool CollisionDetectionSystem::testNarrowPhaseAlgorithm(NarrowPhaseAlgorithmType algorithmType, NarrowPhaseInfoBatch& batch, uint32 batchStartIndex,
+                                                        uint32 batchNbItems, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator) {
+
+    switch (algorithmType) {
+
+        case NarrowPhaseAlgorithmType::SphereVsSphere:
+            return mCollisionDispatch.getSphereVsSphereAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::SphereVsCapsule:
+            return mCollisionDispatch.getSphereVsCapsuleAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::CapsuleVsCapsule:
+            return mCollisionDispatch.getCapsuleVsCapsuleAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
+            return mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems,
+                                                                                            clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
+            return mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems,
+                                                                                             clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
+            return mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems,
+                                                                                                      clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::BoxVsBox:
+            return mCollisionDispatch.getBoxVsBoxAlgorithm()->testCollision(batch, batchStartIndex, batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedronGJK:
+            return mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm()->testCollisionWithGJKAndEPA(batch, batchStartIndex, batchNbItems,
+                                                                                                                   clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::NoCollisionTest:
+            break;
     }
 
-    return contactFound;
+    return false;
 }
 
 // Process the potential contacts after narrow-phase collision detection
 void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& narrowPhaseInput, bool updateLastFrameInfo,
                                                      Array<ContactPointInfo>& potentialContactPoints,
                                                      Array<ContactManifoldInfo>& potentialContactManifolds,
-                                                     Array<ContactPair>* contactPairs) {
+                                                     Array<ContactPair>* contactPairs, MemoryAllocator& allocator) {
 
     assert(contactPairs->size() == 0);
 
-    Map<uint64, uint> mapPairIdToContactPairIndex(mMemoryManager.getHeapAllocator(), mPreviousMapPairIdToContactPairIndex.size());
+    Map<uint64, uint> mapPairIdToContactPairIndex(allocator, mPreviousMapPairIdToContactPairIndex.size());
 
     // get the narrow-phase batches to test for collision
     NarrowPhaseInfoBatch& sphereVsSphereBatch = narrowPhaseInput.getSphereVsSphereBatch();
@@ -676,6 +1000,9 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
+    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronGJKBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronGJKBatch();
+    NarrowPhaseInfoBatch& cachedContactsBatch = narrowPhaseInput.getCachedContactsBatch();
 
     // Process the potential contacts
     processPotentialContacts(sphereVsSphereBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
@@ -685,6 +1012,10 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
     processPotentialContacts(capsuleVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
     processPotentialContacts(convexPolyhedronVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints,
                              potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(boxVsBoxBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(convexPolyhedronVsConvexPolyhedronGJKBatch, updateLastFrameInfo, potentialContactPoints,
+                             potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
+    processPotentialContacts(cachedContactsBatch, updateLastFrameInfo, potentialContactPoints, potentialContactManifolds, mapPairIdToContactPairIndex, contactPairs);
 }
 
 // Compute the narrow-phase collision detection
@@ -705,29 +1036,72 @@ void CollisionDetectionSystem::computeNarrowPhase() {
 
     // Process all the potential contacts after narrow-phase collision
     processAllPotentialContacts(mNarrowPhaseInput, true, mPotentialContactPoints,
-                                mPotentialContactManifolds, mCurrentContactPairs);
+                                mPotentialContactManifolds, mCurrentContactPairs, mMemoryManager.getHeapAllocator());
 
     // Reduce the number of contact points in the manifolds
     reducePotentialContactManifolds(mCurrentContactPairs, mPotentialContactManifolds, mPotentialContactPoints);
 
-    // Add the contact pairs to the bodies
-    addContactPairsToBodies();
+    // Cache the contact points of the tested pairs for the narrow-phase temporal coherence
+    if (mWorld->mConfig.isNarrowPhaseTemporalCoherenceEnabled) {
+        updateCachedContactPoints();
+    }
 
     assert(mCurrentContactManifolds->size() == 0);
     assert(mCurrentContactPoints->size() == 0);
 }
 
-// Add the contact pairs to the corresponding bodies
-void CollisionDetectionSystem::addContactPairsToBodies() {
+// Cache the contact points of the convex pairs tested during the narrow-phase (temporal coherence)
+/// The reduced contact points of each convex pair that has been tested during this frame are stored
+/// in the pair with the relative transform of the two colliders. The pairs that have reused their cached
+/// contact points are not updated such that the relative motion is always measured since the last test.
+void CollisionDetectionSystem::updateCachedContactPoints() {
+
+    RP3D_PROFILE("CollisionDetectionSystem::updateCachedContactPoints()", mProfiler);
 
     const uint32 nbContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
-    for (uint32 p=0 ; p < nbContactPairs; p++) {
+    for (uint32 i=0; i < nbContactPairs; i++) {
+
+        const ContactPair& contactPair = (*mCurrentContactPairs)[i];
+        if (contactPair.isTrigger) {
+            continue;
+        }
+
+        OverlappingPairs::ConvexOverlappingPair* overlappingPair = mOverlappingPairs.getConvexOverlappingPair(contactPair.pairId);
+
+        // If it is a concave pair or a pair that has reused its cached contact points
+        if (overlappingPair == nullptr || overlappingPair->nbCachedContactPoints > 0) {
+            continue;
+        }
+
+        // Count the contact points of the pair
+        uint32 nbContactPoints = 0;
+        for (uint32 m=0; m < contactPair.nbPotentialContactManifolds; m++) {
+            nbContactPoints += mPotentialContactManifolds[contactPair.potentialContactManifoldsIndices[m]].nbPotentialContactPoints;
+        }
+        if (nbContactPoints > OverlappingPairs::ConvexOverlappingPair::NB_MAX_CACHED_CONTACT_POINTS) {
+            continue;
+        }
+
+        const Transform& shape1ToWorldTransform = mCollidersComponents.getLocalToWorldTransform(contactPair.collider1Entity);
+        const Transform& shape2ToWorldTransform = mCollidersComponents.getLocalToWorldTransform(contactPair.collider2Entity);
+        const Quaternion worldToShape1Orientation = shape1ToWorldTransform.getOrientation().getInverse();
 
-        ContactPair& contactPair = (*mCurrentContactPairs)[p];
+        overlappingPair->cachedRelativeTransform = shape1ToWorldTransform.getInverse() * shape2ToWorldTransform;
 
-        // Add the associated contact pair to both bodies of the pair (used to create islands later)
-        mRigidBodyComponents.addContacPair(contactPair.body1Entity, p);
-        mRigidBodyComponents.addContacPair(contactPair.body2Entity, p);
+        // Store the contact points with the normals in local-space of the first collider
+        uint8 index = 0;
+        for (uint32 m=0; m < contactPair.nbPotentialContactManifolds; m++) {
+
+            const ContactManifoldInfo& manifold = mPotentialContactManifolds[contactPair.potentialContactManifoldsIndices[m]];
+            for (uint32 c=0; c < manifold.nbPotentialContactPoints; c++) {
+
+                const ContactPointInfo& contactPoint = mPotentialContactPoints[manifold.potentialContactPointsIndices[c]];
+                overlappingPair->cachedContactPoints[index] = ContactPointInfo{worldToShape1Orientation * contactPoint.normal, contactPoint.localPoint1,
+                                                                               contactPoint.localPoint2, contactPoint.penetrationDepth};
+                index++;
+            }
+        }
+        overlappingPair->nbCachedContactPoints = index;
     }
 }
 
@@ -743,11 +1117,14 @@ void CollisionDetectionSystem::computeMapPreviousContactPairs() {
 
 // Compute the narrow-phase collision detection for the testOverlap() methods.
 /// This method returns true if contacts are found.
-bool CollisionDetectionSystem::computeNarrowPhaseOverlapSnapshot(NarrowPhaseInput& narrowPhaseInput, OverlapCallback* callback) {
+bool CollisionDetectionSystem::computeNarrowPhaseOverlapSnapshot(NarrowPhaseInput& narrowPhaseInput, OverlapCallback* callback,
+                                                                 MemoryAllocator& allocator) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeNarrowPhaseOverlapSnapshot()", mProfiler);
 
-    MemoryAllocator& allocator = mMemoryManager.getPoolAllocator();
+    // In the concurrent queries mode, the narrow-phase works on private copies of the last frame infos
+    uint32 nbLastFrameInfos = 0;
+    LastFrameCollisionInfo* lastFrameInfos = mIsInConcurrentQueriesMode ? copyLastFrameCollisionInfos(narrowPhaseInput, allocator, nbLastFrameInfos) : nullptr;
 
     // Test the narrow-phase collision detection on the batches to be tested
     bool collisionFound = testNarrowPhaseCollision(narrowPhaseInput, false, allocator);
@@ -756,20 +1133,71 @@ bool CollisionDetectionSystem::computeNarrowPhaseOverlapSnapshot(NarrowPhaseInpu
         // Compute the overlapping colliders
         Array<ContactPair> contactPairs(allocator);
         Array<ContactPair> lostContactPairs(allocator);          // Always empty in this case (snapshot)
-        computeOverlapSnapshotContactPairs(narrowPhaseInput, contactPairs);
+        computeOverlapSnapshotContactPairs(narrowPhaseInput, contactPairs, allocator);
 
         // Report overlapping colliders
         OverlapCallback::CallbackData callbackData(contactPairs, lostContactPairs, false, *mWorld);
         (*callback).onOverlap(callbackData);
     }
 
+    if (lastFrameInfos != nullptr) {
+        allocator.release(lastFrameInfos, nbLastFrameInfos * sizeof(LastFrameCollisionInfo));
+    }
+
     return collisionFound;
 }
 
+// Replace the last frame collision infos of the narrow-phase tests by private copies
+/// This is used by the concurrent queries that cannot modify the last frame infos of the overlapping pairs
+/// because other threads might read them at the same time. A test without any previous info gets a
+/// default one. The returned array of copies must be released with the allocator in parameter.
+LastFrameCollisionInfo* CollisionDetectionSystem::copyLastFrameCollisionInfos(NarrowPhaseInput& narrowPhaseInput, MemoryAllocator& allocator,
+                                                                              uint32& nbInfos) const {
+
+    const uint32 nbBatches = 8;
+    NarrowPhaseInfoBatch* batches[nbBatches] = {&narrowPhaseInput.getSphereVsSphereBatch(), &narrowPhaseInput.getSphereVsCapsuleBatch(),
+                                                &narrowPhaseInput.getCapsuleVsCapsuleBatch(), &narrowPhaseInput.getSphereVsConvexPolyhedronBatch(),
+                                                &narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch(),
+                                                &narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch(), &narrowPhaseInput.getBoxVsBoxBatch(),
+                                                &narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronGJKBatch()};
+
+    nbInfos = 0;
+    for (uint32 b=0; b < nbBatches; b++) {
+        nbInfos += batches[b]->getNbObjects();
+    }
+
+    if (nbInfos == 0) {
+        return nullptr;
+    }
+
+    LastFrameCollisionInfo* lastFrameInfos = static_cast<LastFrameCollisionInfo*>(allocator.allocate(nbInfos * sizeof(LastFrameCollisionInfo)));
+
+    uint32 index = 0;
+    for (uint32 b=0; b < nbBatches; b++) {
+        for (uint32 i=0; i < batches[b]->getNbObjects(); i++) {
+
+            LastFrameCollisionInfo*& lastFrameCollisionInfo = batches[b]->lastFrameCollisionInfos[i];
+
+            if (lastFrameCollisionInfo != nullptr) {
+                new (lastFrameInfos + index) LastFrameCollisionInfo(*lastFrameCollisionInfo);
+            }
+            else {
+                new (lastFrameInfos + index) LastFrameCollisionInfo();
+            }
+
+            lastFrameCollisionInfo = lastFrameInfos + index;
+            index++;
+        }
+    }
+
+    return lastFrameInfos;
+}
+
 // Process the potential overlapping bodies  for the testOverlap() methods
-void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>& contactPairs) const {
+void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>& contactPairs,
+                                                                  MemoryAllocator& allocator) const {
 
-    Set<uint64> setOverlapContactPairId(mMemoryManager.getHeapAllocator());
+    Set<uint64> setOverlapContactPairId(allocator);
 
     // get the narrow-phase batches to test for collision
     NarrowPhaseInfoBatch& sphereVsSphereBatch = narrowPhaseInput.getSphereVsSphereBatch();
@@ -778,6 +1206,8 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
+    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronGJKBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronGJKBatch();
 
     // Process the potential contacts
     computeOverlapSnapshotContactPairs(sphereVsSphereBatch, contactPairs, setOverlapContactPairId);
@@ -786,6 +1216,8 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     computeOverlapSnapshotContactPairs(sphereVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(capsuleVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(convexPolyhedronVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(boxVsBoxBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(convexPolyhedronVsConvexPolyhedronGJKBatch, contactPairs, setOverlapContactPairId);
 }
 
 // Notify that the overlapping pairs where a given collider is involved need to be tested for overlap
@@ -799,6 +1231,15 @@ void CollisionDetectionSystem::notifyOverlappingPairsToTestOverlap(Collider* col
 
         // Notify that the overlapping pair needs to be testbed for overlap
         mOverlappingPairs.setNeedToTestOverlap(overlappingPairs[i], true);
+
+        // The collider has moved a lot or the size of its collision shape has changed and
+        // therefore the cached contact points of the pair cannot be reused anymore
+        if (mWorld->mConfig.isNarrowPhaseTemporalCoherenceEnabled) {
+            OverlappingPairs::ConvexOverlappingPair* convexPair = mOverlappingPairs.getConvexOverlappingPair(overlappingPairs[i]);
+            if (convexPair != nullptr) {
+                convexPair->nbCachedContactPoints = 0;
+            }
+        }
     }
 }
 
@@ -812,13 +1253,13 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInf
     for(uint32 i=0; i < narrowPhaseInfoBatch.getNbObjects(); i++) {
 
         // If there is a collision
-        if (narrowPhaseInfoBatch.narrowPhaseInfos[i].isColliding) {
+        if (narrowPhaseInfoBatch.isColliding[i]) {
 
             // If the contact pair does not already exist
-            if (!setOverlapContactPairId.contains(narrowPhaseInfoBatch.narrowPhaseInfos[i].overlappingPairId)) {
+            if (!setOverlapContactPairId.contains(narrowPhaseInfoBatch.overlappingPairIds[i])) {
 
-                const Entity collider1Entity = narrowPhaseInfoBatch.narrowPhaseInfos[i].colliderEntity1;
-                const Entity collider2Entity = narrowPhaseInfoBatch.narrowPhaseInfos[i].colliderEntity2;
+                const Entity collider1Entity = narrowPhaseInfoBatch.colliderEntities1[i];
+                const Entity collider2Entity = narrowPhaseInfoBatch.colliderEntities2[i];
 
                 const uint32 collider1Index = mCollidersComponents.getEntityIndex(collider1Entity);
                 const uint32 collider2Index = mCollidersComponents.getEntityIndex(collider2Entity);
@@ -829,10 +1270,10 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInf
                 const bool isTrigger = mCollidersComponents.mIsTrigger[collider1Index] || mCollidersComponents.mIsTrigger[collider2Index];
 
                 // Create a new contact pair
-                ContactPair contactPair(narrowPhaseInfoBatch.narrowPhaseInfos[i].overlappingPairId, body1Entity, body2Entity, collider1Entity, collider2Entity, static_cast<uint32>(contactPairs.size()), false, isTrigger);
+                ContactPair contactPair(narrowPhaseInfoBatch.overlappingPairIds[i], body1Entity, body2Entity, collider1Entity, collider2Entity, static_cast<uint32>(contactPairs.size()), false, isTrigger);
                 contactPairs.add(contactPair);
 
-                setOverlapContactPairId.add(narrowPhaseInfoBatch.narrowPhaseInfos[i].overlappingPairId);
+                setOverlapContactPairId.add(narrowPhaseInfoBatch.overlappingPairIds[i]);
             }
         }
 
@@ -842,11 +1283,14 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInf
 
 // Compute the narrow-phase collision detection for the testCollision() methods.
 // This method returns true if contacts are found.
-bool CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot(NarrowPhaseInput& narrowPhaseInput, CollisionCallback& callback) {
+bool CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot(NarrowPhaseInput& narrowPhaseInput, CollisionCallback& callback,
+                                                                   MemoryAllocator& allocator) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot()", mProfiler);
 
-    MemoryAllocator& allocator = mMemoryManager.getHeapAllocator();
+    // In the concurrent queries mode, the narrow-phase works on private copies of the last frame infos
+    uint32 nbLastFrameInfos = 0;
+    LastFrameCollisionInfo* lastFrameInfos = mIsInConcurrentQueriesMode ? copyLastFrameCollisionInfos(narrowPhaseInput, allocator, nbLastFrameInfos) : nullptr;
 
     // Test the narrow-phase collision detection on the batches to be tested
     bool collisionFound = testNarrowPhaseCollision(narrowPhaseInput, false, allocator);
@@ -862,7 +1306,7 @@ bool CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot(NarrowPhaseIn
         Array<ContactPoint> contactPoints(allocator);
 
         // Process all the potential contacts after narrow-phase collision
-        processAllPotentialContacts(narrowPhaseInput, true, potentialContactPoints, potentialContactManifolds, &contactPairs);
+        processAllPotentialContacts(narrowPhaseInput, true, potentialContactPoints, potentialContactManifolds, &contactPairs, allocator);
 
         // Reduce the number of contact points in the manifolds
         reducePotentialContactManifolds(&contactPairs, potentialContactManifolds, potentialContactPoints);
@@ -874,6 +1318,10 @@ bool CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot(NarrowPhaseIn
         reportContacts(callback, &contactPairs, &contactManifolds, &contactPoints, lostContactPairs);
     }
 
+    if (lastFrameInfos != nullptr) {
+        allocator.release(lastFrameInfos, nbLastFrameInfos * sizeof(LastFrameCollisionInfo));
+    }
+
     return collisionFound;
 }
 
@@ -1187,11 +1635,69 @@ void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const R
 
     RP3D_PROFILE("CollisionDetectionSystem::raycast()", mProfiler);
 
-    RaycastTest rayCastTest(raycastCallback);
+    // The temporary memory of the raycast is allocated with a scratch allocator of the calling thread
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
+
+    {
+        RaycastTest rayCastTest(raycastCallback, allocator);
+
+        // Ask the broad-phase algorithm to call the testRaycastAgainstShape()
+        // callback method for each collider hit by the ray in the broad-phase
+        mBroadPhaseSystem.raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
+    }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
+}
+
+// Ray casting method for a batch of rays
+/// The rays are split into chunks of RAYCAST_BATCH_CHUNK_SIZE rays and each chunk is split into packets of
+/// consecutive rays that traverse the broad-phase tree and the meshes together. If the batch is parallel,
+/// the chunks are processed by the workers of the task scheduler (except if the profiler is enabled).
+void CollisionDetectionSystem::raycastBatch(const Ray* rays, uint32 nbRays, RaycastHit* outHits, RaycastBatchMode mode,
+                                            unsigned short raycastWithCategoryMaskBits, bool isParallel) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::raycastBatch()", mProfiler);
+
+    auto raycastChunk = [&](uint32 startIndex, uint32 endIndex) {
+
+        // The temporary memory of the raycasts is allocated with a scratch allocator of the calling thread
+        SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
+
+        for (uint32 r=startIndex; r < endIndex; r += SimdDecimal::NB_LANES) {
+
+            const uint32 nbPacketRays = std::min(SimdDecimal::NB_LANES, endIndex - r);
+            const uint32 raysMask = (1u << nbPacketRays) - 1;
+
+            for (uint32 i=0; i < nbPacketRays; i++) {
+                outHits[r + i] = RaycastHit();
+            }
+
+            mBroadPhaseSystem.raycastPacket(rays + r, raysMask, outHits + r, mode, raycastWithCategoryMaskBits, allocator);
+        }
+
+        mMemoryManager.releaseScratchAllocator(allocator);
+    };
+
+    const uint32 nbChunks = TaskScheduler::computeNbChunks(nbRays, RAYCAST_BATCH_CHUNK_SIZE);
+
+    // The profiler is not thread-safe and therefore the batch is not parallel when profiling is enabled
+#ifndef IS_RP3D_PROFILING_ENABLED
+
+    if (isParallel && mWorld->mTaskScheduler.getNbWorkers() > 1 && nbChunks > 1) {
+
+        mWorld->mTaskScheduler.parallelFor(nbRays, RAYCAST_BATCH_CHUNK_SIZE, [&raycastChunk](const TaskScheduler::TaskRange& range) {
+            raycastChunk(range.startIndex, range.endIndex);
+        });
+
+        return;
+    }
 
-    // Ask the broad-phase algorithm to call the testRaycastAgainstShape()
-    // callback method for each collider hit by the ray in the broad-phase
-    mBroadPhaseSystem.raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
+#endif
+
+    for (uint32 c=0; c < nbChunks; c++) {
+        const uint32 startIndex = c * RAYCAST_BATCH_CHUNK_SIZE;
+        raycastChunk(startIndex, std::min(startIndex + RAYCAST_BATCH_CHUNK_SIZE, nbRays));
+    }
 }
 
 // Convert the potential contact into actual contacts
@@ -1210,10 +1716,10 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
         // For each narrow phase info object
         for(uint32 i=0; i < nbObjects; i++) {
 
-            narrowPhaseInfoBatch.narrowPhaseInfos[i].lastFrameCollisionInfo->wasColliding = narrowPhaseInfoBatch.narrowPhaseInfos[i].isColliding;
+            narrowPhaseInfoBatch.lastFrameCollisionInfos[i]->wasColliding = narrowPhaseInfoBatch.isColliding[i];
 
             // The previous frame collision info is now valid
-            narrowPhaseInfoBatch.narrowPhaseInfos[i].lastFrameCollisionInfo->isValid = true;
+            narrowPhaseInfoBatch.lastFrameCollisionInfos[i]->isValid = true;
         }
     }
 
@@ -1221,17 +1727,20 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
     for(uint32 i=0; i < nbObjects; i++) {
 
         // If the two colliders are colliding
-        if (narrowPhaseInfoBatch.narrowPhaseInfos[i].isColliding) {
+        if (narrowPhaseInfoBatch.isColliding[i]) {
 
-            const uint64 pairId = narrowPhaseInfoBatch.narrowPhaseInfos[i].overlappingPairId;
+            const uint64 pairId = narrowPhaseInfoBatch.overlappingPairIds[i];
             OverlappingPairs::OverlappingPair* overlappingPair = mOverlappingPairs.getOverlappingPair(pairId);
             assert(overlappingPair != nullptr);
 
-            overlappingPair->collidingInCurrentFrame = true;
+            // The overlapping pairs must not be modified by the concurrent queries
+            if (!mIsInConcurrentQueriesMode) {
+                overlappingPair->collidingInCurrentFrame = true;
+            }
 
 
-            const Entity collider1Entity = narrowPhaseInfoBatch.narrowPhaseInfos[i].colliderEntity1;
-            const Entity collider2Entity = narrowPhaseInfoBatch.narrowPhaseInfos[i].colliderEntity2;
+            const Entity collider1Entity = narrowPhaseInfoBatch.colliderEntities1[i];
+            const Entity collider2Entity = narrowPhaseInfoBatch.colliderEntities2[i];
 
             const uint32 collider1Index = mCollidersComponents.getEntityIndex(collider1Entity);
             const uint32 collider2Index = mCollidersComponents.getEntityIndex(collider2Entity);
@@ -1240,8 +1749,8 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
             const Entity body2Entity = mCollidersComponents.mBodiesEntities[collider2Index];
 
             const bool isTrigger = mCollidersComponents.mIsTrigger[collider1Index] || mCollidersComponents.mIsTrigger[collider2Index];
-            assert((isTrigger && narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints == 0) ||
-                   (!isTrigger && narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints > 0));
+            assert((isTrigger && narrowPhaseInfoBatch.nbContactPoints[i] == 0) ||
+                   (!isTrigger && narrowPhaseInfoBatch.nbContactPoints[i] > 0));
 
             // If we have a convex vs convex collision (if we consider the base collision shapes of the colliders)
             if (mCollidersComponents.mCollisionShapes[collider1Index]->isConvex() &&
@@ -1257,7 +1766,7 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                 ContactPair* pairContact = &((*contactPairs)[newContactPairIndex]);
 
                 // If there are contact points (not the case with collision with a trigger)
-                if (narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints > 0) {
+                if (narrowPhaseInfoBatch.nbContactPoints[i] > 0) {
 
                     // Create a new potential contact manifold for the overlapping pair
                     uint32 contactManifoldIndex = static_cast<uint>(potentialContactManifolds.size());
@@ -1267,7 +1776,7 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                     const uint32 contactPointIndexStart = static_cast<uint>(potentialContactPoints.size());
 
                     // Add the potential contacts
-                    for (uint32 j=0; j < narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints; j++) {
+                    for (uint32 j=0; j < narrowPhaseInfoBatch.nbContactPoints[i]; j++) {
 
                         if (contactManifoldInfo.nbPotentialContactPoints < NB_MAX_CONTACT_POINTS_IN_POTENTIAL_MANIFOLD) {
 
@@ -1276,7 +1785,7 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                             contactManifoldInfo.nbPotentialContactPoints++;
 
                             // Add the contact point to the array of potential contact points
-                            const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.narrowPhaseInfos[i].contactPoints[j];
+                            const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.contactPoints[i][j];
 
                             potentialContactPoints.add(contactPoint);
                         }
@@ -1315,12 +1824,12 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                 assert(pairContact != nullptr);
 
                 // If there are contact points (not the case with collision with a trigger)
-                if (narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints > 0) {
+                if (narrowPhaseInfoBatch.nbContactPoints[i] > 0) {
 
                     // Add the potential contacts
-                    for (uint32 j=0; j < narrowPhaseInfoBatch.narrowPhaseInfos[i].nbContactPoints; j++) {
+                    for (uint32 j=0; j < narrowPhaseInfoBatch.nbContactPoints[i]; j++) {
 
-                        const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.narrowPhaseInfos[i].contactPoints[j];
+                        const ContactPointInfo& contactPoint = narrowPhaseInfoBatch.contactPoints[i][j];
 
                         // Add the contact point to the array of potential contact points
                         const uint32 contactPointIndex = static_cast<uint32>(potentialContactPoints.size());
@@ -1772,127 +2281,201 @@ void CollisionDetectionSystem::reportDebugRenderingContacts(Array<ContactPair>*
 }
 
 // Return true if two bodies overlap (collide)
+/// The temporary memory of the world queries is allocated with a scratch allocator of the calling
+/// thread. In the concurrent queries mode, the broad-phase has already been computed.
 bool CollisionDetectionSystem::testOverlap(Body* body1, Body* body2) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    bool isOverlapping = false;
+
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
+
+        // Compute the broad-phase collision detection
+        if (!mIsInConcurrentQueriesMode) {
+            computeBroadPhase();
+        }
 
-    // Filter the overlapping pairs to get only the ones with the selected body involved
-    Array<uint64> convexPairs(mMemoryManager.getPoolAllocator());
-    Array<uint64> concavePairs(mMemoryManager.getPoolAllocator());
-    filterOverlappingPairs(body1->getEntity(), body2->getEntity(), convexPairs, concavePairs);
+        // Filter the overlapping pairs to get only the ones with the selected body involved
+        Array<uint64> convexPairs(allocator);
+        Array<uint64> concavePairs(allocator);
+        filterOverlappingPairs(body1->getEntity(), body2->getEntity(), convexPairs, concavePairs);
 
-    if (convexPairs.size() > 0 || concavePairs.size() > 0) {
+        if (convexPairs.size() > 0 || concavePairs.size() > 0) {
 
-        // Compute the middle-phase collision detection
-        computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, false);
+            // Compute the middle-phase collision detection
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, false, allocator);
 
-        // Compute the narrow-phase collision detection
-        return computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, nullptr);
+            // Compute the narrow-phase collision detection
+            isOverlapping = computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, nullptr, allocator);
+        }
     }
 
-    return false;
+    mMemoryManager.releaseScratchAllocator(allocator);
+
+    return isOverlapping;
 }
 
 // Report all the bodies that overlap (collide) in the world
 void CollisionDetectionSystem::testOverlap(OverlapCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
 
-    // Compute the middle-phase collision detection
-    computeMiddlePhase(narrowPhaseInput, false, true);
+        if (mIsInConcurrentQueriesMode) {
+
+            // The middle-phase of the simulation modifies the overlapping pairs. Therefore, we
+            // compute a snapshot of the middle-phase for all the world query pairs instead
+            Array<uint64> convexPairs(allocator);
+            Array<uint64> concavePairs(allocator);
+            filterWorldQueryOverlappingPairs(convexPairs, concavePairs);
+
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, false, allocator);
+        }
+        else {
+
+            // Compute the broad-phase collision detection
+            computeBroadPhase();
+
+            // Compute the middle-phase collision detection
+            computeMiddlePhase(narrowPhaseInput, false, true);
+        }
 
-    // Compute the narrow-phase collision detection and report overlapping shapes
-    computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, &callback);
+        // Compute the narrow-phase collision detection and report overlapping shapes
+        computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, &callback, allocator);
+    }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
 }
 
 // Report all the bodies that overlap (collide) with the body in parameter
 void CollisionDetectionSystem::testOverlap(Body* body, OverlapCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
 
-    // Filter the overlapping pairs to get only the ones with the selected body involved
-    Array<uint64> convexPairs(mMemoryManager.getPoolAllocator());
-    Array<uint64> concavePairs(mMemoryManager.getPoolAllocator());
-    filterOverlappingPairs(body->getEntity(), convexPairs, concavePairs);
+        // Compute the broad-phase collision detection
+        if (!mIsInConcurrentQueriesMode) {
+            computeBroadPhase();
+        }
+
+        // Filter the overlapping pairs to get only the ones with the selected body involved
+        Array<uint64> convexPairs(allocator);
+        Array<uint64> concavePairs(allocator);
+        filterOverlappingPairs(body->getEntity(), convexPairs, concavePairs);
 
-    if (convexPairs.size() > 0 || concavePairs.size() > 0) {
+        if (convexPairs.size() > 0 || concavePairs.size() > 0) {
 
-        // Compute the middle-phase collision detection
-        computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, false);
+            // Compute the middle-phase collision detection
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, false, allocator);
 
-        // Compute the narrow-phase collision detection
-        computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, &callback);
+            // Compute the narrow-phase collision detection
+            computeNarrowPhaseOverlapSnapshot(narrowPhaseInput, &callback, allocator);
+        }
     }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
 }
 
 // Test collision and report contacts between two bodies.
 void CollisionDetectionSystem::testCollision(Body* body1, Body* body2, CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
+
+        // Compute the broad-phase collision detection
+        if (!mIsInConcurrentQueriesMode) {
+            computeBroadPhase();
+        }
 
-    // Filter the overlapping pairs to get only the ones with the selected body involved
-    Array<uint64> convexPairs(mMemoryManager.getPoolAllocator());
-    Array<uint64> concavePairs(mMemoryManager.getPoolAllocator());
-    filterOverlappingPairs(body1->getEntity(), body2->getEntity(), convexPairs, concavePairs);
+        // Filter the overlapping pairs to get only the ones with the selected body involved
+        Array<uint64> convexPairs(allocator);
+        Array<uint64> concavePairs(allocator);
+        filterOverlappingPairs(body1->getEntity(), body2->getEntity(), convexPairs, concavePairs);
 
-    if (convexPairs.size() > 0 || concavePairs.size() > 0) {
+        if (convexPairs.size() > 0 || concavePairs.size() > 0) {
 
-        // Compute the middle-phase collision detection
-        computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, true);
+            // Compute the middle-phase collision detection
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, true, allocator);
 
-        // Compute the narrow-phase collision detection and report contacts
-        computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback);
+            // Compute the narrow-phase collision detection and report contacts
+            computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback, allocator);
+        }
     }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
 }
 
 // Test collision and report all the contacts involving the body in parameter
 void CollisionDetectionSystem::testCollision(Body* body, CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
 
-    // Filter the overlapping pairs to get only the ones with the selected body involved
-    Array<uint64> convexPairs(mMemoryManager.getPoolAllocator());
-    Array<uint64> concavePairs(mMemoryManager.getPoolAllocator());
-    filterOverlappingPairs(body->getEntity(), convexPairs, concavePairs);
+        // Compute the broad-phase collision detection
+        if (!mIsInConcurrentQueriesMode) {
+            computeBroadPhase();
+        }
 
-    if (convexPairs.size() > 0 || concavePairs.size() > 0) {
+        // Filter the overlapping pairs to get only the ones with the selected body involved
+        Array<uint64> convexPairs(allocator);
+        Array<uint64> concavePairs(allocator);
+        filterOverlappingPairs(body->getEntity(), convexPairs, concavePairs);
 
-        // Compute the middle-phase collision detection
-        computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, true);
+        if (convexPairs.size() > 0 || concavePairs.size() > 0) {
 
-        // Compute the narrow-phase collision detection and report contacts
-        computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback);
+            // Compute the middle-phase collision detection
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, true, allocator);
+
+            // Compute the narrow-phase collision detection and report contacts
+            computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback, allocator);
+        }
     }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
 }
 
 // Test collision and report contacts between each colliding bodies in the world
 void CollisionDetectionSystem::testCollision(CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    SingleFrameAllocator& allocator = mMemoryManager.acquireScratchAllocator();
 
-    // Compute the broad-phase collision detection
-    computeBroadPhase();
+    {
+        NarrowPhaseInput narrowPhaseInput(allocator, mOverlappingPairs);
 
-    // Compute the middle-phase collision detection
-    computeMiddlePhase(narrowPhaseInput, true, true);
+        if (mIsInConcurrentQueriesMode) {
+
+            // The middle-phase of the simulation modifies the overlapping pairs. Therefore, we
+            // compute a snapshot of the middle-phase for all the world query pairs instead
+            Array<uint64> convexPairs(allocator);
+            Array<uint64> concavePairs(allocator);
+            filterWorldQueryOverlappingPairs(convexPairs, concavePairs);
+
+            computeMiddlePhaseCollisionSnapshot(convexPairs, concavePairs, narrowPhaseInput, true, allocator);
+        }
+        else {
+
+            // Compute the broad-phase collision detection
+            computeBroadPhase();
 
-    // Compute the narrow-phase collision detection and report contacts
-    computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback);
+            // Compute the middle-phase collision detection
+            computeMiddlePhase(narrowPhaseInput, true, true);
+        }
+
+        // Compute the narrow-phase collision detection and report contacts
+        computeNarrowPhaseCollisionSnapshot(narrowPhaseInput, callback, allocator);
+    }
+
+    mMemoryManager.releaseScratchAllocator(allocator);
 }
 
 // Filter the overlapping pairs to keep only the pairs where a given body is involved
@@ -1953,6 +2536,34 @@ void CollisionDetectionSystem::filterOverlappingPairs(Entity body1Entity, Entity
     }
 }
 
+// Filter the overlapping pairs to keep only the pairs where both colliders are world query colliders
+void CollisionDetectionSystem::filterWorldQueryOverlappingPairs(Array<uint64>& convexPairs, Array<uint64>& concavePairs) const {
+
+    // For each convex pair
+    const uint32 nbConvexPairs = static_cast<uint32>(mOverlappingPairs.mConvexPairs.size());
+    for (uint32 i=0; i < nbConvexPairs; i++) {
+
+        const uint32 collider1Index = mCollidersComponents.getEntityIndex(mOverlappingPairs.mConvexPairs[i].collider1);
+        const uint32 collider2Index = mCollidersComponents.getEntityIndex(mOverlappingPairs.mConvexPairs[i].collider2);
+
+        if (mCollidersComponents.mIsWorldQueryCollider[collider1Index] && mCollidersComponents.mIsWorldQueryCollider[collider2Index]) {
+            convexPairs.add(mOverlappingPairs.mConvexPairs[i].pairID);
+        }
+    }
+
+    // For each concave pair
+    const uint32 nbConcavePairs = static_cast<uint32>(mOverlappingPairs.mConcavePairs.size());
+    for (uint32 i=0; i < nbConcavePairs; i++) {
+
+        const uint32 collider1Index = mCollidersComponents.getEntityIndex(mOverlappingPairs.mConcavePairs[i].collider1);
+        const uint32 collider2Index = mCollidersComponents.getEntityIndex(mOverlappingPairs.mConcavePairs[i].collider2);
+
+        if (mCollidersComponents.mIsWorldQueryCollider[collider1Index] && mCollidersComponents.mIsWorldQueryCollider[collider2Index]) {
+            concavePairs.add(mOverlappingPairs.mConcavePairs[i].pairID);
+        }
+    }
+}
+
 // Return the world event listener
 EventListener* CollisionDetectionSystem::getWorldEventListener() {
    return mWorld->mEventListener;
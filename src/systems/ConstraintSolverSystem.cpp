@@ -27,13 +27,17 @@
 #include <reactphysics3d/systems/ConstraintSolverSystem.h>
 #include <reactphysics3d/components/JointComponents.h>
 #include <reactphysics3d/components/BallAndSocketJointComponents.h>
+#include <reactphysics3d/components/FixedJointComponents.h>
+#include <reactphysics3d/components/HingeJointComponents.h>
+#include <reactphysics3d/components/SliderJointComponents.h>
+#include <reactphysics3d/engine/Islands.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/engine/Island.h>
 
 using namespace reactphysics3d;
 
 // Constructor
-ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
+ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, MemoryAllocator& allocator, Islands& islands, RigidBodyComponents& rigidBodyComponents,
                                                TransformComponents& transformComponents,
                                                JointComponents& jointComponents,
                                                BallAndSocketJointComponents& ballAndSocketJointComponents,
@@ -45,7 +49,11 @@ ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, Islands& isl
                    mSolveBallAndSocketJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, ballAndSocketJointComponents),
                    mSolveFixedJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, fixedJointComponents),
                    mSolveHingeJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, hingeJointComponents),
-                   mSolveSliderJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, sliderJointComponents) {
+                   mSolveSliderJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, sliderJointComponents),
+                   mJointComponents(jointComponents), mBallAndSocketJointComponents(ballAndSocketJointComponents),
+                   mFixedJointComponents(fixedJointComponents), mHingeJointComponents(hingeJointComponents),
+                   mSliderJointComponents(sliderJointComponents), mIslandsJoints(allocator),
+                   mIslandsJointsStartIndex(allocator), mJointsGroupIndex(allocator) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -61,6 +69,30 @@ void ConstraintSolverSystem::initialize(decimal dt) {
 
     RP3D_PROFILE("ConstraintSolverSystem::initialize()", mProfiler);
 
+    initBeforeSolve(dt);
+
+    if (mIsWarmStartingActive) {
+        mSolveBallAndSocketJointSystem.warmstart();
+        mSolveFixedJointSystem.warmstart();
+        mSolveHingeJointSystem.warmstart();
+        mSolveSliderJointSystem.warmstart();
+    }
+}
+
+// Initialize the constraint solver to solve the islands separately
+/// The joints are not warm started here. Each island has to be warm started with warmstartIsland().
+void ConstraintSolverSystem::initializeForIslands(decimal dt) {
+
+    RP3D_PROFILE("ConstraintSolverSystem::initializeForIslands()", mProfiler);
+
+    initBeforeSolve(dt);
+
+    computeIslandsJoints();
+}
+
+// Set the time step and warm starting parameters and initialize the joints before solving
+void ConstraintSolverSystem::initBeforeSolve(decimal dt) {
+
     // Set the current time step
     mTimeStep = dt;
 
@@ -81,12 +113,156 @@ void ConstraintSolverSystem::initialize(decimal dt) {
     mSolveFixedJointSystem.initBeforeSolve();
     mSolveHingeJointSystem.initBeforeSolve();
     mSolveSliderJointSystem.initBeforeSolve();
+}
 
-    if (mIsWarmStartingActive) {
-        mSolveBallAndSocketJointSystem.warmstart();
-        mSolveFixedJointSystem.warmstart();
-        mSolveHingeJointSystem.warmstart();
-        mSolveSliderJointSystem.warmstart();
+// Compute the joints of each island
+/// The joints of each island are sorted in the same order as in the sequential solver (ball-and-socket,
+/// fixed, hinge and slider joints in the order of their components). Solving the islands separately
+/// therefore gives the same result as solving all the joints at once. The enabled joints that are not
+/// part of any island (a joint between a static body and a body without simulation collider for instance)
+/// are stored in an additional group at index mIslands.getNbIslands().
+void ConstraintSolverSystem::computeIslandsJoints() {
+
+    RP3D_PROFILE("ConstraintSolverSystem::computeIslandsJoints()", mProfiler);
+
+    const uint32 nbIslands = mIslands.getNbIslands();
+    const uint32 nbGroups = nbIslands + 1;
+
+    const uint32 nbBallAndSocketJoints = mBallAndSocketJointComponents.getNbEnabledComponents();
+    const uint32 nbFixedJoints = mFixedJointComponents.getNbEnabledComponents();
+    const uint32 nbHingeJoints = mHingeJointComponents.getNbEnabledComponents();
+    const uint32 nbSliderJoints = mSliderJointComponents.getNbEnabledComponents();
+
+    // Index of the first joint of each type of joint in the solver order
+    const uint32 fixedJointsStartIndex = nbBallAndSocketJoints;
+    const uint32 hingeJointsStartIndex = fixedJointsStartIndex + nbFixedJoints;
+    const uint32 sliderJointsStartIndex = hingeJointsStartIndex + nbHingeJoints;
+    const uint32 nbJoints = sliderJointsStartIndex + nbSliderJoints;
+
+    mIslandsJoints.clear();
+    mIslandsJointsStartIndex.clear();
+    mJointsGroupIndex.clear();
+
+    mIslandsJointsStartIndex.reserve(nbGroups + 1);
+    for (uint32 i=0; i <= nbGroups; i++) {
+        mIslandsJointsStartIndex.add(0);
+    }
+
+    if (nbJoints == 0) return;
+
+    // By default, a joint is in the group of the joints that are not in any island
+    mJointsGroupIndex.reserve(nbJoints);
+    for (uint32 i=0; i < nbJoints; i++) {
+        mJointsGroupIndex.add(nbIslands);
+    }
+
+    // Compute the island of each joint
+    for (uint32 i=0; i < nbIslands; i++) {
+
+        const uint32 startIndex = mIslands.startJointEntitiesIndex[i];
+        for (uint32 j=startIndex; j < startIndex + mIslands.nbJointsInIsland[i]; j++) {
+
+            const Entity jointEntity = mIslands.jointEntities[j];
+
+            uint32 solverIndex = 0;
+            switch (mJointComponents.getType(jointEntity)) {
+                case JointType::BALLSOCKETJOINT: solverIndex = mBallAndSocketJointComponents.getEntityIndex(jointEntity); break;
+                case JointType::FIXEDJOINT: solverIndex = fixedJointsStartIndex + mFixedJointComponents.getEntityIndex(jointEntity); break;
+                case JointType::HINGEJOINT: solverIndex = hingeJointsStartIndex + mHingeJointComponents.getEntityIndex(jointEntity); break;
+                case JointType::SLIDERJOINT: solverIndex = sliderJointsStartIndex + mSliderJointComponents.getEntityIndex(jointEntity); break;
+            }
+
+            assert(solverIndex < nbJoints);
+            mJointsGroupIndex[solverIndex] = i;
+        }
+    }
+
+    // Count the number of joints of each group and compute the start index of each group
+    for (uint32 i=0; i < nbJoints; i++) {
+        mIslandsJointsStartIndex[mJointsGroupIndex[i] + 1]++;
+    }
+    for (uint32 i=0; i < nbGroups; i++) {
+        mIslandsJointsStartIndex[i + 1] += mIslandsJointsStartIndex[i];
+    }
+
+    // Store the joints of each group in the solver order
+    mIslandsJoints.addWithoutInit(nbJoints);
+    for (uint32 i=0; i < nbJoints; i++) {
+
+        IslandJoint joint;
+        if (i < fixedJointsStartIndex) {
+            joint.type = JointType::BALLSOCKETJOINT;
+            joint.componentIndex = i;
+        }
+        else if (i < hingeJointsStartIndex) {
+            joint.type = JointType::FIXEDJOINT;
+            joint.componentIndex = i - fixedJointsStartIndex;
+        }
+        else if (i < sliderJointsStartIndex) {
+            joint.type = JointType::HINGEJOINT;
+            joint.componentIndex = i - hingeJointsStartIndex;
+        }
+        else {
+            joint.type = JointType::SLIDERJOINT;
+            joint.componentIndex = i - sliderJointsStartIndex;
+        }
+
+        // Use the start index of the group as the insertion index (restored below)
+        mIslandsJoints[mIslandsJointsStartIndex[mJointsGroupIndex[i]]++] = joint;
+    }
+
+    // Restore the start index of each group
+    for (uint32 i=nbGroups; i > 0; i--) {
+        mIslandsJointsStartIndex[i] = mIslandsJointsStartIndex[i - 1];
+    }
+    mIslandsJointsStartIndex[0] = 0;
+}
+
+// Warm start the joints of a given island
+/// The island index mIslands.getNbIslands() refers to the enabled joints that are not in any island.
+/// This method can be called from a worker thread of the task scheduler.
+void ConstraintSolverSystem::warmstartIsland(uint32 islandIndex) {
+
+    if (!mIsWarmStartingActive) return;
+
+    assert(islandIndex + 1 < mIslandsJointsStartIndex.size());
+
+    for (uint32 i=mIslandsJointsStartIndex[islandIndex]; i < mIslandsJointsStartIndex[islandIndex + 1]; i++) {
+        warmstartJoint(mIslandsJoints[i]);
+    }
+}
+
+// Solve the velocity constraints of the joints of a given island
+/// The island index mIslands.getNbIslands() refers to the enabled joints that are not in any island.
+/// This method can be called from a worker thread of the task scheduler.
+void ConstraintSolverSystem::solveVelocityConstraintsIsland(uint32 islandIndex) {
+
+    assert(islandIndex + 1 < mIslandsJointsStartIndex.size());
+
+    for (uint32 i=mIslandsJointsStartIndex[islandIndex]; i < mIslandsJointsStartIndex[islandIndex + 1]; i++) {
+        solveVelocityConstraintJoint(mIslandsJoints[i]);
+    }
+}
+
+// Warm start a single joint
+void ConstraintSolverSystem::warmstartJoint(const IslandJoint& joint) {
+
+    switch (joint.type) {
+        case JointType::BALLSOCKETJOINT: mSolveBallAndSocketJointSystem.warmstartJoint(joint.componentIndex); break;
+        case JointType::FIXEDJOINT: mSolveFixedJointSystem.warmstartJoint(joint.componentIndex); break;
+        case JointType::HINGEJOINT: mSolveHingeJointSystem.warmstartJoint(joint.componentIndex); break;
+        case JointType::SLIDERJOINT: mSolveSliderJointSystem.warmstartJoint(joint.componentIndex); break;
+    }
+}
+
+// Solve the velocity constraint of a single joint
+void ConstraintSolverSystem::solveVelocityConstraintJoint(const IslandJoint& joint) {
+
+    switch (joint.type) {
+        case JointType::BALLSOCKETJOINT: mSolveBallAndSocketJointSystem.solveVelocityConstraintJoint(joint.componentIndex); break;
+        case JointType::FIXEDJOINT: mSolveFixedJointSystem.solveVelocityConstraintJoint(joint.componentIndex); break;
+        case JointType::HINGEJOINT: mSolveHingeJointSystem.solveVelocityConstraintJoint(joint.componentIndex); break;
+        case JointType::SLIDERJOINT: mSolveSliderJointSystem.solveVelocityConstraintJoint(joint.componentIndex); break;
     }
 }
 
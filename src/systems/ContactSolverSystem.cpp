@@ -34,7 +34,9 @@
 #include <reactphysics3d/components/BodyComponents.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/collision/ContactManifold.h>
+#include <reactphysics3d/utils/TaskScheduler.h>
 #include <algorithm>
+#include <cstring>
 
 using namespace reactphysics3d;
 using namespace std;
@@ -43,17 +45,25 @@ using namespace std;
 const decimal ContactSolverSystem::BETA = decimal(0.2);
 const decimal ContactSolverSystem::BETA_SPLIT_IMPULSE = decimal(0.2);
 const decimal ContactSolverSystem::SLOP = decimal(0.01);
+const uint32 ContactSolverSystem::NB_MAX_PARALLEL_COLORS = 64;
 
 // Constructor
-ContactSolverSystem::ContactSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, Islands& islands,
+ContactSolverSystem::ContactSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, TaskScheduler& taskScheduler, Islands& islands,
                                          BodyComponents& bodyComponents, RigidBodyComponents& rigidBodyComponents,
                                          ColliderComponents& colliderComponents, decimal& restitutionVelocityThreshold)
-              :mMemoryManager(memoryManager), mWorld(world), mTimeStep(-1), mRestitutionVelocityThreshold(restitutionVelocityThreshold),
+              :mMemoryManager(memoryManager), mWorld(world), mTaskScheduler(taskScheduler), mTimeStep(-1), mRestitutionVelocityThreshold(restitutionVelocityThreshold),
                mContactConstraints(nullptr), mContactPoints(nullptr),
                mNbContactPoints(0), mNbContactManifolds(0),
                mIslands(islands), mAllContactManifolds(nullptr), mAllContactPoints(nullptr),
                mBodyComponents(bodyComponents), mRigidBodyComponents(rigidBodyComponents),
-               mColliderComponents(colliderComponents), mIsSplitImpulseActive(true) {
+               mColliderComponents(colliderComponents), mIsSplitImpulseActive(true),
+               mColorsManifolds(memoryManager.getHeapAllocator()), mColorsStartIndex(memoryManager.getHeapAllocator()),
+               mManifoldsColor(memoryManager.getHeapAllocator()), mBodiesColorsMasks(memoryManager.getHeapAllocator()),
+               mIsSimdSolverEnabled(true)
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+               , mColorsBatches(memoryManager.getHeapAllocator()), mColorsBatchesStartIndex(memoryManager.getHeapAllocator())
+#endif
+               {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -65,11 +75,33 @@ ContactSolverSystem::ContactSolverSystem(MemoryManager& memoryManager, PhysicsWo
 // Initialize the contact constraints
 void ContactSolverSystem::init(Array<ContactManifold>* contactManifolds, Array<ContactPoint>* contactPoints, decimal timeStep) {
 
+    RP3D_PROFILE("ContactSolver::init()", mProfiler);
+
+    allocate(contactManifolds, contactPoints, timeStep);
+
+    // For each island of the world
+    const uint32 nbIslands = mIslands.getNbIslands();
+    for (uint32 i = 0; i < nbIslands; i++) {
+
+        if (mIslands.nbContactManifolds[i] > 0) {
+            initializeForIsland(i);
+        }
+    }
+
+    // Warmstarting
+    warmStart();
+}
+
+// Allocate the contact constraints of the current frame
+/// The constraints are not initialized here. Each island has to be initialized with
+/// initializeForIsland(). The islands can be initialized in parallel because the
+/// constraints of an island are stored at the same indices as its contact manifolds
+/// and contact points in the arrays of the narrow-phase.
+void ContactSolverSystem::allocate(Array<ContactManifold>* contactManifolds, Array<ContactPoint>* contactPoints, decimal timeStep) {
+
     mAllContactManifolds = contactManifolds;
     mAllContactPoints = contactPoints;
 
-    RP3D_PROFILE("ContactSolver::init()", mProfiler);
-
     mTimeStep = timeStep;
 
     const uint32 nbContactManifolds = static_cast<uint32>(mAllContactManifolds->size());
@@ -81,6 +113,10 @@ void ContactSolverSystem::init(Array<ContactManifold>* contactManifolds, Array<C
     mContactConstraints = nullptr;
     mContactPoints = nullptr;
 
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+    mColorsBatches.clear();
+#endif
+
     if (nbContactManifolds == 0 || nbContactPoints == 0) return;
 
     mContactPoints = static_cast<ContactPointSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
@@ -91,17 +127,9 @@ void ContactSolverSystem::init(Array<ContactManifold>* contactManifolds, Array<C
                                                                                       sizeof(ContactManifoldSolver) * nbContactManifolds));
     assert(mContactConstraints != nullptr);
 
-    // For each island of the world
-    const uint32 nbIslands = mIslands.getNbIslands();
-    for (uint32 i = 0; i < nbIslands; i++) {
-
-        if (mIslands.nbContactManifolds[i] > 0) {
-            initializeForIsland(i);
-        }
-    }
-
-    // Warmstarting
-    warmStart();
+    // All the contact manifolds of the narrow-phase belong to an island
+    mNbContactManifolds = nbContactManifolds;
+    mNbContactPoints = nbContactPoints;
 }
 
 // Release allocated memory
@@ -112,17 +140,21 @@ void ContactSolverSystem::reset() {
 }
 
 // Initialize the constraint solver for a given island
+/// This method can be called from a worker thread of the task scheduler (the islands
+/// only write their own constraints) and is therefore not profiled
 void ContactSolverSystem::initializeForIsland(uint32 islandIndex) {
 
-    RP3D_PROFILE("ContactSolver::initializeForIsland()", mProfiler);
-
     assert(mIslands.nbBodiesInIsland[islandIndex] > 0);
     assert(mIslands.nbContactManifolds[islandIndex] > 0);
 
-    // For each contact manifold of the island
-    const uint32 contactManifoldsIndex = mIslands.contactManifoldsIndices[islandIndex];
-    const uint32 nbContactManifolds = mIslands.nbContactManifolds[islandIndex];
-    for (uint32 m=contactManifoldsIndex; m < contactManifoldsIndex + nbContactManifolds; m++) {
+    initializeManifolds(mIslands.contactManifoldsIndices[islandIndex], mIslands.nbContactManifolds[islandIndex]);
+}
+
+// Initialize the constraints of the contact manifolds in the range [startManifoldIndex, startManifoldIndex + nbManifolds)
+void ContactSolverSystem::initializeManifolds(uint32 startManifoldIndex, uint32 nbManifolds) {
+
+    // For each contact manifold
+    for (uint32 m=startManifoldIndex; m < startManifoldIndex + nbManifolds; m++) {
 
         ContactManifold& externalManifold = (*mAllContactManifolds)[m];
 
@@ -139,23 +171,23 @@ void ContactSolverSystem::initializeForIsland(uint32 islandIndex) {
         const Vector3& x2 = mRigidBodyComponents.mCentersOfMassWorld[rigidBodyIndex2];
 
         // Initialize the internal contact manifold structure using the external contact manifold
-        new (mContactConstraints + mNbContactManifolds) ContactManifoldSolver();
-        mContactConstraints[mNbContactManifolds].rigidBodyComponentIndexBody1 = rigidBodyIndex1;
-        mContactConstraints[mNbContactManifolds].rigidBodyComponentIndexBody2 = rigidBodyIndex2;
-        mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody1 = mRigidBodyComponents.mInverseInertiaTensorsWorld[rigidBodyIndex1];
-        mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 = mRigidBodyComponents.mInverseInertiaTensorsWorld[rigidBodyIndex2];
-        mContactConstraints[mNbContactManifolds].massInverseBody1 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex1];
-        mContactConstraints[mNbContactManifolds].massInverseBody2 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex2];
-        mContactConstraints[mNbContactManifolds].linearLockAxisFactorBody1 = mRigidBodyComponents.mLinearLockAxisFactors[rigidBodyIndex1];
-        mContactConstraints[mNbContactManifolds].linearLockAxisFactorBody2 = mRigidBodyComponents.mLinearLockAxisFactors[rigidBodyIndex2];
-        mContactConstraints[mNbContactManifolds].angularLockAxisFactorBody1 = mRigidBodyComponents.mAngularLockAxisFactors[rigidBodyIndex1];
-        mContactConstraints[mNbContactManifolds].angularLockAxisFactorBody2 = mRigidBodyComponents.mAngularLockAxisFactors[rigidBodyIndex2];
-        mContactConstraints[mNbContactManifolds].nbContacts = externalManifold.nbContactPoints;
-        mContactConstraints[mNbContactManifolds].frictionCoefficient = computeMixedFrictionCoefficient(mColliderComponents.mMaterials[collider1Index], mColliderComponents.mMaterials[collider2Index]);
-        mContactConstraints[mNbContactManifolds].externalContactManifold = &externalManifold;
-        mContactConstraints[mNbContactManifolds].normal.setToZero();
-        mContactConstraints[mNbContactManifolds].frictionPointBody1.setToZero();
-        mContactConstraints[mNbContactManifolds].frictionPointBody2.setToZero();
+        new (mContactConstraints + m) ContactManifoldSolver();
+        mContactConstraints[m].rigidBodyComponentIndexBody1 = rigidBodyIndex1;
+        mContactConstraints[m].rigidBodyComponentIndexBody2 = rigidBodyIndex2;
+        mContactConstraints[m].inverseInertiaTensorBody1 = mRigidBodyComponents.mInverseInertiaTensorsWorld[rigidBodyIndex1];
+        mContactConstraints[m].inverseInertiaTensorBody2 = mRigidBodyComponents.mInverseInertiaTensorsWorld[rigidBodyIndex2];
+        mContactConstraints[m].massInverseBody1 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex1];
+        mContactConstraints[m].massInverseBody2 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex2];
+        mContactConstraints[m].linearLockAxisFactorBody1 = mRigidBodyComponents.mLinearLockAxisFactors[rigidBodyIndex1];
+        mContactConstraints[m].linearLockAxisFactorBody2 = mRigidBodyComponents.mLinearLockAxisFactors[rigidBodyIndex2];
+        mContactConstraints[m].angularLockAxisFactorBody1 = mRigidBodyComponents.mAngularLockAxisFactors[rigidBodyIndex1];
+        mContactConstraints[m].angularLockAxisFactorBody2 = mRigidBodyComponents.mAngularLockAxisFactors[rigidBodyIndex2];
+        mContactConstraints[m].nbContacts = externalManifold.nbContactPoints;
+        mContactConstraints[m].frictionCoefficient = computeMixedFrictionCoefficient(mColliderComponents.mMaterials[collider1Index], mColliderComponents.mMaterials[collider2Index]);
+        mContactConstraints[m].externalContactManifold = &externalManifold;
+        mContactConstraints[m].normal.setToZero();
+        mContactConstraints[m].frictionPointBody1.setToZero();
+        mContactConstraints[m].frictionPointBody2.setToZero();
 
         // Get the velocities of the bodies
         const Vector3& v1 = mRigidBodyComponents.mLinearVelocities[rigidBodyIndex1];
@@ -174,148 +206,144 @@ void ContactSolverSystem::initializeForIsland(uint32 islandIndex) {
 
             ContactPoint& externalContact = (*mAllContactPoints)[c];
 
-            new (mContactPoints + mNbContactPoints) ContactPointSolver();
-            mContactPoints[mNbContactPoints].externalContact = &externalContact;
-            mContactPoints[mNbContactPoints].normal = externalContact.getNormal();
+            new (mContactPoints + c) ContactPointSolver();
+            mContactPoints[c].externalContact = &externalContact;
+            mContactPoints[c].normal = externalContact.getNormal();
 
             // Get the contact point on the two bodies
             const Vector3 p1 = collider1LocalToWorldTransform * externalContact.getLocalPointOnShape1();
             const Vector3 p2 = collider2LocalToWorldTransform * externalContact.getLocalPointOnShape2();
 
-            mContactPoints[mNbContactPoints].r1.x = p1.x - x1.x;
-            mContactPoints[mNbContactPoints].r1.y = p1.y - x1.y;
-            mContactPoints[mNbContactPoints].r1.z = p1.z - x1.z;
-            mContactPoints[mNbContactPoints].r2.x = p2.x - x2.x;
-            mContactPoints[mNbContactPoints].r2.y = p2.y - x2.y;
-            mContactPoints[mNbContactPoints].r2.z = p2.z - x2.z;
-            mContactPoints[mNbContactPoints].penetrationDepth = externalContact.getPenetrationDepth();
-            mContactPoints[mNbContactPoints].isRestingContact = externalContact.getIsRestingContact();
+            mContactPoints[c].r1.x = p1.x - x1.x;
+            mContactPoints[c].r1.y = p1.y - x1.y;
+            mContactPoints[c].r1.z = p1.z - x1.z;
+            mContactPoints[c].r2.x = p2.x - x2.x;
+            mContactPoints[c].r2.y = p2.y - x2.y;
+            mContactPoints[c].r2.z = p2.z - x2.z;
+            mContactPoints[c].penetrationDepth = externalContact.getPenetrationDepth();
+            mContactPoints[c].isRestingContact = externalContact.getIsRestingContact();
             externalContact.setIsRestingContact(true);
-            mContactPoints[mNbContactPoints].penetrationImpulse = externalContact.getPenetrationImpulse();
-            mContactPoints[mNbContactPoints].penetrationSplitImpulse = 0.0;
+            mContactPoints[c].penetrationImpulse = externalContact.getPenetrationImpulse();
+            mContactPoints[c].penetrationSplitImpulse = 0.0;
 
-            mContactConstraints[mNbContactManifolds].frictionPointBody1.x += p1.x;
-            mContactConstraints[mNbContactManifolds].frictionPointBody1.y += p1.y;
-            mContactConstraints[mNbContactManifolds].frictionPointBody1.z += p1.z;
-            mContactConstraints[mNbContactManifolds].frictionPointBody2.x += p2.x;
-            mContactConstraints[mNbContactManifolds].frictionPointBody2.y += p2.y;
-            mContactConstraints[mNbContactManifolds].frictionPointBody2.z += p2.z;
+            mContactConstraints[m].frictionPointBody1.x += p1.x;
+            mContactConstraints[m].frictionPointBody1.y += p1.y;
+            mContactConstraints[m].frictionPointBody1.z += p1.z;
+            mContactConstraints[m].frictionPointBody2.x += p2.x;
+            mContactConstraints[m].frictionPointBody2.y += p2.y;
+            mContactConstraints[m].frictionPointBody2.z += p2.z;
 
             // Compute the velocity difference
-            // deltaV = v2 + w2.cross(mContactPoints[mNbContactPoints].r2) - v1 - w1.cross(mContactPoints[mNbContactPoints].r1);
-            Vector3 deltaV(v2.x + w2.y * mContactPoints[mNbContactPoints].r2.z - w2.z * mContactPoints[mNbContactPoints].r2.y
-                           - v1.x - w1.y * mContactPoints[mNbContactPoints].r1.z + w1.z * mContactPoints[mNbContactPoints].r1.y,
-                           v2.y + w2.z * mContactPoints[mNbContactPoints].r2.x - w2.x * mContactPoints[mNbContactPoints].r2.z
-                           - v1.y - w1.z * mContactPoints[mNbContactPoints].r1.x + w1.x * mContactPoints[mNbContactPoints].r1.z,
-                           v2.z + w2.x * mContactPoints[mNbContactPoints].r2.y - w2.y * mContactPoints[mNbContactPoints].r2.x
-                           - v1.z - w1.x * mContactPoints[mNbContactPoints].r1.y + w1.y * mContactPoints[mNbContactPoints].r1.x);
-
-            // r1CrossN = mContactPoints[mNbContactPoints].r1.cross(mContactPoints[mNbContactPoints].normal);
-            Vector3 r1CrossN(mContactPoints[mNbContactPoints].r1.y * mContactPoints[mNbContactPoints].normal.z -
-                             mContactPoints[mNbContactPoints].r1.z * mContactPoints[mNbContactPoints].normal.y,
-                             mContactPoints[mNbContactPoints].r1.z * mContactPoints[mNbContactPoints].normal.x -
-                             mContactPoints[mNbContactPoints].r1.x * mContactPoints[mNbContactPoints].normal.z,
-                             mContactPoints[mNbContactPoints].r1.x * mContactPoints[mNbContactPoints].normal.y -
-                             mContactPoints[mNbContactPoints].r1.y * mContactPoints[mNbContactPoints].normal.x);
-            // r2CrossN = mContactPoints[mNbContactPoints].r2.cross(mContactPoints[mNbContactPoints].normal);
-            Vector3 r2CrossN(mContactPoints[mNbContactPoints].r2.y * mContactPoints[mNbContactPoints].normal.z -
-                             mContactPoints[mNbContactPoints].r2.z * mContactPoints[mNbContactPoints].normal.y,
-                             mContactPoints[mNbContactPoints].r2.z * mContactPoints[mNbContactPoints].normal.x -
-                             mContactPoints[mNbContactPoints].r2.x * mContactPoints[mNbContactPoints].normal.z,
-                             mContactPoints[mNbContactPoints].r2.x * mContactPoints[mNbContactPoints].normal.y -
-                             mContactPoints[mNbContactPoints].r2.y * mContactPoints[mNbContactPoints].normal.x);
-
-            mContactPoints[mNbContactPoints].i1TimesR1CrossN = mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody1 * r1CrossN;
-            mContactPoints[mNbContactPoints].i2TimesR2CrossN = mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 * r2CrossN;
+            // deltaV = v2 + w2.cross(mContactPoints[c].r2) - v1 - w1.cross(mContactPoints[c].r1);
+            Vector3 deltaV(v2.x + w2.y * mContactPoints[c].r2.z - w2.z * mContactPoints[c].r2.y
+                           - v1.x - w1.y * mContactPoints[c].r1.z + w1.z * mContactPoints[c].r1.y,
+                           v2.y + w2.z * mContactPoints[c].r2.x - w2.x * mContactPoints[c].r2.z
+                           - v1.y - w1.z * mContactPoints[c].r1.x + w1.x * mContactPoints[c].r1.z,
+                           v2.z + w2.x * mContactPoints[c].r2.y - w2.y * mContactPoints[c].r2.x
+                           - v1.z - w1.x * mContactPoints[c].r1.y + w1.y * mContactPoints[c].r1.x);
+
+            // r1CrossN = mContactPoints[c].r1.cross(mContactPoints[c].normal);
+            Vector3 r1CrossN(mContactPoints[c].r1.y * mContactPoints[c].normal.z -
+                             mContactPoints[c].r1.z * mContactPoints[c].normal.y,
+                             mContactPoints[c].r1.z * mContactPoints[c].normal.x -
+                             mContactPoints[c].r1.x * mContactPoints[c].normal.z,
+                             mContactPoints[c].r1.x * mContactPoints[c].normal.y -
+                             mContactPoints[c].r1.y * mContactPoints[c].normal.x);
+            // r2CrossN = mContactPoints[c].r2.cross(mContactPoints[c].normal);
+            Vector3 r2CrossN(mContactPoints[c].r2.y * mContactPoints[c].normal.z -
+                             mContactPoints[c].r2.z * mContactPoints[c].normal.y,
+                             mContactPoints[c].r2.z * mContactPoints[c].normal.x -
+                             mContactPoints[c].r2.x * mContactPoints[c].normal.z,
+                             mContactPoints[c].r2.x * mContactPoints[c].normal.y -
+                             mContactPoints[c].r2.y * mContactPoints[c].normal.x);
+
+            mContactPoints[c].i1TimesR1CrossN = mContactConstraints[m].inverseInertiaTensorBody1 * r1CrossN;
+            mContactPoints[c].i2TimesR2CrossN = mContactConstraints[m].inverseInertiaTensorBody2 * r2CrossN;
 
             // Compute the inverse mass matrix K for the penetration constraint
-            decimal massPenetration = mContactConstraints[mNbContactManifolds].massInverseBody1 + mContactConstraints[mNbContactManifolds].massInverseBody2 +
-                    ((mContactPoints[mNbContactPoints].i1TimesR1CrossN).cross(mContactPoints[mNbContactPoints].r1)).dot(mContactPoints[mNbContactPoints].normal) +
-                    ((mContactPoints[mNbContactPoints].i2TimesR2CrossN).cross(mContactPoints[mNbContactPoints].r2)).dot(mContactPoints[mNbContactPoints].normal);
-            mContactPoints[mNbContactPoints].inversePenetrationMass = massPenetration > decimal(0.0) ? decimal(1.0) / massPenetration : decimal(0.0);
+            decimal massPenetration = mContactConstraints[m].massInverseBody1 + mContactConstraints[m].massInverseBody2 +
+                    ((mContactPoints[c].i1TimesR1CrossN).cross(mContactPoints[c].r1)).dot(mContactPoints[c].normal) +
+                    ((mContactPoints[c].i2TimesR2CrossN).cross(mContactPoints[c].r2)).dot(mContactPoints[c].normal);
+            mContactPoints[c].inversePenetrationMass = massPenetration > decimal(0.0) ? decimal(1.0) / massPenetration : decimal(0.0);
 
             // Compute the restitution velocity bias "b". We compute this here instead
             // of inside the solve() method because we need to use the velocity difference
             // at the beginning of the contact. Note that if it is a resting contact (normal
             // velocity bellow a given threshold), we do not add a restitution velocity bias
-            mContactPoints[mNbContactPoints].restitutionBias = 0.0;
-            // deltaVDotN = deltaV.dot(mContactPoints[mNbContactPoints].normal);
-            decimal deltaVDotN = deltaV.x * mContactPoints[mNbContactPoints].normal.x +
-                                 deltaV.y * mContactPoints[mNbContactPoints].normal.y +
-                                 deltaV.z * mContactPoints[mNbContactPoints].normal.z;
+            mContactPoints[c].restitutionBias = 0.0;
+            // deltaVDotN = deltaV.dot(mContactPoints[c].normal);
+            decimal deltaVDotN = deltaV.x * mContactPoints[c].normal.x +
+                                 deltaV.y * mContactPoints[c].normal.y +
+                                 deltaV.z * mContactPoints[c].normal.z;
             const decimal restitutionFactor = computeMixedRestitutionFactor(mColliderComponents.mMaterials[collider1Index], mColliderComponents.mMaterials[collider2Index]);
             if (deltaVDotN < -mRestitutionVelocityThreshold) {
-                mContactPoints[mNbContactPoints].restitutionBias = restitutionFactor * deltaVDotN;
+                mContactPoints[c].restitutionBias = restitutionFactor * deltaVDotN;
             }
 
-            mContactConstraints[mNbContactManifolds].normal.x += mContactPoints[mNbContactPoints].normal.x;
-            mContactConstraints[mNbContactManifolds].normal.y += mContactPoints[mNbContactPoints].normal.y;
-            mContactConstraints[mNbContactManifolds].normal.z += mContactPoints[mNbContactPoints].normal.z;
-
-            mNbContactPoints++;
+            mContactConstraints[m].normal.x += mContactPoints[c].normal.x;
+            mContactConstraints[m].normal.y += mContactPoints[c].normal.y;
+            mContactConstraints[m].normal.z += mContactPoints[c].normal.z;
         }
 
-        mContactConstraints[mNbContactManifolds].frictionPointBody1 /= static_cast<decimal>(mContactConstraints[mNbContactManifolds].nbContacts);
-        mContactConstraints[mNbContactManifolds].frictionPointBody2 /= static_cast<decimal>(mContactConstraints[mNbContactManifolds].nbContacts);
-        mContactConstraints[mNbContactManifolds].r1Friction.x = mContactConstraints[mNbContactManifolds].frictionPointBody1.x - x1.x;
-        mContactConstraints[mNbContactManifolds].r1Friction.y = mContactConstraints[mNbContactManifolds].frictionPointBody1.y - x1.y;
-        mContactConstraints[mNbContactManifolds].r1Friction.z = mContactConstraints[mNbContactManifolds].frictionPointBody1.z - x1.z;
-        mContactConstraints[mNbContactManifolds].r2Friction.x = mContactConstraints[mNbContactManifolds].frictionPointBody2.x - x2.x;
-        mContactConstraints[mNbContactManifolds].r2Friction.y = mContactConstraints[mNbContactManifolds].frictionPointBody2.y - x2.y;
-        mContactConstraints[mNbContactManifolds].r2Friction.z = mContactConstraints[mNbContactManifolds].frictionPointBody2.z - x2.z;
-        mContactConstraints[mNbContactManifolds].oldFrictionVector1 = externalManifold.frictionVector1;
-        mContactConstraints[mNbContactManifolds].oldFrictionVector2 = externalManifold.frictionVector2;
+        mContactConstraints[m].frictionPointBody1 /= static_cast<decimal>(mContactConstraints[m].nbContacts);
+        mContactConstraints[m].frictionPointBody2 /= static_cast<decimal>(mContactConstraints[m].nbContacts);
+        mContactConstraints[m].r1Friction.x = mContactConstraints[m].frictionPointBody1.x - x1.x;
+        mContactConstraints[m].r1Friction.y = mContactConstraints[m].frictionPointBody1.y - x1.y;
+        mContactConstraints[m].r1Friction.z = mContactConstraints[m].frictionPointBody1.z - x1.z;
+        mContactConstraints[m].r2Friction.x = mContactConstraints[m].frictionPointBody2.x - x2.x;
+        mContactConstraints[m].r2Friction.y = mContactConstraints[m].frictionPointBody2.y - x2.y;
+        mContactConstraints[m].r2Friction.z = mContactConstraints[m].frictionPointBody2.z - x2.z;
+        mContactConstraints[m].oldFrictionVector1 = externalManifold.frictionVector1;
+        mContactConstraints[m].oldFrictionVector2 = externalManifold.frictionVector2;
 
         // Initialize the accumulated impulses with the previous step accumulated impulses
-        mContactConstraints[mNbContactManifolds].friction1Impulse = externalManifold.frictionImpulse1;
-        mContactConstraints[mNbContactManifolds].friction2Impulse = externalManifold.frictionImpulse2;
-        mContactConstraints[mNbContactManifolds].frictionTwistImpulse = externalManifold.frictionTwistImpulse;
-
-        mContactConstraints[mNbContactManifolds].normal.normalize();
-
-        // deltaVFrictionPoint = v2 + w2.cross(mContactConstraints[mNbContactManifolds].r2Friction) -
-        //                              v1 - w1.cross(mContactConstraints[mNbContactManifolds].r1Friction);
-        Vector3 deltaVFrictionPoint(v2.x + w2.y * mContactConstraints[mNbContactManifolds].r2Friction.z -
-                                    w2.z * mContactConstraints[mNbContactManifolds].r2Friction.y -
-                                      v1.x - w1.y * mContactConstraints[mNbContactManifolds].r1Friction.z +
-                                      w1.z * mContactConstraints[mNbContactManifolds].r1Friction.y,
-                                   v2.y + w2.z * mContactConstraints[mNbContactManifolds].r2Friction.x -
-                                    w2.x * mContactConstraints[mNbContactManifolds].r2Friction.z -
-                                      v1.y - w1.z * mContactConstraints[mNbContactManifolds].r1Friction.x +
-                                      w1.x * mContactConstraints[mNbContactManifolds].r1Friction.z,
-                                   v2.z + w2.x * mContactConstraints[mNbContactManifolds].r2Friction.y -
-                                    w2.y * mContactConstraints[mNbContactManifolds].r2Friction.x -
-                                      v1.z - w1.x * mContactConstraints[mNbContactManifolds].r1Friction.y +
-                                      w1.y * mContactConstraints[mNbContactManifolds].r1Friction.x);
+        mContactConstraints[m].friction1Impulse = externalManifold.frictionImpulse1;
+        mContactConstraints[m].friction2Impulse = externalManifold.frictionImpulse2;
+        mContactConstraints[m].frictionTwistImpulse = externalManifold.frictionTwistImpulse;
+
+        mContactConstraints[m].normal.normalize();
+
+        // deltaVFrictionPoint = v2 + w2.cross(mContactConstraints[m].r2Friction) -
+        //                              v1 - w1.cross(mContactConstraints[m].r1Friction);
+        Vector3 deltaVFrictionPoint(v2.x + w2.y * mContactConstraints[m].r2Friction.z -
+                                    w2.z * mContactConstraints[m].r2Friction.y -
+                                      v1.x - w1.y * mContactConstraints[m].r1Friction.z +
+                                      w1.z * mContactConstraints[m].r1Friction.y,
+                                   v2.y + w2.z * mContactConstraints[m].r2Friction.x -
+                                    w2.x * mContactConstraints[m].r2Friction.z -
+                                      v1.y - w1.z * mContactConstraints[m].r1Friction.x +
+                                      w1.x * mContactConstraints[m].r1Friction.z,
+                                   v2.z + w2.x * mContactConstraints[m].r2Friction.y -
+                                    w2.y * mContactConstraints[m].r2Friction.x -
+                                      v1.z - w1.x * mContactConstraints[m].r1Friction.y +
+                                      w1.y * mContactConstraints[m].r1Friction.x);
 
         // Compute the friction vectors
-        computeFrictionVectors(deltaVFrictionPoint, mContactConstraints[mNbContactManifolds]);
+        computeFrictionVectors(deltaVFrictionPoint, mContactConstraints[m]);
 
         // Compute the inverse mass matrix K for the friction constraints at the center of
         // the contact manifold
-        mContactConstraints[mNbContactManifolds].r1CrossT1 = mContactConstraints[mNbContactManifolds].r1Friction.cross(mContactConstraints[mNbContactManifolds].frictionVector1);
-        mContactConstraints[mNbContactManifolds].r1CrossT2 = mContactConstraints[mNbContactManifolds].r1Friction.cross(mContactConstraints[mNbContactManifolds].frictionVector2);
-        mContactConstraints[mNbContactManifolds].r2CrossT1 = mContactConstraints[mNbContactManifolds].r2Friction.cross(mContactConstraints[mNbContactManifolds].frictionVector1);
-        mContactConstraints[mNbContactManifolds].r2CrossT2 = mContactConstraints[mNbContactManifolds].r2Friction.cross(mContactConstraints[mNbContactManifolds].frictionVector2);
-        decimal friction1Mass = mContactConstraints[mNbContactManifolds].massInverseBody1 + mContactConstraints[mNbContactManifolds].massInverseBody2 +
-                                ((mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody1 * mContactConstraints[mNbContactManifolds].r1CrossT1).cross(mContactConstraints[mNbContactManifolds].r1Friction)).dot(
-                                mContactConstraints[mNbContactManifolds].frictionVector1) +
-                                ((mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 * mContactConstraints[mNbContactManifolds].r2CrossT1).cross(mContactConstraints[mNbContactManifolds].r2Friction)).dot(
-                                mContactConstraints[mNbContactManifolds].frictionVector1);
-        decimal friction2Mass = mContactConstraints[mNbContactManifolds].massInverseBody1 + mContactConstraints[mNbContactManifolds].massInverseBody2 +
-                                ((mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody1 * mContactConstraints[mNbContactManifolds].r1CrossT2).cross(mContactConstraints[mNbContactManifolds].r1Friction)).dot(
-                                mContactConstraints[mNbContactManifolds].frictionVector2) +
-                                ((mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 * mContactConstraints[mNbContactManifolds].r2CrossT2).cross(mContactConstraints[mNbContactManifolds].r2Friction)).dot(
-                                mContactConstraints[mNbContactManifolds].frictionVector2);
-        decimal frictionTwistMass = mContactConstraints[mNbContactManifolds].normal.dot(mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody1 *
-                                       mContactConstraints[mNbContactManifolds].normal) +
-                                    mContactConstraints[mNbContactManifolds].normal.dot(mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 *
-                                       mContactConstraints[mNbContactManifolds].normal);
-        mContactConstraints[mNbContactManifolds].inverseFriction1Mass = friction1Mass > decimal(0.0) ? decimal(1.0) / friction1Mass : decimal(0.0);
-        mContactConstraints[mNbContactManifolds].inverseFriction2Mass = friction2Mass > decimal(0.0) ? decimal(1.0) / friction2Mass : decimal(0.0);
-        mContactConstraints[mNbContactManifolds].inverseTwistFrictionMass = frictionTwistMass > decimal(0.0) ? decimal(1.0) / frictionTwistMass : decimal(0.0);
-
-        mNbContactManifolds++;
+        mContactConstraints[m].r1CrossT1 = mContactConstraints[m].r1Friction.cross(mContactConstraints[m].frictionVector1);
+        mContactConstraints[m].r1CrossT2 = mContactConstraints[m].r1Friction.cross(mContactConstraints[m].frictionVector2);
+        mContactConstraints[m].r2CrossT1 = mContactConstraints[m].r2Friction.cross(mContactConstraints[m].frictionVector1);
+        mContactConstraints[m].r2CrossT2 = mContactConstraints[m].r2Friction.cross(mContactConstraints[m].frictionVector2);
+        decimal friction1Mass = mContactConstraints[m].massInverseBody1 + mContactConstraints[m].massInverseBody2 +
+                                ((mContactConstraints[m].inverseInertiaTensorBody1 * mContactConstraints[m].r1CrossT1).cross(mContactConstraints[m].r1Friction)).dot(
+                                mContactConstraints[m].frictionVector1) +
+                                ((mContactConstraints[m].inverseInertiaTensorBody2 * mContactConstraints[m].r2CrossT1).cross(mContactConstraints[m].r2Friction)).dot(
+                                mContactConstraints[m].frictionVector1);
+        decimal friction2Mass = mContactConstraints[m].massInverseBody1 + mContactConstraints[m].massInverseBody2 +
+                                ((mContactConstraints[m].inverseInertiaTensorBody1 * mContactConstraints[m].r1CrossT2).cross(mContactConstraints[m].r1Friction)).dot(
+                                mContactConstraints[m].frictionVector2) +
+                                ((mContactConstraints[m].inverseInertiaTensorBody2 * mContactConstraints[m].r2CrossT2).cross(mContactConstraints[m].r2Friction)).dot(
+                                mContactConstraints[m].frictionVector2);
+        decimal frictionTwistMass = mContactConstraints[m].normal.dot(mContactConstraints[m].inverseInertiaTensorBody1 *
+                                       mContactConstraints[m].normal) +
+                                    mContactConstraints[m].normal.dot(mContactConstraints[m].inverseInertiaTensorBody2 *
+                                       mContactConstraints[m].normal);
+        mContactConstraints[m].inverseFriction1Mass = friction1Mass > decimal(0.0) ? decimal(1.0) / friction1Mass : decimal(0.0);
+        mContactConstraints[m].inverseFriction2Mass = friction2Mass > decimal(0.0) ? decimal(1.0) / friction2Mass : decimal(0.0);
+        mContactConstraints[m].inverseTwistFrictionMass = frictionTwistMass > decimal(0.0) ? decimal(1.0) / frictionTwistMass : decimal(0.0);
     }
 }
 
@@ -327,152 +355,175 @@ void ContactSolverSystem::warmStart() {
 
     RP3D_PROFILE("ContactSolver::warmStart()", mProfiler);
 
-    uint32 contactPointIndex = 0;
+    warmStartManifolds(0, mNbContactManifolds);
+}
 
-    // For each constraint
-    for (uint32 c=0; c<mNbContactManifolds; c++) {
+// Warm start the contacts of a given island
+void ContactSolverSystem::warmStartIsland(uint32 islandIndex) {
 
-        bool atLeastOneRestingContactPoint = false;
+    warmStartManifolds(mIslands.contactManifoldsIndices[islandIndex], mIslands.nbContactManifolds[islandIndex]);
+}
 
-        for (short int i=0; i<mContactConstraints[c].nbContacts; i++) {
+// Warm start the contact manifolds in the range [startManifoldIndex, startManifoldIndex + nbManifolds)
+void ContactSolverSystem::warmStartManifolds(uint32 startManifoldIndex, uint32 nbManifolds) {
 
-            // If it is not a new contact (this contact was already existing at last time step)
-            if (mContactPoints[contactPointIndex].isRestingContact) {
+    for (uint32 c=startManifoldIndex; c < startManifoldIndex + nbManifolds; c++) {
+        warmStartManifold(c);
+    }
+}
 
-                const uint32 rigidBody1Index = mContactConstraints[c].rigidBodyComponentIndexBody1;
-                const uint32 rigidBody2Index = mContactConstraints[c].rigidBodyComponentIndexBody2;
+// Warm start a single contact manifold
+void ContactSolverSystem::warmStartManifold(uint32 c) {
 
-                atLeastOneRestingContactPoint = true;
+    uint32 contactPointIndex = (*mAllContactManifolds)[c].contactPointsIndex;
 
-                // --------- Penetration --------- //
+    bool atLeastOneRestingContactPoint = false;
 
-                // Update the velocities of the body 1 by applying the impulse P
-                Vector3 impulsePenetration(mContactPoints[contactPointIndex].normal.x * mContactPoints[contactPointIndex].penetrationImpulse,
-                                           mContactPoints[contactPointIndex].normal.y * mContactPoints[contactPointIndex].penetrationImpulse,
-                                           mContactPoints[contactPointIndex].normal.z * mContactPoints[contactPointIndex].penetrationImpulse);
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * impulsePenetration.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * impulsePenetration.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * impulsePenetration.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+    const uint32 rigidBody1Index = mContactConstraints[c].rigidBodyComponentIndexBody1;
+    const uint32 rigidBody2Index = mContactConstraints[c].rigidBodyComponentIndexBody2;
 
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * mContactPoints[contactPointIndex].penetrationImpulse;
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * mContactPoints[contactPointIndex].penetrationImpulse;
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * mContactPoints[contactPointIndex].penetrationImpulse;
+    // Get local copies of the constrained velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index];
 
-                // Update the velocities of the body 2 by applying the impulse P
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * impulsePenetration.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * impulsePenetration.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-                mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * impulsePenetration.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+    for (short int i=0; i<mContactConstraints[c].nbContacts; i++) {
 
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * mContactPoints[contactPointIndex].penetrationImpulse;
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * mContactPoints[contactPointIndex].penetrationImpulse;
-                mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * mContactPoints[contactPointIndex].penetrationImpulse;
-            }
-            else {  // If it is a new contact point
+        // If it is not a new contact (this contact was already existing at last time step)
+        if (mContactPoints[contactPointIndex].isRestingContact) {
 
-                // Initialize the accumulated impulses to zero
-                mContactPoints[contactPointIndex].penetrationImpulse = 0.0;
-            }
+            atLeastOneRestingContactPoint = true;
 
-            contactPointIndex++;
+            // --------- Penetration --------- //
+
+            // Update the velocities of the body 1 by applying the impulse P
+            Vector3 impulsePenetration(mContactPoints[contactPointIndex].normal.x * mContactPoints[contactPointIndex].penetrationImpulse,
+                                       mContactPoints[contactPointIndex].normal.y * mContactPoints[contactPointIndex].penetrationImpulse,
+                                       mContactPoints[contactPointIndex].normal.z * mContactPoints[contactPointIndex].penetrationImpulse);
+            v1.x -= mContactConstraints[c].massInverseBody1 * impulsePenetration.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+            v1.y -= mContactConstraints[c].massInverseBody1 * impulsePenetration.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+            v1.z -= mContactConstraints[c].massInverseBody1 * impulsePenetration.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+
+            w1.x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * mContactPoints[contactPointIndex].penetrationImpulse;
+            w1.y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * mContactPoints[contactPointIndex].penetrationImpulse;
+            w1.z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * mContactPoints[contactPointIndex].penetrationImpulse;
+
+            // Update the velocities of the body 2 by applying the impulse P
+            v2.x += mContactConstraints[c].massInverseBody2 * impulsePenetration.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+            v2.y += mContactConstraints[c].massInverseBody2 * impulsePenetration.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+            v2.z += mContactConstraints[c].massInverseBody2 * impulsePenetration.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+
+            w2.x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * mContactPoints[contactPointIndex].penetrationImpulse;
+            w2.y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * mContactPoints[contactPointIndex].penetrationImpulse;
+            w2.z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * mContactPoints[contactPointIndex].penetrationImpulse;
         }
+        else {  // If it is a new contact point
 
-        // If we solve the friction constraints at the center of the contact manifold and there is
-        // at least one resting contact point in the contact manifold
-        if (atLeastOneRestingContactPoint) {
-
-            // Project the old friction impulses (with old friction vectors) into the new friction
-            // vectors to get the new friction impulses
-            Vector3 oldFrictionImpulse(mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.x +
-                                         mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.x,
-                                       mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.y +
-                                         mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.y,
-                                       mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.z +
-                                         mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.z);
-            mContactConstraints[c].friction1Impulse = oldFrictionImpulse.dot(mContactConstraints[c].frictionVector1);
-            mContactConstraints[c].friction2Impulse = oldFrictionImpulse.dot(mContactConstraints[c].frictionVector2);
-
-            // ------ First friction constraint at the center of the contact manifold ------ //
-
-            // Compute the impulse P = J^T * lambda
-            Vector3 angularImpulseBody1(-mContactConstraints[c].r1CrossT1.x * mContactConstraints[c].friction1Impulse,
-                                        -mContactConstraints[c].r1CrossT1.y * mContactConstraints[c].friction1Impulse,
-                                        -mContactConstraints[c].r1CrossT1.z * mContactConstraints[c].friction1Impulse);
-            Vector3 linearImpulseBody2(mContactConstraints[c].frictionVector1.x * mContactConstraints[c].friction1Impulse,
-                                       mContactConstraints[c].frictionVector1.y * mContactConstraints[c].friction1Impulse,
-                                       mContactConstraints[c].frictionVector1.z * mContactConstraints[c].friction1Impulse);
-            Vector3 angularImpulseBody2(mContactConstraints[c].r2CrossT1.x * mContactConstraints[c].friction1Impulse,
-                                        mContactConstraints[c].r2CrossT1.y * mContactConstraints[c].friction1Impulse,
-                                        mContactConstraints[c].r2CrossT1.z * mContactConstraints[c].friction1Impulse);
-
-            const uint32 rigidBody1Index = mContactConstraints[c].rigidBodyComponentIndexBody1;
-            const uint32 rigidBody2Index = mContactConstraints[c].rigidBodyComponentIndexBody2;
+            // Initialize the accumulated impulses to zero
+            mContactPoints[contactPointIndex].penetrationImpulse = 0.0;
+        }
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index] -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2 * mContactConstraints[c].linearLockAxisFactorBody1;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index] += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
+        contactPointIndex++;
+    }
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index] += mContactConstraints[c].massInverseBody2 * linearImpulseBody2 * mContactConstraints[c].linearLockAxisFactorBody2;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index] += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
-
-            // ------ Second friction constraint at the center of the contact manifold ----- //
-
-            // Compute the impulse P = J^T * lambda
-            angularImpulseBody1.x = -mContactConstraints[c].r1CrossT2.x * mContactConstraints[c].friction2Impulse;
-            angularImpulseBody1.y = -mContactConstraints[c].r1CrossT2.y * mContactConstraints[c].friction2Impulse;
-            angularImpulseBody1.z = -mContactConstraints[c].r1CrossT2.z * mContactConstraints[c].friction2Impulse;
-            linearImpulseBody2.x = mContactConstraints[c].frictionVector2.x * mContactConstraints[c].friction2Impulse;
-            linearImpulseBody2.y = mContactConstraints[c].frictionVector2.y * mContactConstraints[c].friction2Impulse;
-            linearImpulseBody2.z = mContactConstraints[c].frictionVector2.z * mContactConstraints[c].friction2Impulse;
-            angularImpulseBody2.x = mContactConstraints[c].r2CrossT2.x * mContactConstraints[c].friction2Impulse;
-            angularImpulseBody2.y = mContactConstraints[c].r2CrossT2.y * mContactConstraints[c].friction2Impulse;
-            angularImpulseBody2.z = mContactConstraints[c].r2CrossT2.z * mContactConstraints[c].friction2Impulse;
+    // If we solve the friction constraints at the center of the contact manifold and there is
+    // at least one resting contact point in the contact manifold
+    if (atLeastOneRestingContactPoint) {
+
+        // Project the old friction impulses (with old friction vectors) into the new friction
+        // vectors to get the new friction impulses
+        Vector3 oldFrictionImpulse(mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.x +
+                                     mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.x,
+                                   mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.y +
+                                     mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.y,
+                                   mContactConstraints[c].friction1Impulse * mContactConstraints[c].oldFrictionVector1.z +
+                                     mContactConstraints[c].friction2Impulse * mContactConstraints[c].oldFrictionVector2.z);
+        mContactConstraints[c].friction1Impulse = oldFrictionImpulse.dot(mContactConstraints[c].frictionVector1);
+        mContactConstraints[c].friction2Impulse = oldFrictionImpulse.dot(mContactConstraints[c].frictionVector2);
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+        // ------ First friction constraint at the center of the contact manifold ------ //
 
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index] += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
+        // Compute the impulse P = J^T * lambda
+        Vector3 angularImpulseBody1(-mContactConstraints[c].r1CrossT1.x * mContactConstraints[c].friction1Impulse,
+                                    -mContactConstraints[c].r1CrossT1.y * mContactConstraints[c].friction1Impulse,
+                                    -mContactConstraints[c].r1CrossT1.z * mContactConstraints[c].friction1Impulse);
+        Vector3 linearImpulseBody2(mContactConstraints[c].frictionVector1.x * mContactConstraints[c].friction1Impulse,
+                                   mContactConstraints[c].frictionVector1.y * mContactConstraints[c].friction1Impulse,
+                                   mContactConstraints[c].frictionVector1.z * mContactConstraints[c].friction1Impulse);
+        Vector3 angularImpulseBody2(mContactConstraints[c].r2CrossT1.x * mContactConstraints[c].friction1Impulse,
+                                    mContactConstraints[c].r2CrossT1.y * mContactConstraints[c].friction1Impulse,
+                                    mContactConstraints[c].r2CrossT1.z * mContactConstraints[c].friction1Impulse);
 
-            // Update the velocities of the body 2 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+        // Update the velocities of the body 1 by applying the impulse P
+        v1 -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2 * mContactConstraints[c].linearLockAxisFactorBody1;
+        w1 += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
 
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index] += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+        // Update the velocities of the body 1 by applying the impulse P
+        v2 += mContactConstraints[c].massInverseBody2 * linearImpulseBody2 * mContactConstraints[c].linearLockAxisFactorBody2;
+        w2 += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
 
-            // ------ Twist friction constraint at the center of the contact manifold ------ //
+        // ------ Second friction constraint at the center of the contact manifold ----- //
 
-            // Compute the impulse P = J^T * lambda
-            angularImpulseBody1.x = -mContactConstraints[c].normal.x * mContactConstraints[c].frictionTwistImpulse;
-            angularImpulseBody1.y = -mContactConstraints[c].normal.y * mContactConstraints[c].frictionTwistImpulse;
-            angularImpulseBody1.z = -mContactConstraints[c].normal.z * mContactConstraints[c].frictionTwistImpulse;
+        // Compute the impulse P = J^T * lambda
+        angularImpulseBody1.x = -mContactConstraints[c].r1CrossT2.x * mContactConstraints[c].friction2Impulse;
+        angularImpulseBody1.y = -mContactConstraints[c].r1CrossT2.y * mContactConstraints[c].friction2Impulse;
+        angularImpulseBody1.z = -mContactConstraints[c].r1CrossT2.z * mContactConstraints[c].friction2Impulse;
+        linearImpulseBody2.x = mContactConstraints[c].frictionVector2.x * mContactConstraints[c].friction2Impulse;
+        linearImpulseBody2.y = mContactConstraints[c].frictionVector2.y * mContactConstraints[c].friction2Impulse;
+        linearImpulseBody2.z = mContactConstraints[c].frictionVector2.z * mContactConstraints[c].friction2Impulse;
+        angularImpulseBody2.x = mContactConstraints[c].r2CrossT2.x * mContactConstraints[c].friction2Impulse;
+        angularImpulseBody2.y = mContactConstraints[c].r2CrossT2.y * mContactConstraints[c].friction2Impulse;
+        angularImpulseBody2.z = mContactConstraints[c].r2CrossT2.z * mContactConstraints[c].friction2Impulse;
 
-            angularImpulseBody2.x = mContactConstraints[c].normal.x * mContactConstraints[c].frictionTwistImpulse;
-            angularImpulseBody2.y = mContactConstraints[c].normal.y * mContactConstraints[c].frictionTwistImpulse;
-            angularImpulseBody2.z = mContactConstraints[c].normal.z * mContactConstraints[c].frictionTwistImpulse;
+        // Update the velocities of the body 1 by applying the impulse P
+        v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+        v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+        v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index] += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 *  angularImpulseBody1);
+        w1 += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
 
-            // Update the velocities of the body 2 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index] += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+        // Update the velocities of the body 2 by applying the impulse P
+        v2.x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+        v2.y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+        v2.z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index] -= mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2);
+        w2 += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index] += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
-        }
-        else {  // If it is a new contact manifold
+        // ------ Twist friction constraint at the center of the contact manifold ------ //
 
-            // Initialize the accumulated impulses to zero
-            mContactConstraints[c].friction1Impulse = 0.0;
-            mContactConstraints[c].friction2Impulse = 0.0;
-            mContactConstraints[c].frictionTwistImpulse = 0.0;
-        }
+        // Compute the impulse P = J^T * lambda
+        angularImpulseBody1.x = -mContactConstraints[c].normal.x * mContactConstraints[c].frictionTwistImpulse;
+        angularImpulseBody1.y = -mContactConstraints[c].normal.y * mContactConstraints[c].frictionTwistImpulse;
+        angularImpulseBody1.z = -mContactConstraints[c].normal.z * mContactConstraints[c].frictionTwistImpulse;
+
+        angularImpulseBody2.x = mContactConstraints[c].normal.x * mContactConstraints[c].frictionTwistImpulse;
+        angularImpulseBody2.y = mContactConstraints[c].normal.y * mContactConstraints[c].frictionTwistImpulse;
+        angularImpulseBody2.z = mContactConstraints[c].normal.z * mContactConstraints[c].frictionTwistImpulse;
+
+        // Update the velocities of the body 1 by applying the impulse P
+        w1 += mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 *  angularImpulseBody1);
+
+        // Update the velocities of the body 2 by applying the impulse P
+        w2 += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+
+        // Update the velocities of the body 1 by applying the impulse P
+        w1 -= mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2);
+
+        // Update the velocities of the body 1 by applying the impulse P
+        w2 += mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+    }
+    else {  // If it is a new contact manifold
+
+        // Initialize the accumulated impulses to zero
+        mContactConstraints[c].friction1Impulse = 0.0;
+        mContactConstraints[c].friction2Impulse = 0.0;
+        mContactConstraints[c].frictionTwistImpulse = 0.0;
     }
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody1Index, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody2Index, v2, w2);
 }
 
 // Solve the contacts
@@ -480,290 +531,881 @@ void ContactSolverSystem::solve() {
 
     RP3D_PROFILE("ContactSolverSystem::solve()", mProfiler);
 
+    solveManifolds(0, mNbContactManifolds);
+}
+
+// Solve the contacts of a given island
+void ContactSolverSystem::solveIsland(uint32 islandIndex) {
+
+    solveManifolds(mIslands.contactManifoldsIndices[islandIndex], mIslands.nbContactManifolds[islandIndex]);
+}
+
+// Solve the contact manifolds in the range [startManifoldIndex, startManifoldIndex + nbManifolds)
+void ContactSolverSystem::solveManifolds(uint32 startManifoldIndex, uint32 nbManifolds) {
+
+    for (uint32 c=startManifoldIndex; c < startManifoldIndex + nbManifolds; c++) {
+        solveManifold(c);
+    }
+}
+
+// Solve a single contact manifold
+void ContactSolverSystem::solveManifold(uint32 c) {
+
     decimal deltaLambda;
     decimal lambdaTemp;
-    uint32 contactPointIndex = 0;
+    uint32 contactPointIndex = (*mAllContactManifolds)[c].contactPointsIndex;
 
     const decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
 
+    decimal sumPenetrationImpulse = 0.0;
+
+    const uint32 rigidBody1Index = mContactConstraints[c].rigidBodyComponentIndexBody1;
+    const uint32 rigidBody2Index = mContactConstraints[c].rigidBodyComponentIndexBody2;
+
+    // Get local copies of the constrained velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index];
+
+    // Get local copies of the split velocities
+    Vector3 v1Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index];
+    Vector3 w1Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index];
+    Vector3 v2Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index];
+    Vector3 w2Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index];
+
+    for (short int i=0; i<mContactConstraints[c].nbContacts; i++) {
+
+        // --------- Penetration --------- //
+
+        // Compute J*v
+        //Vector3 deltaV = v2 + w2.cross(mContactPoints[contactPointIndex].r2) - v1 - w1.cross(mContactPoints[contactPointIndex].r1);
+        Vector3 deltaV(v2.x + w2.y * mContactPoints[contactPointIndex].r2.z - w2.z * mContactPoints[contactPointIndex].r2.y - v1.x -
+                       w1.y * mContactPoints[contactPointIndex].r1.z + w1.z * mContactPoints[contactPointIndex].r1.y,
+                       v2.y + w2.z * mContactPoints[contactPointIndex].r2.x - w2.x * mContactPoints[contactPointIndex].r2.z - v1.y -
+                       w1.z * mContactPoints[contactPointIndex].r1.x + w1.x * mContactPoints[contactPointIndex].r1.z,
+                       v2.z + w2.x * mContactPoints[contactPointIndex].r2.y - w2.y * mContactPoints[contactPointIndex].r2.x - v1.z -
+                       w1.x * mContactPoints[contactPointIndex].r1.y + w1.y * mContactPoints[contactPointIndex].r1.x);
+        decimal deltaVDotN = deltaV.x * mContactPoints[contactPointIndex].normal.x + deltaV.y * mContactPoints[contactPointIndex].normal.y +
+                             deltaV.z * mContactPoints[contactPointIndex].normal.z;
+        decimal Jv = deltaVDotN;
+
+        // Compute the bias "b" of the constraint
+        decimal biasPenetrationDepth = 0.0;
+        if (mContactPoints[contactPointIndex].penetrationDepth > SLOP) {
+            biasPenetrationDepth = -(beta/mTimeStep) * std::max(0.0f, float(mContactPoints[contactPointIndex].penetrationDepth - SLOP));
+        }
+        decimal b = biasPenetrationDepth + mContactPoints[contactPointIndex].restitutionBias;
+
+        // Compute the Lagrange multiplier lambda
+        if (mIsSplitImpulseActive) {
+            deltaLambda = - (Jv + mContactPoints[contactPointIndex].restitutionBias) *
+                    mContactPoints[contactPointIndex].inversePenetrationMass;
+        }
+        else {
+            deltaLambda = - (Jv + b) * mContactPoints[contactPointIndex].inversePenetrationMass;
+        }
+        lambdaTemp = mContactPoints[contactPointIndex].penetrationImpulse;
+        mContactPoints[contactPointIndex].penetrationImpulse = std::max(mContactPoints[contactPointIndex].penetrationImpulse +
+                                                   deltaLambda, decimal(0.0));
+        deltaLambda = mContactPoints[contactPointIndex].penetrationImpulse - lambdaTemp;
+
+        Vector3 linearImpulse(mContactPoints[contactPointIndex].normal.x * deltaLambda,
+                              mContactPoints[contactPointIndex].normal.y * deltaLambda,
+                              mContactPoints[contactPointIndex].normal.z * deltaLambda);
+
+        // Update the velocities of the body 1 by applying the impulse P
+        v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+        v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+        v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+
+        w1.x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * deltaLambda;
+        w1.y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * deltaLambda;
+        w1.z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * deltaLambda;
+
+        // Update the velocities of the body 2 by applying the impulse P
+        v2.x += mContactConstraints[c].massInverseBody2 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+        v2.y += mContactConstraints[c].massInverseBody2 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+        v2.z += mContactConstraints[c].massInverseBody2 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+
+        w2.x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * deltaLambda;
+        w2.y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * deltaLambda;
+        w2.z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * deltaLambda;
+
+        sumPenetrationImpulse += mContactPoints[contactPointIndex].penetrationImpulse;
+
+        // If the split impulse position correction is active
+        if (mIsSplitImpulseActive) {
+
+            // Split impulse (position correction)
+            //Vector3 deltaVSplit = v2Split + w2Split.cross(mContactPoints[contactPointIndex].r2) - v1Split - w1Split.cross(mContactPoints[contactPointIndex].r1);
+            Vector3 deltaVSplit(v2Split.x + w2Split.y * mContactPoints[contactPointIndex].r2.z - w2Split.z * mContactPoints[contactPointIndex].r2.y - v1Split.x -
+                                w1Split.y * mContactPoints[contactPointIndex].r1.z + w1Split.z * mContactPoints[contactPointIndex].r1.y,
+                                v2Split.y + w2Split.z * mContactPoints[contactPointIndex].r2.x - w2Split.x * mContactPoints[contactPointIndex].r2.z - v1Split.y -
+                                w1Split.z * mContactPoints[contactPointIndex].r1.x + w1Split.x * mContactPoints[contactPointIndex].r1.z,
+                                v2Split.z + w2Split.x * mContactPoints[contactPointIndex].r2.y - w2Split.y * mContactPoints[contactPointIndex].r2.x - v1Split.z -
+                                w1Split.x * mContactPoints[contactPointIndex].r1.y + w1Split.y * mContactPoints[contactPointIndex].r1.x);
+            decimal JvSplit = deltaVSplit.x * mContactPoints[contactPointIndex].normal.x +
+                              deltaVSplit.y * mContactPoints[contactPointIndex].normal.y +
+                              deltaVSplit.z * mContactPoints[contactPointIndex].normal.z;
+            decimal deltaLambdaSplit = - (JvSplit + biasPenetrationDepth) *
+                    mContactPoints[contactPointIndex].inversePenetrationMass;
+            decimal lambdaTempSplit = mContactPoints[contactPointIndex].penetrationSplitImpulse;
+            mContactPoints[contactPointIndex].penetrationSplitImpulse = std::max(
+                        mContactPoints[contactPointIndex].penetrationSplitImpulse +
+                        deltaLambdaSplit, decimal(0.0));
+            deltaLambdaSplit = mContactPoints[contactPointIndex].penetrationSplitImpulse - lambdaTempSplit;
+
+            Vector3 linearImpulse(mContactPoints[contactPointIndex].normal.x * deltaLambdaSplit,
+                                  mContactPoints[contactPointIndex].normal.y * deltaLambdaSplit,
+                                  mContactPoints[contactPointIndex].normal.z * deltaLambdaSplit);
+
+            // Update the velocities of the body 1 by applying the impulse P
+            v1Split.x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+            v1Split.y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+            v1Split.z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+
+            w1Split.x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * deltaLambdaSplit;
+            w1Split.y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * deltaLambdaSplit;
+            w1Split.z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * deltaLambdaSplit;
+
+            // Update the velocities of the body 1 by applying the impulse P
+            v2Split.x += mContactConstraints[c].massInverseBody2 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+            v2Split.y += mContactConstraints[c].massInverseBody2 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+            v2Split.z += mContactConstraints[c].massInverseBody2 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+
+            w2Split.x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * deltaLambdaSplit;
+            w2Split.y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * deltaLambdaSplit;
+            w2Split.z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * deltaLambdaSplit;
+        }
+
+        contactPointIndex++;
+    }
+
+    // ------ First friction constraint at the center of the contact manifold ------ //
+
+    // Compute J*v
+    // deltaV = v2 + w2.cross(mContactConstraints[c].r2Friction) - v1 - w1.cross(mContactConstraints[c].r1Friction);
+    Vector3 deltaV(v2.x + w2.y * mContactConstraints[c].r2Friction.z - w2.z * mContactConstraints[c].r2Friction.y - v1.x -
+                   w1.y * mContactConstraints[c].r1Friction.z + w1.z * mContactConstraints[c].r1Friction.y,
+
+                   v2.y + w2.z * mContactConstraints[c].r2Friction.x - w2.x * mContactConstraints[c].r2Friction.z - v1.y -
+                   w1.z * mContactConstraints[c].r1Friction.x + w1.x * mContactConstraints[c].r1Friction.z,
+
+                   v2.z + w2.x * mContactConstraints[c].r2Friction.y - w2.y * mContactConstraints[c].r2Friction.x - v1.z -
+                   w1.x * mContactConstraints[c].r1Friction.y + w1.y * mContactConstraints[c].r1Friction.x);
+    decimal Jv = deltaV.x * mContactConstraints[c].frictionVector1.x +
+                 deltaV.y * mContactConstraints[c].frictionVector1.y +
+                 deltaV.z * mContactConstraints[c].frictionVector1.z;
+
+    // Compute the Lagrange multiplier lambda
+    deltaLambda = -Jv * mContactConstraints[c].inverseFriction1Mass;
+    decimal frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
+    lambdaTemp = mContactConstraints[c].friction1Impulse;
+    mContactConstraints[c].friction1Impulse = std::max(-frictionLimit,
+                                                std::min(mContactConstraints[c].friction1Impulse +
+                                                         deltaLambda, frictionLimit));
+    deltaLambda = mContactConstraints[c].friction1Impulse - lambdaTemp;
+
+    // Compute the impulse P=J^T * lambda
+    Vector3 angularImpulseBody1(-mContactConstraints[c].r1CrossT1.x * deltaLambda,
+                                -mContactConstraints[c].r1CrossT1.y * deltaLambda,
+                                -mContactConstraints[c].r1CrossT1.z * deltaLambda);
+    Vector3 linearImpulseBody2(mContactConstraints[c].frictionVector1.x * deltaLambda,
+                               mContactConstraints[c].frictionVector1.y * deltaLambda,
+                               mContactConstraints[c].frictionVector1.z * deltaLambda);
+    Vector3 angularImpulseBody2(mContactConstraints[c].r2CrossT1.x * deltaLambda,
+                                mContactConstraints[c].r2CrossT1.y * deltaLambda,
+                                mContactConstraints[c].r2CrossT1.z * deltaLambda);
+
+    // Update the velocities of the body 1 by applying the impulse P
+    v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+    v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+    v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+
+    Vector3 angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
+    w1.x += angularVelocity1.x;
+    w1.y += angularVelocity1.y;
+    w1.z += angularVelocity1.z;
+
+    // Update the velocities of the body 2 by applying the impulse P
+    v2.x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+    v2.y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+    v2.z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+
+    Vector3 angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+    w2.x += angularVelocity2.x;
+    w2.y += angularVelocity2.y;
+    w2.z += angularVelocity2.z;
+
+    // ------ Second friction constraint at the center of the contact manifold ----- //
+
+    // Compute J*v
+    //deltaV = v2 + w2.cross(mContactConstraints[c].r2Friction) - v1 - w1.cross(mContactConstraints[c].r1Friction);
+    deltaV.x = v2.x + w2.y * mContactConstraints[c].r2Friction.z - w2.z * mContactConstraints[c].r2Friction.y  - v1.x -
+               w1.y * mContactConstraints[c].r1Friction.z + w1.z * mContactConstraints[c].r1Friction.y;
+    deltaV.y = v2.y + w2.z * mContactConstraints[c].r2Friction.x - w2.x * mContactConstraints[c].r2Friction.z  - v1.y -
+               w1.z * mContactConstraints[c].r1Friction.x + w1.x * mContactConstraints[c].r1Friction.z;
+    deltaV.z = v2.z + w2.x * mContactConstraints[c].r2Friction.y - w2.y * mContactConstraints[c].r2Friction.x  - v1.z -
+               w1.x * mContactConstraints[c].r1Friction.y + w1.y * mContactConstraints[c].r1Friction.x;
+    Jv = deltaV.x * mContactConstraints[c].frictionVector2.x + deltaV.y * mContactConstraints[c].frictionVector2.y +
+         deltaV.z * mContactConstraints[c].frictionVector2.z;
+
+    // Compute the Lagrange multiplier lambda
+    deltaLambda = -Jv * mContactConstraints[c].inverseFriction2Mass;
+    frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
+    lambdaTemp = mContactConstraints[c].friction2Impulse;
+    mContactConstraints[c].friction2Impulse = std::max(-frictionLimit,
+                                                std::min(mContactConstraints[c].friction2Impulse +
+                                                         deltaLambda, frictionLimit));
+    deltaLambda = mContactConstraints[c].friction2Impulse - lambdaTemp;
+
+    // Compute the impulse P=J^T * lambda
+    angularImpulseBody1.x = -mContactConstraints[c].r1CrossT2.x * deltaLambda;
+    angularImpulseBody1.y = -mContactConstraints[c].r1CrossT2.y * deltaLambda;
+    angularImpulseBody1.z = -mContactConstraints[c].r1CrossT2.z * deltaLambda;
+
+    linearImpulseBody2.x = mContactConstraints[c].frictionVector2.x * deltaLambda;
+    linearImpulseBody2.y = mContactConstraints[c].frictionVector2.y * deltaLambda;
+    linearImpulseBody2.z = mContactConstraints[c].frictionVector2.z * deltaLambda;
+
+    angularImpulseBody2.x = mContactConstraints[c].r2CrossT2.x * deltaLambda;
+    angularImpulseBody2.y = mContactConstraints[c].r2CrossT2.y * deltaLambda;
+    angularImpulseBody2.z = mContactConstraints[c].r2CrossT2.z * deltaLambda;
+
+    // Update the velocities of the body 1 by applying the impulse P
+    v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
+    v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
+    v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+
+    angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
+    w1.x += angularVelocity1.x;
+    w1.y += angularVelocity1.y;
+    w1.z += angularVelocity1.z;
+
+    // Update the velocities of the body 2 by applying the impulse P
+    v2.x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
+    v2.y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
+    v2.z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+
+    angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+    w2.x += angularVelocity2.x;
+    w2.y += angularVelocity2.y;
+    w2.z += angularVelocity2.z;
+
+    // ------ Twist friction constraint at the center of the contact manifol ------ //
+
+    // Compute J*v
+    deltaV = w2 - w1;
+    Jv = deltaV.x * mContactConstraints[c].normal.x + deltaV.y * mContactConstraints[c].normal.y +
+         deltaV.z * mContactConstraints[c].normal.z;
+
+    deltaLambda = -Jv * (mContactConstraints[c].inverseTwistFrictionMass);
+    frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
+    lambdaTemp = mContactConstraints[c].frictionTwistImpulse;
+    mContactConstraints[c].frictionTwistImpulse = std::max(-frictionLimit,
+                                                    std::min(mContactConstraints[c].frictionTwistImpulse
+                                                             + deltaLambda, frictionLimit));
+    deltaLambda = mContactConstraints[c].frictionTwistImpulse - lambdaTemp;
+
+    // Compute the impulse P=J^T * lambda
+    angularImpulseBody2.x = mContactConstraints[c].normal.x * deltaLambda;
+    angularImpulseBody2.y = mContactConstraints[c].normal.y * deltaLambda;
+    angularImpulseBody2.z = mContactConstraints[c].normal.z * deltaLambda;
+
+    // Update the velocities of the body 1 by applying the impulse P
+    angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2);
+    w1.x -= angularVelocity1.x;
+    w1.y -= angularVelocity1.y;
+    w1.z -= angularVelocity1.z;
+
+    // Update the velocities of the body 1 by applying the impulse P
+    angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
+    w2.x += angularVelocity2.x;
+    w2.y += angularVelocity2.y;
+    w2.z += angularVelocity2.z;
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody1Index, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody2Index, v2, w2);
+
+    if (mIsSplitImpulseActive) {
+        mRigidBodyComponents.updateSplitVelocitiesOfDynamicBody(rigidBody1Index, v1Split, w1Split);
+        mRigidBodyComponents.updateSplitVelocitiesOfDynamicBody(rigidBody2Index, v2Split, w2Split);
+    }
+}
+
+// Initialize and warm start the contacts of a large island partitioned into colors
+/// The contact manifolds of a color do not share any dynamic body and are therefore solved in parallel.
+/// The static and kinematic bodies are ignored by the coloring because the solver never changes their
+/// velocities (otherwise the contacts with the ground would all be in different colors). The colors
+/// only depend on the order of the contact manifolds and the results therefore do not depend on the
+/// number of workers of the task scheduler. Only a single island can be colored at a time.
+void ContactSolverSystem::initializeForColoredIsland(uint32 islandIndex) {
+
+    RP3D_PROFILE("ContactSolverSystem::initializeForColoredIsland()", mProfiler);
+
+    const uint32 startManifoldIndex = mIslands.contactManifoldsIndices[islandIndex];
+    const uint32 nbManifolds = mIslands.nbContactManifolds[islandIndex];
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+    // The batches of the previous colored island use the colors that are computed again below
+    storeColorsBatchesImpulses();
+
+#endif
+
+    // Initialize the contact manifolds in parallel
+    mTaskScheduler.parallelFor(nbManifolds, PARALLEL_COLOR_CHUNK_SIZE, [this, startManifoldIndex](const TaskScheduler::TaskRange& range) {
+        initializeManifolds(startManifoldIndex + range.startIndex, range.endIndex - range.startIndex);
+    });
+
+    computeColors(startManifoldIndex, nbManifolds);
+
+    // Warm start the colors
+    for (uint32 c=0; c < NB_MAX_PARALLEL_COLORS + 1; c++) {
+        solveColor(c, true);
+    }
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+    if (mIsSimdSolverEnabled) {
+        initializeColorsBatches();
+    }
+
+#endif
+}
+
+// Solve the contacts of the colored island
+void ContactSolverSystem::solveColoredIsland() {
+
+    RP3D_PROFILE("ContactSolverSystem::solveColoredIsland()", mProfiler);
+
+    for (uint32 c=0; c < NB_MAX_PARALLEL_COLORS + 1; c++) {
+        solveColor(c, false);
+    }
+}
+
+// Partition the contact manifolds in the range [startManifoldIndex, startManifoldIndex + nbManifolds) into colors
+/// Each contact manifold gets the first color that is not already used by one of its dynamic bodies.
+void ContactSolverSystem::computeColors(uint32 startManifoldIndex, uint32 nbManifolds) {
+
+    RP3D_PROFILE("ContactSolverSystem::computeColors()", mProfiler);
+
+    const uint32 nbColors = NB_MAX_PARALLEL_COLORS + 1;
+
+    const uint32 nbBodies = mRigidBodyComponents.getNbComponents();
+    mBodiesColorsMasks.reserve(nbBodies);
+    while (mBodiesColorsMasks.size() < nbBodies) {
+        mBodiesColorsMasks.add(0);
+    }
+
+    mManifoldsColor.clear();
+    mManifoldsColor.reserve(nbManifolds);
+    mColorsStartIndex.clear();
+    mColorsStartIndex.reserve(nbColors + 1);
+    for (uint32 c=0; c <= nbColors; c++) {
+        mColorsStartIndex.add(0);
+    }
+
     // For each contact manifold
-    for (uint32 c=0; c<mNbContactManifolds; c++) {
+    for (uint32 m=startManifoldIndex; m < startManifoldIndex + nbManifolds; m++) {
 
-        decimal sumPenetrationImpulse = 0.0;
+        const uint32 rigidBody1Index = mContactConstraints[m].rigidBodyComponentIndexBody1;
+        const uint32 rigidBody2Index = mContactConstraints[m].rigidBodyComponentIndexBody2;
+        const bool isBody1Dynamic = mRigidBodyComponents.mBodyTypes[rigidBody1Index] == BodyType::DYNAMIC;
+        const bool isBody2Dynamic = mRigidBodyComponents.mBodyTypes[rigidBody2Index] == BodyType::DYNAMIC;
 
-        const uint32 rigidBody1Index = mContactConstraints[c].rigidBodyComponentIndexBody1;
-        const uint32 rigidBody2Index = mContactConstraints[c].rigidBodyComponentIndexBody2;
+        uint64 usedColors = 0;
+        if (isBody1Dynamic) usedColors |= mBodiesColorsMasks[rigidBody1Index];
+        if (isBody2Dynamic) usedColors |= mBodiesColorsMasks[rigidBody2Index];
 
-        // Get the constrained velocities
-        const Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index];
-        const Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index];
-        const Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index];
-        const Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index];
+        // Find the first color that is not used by the dynamic bodies
+        uint32 color = 0;
+        while (color < NB_MAX_PARALLEL_COLORS && (usedColors & (uint64(1) << color)) != 0) {
+            color++;
+        }
 
-        for (short int i=0; i<mContactConstraints[c].nbContacts; i++) {
+        if (color < NB_MAX_PARALLEL_COLORS) {
+            if (isBody1Dynamic) mBodiesColorsMasks[rigidBody1Index] |= uint64(1) << color;
+            if (isBody2Dynamic) mBodiesColorsMasks[rigidBody2Index] |= uint64(1) << color;
+        }
 
-            // --------- Penetration --------- //
+        mManifoldsColor.add(static_cast<uint8>(color));
+        mColorsStartIndex[color + 1]++;
+    }
 
-            // Compute J*v
-            //Vector3 deltaV = v2 + w2.cross(mContactPoints[contactPointIndex].r2) - v1 - w1.cross(mContactPoints[contactPointIndex].r1);
-            Vector3 deltaV(v2.x + w2.y * mContactPoints[contactPointIndex].r2.z - w2.z * mContactPoints[contactPointIndex].r2.y - v1.x -
-                           w1.y * mContactPoints[contactPointIndex].r1.z + w1.z * mContactPoints[contactPointIndex].r1.y,
-                           v2.y + w2.z * mContactPoints[contactPointIndex].r2.x - w2.x * mContactPoints[contactPointIndex].r2.z - v1.y -
-                           w1.z * mContactPoints[contactPointIndex].r1.x + w1.x * mContactPoints[contactPointIndex].r1.z,
-                           v2.z + w2.x * mContactPoints[contactPointIndex].r2.y - w2.y * mContactPoints[contactPointIndex].r2.x - v1.z -
-                           w1.x * mContactPoints[contactPointIndex].r1.y + w1.y * mContactPoints[contactPointIndex].r1.x);
-            decimal deltaVDotN = deltaV.x * mContactPoints[contactPointIndex].normal.x + deltaV.y * mContactPoints[contactPointIndex].normal.y +
-                                 deltaV.z * mContactPoints[contactPointIndex].normal.z;
-            decimal Jv = deltaVDotN;
-
-            // Compute the bias "b" of the constraint
-            decimal biasPenetrationDepth = 0.0;
-            if (mContactPoints[contactPointIndex].penetrationDepth > SLOP) {
-                biasPenetrationDepth = -(beta/mTimeStep) * std::max(0.0f, float(mContactPoints[contactPointIndex].penetrationDepth - SLOP));
+    // Reset the colors of the bodies
+    for (uint32 m=startManifoldIndex; m < startManifoldIndex + nbManifolds; m++) {
+        mBodiesColorsMasks[mContactConstraints[m].rigidBodyComponentIndexBody1] = 0;
+        mBodiesColorsMasks[mContactConstraints[m].rigidBodyComponentIndexBody2] = 0;
+    }
+
+    // Compute the start index of each color
+    for (uint32 c=0; c < nbColors; c++) {
+        mColorsStartIndex[c + 1] += mColorsStartIndex[c];
+    }
+
+    // Group the contact manifolds by color (keeping their order inside a color)
+    mColorsManifolds.clear();
+    mColorsManifolds.addWithoutInit(nbManifolds);
+    for (uint32 i=0; i < nbManifolds; i++) {
+        mColorsManifolds[mColorsStartIndex[mManifoldsColor[i]]++] = startManifoldIndex + i;
+    }
+
+    // Restore the start index of each color
+    for (uint32 c=nbColors; c > 0; c--) {
+        mColorsStartIndex[c] = mColorsStartIndex[c - 1];
+    }
+    mColorsStartIndex[0] = 0;
+}
+
+// Warm start or solve the contact manifolds of a color
+void ContactSolverSystem::solveColor(uint32 colorIndex, bool isWarmStart) {
+
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+
+    // Solve the batches of the color with SIMD instructions
+    if (mIsSimdSolverEnabled && !isWarmStart && colorIndex < NB_MAX_PARALLEL_COLORS) {
+
+        const uint32 startBatchIndex = mColorsBatchesStartIndex[colorIndex];
+        const uint32 nbBatches = mColorsBatchesStartIndex[colorIndex + 1] - startBatchIndex;
+        const uint32 batchesChunkSize = std::max(PARALLEL_COLOR_CHUNK_SIZE / SimdDecimal::NB_LANES, uint32(1));
+
+        mTaskScheduler.parallelFor(nbBatches, batchesChunkSize, [this, startBatchIndex](const TaskScheduler::TaskRange& range) {
+
+            for (uint32 b=startBatchIndex + range.startIndex; b < startBatchIndex + range.endIndex; b++) {
+                solveBatch(mColorsBatches[b]);
             }
-            decimal b = biasPenetrationDepth + mContactPoints[contactPointIndex].restitutionBias;
+        });
+
+        return;
+    }
+
+#endif
 
-            // Compute the Lagrange multiplier lambda
-            if (mIsSplitImpulseActive) {
-                deltaLambda = - (Jv + mContactPoints[contactPointIndex].restitutionBias) *
-                        mContactPoints[contactPointIndex].inversePenetrationMass;
+    const uint32 startIndex = mColorsStartIndex[colorIndex];
+    const uint32 nbManifolds = mColorsStartIndex[colorIndex + 1] - startIndex;
+
+    // The manifolds of the last color can share bodies and are solved sequentially
+    const uint32 chunkSize = colorIndex < NB_MAX_PARALLEL_COLORS ? PARALLEL_COLOR_CHUNK_SIZE : std::max(nbManifolds, uint32(1));
+
+    mTaskScheduler.parallelFor(nbManifolds, chunkSize, [this, startIndex, isWarmStart](const TaskScheduler::TaskRange& range) {
+
+        for (uint32 i=startIndex + range.startIndex; i < startIndex + range.endIndex; i++) {
+
+            if (isWarmStart) {
+                warmStartManifold(mColorsManifolds[i]);
             }
             else {
-                deltaLambda = - (Jv + b) * mContactPoints[contactPointIndex].inversePenetrationMass;
+                solveManifold(mColorsManifolds[i]);
             }
-            lambdaTemp = mContactPoints[contactPointIndex].penetrationImpulse;
-            mContactPoints[contactPointIndex].penetrationImpulse = std::max(mContactPoints[contactPointIndex].penetrationImpulse +
-                                                       deltaLambda, decimal(0.0));
-            deltaLambda = mContactPoints[contactPointIndex].penetrationImpulse - lambdaTemp;
+        }
+    });
+}
 
-            Vector3 linearImpulse(mContactPoints[contactPointIndex].normal.x * deltaLambda,
-                                  mContactPoints[contactPointIndex].normal.y * deltaLambda,
-                                  mContactPoints[contactPointIndex].normal.z * deltaLambda);
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
 
-            // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+// Group the contact manifolds of the colors into batches solved with SIMD instructions
+/// The manifolds of a color never share a dynamic body and can therefore be solved in different
+/// lanes at the same time. The manifolds of the last color can share bodies and are not batched.
+/// This method is called after the warm starting because it copies the accumulated impulses.
+void ContactSolverSystem::initializeColorsBatches() {
 
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * deltaLambda;
+    RP3D_PROFILE("ContactSolverSystem::initializeColorsBatches()", mProfiler);
 
-            // Update the velocities of the body 2 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
-
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * deltaLambda;
-
-            sumPenetrationImpulse += mContactPoints[contactPointIndex].penetrationImpulse;
-
-            // If the split impulse position correction is active
-            if (mIsSplitImpulseActive) {
-
-                // Split impulse (position correction)
-                const Vector3& v1Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index];
-                const Vector3& w1Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index];
-                const Vector3& v2Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index];
-                const Vector3& w2Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index];
-
-                //Vector3 deltaVSplit = v2Split + w2Split.cross(mContactPoints[contactPointIndex].r2) - v1Split - w1Split.cross(mContactPoints[contactPointIndex].r1);
-                Vector3 deltaVSplit(v2Split.x + w2Split.y * mContactPoints[contactPointIndex].r2.z - w2Split.z * mContactPoints[contactPointIndex].r2.y - v1Split.x -
-                                    w1Split.y * mContactPoints[contactPointIndex].r1.z + w1Split.z * mContactPoints[contactPointIndex].r1.y,
-                                    v2Split.y + w2Split.z * mContactPoints[contactPointIndex].r2.x - w2Split.x * mContactPoints[contactPointIndex].r2.z - v1Split.y -
-                                    w1Split.z * mContactPoints[contactPointIndex].r1.x + w1Split.x * mContactPoints[contactPointIndex].r1.z,
-                                    v2Split.z + w2Split.x * mContactPoints[contactPointIndex].r2.y - w2Split.y * mContactPoints[contactPointIndex].r2.x - v1Split.z -
-                                    w1Split.x * mContactPoints[contactPointIndex].r1.y + w1Split.y * mContactPoints[contactPointIndex].r1.x);
-                decimal JvSplit = deltaVSplit.x * mContactPoints[contactPointIndex].normal.x +
-                                  deltaVSplit.y * mContactPoints[contactPointIndex].normal.y +
-                                  deltaVSplit.z * mContactPoints[contactPointIndex].normal.z;
-                decimal deltaLambdaSplit = - (JvSplit + biasPenetrationDepth) *
-                        mContactPoints[contactPointIndex].inversePenetrationMass;
-                decimal lambdaTempSplit = mContactPoints[contactPointIndex].penetrationSplitImpulse;
-                mContactPoints[contactPointIndex].penetrationSplitImpulse = std::max(
-                            mContactPoints[contactPointIndex].penetrationSplitImpulse +
-                            deltaLambdaSplit, decimal(0.0));
-                deltaLambdaSplit = mContactPoints[contactPointIndex].penetrationSplitImpulse - lambdaTempSplit;
-
-                Vector3 linearImpulse(mContactPoints[contactPointIndex].normal.x * deltaLambdaSplit,
-                                      mContactPoints[contactPointIndex].normal.y * deltaLambdaSplit,
-                                      mContactPoints[contactPointIndex].normal.z * deltaLambdaSplit);
-
-                // Update the velocities of the body 1 by applying the impulse P
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
-
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index].x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * mContactConstraints[c].angularLockAxisFactorBody1.x * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index].y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * mContactConstraints[c].angularLockAxisFactorBody1.y * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index].z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * mContactConstraints[c].angularLockAxisFactorBody1.z * deltaLambdaSplit;
-
-                // Update the velocities of the body 1 by applying the impulse P
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * linearImpulse.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * linearImpulse.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-                mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * linearImpulse.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
-
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index].x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * mContactConstraints[c].angularLockAxisFactorBody2.x * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index].y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * mContactConstraints[c].angularLockAxisFactorBody2.y * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index].z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * mContactConstraints[c].angularLockAxisFactorBody2.z * deltaLambdaSplit;
-            }
+    mColorsBatches.clear();
+    mColorsBatchesStartIndex.clear();
+    mColorsBatchesStartIndex.reserve(NB_MAX_PARALLEL_COLORS + 1);
 
-            contactPointIndex++;
+    for (uint32 c=0; c < NB_MAX_PARALLEL_COLORS; c++) {
+
+        mColorsBatchesStartIndex.add(static_cast<uint32>(mColorsBatches.size()));
+
+        for (uint32 i=mColorsStartIndex[c]; i < mColorsStartIndex[c + 1]; i += SimdDecimal::NB_LANES) {
+
+            mColorsBatches.addWithoutInit(1);
+            ContactManifoldsBatch& batch = mColorsBatches[mColorsBatches.size() - 1];
+            batch.colorsManifoldsStartIndex = i;
+            batch.nbLanes = std::min(SimdDecimal::NB_LANES, mColorsStartIndex[c + 1] - i);
         }
+    }
+    mColorsBatchesStartIndex.add(static_cast<uint32>(mColorsBatches.size()));
 
-        // ------ First friction constraint at the center of the contact manifold ------ //
+    // Copy the constraints into the batches in parallel
+    const uint32 nbBatches = static_cast<uint32>(mColorsBatches.size());
+    const uint32 batchesChunkSize = std::max(PARALLEL_COLOR_CHUNK_SIZE / SimdDecimal::NB_LANES, uint32(1));
+    mTaskScheduler.parallelFor(nbBatches, batchesChunkSize, [this](const TaskScheduler::TaskRange& range) {
 
-        // Compute J*v
-        // deltaV = v2 + w2.cross(mContactConstraints[c].r2Friction) - v1 - w1.cross(mContactConstraints[c].r1Friction);
-        Vector3 deltaV(v2.x + w2.y * mContactConstraints[c].r2Friction.z - w2.z * mContactConstraints[c].r2Friction.y - v1.x -
-                       w1.y * mContactConstraints[c].r1Friction.z + w1.z * mContactConstraints[c].r1Friction.y,
+        for (uint32 b=range.startIndex; b < range.endIndex; b++) {
+            initializeBatch(mColorsBatches[b]);
+        }
+    });
+}
+
+// Copy the constraints of the contact manifolds of a batch into the batch
+void ContactSolverSystem::initializeBatch(ContactManifoldsBatch& batch) {
+
+    const uint32 colorsManifoldsStartIndex = batch.colorsManifoldsStartIndex;
+    const uint32 nbLanes = batch.nbLanes;
+
+    // The unused lanes and contact points are zero
+    std::memset(&batch, 0, sizeof(ContactManifoldsBatch));
+    batch.colorsManifoldsStartIndex = colorsManifoldsStartIndex;
+    batch.nbLanes = nbLanes;
+
+    const decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
+
+    for (uint32 l=0; l < nbLanes; l++) {
+
+        const uint32 m = mColorsManifolds[colorsManifoldsStartIndex + l];
+        const ContactManifoldSolver& manifold = mContactConstraints[m];
+
+        batch.maxNbContacts = std::max(batch.maxNbContacts, static_cast<uint32>(manifold.nbContacts));
+        batch.rigidBodyComponentIndexBody1[l] = manifold.rigidBodyComponentIndexBody1;
+        batch.rigidBodyComponentIndexBody2[l] = manifold.rigidBodyComponentIndexBody2;
+        batch.massInverseBody1[l] = manifold.massInverseBody1;
+        batch.massInverseBody2[l] = manifold.massInverseBody2;
+        batch.linearLockAxisFactorBody1.setLane(l, manifold.linearLockAxisFactorBody1);
+        batch.linearLockAxisFactorBody2.setLane(l, manifold.linearLockAxisFactorBody2);
+        batch.angularLockAxisFactorBody1.setLane(l, manifold.angularLockAxisFactorBody1);
+        batch.angularLockAxisFactorBody2.setLane(l, manifold.angularLockAxisFactorBody2);
+        for (int r=0; r < 3; r++) {
+            batch.inverseInertiaTensorBody1[r].setLane(l, manifold.inverseInertiaTensorBody1[r]);
+            batch.inverseInertiaTensorBody2[r].setLane(l, manifold.inverseInertiaTensorBody2[r]);
+        }
+        batch.frictionCoefficient[l] = manifold.frictionCoefficient;
+        batch.normal.setLane(l, manifold.normal);
+        batch.r1Friction.setLane(l, manifold.r1Friction);
+        batch.r2Friction.setLane(l, manifold.r2Friction);
+        batch.r1CrossT1.setLane(l, manifold.r1CrossT1);
+        batch.r1CrossT2.setLane(l, manifold.r1CrossT2);
+        batch.r2CrossT1.setLane(l, manifold.r2CrossT1);
+        batch.r2CrossT2.setLane(l, manifold.r2CrossT2);
+        batch.frictionVector1.setLane(l, manifold.frictionVector1);
+        batch.frictionVector2.setLane(l, manifold.frictionVector2);
+        batch.inverseFriction1Mass[l] = manifold.inverseFriction1Mass;
+        batch.inverseFriction2Mass[l] = manifold.inverseFriction2Mass;
+        batch.inverseTwistFrictionMass[l] = manifold.inverseTwistFrictionMass;
+        batch.friction1Impulse[l] = manifold.friction1Impulse;
+        batch.friction2Impulse[l] = manifold.friction2Impulse;
+        batch.frictionTwistImpulse[l] = manifold.frictionTwistImpulse;
+
+        // For each contact point of the manifold
+        const uint32 contactPointsStartIndex = (*mAllContactManifolds)[m].contactPointsIndex;
+        for (int8 i=0; i < manifold.nbContacts; i++) {
+
+            const ContactPointSolver& contactPoint = mContactPoints[contactPointsStartIndex + i];
+            ContactPointsLanes& contactPointsLanes = batch.contactPoints[i];
+
+            contactPointsLanes.normal.setLane(l, contactPoint.normal);
+            contactPointsLanes.r1.setLane(l, contactPoint.r1);
+            contactPointsLanes.r2.setLane(l, contactPoint.r2);
+            contactPointsLanes.i1TimesR1CrossN.setLane(l, contactPoint.i1TimesR1CrossN);
+            contactPointsLanes.i2TimesR2CrossN.setLane(l, contactPoint.i2TimesR2CrossN);
+
+            // The bias of the penetration depth does not change during the iterations
+            decimal biasPenetrationDepth = 0.0;
+            if (contactPoint.penetrationDepth > SLOP) {
+                biasPenetrationDepth = -(beta/mTimeStep) * std::max(0.0f, float(contactPoint.penetrationDepth - SLOP));
+            }
+            contactPointsLanes.biasPenetrationDepth[l] = biasPenetrationDepth;
+            contactPointsLanes.restitutionBias[l] = contactPoint.restitutionBias;
+            contactPointsLanes.inversePenetrationMass[l] = contactPoint.inversePenetrationMass;
+            contactPointsLanes.penetrationImpulse[l] = contactPoint.penetrationImpulse;
+            contactPointsLanes.penetrationSplitImpulse[l] = contactPoint.penetrationSplitImpulse;
+        }
+    }
+}
+
+// Solve the contact manifolds of a batch with SIMD instructions
+/// Each lane performs exactly the same operations as solveManifold() for its contact manifold.
+/// The unused lanes and contact points have a zero inverse mass and their impulses stay zero.
+void ContactSolverSystem::solveBatch(ContactManifoldsBatch& batch) {
+
+    // Gather the velocities of the bodies of the lanes
+    LanesVector3 lanesV1, lanesW1, lanesV2, lanesW2;
+    LanesVector3 lanesV1Split, lanesW1Split, lanesV2Split, lanesW2Split;
+    for (uint32 l=0; l < SimdDecimal::NB_LANES; l++) {
+
+        const bool isUsedLane = l < batch.nbLanes;
+        const uint32 rigidBody1Index = batch.rigidBodyComponentIndexBody1[l];
+        const uint32 rigidBody2Index = batch.rigidBodyComponentIndexBody2[l];
+
+        lanesV1.setLane(l, isUsedLane ? mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index] : Vector3::zero());
+        lanesW1.setLane(l, isUsedLane ? mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index] : Vector3::zero());
+        lanesV2.setLane(l, isUsedLane ? mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index] : Vector3::zero());
+        lanesW2.setLane(l, isUsedLane ? mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index] : Vector3::zero());
+        lanesV1Split.setLane(l, isUsedLane ? mRigidBodyComponents.mSplitLinearVelocities[rigidBody1Index] : Vector3::zero());
+        lanesW1Split.setLane(l, isUsedLane ? mRigidBodyComponents.mSplitAngularVelocities[rigidBody1Index] : Vector3::zero());
+        lanesV2Split.setLane(l, isUsedLane ? mRigidBodyComponents.mSplitLinearVelocities[rigidBody2Index] : Vector3::zero());
+        lanesW2Split.setLane(l, isUsedLane ? mRigidBodyComponents.mSplitAngularVelocities[rigidBody2Index] : Vector3::zero());
+    }
 
-                       v2.y + w2.z * mContactConstraints[c].r2Friction.x - w2.x * mContactConstraints[c].r2Friction.z - v1.y -
-                       w1.z * mContactConstraints[c].r1Friction.x + w1.x * mContactConstraints[c].r1Friction.z,
+    SimdVector3 v1 = lanesV1.load();
+    SimdVector3 w1 = lanesW1.load();
+    SimdVector3 v2 = lanesV2.load();
+    SimdVector3 w2 = lanesW2.load();
+    SimdVector3 v1Split = lanesV1Split.load();
+    SimdVector3 w1Split = lanesW1Split.load();
+    SimdVector3 v2Split = lanesV2Split.load();
+    SimdVector3 w2Split = lanesW2Split.load();
+
+    const SimdDecimal zero(decimal(0.0));
+    const SimdDecimal massInverseBody1 = SimdDecimal::load(batch.massInverseBody1);
+    const SimdDecimal massInverseBody2 = SimdDecimal::load(batch.massInverseBody2);
+    const SimdVector3 linearLockAxisFactorBody1 = batch.linearLockAxisFactorBody1.load();
+    const SimdVector3 linearLockAxisFactorBody2 = batch.linearLockAxisFactorBody2.load();
+    const SimdVector3 angularLockAxisFactorBody1 = batch.angularLockAxisFactorBody1.load();
+    const SimdVector3 angularLockAxisFactorBody2 = batch.angularLockAxisFactorBody2.load();
+    const SimdVector3 inverseInertiaTensorBody1[3] = {batch.inverseInertiaTensorBody1[0].load(), batch.inverseInertiaTensorBody1[1].load(),
+                                                      batch.inverseInertiaTensorBody1[2].load()};
+    const SimdVector3 inverseInertiaTensorBody2[3] = {batch.inverseInertiaTensorBody2[0].load(), batch.inverseInertiaTensorBody2[1].load(),
+                                                      batch.inverseInertiaTensorBody2[2].load()};
+
+    // Return lockAxisFactor * (inverseInertiaTensor * impulse) (same operations order as the Vector3 and Matrix3x3 operators)
+    auto angularVelocityChange = [](const SimdVector3& lockAxisFactor, const SimdVector3* inverseInertiaTensor, const SimdVector3& impulse) {
+        return SimdVector3{lockAxisFactor.x * (inverseInertiaTensor[0].x * impulse.x + inverseInertiaTensor[0].y * impulse.y + inverseInertiaTensor[0].z * impulse.z),
+                           lockAxisFactor.y * (inverseInertiaTensor[1].x * impulse.x + inverseInertiaTensor[1].y * impulse.y + inverseInertiaTensor[1].z * impulse.z),
+                           lockAxisFactor.z * (inverseInertiaTensor[2].x * impulse.x + inverseInertiaTensor[2].y * impulse.y + inverseInertiaTensor[2].z * impulse.z)};
+    };
+
+    SimdDecimal sumPenetrationImpulse = zero;
+
+    for (uint32 i=0; i < batch.maxNbContacts; i++) {
+
+        ContactPointsLanes& contactPoints = batch.contactPoints[i];
+
+        const SimdVector3 normal = contactPoints.normal.load();
+        const SimdVector3 r1 = contactPoints.r1.load();
+        const SimdVector3 r2 = contactPoints.r2.load();
+        const SimdVector3 i1TimesR1CrossN = contactPoints.i1TimesR1CrossN.load();
+        const SimdVector3 i2TimesR2CrossN = contactPoints.i2TimesR2CrossN.load();
+        const SimdDecimal biasPenetrationDepth = SimdDecimal::load(contactPoints.biasPenetrationDepth);
+        const SimdDecimal restitutionBias = SimdDecimal::load(contactPoints.restitutionBias);
+        const SimdDecimal inversePenetrationMass = SimdDecimal::load(contactPoints.inversePenetrationMass);
+
+        // --------- Penetration --------- //
 
-                       v2.z + w2.x * mContactConstraints[c].r2Friction.y - w2.y * mContactConstraints[c].r2Friction.x - v1.z -
-                       w1.x * mContactConstraints[c].r1Friction.y + w1.y * mContactConstraints[c].r1Friction.x);
-        decimal Jv = deltaV.x * mContactConstraints[c].frictionVector1.x +
-                     deltaV.y * mContactConstraints[c].frictionVector1.y +
-                     deltaV.z * mContactConstraints[c].frictionVector1.z;
+        // Compute J*v
+        const SimdDecimal deltaVX = v2.x + w2.y * r2.z - w2.z * r2.y - v1.x - w1.y * r1.z + w1.z * r1.y;
+        const SimdDecimal deltaVY = v2.y + w2.z * r2.x - w2.x * r2.z - v1.y - w1.z * r1.x + w1.x * r1.z;
+        const SimdDecimal deltaVZ = v2.z + w2.x * r2.y - w2.y * r2.x - v1.z - w1.x * r1.y + w1.y * r1.x;
+        const SimdDecimal Jv = deltaVX * normal.x + deltaVY * normal.y + deltaVZ * normal.z;
 
         // Compute the Lagrange multiplier lambda
-        decimal deltaLambda = -Jv * mContactConstraints[c].inverseFriction1Mass;
-        decimal frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
-        lambdaTemp = mContactConstraints[c].friction1Impulse;
-        mContactConstraints[c].friction1Impulse = std::max(-frictionLimit,
-                                                    std::min(mContactConstraints[c].friction1Impulse +
-                                                             deltaLambda, frictionLimit));
-        deltaLambda = mContactConstraints[c].friction1Impulse - lambdaTemp;
+        SimdDecimal deltaLambda = mIsSplitImpulseActive ? -(Jv + restitutionBias) * inversePenetrationMass :
+                                                          -(Jv + (biasPenetrationDepth + restitutionBias)) * inversePenetrationMass;
+        const SimdDecimal lambdaTemp = SimdDecimal::load(contactPoints.penetrationImpulse);
+        const SimdDecimal penetrationImpulse = max(lambdaTemp + deltaLambda, zero);
+        penetrationImpulse.store(contactPoints.penetrationImpulse);
+        deltaLambda = penetrationImpulse - lambdaTemp;
 
-        // Compute the impulse P=J^T * lambda
-        Vector3 angularImpulseBody1(-mContactConstraints[c].r1CrossT1.x * deltaLambda,
-                                    -mContactConstraints[c].r1CrossT1.y * deltaLambda,
-                                    -mContactConstraints[c].r1CrossT1.z * deltaLambda);
-        Vector3 linearImpulseBody2(mContactConstraints[c].frictionVector1.x * deltaLambda,
-                                   mContactConstraints[c].frictionVector1.y * deltaLambda,
-                                   mContactConstraints[c].frictionVector1.z * deltaLambda);
-        Vector3 angularImpulseBody2(mContactConstraints[c].r2CrossT1.x * deltaLambda,
-                                    mContactConstraints[c].r2CrossT1.y * deltaLambda,
-                                    mContactConstraints[c].r2CrossT1.z * deltaLambda);
+        const SimdVector3 linearImpulse{normal.x * deltaLambda, normal.y * deltaLambda, normal.z * deltaLambda};
 
         // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+        v1.x -= massInverseBody1 * linearImpulse.x * linearLockAxisFactorBody1.x;
+        v1.y -= massInverseBody1 * linearImpulse.y * linearLockAxisFactorBody1.y;
+        v1.z -= massInverseBody1 * linearImpulse.z * linearLockAxisFactorBody1.z;
 
-        Vector3 angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].x += angularVelocity1.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].y += angularVelocity1.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].z += angularVelocity1.z;
+        w1.x -= i1TimesR1CrossN.x * angularLockAxisFactorBody1.x * deltaLambda;
+        w1.y -= i1TimesR1CrossN.y * angularLockAxisFactorBody1.y * deltaLambda;
+        w1.z -= i1TimesR1CrossN.z * angularLockAxisFactorBody1.z * deltaLambda;
 
         // Update the velocities of the body 2 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+        v2.x += massInverseBody2 * linearImpulse.x * linearLockAxisFactorBody2.x;
+        v2.y += massInverseBody2 * linearImpulse.y * linearLockAxisFactorBody2.y;
+        v2.z += massInverseBody2 * linearImpulse.z * linearLockAxisFactorBody2.z;
 
-        Vector3 angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].x += angularVelocity2.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].y += angularVelocity2.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].z += angularVelocity2.z;
+        w2.x += i2TimesR2CrossN.x * angularLockAxisFactorBody2.x * deltaLambda;
+        w2.y += i2TimesR2CrossN.y * angularLockAxisFactorBody2.y * deltaLambda;
+        w2.z += i2TimesR2CrossN.z * angularLockAxisFactorBody2.z * deltaLambda;
 
-        // ------ Second friction constraint at the center of the contact manifold ----- //
+        sumPenetrationImpulse += penetrationImpulse;
 
-        // Compute J*v
-        //deltaV = v2 + w2.cross(mContactConstraints[c].r2Friction) - v1 - w1.cross(mContactConstraints[c].r1Friction);
-        deltaV.x = v2.x + w2.y * mContactConstraints[c].r2Friction.z - w2.z * mContactConstraints[c].r2Friction.y  - v1.x -
-                   w1.y * mContactConstraints[c].r1Friction.z + w1.z * mContactConstraints[c].r1Friction.y;
-        deltaV.y = v2.y + w2.z * mContactConstraints[c].r2Friction.x - w2.x * mContactConstraints[c].r2Friction.z  - v1.y -
-                   w1.z * mContactConstraints[c].r1Friction.x + w1.x * mContactConstraints[c].r1Friction.z;
-        deltaV.z = v2.z + w2.x * mContactConstraints[c].r2Friction.y - w2.y * mContactConstraints[c].r2Friction.x  - v1.z -
-                   w1.x * mContactConstraints[c].r1Friction.y + w1.y * mContactConstraints[c].r1Friction.x;
-        Jv = deltaV.x * mContactConstraints[c].frictionVector2.x + deltaV.y * mContactConstraints[c].frictionVector2.y +
-             deltaV.z * mContactConstraints[c].frictionVector2.z;
+        // If the split impulse position correction is active
+        if (mIsSplitImpulseActive) {
 
-        // Compute the Lagrange multiplier lambda
-        deltaLambda = -Jv * mContactConstraints[c].inverseFriction2Mass;
-        frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
-        lambdaTemp = mContactConstraints[c].friction2Impulse;
-        mContactConstraints[c].friction2Impulse = std::max(-frictionLimit,
-                                                    std::min(mContactConstraints[c].friction2Impulse +
-                                                             deltaLambda, frictionLimit));
-        deltaLambda = mContactConstraints[c].friction2Impulse - lambdaTemp;
+            // Split impulse (position correction)
+            const SimdDecimal deltaVSplitX = v2Split.x + w2Split.y * r2.z - w2Split.z * r2.y - v1Split.x - w1Split.y * r1.z + w1Split.z * r1.y;
+            const SimdDecimal deltaVSplitY = v2Split.y + w2Split.z * r2.x - w2Split.x * r2.z - v1Split.y - w1Split.z * r1.x + w1Split.x * r1.z;
+            const SimdDecimal deltaVSplitZ = v2Split.z + w2Split.x * r2.y - w2Split.y * r2.x - v1Split.z - w1Split.x * r1.y + w1Split.y * r1.x;
+            const SimdDecimal JvSplit = deltaVSplitX * normal.x + deltaVSplitY * normal.y + deltaVSplitZ * normal.z;
+            SimdDecimal deltaLambdaSplit = -(JvSplit + biasPenetrationDepth) * inversePenetrationMass;
+            const SimdDecimal lambdaTempSplit = SimdDecimal::load(contactPoints.penetrationSplitImpulse);
+            const SimdDecimal penetrationSplitImpulse = max(lambdaTempSplit + deltaLambdaSplit, zero);
+            penetrationSplitImpulse.store(contactPoints.penetrationSplitImpulse);
+            deltaLambdaSplit = penetrationSplitImpulse - lambdaTempSplit;
 
-        // Compute the impulse P=J^T * lambda
-        angularImpulseBody1.x = -mContactConstraints[c].r1CrossT2.x * deltaLambda;
-        angularImpulseBody1.y = -mContactConstraints[c].r1CrossT2.y * deltaLambda;
-        angularImpulseBody1.z = -mContactConstraints[c].r1CrossT2.z * deltaLambda;
+            const SimdVector3 linearImpulseSplit{normal.x * deltaLambdaSplit, normal.y * deltaLambdaSplit, normal.z * deltaLambdaSplit};
 
-        linearImpulseBody2.x = mContactConstraints[c].frictionVector2.x * deltaLambda;
-        linearImpulseBody2.y = mContactConstraints[c].frictionVector2.y * deltaLambda;
-        linearImpulseBody2.z = mContactConstraints[c].frictionVector2.z * deltaLambda;
+            // Update the velocities of the body 1 by applying the impulse P
+            v1Split.x -= massInverseBody1 * linearImpulseSplit.x * linearLockAxisFactorBody1.x;
+            v1Split.y -= massInverseBody1 * linearImpulseSplit.y * linearLockAxisFactorBody1.y;
+            v1Split.z -= massInverseBody1 * linearImpulseSplit.z * linearLockAxisFactorBody1.z;
 
-        angularImpulseBody2.x = mContactConstraints[c].r2CrossT2.x * deltaLambda;
-        angularImpulseBody2.y = mContactConstraints[c].r2CrossT2.y * deltaLambda;
-        angularImpulseBody2.z = mContactConstraints[c].r2CrossT2.z * deltaLambda;
+            w1Split.x -= i1TimesR1CrossN.x * angularLockAxisFactorBody1.x * deltaLambdaSplit;
+            w1Split.y -= i1TimesR1CrossN.y * angularLockAxisFactorBody1.y * deltaLambdaSplit;
+            w1Split.z -= i1TimesR1CrossN.z * angularLockAxisFactorBody1.z * deltaLambdaSplit;
 
-        // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody1.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody1.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody1Index].z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody1.z;
+            // Update the velocities of the body 2 by applying the impulse P
+            v2Split.x += massInverseBody2 * linearImpulseSplit.x * linearLockAxisFactorBody2.x;
+            v2Split.y += massInverseBody2 * linearImpulseSplit.y * linearLockAxisFactorBody2.y;
+            v2Split.z += massInverseBody2 * linearImpulseSplit.z * linearLockAxisFactorBody2.z;
 
-        angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].x += angularVelocity1.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].y += angularVelocity1.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].z += angularVelocity1.z;
+            w2Split.x += i2TimesR2CrossN.x * angularLockAxisFactorBody2.x * deltaLambdaSplit;
+            w2Split.y += i2TimesR2CrossN.y * angularLockAxisFactorBody2.y * deltaLambdaSplit;
+            w2Split.z += i2TimesR2CrossN.z * angularLockAxisFactorBody2.z * deltaLambdaSplit;
+        }
+    }
 
-        // Update the velocities of the body 2 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x * mContactConstraints[c].linearLockAxisFactorBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y * mContactConstraints[c].linearLockAxisFactorBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[rigidBody2Index].z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z * mContactConstraints[c].linearLockAxisFactorBody2.z;
+    const SimdVector3 r1Friction = batch.r1Friction.load();
+    const SimdVector3 r2Friction = batch.r2Friction.load();
+    const SimdDecimal frictionLimit = SimdDecimal::load(batch.frictionCoefficient) * sumPenetrationImpulse;
 
-        angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].x += angularVelocity2.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].y += angularVelocity2.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].z += angularVelocity2.z;
+    // ------ First and second friction constraints at the center of the contact manifold ------ //
 
-        // ------ Twist friction constraint at the center of the contact manifol ------ //
+    LanesVector3* frictionVectors[2] = {&batch.frictionVector1, &batch.frictionVector2};
+    LanesVector3* r1CrossTs[2] = {&batch.r1CrossT1, &batch.r1CrossT2};
+    LanesVector3* r2CrossTs[2] = {&batch.r2CrossT1, &batch.r2CrossT2};
+    decimal* inverseFrictionMasses[2] = {batch.inverseFriction1Mass, batch.inverseFriction2Mass};
+    decimal* frictionImpulses[2] = {batch.friction1Impulse, batch.friction2Impulse};
+
+    for (uint32 f=0; f < 2; f++) {
+
+        const SimdVector3 frictionVector = frictionVectors[f]->load();
+        const SimdVector3 r1CrossT = r1CrossTs[f]->load();
+        const SimdVector3 r2CrossT = r2CrossTs[f]->load();
 
         // Compute J*v
-        deltaV = w2 - w1;
-        Jv = deltaV.x * mContactConstraints[c].normal.x + deltaV.y * mContactConstraints[c].normal.y +
-             deltaV.z * mContactConstraints[c].normal.z;
-
-        deltaLambda = -Jv * (mContactConstraints[c].inverseTwistFrictionMass);
-        frictionLimit = mContactConstraints[c].frictionCoefficient * sumPenetrationImpulse;
-        lambdaTemp = mContactConstraints[c].frictionTwistImpulse;
-        mContactConstraints[c].frictionTwistImpulse = std::max(-frictionLimit,
-                                                        std::min(mContactConstraints[c].frictionTwistImpulse
-                                                                 + deltaLambda, frictionLimit));
-        deltaLambda = mContactConstraints[c].frictionTwistImpulse - lambdaTemp;
+        const SimdDecimal deltaVX = v2.x + w2.y * r2Friction.z - w2.z * r2Friction.y - v1.x - w1.y * r1Friction.z + w1.z * r1Friction.y;
+        const SimdDecimal deltaVY = v2.y + w2.z * r2Friction.x - w2.x * r2Friction.z - v1.y - w1.z * r1Friction.x + w1.x * r1Friction.z;
+        const SimdDecimal deltaVZ = v2.z + w2.x * r2Friction.y - w2.y * r2Friction.x - v1.z - w1.x * r1Friction.y + w1.y * r1Friction.x;
+        const SimdDecimal Jv = deltaVX * frictionVector.x + deltaVY * frictionVector.y + deltaVZ * frictionVector.z;
+
+        // Compute the Lagrange multiplier lambda
+        SimdDecimal deltaLambda = -Jv * SimdDecimal::load(inverseFrictionMasses[f]);
+        const SimdDecimal lambdaTemp = SimdDecimal::load(frictionImpulses[f]);
+        const SimdDecimal frictionImpulse = max(-frictionLimit, min(lambdaTemp + deltaLambda, frictionLimit));
+        frictionImpulse.store(frictionImpulses[f]);
+        deltaLambda = frictionImpulse - lambdaTemp;
 
         // Compute the impulse P=J^T * lambda
-        angularImpulseBody2.x = mContactConstraints[c].normal.x * deltaLambda;
-        angularImpulseBody2.y = mContactConstraints[c].normal.y * deltaLambda;
-        angularImpulseBody2.z = mContactConstraints[c].normal.z * deltaLambda;
+        const SimdVector3 angularImpulseBody1{-r1CrossT.x * deltaLambda, -r1CrossT.y * deltaLambda, -r1CrossT.z * deltaLambda};
+        const SimdVector3 linearImpulseBody2{frictionVector.x * deltaLambda, frictionVector.y * deltaLambda, frictionVector.z * deltaLambda};
+        const SimdVector3 angularImpulseBody2{r2CrossT.x * deltaLambda, r2CrossT.y * deltaLambda, r2CrossT.z * deltaLambda};
 
         // Update the velocities of the body 1 by applying the impulse P
-        angularVelocity1 = mContactConstraints[c].angularLockAxisFactorBody1 * (mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].x -= angularVelocity1.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].y -= angularVelocity1.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody1Index].z -= angularVelocity1.z;
+        v1.x -= massInverseBody1 * linearImpulseBody2.x * linearLockAxisFactorBody1.x;
+        v1.y -= massInverseBody1 * linearImpulseBody2.y * linearLockAxisFactorBody1.y;
+        v1.z -= massInverseBody1 * linearImpulseBody2.z * linearLockAxisFactorBody1.z;
 
-        // Update the velocities of the body 1 by applying the impulse P
-        angularVelocity2 = mContactConstraints[c].angularLockAxisFactorBody2 * (mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2);
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].x += angularVelocity2.x;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].y += angularVelocity2.y;
-        mRigidBodyComponents.mConstrainedAngularVelocities[rigidBody2Index].z += angularVelocity2.z;
+        const SimdVector3 angularVelocity1 = angularVelocityChange(angularLockAxisFactorBody1, inverseInertiaTensorBody1, angularImpulseBody1);
+        w1.x += angularVelocity1.x;
+        w1.y += angularVelocity1.y;
+        w1.z += angularVelocity1.z;
+
+        // Update the velocities of the body 2 by applying the impulse P
+        v2.x += massInverseBody2 * linearImpulseBody2.x * linearLockAxisFactorBody2.x;
+        v2.y += massInverseBody2 * linearImpulseBody2.y * linearLockAxisFactorBody2.y;
+        v2.z += massInverseBody2 * linearImpulseBody2.z * linearLockAxisFactorBody2.z;
+
+        const SimdVector3 angularVelocity2 = angularVelocityChange(angularLockAxisFactorBody2, inverseInertiaTensorBody2, angularImpulseBody2);
+        w2.x += angularVelocity2.x;
+        w2.y += angularVelocity2.y;
+        w2.z += angularVelocity2.z;
+    }
+
+    // ------ Twist friction constraint at the center of the contact manifold ------ //
+
+    // Compute J*v
+    const SimdVector3 normal = batch.normal.load();
+    const SimdDecimal Jv = (w2.x - w1.x) * normal.x + (w2.y - w1.y) * normal.y + (w2.z - w1.z) * normal.z;
+
+    SimdDecimal deltaLambda = -Jv * SimdDecimal::load(batch.inverseTwistFrictionMass);
+    const SimdDecimal lambdaTemp = SimdDecimal::load(batch.frictionTwistImpulse);
+    const SimdDecimal frictionTwistImpulse = max(-frictionLimit, min(lambdaTemp + deltaLambda, frictionLimit));
+    frictionTwistImpulse.store(batch.frictionTwistImpulse);
+    deltaLambda = frictionTwistImpulse - lambdaTemp;
+
+    // Compute the impulse P=J^T * lambda
+    const SimdVector3 angularImpulseBody2{normal.x * deltaLambda, normal.y * deltaLambda, normal.z * deltaLambda};
+
+    // Update the velocities of the bodies by applying the impulse P
+    const SimdVector3 angularVelocity1 = angularVelocityChange(angularLockAxisFactorBody1, inverseInertiaTensorBody1, angularImpulseBody2);
+    w1.x -= angularVelocity1.x;
+    w1.y -= angularVelocity1.y;
+    w1.z -= angularVelocity1.z;
+
+    const SimdVector3 angularVelocity2 = angularVelocityChange(angularLockAxisFactorBody2, inverseInertiaTensorBody2, angularImpulseBody2);
+    w2.x += angularVelocity2.x;
+    w2.y += angularVelocity2.y;
+    w2.z += angularVelocity2.z;
+
+    // Scatter the velocities of the bodies of the lanes
+    lanesV1.store(v1);
+    lanesW1.store(w1);
+    lanesV2.store(v2);
+    lanesW2.store(w2);
+    lanesV1Split.store(v1Split);
+    lanesW1Split.store(w1Split);
+    lanesV2Split.store(v2Split);
+    lanesW2Split.store(w2Split);
+
+    for (uint32 l=0; l < batch.nbLanes; l++) {
+
+        const uint32 rigidBody1Index = batch.rigidBodyComponentIndexBody1[l];
+        const uint32 rigidBody2Index = batch.rigidBodyComponentIndexBody2[l];
+
+        mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody1Index, lanesV1.getLane(l), lanesW1.getLane(l));
+        mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(rigidBody2Index, lanesV2.getLane(l), lanesW2.getLane(l));
+
+        if (mIsSplitImpulseActive) {
+            mRigidBodyComponents.updateSplitVelocitiesOfDynamicBody(rigidBody1Index, lanesV1Split.getLane(l), lanesW1Split.getLane(l));
+            mRigidBodyComponents.updateSplitVelocitiesOfDynamicBody(rigidBody2Index, lanesV2Split.getLane(l), lanesW2Split.getLane(l));
+        }
     }
 }
 
+// Copy the accumulated impulses of the batches back into the contact manifolds and points
+/// This must be done before the colors are computed for another island and before the impulses are stored.
+void ContactSolverSystem::storeColorsBatchesImpulses() {
+
+    for (uint32 b=0; b < mColorsBatches.size(); b++) {
+
+        const ContactManifoldsBatch& batch = mColorsBatches[b];
+
+        for (uint32 l=0; l < batch.nbLanes; l++) {
+
+            const uint32 m = mColorsManifolds[batch.colorsManifoldsStartIndex + l];
+
+            mContactConstraints[m].friction1Impulse = batch.friction1Impulse[l];
+            mContactConstraints[m].friction2Impulse = batch.friction2Impulse[l];
+            mContactConstraints[m].frictionTwistImpulse = batch.frictionTwistImpulse[l];
+
+            const uint32 contactPointsStartIndex = (*mAllContactManifolds)[m].contactPointsIndex;
+            for (int8 i=0; i < mContactConstraints[m].nbContacts; i++) {
+                mContactPoints[contactPointsStartIndex + i].penetrationImpulse = batch.contactPoints[i].penetrationImpulse[l];
+                mContactPoints[contactPointsStartIndex + i].penetrationSplitImpulse = batch.contactPoints[i].penetrationSplitImpulse[l];
+            }
+        }
+    }
+
+    mColorsBatches.clear();
+}
+
+#endif
+
 // Store the computed impulses to use them to
 // warm start the solver at the next iteration
 void ContactSolverSystem::storeImpulses() {
 
     RP3D_PROFILE("ContactSolver::storeImpulses()", mProfiler);
 
+#ifdef IS_RP3D_SIMD_CONTACT_SOLVER_ENABLED
+    storeColorsBatchesImpulses();
+#endif
+
     uint32 contactPointIndex = 0;
 
     // For each contact manifold
@@ -788,8 +1430,6 @@ void ContactSolverSystem::storeImpulses() {
 // for a contact manifold. The two vectors have to be such that : t1 x t2 = contactNormal.
 void ContactSolverSystem::computeFrictionVectors(const Vector3& deltaVelocity, ContactManifoldSolver& contact) const {
 
-    RP3D_PROFILE("ContactSolver::computeFrictionVectors()", mProfiler);
-
     assert(contact.normal.length() > decimal(0.0));
 
     // Compute the velocity difference vector in the tangential plane
@@ -27,13 +27,14 @@
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/body/RigidBody.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/utils/TaskScheduler.h>
 
 using namespace reactphysics3d;
 
 // Constructor
-DynamicsSystem::DynamicsSystem(PhysicsWorld& world, BodyComponents& bodyComponents, RigidBodyComponents& rigidBodyComponents,
+DynamicsSystem::DynamicsSystem(PhysicsWorld& world, TaskScheduler& taskScheduler, BodyComponents& bodyComponents, RigidBodyComponents& rigidBodyComponents,
                                TransformComponents& transformComponents, ColliderComponents& colliderComponents, bool& isGravityEnabled, Vector3& gravity)
-              :mWorld(world), mBodyComponents(bodyComponents), mRigidBodyComponents(rigidBodyComponents), mTransformComponents(transformComponents), mColliderComponents(colliderComponents),
+              :mWorld(world), mTaskScheduler(taskScheduler), mBodyComponents(bodyComponents), mRigidBodyComponents(rigidBodyComponents), mTransformComponents(transformComponents), mColliderComponents(colliderComponents),
                mIsGravityEnabled(isGravityEnabled), mGravity(gravity) {
 
 }
@@ -47,27 +48,31 @@ void DynamicsSystem::integrateRigidBodiesPositions(decimal timeStep, bool isSpli
 
     const decimal isSplitImpulseFactor = isSplitImpulseActive ? decimal(1.0) : decimal(0.0);
 
+    // Each body only writes its own components so the bodies can be processed in parallel
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
-
-        // Get the constrained velocity
-        Vector3 newLinVelocity = mRigidBodyComponents.mConstrainedLinearVelocities[i];
-        Vector3 newAngVelocity = mRigidBodyComponents.mConstrainedAngularVelocities[i];
-
-        // Add the split impulse velocity from Contact Solver (only used
-        // to update the position)
-        newLinVelocity += isSplitImpulseFactor * mRigidBodyComponents.mSplitLinearVelocities[i];
-        newAngVelocity += isSplitImpulseFactor * mRigidBodyComponents.mSplitAngularVelocities[i];
-
-        // Get current position and orientation of the body
-        const Vector3& currentPosition = mRigidBodyComponents.mCentersOfMassWorld[i];
-        const Quaternion& currentOrientation = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).getOrientation();
-
-        // Update the new constrained position and orientation of the body
-        mRigidBodyComponents.mConstrainedPositions[i] = currentPosition + newLinVelocity * timeStep;
-        mRigidBodyComponents.mConstrainedOrientations[i] = currentOrientation + Quaternion(0, newAngVelocity) *
-                                                           currentOrientation * decimal(0.5) * timeStep;
-    }
+    mTaskScheduler.parallelFor(nbRigidBodyComponents, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
+
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+
+            // Get the constrained velocity
+            Vector3 newLinVelocity = mRigidBodyComponents.mConstrainedLinearVelocities[i];
+            Vector3 newAngVelocity = mRigidBodyComponents.mConstrainedAngularVelocities[i];
+
+            // Add the split impulse velocity from Contact Solver (only used
+            // to update the position)
+            newLinVelocity += isSplitImpulseFactor * mRigidBodyComponents.mSplitLinearVelocities[i];
+            newAngVelocity += isSplitImpulseFactor * mRigidBodyComponents.mSplitAngularVelocities[i];
+
+            // Get current position and orientation of the body
+            const Vector3& currentPosition = mRigidBodyComponents.mCentersOfMassWorld[i];
+            const Quaternion& currentOrientation = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).getOrientation();
+
+            // Update the new constrained position and orientation of the body
+            mRigidBodyComponents.mConstrainedPositions[i] = currentPosition + newLinVelocity * timeStep;
+            mRigidBodyComponents.mConstrainedOrientations[i] = currentOrientation + Quaternion(0, newAngVelocity) *
+                                                               currentOrientation * decimal(0.5) * timeStep;
+        }
+    });
 }
 
 // Update the postion/orientation of the bodies
@@ -76,37 +81,40 @@ void DynamicsSystem::updateBodiesState() {
     RP3D_PROFILE("DynamicsSystem::updateBodiesState()", mProfiler);
 
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
+    mTaskScheduler.parallelFor(nbRigidBodyComponents, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
 
-        // Update the linear and angular velocity of the body
-        mRigidBodyComponents.mLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i];
-        mRigidBodyComponents.mAngularVelocities[i] = mRigidBodyComponents.mConstrainedAngularVelocities[i];
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
 
-        // Update the position of the center of mass of the body
-        mRigidBodyComponents.mCentersOfMassWorld[i] = mRigidBodyComponents.mConstrainedPositions[i];
+            // Update the linear and angular velocity of the body
+            mRigidBodyComponents.mLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i];
+            mRigidBodyComponents.mAngularVelocities[i] = mRigidBodyComponents.mConstrainedAngularVelocities[i];
 
-        // Update the orientation of the body
-        const Quaternion& constrainedOrientation = mRigidBodyComponents.mConstrainedOrientations[i];
-        mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).setOrientation(constrainedOrientation.getUnit());
-    }
+            // Update the position of the center of mass of the body
+            mRigidBodyComponents.mCentersOfMassWorld[i] = mRigidBodyComponents.mConstrainedPositions[i];
 
-    // Update the position of the body (using the new center of mass and new orientation)
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
+            // Update the orientation of the body
+            Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+            const Quaternion& constrainedOrientation = mRigidBodyComponents.mConstrainedOrientations[i];
+            transform.setOrientation(constrainedOrientation.getUnit());
 
-        Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
-        const Vector3& centerOfMassWorld = mRigidBodyComponents.mCentersOfMassWorld[i];
-        const Vector3& centerOfMassLocal = mRigidBodyComponents.mCentersOfMassLocal[i];
-        transform.setPosition(centerOfMassWorld - transform.getOrientation() * centerOfMassLocal);
-    }
+            // Update the position of the body (using the new center of mass and new orientation)
+            const Vector3& centerOfMassWorld = mRigidBodyComponents.mCentersOfMassWorld[i];
+            const Vector3& centerOfMassLocal = mRigidBodyComponents.mCentersOfMassLocal[i];
+            transform.setPosition(centerOfMassWorld - transform.getOrientation() * centerOfMassLocal);
+        }
+    });
 
-    // Update the local-to-world transform of the colliders
+    // Update the local-to-world transform of the colliders (once all the bodies transforms have been updated)
     const uint32 nbColliderComponents = mColliderComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbColliderComponents; i++) {
+    mTaskScheduler.parallelFor(nbColliderComponents, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
 
-        // Update the local-to-world transform of the collider
-        mColliderComponents.mLocalToWorldTransforms[i] = mTransformComponents.getTransform(mColliderComponents.mBodiesEntities[i]) *
-                                                           mColliderComponents.mLocalToBodyTransforms[i];
-    }
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+
+            // Update the local-to-world transform of the collider
+            mColliderComponents.mLocalToWorldTransforms[i] = mTransformComponents.getTransform(mColliderComponents.mBodiesEntities[i]) *
+                                                               mColliderComponents.mLocalToBodyTransforms[i];
+        }
+    });
 }
 
 // Integrate the velocities of rigid bodies.
@@ -118,68 +126,60 @@ void DynamicsSystem::integrateRigidBodiesVelocities(decimal timeStep) {
 
     RP3D_PROFILE("DynamicsSystem::integrateRigidBodiesVelocities()", mProfiler);
 
-    // Reset the split velocities of the bodies
-    resetSplitVelocities();
+    const bool isGravityEnabled = mIsGravityEnabled;
+    const Vector3 gravity = mGravity;
 
-    // Integration component velocities using force/torque
-    const uint32 nbEnabledRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbEnabledRigidBodyComponents; i++) {
-
-        assert(mRigidBodyComponents.mSplitLinearVelocities[i] == Vector3(0, 0, 0));
-        assert(mRigidBodyComponents.mSplitAngularVelocities[i] == Vector3(0, 0, 0));
+    // The split velocities reset, the integration of the forces, the gravity and the damping are
+    // applied to a body in a single pass (in the same order as separate passes would do)
+    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
+    mTaskScheduler.parallelFor(nbRigidBodyComponents, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
 
-        const Vector3& linearVelocity = mRigidBodyComponents.mLinearVelocities[i];
-        const Vector3& angularVelocity = mRigidBodyComponents.mAngularVelocities[i];
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
 
-        // Integrate the external force to get the new velocity of the body
-        mRigidBodyComponents.mConstrainedLinearVelocities[i] = linearVelocity + timeStep * mRigidBodyComponents.mInverseMasses[i] *
-                                                               mRigidBodyComponents.mLinearLockAxisFactors[i] * mRigidBodyComponents.mExternalForces[i];
-        mRigidBodyComponents.mConstrainedAngularVelocities[i] = angularVelocity + timeStep * mRigidBodyComponents.mAngularLockAxisFactors[i] *
-                                                                (mRigidBodyComponents.mInverseInertiaTensorsWorld[i] * mRigidBodyComponents.mExternalTorques[i]);
-    }
+            // Reset the split velocities of the body
+            mRigidBodyComponents.mSplitLinearVelocities[i].setToZero();
+            mRigidBodyComponents.mSplitAngularVelocities[i].setToZero();
 
-    // Apply gravity force
-    if (mIsGravityEnabled) {
+            const Vector3& linearVelocity = mRigidBodyComponents.mLinearVelocities[i];
+            const Vector3& angularVelocity = mRigidBodyComponents.mAngularVelocities[i];
 
-        const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-        for (uint32 i=0; i < nbRigidBodyComponents; i++) {
+            // Integrate the external force to get the new velocity of the body
+            Vector3 newLinearVelocity = linearVelocity + timeStep * mRigidBodyComponents.mInverseMasses[i] *
+                                        mRigidBodyComponents.mLinearLockAxisFactors[i] * mRigidBodyComponents.mExternalForces[i];
+            Vector3 newAngularVelocity = angularVelocity + timeStep * mRigidBodyComponents.mAngularLockAxisFactors[i] *
+                                         (mRigidBodyComponents.mInverseInertiaTensorsWorld[i] * mRigidBodyComponents.mExternalTorques[i]);
 
             // If the gravity has to be applied to this rigid body
-            if (mRigidBodyComponents.mIsGravityEnabled[i]) {
+            if (isGravityEnabled && mRigidBodyComponents.mIsGravityEnabled[i]) {
 
                 // Integrate the gravity force
-                mRigidBodyComponents.mConstrainedLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i] + timeStep *
-                                                                       mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mLinearLockAxisFactors[i] *
-                                                                       mRigidBodyComponents.mMasses[i] * mGravity;
+                newLinearVelocity = newLinearVelocity + timeStep * mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mLinearLockAxisFactors[i] *
+                                    mRigidBodyComponents.mMasses[i] * gravity;
             }
+
+            // Apply the velocity damping
+            // Damping force : F_c = -c' * v (c=damping factor)
+            // Differential Equation      : m * dv/dt = -c' * v
+            //                              => dv/dt = -c * v (with c=c'/m)
+            //                              => dv/dt + c * v = 0
+            // Solution      : v(t) = v0 * e^(-c * t)
+            //                 => v(t + dt) = v0 * e^(-c(t + dt))
+            //                              = v0 * e^(-c * t) * e^(-c * dt)
+            //                              = v(t) * e^(-c * dt)
+            //                 => v2 = v1 * e^(-c * dt)
+            // Using Padé's approximation of the exponential function:
+            // Reference: https://mathworld.wolfram.com/PadeApproximant.html
+            //                   e^x ~ 1 / (1 - x)
+            //                      => e^(-c * dt) ~ 1 / (1 + c * dt)
+            //                      => v2 = v1 * 1 / (1 + c * dt)
+            const decimal linDampingFactor = mRigidBodyComponents.mLinearDampings[i];
+            const decimal angDampingFactor = mRigidBodyComponents.mAngularDampings[i];
+            const decimal linearDamping = decimal(1.0) / (decimal(1.0) + linDampingFactor * timeStep);
+            const decimal angularDamping = decimal(1.0) / (decimal(1.0) + angDampingFactor * timeStep);
+            mRigidBodyComponents.mConstrainedLinearVelocities[i] = newLinearVelocity * linearDamping;
+            mRigidBodyComponents.mConstrainedAngularVelocities[i] = newAngularVelocity * angularDamping;
         }
-    }
-
-    // Apply the velocity damping
-    // Damping force : F_c = -c' * v (c=damping factor)
-    // Differential Equation      : m * dv/dt = -c' * v
-    //                              => dv/dt = -c * v (with c=c'/m)
-    //                              => dv/dt + c * v = 0
-    // Solution      : v(t) = v0 * e^(-c * t)
-    //                 => v(t + dt) = v0 * e^(-c(t + dt))
-    //                              = v0 * e^(-c * t) * e^(-c * dt)
-    //                              = v(t) * e^(-c * dt)
-    //                 => v2 = v1 * e^(-c * dt)
-    // Using Padé's approximation of the exponential function:
-    // Reference: https://mathworld.wolfram.com/PadeApproximant.html
-    //                   e^x ~ 1 / (1 - x)
-    //                      => e^(-c * dt) ~ 1 / (1 + c * dt)
-    //                      => v2 = v1 * 1 / (1 + c * dt)
-    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
-
-        const decimal linDampingFactor = mRigidBodyComponents.mLinearDampings[i];
-        const decimal angDampingFactor = mRigidBodyComponents.mAngularDampings[i];
-        const decimal linearDamping = decimal(1.0) / (decimal(1.0) + linDampingFactor * timeStep);
-        const decimal angularDamping = decimal(1.0) / (decimal(1.0) + angDampingFactor * timeStep);
-        mRigidBodyComponents.mConstrainedLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i] * linearDamping;
-        mRigidBodyComponents.mConstrainedAngularVelocities[i] = mRigidBodyComponents.mConstrainedAngularVelocities[i] * angularDamping;
-    }
+    });
 }
 
 // Reset the external force and torque applied to the bodies
@@ -187,19 +187,12 @@ void DynamicsSystem::resetBodiesForceAndTorque() {
 
     // For each body of the world
     const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbComponents();
-    for (uint32 i=0; i < nbRigidBodyComponents; i++) {
-        mRigidBodyComponents.mExternalForces[i].setToZero();
-        mRigidBodyComponents.mExternalTorques[i].setToZero();
-    }
-}
-
-// Reset the split velocities of the bodies
-void DynamicsSystem::resetSplitVelocities() {
+    mTaskScheduler.parallelFor(nbRigidBodyComponents, PARALLEL_FOR_CHUNK_SIZE, [&](const TaskScheduler::TaskRange& range) {
 
-    const uint32 nbRigidBodyComponents = mRigidBodyComponents.getNbEnabledComponents();
-    for(uint32 i=0; i < nbRigidBodyComponents; i++) {
-        mRigidBodyComponents.mSplitLinearVelocities[i].setToZero();
-        mRigidBodyComponents.mSplitAngularVelocities[i].setToZero();
-    }
+        for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+            mRigidBodyComponents.mExternalForces[i].setToZero();
+            mRigidBodyComponents.mExternalTorques[i].setToZero();
+        }
+    });
 }
 
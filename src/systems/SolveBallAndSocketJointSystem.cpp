@@ -164,52 +164,61 @@ void SolveBallAndSocketJointSystem::warmstart() {
     // For each joint component
     const uint32 nbJoints = mBallAndSocketJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        warmstartJoint(i);
+    }
+}
 
-        const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Warm start the constraint of the joint at a given index in the components arrays
+void SolveBallAndSocketJointSystem::warmstartJoint(uint32 i) {
 
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        const Vector3& r1World = mBallAndSocketJointComponents.mR1World[i];
-        const Vector3& r2World = mBallAndSocketJointComponents.mR2World[i];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
-        const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
+    const Vector3& r1World = mBallAndSocketJointComponents.mR1World[i];
+    const Vector3& r2World = mBallAndSocketJointComponents.mR2World[i];
 
-        // Compute the impulse P=J^T * lambda for the body 1
-        Vector3 linearImpulseBody1 = -mBallAndSocketJointComponents.mImpulse[i];
-        Vector3 angularImpulseBody1 = mBallAndSocketJointComponents.mImpulse[i].cross(r1World);
+    const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
+    const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints
-        const Vector3 coneLimitImpulse = mBallAndSocketJointComponents.mConeLimitImpulse[i] * mBallAndSocketJointComponents.mConeLimitACrossB[i];
+    // Compute the impulse P=J^T * lambda for the body 1
+    Vector3 linearImpulseBody1 = -mBallAndSocketJointComponents.mImpulse[i];
+    Vector3 angularImpulseBody1 = mBallAndSocketJointComponents.mImpulse[i].cross(r1World);
 
-        // Compute the impulse P=J^T * lambda for the cone limit constraint of body 1
-        angularImpulseBody1 += coneLimitImpulse;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints
+    const Vector3 coneLimitImpulse = mBallAndSocketJointComponents.mConeLimitImpulse[i] * mBallAndSocketJointComponents.mConeLimitACrossB[i];
 
-        // Apply the impulse to the body 1
-        v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    // Compute the impulse P=J^T * lambda for the cone limit constraint of body 1
+    angularImpulseBody1 += coneLimitImpulse;
 
-        // Compute the impulse P=J^T * lambda for the body 2
-        Vector3 angularImpulseBody2 = -mBallAndSocketJointComponents.mImpulse[i].cross(r2World);
+    // Apply the impulse to the body 1
+    v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the cone limit constraint of body 2
-        angularImpulseBody2 += -coneLimitImpulse;
+    // Compute the impulse P=J^T * lambda for the body 2
+    Vector3 angularImpulseBody2 = -mBallAndSocketJointComponents.mImpulse[i].cross(r2World);
 
-        // Apply the impulse to the body to the body 2
-        v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * mBallAndSocketJointComponents.mImpulse[i];
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-    }
+    // Compute the impulse P=J^T * lambda for the cone limit constraint of body 2
+    angularImpulseBody2 += -coneLimitImpulse;
+
+    // Apply the impulse to the body to the body 2
+    v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * mBallAndSocketJointComponents.mImpulse[i];
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the velocity constraint
@@ -218,80 +227,89 @@ void SolveBallAndSocketJointSystem::solveVelocityConstraint() {
     // For each joint component
     const uint32 nbJoints = mBallAndSocketJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        solveVelocityConstraintJoint(i);
+    }
+}
 
-        const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Solve the velocity constraint of the joint at a given index in the components arrays
+void SolveBallAndSocketJointSystem::solveVelocityConstraintJoint(uint32 i) {
 
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
-        const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        // --------------- Limits Constraints --------------- //
+    const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
+    const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
 
-        if (mBallAndSocketJointComponents.mIsConeLimitEnabled[i]) {
+    // --------------- Limits Constraints --------------- //
 
-            // If the cone limit is violated
-            if (mBallAndSocketJointComponents.mIsConeLimitViolated[i]) {
+    if (mBallAndSocketJointComponents.mIsConeLimitEnabled[i]) {
 
-                // Compute J*v for the cone limit constraine
-                const decimal JvConeLimit = mBallAndSocketJointComponents.mConeLimitACrossB[i].dot(w1 - w2);
+        // If the cone limit is violated
+        if (mBallAndSocketJointComponents.mIsConeLimitViolated[i]) {
 
-                // Compute the Lagrange multiplier lambda for the cone limit constraint
-                decimal deltaLambdaConeLimit = mBallAndSocketJointComponents.mInverseMassMatrixConeLimit[i] * (-JvConeLimit -mBallAndSocketJointComponents.mBConeLimit[i]);
-                decimal lambdaTemp = mBallAndSocketJointComponents.mConeLimitImpulse[i];
-                mBallAndSocketJointComponents.mConeLimitImpulse[i] = std::max(mBallAndSocketJointComponents.mConeLimitImpulse[i] + deltaLambdaConeLimit, decimal(0.0));
-                deltaLambdaConeLimit = mBallAndSocketJointComponents.mConeLimitImpulse[i] - lambdaTemp;
+            // Compute J*v for the cone limit constraine
+            const decimal JvConeLimit = mBallAndSocketJointComponents.mConeLimitACrossB[i].dot(w1 - w2);
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
-                const Vector3 angularImpulseBody1 = deltaLambdaConeLimit * mBallAndSocketJointComponents.mConeLimitACrossB[i];
+            // Compute the Lagrange multiplier lambda for the cone limit constraint
+            decimal deltaLambdaConeLimit = mBallAndSocketJointComponents.mInverseMassMatrixConeLimit[i] * (-JvConeLimit -mBallAndSocketJointComponents.mBConeLimit[i]);
+            decimal lambdaTemp = mBallAndSocketJointComponents.mConeLimitImpulse[i];
+            mBallAndSocketJointComponents.mConeLimitImpulse[i] = std::max(mBallAndSocketJointComponents.mConeLimitImpulse[i] + deltaLambdaConeLimit, decimal(0.0));
+            deltaLambdaConeLimit = mBallAndSocketJointComponents.mConeLimitImpulse[i] - lambdaTemp;
 
-                // Apply the impulse to the body 1
-                w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
+            const Vector3 angularImpulseBody1 = deltaLambdaConeLimit * mBallAndSocketJointComponents.mConeLimitACrossB[i];
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
-                const Vector3 angularImpulseBody2 = -deltaLambdaConeLimit * mBallAndSocketJointComponents.mConeLimitACrossB[i];
+            // Apply the impulse to the body 1
+            w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-                // Apply the impulse to the body 2
-                w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
+            const Vector3 angularImpulseBody2 = -deltaLambdaConeLimit * mBallAndSocketJointComponents.mConeLimitACrossB[i];
+
+            // Apply the impulse to the body 2
+            w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
 
-            }
         }
+    }
 
-        // --------------- Joint Constraints --------------- //
+    // --------------- Joint Constraints --------------- //
 
-        // Compute J*v
-        const Vector3 Jv = v2 + w2.cross(mBallAndSocketJointComponents.mR2World[i]) - v1 - w1.cross(mBallAndSocketJointComponents.mR1World[i]);
+    // Compute J*v
+    const Vector3 Jv = v2 + w2.cross(mBallAndSocketJointComponents.mR2World[i]) - v1 - w1.cross(mBallAndSocketJointComponents.mR1World[i]);
 
-        // Compute the Lagrange multiplier lambda
-        const Vector3 deltaLambda = mBallAndSocketJointComponents.mInverseMassMatrix[i] * (-Jv - mBallAndSocketJointComponents.mBiasVector[i]);
-        mBallAndSocketJointComponents.mImpulse[i] += deltaLambda;
+    // Compute the Lagrange multiplier lambda
+    const Vector3 deltaLambda = mBallAndSocketJointComponents.mInverseMassMatrix[i] * (-Jv - mBallAndSocketJointComponents.mBiasVector[i]);
+    mBallAndSocketJointComponents.mImpulse[i] += deltaLambda;
 
-        // Compute the impulse P=J^T * lambda for the body 1
-        const Vector3 linearImpulseBody1 = -deltaLambda;
-        const Vector3 angularImpulseBody1 = deltaLambda.cross(mBallAndSocketJointComponents.mR1World[i]);
+    // Compute the impulse P=J^T * lambda for the body 1
+    const Vector3 linearImpulseBody1 = -deltaLambda;
+    const Vector3 angularImpulseBody1 = deltaLambda.cross(mBallAndSocketJointComponents.mR1World[i]);
 
-        // Apply the impulse to the body 1
-        v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    // Apply the impulse to the body 1
+    v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the body 2
-        const Vector3 angularImpulseBody2 = -deltaLambda.cross(mBallAndSocketJointComponents.mR2World[i]);
+    // Compute the impulse P=J^T * lambda for the body 2
+    const Vector3 angularImpulseBody2 = -deltaLambda.cross(mBallAndSocketJointComponents.mR2World[i]);
 
-        // Apply the impulse to the body 2
-        v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambda;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-    }
+    // Apply the impulse to the body 2
+    v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambda;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the position constraint (for position error correction)
@@ -147,58 +147,67 @@ void SolveFixedJointSystem::warmstart() {
     // For each joint
     const uint32 nbJoints = mFixedJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        warmstartJoint(i);
+    }
+}
 
-        const Entity jointEntity = mFixedJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Warm start the constraint of the joint at a given index in the components arrays
+void SolveFixedJointSystem::warmstartJoint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mFixedJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Get the inverse mass of the bodies
-        const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& impulseTranslation = mFixedJointComponents.mImpulseTranslation[i];
-        const Vector3& impulseRotation = mFixedJointComponents.mImpulseRotation[i];
+    // Get the inverse mass of the bodies
+    const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        const Vector3& r1World = mFixedJointComponents.mR1World[i];
-        const Vector3& r2World = mFixedJointComponents.mR2World[i];
+    const Vector3& impulseTranslation = mFixedJointComponents.mImpulseTranslation[i];
+    const Vector3& impulseRotation = mFixedJointComponents.mImpulseRotation[i];
 
-        // Compute the impulse P=J^T * lambda for the 3 translation constraints for body 1
-        Vector3 linearImpulseBody1 = -impulseTranslation;
-        Vector3 angularImpulseBody1 = impulseTranslation.cross(r1World);
+    const Vector3& r1World = mFixedJointComponents.mR1World[i];
+    const Vector3& r2World = mFixedJointComponents.mR2World[i];
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 1
-        angularImpulseBody1 += -impulseRotation;
+    // Compute the impulse P=J^T * lambda for the 3 translation constraints for body 1
+    Vector3 linearImpulseBody1 = -impulseTranslation;
+    Vector3 angularImpulseBody1 = impulseTranslation.cross(r1World);
 
-        const Matrix3x3& i1 = mFixedJointComponents.mI1[i];
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 1
+    angularImpulseBody1 += -impulseRotation;
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    const Matrix3x3& i1 = mFixedJointComponents.mI1[i];
 
-        // Compute the impulse P=J^T * lambda for the 3 translation constraints for body 2
-        Vector3 angularImpulseBody2 = -impulseTranslation.cross(r2World);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 2
-        angularImpulseBody2 += impulseRotation;
+    // Compute the impulse P=J^T * lambda for the 3 translation constraints for body 2
+    Vector3 angularImpulseBody2 = -impulseTranslation.cross(r2World);
 
-        const Matrix3x3& i2 = mFixedJointComponents.mI2[i];
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 2
+    angularImpulseBody2 += impulseRotation;
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * impulseTranslation;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-    }
+    const Matrix3x3& i2 = mFixedJointComponents.mI2[i];
+
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * impulseTranslation;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the velocity constraint
@@ -207,81 +216,90 @@ void SolveFixedJointSystem::solveVelocityConstraint() {
     // For each joint
     const uint32 nbJoints = mFixedJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        solveVelocityConstraintJoint(i);
+    }
+}
 
-        const Entity jointEntity = mFixedJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Solve the velocity constraint of the joint at a given index in the components arrays
+void SolveFixedJointSystem::solveVelocityConstraintJoint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mFixedJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Get the inverse mass of the bodies
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& r1World = mFixedJointComponents.mR1World[i];
-        const Vector3& r2World = mFixedJointComponents.mR2World[i];
+    // Get the inverse mass of the bodies
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        // --------------- Translation Constraints --------------- //
+    const Vector3& r1World = mFixedJointComponents.mR1World[i];
+    const Vector3& r2World = mFixedJointComponents.mR2World[i];
 
-        // Compute J*v for the 3 translation constraints
-        const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
+    // --------------- Translation Constraints --------------- //
 
-        const Matrix3x3& inverseMassMatrixTranslation = mFixedJointComponents.mInverseMassMatrixTranslation[i];
+    // Compute J*v for the 3 translation constraints
+    const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
 
-        // Compute the Lagrange multiplier lambda
-        const Vector3 deltaLambda = inverseMassMatrixTranslation * (-JvTranslation - mFixedJointComponents.mBiasTranslation[i]);
-        mFixedJointComponents.mImpulseTranslation[i] += deltaLambda;
+    const Matrix3x3& inverseMassMatrixTranslation = mFixedJointComponents.mInverseMassMatrixTranslation[i];
 
-        // Compute the impulse P=J^T * lambda for body 1
-        const Vector3 linearImpulseBody1 = -deltaLambda;
-        Vector3 angularImpulseBody1 = deltaLambda.cross(r1World);
+    // Compute the Lagrange multiplier lambda
+    const Vector3 deltaLambda = inverseMassMatrixTranslation * (-JvTranslation - mFixedJointComponents.mBiasTranslation[i]);
+    mFixedJointComponents.mImpulseTranslation[i] += deltaLambda;
 
-        const Matrix3x3& i1 = mFixedJointComponents.mI1[i];
+    // Compute the impulse P=J^T * lambda for body 1
+    const Vector3 linearImpulseBody1 = -deltaLambda;
+    Vector3 angularImpulseBody1 = deltaLambda.cross(r1World);
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    const Matrix3x3& i1 = mFixedJointComponents.mI1[i];
 
-        // Compute the impulse P=J^T * lambda  for body 2
-        const Vector3 angularImpulseBody2 = -deltaLambda.cross(r2World);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        const Matrix3x3& i2 = mFixedJointComponents.mI2[i];
+    // Compute the impulse P=J^T * lambda  for body 2
+    const Vector3 angularImpulseBody2 = -deltaLambda.cross(r2World);
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambda;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+    const Matrix3x3& i2 = mFixedJointComponents.mI2[i];
 
-        // --------------- Rotation Constraints --------------- //
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambda;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
 
-        // Compute J*v for the 3 rotation constraints
-        const Vector3 JvRotation = w2 - w1;
+    // --------------- Rotation Constraints --------------- //
 
-        const Vector3& biasRotation = mFixedJointComponents.mBiasRotation[i];
-        const Matrix3x3& inverseMassMatrixRotation = mFixedJointComponents.mInverseMassMatrixRotation[i];
+    // Compute J*v for the 3 rotation constraints
+    const Vector3 JvRotation = w2 - w1;
 
-        // Compute the Lagrange multiplier lambda for the 3 rotation constraints
-        Vector3 deltaLambda2 = inverseMassMatrixRotation * (-JvRotation - biasRotation);
-        mFixedJointComponents.mImpulseRotation[i] += deltaLambda2;
+    const Vector3& biasRotation = mFixedJointComponents.mBiasRotation[i];
+    const Matrix3x3& inverseMassMatrixRotation = mFixedJointComponents.mInverseMassMatrixRotation[i];
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 1
-        angularImpulseBody1 = -deltaLambda2;
+    // Compute the Lagrange multiplier lambda for the 3 rotation constraints
+    Vector3 deltaLambda2 = inverseMassMatrixRotation * (-JvRotation - biasRotation);
+    mFixedJointComponents.mImpulseRotation[i] += deltaLambda2;
 
-        // Apply the impulse to the body 1
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints for body 1
+    angularImpulseBody1 = -deltaLambda2;
 
-        // Apply the impulse to the body 2
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * deltaLambda2);
-    }
+    // Apply the impulse to the body 1
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+
+    // Apply the impulse to the body 2
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * deltaLambda2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the position constraint (for position error correction)
@@ -218,78 +218,87 @@ void SolveHingeJointSystem::warmstart() {
     // For each joint component
     const uint32 nbJoints = mHingeJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        warmstartJoint(i);
+    }
+}
 
-        const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Warm start the constraint of the joint at a given index in the components arrays
+void SolveHingeJointSystem::warmstartJoint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& impulseTranslation = mHingeJointComponents.mImpulseTranslation[i];
-        const Vector2& impulseRotation = mHingeJointComponents.mImpulseRotation[i];
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        const decimal impulseLowerLimit = mHingeJointComponents.mImpulseLowerLimit[i];
-        const decimal impulseUpperLimit = mHingeJointComponents.mImpulseUpperLimit[i];
+    const Vector3& impulseTranslation = mHingeJointComponents.mImpulseTranslation[i];
+    const Vector2& impulseRotation = mHingeJointComponents.mImpulseRotation[i];
 
-        const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
-        const Vector3& a1 = mHingeJointComponents.mA1[i];
+    const decimal impulseLowerLimit = mHingeJointComponents.mImpulseLowerLimit[i];
+    const decimal impulseUpperLimit = mHingeJointComponents.mImpulseUpperLimit[i];
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints
-        Vector3 rotationImpulse = -b2CrossA1 * impulseRotation.x - mHingeJointComponents.mC2CrossA1[i] * impulseRotation.y;
+    const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
+    const Vector3& a1 = mHingeJointComponents.mA1[i];
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints
-        const Vector3 limitsImpulse = (impulseUpperLimit - impulseLowerLimit) * a1;
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints
+    Vector3 rotationImpulse = -b2CrossA1 * impulseRotation.x - mHingeJointComponents.mC2CrossA1[i] * impulseRotation.y;
 
-        // Compute the impulse P=J^T * lambda for the motor constraint
-        const Vector3 motorImpulse = -mHingeJointComponents.mImpulseMotor[i] * a1;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints
+    const Vector3 limitsImpulse = (impulseUpperLimit - impulseLowerLimit) * a1;
 
-        // Compute the impulse P=J^T * lambda for the 3 translation constraints of body 1
-        Vector3 linearImpulseBody1 = -impulseTranslation;
-        Vector3 angularImpulseBody1 = impulseTranslation.cross(mHingeJointComponents.mR1World[i]);
+    // Compute the impulse P=J^T * lambda for the motor constraint
+    const Vector3 motorImpulse = -mHingeJointComponents.mImpulseMotor[i] * a1;
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
-        angularImpulseBody1 += rotationImpulse;
+    // Compute the impulse P=J^T * lambda for the 3 translation constraints of body 1
+    Vector3 linearImpulseBody1 = -impulseTranslation;
+    Vector3 angularImpulseBody1 = impulseTranslation.cross(mHingeJointComponents.mR1World[i]);
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
-        angularImpulseBody1 += limitsImpulse;
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
+    angularImpulseBody1 += rotationImpulse;
 
-        // Compute the impulse P=J^T * lambda for the motor constraint of body 1
-        angularImpulseBody1 += motorImpulse;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
+    angularImpulseBody1 += limitsImpulse;
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mHingeJointComponents.mI1[i] * angularImpulseBody1);
+    // Compute the impulse P=J^T * lambda for the motor constraint of body 1
+    angularImpulseBody1 += motorImpulse;
 
-        // Compute the impulse P=J^T * lambda for the 3 translation constraints of body 2
-        Vector3 angularImpulseBody2 = -impulseTranslation.cross(mHingeJointComponents.mR2World[i]);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mHingeJointComponents.mI1[i] * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
-        angularImpulseBody2 += -rotationImpulse;
+    // Compute the impulse P=J^T * lambda for the 3 translation constraints of body 2
+    Vector3 angularImpulseBody2 = -impulseTranslation.cross(mHingeJointComponents.mR2World[i]);
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 2
-        angularImpulseBody2 += -limitsImpulse;
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
+    angularImpulseBody2 += -rotationImpulse;
 
-        // Compute the impulse P=J^T * lambda for the motor constraint of body 2
-        angularImpulseBody2 += -motorImpulse;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 2
+    angularImpulseBody2 += -limitsImpulse;
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * impulseTranslation;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mHingeJointComponents.mI2[i] * angularImpulseBody2);
-    }
+    // Compute the impulse P=J^T * lambda for the motor constraint of body 2
+    angularImpulseBody2 += -motorImpulse;
+
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * impulseTranslation;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mHingeJointComponents.mI2[i] * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the velocity constraint
@@ -298,171 +307,180 @@ void SolveHingeJointSystem::solveVelocityConstraint() {
     // For each joint component
     const uint32 nbJoints = mHingeJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        solveVelocityConstraintJoint(i);
+    }
+}
 
-        const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
-
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+// Solve the velocity constraint of the joint at a given index in the components arrays
+void SolveHingeJointSystem::solveVelocityConstraintJoint(uint32 i) {
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        const Matrix3x3& i1 = mHingeJointComponents.mI1[i];
-        const Matrix3x3& i2 = mHingeJointComponents.mI2[i];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& r1World = mHingeJointComponents.mR1World[i];
-        const Vector3& r2World = mHingeJointComponents.mR2World[i];
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        const Vector3& a1 = mHingeJointComponents.mA1[i];
+    const Matrix3x3& i1 = mHingeJointComponents.mI1[i];
+    const Matrix3x3& i2 = mHingeJointComponents.mI2[i];
 
-        const decimal inverseMassMatrixLimitMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i];
+    const Vector3& r1World = mHingeJointComponents.mR1World[i];
+    const Vector3& r2World = mHingeJointComponents.mR2World[i];
 
-        // --------------- Limits Constraints --------------- //
+    const Vector3& a1 = mHingeJointComponents.mA1[i];
 
-        if (mHingeJointComponents.mIsLimitEnabled[i]) {
+    const decimal inverseMassMatrixLimitMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i];
 
-            // If the lower limit is violated
-            if (mHingeJointComponents.mIsLowerLimitViolated[i]) {
+    // --------------- Limits Constraints --------------- //
 
-                // Compute J*v for the lower limit constraint
-                const decimal JvLowerLimit = (w2 - w1).dot(a1);
+    if (mHingeJointComponents.mIsLimitEnabled[i]) {
 
-                // Compute the Lagrange multiplier lambda for the lower limit constraint
-                decimal deltaLambdaLower = inverseMassMatrixLimitMotor * (-JvLowerLimit -mHingeJointComponents.mBLowerLimit[i]);
-                decimal lambdaTemp = mHingeJointComponents.mImpulseLowerLimit[i];
-                mHingeJointComponents.mImpulseLowerLimit[i] = std::max(mHingeJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
-                deltaLambdaLower = mHingeJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
+        // If the lower limit is violated
+        if (mHingeJointComponents.mIsLowerLimitViolated[i]) {
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
-                const Vector3 angularImpulseBody1 = -deltaLambdaLower * a1;
+            // Compute J*v for the lower limit constraint
+            const decimal JvLowerLimit = (w2 - w1).dot(a1);
 
-                // Apply the impulse to the body 1
-                w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+            // Compute the Lagrange multiplier lambda for the lower limit constraint
+            decimal deltaLambdaLower = inverseMassMatrixLimitMotor * (-JvLowerLimit -mHingeJointComponents.mBLowerLimit[i]);
+            decimal lambdaTemp = mHingeJointComponents.mImpulseLowerLimit[i];
+            mHingeJointComponents.mImpulseLowerLimit[i] = std::max(mHingeJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
+            deltaLambdaLower = mHingeJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
-                const Vector3 angularImpulseBody2 = deltaLambdaLower * a1;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
+            const Vector3 angularImpulseBody1 = -deltaLambdaLower * a1;
 
-                // Apply the impulse to the body 2
-                w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-            }
-
-            // If the upper limit is violated
-            if (mHingeJointComponents.mIsUpperLimitViolated[i]) {
-
-                // Compute J*v for the upper limit constraint
-                const decimal JvUpperLimit = -(w2 - w1).dot(a1);
-
-                // Compute the Lagrange multiplier lambda for the upper limit constraint
-                decimal deltaLambdaUpper = inverseMassMatrixLimitMotor * (-JvUpperLimit -mHingeJointComponents.mBUpperLimit[i]);
-                decimal lambdaTemp = mHingeJointComponents.mImpulseUpperLimit[i];
-                mHingeJointComponents.mImpulseUpperLimit[i] = std::max(mHingeJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
-                deltaLambdaUpper = mHingeJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
-
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
-                const Vector3 angularImpulseBody1 = deltaLambdaUpper * a1;
-
-                // Apply the impulse to the body 1
-                w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+            // Apply the impulse to the body 1
+            w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
-                const Vector3 angularImpulseBody2 = -deltaLambdaUpper * a1;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
+            const Vector3 angularImpulseBody2 = deltaLambdaLower * a1;
 
-                // Apply the impulse to the body 2
-                w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-            }
+            // Apply the impulse to the body 2
+            w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
         }
 
-        // --------------- Motor --------------- //
-
-        // If the motor is enabled
-        if (mHingeJointComponents.mIsMotorEnabled[i]) {
+        // If the upper limit is violated
+        if (mHingeJointComponents.mIsUpperLimitViolated[i]) {
 
-            // Compute J*v for the motor
-            const decimal JvMotor = a1.dot(w1 - w2);
+            // Compute J*v for the upper limit constraint
+            const decimal JvUpperLimit = -(w2 - w1).dot(a1);
 
-            // Compute the Lagrange multiplier lambda for the motor
-            const decimal maxMotorImpulse = mHingeJointComponents.mMaxMotorTorque[i] * mTimeStep;
-            decimal deltaLambdaMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i] * (-JvMotor - mHingeJointComponents.mMotorSpeed[i]);
-            decimal lambdaTemp = mHingeJointComponents.mImpulseMotor[i];
-            mHingeJointComponents.mImpulseMotor[i] = clamp(mHingeJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
-            deltaLambdaMotor = mHingeJointComponents.mImpulseMotor[i] - lambdaTemp;
+            // Compute the Lagrange multiplier lambda for the upper limit constraint
+            decimal deltaLambdaUpper = inverseMassMatrixLimitMotor * (-JvUpperLimit -mHingeJointComponents.mBUpperLimit[i]);
+            decimal lambdaTemp = mHingeJointComponents.mImpulseUpperLimit[i];
+            mHingeJointComponents.mImpulseUpperLimit[i] = std::max(mHingeJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
+            deltaLambdaUpper = mHingeJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 1
-            const Vector3 angularImpulseBody1 = -deltaLambdaMotor * a1;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
+            const Vector3 angularImpulseBody1 = deltaLambdaUpper * a1;
 
             // Apply the impulse to the body 1
             w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-            // Compute the impulse P=J^T * lambda for the motor of body 2
-            const Vector3 angularImpulseBody2 = deltaLambdaMotor * a1;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
+            const Vector3 angularImpulseBody2 = -deltaLambdaUpper * a1;
 
             // Apply the impulse to the body 2
             w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
         }
+    }
 
-        // --------------- Joint Rotation Constraints --------------- //
+    // --------------- Motor --------------- //
 
-        const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
-        const Vector3& c2CrossA1 = mHingeJointComponents.mC2CrossA1[i];
+    // If the motor is enabled
+    if (mHingeJointComponents.mIsMotorEnabled[i]) {
 
-        // Compute J*v for the 2 rotation constraints
-        const Vector2 JvRotation(-b2CrossA1.dot(w1) + b2CrossA1.dot(w2),
-                                 -c2CrossA1.dot(w1) + c2CrossA1.dot(w2));
+        // Compute J*v for the motor
+        const decimal JvMotor = a1.dot(w1 - w2);
 
-        // Compute the Lagrange multiplier lambda for the 2 rotation constraints
-        Vector2 deltaLambdaRotation = mHingeJointComponents.mInverseMassMatrixRotation[i] *
-                                      (-JvRotation - mHingeJointComponents.mBiasRotation[i]);
-        mHingeJointComponents.mImpulseRotation[i] += deltaLambdaRotation;
+        // Compute the Lagrange multiplier lambda for the motor
+        const decimal maxMotorImpulse = mHingeJointComponents.mMaxMotorTorque[i] * mTimeStep;
+        decimal deltaLambdaMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i] * (-JvMotor - mHingeJointComponents.mMotorSpeed[i]);
+        decimal lambdaTemp = mHingeJointComponents.mImpulseMotor[i];
+        mHingeJointComponents.mImpulseMotor[i] = clamp(mHingeJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
+        deltaLambdaMotor = mHingeJointComponents.mImpulseMotor[i] - lambdaTemp;
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
-        Vector3 angularImpulseBody1 = -b2CrossA1 * deltaLambdaRotation.x - c2CrossA1 * deltaLambdaRotation.y;
+        // Compute the impulse P=J^T * lambda for the motor of body 1
+        const Vector3 angularImpulseBody1 = -deltaLambdaMotor * a1;
 
         // Apply the impulse to the body 1
         w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
-        Vector3 angularImpulseBody2 = b2CrossA1 * deltaLambdaRotation.x + c2CrossA1 * deltaLambdaRotation.y;
+        // Compute the impulse P=J^T * lambda for the motor of body 2
+        const Vector3 angularImpulseBody2 = deltaLambdaMotor * a1;
 
         // Apply the impulse to the body 2
         w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+    }
 
-        // --------------- Joint Translation Constraints --------------- //
+    // --------------- Joint Rotation Constraints --------------- //
 
-        // Compute J*v
-        const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
+    const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
+    const Vector3& c2CrossA1 = mHingeJointComponents.mC2CrossA1[i];
 
-        // Compute the Lagrange multiplier lambda
-        const Vector3 deltaLambdaTranslation = mHingeJointComponents.mInverseMassMatrixTranslation[i] *
-                                               (-JvTranslation - mHingeJointComponents.mBiasTranslation[i]);
-        mHingeJointComponents.mImpulseTranslation[i] += deltaLambdaTranslation;
+    // Compute J*v for the 2 rotation constraints
+    const Vector2 JvRotation(-b2CrossA1.dot(w1) + b2CrossA1.dot(w2),
+                             -c2CrossA1.dot(w1) + c2CrossA1.dot(w2));
 
-        // Compute the impulse P=J^T * lambda of body 1
-        const Vector3 linearImpulseBody1 = -deltaLambdaTranslation;
-        angularImpulseBody1 = deltaLambdaTranslation.cross(r1World);
+    // Compute the Lagrange multiplier lambda for the 2 rotation constraints
+    Vector2 deltaLambdaRotation = mHingeJointComponents.mInverseMassMatrixRotation[i] *
+                                  (-JvRotation - mHingeJointComponents.mBiasRotation[i]);
+    mHingeJointComponents.mImpulseRotation[i] += deltaLambdaRotation;
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
+    Vector3 angularImpulseBody1 = -b2CrossA1 * deltaLambdaRotation.x - c2CrossA1 * deltaLambdaRotation.y;
 
-        // Compute the impulse P=J^T * lambda of body 2
-        angularImpulseBody2 = -deltaLambdaTranslation.cross(r2World);
+    // Apply the impulse to the body 1
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambdaTranslation;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-    }
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
+    Vector3 angularImpulseBody2 = b2CrossA1 * deltaLambdaRotation.x + c2CrossA1 * deltaLambdaRotation.y;
+
+    // Apply the impulse to the body 2
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // --------------- Joint Translation Constraints --------------- //
+
+    // Compute J*v
+    const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
+
+    // Compute the Lagrange multiplier lambda
+    const Vector3 deltaLambdaTranslation = mHingeJointComponents.mInverseMassMatrixTranslation[i] *
+                                           (-JvTranslation - mHingeJointComponents.mBiasTranslation[i]);
+    mHingeJointComponents.mImpulseTranslation[i] += deltaLambdaTranslation;
+
+    // Compute the impulse P=J^T * lambda of body 1
+    const Vector3 linearImpulseBody1 = -deltaLambdaTranslation;
+    angularImpulseBody1 = deltaLambdaTranslation.cross(r1World);
+
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+
+    // Compute the impulse P=J^T * lambda of body 2
+    angularImpulseBody2 = -deltaLambdaTranslation.cross(r2World);
+
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * deltaLambdaTranslation;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the position constraint (for position error correction)
@@ -244,78 +244,87 @@ void SolveSliderJointSystem::warmstart() {
     // For each joint component
     const uint32 nbJoints = mSliderJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        warmstartJoint(i);
+    }
+}
 
-        const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Warm start the constraint of the joint at a given index in the components arrays
+void SolveSliderJointSystem::warmstartJoint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& n1 = mSliderJointComponents.mN1[i];
-        const Vector3& n2 = mSliderJointComponents.mN2[i];
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    const decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    const decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
-        decimal impulseLimits = mSliderJointComponents.mImpulseUpperLimit[i] - mSliderJointComponents.mImpulseLowerLimit[i];
-        Vector3 linearImpulseLimits = impulseLimits * mSliderJointComponents.mSliderAxisWorld[i];
+    const Vector3& n1 = mSliderJointComponents.mN1[i];
+    const Vector3& n2 = mSliderJointComponents.mN2[i];
 
-        // Compute the impulse P=J^T * lambda for the motor constraint of body 1
-        Vector3 impulseMotor = mSliderJointComponents.mImpulseMotor[i] * mSliderJointComponents.mSliderAxisWorld[i];
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
+    decimal impulseLimits = mSliderJointComponents.mImpulseUpperLimit[i] - mSliderJointComponents.mImpulseLowerLimit[i];
+    Vector3 linearImpulseLimits = impulseLimits * mSliderJointComponents.mSliderAxisWorld[i];
 
-        const Vector2& impulseTranslation = mSliderJointComponents.mImpulseTranslation[i];
-        const Vector3& impulseRotation = mSliderJointComponents.mImpulseRotation[i];
+    // Compute the impulse P=J^T * lambda for the motor constraint of body 1
+    Vector3 impulseMotor = mSliderJointComponents.mImpulseMotor[i] * mSliderJointComponents.mSliderAxisWorld[i];
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
-        Vector3 linearImpulseBody1 = -n1 * impulseTranslation.x - n2 * impulseTranslation.y;
-        Vector3 angularImpulseBody1 = -mSliderJointComponents.mR1PlusUCrossN1[i] * impulseTranslation.x -
-                mSliderJointComponents.mR1PlusUCrossN2[i] * impulseTranslation.y;
+    const Vector2& impulseTranslation = mSliderJointComponents.mImpulseTranslation[i];
+    const Vector3& impulseRotation = mSliderJointComponents.mImpulseRotation[i];
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
-        angularImpulseBody1 += -impulseRotation;
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
+    Vector3 linearImpulseBody1 = -n1 * impulseTranslation.x - n2 * impulseTranslation.y;
+    Vector3 angularImpulseBody1 = -mSliderJointComponents.mR1PlusUCrossN1[i] * impulseTranslation.x -
+            mSliderJointComponents.mR1PlusUCrossN2[i] * impulseTranslation.y;
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
-        linearImpulseBody1 += linearImpulseLimits;
-        angularImpulseBody1 += impulseLimits * mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
+    angularImpulseBody1 += -impulseRotation;
 
-        // Compute the impulse P=J^T * lambda for the motor constraint of body 1
-        linearImpulseBody1 += impulseMotor;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 1
+    linearImpulseBody1 += linearImpulseLimits;
+    angularImpulseBody1 += impulseLimits * mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
+    // Compute the impulse P=J^T * lambda for the motor constraint of body 1
+    linearImpulseBody1 += impulseMotor;
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
-        Vector3 linearImpulseBody2 = n1 * impulseTranslation.x + n2 * impulseTranslation.y;
-        Vector3 angularImpulseBody2 = mSliderJointComponents.mR2CrossN1[i] * impulseTranslation.x +
-                mSliderJointComponents.mR2CrossN2[i] * impulseTranslation.y;
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
-        angularImpulseBody2 += impulseRotation;
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
+    Vector3 linearImpulseBody2 = n1 * impulseTranslation.x + n2 * impulseTranslation.y;
+    Vector3 angularImpulseBody2 = mSliderJointComponents.mR2CrossN1[i] * impulseTranslation.x +
+            mSliderJointComponents.mR2CrossN2[i] * impulseTranslation.y;
 
-        // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 2
-        linearImpulseBody2 += -linearImpulseLimits;
-        angularImpulseBody2 += -impulseLimits * mSliderJointComponents.mR2CrossSliderAxis[i];
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
+    angularImpulseBody2 += impulseRotation;
 
-        // Compute the impulse P=J^T * lambda for the motor constraint of body 2
-        linearImpulseBody2 += -impulseMotor;
+    // Compute the impulse P=J^T * lambda for the lower and upper limits constraints of body 2
+    linearImpulseBody2 += -linearImpulseLimits;
+    angularImpulseBody2 += -impulseLimits * mSliderJointComponents.mR2CrossSliderAxis[i];
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
-    }
+    // Compute the impulse P=J^T * lambda for the motor constraint of body 2
+    linearImpulseBody2 += -impulseMotor;
+
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the velocity constraint
@@ -324,192 +333,198 @@ void SolveSliderJointSystem::solveVelocityConstraint() {
     // For each joint component
     const uint32 nbJoints = mSliderJointComponents.getNbEnabledComponents();
     for (uint32 i=0; i < nbJoints; i++) {
+        solveVelocityConstraintJoint(i);
+    }
+}
 
-        const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
-        const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
+// Solve the velocity constraint of the joint at a given index in the components arrays
+void SolveSliderJointSystem::solveVelocityConstraintJoint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
-        const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
+    const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
+    const uint32 jointIndex = mJointComponents.getEntityIndex(jointEntity);
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.mBody1Entities[jointIndex];
+    const Entity body2Entity = mJointComponents.mBody2Entities[jointIndex];
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        const Matrix3x3& i1 = mSliderJointComponents.mI1[i];
-        const Matrix3x3& i2 = mSliderJointComponents.mI2[i];
+    // Get local copies of the velocities
+    Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Vector3& n1 = mSliderJointComponents.mN1[i];
-        const Vector3& n2 = mSliderJointComponents.mN2[i];
+    const Matrix3x3& i1 = mSliderJointComponents.mI1[i];
+    const Matrix3x3& i2 = mSliderJointComponents.mI2[i];
 
-        const Vector3& r2CrossN1 = mSliderJointComponents.mR2CrossN1[i];
-        const Vector3& r2CrossN2 = mSliderJointComponents.mR2CrossN2[i];
-        const Vector3& r1PlusUCrossN1 = mSliderJointComponents.mR1PlusUCrossN1[i];
-        const Vector3& r1PlusUCrossN2 = mSliderJointComponents.mR1PlusUCrossN2[i];
+    const Vector3& n1 = mSliderJointComponents.mN1[i];
+    const Vector3& n2 = mSliderJointComponents.mN2[i];
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    const Vector3& r2CrossN1 = mSliderJointComponents.mR2CrossN1[i];
+    const Vector3& r2CrossN2 = mSliderJointComponents.mR2CrossN2[i];
+    const Vector3& r1PlusUCrossN1 = mSliderJointComponents.mR1PlusUCrossN1[i];
+    const Vector3& r1PlusUCrossN2 = mSliderJointComponents.mR1PlusUCrossN2[i];
 
-        const Vector3& r2CrossSliderAxis = mSliderJointComponents.mR2CrossSliderAxis[i];
-        const Vector3& r1PlusUCrossSliderAxis = mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        const Vector3& sliderAxisWorld = mSliderJointComponents.mSliderAxisWorld[i];
+    const Vector3& r2CrossSliderAxis = mSliderJointComponents.mR2CrossSliderAxis[i];
+    const Vector3& r1PlusUCrossSliderAxis = mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
 
-        // --------------- Limits Constraints --------------- //
+    const Vector3& sliderAxisWorld = mSliderJointComponents.mSliderAxisWorld[i];
 
-        if (mSliderJointComponents.mIsLimitEnabled[i]) {
+    // --------------- Limits Constraints --------------- //
 
-            Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-            Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    if (mSliderJointComponents.mIsLimitEnabled[i]) {
 
-            const decimal inverseMassMatrixLimit = mSliderJointComponents.mInverseMassMatrixLimit[i];
+        const decimal inverseMassMatrixLimit = mSliderJointComponents.mInverseMassMatrixLimit[i];
 
-            // If the lower limit is violated
-            if (mSliderJointComponents.mIsLowerLimitViolated[i]) {
+        // If the lower limit is violated
+        if (mSliderJointComponents.mIsLowerLimitViolated[i]) {
 
-                // Compute J*v for the lower limit constraint
-                const decimal JvLowerLimit = sliderAxisWorld.dot(v2) + r2CrossSliderAxis.dot(w2) -
-                                             sliderAxisWorld.dot(v1) - r1PlusUCrossSliderAxis.dot(w1);
+            // Compute J*v for the lower limit constraint
+            const decimal JvLowerLimit = sliderAxisWorld.dot(v2) + r2CrossSliderAxis.dot(w2) -
+                                         sliderAxisWorld.dot(v1) - r1PlusUCrossSliderAxis.dot(w1);
 
-                // Compute the Lagrange multiplier lambda for the lower limit constraint
-                decimal deltaLambdaLower = inverseMassMatrixLimit * (-JvLowerLimit - mSliderJointComponents.mBLowerLimit[i]);
-                decimal lambdaTemp = mSliderJointComponents.mImpulseLowerLimit[i];
-                mSliderJointComponents.mImpulseLowerLimit[i] = std::max(mSliderJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
-                deltaLambdaLower = mSliderJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
+            // Compute the Lagrange multiplier lambda for the lower limit constraint
+            decimal deltaLambdaLower = inverseMassMatrixLimit * (-JvLowerLimit - mSliderJointComponents.mBLowerLimit[i]);
+            decimal lambdaTemp = mSliderJointComponents.mImpulseLowerLimit[i];
+            mSliderJointComponents.mImpulseLowerLimit[i] = std::max(mSliderJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
+            deltaLambdaLower = mSliderJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
-                const Vector3 linearImpulseBody1 = -deltaLambdaLower * sliderAxisWorld;
-                const Vector3 angularImpulseBody1 = -deltaLambdaLower * r1PlusUCrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
+            const Vector3 linearImpulseBody1 = -deltaLambdaLower * sliderAxisWorld;
+            const Vector3 angularImpulseBody1 = -deltaLambdaLower * r1PlusUCrossSliderAxis;
 
-                // Apply the impulse to the body 1
-                v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-                w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
+            // Apply the impulse to the body 1
+            v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+            w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
-                const Vector3 linearImpulseBody2 = deltaLambdaLower * sliderAxisWorld;
-                const Vector3 angularImpulseBody2 = deltaLambdaLower * r2CrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
+            const Vector3 linearImpulseBody2 = deltaLambdaLower * sliderAxisWorld;
+            const Vector3 angularImpulseBody2 = deltaLambdaLower * r2CrossSliderAxis;
 
-                // Apply the impulse to the body 2
-                v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
-                w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
-            }
+            // Apply the impulse to the body 2
+            v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
+            w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
+        }
 
-            // If the upper limit is violated
-            if (mSliderJointComponents.mIsUpperLimitViolated[i]) {
+        // If the upper limit is violated
+        if (mSliderJointComponents.mIsUpperLimitViolated[i]) {
 
-                // Compute J*v for the upper limit constraint
-                const decimal JvUpperLimit = sliderAxisWorld.dot(v1) + r1PlusUCrossSliderAxis.dot(w1)
-                                            - sliderAxisWorld.dot(v2) - r2CrossSliderAxis.dot(w2);
+            // Compute J*v for the upper limit constraint
+            const decimal JvUpperLimit = sliderAxisWorld.dot(v1) + r1PlusUCrossSliderAxis.dot(w1)
+                                        - sliderAxisWorld.dot(v2) - r2CrossSliderAxis.dot(w2);
 
-                // Compute the Lagrange multiplier lambda for the upper limit constraint
-                decimal deltaLambdaUpper = inverseMassMatrixLimit * (-JvUpperLimit -mSliderJointComponents.mBUpperLimit[i]);
-                decimal lambdaTemp = mSliderJointComponents.mImpulseUpperLimit[i];
-                mSliderJointComponents.mImpulseUpperLimit[i] = std::max(mSliderJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
-                deltaLambdaUpper = mSliderJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
+            // Compute the Lagrange multiplier lambda for the upper limit constraint
+            decimal deltaLambdaUpper = inverseMassMatrixLimit * (-JvUpperLimit -mSliderJointComponents.mBUpperLimit[i]);
+            decimal lambdaTemp = mSliderJointComponents.mImpulseUpperLimit[i];
+            mSliderJointComponents.mImpulseUpperLimit[i] = std::max(mSliderJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
+            deltaLambdaUpper = mSliderJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
-                const Vector3 linearImpulseBody1 = deltaLambdaUpper * sliderAxisWorld;
-                const Vector3 angularImpulseBody1 = deltaLambdaUpper * r1PlusUCrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
+            const Vector3 linearImpulseBody1 = deltaLambdaUpper * sliderAxisWorld;
+            const Vector3 angularImpulseBody1 = deltaLambdaUpper * r1PlusUCrossSliderAxis;
 
-                // Apply the impulse to the body 1
-                v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-                w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
+            // Apply the impulse to the body 1
+            v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+            w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
-                const Vector3 linearImpulseBody2 = -deltaLambdaUpper * sliderAxisWorld;
-                const Vector3 angularImpulseBody2 = -deltaLambdaUpper * r2CrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
+            const Vector3 linearImpulseBody2 = -deltaLambdaUpper * sliderAxisWorld;
+            const Vector3 angularImpulseBody2 = -deltaLambdaUpper * r2CrossSliderAxis;
 
-                // Apply the impulse to the body 2
-                v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
-                w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
-            }
+            // Apply the impulse to the body 2
+            v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
+            w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
         }
+    }
 
-        // --------------- Motor --------------- //
+    // --------------- Motor --------------- //
 
-        if (mSliderJointComponents.mIsMotorEnabled[i]) {
+    if (mSliderJointComponents.mIsMotorEnabled[i]) {
 
-            // Compute J*v for the motor
-            const decimal JvMotor = sliderAxisWorld.dot(v1) - sliderAxisWorld.dot(v2);
+        // Compute J*v for the motor
+        const decimal JvMotor = sliderAxisWorld.dot(v1) - sliderAxisWorld.dot(v2);
 
-            // Compute the Lagrange multiplier lambda for the motor
-            const decimal maxMotorImpulse = mSliderJointComponents.mMaxMotorForce[i] * mTimeStep;
-            decimal deltaLambdaMotor = mSliderJointComponents.mInverseMassMatrixMotor[i] * (-JvMotor - mSliderJointComponents.mMotorSpeed[i]);
-            decimal lambdaTemp = mSliderJointComponents.mImpulseMotor[i];
-            mSliderJointComponents.mImpulseMotor[i] = clamp(mSliderJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
-            deltaLambdaMotor = mSliderJointComponents.mImpulseMotor[i] - lambdaTemp;
+        // Compute the Lagrange multiplier lambda for the motor
+        const decimal maxMotorImpulse = mSliderJointComponents.mMaxMotorForce[i] * mTimeStep;
+        decimal deltaLambdaMotor = mSliderJointComponents.mInverseMassMatrixMotor[i] * (-JvMotor - mSliderJointComponents.mMotorSpeed[i]);
+        decimal lambdaTemp = mSliderJointComponents.mImpulseMotor[i];
+        mSliderJointComponents.mImpulseMotor[i] = clamp(mSliderJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
+        deltaLambdaMotor = mSliderJointComponents.mImpulseMotor[i] - lambdaTemp;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 1
-            const Vector3 linearImpulseBody1 = deltaLambdaMotor * sliderAxisWorld;
+        // Compute the impulse P=J^T * lambda for the motor of body 1
+        const Vector3 linearImpulseBody1 = deltaLambdaMotor * sliderAxisWorld;
 
-            // Apply the impulse to the body 1
-            v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+        // Apply the impulse to the body 1
+        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 2
-            const Vector3 linearImpulseBody2 = -deltaLambdaMotor * sliderAxisWorld;
+        // Compute the impulse P=J^T * lambda for the motor of body 2
+        const Vector3 linearImpulseBody2 = -deltaLambdaMotor * sliderAxisWorld;
 
-            // Apply the impulse to the body 2
-            v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
-        }
+        // Apply the impulse to the body 2
+        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
+    }
 
-        // --------------- Rotation Constraints --------------- //
+    // --------------- Rotation Constraints --------------- //
 
-        // Compute J*v for the 3 rotation constraints
-        const Vector3 JvRotation = w2 - w1;
+    // Compute J*v for the 3 rotation constraints
+    const Vector3 JvRotation = w2 - w1;
 
-        // Compute the Lagrange multiplier lambda for the 3 rotation constraints
-        Vector3 deltaLambda2 = mSliderJointComponents.mInverseMassMatrixRotation[i] *
-                               (-JvRotation - mSliderJointComponents.getBiasRotation(jointEntity));
-        mSliderJointComponents.mImpulseRotation[i] += deltaLambda2;
+    // Compute the Lagrange multiplier lambda for the 3 rotation constraints
+    Vector3 deltaLambda2 = mSliderJointComponents.mInverseMassMatrixRotation[i] *
+                           (-JvRotation - mSliderJointComponents.getBiasRotation(jointEntity));
+    mSliderJointComponents.mImpulseRotation[i] += deltaLambda2;
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
-        Vector3 angularImpulseBody1 = -deltaLambda2;
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
+    Vector3 angularImpulseBody1 = -deltaLambda2;
 
-        // Apply the impulse to the body 1
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
+    // Apply the impulse to the body 1
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (mSliderJointComponents.mI1[i] * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
-        Vector3 angularImpulseBody2 = deltaLambda2;
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
+    Vector3 angularImpulseBody2 = deltaLambda2;
 
-        // Apply the impulse to the body 2
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
+    // Apply the impulse to the body 2
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (mSliderJointComponents.mI2[i] * angularImpulseBody2);
 
-        // --------------- Translation Constraints --------------- //
+    // --------------- Translation Constraints --------------- //
 
-        // Compute J*v for the 2 translation constraints
-        const decimal el1 = -n1.dot(v1) - w1.dot(r1PlusUCrossN1) +
-                             n1.dot(v2) + w2.dot(r2CrossN1);
-        const decimal el2 = -n2.dot(v1) - w1.dot(r1PlusUCrossN2) +
-                             n2.dot(v2) + w2.dot(r2CrossN2);
-        const Vector2 JvTranslation(el1, el2);
+    // Compute J*v for the 2 translation constraints
+    const decimal el1 = -n1.dot(v1) - w1.dot(r1PlusUCrossN1) +
+                         n1.dot(v2) + w2.dot(r2CrossN1);
+    const decimal el2 = -n2.dot(v1) - w1.dot(r1PlusUCrossN2) +
+                         n2.dot(v2) + w2.dot(r2CrossN2);
+    const Vector2 JvTranslation(el1, el2);
 
-        // Compute the Lagrange multiplier lambda for the 2 translation constraints
-        const Vector2 deltaLambda = mSliderJointComponents.mInverseMassMatrixTranslation[i] * (-JvTranslation - mSliderJointComponents.mBiasTranslation[i]);
-        mSliderJointComponents.mImpulseTranslation[i] += deltaLambda;
+    // Compute the Lagrange multiplier lambda for the 2 translation constraints
+    const Vector2 deltaLambda = mSliderJointComponents.mInverseMassMatrixTranslation[i] * (-JvTranslation - mSliderJointComponents.mBiasTranslation[i]);
+    mSliderJointComponents.mImpulseTranslation[i] += deltaLambda;
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
-        const Vector3 linearImpulseBody1 = -n1 * deltaLambda.x - n2 * deltaLambda.y;
-        angularImpulseBody1 = -r1PlusUCrossN1 * deltaLambda.x -
-                r1PlusUCrossN2 * deltaLambda.y;
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
+    const Vector3 linearImpulseBody1 = -n1 * deltaLambda.x - n2 * deltaLambda.y;
+    angularImpulseBody1 = -r1PlusUCrossN1 * deltaLambda.x -
+            r1PlusUCrossN2 * deltaLambda.y;
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
-        w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody1] * linearImpulseBody1;
+    w1 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody1] * (i1 * angularImpulseBody1);
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
-        const Vector3 linearImpulseBody2 = -linearImpulseBody1;
-        angularImpulseBody2 = r2CrossN1 * deltaLambda.x + r2CrossN2 * deltaLambda.y;
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
+    const Vector3 linearImpulseBody2 = -linearImpulseBody1;
+    angularImpulseBody2 = r2CrossN1 * deltaLambda.x + r2CrossN2 * deltaLambda.y;
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
-        w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
-    }
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * mRigidBodyComponents.mLinearLockAxisFactors[componentIndexBody2] * linearImpulseBody2;
+    w2 += mRigidBodyComponents.mAngularLockAxisFactors[componentIndexBody2] * (i2 * angularImpulseBody2);
+
+    // Write back the velocities of the bodies
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody1, v1, w1);
+    mRigidBodyComponents.updateConstrainedVelocitiesOfDynamicBody(componentIndexBody2, v2, w2);
 }
 
 // Solve the position constraint (for position error correction)
@@ -0,0 +1,250 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/DefaultTaskScheduler.h>
+#include <new>
+
+using namespace reactphysics3d;
+
+// Static variables
+thread_local const DefaultTaskScheduler* DefaultTaskScheduler::mCurrentScheduler = nullptr;
+thread_local uint32 DefaultTaskScheduler::mCurrentWorkerIndex = 0;
+
+// Constructor
+/**
+ * @param allocator Memory allocator used to allocate the worker threads
+ * @param nbWorkers Number of workers (including the calling thread). If zero, the number
+ *                  of hardware threads of the system is used.
+ */
+DefaultTaskScheduler::DefaultTaskScheduler(MemoryAllocator& allocator, uint32 nbWorkers)
+                     : mAllocator(allocator), mNbWorkers(nbWorkers), mThreads(nullptr), mWorkQueues(nullptr),
+                       mFunction(nullptr), mNbItems(0), mChunkSize(1), mJobIndex(0), mNbBusyWorkerThreads(0),
+                       mIsQuitting(false) {
+
+    if (mNbWorkers == 0) {
+        mNbWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Create the work queues
+    mWorkQueues = static_cast<WorkQueue*>(mAllocator.allocate(computeAllocatedSize(mNbWorkers * sizeof(WorkQueue))));
+    for (uint32 i=0; i < mNbWorkers; i++) {
+        new (mWorkQueues + i) WorkQueue();
+    }
+
+    // Start the worker threads (the calling thread of a parallel-for is the worker 0)
+    if (mNbWorkers > 1) {
+        mThreads = static_cast<std::thread*>(mAllocator.allocate(computeAllocatedSize((mNbWorkers - 1) * sizeof(std::thread))));
+        for (uint32 i=1; i < mNbWorkers; i++) {
+            new (mThreads + i - 1) std::thread(&DefaultTaskScheduler::runWorkerThread, this, i);
+        }
+    }
+}
+
+// Destructor
+DefaultTaskScheduler::~DefaultTaskScheduler() {
+
+    // Ask the worker threads to terminate
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsQuitting = true;
+    }
+    mWorkAvailableCondition.notify_all();
+
+    // Wait for the worker threads and release them
+    if (mThreads != nullptr) {
+        for (uint32 i=0; i < mNbWorkers - 1; i++) {
+            mThreads[i].join();
+            mThreads[i].~thread();
+        }
+        mAllocator.release(mThreads, computeAllocatedSize((mNbWorkers - 1) * sizeof(std::thread)));
+    }
+
+    // Release the work queues
+    for (uint32 i=0; i < mNbWorkers; i++) {
+        mWorkQueues[i].~WorkQueue();
+    }
+    mAllocator.release(mWorkQueues, computeAllocatedSize(mNbWorkers * sizeof(WorkQueue)));
+}
+
+// Call the function for each chunk of the range [0, nbItems[ and return once all the chunks have been processed
+/**
+ * @param nbItems Number of items to process
+ * @param chunkSize Maximum number of items processed by a single call of the function
+ * @param function Function called for each chunk
+ */
+void DefaultTaskScheduler::parallelFor(uint32 nbItems, uint32 chunkSize, const ParallelForFunction& function) {
+
+    if (nbItems == 0) return;
+
+    const uint32 nbChunks = computeNbChunks(nbItems, chunkSize);
+
+    // If this thread is already executing a task of this scheduler (nested parallel-for)
+    if (mCurrentScheduler == this) {
+
+        // Execute all the chunks sequentially with the current worker
+        for (uint32 c=0; c < nbChunks; c++) {
+            executeChunk(function, c, nbItems, chunkSize, mCurrentWorkerIndex);
+        }
+
+        return;
+    }
+
+    // Only one parallel-for can use the workers at a time
+    std::lock_guard<std::mutex> submitLock(mSubmitMutex);
+
+    const DefaultTaskScheduler* previousScheduler = mCurrentScheduler;
+    const uint32 previousWorkerIndex = mCurrentWorkerIndex;
+    mCurrentScheduler = this;
+    mCurrentWorkerIndex = 0;
+
+    // If there is no need to wake up the worker threads
+    if (mNbWorkers == 1 || nbChunks == 1) {
+
+        // Execute all the chunks in order on the calling thread
+        for (uint32 c=0; c < nbChunks; c++) {
+            executeChunk(function, c, nbItems, chunkSize, 0);
+        }
+    }
+    else {
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            mFunction = &function;
+            mNbItems = nbItems;
+            mChunkSize = chunkSize;
+
+            // Give a contiguous range of chunks to each worker
+            for (uint32 i=0; i < mNbWorkers; i++) {
+                std::lock_guard<std::mutex> queueLock(mWorkQueues[i].mutex);
+                mWorkQueues[i].startChunk = static_cast<uint32>((uint64(nbChunks) * i) / mNbWorkers);
+                mWorkQueues[i].endChunk = static_cast<uint32>((uint64(nbChunks) * (i + 1)) / mNbWorkers);
+            }
+
+            mNbBusyWorkerThreads = mNbWorkers - 1;
+            mJobIndex++;
+        }
+
+        // Wake up the worker threads
+        mWorkAvailableCondition.notify_all();
+
+        // The calling thread is the worker 0
+        executeChunks(0);
+
+        // Wait until all the worker threads are done with this parallel-for
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWorkDoneCondition.wait(lock, [this]() { return mNbBusyWorkerThreads == 0; });
+        mFunction = nullptr;
+    }
+
+    mCurrentScheduler = previousScheduler;
+    mCurrentWorkerIndex = previousWorkerIndex;
+}
+
+// Main loop of a worker thread
+void DefaultTaskScheduler::runWorkerThread(uint32 workerIndex) {
+
+    mCurrentScheduler = this;
+    mCurrentWorkerIndex = workerIndex;
+
+    uint64 lastJobIndex = 0;
+
+    while (true) {
+
+        // Wait for a new parallel-for (or for the termination of the scheduler)
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkAvailableCondition.wait(lock, [this, lastJobIndex]() { return mIsQuitting || mJobIndex != lastJobIndex; });
+
+            if (mIsQuitting) return;
+
+            lastJobIndex = mJobIndex;
+        }
+
+        executeChunks(workerIndex);
+
+        // Notify the calling thread that this worker is done
+        bool isLastWorker;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            assert(mNbBusyWorkerThreads > 0);
+            mNbBusyWorkerThreads--;
+            isLastWorker = mNbBusyWorkerThreads == 0;
+        }
+        if (isLastWorker) {
+            mWorkDoneCondition.notify_one();
+        }
+    }
+}
+
+// Process chunks of the current parallel-for until there is no more work
+void DefaultTaskScheduler::executeChunks(uint32 workerIndex) {
+
+    const ParallelForFunction& function = *mFunction;
+    const uint32 nbItems = mNbItems;
+    const uint32 chunkSize = mChunkSize;
+
+    uint32 chunkIndex;
+    while (popChunk(workerIndex, chunkIndex) || stealChunk(workerIndex, chunkIndex)) {
+        executeChunk(function, chunkIndex, nbItems, chunkSize, workerIndex);
+    }
+}
+
+// Take the next chunk of the work queue of a worker
+bool DefaultTaskScheduler::popChunk(uint32 workerIndex, uint32& chunkIndex) {
+
+    WorkQueue& queue = mWorkQueues[workerIndex];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.startChunk < queue.endChunk) {
+        chunkIndex = queue.startChunk;
+        queue.startChunk++;
+        return true;
+    }
+
+    return false;
+}
+
+// Steal a chunk from the work queue of another worker
+bool DefaultTaskScheduler::stealChunk(uint32 workerIndex, uint32& chunkIndex) {
+
+    for (uint32 i=1; i < mNbWorkers; i++) {
+
+        WorkQueue& queue = mWorkQueues[(workerIndex + i) % mNbWorkers];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        // Steal from the back of the queue to stay away from its owner
+        if (queue.startChunk < queue.endChunk) {
+            queue.endChunk--;
+            chunkIndex = queue.endChunk;
+            return true;
+        }
+    }
+
+    return false;
+}
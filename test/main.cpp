@@ -32,23 +32,41 @@
 #include "tests/mathematics/TestMatrix2x2.h"
 #include "tests/mathematics/TestMatrix3x3.h"
 #include "tests/mathematics/TestMathematicsFunctions.h"
+#include "tests/mathematics/TestSimdVector.h"
 #include "tests/collision/TestPointInside.h"
 #include "tests/collision/TestRaycast.h"
 #include "tests/collision/TestWorldQueries.h"
 #include "tests/collision/TestAABB.h"
 #include "tests/collision/TestDynamicAABBTree.h"
+#include "tests/collision/TestWideAABBTree.h"
+#include "tests/collision/TestRaycastBatch.h"
 #include "tests/collision/TestHalfEdgeStructure.h"
 #include "tests/collision/TestTriangleVertexArray.h"
 #include "tests/collision/TestConvexMesh.h"
 #include "tests/collision/TestTriangleMesh.h"
 #include "tests/collision/TestHeightField.h"
+#include "tests/collision/TestBoxVsBox.h"
+#include "tests/collision/TestConvexVsConcave.h"
+#include "tests/collision/TestEPA.h"
+#include "tests/collision/TestParallelCollisionDetection.h"
 #include "tests/containers/TestArray.h"
 #include "tests/containers/TestMap.h"
 #include "tests/containers/TestSet.h"
 #include "tests/containers/TestDeque.h"
 #include "tests/containers/TestStack.h"
+#include "tests/containers/TestUnionFind.h"
+#include "tests/memory/TestConcurrentPoolAllocator.h"
+#include "tests/memory/TestSingleFrameAllocator.h"
 #include "tests/engine/TestRigidBody.h"
+#include "tests/engine/TestDeterminism.h"
+#include "tests/engine/TestSimdContactSolver.h"
+#include "tests/engine/TestParallelIslandSolver.h"
+#include "tests/engine/TestGraphColoringContactSolver.h"
+#include "tests/engine/TestIslands.h"
+#include "tests/engine/TestParallelWorlds.h"
+#include "tests/engine/TestTemporalCoherence.h"
 #include "tests/utils/TestQuickHull.h"
+#include "tests/utils/TestTaskScheduler.h"
 
 using namespace reactphysics3d;
 
@@ -63,6 +81,7 @@ int main() {
     testSuite.addTest(new TestMap("Map"));
     testSuite.addTest(new TestDeque("Deque"));
     testSuite.addTest(new TestStack("Stack"));
+    testSuite.addTest(new TestUnionFind("UnionFind"));
 
     // ---------- Mathematics tests ---------- //
 
@@ -73,6 +92,7 @@ int main() {
     testSuite.addTest(new TestMatrix3x3("Matrix3x3"));
     testSuite.addTest(new TestMatrix2x2("Matrix2x2"));
     testSuite.addTest(new TestMathematicsFunctions("Maths Functions"));
+    testSuite.addTest(new TestSimdVector("SimdVector"));
 
     // ---------- Collision Detection tests ---------- //
 
@@ -82,18 +102,37 @@ int main() {
     testSuite.addTest(new TestRaycast("Raycasting"));
     testSuite.addTest(new TestWorldQueries("WorldQueries"));
     testSuite.addTest(new TestDynamicAABBTree("DynamicAABBTree"));
+    testSuite.addTest(new TestWideAABBTree("WideAABBTree"));
+    testSuite.addTest(new TestRaycastBatch("RaycastBatch"));
     testSuite.addTest(new TestHalfEdgeStructure("HalfEdgeStructure"));
     testSuite.addTest(new TestConvexMesh("ConvexMesh"));
     testSuite.addTest(new TestTriangleMesh("TriangleMesh"));
     testSuite.addTest(new TestHeightField("HeightField"));
+    testSuite.addTest(new TestBoxVsBox("BoxVsBox"));
+    testSuite.addTest(new TestConvexVsConcave("ConvexVsConcave"));
+    testSuite.addTest(new TestEPA("EPA"));
+    testSuite.addTest(new TestParallelCollisionDetection("ParallelCollisionDetection"));
 
     // ---------- Utils tests ---------- //
 
     testSuite.addTest(new TestQuickHull("QuickHull"));
+    testSuite.addTest(new TestTaskScheduler("TaskScheduler"));
+
+    // ---------- Memory tests ---------- //
+
+    testSuite.addTest(new TestConcurrentPoolAllocator("ConcurrentPoolAllocator"));
+    testSuite.addTest(new TestSingleFrameAllocator("SingleFrameAllocator"));
 
     // ---------- Engine tests ---------- //
 
     testSuite.addTest(new TestRigidBody("RigidBody"));
+    testSuite.addTest(new TestDeterminism("Determinism"));
+    testSuite.addTest(new TestSimdContactSolver("SimdContactSolver"));
+    testSuite.addTest(new TestParallelIslandSolver("ParallelIslandSolver"));
+    testSuite.addTest(new TestGraphColoringContactSolver("GraphColoringContactSolver"));
+    testSuite.addTest(new TestIslands("Islands"));
+    testSuite.addTest(new TestParallelWorlds("ParallelWorlds"));
+    testSuite.addTest(new TestTemporalCoherence("TemporalCoherence"));
 
     // Run the tests
     testSuite.run();
@@ -0,0 +1,257 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_BOX_VS_BOX_H
+#define TEST_BOX_VS_BOX_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Collision callback that keeps the contact points of a single pair of colliders
+class BoxContactsCallback : public CollisionCallback {
+
+    public:
+
+        bool isColliding = false;
+        decimal maxPenetrationDepth = 0;
+        Vector3 normal;
+        bool areContactPointsValid = true;
+
+        void reset() {
+            isColliding = false;
+            maxPenetrationDepth = 0;
+            areContactPointsValid = true;
+        }
+
+        virtual void onContact(const CallbackData& callbackData) override {
+
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+
+                const ContactPair contactPair = callbackData.getContactPair(p);
+                const Transform& transform1 = contactPair.getCollider1()->getLocalToWorldTransform();
+                const Transform& transform2 = contactPair.getCollider2()->getLocalToWorldTransform();
+
+                for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+
+                    const ContactPoint contactPoint = contactPair.getContactPoint(c);
+                    isColliding = true;
+
+                    // The distance between the two points along the normal must be the penetration depth
+                    const Vector3 point1 = transform1 * contactPoint.getLocalPointOnCollider1();
+                    const Vector3 point2 = transform2 * contactPoint.getLocalPointOnCollider2();
+                    if (std::abs((point1 - point2).dot(contactPoint.getWorldNormal()) - contactPoint.getPenetrationDepth()) > decimal(0.01)) {
+                        areContactPointsValid = false;
+                    }
+
+                    if (contactPoint.getPenetrationDepth() > maxPenetrationDepth) {
+                        maxPenetrationDepth = contactPoint.getPenetrationDepth();
+                        normal = contactPoint.getWorldNormal();
+                    }
+                }
+            }
+        }
+};
+
+// Class TestBoxVsBox
+/**
+ * Unit test for the BoxVsBoxAlgorithm class. The results of the box vs box algorithm
+ * are compared with the results of the SAT algorithm for convex polyhedrons on the same
+ * boxes represented as convex meshes.
+ */
+class TestBoxVsBox : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of random pairs of boxes
+        static const int NB_PAIRS = 1000;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// World with the box shapes (box vs box algorithm)
+        PhysicsWorld* mBoxWorld;
+
+        /// World with the convex mesh shapes (SAT algorithm)
+        PhysicsWorld* mMeshWorld;
+
+        /// Convex mesh of a cube with half-extents of one
+        ConvexMesh* mCubeMesh;
+
+        RigidBody* mBoxBody1;
+        RigidBody* mBoxBody2;
+        RigidBody* mMeshBody1;
+        RigidBody* mMeshBody2;
+
+        float mVertices[24];
+        uint32 mIndices[24];
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1u << 24);
+        }
+
+        /// Return a random unit quaternion
+        Quaternion randomQuaternion() {
+            Quaternion quaternion(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+            quaternion.normalize();
+            return quaternion;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestBoxVsBox(const std::string& name) : Test(name), mRandomState(12345) {
+
+            mBoxWorld = mPhysicsCommon.createPhysicsWorld();
+            mMeshWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Cube
+            mVertices[0] = -1; mVertices[1] = -1; mVertices[2] = 1;
+            mVertices[3] = 1; mVertices[4] = -1; mVertices[5] = 1;
+            mVertices[6] = 1; mVertices[7] = -1; mVertices[8] = -1;
+            mVertices[9] = -1; mVertices[10] = -1; mVertices[11] = -1;
+            mVertices[12] = -1; mVertices[13] = 1; mVertices[14] = 1;
+            mVertices[15] = 1; mVertices[16] = 1; mVertices[17] = 1;
+            mVertices[18] = 1; mVertices[19] = 1; mVertices[20] = -1;
+            mVertices[21] = -1; mVertices[22] = 1; mVertices[23] = -1;
+
+            mIndices[0] = 0; mIndices[1] = 3; mIndices[2] = 2; mIndices[3] = 1;
+            mIndices[4] = 4; mIndices[5] = 5; mIndices[6] = 6; mIndices[7] = 7;
+            mIndices[8] = 0; mIndices[9] = 1; mIndices[10] = 5; mIndices[11] = 4;
+            mIndices[12] = 1; mIndices[13] = 2; mIndices[14] = 6; mIndices[15] = 5;
+            mIndices[16] = 2; mIndices[17] = 3; mIndices[18] = 7; mIndices[19] = 6;
+            mIndices[20] = 0; mIndices[21] = 4; mIndices[22] = 7; mIndices[23] = 3;
+
+            PolygonVertexArray::PolygonFace faces[6];
+            for (int f = 0; f < 6; f++) {
+                faces[f].indexBase = f * 4;
+                faces[f].nbVertices = 4;
+            }
+            PolygonVertexArray polygonVertexArray(8, &(mVertices[0]), 3 * sizeof(float),
+                    &(mIndices[0]), sizeof(int), 6, faces,
+                    rp3d::PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<Message> messages;
+            mCubeMesh = mPhysicsCommon.createConvexMesh(polygonVertexArray, messages);
+
+            mBoxBody1 = mBoxWorld->createRigidBody(Transform::identity());
+            mBoxBody2 = mBoxWorld->createRigidBody(Transform::identity());
+            mMeshBody1 = mMeshWorld->createRigidBody(Transform::identity());
+            mMeshBody2 = mMeshWorld->createRigidBody(Transform::identity());
+        }
+
+        /// Destructor
+        virtual ~TestBoxVsBox() {
+            mPhysicsCommon.destroyPhysicsWorld(mBoxWorld);
+            mPhysicsCommon.destroyPhysicsWorld(mMeshWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testCompareWithSAT();
+        }
+
+        /// Compare the box vs box algorithm with the SAT algorithm on random pairs of boxes
+        void testCompareWithSAT() {
+
+            BoxContactsCallback boxCallback;
+            BoxContactsCallback meshCallback;
+
+            for (int i=0; i < NB_PAIRS; i++) {
+
+                const Vector3 halfExtents1(random(0.2, 2), random(0.2, 2), random(0.2, 2));
+                const Vector3 halfExtents2(random(0.2, 2), random(0.2, 2), random(0.2, 2));
+                const Transform transform1(Vector3(random(-0.5, 0.5), random(-0.5, 0.5), random(-0.5, 0.5)), randomQuaternion());
+
+                // Some pairs have the same orientation (parallel edges and coplanar faces)
+                const Quaternion orientation2 = i % 4 == 0 ? transform1.getOrientation() : randomQuaternion();
+                const Transform transform2(Vector3(random(-3, 3), random(-3, 3), random(-3, 3)), orientation2);
+
+                BoxShape* boxShape1 = mPhysicsCommon.createBoxShape(halfExtents1);
+                BoxShape* boxShape2 = mPhysicsCommon.createBoxShape(halfExtents2);
+                ConvexMeshShape* meshShape1 = mPhysicsCommon.createConvexMeshShape(mCubeMesh, halfExtents1);
+                ConvexMeshShape* meshShape2 = mPhysicsCommon.createConvexMeshShape(mCubeMesh, halfExtents2);
+
+                mBoxBody1->setTransform(transform1);
+                mBoxBody2->setTransform(transform2);
+                mMeshBody1->setTransform(transform1);
+                mMeshBody2->setTransform(transform2);
+                Collider* boxCollider1 = mBoxBody1->addCollider(boxShape1, Transform::identity());
+                Collider* boxCollider2 = mBoxBody2->addCollider(boxShape2, Transform::identity());
+                Collider* meshCollider1 = mMeshBody1->addCollider(meshShape1, Transform::identity());
+                Collider* meshCollider2 = mMeshBody2->addCollider(meshShape2, Transform::identity());
+
+                boxCallback.reset();
+                meshCallback.reset();
+                mBoxWorld->testCollision(mBoxBody1, mBoxBody2, boxCallback);
+                mMeshWorld->testCollision(mMeshBody1, mMeshBody2, meshCallback);
+
+                rp3d_test(boxCallback.areContactPointsValid);
+
+                // The pairs that are almost touching can be classified differently by the two algorithms
+                if (boxCallback.maxPenetrationDepth > decimal(0.001) || meshCallback.maxPenetrationDepth > decimal(0.001)) {
+
+                    rp3d_test(boxCallback.isColliding == meshCallback.isColliding);
+                    rp3d_test(mBoxWorld->testOverlap(mBoxBody1, mBoxBody2) == mMeshWorld->testOverlap(mMeshBody1, mMeshBody2));
+                    rp3d_test(std::abs(boxCallback.maxPenetrationDepth - meshCallback.maxPenetrationDepth) < decimal(0.01));
+
+                    if (boxCallback.isColliding && meshCallback.isColliding) {
+                        rp3d_test(boxCallback.normal.dot(meshCallback.normal) > decimal(0.99));
+                    }
+                }
+                else if (!boxCallback.isColliding && !meshCallback.isColliding) {
+                    rp3d_test(!mBoxWorld->testOverlap(mBoxBody1, mBoxBody2));
+                }
+
+                mBoxBody1->removeCollider(boxCollider1);
+                mBoxBody2->removeCollider(boxCollider2);
+                mMeshBody1->removeCollider(meshCollider1);
+                mMeshBody2->removeCollider(meshCollider2);
+                mPhysicsCommon.destroyBoxShape(boxShape1);
+                mPhysicsCommon.destroyBoxShape(boxShape2);
+                mPhysicsCommon.destroyConvexMeshShape(meshShape1);
+                mPhysicsCommon.destroyConvexMeshShape(meshShape2);
+            }
+        }
+ };
+
+}
+
+#endif
@@ -100,6 +100,7 @@ class TestConvexMesh : public Test {
         /// Run the tests
         void run() {
             test();
+            testSupportVertex();
         }
 
         void test() {
@@ -133,6 +134,59 @@ class TestConvexMesh : public Test {
             rp3d_test(Vector3::approxEqual(mConvexMesh->getBounds().getMin(), Vector3(-3, -3 ,-3)));
             rp3d_test(Vector3::approxEqual(mConvexMesh->getBounds().getMax(), Vector3(3, 3 ,3)));
         }
+
+        /// Test the search of the support vertex (all the vertices and hill-climbing)
+        void testSupportVertex() {
+
+            // Convex hull of points on a sphere
+            uint32 randomState = 12345;
+            auto random = [&randomState]() {
+                randomState = randomState * 1664525u + 1013904223u;
+                return float(randomState >> 8) / float(1u << 24) * 2.0f - 1.0f;
+            };
+            std::vector<float> points;
+            while (points.size() < 3 * 200) {
+                const Vector3 point(random(), random(), random());
+                if (point.lengthSquare() < decimal(0.01) || point.lengthSquare() > decimal(1.0)) continue;
+                const Vector3 unitPoint = point.getUnit();
+                points.push_back(float(unitPoint.x) * 2.0f);
+                points.push_back(float(unitPoint.y) * 3.0f);
+                points.push_back(float(unitPoint.z));
+            }
+            VertexArray vertexArray(points.data(), 3 * sizeof(float), uint32(points.size() / 3), VertexArray::DataType::VERTEX_FLOAT_TYPE);
+            std::vector<Message> messages;
+            ConvexMesh* convexMesh = mPhysicsCommon.createConvexMesh(vertexArray, messages);
+            rp3d_test(convexMesh != nullptr);
+
+            for (ConvexMesh* mesh : {mConvexMesh, convexMesh}) {
+
+                uint32 vertexIndex = 0;
+                for (int i=0; i < 500; i++) {
+
+                    const Vector3 direction(random(), random(), random());
+
+                    // Largest dot product with a scalar loop over the vertices
+                    decimal maxDotProduct = -DECIMAL_LARGEST;
+                    for (uint32 v=0; v < mesh->getNbVertices(); v++) {
+                        maxDotProduct = std::max(maxDotProduct, direction.dot(mesh->getVertex(v)));
+                    }
+
+                    const uint32 supportIndex = mesh->computeSupportVertexIndex(direction);
+                    rp3d_test(supportIndex < mesh->getNbVertices());
+                    rp3d_test(direction.dot(mesh->getVertex(supportIndex)) == maxDotProduct);
+
+                    // Hill-climbing from the previous support vertex
+                    vertexIndex = mesh->computeSupportVertexIndex(direction, vertexIndex);
+                    rp3d_test(approxEqual(direction.dot(mesh->getVertex(vertexIndex)), maxDotProduct, decimal(0.0001)));
+
+                    // Hill-climbing from an arbitrary vertex
+                    const uint32 startIndex = uint32(i) % mesh->getNbVertices();
+                    rp3d_test(approxEqual(direction.dot(mesh->getVertex(mesh->computeSupportVertexIndex(direction, startIndex))), maxDotProduct, decimal(0.0001)));
+                }
+            }
+
+            mPhysicsCommon.destroyConvexMesh(convexMesh);
+        }
  };
 
 }
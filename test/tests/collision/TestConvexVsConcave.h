@@ -0,0 +1,338 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_CONVEX_VS_CONCAVE_H
+#define TEST_CONVEX_VS_CONCAVE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Collision callback that keeps the deepest contact point between a convex collider and a concave collider
+class ConcaveContactsCallback : public CollisionCallback {
+
+    public:
+
+        bool isColliding = false;
+        decimal maxPenetrationDepth = 0;
+        Vector3 normal;
+        uint32 nbContactPoints = 0;
+
+        void reset() {
+            isColliding = false;
+            maxPenetrationDepth = 0;
+            nbContactPoints = 0;
+        }
+
+        virtual void onContact(const CallbackData& callbackData) override {
+
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+
+                const ContactPair contactPair = callbackData.getContactPair(p);
+
+                for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+
+                    const ContactPoint contactPoint = contactPair.getContactPoint(c);
+                    isColliding = true;
+                    nbContactPoints++;
+
+                    if (contactPoint.getPenetrationDepth() > maxPenetrationDepth) {
+                        maxPenetrationDepth = contactPoint.getPenetrationDepth();
+                        normal = contactPoint.getWorldNormal();
+                    }
+                }
+            }
+        }
+};
+
+// Class TestConvexVsConcave
+/**
+ * Unit test for the collision detection between convex shapes and concave shapes. Spheres,
+ * capsules and boxes are tested against a flat triangle mesh and a flat height field for which
+ * the penetration depths are known.
+ */
+class TestConvexVsConcave : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of vertices on each side of the grid of the concave shapes
+        static const int GRID_SIZE = 11;
+
+        /// Number of random poses tested for each pair of shapes
+        static const int NB_POSES = 300;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        float mMeshVertices[GRID_SIZE * GRID_SIZE * 3];
+        int mMeshIndices[(GRID_SIZE - 1) * (GRID_SIZE - 1) * 6];
+        float mHeightData[GRID_SIZE * GRID_SIZE];
+
+        TriangleMesh* mTriangleMesh;
+        HeightField* mHeightField;
+
+        ConcaveMeshShape* mConcaveMeshShape;
+        HeightFieldShape* mHeightFieldShape;
+        SphereShape* mSphereShape;
+        CapsuleShape* mCapsuleShape;
+        BoxShape* mBoxShape;
+
+        RigidBody* mConcaveMeshBody;
+        RigidBody* mHeightFieldBody;
+        RigidBody* mConvexBody;
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1u << 24);
+        }
+
+        /// Return a random unit quaternion
+        Quaternion randomQuaternion() {
+            Quaternion quaternion(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+            quaternion.normalize();
+            return quaternion;
+        }
+
+        /// Return the lowest height of the convex shape in world-space
+        decimal computeLowestHeight(const CollisionShape* shape, const Transform& transform) const {
+
+            const Matrix3x3 rotation = transform.getOrientation().getMatrix();
+            decimal lowestHeight = transform.getPosition().y;
+
+            if (shape == mSphereShape) {
+                lowestHeight -= mSphereShape->getRadius();
+            }
+            else if (shape == mCapsuleShape) {
+                lowestHeight -= std::abs(rotation[1][1]) * mCapsuleShape->getHeight() * decimal(0.5) + mCapsuleShape->getRadius();
+            }
+            else {
+                const Vector3& halfExtents = mBoxShape->getHalfExtents();
+                lowestHeight -= std::abs(rotation[1][0]) * halfExtents.x + std::abs(rotation[1][1]) * halfExtents.y +
+                                std::abs(rotation[1][2]) * halfExtents.z;
+            }
+
+            return lowestHeight;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestConvexVsConcave(const std::string& name) : Test(name), mRandomState(4321) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Flat grid of triangles centered at the origin in the plane y=0
+            const int halfSize = (GRID_SIZE - 1) / 2;
+            for (int i=0; i < GRID_SIZE; i++) {
+                for (int j=0; j < GRID_SIZE; j++) {
+                    const int vertexIndex = i * GRID_SIZE + j;
+                    mMeshVertices[vertexIndex * 3] = float(i - halfSize);
+                    mMeshVertices[vertexIndex * 3 + 1] = 0;
+                    mMeshVertices[vertexIndex * 3 + 2] = float(j - halfSize);
+                    mHeightData[vertexIndex] = 0;
+                }
+            }
+            int index = 0;
+            for (int i=0; i < GRID_SIZE - 1; i++) {
+                for (int j=0; j < GRID_SIZE - 1; j++) {
+                    const int v1 = i * GRID_SIZE + j;
+                    const int v2 = i * GRID_SIZE + j + 1;
+                    const int v3 = (i + 1) * GRID_SIZE + j;
+                    const int v4 = (i + 1) * GRID_SIZE + j + 1;
+                    mMeshIndices[index++] = v1; mMeshIndices[index++] = v2; mMeshIndices[index++] = v3;
+                    mMeshIndices[index++] = v2; mMeshIndices[index++] = v4; mMeshIndices[index++] = v3;
+                }
+            }
+
+            TriangleVertexArray triangleVertexArray(GRID_SIZE * GRID_SIZE, &(mMeshVertices[0]), 3 * sizeof(float),
+                                                    (GRID_SIZE - 1) * (GRID_SIZE - 1) * 2, &(mMeshIndices[0]), 3 * sizeof(int),
+                                                    TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                                    TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<Message> messages;
+            mTriangleMesh = mPhysicsCommon.createTriangleMesh(triangleVertexArray, messages);
+            rp3d_test(mTriangleMesh != nullptr);
+
+            messages.clear();
+            mHeightField = mPhysicsCommon.createHeightField(GRID_SIZE, GRID_SIZE, mHeightData,
+                                                            HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            rp3d_test(mHeightField != nullptr);
+
+            mConcaveMeshShape = mPhysicsCommon.createConcaveMeshShape(mTriangleMesh);
+            mHeightFieldShape = mPhysicsCommon.createHeightFieldShape(mHeightField);
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mCapsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.3), decimal(1.2));
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.4), decimal(0.7), decimal(1.1)));
+
+            mConcaveMeshBody = mWorld->createRigidBody(Transform::identity());
+            mConcaveMeshBody->setType(BodyType::STATIC);
+            mConcaveMeshBody->addCollider(mConcaveMeshShape, Transform::identity());
+            mHeightFieldBody = mWorld->createRigidBody(Transform::identity());
+            mHeightFieldBody->setType(BodyType::STATIC);
+            mHeightFieldBody->addCollider(mHeightFieldShape, Transform::identity());
+            mConvexBody = mWorld->createRigidBody(Transform::identity());
+        }
+
+        /// Destructor
+        virtual ~TestConvexVsConcave() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+            mPhysicsCommon.destroyConcaveMeshShape(mConcaveMeshShape);
+            mPhysicsCommon.destroyHeightFieldShape(mHeightFieldShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+            mPhysicsCommon.destroyCapsuleShape(mCapsuleShape);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroyTriangleMesh(mTriangleMesh);
+            mPhysicsCommon.destroyHeightField(mHeightField);
+        }
+
+        /// Run the tests
+        void run() {
+            testPenetrationDepths();
+            testRestingBodies();
+        }
+
+        /// Compare the penetration depths of convex shapes in random poses against the flat concave shapes with the exact ones
+        void testPenetrationDepths() {
+
+            CollisionShape* convexShapes[3] = {mSphereShape, mCapsuleShape, mBoxShape};
+            RigidBody* concaveBodies[2] = {mConcaveMeshBody, mHeightFieldBody};
+
+            ConcaveContactsCallback callback;
+            ConcaveContactsCallback concurrentCallback;
+
+            for (int s=0; s < 3; s++) {
+
+                Collider* convexCollider = mConvexBody->addCollider(convexShapes[s], Transform::identity());
+
+                for (int b=0; b < 2; b++) {
+
+                    // Only the tested concave body is enabled
+                    concaveBodies[b]->setIsActive(true);
+                    concaveBodies[1 - b]->setIsActive(false);
+
+                    for (int i=0; i < NB_POSES; i++) {
+
+                        // Choose a random pose with a penetration depth in [-0.1, 0.1]
+                        Transform transform(Vector3(random(-3, 3), 0, random(-3, 3)), randomQuaternion());
+                        const decimal penetrationDepth = random(decimal(-0.1), decimal(0.1));
+                        transform.setPosition(transform.getPosition() - Vector3(0, computeLowestHeight(convexShapes[s], transform) + penetrationDepth, 0));
+                        mConvexBody->setTransform(transform);
+
+                        callback.reset();
+                        mWorld->testCollision(mConvexBody, concaveBodies[b], callback);
+
+                        // The pairs that are almost touching are not tested
+                        if (penetrationDepth > decimal(0.01)) {
+                            rp3d_test(callback.isColliding);
+                            rp3d_test(mWorld->testOverlap(mConvexBody, concaveBodies[b]));
+                            rp3d_test(callback.maxPenetrationDepth < penetrationDepth + decimal(0.01));
+
+                            // The SAT algorithm can separate a polyhedron from a single triangle along one of the triangle
+                            // edges with a smaller depth. Therefore, only the depths of the spheres are exact.
+                            if (convexShapes[s] == mSphereShape) {
+                                rp3d_test(std::abs(callback.maxPenetrationDepth - penetrationDepth) < decimal(0.01));
+                            }
+                            rp3d_test(std::abs(callback.normal.y) > decimal(0.99));
+                        }
+                        else if (penetrationDepth < decimal(-0.01)) {
+                            rp3d_test(!callback.isColliding);
+                            rp3d_test(!mWorld->testOverlap(mConvexBody, concaveBodies[b]));
+                        }
+
+                        // The same query in the concurrent queries mode must report the same contacts
+                        concurrentCallback.reset();
+                        mWorld->beginConcurrentQueries();
+                        mWorld->testCollision(mConvexBody, concaveBodies[b], concurrentCallback);
+                        mWorld->endConcurrentQueries();
+                        rp3d_test(concurrentCallback.isColliding == callback.isColliding);
+                        rp3d_test(concurrentCallback.nbContactPoints == callback.nbContactPoints);
+                        rp3d_test(std::abs(concurrentCallback.maxPenetrationDepth - callback.maxPenetrationDepth) < decimal(0.0001));
+                    }
+                }
+
+                mConvexBody->removeCollider(convexCollider);
+            }
+
+            mConcaveMeshBody->setIsActive(true);
+            mHeightFieldBody->setIsActive(true);
+        }
+
+        /// Make sure that bodies dropped on the concave shapes come to rest on their surface
+        void testRestingBodies() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            RigidBody* concaveMeshBody = world->createRigidBody(Transform(Vector3(-6, 0, 0), Quaternion::identity()));
+            concaveMeshBody->setType(BodyType::STATIC);
+            concaveMeshBody->addCollider(mConcaveMeshShape, Transform::identity());
+            RigidBody* heightFieldBody = world->createRigidBody(Transform(Vector3(6, 0, 0), Quaternion::identity()));
+            heightFieldBody->setType(BodyType::STATIC);
+            heightFieldBody->addCollider(mHeightFieldShape, Transform::identity());
+
+            // Drop a sphere, a capsule and a box on each concave shape
+            CollisionShape* convexShapes[3] = {mSphereShape, mCapsuleShape, mBoxShape};
+            const decimal restingHeights[3] = {mSphereShape->getRadius(), mCapsuleShape->getRadius(), mBoxShape->getHalfExtents().y};
+            const Quaternion orientations[3] = {Quaternion::identity(), Quaternion::fromEulerAngles(0, 0, PI_RP3D * decimal(0.5)),
+                                                Quaternion::identity()};
+            RigidBody* bodies[6];
+            for (int b=0; b < 6; b++) {
+                const decimal x = (b < 3 ? decimal(-6) : decimal(6)) + decimal(b % 3 - 1) * decimal(2.5);
+                bodies[b] = world->createRigidBody(Transform(Vector3(x, restingHeights[b % 3] + decimal(0.5), decimal(0.3)), orientations[b % 3]));
+                bodies[b]->addCollider(convexShapes[b % 3], Transform::identity());
+            }
+
+            for (int i=0; i < 300; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+
+            for (int b=0; b < 6; b++) {
+                const Vector3& position = bodies[b]->getTransform().getPosition();
+                rp3d_test(std::abs(position.y - restingHeights[b % 3]) < decimal(0.02));
+                rp3d_test(bodies[b]->getLinearVelocity().length() < decimal(0.05));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,322 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_EPA_H
+#define TEST_EPA_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <map>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Collision callback that keeps the deepest contact point of a single pair of colliders
+class EPAContactsCallback : public CollisionCallback {
+
+    public:
+
+        bool isColliding = false;
+        decimal maxPenetrationDepth = 0;
+        Vector3 normal;
+        bool areContactPointsValid = true;
+
+        void reset() {
+            isColliding = false;
+            maxPenetrationDepth = 0;
+            areContactPointsValid = true;
+        }
+
+        virtual void onContact(const CallbackData& callbackData) override {
+
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+
+                const ContactPair contactPair = callbackData.getContactPair(p);
+                const Transform& transform1 = contactPair.getCollider1()->getLocalToWorldTransform();
+                const Transform& transform2 = contactPair.getCollider2()->getLocalToWorldTransform();
+
+                for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+
+                    const ContactPoint contactPoint = contactPair.getContactPoint(c);
+                    isColliding = true;
+
+                    // The distance between the two points along the normal must be the penetration depth
+                    const Vector3 point1 = transform1 * contactPoint.getLocalPointOnCollider1();
+                    const Vector3 point2 = transform2 * contactPoint.getLocalPointOnCollider2();
+                    if (std::abs((point1 - point2).dot(contactPoint.getWorldNormal()) - contactPoint.getPenetrationDepth()) > decimal(0.01)) {
+                        areContactPointsValid = false;
+                    }
+
+                    if (contactPoint.getPenetrationDepth() > maxPenetrationDepth) {
+                        maxPenetrationDepth = contactPoint.getPenetrationDepth();
+                        normal = contactPoint.getWorldNormal();
+                    }
+                }
+            }
+        }
+};
+
+// Class TestEPA
+/**
+ * Unit test for the GJK and EPA algorithms used between convex polyhedra with many edges.
+ * We use a cube with subdivided faces as convex mesh (with enough edges to select the GJK
+ * and EPA algorithms) and compare the results with the box vs box algorithm on the same boxes.
+ * Because the faces of the mesh are subdivided, the contact points can be different from the
+ * ones of the box vs box algorithm and we only compare the penetration depths along the normals.
+ */
+class TestEPA : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of random pairs of boxes
+        static const int NB_PAIRS = 500;
+
+        /// Number of subdivisions of each side of a face of the cube
+        static const int NB_SUBDIVISIONS = 4;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// World with the box shapes (box vs box algorithm)
+        PhysicsWorld* mBoxWorld;
+
+        /// World with the convex mesh shapes (GJK and EPA algorithms)
+        PhysicsWorld* mMeshWorld;
+
+        /// Convex mesh of a cube with subdivided faces and half-extents of one
+        ConvexMesh* mCubeMesh;
+
+        RigidBody* mBoxBody1;
+        RigidBody* mBoxBody2;
+        RigidBody* mMeshBody1;
+        RigidBody* mMeshBody2;
+
+        std::vector<float> mVertices;
+        std::vector<uint32> mIndices;
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1u << 24);
+        }
+
+        /// Return a random unit quaternion
+        Quaternion randomQuaternion() {
+            Quaternion quaternion(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+            quaternion.normalize();
+            return quaternion;
+        }
+
+        /// Return the overlap of the projections of two boxes on an axis
+        decimal computeOverlapOnAxis(const Vector3& halfExtents1, const Transform& transform1,
+                                     const Vector3& halfExtents2, const Transform& transform2, const Vector3& axis) {
+
+            const Matrix3x3 rotation1 = transform1.getOrientation().getMatrix();
+            const Matrix3x3 rotation2 = transform2.getOrientation().getMatrix();
+            decimal radius1 = 0;
+            decimal radius2 = 0;
+            for (int c=0; c < 3; c++) {
+                radius1 += halfExtents1[c] * std::abs(rotation1.getColumn(c).dot(axis));
+                radius2 += halfExtents2[c] * std::abs(rotation2.getColumn(c).dot(axis));
+            }
+
+            return radius1 + radius2 - std::abs((transform2.getPosition() - transform1.getPosition()).dot(axis));
+        }
+
+        /// Return the index of a vertex of the subdivided cube (created if necessary)
+        uint32 getVertexIndex(std::map<std::vector<int>, uint32>& mapGridToIndex, const std::vector<int>& gridCoordinates) {
+
+            auto it = mapGridToIndex.find(gridCoordinates);
+            if (it != mapGridToIndex.end()) {
+                return it->second;
+            }
+
+            const uint32 index = uint32(mVertices.size() / 3);
+            for (int c=0; c < 3; c++) {
+                mVertices.push_back(-1.0f + 2.0f * float(gridCoordinates[c]) / float(NB_SUBDIVISIONS));
+            }
+            mapGridToIndex[gridCoordinates] = index;
+
+            return index;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestEPA(const std::string& name) : Test(name), mRandomState(54321) {
+
+            mBoxWorld = mPhysicsCommon.createPhysicsWorld();
+            mMeshWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Cube with each face subdivided in a grid of quads
+            std::map<std::vector<int>, uint32> mapGridToIndex;
+            for (int axis=0; axis < 3; axis++) {
+                const int axisU = (axis + 1) % 3;
+                const int axisV = (axis + 2) % 3;
+                for (int side=0; side < 2; side++) {
+                    for (int i=0; i < NB_SUBDIVISIONS; i++) {
+                        for (int j=0; j < NB_SUBDIVISIONS; j++) {
+
+                            uint32 quad[4];
+                            const int cornersU[4] = {i, i + 1, i + 1, i};
+                            const int cornersV[4] = {j, j, j + 1, j + 1};
+                            for (int k=0; k < 4; k++) {
+                                std::vector<int> gridCoordinates(3);
+                                gridCoordinates[axis] = side * NB_SUBDIVISIONS;
+                                gridCoordinates[axisU] = cornersU[k];
+                                gridCoordinates[axisV] = cornersV[k];
+                                quad[k] = getVertexIndex(mapGridToIndex, gridCoordinates);
+                            }
+
+                            // The vertices of a face are in counter-clockwise order seen from outside
+                            for (int k=0; k < 4; k++) {
+                                mIndices.push_back(side == 1 ? quad[k] : quad[3 - k]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            const uint32 nbFaces = uint32(mIndices.size() / 4);
+            std::vector<PolygonVertexArray::PolygonFace> faces(nbFaces);
+            for (uint32 f = 0; f < nbFaces; f++) {
+                faces[f].indexBase = f * 4;
+                faces[f].nbVertices = 4;
+            }
+            PolygonVertexArray polygonVertexArray(uint32(mVertices.size() / 3), mVertices.data(), 3 * sizeof(float),
+                    mIndices.data(), sizeof(uint32), nbFaces, faces.data(),
+                    rp3d::PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<Message> messages;
+            mCubeMesh = mPhysicsCommon.createConvexMesh(polygonVertexArray, messages);
+
+            mBoxBody1 = mBoxWorld->createRigidBody(Transform::identity());
+            mBoxBody2 = mBoxWorld->createRigidBody(Transform::identity());
+            mMeshBody1 = mMeshWorld->createRigidBody(Transform::identity());
+            mMeshBody2 = mMeshWorld->createRigidBody(Transform::identity());
+        }
+
+        /// Destructor
+        virtual ~TestEPA() {
+            mPhysicsCommon.destroyPhysicsWorld(mBoxWorld);
+            mPhysicsCommon.destroyPhysicsWorld(mMeshWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testCubeMesh();
+            testCompareWithBoxVsBox();
+        }
+
+        /// Test that the subdivided cube mesh is valid
+        void testCubeMesh() {
+
+            rp3d_test(mCubeMesh != nullptr);
+            rp3d_test(mCubeMesh->getNbFaces() == 6 * NB_SUBDIVISIONS * NB_SUBDIVISIONS);
+            rp3d_test(mCubeMesh->getNbVertices() == 6 * NB_SUBDIVISIONS * NB_SUBDIVISIONS + 2);
+        }
+
+        /// Compare the GJK and EPA algorithms with the box vs box algorithm on random pairs of boxes
+        void testCompareWithBoxVsBox() {
+
+            EPAContactsCallback boxCallback;
+            EPAContactsCallback meshCallback;
+
+            for (int i=0; i < NB_PAIRS; i++) {
+
+                const Vector3 halfExtents1(random(0.2, 2), random(0.2, 2), random(0.2, 2));
+                const Vector3 halfExtents2(random(0.2, 2), random(0.2, 2), random(0.2, 2));
+                const Transform transform1(Vector3(random(-0.5, 0.5), random(-0.5, 0.5), random(-0.5, 0.5)), randomQuaternion());
+
+                // Some pairs have the same orientation (parallel edges and coplanar faces)
+                const Quaternion orientation2 = i % 4 == 0 ? transform1.getOrientation() : randomQuaternion();
+                const Transform transform2(Vector3(random(-3, 3), random(-3, 3), random(-3, 3)), orientation2);
+
+                BoxShape* boxShape1 = mPhysicsCommon.createBoxShape(halfExtents1);
+                BoxShape* boxShape2 = mPhysicsCommon.createBoxShape(halfExtents2);
+                ConvexMeshShape* meshShape1 = mPhysicsCommon.createConvexMeshShape(mCubeMesh, halfExtents1);
+                ConvexMeshShape* meshShape2 = mPhysicsCommon.createConvexMeshShape(mCubeMesh, halfExtents2);
+
+                mBoxBody1->setTransform(transform1);
+                mBoxBody2->setTransform(transform2);
+                mMeshBody1->setTransform(transform1);
+                mMeshBody2->setTransform(transform2);
+                Collider* boxCollider1 = mBoxBody1->addCollider(boxShape1, Transform::identity());
+                Collider* boxCollider2 = mBoxBody2->addCollider(boxShape2, Transform::identity());
+                Collider* meshCollider1 = mMeshBody1->addCollider(meshShape1, Transform::identity());
+                Collider* meshCollider2 = mMeshBody2->addCollider(meshShape2, Transform::identity());
+
+                boxCallback.reset();
+                meshCallback.reset();
+                mBoxWorld->testCollision(mBoxBody1, mBoxBody2, boxCallback);
+                mMeshWorld->testCollision(mMeshBody1, mMeshBody2, meshCallback);
+
+                rp3d_test(meshCallback.areContactPointsValid);
+
+                // The pairs that are almost touching can be classified differently by the two algorithms
+                if (boxCallback.maxPenetrationDepth > decimal(0.001) || meshCallback.maxPenetrationDepth > decimal(0.001)) {
+
+                    rp3d_test(boxCallback.isColliding == meshCallback.isColliding);
+                    rp3d_test(mBoxWorld->testOverlap(mBoxBody1, mBoxBody2) == mMeshWorld->testOverlap(mMeshBody1, mMeshBody2));
+                    rp3d_test(meshCallback.maxPenetrationDepth < boxCallback.maxPenetrationDepth + decimal(0.01));
+
+                    // The normal must be an axis of minimum penetration depth of the two boxes
+                    if (boxCallback.isColliding && meshCallback.isColliding) {
+                        const decimal boxDepth = computeOverlapOnAxis(halfExtents1, transform1, halfExtents2, transform2, boxCallback.normal);
+                        const decimal meshDepth = computeOverlapOnAxis(halfExtents1, transform1, halfExtents2, transform2, meshCallback.normal);
+                        rp3d_test(std::abs(meshDepth - boxDepth) < decimal(0.01));
+                    }
+                }
+                else if (!boxCallback.isColliding && !meshCallback.isColliding) {
+                    rp3d_test(!mMeshWorld->testOverlap(mMeshBody1, mMeshBody2));
+                }
+
+                mBoxBody1->removeCollider(boxCollider1);
+                mBoxBody2->removeCollider(boxCollider2);
+                mMeshBody1->removeCollider(meshCollider1);
+                mMeshBody2->removeCollider(meshCollider2);
+                mPhysicsCommon.destroyBoxShape(boxShape1);
+                mPhysicsCommon.destroyBoxShape(boxShape2);
+                mPhysicsCommon.destroyConvexMeshShape(meshShape1);
+                mPhysicsCommon.destroyConvexMeshShape(meshShape2);
+            }
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,305 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_PARALLEL_COLLISION_DETECTION_H
+#define TEST_PARALLEL_COLLISION_DETECTION_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+#include <set>
+#include <cmath>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Contact pair reported by the physics world
+struct ContactPairRecord {
+
+    uint32 body1Id;
+    uint32 body2Id;
+    CollisionShapeName shape1Name;
+    CollisionShapeName shape2Name;
+    CollisionCallback::ContactPair::EventType eventType;
+    std::vector<Vector3> normals;
+    std::vector<Vector3> localPoints1;
+    std::vector<Vector3> localPoints2;
+    std::vector<decimal> penetrationDepths;
+
+    bool operator==(const ContactPairRecord& record) const {
+        return body1Id == record.body1Id && body2Id == record.body2Id && eventType == record.eventType &&
+               normals == record.normals && localPoints1 == record.localPoints1 && localPoints2 == record.localPoints2 &&
+               penetrationDepths == record.penetrationDepths;
+    }
+};
+
+// Event listener that records all the contact pairs reported by the physics world (in the reported order)
+class ContactPairsRecorder : public EventListener {
+
+    public:
+
+        std::vector<ContactPairRecord> contactPairs;
+
+        virtual void onContact(const CollisionCallback::CallbackData& callbackData) override {
+
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+
+                const CollisionCallback::ContactPair contactPair = callbackData.getContactPair(p);
+
+                ContactPairRecord record;
+                record.body1Id = contactPair.getBody1()->getEntity().id;
+                record.body2Id = contactPair.getBody2()->getEntity().id;
+                record.shape1Name = contactPair.getCollider1()->getCollisionShape()->getName();
+                record.shape2Name = contactPair.getCollider2()->getCollisionShape()->getName();
+                record.eventType = contactPair.getEventType();
+                for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+                    const CollisionCallback::ContactPoint contactPoint = contactPair.getContactPoint(c);
+                    record.normals.push_back(contactPoint.getWorldNormal());
+                    record.localPoints1.push_back(contactPoint.getLocalPointOnCollider1());
+                    record.localPoints2.push_back(contactPoint.getLocalPointOnCollider2());
+                    record.penetrationDepths.push_back(contactPoint.getPenetrationDepth());
+                }
+
+                contactPairs.push_back(record);
+            }
+        }
+};
+
+// Class TestParallelCollisionDetection
+/**
+ * Unit test for the parallel stages of the collision detection. The chunks of the stages are
+ * executed in a shuffled order on several simulated workers and the contact pairs reported by
+ * the world must be the same (and in the same order) as with the chunks executed in order.
+ */
+class TestParallelCollisionDetection : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of simulation steps
+        static const uint32 NB_STEPS = 60;
+
+        /// Number of bodies that fall on the terrain
+        static const uint32 NB_TERRAIN_BODIES = 300;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        SphereShape* mSphereShape;
+
+        CapsuleShape* mCapsuleShape;
+
+        BoxShape* mBoxShape;
+
+        BoxShape* mFloorShape;
+
+        HeightField* mHeightField;
+
+        HeightFieldShape* mTerrainShape;
+
+        float mHeightData[40 * 40];
+
+        // ---------- Methods ---------- //
+
+        /// Create a layer of spheres, capsules and boxes on a floor (to fill all the narrow-phase batches)
+        void createShapesLayer(PhysicsWorld* world) {
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mFloorShape, Transform::identity());
+
+            // Each shape touches the same shape and the two other shapes
+            CollisionShape* shapes[3] = {mSphereShape, mCapsuleShape, mBoxShape};
+            for (uint32 i=0; i < 36; i++) {
+                const Vector3 position(decimal(i % 6) * decimal(1.02), decimal(0.5), decimal(i / 6) * decimal(1.02));
+                const Quaternion orientation = Quaternion::fromEulerAngles(0, decimal(0.2) * (i % 3), decimal(1.5707963));
+                RigidBody* body = world->createRigidBody(Transform(position, orientation));
+                body->addCollider(shapes[((i % 6) / 2 + i / 6) % 3], Transform::identity());
+            }
+        }
+
+        /// Create bodies just above a bumpy terrain (convex vs concave pairs) and touching each other (convex vs convex pairs)
+        void createTerrainScene(PhysicsWorld* world) {
+
+            RigidBody* terrain = world->createRigidBody(Transform::identity());
+            terrain->setType(BodyType::STATIC);
+            terrain->addCollider(mTerrainShape, Transform::identity());
+
+            CollisionShape* shapes[3] = {mSphereShape, mCapsuleShape, mBoxShape};
+            for (uint32 i=0; i < NB_TERRAIN_BODIES; i++) {
+                const Vector3 position(decimal(i % 20) * decimal(1.02) - decimal(10.0), decimal(1.2), decimal(i / 20) * decimal(1.02) - decimal(7.5));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(decimal(0.3) * (i % 5), 0, 0)));
+                body->addCollider(shapes[i % 3], Transform::identity());
+            }
+        }
+
+        /// Simulate a scene with a given task scheduler and return the reported contact pairs
+        std::vector<ContactPairRecord> simulate(void (TestParallelCollisionDetection::*createScene)(PhysicsWorld*), TaskScheduler* taskScheduler) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = taskScheduler;
+            settings.isParallelIslandSolverEnabled = false;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            ContactPairsRecorder recorder;
+            world->setEventListener(&recorder);
+
+            (this->*createScene)(world);
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            return recorder.contactPairs;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestParallelCollisionDetection(const std::string& name) : Test(name) {
+
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mCapsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.45), decimal(0.5));
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            mFloorShape = mPhysicsCommon.createBoxShape(Vector3(50, 0.5, 50));
+
+            for (int i=0; i < 40; i++) {
+                for (int j=0; j < 40; j++) {
+                    mHeightData[i * 40 + j] = float(std::sin(i * 0.5) * std::cos(j * 0.4));
+                }
+            }
+            std::vector<Message> messages;
+            mHeightField = mPhysicsCommon.createHeightField(40, 40, mHeightData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            rp3d_test(mHeightField != nullptr);
+            mTerrainShape = mPhysicsCommon.createHeightFieldShape(mHeightField);
+        }
+
+        /// Run the tests
+        void run() {
+
+            testParallelNarrowPhase();
+            testParallelMiddlePhase();
+        }
+
+        void testParallelNarrowPhase() {
+
+            DefaultTaskScheduler* scheduler1 = mPhysicsCommon.createDefaultTaskScheduler(1);
+            ShuffledTaskScheduler shuffledScheduler(4);
+
+            const std::vector<ContactPairRecord> contactPairs = simulate(&TestParallelCollisionDetection::createShapesLayer, scheduler1);
+            const std::vector<ContactPairRecord> shuffledContactPairs = simulate(&TestParallelCollisionDetection::createShapesLayer, &shuffledScheduler);
+
+            // There are too few overlapping pairs to split the middle-phase and the islands are solved in a single
+            // task. Therefore, the only parallel-for split into chunks of one item are the narrow-phase tests
+            rp3d_test(shuffledScheduler.getNbParallelFors(1, 2) == NB_STEPS);
+
+            // The narrow-phase chunks tested in a shuffled order give the same contacts in the same order
+            rp3d_test(contactPairs.size() > 0);
+            rp3d_test(contactPairs == shuffledContactPairs);
+
+            // All the narrow-phase batches have produced valid contacts
+            bool isShapePairFound[3][3] = {{false, false, false}, {false, false, false}, {false, false, false}};
+            const CollisionShapeName shapeNames[3] = {CollisionShapeName::SPHERE, CollisionShapeName::CAPSULE, CollisionShapeName::BOX};
+            bool isValid = true;
+            for (const ContactPairRecord& record : contactPairs) {
+
+                if (record.eventType == CollisionCallback::ContactPair::EventType::ContactExit) continue;
+
+                isValid &= record.normals.size() > 0 && record.normals.size() <= 4;
+                for (size_t c=0; c < record.normals.size(); c++) {
+                    isValid &= approxEqual(record.normals[c].length(), decimal(1.0), decimal(0.001));
+                    isValid &= record.penetrationDepths[c] >= decimal(0.0) && record.penetrationDepths[c] < decimal(0.5);
+                }
+
+                for (uint32 s1=0; s1 < 3; s1++) {
+                    for (uint32 s2=0; s2 < 3; s2++) {
+                        isShapePairFound[s1][s2] |= record.shape1Name == shapeNames[s1] && record.shape2Name == shapeNames[s2];
+                    }
+                }
+            }
+            rp3d_test(isValid);
+            for (uint32 s1=0; s1 < 3; s1++) {
+                for (uint32 s2=s1; s2 < 3; s2++) {
+                    rp3d_test(isShapePairFound[s1][s2] || isShapePairFound[s2][s1]);
+                }
+            }
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler1);
+        }
+
+        void testParallelMiddlePhase() {
+
+            DefaultTaskScheduler* scheduler1 = mPhysicsCommon.createDefaultTaskScheduler(1);
+            ShuffledTaskScheduler shuffledScheduler(4);
+
+            const std::vector<ContactPairRecord> contactPairs = simulate(&TestParallelCollisionDetection::createTerrainScene, scheduler1);
+            const std::vector<ContactPairRecord> shuffledContactPairs = simulate(&TestParallelCollisionDetection::createTerrainScene, &shuffledScheduler);
+
+            // The islands are solved in a single task. Therefore, the only parallel-for split into chunks
+            // of one item are the middle-phase and the narrow-phase (two at each step)
+            rp3d_test(shuffledScheduler.getNbParallelFors(1, 2) == 2 * NB_STEPS);
+
+            // The narrow-phase inputs of the middle-phase chunks created in a shuffled order are merged in the
+            // order of the chunks. Therefore, the contact pairs are the same and are reported in the same order
+            rp3d_test(contactPairs.size() > 0);
+            rp3d_test(contactPairs == shuffledContactPairs);
+
+            // The middle-phase has found the triangles of the terrain below the bodies (most of them have
+            // touched the terrain) and the contact points on the terrain are inside its bounds
+            AABB terrainBounds = mTerrainShape->getLocalBounds();
+            terrainBounds.inflate(decimal(0.01), decimal(0.01), decimal(0.01));
+            std::set<uint32> bodiesOnTerrain;
+            bool isInsideTerrainBounds = true;
+            for (const ContactPairRecord& record : contactPairs) {
+
+                const bool isTerrainBody1 = record.shape1Name == CollisionShapeName::HEIGHTFIELD;
+                if (!isTerrainBody1 && record.shape2Name != CollisionShapeName::HEIGHTFIELD) continue;
+
+                bodiesOnTerrain.insert(isTerrainBody1 ? record.body2Id : record.body1Id);
+
+                const std::vector<Vector3>& terrainPoints = isTerrainBody1 ? record.localPoints1 : record.localPoints2;
+                for (const Vector3& point : terrainPoints) {
+                    isInsideTerrainBounds &= terrainBounds.contains(point);
+                }
+            }
+            rp3d_test(bodiesOnTerrain.size() > NB_TERRAIN_BODIES * 9 / 10);
+            rp3d_test(isInsideTerrainBounds);
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler1);
+        }
+ };
+
+}
+
+#endif
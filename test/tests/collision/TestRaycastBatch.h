@@ -0,0 +1,296 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_RAYCAST_BATCH_H
+#define TEST_RAYCAST_BATCH_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+#include <cmath>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class ClosestHitRaycastCallback
+/**
+ * Raycast callback that keeps the closest hit of a single ray
+ */
+class ClosestHitRaycastCallback : public RaycastCallback {
+
+    public:
+
+        Collider* closestCollider = nullptr;
+
+        decimal closestHitFraction = decimal(1.0);
+
+        Vector3 closestWorldPoint;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            if (info.hitFraction < closestHitFraction) {
+                closestHitFraction = info.hitFraction;
+                closestCollider = info.collider;
+                closestWorldPoint = info.worldPoint;
+            }
+            return info.hitFraction;
+        }
+};
+
+// Class TestRaycastBatch
+/**
+ * Unit test for the batched raycasts. The hits of a batch must be the same as the
+ * closest hits of the rays tested one by one.
+ */
+class TestRaycastBatch : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        DefaultTaskScheduler* mTaskScheduler;
+
+        PhysicsWorld* mWorld;
+
+        std::vector<Vector3> mConcaveMeshVertices;
+        std::vector<uint> mConcaveMeshIndices;
+        float mHeightFieldData[400];
+
+        std::vector<Ray> mRays;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestRaycastBatch(const std::string& name) : Test(name) {
+
+            mTaskScheduler = mPhysicsCommon.createDefaultTaskScheduler(4);
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = mTaskScheduler;
+            mWorld = mPhysicsCommon.createPhysicsWorld(settings);
+
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(1, 2, decimal(0.5)));
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.8));
+            CapsuleShape* capsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.5), decimal(1.5));
+
+            // Grid of convex bodies
+            for (int x=0; x < 6; x++) {
+                for (int z=0; z < 6; z++) {
+
+                    const Transform transform(Vector3(x * decimal(4.5) - 12, decimal(1.0) + (x + z) % 3, z * decimal(4.5) - 12),
+                                              Quaternion::fromEulerAngles(decimal(0.3) * x, decimal(0.2) * z, 0));
+                    Body* body = mWorld->createRigidBody(transform);
+                    CollisionShape* shape = (x + z) % 3 == 0 ? static_cast<CollisionShape*>(sphereShape) :
+                                            ((x + z) % 3 == 1 ? static_cast<CollisionShape*>(boxShape) : capsuleShape);
+                    Collider* collider = body->addCollider(shape, Transform::identity());
+                    collider->setIsSimulationCollider(false);
+
+                    if ((x * 6 + z) % 2 == 0) {
+                        collider->setCollisionCategoryBits(0x0001);
+                    }
+                    else {
+                        collider->setCollisionCategoryBits(0x0002);
+                    }
+                }
+            }
+
+            // Concave mesh (scaled box with the faces inwards and outwards)
+            mConcaveMeshVertices.push_back(Vector3(-2, -3, -4));
+            mConcaveMeshVertices.push_back(Vector3(2, -3, -4));
+            mConcaveMeshVertices.push_back(Vector3(2, -3, 4));
+            mConcaveMeshVertices.push_back(Vector3(-2, -3, 4));
+            mConcaveMeshVertices.push_back(Vector3(-2, 3, -4));
+            mConcaveMeshVertices.push_back(Vector3(2, 3, -4));
+            mConcaveMeshVertices.push_back(Vector3(2, 3, 4));
+            mConcaveMeshVertices.push_back(Vector3(-2, 3, 4));
+            const uint indices[36] = {0, 1, 2,  0, 2, 3,  1, 5, 2,  2, 5, 6,  2, 7, 3,  2, 6, 7,
+                                      0, 3, 4,  3, 7, 4,  0, 4, 1,  1, 4, 5,  5, 7, 6,  4, 7, 5};
+            mConcaveMeshIndices.assign(indices, indices + 36);
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ? TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE :
+                                                                                    TriangleVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray concaveMeshVertexArray(8, &(mConcaveMeshVertices[0]), sizeof(Vector3),
+                                                       12, &(mConcaveMeshIndices[0]), 3 * sizeof(uint),
+                                                       vertexType, TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<Message> messages;
+            TriangleMesh* triangleMesh = mPhysicsCommon.createTriangleMesh(concaveMeshVertexArray, messages);
+            rp3d_test(triangleMesh != nullptr);
+            ConcaveMeshShape* concaveMeshShape = mPhysicsCommon.createConcaveMeshShape(triangleMesh, Vector3(decimal(1.5), 1, decimal(0.5)));
+            Body* concaveMeshBody = mWorld->createRigidBody(Transform(Vector3(18, 4, 2), Quaternion::fromEulerAngles(0, decimal(0.4), decimal(0.1))));
+            concaveMeshBody->addCollider(concaveMeshShape, Transform::identity())->setIsSimulationCollider(false);
+
+            // Height field with some bumps
+            for (int i=0; i < 20; i++) {
+                for (int j=0; j < 20; j++) {
+                    mHeightFieldData[i * 20 + j] = std::sin(float(i) * 0.7f) + std::cos(float(j) * 0.4f);
+                }
+            }
+            messages.clear();
+            HeightField* heightField = mPhysicsCommon.createHeightField(20, 20, mHeightFieldData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            rp3d_test(heightField != nullptr);
+            HeightFieldShape* heightFieldShape = mPhysicsCommon.createHeightFieldShape(heightField);
+            Body* heightFieldBody = mWorld->createRigidBody(Transform(Vector3(0, -2, 0), Quaternion::identity()));
+            heightFieldBody->addCollider(heightFieldShape, Transform::identity())->setIsSimulationCollider(false);
+
+            // Lidar-like fans of rays from some points
+            const Vector3 origins[4] = {Vector3(0, 8, 0), Vector3(-14, 3, -14), Vector3(15, 5, 10), Vector3(30, 4, 2)};
+            for (int o=0; o < 4; o++) {
+                for (int i=0; i < 16; i++) {
+                    for (int j=0; j < 37; j++) {
+                        const decimal pitch = decimal(-1.3) + decimal(i) * decimal(0.12);
+                        const decimal yaw = decimal(j) * decimal(2.0) * PI_RP3D / decimal(37.0);
+                        const Vector3 direction(std::cos(pitch) * std::cos(yaw), std::sin(pitch), std::cos(pitch) * std::sin(yaw));
+                        mRays.push_back(Ray(origins[o], origins[o] + decimal(40.0) * direction));
+                    }
+                }
+            }
+
+            // Axis-aligned rays (zero components in the directions)
+            for (int i=0; i < 13; i++) {
+                const Vector3 point(decimal(i) * decimal(3.1) - 18, 20, decimal(i) * decimal(1.7) - 10);
+                mRays.push_back(Ray(point, point - Vector3(0, 40, 0)));
+                mRays.push_back(Ray(point - Vector3(30, 18, 0), point + Vector3(30, -18, 0)));
+            }
+
+            // Ray with a maximum fraction
+            mRays.push_back(Ray(Vector3(0, 8, 0), Vector3(0, -32, 0), decimal(0.1)));
+        }
+
+        /// Destructor
+        virtual ~TestRaycastBatch() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+            mPhysicsCommon.destroyDefaultTaskScheduler(mTaskScheduler);
+        }
+
+        /// Run the tests
+        void run() {
+
+            testClosestHits();
+            testFirstHits();
+            testCategoryMask();
+            testEmptyBatch();
+        }
+
+        /// Return true if the hits of a batch are the closest hits of the rays
+        bool areClosestHits(const std::vector<RaycastHit>& hits, unsigned short categoryMaskBits) {
+
+            if (hits.size() != mRays.size()) return false;
+
+            const decimal epsilon = decimal(0.0001);
+            for (size_t i=0; i < mRays.size(); i++) {
+
+                ClosestHitRaycastCallback callback;
+                mWorld->raycast(mRays[i], &callback, categoryMaskBits);
+
+                if (hits[i].isHit() != (callback.closestCollider != nullptr)) return false;
+                if (!hits[i].isHit()) continue;
+
+                if (hits[i].collider != callback.closestCollider ||
+                    hits[i].body != callback.closestCollider->getBody() ||
+                    !approxEqual(hits[i].hitFraction, callback.closestHitFraction, epsilon) ||
+                    !Vector3::approxEqual(hits[i].worldPoint, callback.closestWorldPoint, decimal(0.001))) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void testClosestHits() {
+
+            std::vector<RaycastHit> hits;
+
+            mWorld->raycastBatch(mRays, hits);
+            rp3d_test(areClosestHits(hits, 0xFFFF));
+
+            std::vector<RaycastHit> parallelHits;
+            mWorld->raycastBatch(mRays, parallelHits, RaycastBatchMode::CLOSEST_HIT, 0xFFFF, true);
+            rp3d_test(areClosestHits(parallelHits, 0xFFFF));
+
+            // Some of the rays must hit and some of them must miss
+            uint32 nbHits = 0;
+            for (size_t i=0; i < hits.size(); i++) {
+                if (hits[i].isHit()) nbHits++;
+            }
+            rp3d_test(nbHits > 0);
+            rp3d_test(nbHits < hits.size());
+
+            // The ray with the small maximum fraction does not reach the height field
+            rp3d_test(!hits[hits.size() - 1].isHit());
+        }
+
+        void testFirstHits() {
+
+            std::vector<RaycastHit> hits;
+            mWorld->raycastBatch(mRays, hits, RaycastBatchMode::FIRST_HIT, 0xFFFF, true);
+            rp3d_test(hits.size() == mRays.size());
+
+            for (size_t i=0; i < mRays.size(); i++) {
+
+                ClosestHitRaycastCallback callback;
+                mWorld->raycast(mRays[i], &callback);
+
+                rp3d_test(hits[i].isHit() == (callback.closestCollider != nullptr));
+
+                if (hits[i].isHit()) {
+
+                    // The reported hit must be on the ray and not closer than the closest hit
+                    rp3d_test(hits[i].collider != nullptr);
+                    rp3d_test(hits[i].hitFraction <= mRays[i].maxFraction);
+                    rp3d_test(hits[i].hitFraction >= callback.closestHitFraction - decimal(0.0001));
+                    const Vector3 pointOnRay = mRays[i].point1 + hits[i].hitFraction * (mRays[i].point2 - mRays[i].point1);
+                    rp3d_test(Vector3::approxEqual(pointOnRay, hits[i].worldPoint, decimal(0.001)));
+                }
+            }
+        }
+
+        void testCategoryMask() {
+
+            std::vector<RaycastHit> hits;
+            mWorld->raycastBatch(mRays, hits, RaycastBatchMode::CLOSEST_HIT, 0x0001);
+            rp3d_test(areClosestHits(hits, 0x0001));
+
+            for (size_t i=0; i < hits.size(); i++) {
+                if (hits[i].isHit()) {
+                    rp3d_test(hits[i].collider->getCollisionCategoryBits() == 0x0001);
+                }
+            }
+        }
+
+        void testEmptyBatch() {
+
+            std::vector<Ray> rays;
+            std::vector<RaycastHit> hits(3);
+            mWorld->raycastBatch(rays, hits, RaycastBatchMode::CLOSEST_HIT, 0xFFFF, true);
+            rp3d_test(hits.empty());
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,388 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_WIDE_AABB_TREE_H
+#define TEST_WIDE_AABB_TREE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/collision/broadphase/WideAABBTree.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <reactphysics3d/mathematics/Ray.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <vector>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+class WideTreeRaycastCallback : public DynamicAABBTreeRaycastCallback {
+
+    public:
+
+        std::vector<int32> mHitNodes;
+
+        const DynamicAABBTree* mTree = nullptr;
+
+        /// True if the callback returns the hit fraction of the AABB of the node (closest hit)
+        bool mIsClosestHit = false;
+
+        decimal mClosestHitFraction = decimal(1.0);
+
+        // Called when the AABB of a leaf node is hit by a ray
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override {
+
+            mHitNodes.push_back(nodeId);
+
+            if (!mIsClosestHit) return decimal(-1.0);
+
+            Vector3 hitPoint;
+            if (!mTree->getFatAABB(nodeId).raycast(ray, hitPoint)) return decimal(-1.0);
+
+            const decimal hitFraction = (hitPoint - ray.point1).length() / (ray.point2 - ray.point1).length();
+            if (hitFraction < mClosestHitFraction) {
+                mClosestHitFraction = hitFraction;
+            }
+            return hitFraction;
+        }
+
+        void reset() {
+            mHitNodes.clear();
+            mClosestHitFraction = decimal(1.0);
+        }
+
+        std::vector<int32> getSortedHitNodes() const {
+            std::vector<int32> nodes = mHitNodes;
+            std::sort(nodes.begin(), nodes.end());
+            return nodes;
+        }
+};
+
+class WideTreeWorldRaycastCallback : public RaycastCallback {
+
+    public:
+
+        Body* closestBody = nullptr;
+
+        decimal closestHitFraction = decimal(1.0);
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            if (info.hitFraction < closestHitFraction) {
+                closestHitFraction = info.hitFraction;
+                closestBody = info.body;
+            }
+            return info.hitFraction;
+        }
+};
+
+// Class TestWideAABBTree
+/**
+ * Unit test for the wide AABB tree. The queries of the wide tree must report the
+ * same leaf nodes as the queries of the dynamic AABB tree it is built from.
+ */
+class TestWideAABBTree : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        Profiler* mProfiler;
+#endif
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1u << 24);
+        }
+
+        /// Return a random AABB in a cube of a given size
+        AABB randomAABB(decimal size, decimal maxExtent) {
+            const Vector3 min(random(-size, size), random(-size, size), random(-size, size));
+            return AABB(min, min + Vector3(random(decimal(0.1), maxExtent), random(decimal(0.1), maxExtent), random(decimal(0.1), maxExtent)));
+        }
+
+        /// Return the sorted nodes of an array
+        static std::vector<int32> sortedNodes(const Array<int32>& nodes) {
+            std::vector<int32> sorted;
+            for (uint32 i=0; i < nodes.size(); i++) sorted.push_back(nodes[i]);
+            std::sort(sorted.begin(), sorted.end());
+            return sorted;
+        }
+
+        /// Return the sorted pairs of an array
+        static std::vector<std::pair<int32, int32>> sortedPairs(const Array<Pair<int32, int32>>& pairs) {
+            std::vector<std::pair<int32, int32>> sorted;
+            for (uint32 i=0; i < pairs.size(); i++) sorted.push_back(std::make_pair(pairs[i].first, pairs[i].second));
+            std::sort(sorted.begin(), sorted.end());
+            return sorted;
+        }
+
+        /// Test that the wide tree queries report the same nodes as the dynamic tree queries
+        void testSameQueriesResults(const DynamicAABBTree& tree, const WideAABBTree& wideTree, const Array<int32>& nodes) {
+
+            // Overlap with the shapes of the tree
+            Array<Pair<int32, int32>> treePairs(mAllocator);
+            Array<Pair<int32, int32>> wideTreePairs(mAllocator);
+            tree.reportAllShapesOverlappingWithShapes(nodes, 0, nodes.size(), treePairs);
+            wideTree.reportAllShapesOverlappingWithShapes(nodes, 0, nodes.size(), wideTreePairs);
+            rp3d_test(treePairs.size() > nodes.size());
+            rp3d_test(sortedPairs(treePairs) == sortedPairs(wideTreePairs));
+
+            // Overlap with random AABBs
+            for (int i=0; i < 50; i++) {
+
+                const AABB aabb = randomAABB(decimal(40.0), decimal(15.0));
+                Array<int32> treeNodes(mAllocator);
+                Array<int32> wideTreeNodes(mAllocator);
+                tree.reportAllShapesOverlappingWithAABB(aabb, treeNodes);
+                wideTree.reportAllShapesOverlappingWithAABB(aabb, wideTreeNodes, mAllocator);
+                rp3d_test(sortedNodes(treeNodes) == sortedNodes(wideTreeNodes));
+            }
+
+            // Raycast with random rays and with rays parallel to the axis
+            WideTreeRaycastCallback treeCallback;
+            WideTreeRaycastCallback wideTreeCallback;
+            treeCallback.mTree = &tree;
+            wideTreeCallback.mTree = &tree;
+            for (int i=0; i < 60; i++) {
+
+                Vector3 point1(random(-50, 50), random(-50, 50), random(-50, 50));
+                Vector3 point2(random(-50, 50), random(-50, 50), random(-50, 50));
+                if (i % 3 == 0) {
+                    point2.y = point1.y;
+                    point2.z = point1.z;
+                }
+                const Ray ray(point1, point2);
+
+                // All the AABBs hit by the ray
+                treeCallback.mIsClosestHit = false;
+                wideTreeCallback.mIsClosestHit = false;
+                treeCallback.reset();
+                wideTreeCallback.reset();
+                tree.raycast(ray, treeCallback);
+                wideTree.raycast(ray, wideTreeCallback, mAllocator);
+                rp3d_test(treeCallback.getSortedHitNodes() == wideTreeCallback.getSortedHitNodes());
+
+                // Closest AABB hit by the ray
+                treeCallback.mIsClosestHit = true;
+                wideTreeCallback.mIsClosestHit = true;
+                treeCallback.reset();
+                wideTreeCallback.reset();
+                tree.raycast(ray, treeCallback);
+                wideTree.raycast(ray, wideTreeCallback, mAllocator);
+                rp3d_test(treeCallback.mClosestHitFraction == wideTreeCallback.mClosestHitFraction);
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestWideAABBTree(const std::string& name): Test(name), mRandomState(12345)  {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            mProfiler = new Profiler();
+#endif
+
+        }
+
+        /// Destructor
+        ~TestWideAABBTree() {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            delete mProfiler;
+#endif
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testLessOrEqualMask();
+            testEmptyTree();
+            testQueries();
+            testWorldRaycast();
+        }
+
+        void testLessOrEqualMask() {
+
+            decimal values1[SimdDecimal::NB_LANES];
+            decimal values2[SimdDecimal::NB_LANES];
+            uint32 expectedMask = 0;
+            for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+                values1[i] = decimal(i);
+                values2[i] = decimal(i % 3 == 0 ? i : (i % 3 == 1 ? i + 1 : i - 1));
+                if (values1[i] <= values2[i]) expectedMask |= (1u << i);
+            }
+
+            rp3d_test(lessOrEqualMask(SimdDecimal::load(values1), SimdDecimal::load(values2)) == expectedMask);
+            rp3d_test(lessOrEqualMask(SimdDecimal(1), SimdDecimal(2)) == (1u << SimdDecimal::NB_LANES) - 1);
+            rp3d_test(lessOrEqualMask(SimdDecimal(2), SimdDecimal(1)) == 0);
+        }
+
+        void testEmptyTree() {
+
+            DynamicAABBTree tree(mAllocator);
+            WideAABBTree wideTree(mAllocator, tree);
+#ifdef IS_RP3D_PROFILING_ENABLED
+            tree.setProfiler(mProfiler);
+            wideTree.setProfiler(mProfiler);
+#endif
+
+            wideTree.build();
+            rp3d_test(wideTree.getNbNodes() == 0);
+
+            Array<int32> overlappingNodes(mAllocator);
+            wideTree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-1, -1, -1), Vector3(1, 1, 1)), overlappingNodes, mAllocator);
+            rp3d_test(overlappingNodes.size() == 0);
+
+            // Tree with a single leaf
+            int32 nodeId = tree.addObject(AABB(Vector3(-1, -1, -1), Vector3(1, 1, 1)), static_cast<void*>(nullptr));
+            wideTree.build();
+            rp3d_test(wideTree.getNbNodes() == 1);
+
+            wideTree.reportAllShapesOverlappingWithAABB(AABB(Vector3(0, 0, 0), Vector3(2, 2, 2)), overlappingNodes, mAllocator);
+            rp3d_test(overlappingNodes.size() == 1);
+            rp3d_test(overlappingNodes[0] == nodeId);
+
+            WideTreeRaycastCallback callback;
+            wideTree.raycast(Ray(Vector3(-5, 0, 0), Vector3(5, 0, 0)), callback, mAllocator);
+            rp3d_test(callback.mHitNodes.size() == 1);
+            callback.reset();
+            wideTree.raycast(Ray(Vector3(-5, 3, 0), Vector3(5, 3, 0)), callback, mAllocator);
+            rp3d_test(callback.mHitNodes.size() == 0);
+        }
+
+        void testQueries() {
+
+            DynamicAABBTree tree(mAllocator);
+            WideAABBTree wideTree(mAllocator, tree);
+#ifdef IS_RP3D_PROFILING_ENABLED
+            tree.setProfiler(mProfiler);
+            wideTree.setProfiler(mProfiler);
+#endif
+
+            // Add many objects into the tree
+            Array<int32> nodes(mAllocator);
+            for (int i=0; i < 500; i++) {
+                nodes.add(tree.addObject(randomAABB(decimal(40.0), decimal(6.0)), static_cast<void*>(nullptr)));
+            }
+
+            wideTree.build();
+
+            // The wide tree must have fewer nodes than the internal nodes of the binary tree
+            // (except with two SIMD lanes where the wide tree is also a binary tree)
+            rp3d_test(wideTree.getNbNodes() > 0);
+            if (SimdDecimal::NB_LANES > 2) {
+                rp3d_test(wideTree.getNbNodes() < nodes.size() - 1);
+            }
+            else {
+                rp3d_test(wideTree.getNbNodes() <= nodes.size() - 1);
+            }
+
+            testSameQueriesResults(tree, wideTree, nodes);
+
+            // Move and remove some objects and build the wide tree again
+            for (uint32 i=0; i < nodes.size(); i += 3) {
+                tree.updateObject(nodes[i], randomAABB(decimal(40.0), decimal(6.0)), true);
+            }
+            for (uint32 i=1; i < 100; i += 2) {
+                tree.removeObject(nodes[i]);
+            }
+            Array<int32> remainingNodes(mAllocator);
+            for (uint32 i=0; i < nodes.size(); i++) {
+                if (i >= 100 || i % 2 == 0) remainingNodes.add(nodes[i]);
+            }
+
+            wideTree.build();
+
+            testSameQueriesResults(tree, wideTree, remainingNodes);
+        }
+
+        void testWorldRaycast() {
+
+            // Two worlds with the same bodies (the second one uses the wide AABB tree)
+            PhysicsWorld* worlds[2];
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(1, 1, 1));
+            for (int w=0; w < 2; w++) {
+
+                mRandomState = 54321;
+
+                PhysicsWorld::WorldSettings settings;
+                settings.isWideAABBTreeEnabled = (w == 1);
+                worlds[w] = mPhysicsCommon.createPhysicsWorld(settings);
+
+                for (int i=0; i < 200; i++) {
+                    RigidBody* body = worlds[w]->createRigidBody(Transform(Vector3(random(-30, 30), random(-30, 30), random(-30, 30)), Quaternion::identity()));
+                    body->setType(BodyType::STATIC);
+                    body->addCollider(boxShape, Transform::identity());
+                }
+
+                worlds[w]->update(decimal(1.0 / 60.0));
+            }
+
+            for (int i=0; i < 100; i++) {
+
+                const Ray ray(Vector3(random(-40, 40), random(-40, 40), random(-40, 40)), Vector3(random(-40, 40), random(-40, 40), random(-40, 40)));
+
+                WideTreeWorldRaycastCallback callbacks[2];
+                uint32 bodiesIndices[2];
+                for (int w=0; w < 2; w++) {
+
+                    worlds[w]->raycast(ray, &callbacks[w]);
+
+                    bodiesIndices[w] = 0;
+                    while (bodiesIndices[w] < worlds[w]->getNbRigidBodies() && worlds[w]->getRigidBody(bodiesIndices[w]) != callbacks[w].closestBody) {
+                        bodiesIndices[w]++;
+                    }
+                }
+
+                rp3d_test(callbacks[0].closestHitFraction == callbacks[1].closestHitFraction);
+                rp3d_test(bodiesIndices[0] == bodiesIndices[1]);
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(worlds[0]);
+            mPhysicsCommon.destroyPhysicsWorld(worlds[1]);
+        }
+ };
+
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <map>
 #include <vector>
+#include <thread>
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -524,6 +525,8 @@ class TestWorldQueries : public Test {
             testConvexMeshVsConvexMeshCollision();
             testConvexMeshVsCapsuleCollision();
             testConvexMeshVsConcaveMeshCollision();
+
+            testConcurrentQueries();
         }
 
 		void testNoCollisions() {
@@ -2964,6 +2967,116 @@ class TestWorldQueries : public Test {
             mCapsuleBody1->setTransform(initTransform1);
             mConcaveMeshBody->setTransform(initTransform2);
         }
+
+        void testConcurrentQueries() {
+
+            // Raycast callback that keeps the closest hit
+            class ClosestHitRaycastCallback : public RaycastCallback {
+
+                public:
+
+                    Body* body = nullptr;
+
+                    virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+                        body = info.body;
+                        return info.hitFraction;
+                    }
+            };
+
+            Transform initBoxTransform = mBoxBody1->getTransform();
+            Transform initConcaveMeshTransform = mConcaveMeshBody->getTransform();
+            Transform initBoxTransform2 = mBoxBody2->getTransform();
+            Transform initSphereTransform = mSphereBody1->getTransform();
+
+            // Move a box on the concave mesh and another box against a sphere
+            mBoxBody1->setTransform(Transform(Vector3(10, 22, 50), Quaternion::identity()));
+            mConcaveMeshBody->setTransform(Transform(Vector3(10, 20, 50), Quaternion::identity()));
+            mBoxBody2->setTransform(Transform(Vector3(-50, 20, 50), Quaternion::identity()));
+            mSphereBody1->setTransform(Transform(Vector3(-44, 20, 50), Quaternion::identity()));
+
+            const Ray ray(Vector3(10, 40, 50), Vector3(10, 0, 50));
+
+            // Results of the queries on the current thread
+            mCollisionCallback.reset();
+            mWorld->testCollision(mBoxBody1, mCollisionCallback);
+            const CollisionData* boxCollisionData = mCollisionCallback.getCollisionData(mBoxCollider1, mConcaveMeshCollider);
+            rp3d_test(boxCollisionData != nullptr);
+            const int nbBoxContactPoints = boxCollisionData != nullptr ? boxCollisionData->getTotalNbContactPoints() : 0;
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(mBoxBody2, mSphereBody1, mCollisionCallback);
+            const CollisionData* sphereBoxCollisionData = mCollisionCallback.getCollisionData(mBoxCollider2, mSphereCollider1);
+            rp3d_test(sphereBoxCollisionData != nullptr);
+            const int nbSphereBoxContactPoints = sphereBoxCollisionData != nullptr ? sphereBoxCollisionData->getTotalNbContactPoints() : 0;
+
+            ClosestHitRaycastCallback raycastCallback;
+            mWorld->raycast(ray, &raycastCallback);
+            rp3d_test(raycastCallback.body == mBoxBody1);
+
+            mWorld->beginConcurrentQueries();
+            rp3d_test(mWorld->isInConcurrentQueriesMode());
+
+            // Run the same queries on several threads at the same time
+            const uint32 nbThreads = 4;
+            std::vector<int> areThreadResultsValid(nbThreads, 0);
+            std::vector<std::thread> threads;
+            for (uint32 t=0; t < nbThreads; t++) {
+
+                threads.emplace_back([&, t]() {
+
+                    bool isValid = true;
+                    for (uint32 i=0; i < 50; i++) {
+
+                        WorldCollisionCallback collisionCallback;
+                        mWorld->testCollision(collisionCallback);
+                        isValid = isValid && collisionCallback.hasContacts();
+
+                        WorldCollisionCallback boxCollisionCallback;
+                        mWorld->testCollision(mBoxBody1, boxCollisionCallback);
+                        const CollisionData* boxData = boxCollisionCallback.getCollisionData(mBoxCollider1, mConcaveMeshCollider);
+                        isValid = isValid && boxData != nullptr && boxData->getTotalNbContactPoints() == nbBoxContactPoints;
+
+                        WorldCollisionCallback sphereBoxCollisionCallback;
+                        mWorld->testCollision(mBoxBody2, mSphereBody1, sphereBoxCollisionCallback);
+                        const CollisionData* sphereBoxData = sphereBoxCollisionCallback.getCollisionData(mBoxCollider2, mSphereCollider1);
+                        isValid = isValid && sphereBoxData != nullptr && sphereBoxData->getTotalNbContactPoints() == nbSphereBoxContactPoints;
+
+                        WorldOverlapCallback overlapCallback;
+                        mWorld->testOverlap(overlapCallback);
+                        isValid = isValid && overlapCallback.hasOverlapWithBody(mBoxBody1) && overlapCallback.hasOverlapWithBody(mSphereBody1);
+
+                        isValid = isValid && mWorld->testOverlap(mBoxBody2, mSphereBody1);
+                        isValid = isValid && !mWorld->testOverlap(mBoxBody1, mSphereBody1);
+
+                        ClosestHitRaycastCallback threadRaycastCallback;
+                        mWorld->raycast(ray, &threadRaycastCallback);
+                        isValid = isValid && threadRaycastCallback.body == mBoxBody1;
+                    }
+
+                    areThreadResultsValid[t] = isValid ? 1 : 0;
+                });
+            }
+
+            for (uint32 t=0; t < nbThreads; t++) {
+                threads[t].join();
+                rp3d_test(areThreadResultsValid[t] == 1);
+            }
+
+            mWorld->endConcurrentQueries();
+            rp3d_test(!mWorld->isInConcurrentQueriesMode());
+
+            // The queries must not have modified the world
+            mCollisionCallback.reset();
+            mWorld->testCollision(mBoxBody1, mCollisionCallback);
+            boxCollisionData = mCollisionCallback.getCollisionData(mBoxCollider1, mConcaveMeshCollider);
+            rp3d_test(boxCollisionData != nullptr && boxCollisionData->getTotalNbContactPoints() == nbBoxContactPoints);
+
+            // Reset the init transforms
+            mBoxBody1->setTransform(initBoxTransform);
+            mConcaveMeshBody->setTransform(initConcaveMeshTransform);
+            mBoxBody2->setTransform(initBoxTransform2);
+            mSphereBody1->setTransform(initSphereTransform);
+        }
  };
 
 }
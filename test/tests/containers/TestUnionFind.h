@@ -0,0 +1,134 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+#ifndef TEST_UNION_FIND_H
+#define TEST_UNION_FIND_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/containers/UnionFind.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <reactphysics3d/utils/DefaultTaskScheduler.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestUnionFind
+/**
+ * Unit test for the UnionFind class
+ */
+class TestUnionFind : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestUnionFind(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testConstructor();
+            testMerge();
+            testConcurrentMerge();
+        }
+
+        void testConstructor() {
+
+            UnionFind sets1(mAllocator, 0);
+            rp3d_test(sets1.getNbElements() == 0);
+
+            UnionFind sets2(mAllocator, 10);
+            rp3d_test(sets2.getNbElements() == 10);
+            for (uint32 i=0; i < 10; i++) {
+                rp3d_test(sets2.find(i) == i);
+            }
+        }
+
+        void testMerge() {
+
+            UnionFind sets(mAllocator, 10);
+
+            sets.merge(7, 3);
+            rp3d_test(sets.find(7) == 3);
+            rp3d_test(sets.find(3) == 3);
+
+            sets.merge(9, 8);
+            sets.merge(8, 7);
+            rp3d_test(sets.find(9) == 3);
+            rp3d_test(sets.find(8) == 3);
+
+            // Merging two elements of the same set does not change anything
+            sets.merge(9, 7);
+            rp3d_test(sets.find(9) == 3);
+
+            sets.merge(5, 1);
+            sets.merge(9, 5);
+            rp3d_test(sets.find(3) == 1);
+            rp3d_test(sets.find(9) == 1);
+            rp3d_test(sets.find(0) == 0);
+            rp3d_test(sets.find(2) == 2);
+
+            // The root of each element is the smallest element of its set
+            sets.flatten();
+            const uint32 roots[10] = {0, 1, 2, 1, 4, 1, 6, 1, 1, 1};
+            for (uint32 i=0; i < 10; i++) {
+                rp3d_test(sets.getFlattenedRoot(i) == roots[i]);
+            }
+        }
+
+        void testConcurrentMerge() {
+
+            DefaultTaskScheduler scheduler(mAllocator, 4);
+
+            // Merge the elements of the same residue modulo 7 concurrently
+            const uint32 nbElements = 5000;
+            UnionFind sets(mAllocator, nbElements);
+            scheduler.parallelFor(nbElements - 7, 64, [&sets](const TaskScheduler::TaskRange& range) {
+                for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+                    sets.merge(nbElements - 1 - i, nbElements - 8 - i);
+                }
+            });
+
+            sets.flatten();
+            bool isCorrect = true;
+            for (uint32 i=0; i < nbElements; i++) {
+                isCorrect &= sets.getFlattenedRoot(i) == i % 7;
+            }
+            rp3d_test(isCorrect);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,268 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_DETERMINISM_H
+#define TEST_DETERMINISM_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <cstring>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestDeterminism
+/**
+ * Unit test for the determinism of the physics world. Scenes similar to the testbed
+ * scenes are simulated with different numbers of workers and the transforms of the
+ * bodies must be identical byte-for-byte (the parallel stages must not depend on the
+ * number of workers).
+ */
+class TestDeterminism : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Scenes that are simulated
+        enum class Scene {Pile, BoxTower, Joints, HeightField};
+
+        /// Number of simulation steps of each scene
+        static const uint32 NB_STEPS = 120;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        ConvexMesh* mConvexMesh;
+
+        HeightField* mHeightField;
+
+        float mConvexMeshVertices[8 * 3];
+
+        float mHeightFieldData[20 * 20];
+
+        // ---------- Methods ---------- //
+
+        /// Create a static floor box
+        void createFloor(PhysicsWorld* world) {
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mPhysicsCommon.createBoxShape(Vector3(60, 1, 60)), Transform::identity());
+        }
+
+        /// Create a pile of bodies with different collision shapes that fall on the floor
+        void createPileScene(PhysicsWorld* world) {
+
+            createFloor(world);
+
+            CollisionShape* shapes[4] = {mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5)),
+                                         mPhysicsCommon.createSphereShape(0.5),
+                                         mPhysicsCommon.createCapsuleShape(0.4, 0.8),
+                                         mPhysicsCommon.createConvexMeshShape(mConvexMesh)};
+
+            uint32 shapeIndex = 0;
+            for (int y=0; y < 6; y++) {
+                for (int x=0; x < 10; x++) {
+                    for (int z=0; z < 10; z++) {
+
+                        const decimal angle = decimal(0.1) * ((x + y + z) % 7);
+                        const Transform transform(Vector3(x * decimal(1.3) - 6, 1 + y * decimal(1.5), z * decimal(1.3) - 6),
+                                                  Quaternion::fromEulerAngles(angle, decimal(2) * angle, decimal(0.5) * angle));
+                        RigidBody* body = world->createRigidBody(transform);
+                        body->addCollider(shapes[shapeIndex % 4], Transform::identity());
+                        shapeIndex++;
+                    }
+                }
+            }
+        }
+
+        /// Create towers of stacked boxes (large islands)
+        void createBoxTowerScene(PhysicsWorld* world) {
+
+            createFloor(world);
+
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+
+            for (int t=0; t < 4; t++) {
+                for (int y=0; y < 10; y++) {
+                    for (int x=0; x < 4; x++) {
+                        for (int z=0; z < 4; z++) {
+
+                            const Transform transform(Vector3(t * 8 - 12 + x * decimal(1.01), decimal(0.5) + y * decimal(1.01), z * decimal(1.01)),
+                                                      Quaternion::identity());
+                            RigidBody* body = world->createRigidBody(transform);
+                            body->addCollider(boxShape, Transform::identity());
+                        }
+                    }
+                }
+            }
+        }
+
+        /// Create chains of bodies connected with the different kinds of joints
+        void createJointsScene(PhysicsWorld* world) {
+
+            createFloor(world);
+
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.3, 0.3, 0.3));
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(0.3);
+
+            for (int c=0; c < 16; c++) {
+
+                const Vector3 chainStart(c * decimal(2.0) - 16, 20, 0);
+
+                RigidBody* previousBody = world->createRigidBody(Transform(chainStart, Quaternion::identity()));
+                previousBody->setType(BodyType::STATIC);
+                previousBody->addCollider(sphereShape, Transform::identity());
+
+                for (int i=1; i < 12; i++) {
+
+                    const Vector3 position = chainStart + Vector3(0, 0, i * decimal(0.8));
+                    RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+                    body->addCollider(c % 2 == 0 ? static_cast<CollisionShape*>(boxShape) : sphereShape, Transform::identity());
+
+                    const Vector3 anchor = position - Vector3(0, 0, decimal(0.4));
+                    switch ((c + i) % 4) {
+                        case 0: world->createJoint(BallAndSocketJointInfo(previousBody, body, anchor)); break;
+                        case 1: world->createJoint(HingeJointInfo(previousBody, body, anchor, Vector3(1, 0, 0))); break;
+                        case 2: world->createJoint(SliderJointInfo(previousBody, body, anchor, Vector3(0, 0, 1), -0.2, 0.2)); break;
+                        case 3: world->createJoint(FixedJointInfo(previousBody, body, anchor)); break;
+                    }
+
+                    previousBody = body;
+                }
+            }
+        }
+
+        /// Create bodies that fall on a height-field
+        void createHeightFieldScene(PhysicsWorld* world) {
+
+            RigidBody* terrain = world->createRigidBody(Transform::identity());
+            terrain->setType(BodyType::STATIC);
+            terrain->addCollider(mPhysicsCommon.createHeightFieldShape(mHeightField, Vector3(2, 1, 2)), Transform::identity());
+
+            CollisionShape* shapes[3] = {mPhysicsCommon.createSphereShape(0.5),
+                                         mPhysicsCommon.createBoxShape(Vector3(0.4, 0.4, 0.4)),
+                                         mPhysicsCommon.createConvexMeshShape(mConvexMesh)};
+
+            for (int x=0; x < 12; x++) {
+                for (int z=0; z < 12; z++) {
+
+                    const Transform transform(Vector3(x * decimal(2.5) - 15, 4 + (x + z) % 3, z * decimal(2.5) - 15), Quaternion::identity());
+                    RigidBody* body = world->createRigidBody(transform);
+                    body->addCollider(shapes[(x + z) % 3], Transform::identity());
+                }
+            }
+        }
+
+        /// Simulate a scene with a given number of workers and return the bytes of the transforms of the bodies
+        std::vector<uint8> simulate(Scene scene, uint32 nbWorkers) {
+
+            DefaultTaskScheduler* taskScheduler = mPhysicsCommon.createDefaultTaskScheduler(nbWorkers);
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = taskScheduler;
+            settings.isGraphColoringContactSolverEnabled = scene == Scene::BoxTower;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            switch (scene) {
+                case Scene::Pile: createPileScene(world); break;
+                case Scene::BoxTower: createBoxTowerScene(world); break;
+                case Scene::Joints: createJointsScene(world); break;
+                case Scene::HeightField: createHeightFieldScene(world); break;
+            }
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            std::vector<uint8> transformsBytes(world->getNbRigidBodies() * sizeof(Transform));
+            for (uint32 i=0; i < world->getNbRigidBodies(); i++) {
+                std::memcpy(transformsBytes.data() + i * sizeof(Transform), &(world->getRigidBody(i)->getTransform()), sizeof(Transform));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyDefaultTaskScheduler(taskScheduler);
+
+            return transformsBytes;
+        }
+
+        /// Return true if a scene gives the same transforms with 1, 2 and 8 workers
+        bool isSceneDeterministic(Scene scene) {
+
+            const std::vector<uint8> transformsBytes1 = simulate(scene, 1);
+            const std::vector<uint8> transformsBytes2 = simulate(scene, 2);
+            const std::vector<uint8> transformsBytes8 = simulate(scene, 8);
+
+            return transformsBytes1 == transformsBytes2 && transformsBytes1 == transformsBytes8;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDeterminism(const std::string& name) : Test(name) {
+
+            // Convex mesh (a box with a cut corner)
+            const float vertices[8 * 3] = {-0.5f, -0.5f, 0.5f,   0.5f, -0.5f, 0.5f,   0.5f, -0.5f, -0.5f,   -0.5f, -0.5f, -0.5f,
+                                           -0.5f, 0.5f, 0.5f,    0.3f, 0.3f, 0.5f,    0.5f, 0.5f, -0.5f,    -0.5f, 0.5f, -0.5f};
+            std::memcpy(mConvexMeshVertices, vertices, sizeof(vertices));
+            VertexArray vertexArray(mConvexMeshVertices, 3 * sizeof(float), 8, VertexArray::DataType::VERTEX_FLOAT_TYPE);
+            std::vector<Message> messages;
+            mConvexMesh = mPhysicsCommon.createConvexMesh(vertexArray, messages);
+            rp3d_test(mConvexMesh != nullptr);
+
+            // Height-field with some bumps
+            for (int i=0; i < 20; i++) {
+                for (int j=0; j < 20; j++) {
+                    mHeightFieldData[i * 20 + j] = float(((i * 7 + j * 3) % 5)) * 0.3f;
+                }
+            }
+            mHeightField = mPhysicsCommon.createHeightField(20, 20, mHeightFieldData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            rp3d_test(mHeightField != nullptr);
+        }
+
+        /// Run the tests
+        void run() {
+
+            testDeterministicScenes();
+        }
+
+        void testDeterministicScenes() {
+
+            rp3d_test(isSceneDeterministic(Scene::Pile));
+            rp3d_test(isSceneDeterministic(Scene::BoxTower));
+            rp3d_test(isSceneDeterministic(Scene::Joints));
+            rp3d_test(isSceneDeterministic(Scene::HeightField));
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_GRAPH_COLORING_CONTACT_SOLVER_H
+#define TEST_GRAPH_COLORING_CONTACT_SOLVER_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestGraphColoringContactSolver
+/**
+ * Unit test for the graph-colored contact solver. The contact manifolds of a color never
+ * share a dynamic body and can therefore be solved in any order. A large island is simulated
+ * with the chunks of each color solved in a shuffled order and the results must be the same
+ * as with the chunks solved in order (two manifolds of a color that share a body in different
+ * chunks would give different results).
+ */
+class TestGraphColoringContactSolver : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of simulation steps
+        static const uint32 NB_STEPS = 60;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mBoxShape;
+
+        BoxShape* mFloorShape;
+
+        // ---------- Methods ---------- //
+
+        /// Simulate a large island of boxes with a given task scheduler and return the transforms of the bodies
+        std::vector<Transform> simulate(TaskScheduler* taskScheduler) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = taskScheduler;
+            settings.isGraphColoringContactSolverEnabled = true;
+            settings.isSimdContactSolverEnabled = false;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mFloorShape, Transform::identity());
+
+            // Overlapping boxes so that all of them are in a single island
+            std::vector<RigidBody*> bodies;
+            for (uint32 i=0; i < 400; i++) {
+                const Vector3 position(decimal(i % 10) * decimal(0.98), decimal(0.5) + decimal(i / 100) * decimal(0.98), decimal((i / 10) % 10) * decimal(0.98));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+                body->addCollider(mBoxShape, Transform::identity());
+                bodies.push_back(body);
+            }
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+
+            std::vector<Transform> transforms;
+            for (RigidBody* body : bodies) {
+                transforms.push_back(body->getTransform());
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            return transforms;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestGraphColoringContactSolver(const std::string& name) : Test(name) {
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            mFloorShape = mPhysicsCommon.createBoxShape(Vector3(50, 0.5, 50));
+        }
+
+        /// Run the tests
+        void run() {
+
+            testShuffledColors();
+        }
+
+        void testShuffledColors() {
+
+            DefaultTaskScheduler* scheduler1 = mPhysicsCommon.createDefaultTaskScheduler(1);
+            ShuffledTaskScheduler shuffledScheduler(4);
+
+            const std::vector<Transform> transforms = simulate(scheduler1);
+            const std::vector<Transform> shuffledTransforms = simulate(&shuffledScheduler);
+
+            // The contact manifolds of the colors have been split into several chunks at each step
+            rp3d_test(shuffledScheduler.getNbParallelFors(PARALLEL_COLOR_CHUNK_SIZE, 2) > NB_STEPS);
+
+            // The chunks of the colors solved in a shuffled order give the same results
+            rp3d_test(transforms == shuffledTransforms);
+
+            // The pile must stay above the floor
+            bool isAboveFloor = true;
+            for (const Transform& transform : transforms) {
+                isAboveFloor &= transform.getPosition().y > decimal(0.3);
+            }
+            rp3d_test(isAboveFloor);
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler1);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_ISLANDS_H
+#define TEST_ISLANDS_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestIslands
+/**
+ * Unit test for the creation of the islands of a physics world. The bodies of the contact pairs
+ * and joints are merged into islands. The bodies of an island are put to sleep together and a
+ * sleeping body is woken up when it joins the island of an awake body. The contact pairs are merged in chunks that are executed in a shuffled order and the
+ * islands must be the same as with the chunks executed in order.
+ */
+class TestIslands : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Maximum number of simulation steps
+        static const uint32 NB_STEPS = 300;
+
+        /// Value of a sleep step for a body that has never fallen asleep
+        static constexpr uint32 NEVER_SLEEPING = ~uint32(0);
+
+        // ---------- Structures ---------- //
+
+        /// Bodies of the scene
+        struct Scene {
+
+            /// Boxes of a large pile (a single island)
+            std::vector<RigidBody*> pile;
+
+            /// Sleeping boxes stacked on the floor
+            std::vector<RigidBody*> sleepingStack;
+
+            /// Box that falls on the sleeping stack
+            RigidBody* fallingBox;
+
+            /// Sleeping box that only touches the floor
+            RigidBody* sleepingBox;
+
+            /// Sleeping bodies of a chain attached to a static body with joints
+            std::vector<RigidBody*> chain;
+        };
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mBoxShape;
+
+        BoxShape* mFloorShape;
+
+        // ---------- Methods ---------- //
+
+        /// Create the scene
+        Scene createScene(PhysicsWorld* world) {
+
+            Scene scene;
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mFloorShape, Transform::identity());
+
+            // Pile of touching boxes with enough contact pairs to merge them with several tasks (but with fewer
+            // bodies than the chunk size such that the only split loop over PARALLEL_FOR_CHUNK_SIZE items is the merge)
+            for (uint32 i=0; i < 200; i++) {
+                const Vector3 position(decimal(i % 10) * decimal(0.999), decimal(0.5) + decimal(i / 100) * decimal(0.999), decimal((i / 10) % 10) * decimal(0.999));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::identity()));
+                body->addCollider(mBoxShape, Transform::identity());
+                scene.pile.push_back(body);
+            }
+
+            // Sleeping stack of boxes on which an awake box falls
+            for (uint32 i=0; i < 4; i++) {
+                RigidBody* body = world->createRigidBody(Transform(Vector3(20, decimal(0.5) + decimal(i), 20), Quaternion::identity()));
+                body->addCollider(mBoxShape, Transform::identity());
+                body->setIsSleeping(true);
+                scene.sleepingStack.push_back(body);
+            }
+            scene.fallingBox = world->createRigidBody(Transform(Vector3(20, 6, 20), Quaternion::identity()));
+            scene.fallingBox->addCollider(mBoxShape, Transform::identity());
+
+            // Sleeping box that only touches the floor shared with the awake bodies
+            scene.sleepingBox = world->createRigidBody(Transform(Vector3(-20, 0.5, -20), Quaternion::identity()));
+            scene.sleepingBox->addCollider(mBoxShape, Transform::identity());
+            scene.sleepingBox->setIsSleeping(true);
+
+            // Sleeping chain of bodies attached with joints to a static body
+            RigidBody* support = world->createRigidBody(Transform(Vector3(0, 20, -20), Quaternion::identity()));
+            support->setType(BodyType::STATIC);
+            RigidBody* previousBody = support;
+            for (uint32 j=0; j < 8; j++) {
+                const Vector3 anchor(decimal(j) * decimal(1.2), decimal(20.0), decimal(-20.0));
+                RigidBody* body = world->createRigidBody(Transform(anchor + Vector3(decimal(0.6), 0, 0), Quaternion::identity()));
+                body->addCollider(mBoxShape, Transform::identity());
+                body->setIsSleeping(true);
+                world->createJoint(BallAndSocketJointInfo(previousBody, body, anchor));
+                scene.chain.push_back(body);
+                previousBody = body;
+            }
+
+            return scene;
+        }
+
+        /// Simulate the scene and return the step at which each body of the pile has fallen asleep
+        std::vector<uint32> simulate(TaskScheduler* taskScheduler) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = taskScheduler;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            Scene scene = createScene(world);
+
+            // Waking up the last body of the chain wakes up the whole chain
+            world->update(decimal(1.0) / decimal(60.0));
+            for (RigidBody* body : scene.chain) {
+                rp3d_test(body->isSleeping());
+            }
+            scene.chain.back()->setIsSleeping(false);
+            world->update(decimal(1.0) / decimal(60.0));
+            for (RigidBody* body : scene.chain) {
+                rp3d_test(!body->isSleeping());
+            }
+
+            std::vector<uint32> pileSleepSteps(scene.pile.size(), NEVER_SLEEPING);
+            std::vector<bool> isStackBodyWokenUp(scene.sleepingStack.size(), false);
+            for (uint32 i=0; i < NB_STEPS; i++) {
+
+                world->update(decimal(1.0) / decimal(60.0));
+
+                // The falling box wakes up the stack (a sleeping body joins the island of an awake body in contact with it)
+                for (size_t b=0; b < scene.sleepingStack.size(); b++) {
+                    if (!scene.sleepingStack[b]->isSleeping()) {
+                        isStackBodyWokenUp[b] = true;
+                    }
+                }
+
+                // The box that only touches the floor is never woken up
+                rp3d_test(scene.sleepingBox->isSleeping());
+
+                for (size_t b=0; b < scene.pile.size(); b++) {
+                    if (pileSleepSteps[b] == NEVER_SLEEPING && scene.pile[b]->isSleeping()) {
+                        pileSleepSteps[b] = i;
+                    }
+                }
+            }
+            for (size_t b=0; b < scene.sleepingStack.size(); b++) {
+                rp3d_test(isStackBodyWokenUp[b]);
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            return pileSleepSteps;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestIslands(const std::string& name) : Test(name) {
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            mFloorShape = mPhysicsCommon.createBoxShape(Vector3(60, 0.5, 60));
+        }
+
+        /// Run the tests
+        void run() {
+
+            testIslands();
+        }
+
+        void testIslands() {
+
+            DefaultTaskScheduler* scheduler1 = mPhysicsCommon.createDefaultTaskScheduler(1);
+            ShuffledTaskScheduler shuffledScheduler(4);
+
+            const std::vector<uint32> pileSleepSteps = simulate(scheduler1);
+            const std::vector<uint32> shuffledPileSleepSteps = simulate(&shuffledScheduler);
+
+            // The contact pairs have been merged with several tasks
+            rp3d_test(shuffledScheduler.getNbParallelFors(PARALLEL_FOR_CHUNK_SIZE, 2) > 0);
+
+            // The bodies of the pile are in the same island and therefore fall asleep at the same step
+            rp3d_test(pileSleepSteps[0] != NEVER_SLEEPING);
+            bool isSameStep = true;
+            for (uint32 step : pileSleepSteps) {
+                isSameStep &= step == pileSleepSteps[0];
+            }
+            rp3d_test(isSameStep);
+
+            // The islands merged in a shuffled order are the same
+            rp3d_test(pileSleepSteps == shuffledPileSleepSteps);
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler1);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_PARALLEL_ISLAND_SOLVER_H
+#define TEST_PARALLEL_ISLAND_SOLVER_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestParallelIslandSolver
+/**
+ * Unit test for the parallel island solver. The batches of islands of a world are solved
+ * in a shuffled order and the results must be the same as with the islands solved one after
+ * the other in a single task.
+ */
+class TestParallelIslandSolver : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of simulation steps
+        static const uint32 NB_STEPS = 60;
+
+        /// Number of piles of boxes (one island each)
+        static const uint32 NB_PILES = 6;
+
+        /// Number of chains of bodies connected with joints (one island each)
+        static const uint32 NB_CHAINS = 8;
+
+        /// Number of bodies in a chain
+        static const uint32 NB_BODIES_IN_CHAIN = 6;
+
+        /// Distance between two consecutive joints of a chain
+        static constexpr decimal CHAIN_LINK_LENGTH = decimal(1.2);
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mBoxShape;
+
+        BoxShape* mFloorShape;
+
+        // ---------- Methods ---------- //
+
+        /// Create separated piles of boxes on a floor and chains of bodies with the different types of joints
+        void createScene(PhysicsWorld* world, std::vector<RigidBody*>& bodies, std::vector<RigidBody*>& chainsBodies) {
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mFloorShape, Transform::identity());
+
+            // Piles of boxes far enough from each other to be different islands
+            for (uint32 p=0; p < NB_PILES; p++) {
+                for (uint32 i=0; i < 40; i++) {
+                    const Vector3 position(decimal(p) * decimal(8.0) + decimal(i % 2) * decimal(1.05), decimal(0.5) + decimal(i / 4) * decimal(1.01),
+                                           decimal((i / 2) % 2) * decimal(1.05) - decimal(10.0));
+                    RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.05) * (i % 3), 0)));
+                    body->addCollider(mBoxShape, Transform::identity());
+                    bodies.push_back(body);
+                }
+            }
+
+            // Chains attached to a shared static body (the static bodies are not part of the islands)
+            RigidBody* support = world->createRigidBody(Transform(Vector3(0, 30, 0), Quaternion::identity()));
+            support->setType(BodyType::STATIC);
+            for (uint32 c=0; c < NB_CHAINS; c++) {
+
+                RigidBody* previousBody = support;
+                for (uint32 j=0; j < NB_BODIES_IN_CHAIN; j++) {
+
+                    const Vector3 anchor(decimal(j) * CHAIN_LINK_LENGTH, decimal(30.0), decimal(c) * decimal(2.0));
+                    RigidBody* body = world->createRigidBody(Transform(anchor + Vector3(CHAIN_LINK_LENGTH * decimal(0.5), 0, 0), Quaternion::identity()));
+                    body->addCollider(mBoxShape, Transform::identity());
+                    bodies.push_back(body);
+                    chainsBodies.push_back(body);
+
+                    switch ((c + j) % 4) {
+                        case 0: world->createJoint(BallAndSocketJointInfo(previousBody, body, anchor)); break;
+                        case 1: world->createJoint(HingeJointInfo(previousBody, body, anchor, Vector3(0, 0, 1))); break;
+                        case 2: world->createJoint(SliderJointInfo(previousBody, body, anchor, Vector3(1, 0, 0), decimal(-0.1), decimal(0.1))); break;
+                        case 3: world->createJoint(FixedJointInfo(previousBody, body, anchor)); break;
+                    }
+
+                    previousBody = body;
+                }
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestParallelIslandSolver(const std::string& name) : Test(name) {
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            mFloorShape = mPhysicsCommon.createBoxShape(Vector3(60, 0.5, 60));
+        }
+
+        /// Run the tests
+        void run() {
+
+            testShuffledIslandBatches();
+        }
+
+        void testShuffledIslandBatches() {
+
+            // The two worlds use the same kind of task scheduler such that they only differ by the way the islands are solved
+            ShuffledTaskScheduler schedulerParallel(4);
+            ShuffledTaskScheduler schedulerSequential(4);
+
+            PhysicsWorld::WorldSettings settingsParallel;
+            settingsParallel.taskScheduler = &schedulerParallel;
+            PhysicsWorld::WorldSettings settingsSequential;
+            settingsSequential.taskScheduler = &schedulerSequential;
+            settingsSequential.isParallelIslandSolverEnabled = false;
+
+            PhysicsWorld* worldParallel = mPhysicsCommon.createPhysicsWorld(settingsParallel);
+            PhysicsWorld* worldSequential = mPhysicsCommon.createPhysicsWorld(settingsSequential);
+
+            std::vector<RigidBody*> bodiesParallel;
+            std::vector<RigidBody*> bodiesSequential;
+            std::vector<RigidBody*> chainsBodies;
+            std::vector<RigidBody*> chainsBodiesSequential;
+            createScene(worldParallel, bodiesParallel, chainsBodies);
+            createScene(worldSequential, bodiesSequential, chainsBodiesSequential);
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                worldParallel->update(decimal(1.0) / decimal(60.0));
+                worldSequential->update(decimal(1.0) / decimal(60.0));
+            }
+
+            // The only additional split parallel-for of the parallel world are the batches of islands (one per step)
+            const uint32 nbSplitParallelFors = schedulerParallel.getNbParallelFors(1, 2);
+            const uint32 nbSplitParallelForsSequential = schedulerSequential.getNbParallelFors(1, 2);
+            rp3d_test(nbSplitParallelFors == nbSplitParallelForsSequential + NB_STEPS);
+
+            // The islands solved in a shuffled order give the same results as the islands solved in order
+            bool isSame = true;
+            for (size_t i=0; i < bodiesParallel.size(); i++) {
+                isSame &= bodiesParallel[i]->getTransform() == bodiesSequential[i]->getTransform();
+            }
+            rp3d_test(isSame);
+
+            // The joints of the chains have been solved
+            const Vector3 supportPosition(0, 30, 0);
+            for (uint32 c=0; c < NB_CHAINS; c++) {
+                for (uint32 j=0; j < NB_BODIES_IN_CHAIN; j++) {
+                    const Vector3 position = chainsBodies[c * NB_BODIES_IN_CHAIN + j]->getTransform().getPosition();
+                    const Vector3 chainStart = supportPosition + Vector3(0, 0, decimal(c) * decimal(2.0));
+                    rp3d_test((position - chainStart).length() < decimal(j + 1) * CHAIN_LINK_LENGTH + decimal(0.2));
+                }
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(worldParallel);
+            mPhysicsCommon.destroyPhysicsWorld(worldSequential);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+
+#ifndef TEST_PARALLEL_WORLDS_H
+#define TEST_PARALLEL_WORLDS_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestParallelWorlds
+/**
+ * Unit test for the update of several physics worlds in parallel with the
+ * PhysicsCommon::updatePhysicsWorlds() method. Each world with its own memory manager
+ * must be updated by a task of the task scheduler of the PhysicsCommon object and the
+ * results must be the same as with the worlds updated one after the other.
+ */
+class TestParallelWorlds : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of simulation steps
+        static const uint32 NB_STEPS = 60;
+
+        /// Number of worlds
+        static const uint32 NB_WORLDS = 6;
+
+        // ---------- Methods ---------- //
+
+        /// Create a different pile of boxes in each world
+        void createPile(PhysicsCommon& physicsCommon, PhysicsWorld* world, uint32 worldIndex, std::vector<RigidBody*>& bodies) {
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -0.5, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(physicsCommon.createBoxShape(Vector3(20, 0.5, 20)), Transform::identity());
+
+            BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            for (uint32 i=0; i < 20 + 5 * worldIndex; i++) {
+                const Vector3 position(decimal(i % 4) * decimal(1.5), decimal(1 + i / 4) * decimal(1.1), decimal(worldIndex) * decimal(0.1));
+                RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.1) * (i % 3), 0)));
+                body->addCollider(boxShape, Transform::identity());
+                bodies.push_back(body);
+            }
+        }
+
+        /// Simulate the worlds one after the other and return the transforms of the bodies
+        std::vector<Transform> simulateSequentially() {
+
+            PhysicsCommon physicsCommon;
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = physicsCommon.createDefaultTaskScheduler(1);
+
+            std::vector<PhysicsWorld*> worlds;
+            std::vector<RigidBody*> bodies;
+            for (uint32 w=0; w < NB_WORLDS; w++) {
+                worlds.push_back(physicsCommon.createPhysicsWorld(settings));
+                createPile(physicsCommon, worlds[w], w, bodies);
+            }
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                for (PhysicsWorld* world : worlds) {
+                    world->update(decimal(1.0) / decimal(60.0));
+                }
+            }
+
+            std::vector<Transform> transforms;
+            for (RigidBody* body : bodies) {
+                transforms.push_back(body->getTransform());
+            }
+
+            return transforms;
+        }
+
+        /// Simulate the worlds in parallel with the task scheduler of the PhysicsCommon object and return the transforms of the bodies
+        std::vector<Transform> simulateInParallel(TaskScheduler* taskScheduler, ShuffledTaskScheduler* shuffledTaskScheduler) {
+
+            // The worlds use their own memory managers except the first one that shares the memory manager of the
+            // PhysicsCommon object and is updated on the calling thread. The worlds also use the task scheduler
+            // of the PhysicsCommon object
+            PhysicsCommon physicsCommon;
+            physicsCommon.setTaskScheduler(taskScheduler);
+            PhysicsWorld::WorldSettings settings;
+
+            std::vector<PhysicsWorld*> worlds;
+            std::vector<RigidBody*> bodies;
+            for (uint32 w=0; w < NB_WORLDS; w++) {
+                settings.hasOwnMemoryManager = w > 0;
+                worlds.push_back(physicsCommon.createPhysicsWorld(settings));
+                createPile(physicsCommon, worlds[w], w, bodies);
+            }
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+
+                if (shuffledTaskScheduler != nullptr) {
+                    shuffledTaskScheduler->clearParallelFors();
+                }
+
+                physicsCommon.updatePhysicsWorlds(worlds, decimal(1.0) / decimal(60.0));
+
+                if (shuffledTaskScheduler != nullptr) {
+
+                    // The last parallel-for submitted from the calling thread updates a world with its own memory
+                    // manager in each task and the parallel work of those worlds is executed by the same task
+                    const std::vector<ShuffledTaskScheduler::ParallelForInfo>& parallelFors = shuffledTaskScheduler->getParallelFors();
+                    size_t worldsParallelFor = parallelFors.size();
+                    for (size_t p=0; p < parallelFors.size(); p++) {
+                        if (!parallelFors[p].isNested) worldsParallelFor = p;
+                    }
+                    rp3d_test(worldsParallelFor < parallelFors.size());
+                    rp3d_test(parallelFors[worldsParallelFor].nbItems == NB_WORLDS - 1);
+                    rp3d_test(parallelFors[worldsParallelFor].chunkSize == 1);
+                    rp3d_test(parallelFors.size() - worldsParallelFor > NB_WORLDS);
+                }
+            }
+
+            std::vector<Transform> transforms;
+            for (RigidBody* body : bodies) {
+                transforms.push_back(body->getTransform());
+            }
+
+            return transforms;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestParallelWorlds(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testParallelWorlds();
+        }
+
+        void testParallelWorlds() {
+
+            const std::vector<Transform> transforms = simulateSequentially();
+
+            // The worlds are updated in a shuffled order by several simulated workers
+            ShuffledTaskScheduler shuffledScheduler(4);
+            rp3d_test(transforms == simulateInParallel(&shuffledScheduler, &shuffledScheduler));
+
+            // The worlds are updated by the threads of the default task scheduler
+            PhysicsCommon physicsCommon;
+            DefaultTaskScheduler* scheduler4 = physicsCommon.createDefaultTaskScheduler(4);
+            rp3d_test(transforms == simulateInParallel(scheduler4, nullptr));
+            physicsCommon.destroyDefaultTaskScheduler(scheduler4);
+
+            // The boxes have fallen
+            rp3d_test(transforms[0].getPosition().y < decimal(1.1));
+        }
+ };
+
+}
+
+#endif
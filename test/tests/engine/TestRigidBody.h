@@ -143,6 +143,7 @@ class TestRigidBody : public Test {
             testGettersSetters();
             testMassPropertiesMethods();
             testApplyForcesAndTorques();
+            testAsyncUpdate();
         }
 
         void testGettersSetters() {
@@ -308,6 +309,47 @@ class TestRigidBody : public Test {
             mRigidBody3->resetForce();
             mRigidBody3->resetTorque();
         }
+
+        void testAsyncUpdate() {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            const Transform initTransform(Vector3(0, 10, 0), Quaternion::identity());
+            RigidBody* body = world->createRigidBody(initTransform);
+            body->addCollider(mPhysicsCommon.createSphereShape(1), Transform::identity());
+
+            rp3d_test(Vector3::approxEqual(body->getTransformSnapshot().getPosition(), initTransform.getPosition()));
+
+            // Before the first asynchronous update, the snapshot is the current transform of the body
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(body->getTransform().getPosition().y < initTransform.getPosition().y);
+            rp3d_test(body->getTransformSnapshot() == body->getTransform());
+
+            for (int i=0; i < 10; i++) {
+
+                const Vector3 previousPosition = body->getTransform().getPosition();
+
+                PhysicsWorld::UpdateHandle handle = world->updateAsync(decimal(1.0 / 60.0));
+
+                // While the update is running, the snapshot contains the state of the previous step or
+                // (if the update is already finished) the new state but never a partially updated state
+                const Vector3 snapshotPosition = body->getTransformSnapshot().getPosition();
+
+                handle.wait();
+                rp3d_test(handle.isDone());
+
+                // The body falls and the snapshot contains its new transform
+                rp3d_test(body->getTransform().getPosition().y < previousPosition.y);
+                rp3d_test(Vector3::approxEqual(body->getTransformSnapshot().getPosition(), body->getTransform().getPosition()));
+                rp3d_test(snapshotPosition == previousPosition || snapshotPosition == body->getTransform().getPosition());
+            }
+
+            // A synchronous update also updates the snapshot
+            world->update(decimal(1.0 / 60.0));
+            rp3d_test(Vector3::approxEqual(body->getTransformSnapshot().getPosition(), body->getTransform().getPosition()));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
  };
 
 }
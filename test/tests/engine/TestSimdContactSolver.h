@@ -0,0 +1,193 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SIMD_CONTACT_SOLVER_H
+#define TEST_SIMD_CONTACT_SOLVER_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestSimdContactSolver
+/**
+ * Unit test for the SIMD contact solver. A large island is simulated with the SIMD
+ * contact solver and with the scalar contact solver and the transforms of the bodies
+ * must be the same. If the library is not compiled with the SIMD contact solver,
+ * both simulations use the scalar contact solver. Note that the library is compiled with
+ * -ffp-contract=off when the SIMD contact solver is enabled such that the scalar operations
+ * are not contracted into fused multiply-add instructions.
+ */
+class TestSimdContactSolver : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of simulation steps
+        static const uint32 NB_STEPS = 60;
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Simulate a large pile of boxes and return the transforms of the bodies
+        std::vector<Transform> simulate(bool isSimdContactSolverEnabled, uint32 nbWorkers) {
+
+            DefaultTaskScheduler* taskScheduler = mPhysicsCommon.createDefaultTaskScheduler(nbWorkers);
+
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = taskScheduler;
+            settings.isGraphColoringContactSolverEnabled = true;
+            settings.isSimdContactSolverEnabled = isSimdContactSolverEnabled;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mPhysicsCommon.createBoxShape(Vector3(40, 1, 40)), Transform::identity());
+
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            // Overlapping bodies so that all of them are in a single island
+            for (int y=0; y < 8; y++) {
+                for (int x=0; x < 8; x++) {
+                    for (int z=0; z < 8; z++) {
+
+                        const Transform transform(Vector3(x * decimal(0.98) - 4, decimal(0.5) + y * decimal(0.98), z * decimal(0.98) - 4),
+                                                  Quaternion::fromEulerAngles(decimal(0.02) * x, 0, decimal(0.03) * z));
+                        RigidBody* body = world->createRigidBody(transform);
+                        body->addCollider((x + y + z) % 5 == 0 ? static_cast<CollisionShape*>(sphereShape) : boxShape, Transform::identity());
+
+                        // Some bodies with a locked rotation
+                        if ((x + z) % 7 == 0) {
+                            body->setAngularLockAxisFactor(Vector3(0, 1, 0));
+                        }
+                    }
+                }
+            }
+
+            for (uint32 i=0; i < NB_STEPS; i++) {
+                world->update(decimal(1.0 / 60.0));
+            }
+
+            std::vector<Transform> transforms;
+            for (uint32 i=0; i < world->getNbRigidBodies(); i++) {
+                transforms.push_back(world->getRigidBody(i)->getTransform());
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyDefaultTaskScheduler(taskScheduler);
+
+            return transforms;
+        }
+
+        /// Return true if two arrays of transforms are approximately equal
+        bool areTransformsEqual(const std::vector<Transform>& transforms1, const std::vector<Transform>& transforms2) {
+
+            if (transforms1.size() != transforms2.size()) return false;
+
+            const decimal epsilon = decimal(0.001);
+            for (size_t i=0; i < transforms1.size(); i++) {
+
+                const Vector3& position1 = transforms1[i].getPosition();
+                const Vector3& position2 = transforms2[i].getPosition();
+                const Quaternion& orientation1 = transforms1[i].getOrientation();
+                const Quaternion& orientation2 = transforms2[i].getOrientation();
+
+                if (!approxEqual(position1.x, position2.x, epsilon) || !approxEqual(position1.y, position2.y, epsilon) ||
+                    !approxEqual(position1.z, position2.z, epsilon) || !approxEqual(orientation1.x, orientation2.x, epsilon) ||
+                    !approxEqual(orientation1.y, orientation2.y, epsilon) || !approxEqual(orientation1.z, orientation2.z, epsilon) ||
+                    !approxEqual(orientation1.w, orientation2.w, epsilon)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSimdContactSolver(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testSimdDecimal();
+            testSameResultsAsScalarSolver();
+        }
+
+        void testSimdDecimal() {
+
+            decimal values1[SimdDecimal::NB_LANES];
+            decimal values2[SimdDecimal::NB_LANES];
+            for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+                values1[i] = decimal(i) - decimal(1.5);
+                values2[i] = decimal(2.0) * decimal(i) + decimal(0.25);
+            }
+
+            const SimdDecimal pack1 = SimdDecimal::load(values1);
+            const SimdDecimal pack2 = SimdDecimal::load(values2);
+
+            decimal sum[SimdDecimal::NB_LANES];
+            decimal product[SimdDecimal::NB_LANES];
+            decimal difference[SimdDecimal::NB_LANES];
+            decimal clamped[SimdDecimal::NB_LANES];
+            (pack1 + pack2).store(sum);
+            (pack1 * pack2).store(product);
+            (-(pack1 - pack2)).store(difference);
+            max(SimdDecimal(decimal(-1.0)), min(pack1, SimdDecimal(decimal(1.0)))).store(clamped);
+
+            for (uint32 i=0; i < SimdDecimal::NB_LANES; i++) {
+                rp3d_test(sum[i] == values1[i] + values2[i]);
+                rp3d_test(product[i] == values1[i] * values2[i]);
+                rp3d_test(difference[i] == values2[i] - values1[i]);
+                rp3d_test(clamped[i] == std::max(decimal(-1.0), std::min(values1[i], decimal(1.0))));
+            }
+        }
+
+        void testSameResultsAsScalarSolver() {
+
+            const std::vector<Transform> scalarTransforms = simulate(false, 1);
+
+            rp3d_test(areTransformsEqual(scalarTransforms, simulate(true, 1)));
+            rp3d_test(areTransformsEqual(scalarTransforms, simulate(true, 4)));
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,266 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_TEMPORAL_COHERENCE_H
+#define TEST_TEMPORAL_COHERENCE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Event listener that keeps the contact points reported during the last update of the world
+class CoherenceEventListener : public EventListener {
+
+    public:
+
+        std::vector<ContactPointInfo> contactPoints;
+        uint32 nbContactPairs = 0;
+        uint32 nbExitContactPairs = 0;
+
+        void reset() {
+            contactPoints.clear();
+            nbContactPairs = 0;
+            nbExitContactPairs = 0;
+        }
+
+        virtual void onContact(const CollisionCallback::CallbackData& callbackData) override {
+
+            for (uint32 p=0; p < callbackData.getNbContactPairs(); p++) {
+
+                const CollisionCallback::ContactPair contactPair = callbackData.getContactPair(p);
+                if (contactPair.getEventType() == CollisionCallback::ContactPair::EventType::ContactExit) {
+                    nbExitContactPairs++;
+                    continue;
+                }
+
+                nbContactPairs++;
+                for (uint32 c=0; c < contactPair.getNbContactPoints(); c++) {
+                    const CollisionCallback::ContactPoint contactPoint = contactPair.getContactPoint(c);
+                    contactPoints.push_back(ContactPointInfo{contactPoint.getWorldNormal(), contactPoint.getLocalPointOnCollider1(),
+                                                             contactPoint.getLocalPointOnCollider2(), contactPoint.getPenetrationDepth()});
+                }
+            }
+        }
+};
+
+// Class TestTemporalCoherence
+/**
+ * Unit test for the narrow-phase temporal coherence of the physics world. The contact points
+ * of the resting pairs must be reused and the pairs that have moved or whose collision shape
+ * has changed must be tested again.
+ */
+class TestTemporalCoherence : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Time step of the simulation
+        static constexpr decimal TIME_STEP = decimal(1.0 / 60.0);
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Create a world with a static floor (the top of the floor is at y=0)
+        PhysicsWorld* createWorld(bool isTemporalCoherenceEnabled) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isSleepingEnabled = false;
+            settings.isNarrowPhaseTemporalCoherenceEnabled = isTemporalCoherenceEnabled;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            floor->setType(BodyType::STATIC);
+            floor->addCollider(mPhysicsCommon.createBoxShape(Vector3(20, 1, 20)), Transform::identity());
+
+            return world;
+        }
+
+        /// Create a stack of boxes on the floor and return the top box
+        RigidBody* createStack(PhysicsWorld* world, BoxShape* boxShape, int nbBoxes) {
+
+            RigidBody* body = nullptr;
+            for (int i=0; i < nbBoxes; i++) {
+                body = world->createRigidBody(Transform(Vector3(0, decimal(0.5) + i * decimal(1.0), 0), Quaternion::identity()));
+                body->addCollider(boxShape, Transform::identity());
+            }
+
+            return body;
+        }
+
+        /// Simulate a number of steps
+        void simulate(PhysicsWorld* world, int nbSteps) {
+            for (int s=0; s < nbSteps; s++) {
+                world->update(TIME_STEP);
+            }
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestTemporalCoherence(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testRestingContactsAreReused();
+            testMovedBodyIsTestedAgain();
+            testChangedShapeIsTestedAgain();
+            testStackIsStable();
+        }
+
+        /// Test that the contact points of a resting box are reused from one frame to the next
+        void testRestingContactsAreReused() {
+
+            PhysicsWorld* world = createWorld(true);
+            CoherenceEventListener listener;
+            world->setEventListener(&listener);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            createStack(world, boxShape, 1);
+
+            simulate(world, 120);
+
+            listener.reset();
+            world->update(TIME_STEP);
+            const std::vector<ContactPointInfo> previousContactPoints = listener.contactPoints;
+
+            listener.reset();
+            world->update(TIME_STEP);
+
+            rp3d_test(listener.nbContactPairs == 1);
+            rp3d_test(listener.contactPoints.size() == 4);
+            rp3d_test(listener.contactPoints.size() == previousContactPoints.size());
+
+            // The local contact points of the reused contacts are identical
+            for (uint32 i=0; i < listener.contactPoints.size() && i < previousContactPoints.size(); i++) {
+                rp3d_test(listener.contactPoints[i].localPoint1 == previousContactPoints[i].localPoint1);
+                rp3d_test(listener.contactPoints[i].localPoint2 == previousContactPoints[i].localPoint2);
+                rp3d_test(listener.contactPoints[i].penetrationDepth > decimal(0.0));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        /// Test that the contact points of a box that is moved away are not reused
+        void testMovedBodyIsTestedAgain() {
+
+            PhysicsWorld* world = createWorld(true);
+            CoherenceEventListener listener;
+            world->setEventListener(&listener);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            RigidBody* box = createStack(world, boxShape, 1);
+
+            simulate(world, 120);
+
+            // Move the box a little bit above the floor (less than its broad-phase AABB margin)
+            box->setTransform(Transform(box->getTransform().getPosition() + Vector3(0, decimal(0.05), 0), box->getTransform().getOrientation()));
+
+            listener.reset();
+            world->update(TIME_STEP);
+
+            rp3d_test(listener.nbContactPairs == 0);
+            rp3d_test(listener.nbExitContactPairs == 1);
+
+            // Move the box far away from the floor
+            simulate(world, 120);
+            box->setTransform(Transform(Vector3(0, 10, 0), Quaternion::identity()));
+
+            listener.reset();
+            world->update(TIME_STEP);
+
+            rp3d_test(listener.nbContactPairs == 0);
+            rp3d_test(listener.nbExitContactPairs == 1);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        /// Test that the contact points are computed again when the size of a collision shape changes
+        void testChangedShapeIsTestedAgain() {
+
+            PhysicsWorld* world = createWorld(true);
+            CoherenceEventListener listener;
+            world->setEventListener(&listener);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            createStack(world, boxShape, 1);
+
+            simulate(world, 120);
+
+            // Increase the size of the box such that it penetrates the floor
+            boxShape->setHalfExtents(Vector3(decimal(0.5), decimal(0.6), decimal(0.5)));
+
+            listener.reset();
+            world->update(TIME_STEP);
+
+            rp3d_test(listener.nbContactPairs == 1);
+            decimal maxPenetrationDepth = 0;
+            for (uint32 i=0; i < listener.contactPoints.size(); i++) {
+                maxPenetrationDepth = std::max(maxPenetrationDepth, listener.contactPoints[i].penetrationDepth);
+            }
+            rp3d_test(maxPenetrationDepth > decimal(0.05));
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+
+        /// Test that a stack of boxes stays upright with the temporal coherence as without it
+        /// (the resting stack is chaotic and therefore the two simulations are not compared exactly)
+        void testStackIsStable() {
+
+            PhysicsWorld* coherenceWorld = createWorld(true);
+            PhysicsWorld* world = createWorld(false);
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            RigidBody* coherenceTopBox = createStack(coherenceWorld, boxShape, 4);
+            RigidBody* topBox = createStack(world, boxShape, 4);
+
+            simulate(coherenceWorld, 600);
+            simulate(world, 600);
+
+            const Vector3 coherencePosition = coherenceTopBox->getTransform().getPosition();
+            const Vector3 position = topBox->getTransform().getPosition();
+            rp3d_test(std::abs(coherencePosition.y - decimal(3.5)) < decimal(0.05));
+            rp3d_test(std::abs(coherencePosition.y - position.y) < decimal(0.01));
+            rp3d_test(Vector3(coherencePosition.x, 0, coherencePosition.z).length() < decimal(0.1));
+
+            mPhysicsCommon.destroyPhysicsWorld(coherenceWorld);
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,262 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SIMD_VECTOR_H
+#define TEST_SIMD_VECTOR_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/mathematics/mathematics.h>
+#include <reactphysics3d/mathematics/SimdVector.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestSimdVector
+/**
+ * Unit test for the SimdVector class and for the operations of the mathematics classes
+ * that use it when the library is compiled with the RP3D_SIMD_ENABLED option. The results
+ * are compared with the scalar formulas within the documented tolerance.
+ */
+class TestSimdVector : public Test {
+
+    private :
+
+        // ---------- Constants ---------- //
+
+        /// Number of random inputs for each operation
+        static const int NB_INPUTS = 200;
+
+        // ---------- Atributes ---------- //
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1u << 24);
+        }
+
+        /// Return a random vector
+        Vector3 randomVector() {
+            return Vector3(random(-10, 10), random(-10, 10), random(-10, 10));
+        }
+
+        /// Return a random unit quaternion
+        Quaternion randomQuaternion() {
+            Quaternion quaternion(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+            quaternion.normalize();
+            return quaternion;
+        }
+
+        /// Return true if two values are equal within the tolerance of the SIMD operations
+        bool isEqual(decimal value1, decimal value2) {
+            const decimal tolerance = sizeof(decimal) == sizeof(float) ? decimal(1e-5) : decimal(1e-12);
+            return std::abs(value1 - value2) <= tolerance * std::max(decimal(1.0), std::max(std::abs(value1), std::abs(value2)));
+        }
+
+        bool isEqual(const Vector3& vector1, const Vector3& vector2) {
+            return isEqual(vector1.x, vector2.x) && isEqual(vector1.y, vector2.y) && isEqual(vector1.z, vector2.z);
+        }
+
+        bool isEqual(const Quaternion& quaternion1, const Quaternion& quaternion2) {
+            return isEqual(quaternion1.x, quaternion2.x) && isEqual(quaternion1.y, quaternion2.y) &&
+                   isEqual(quaternion1.z, quaternion2.z) && isEqual(quaternion1.w, quaternion2.w);
+        }
+
+        bool isEqual(const Matrix3x3& matrix1, const Matrix3x3& matrix2) {
+            return isEqual(matrix1[0], matrix2[0]) && isEqual(matrix1[1], matrix2[1]) && isEqual(matrix1[2], matrix2[2]);
+        }
+
+        /// Scalar cross product
+        Vector3 cross(const Vector3& v1, const Vector3& v2) {
+            return Vector3(v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x);
+        }
+
+        /// Scalar product of two quaternions
+        Quaternion product(const Quaternion& q1, const Quaternion& q2) {
+            return Quaternion(q1.w * q2.x + q2.w * q1.x + q1.y * q2.z - q1.z * q2.y,
+                              q1.w * q2.y + q2.w * q1.y + q1.z * q2.x - q1.x * q2.z,
+                              q1.w * q2.z + q2.w * q1.z + q1.x * q2.y - q1.y * q2.x,
+                              q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z);
+        }
+
+        /// Scalar rotation of a vector by a unit quaternion
+        Vector3 rotate(const Quaternion& q, const Vector3& v) {
+            const Quaternion rotated = product(product(q, Quaternion(v.x, v.y, v.z, 0)), Quaternion(-q.x, -q.y, -q.z, q.w));
+            return Vector3(rotated.x, rotated.y, rotated.z);
+        }
+
+        /// Return a SIMD vector with the components of a 3D vector
+        SimdVector toSimd(const Vector3& vector) {
+            return SimdVector(vector.x, vector.y, vector.z, 0);
+        }
+
+        /// Return a 3D vector with the lanes x, y and z of a SIMD vector
+        Vector3 toVector3(const SimdVector& vector) {
+            decimal values[4];
+            vector.store(values);
+            return Vector3(values[0], values[1], values[2]);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSimdVector(const std::string& name) : Test(name), mRandomState(12345) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testLanes();
+            testVectorOperations();
+            testQuaternionOperations();
+            testMatrixOperations();
+            testTransformOperations();
+        }
+
+        /// Test the lanes, the shuffles and the arithmetic operations
+        void testLanes() {
+
+            const decimal values1[4] = {decimal(1.5), decimal(-2.0), decimal(3.25), decimal(4.0)};
+            const decimal values2[4] = {decimal(-0.5), decimal(6.0), decimal(2.0), decimal(-1.0)};
+            const SimdVector vector1 = SimdVector::load(values1);
+            const SimdVector vector2(values2[0], values2[1], values2[2], values2[3]);
+
+            decimal sum[4], difference[4], product[4], shuffled[4], splat[4];
+            (vector1 + vector2).store(sum);
+            (vector1 - vector2).store(difference);
+            (vector1 * vector2).store(product);
+            vector1.shuffle<3, 0, 2, 1>().store(shuffled);
+            SimdVector(decimal(7.0)).store(splat);
+
+            for (int i=0; i < 4; i++) {
+                rp3d_test(sum[i] == values1[i] + values2[i]);
+                rp3d_test(difference[i] == values1[i] - values2[i]);
+                rp3d_test(product[i] == values1[i] * values2[i]);
+                rp3d_test(splat[i] == decimal(7.0));
+            }
+            rp3d_test(shuffled[0] == values1[3]);
+            rp3d_test(shuffled[1] == values1[0]);
+            rp3d_test(shuffled[2] == values1[2]);
+            rp3d_test(shuffled[3] == values1[1]);
+            rp3d_test(vector1.getX() == values1[0]);
+        }
+
+        /// Test the dot and cross products
+        void testVectorOperations() {
+
+            for (int i=0; i < NB_INPUTS; i++) {
+
+                const Vector3 v1 = randomVector();
+                const Vector3 v2 = randomVector();
+                const decimal dot = v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+
+                rp3d_test(isEqual(SimdVector::dot(toSimd(v1), toSimd(v2)), dot));
+                rp3d_test(isEqual(toVector3(SimdVector::cross(toSimd(v1), toSimd(v2))), cross(v1, v2)));
+                rp3d_test(isEqual(v1.dot(v2), dot));
+                rp3d_test(isEqual(v1.cross(v2), cross(v1, v2)));
+            }
+        }
+
+        /// Test the product of quaternions and the rotation of vectors
+        void testQuaternionOperations() {
+
+            for (int i=0; i < NB_INPUTS; i++) {
+
+                const Quaternion q1 = randomQuaternion();
+                const Quaternion q2 = randomQuaternion();
+                const Vector3 v = randomVector();
+
+                rp3d_test(isEqual(q1 * q2, product(q1, q2)));
+                rp3d_test(isEqual(q1 * v, rotate(q1, v)));
+
+                decimal values[4];
+                SimdVector::quaternionProduct(SimdVector(q1.x, q1.y, q1.z, q1.w), SimdVector(q2.x, q2.y, q2.z, q2.w)).store(values);
+                rp3d_test(isEqual(Quaternion(values[0], values[1], values[2], values[3]), product(q1, q2)));
+
+                const Vector3 translation = randomVector();
+                const Vector3 transformed = toVector3(SimdVector::transform(SimdVector(q1.x, q1.y, q1.z, q1.w), toSimd(translation), toSimd(v)));
+                rp3d_test(isEqual(transformed, translation + rotate(q1, v)));
+            }
+        }
+
+        /// Test the product and the inverse of matrices
+        void testMatrixOperations() {
+
+            for (int i=0; i < NB_INPUTS; i++) {
+
+                const Matrix3x3 m1(random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5),
+                                   random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5));
+                const Matrix3x3 m2(random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5),
+                                   random(-5, 5), random(-5, 5), random(-5, 5), random(-5, 5));
+
+                Matrix3x3 product;
+                for (int r=0; r < 3; r++) {
+                    for (int c=0; c < 3; c++) {
+                        product[r][c] = m1[r][0] * m2[0][c] + m1[r][1] * m2[1][c] + m1[r][2] * m2[2][c];
+                    }
+                }
+                rp3d_test(isEqual(m1 * m2, product));
+
+                // The inverse is only tested for well-conditioned matrices
+                const decimal determinant = m1.getDeterminant();
+                if (std::abs(determinant) < decimal(1.0)) continue;
+
+                const decimal invDeterminant = decimal(1.0) / determinant;
+                const Vector3 column0 = cross(m1[1], m1[2]) * invDeterminant;
+                const Vector3 column1 = cross(m1[2], m1[0]) * invDeterminant;
+                const Vector3 column2 = cross(m1[0], m1[1]) * invDeterminant;
+                const Matrix3x3 inverse(column0.x, column1.x, column2.x, column0.y, column1.y, column2.y,
+                                        column0.z, column1.z, column2.z);
+                rp3d_test(isEqual(m1.getInverse(), inverse));
+            }
+        }
+
+        /// Test the composition of transforms and the transformation of points
+        void testTransformOperations() {
+
+            for (int i=0; i < NB_INPUTS; i++) {
+
+                const Transform transform1(randomVector(), randomQuaternion());
+                const Transform transform2(randomVector(), randomQuaternion());
+                const Vector3 point = randomVector();
+
+                const Transform composition = transform1 * transform2;
+                rp3d_test(isEqual(composition.getPosition(), transform1.getPosition() + rotate(transform1.getOrientation(), transform2.getPosition())));
+                rp3d_test(isEqual(composition.getOrientation(), product(transform1.getOrientation(), transform2.getOrientation())));
+                rp3d_test(isEqual(transform1 * point, rotate(transform1.getOrientation(), point) + transform1.getPosition()));
+            }
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_CONCURRENT_POOL_ALLOCATOR_H
+#define TEST_CONCURRENT_POOL_ALLOCATOR_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/memory/ConcurrentPoolAllocator.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestConcurrentPoolAllocator
+/**
+ * Unit test for the ConcurrentPoolAllocator class
+ */
+class TestConcurrentPoolAllocator : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        // ---------- Methods ---------- //
+
+        /// Allocate objects of different sizes, fill them with a pattern and check that
+        /// no object has been overwritten by another one before they are released
+        static bool allocateAndCheck(ConcurrentPoolAllocator& allocator, uint32 nbObjects, uint8 pattern) {
+
+            std::vector<uint8*> objects(nbObjects);
+            bool isValid = true;
+
+            for (uint32 i=0; i < nbObjects; i++) {
+                const size_t size = 1 + (i * 37) % 1200;
+                objects[i] = static_cast<uint8*>(allocator.allocate(size));
+                isValid &= reinterpret_cast<uintptr_t>(objects[i]) % GLOBAL_ALIGNMENT == 0;
+                std::memset(objects[i], pattern, size);
+            }
+
+            for (uint32 i=0; i < nbObjects; i++) {
+                const size_t size = 1 + (i * 37) % 1200;
+                for (size_t j=0; j < size; j++) {
+                    isValid &= objects[i][j] == pattern;
+                }
+                allocator.release(objects[i], size);
+            }
+
+            return isValid;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestConcurrentPoolAllocator(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testAllocateRelease();
+            testConcurrentAllocateRelease();
+        }
+
+        void testAllocateRelease() {
+
+            ConcurrentPoolAllocator allocator(mAllocator);
+
+            rp3d_test(allocateAndCheck(allocator, 5000, 0xAB));
+
+            // The released memory units must be reused
+            void* object1 = allocator.allocate(64);
+            allocator.release(object1, 64);
+            void* object2 = allocator.allocate(64);
+            rp3d_test(object1 == object2);
+            allocator.release(object2, 64);
+        }
+
+        void testConcurrentAllocateRelease() {
+
+            ConcurrentPoolAllocator allocator(mAllocator);
+
+            const uint32 nbThreads = 8;
+            bool results[nbThreads];
+
+            std::vector<std::thread> threads;
+            for (uint32 t=0; t < nbThreads; t++) {
+                threads.emplace_back([&allocator, &results, t]() {
+                    results[t] = true;
+                    for (uint32 i=0; i < 20; i++) {
+                        results[t] &= allocateAndCheck(allocator, 500, uint8(t + 1));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            for (uint32 t=0; t < nbThreads; t++) {
+                rp3d_test(results[t]);
+            }
+
+            // Memory allocated by a thread can be released by another thread
+            std::vector<void*> objects(1000);
+            std::thread allocatingThread([&allocator, &objects]() {
+                for (uint32 i=0; i < objects.size(); i++) {
+                    objects[i] = allocator.allocate(48);
+                }
+            });
+            allocatingThread.join();
+
+            std::thread releasingThread([&allocator, &objects]() {
+                for (uint32 i=0; i < objects.size(); i++) {
+                    allocator.release(objects[i], 48);
+                }
+            });
+            releasingThread.join();
+
+            rp3d_test(allocateAndCheck(allocator, 2000, 0x5C));
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SINGLE_FRAME_ALLOCATOR_H
+#define TEST_SINGLE_FRAME_ALLOCATOR_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/memory/SingleFrameAllocator.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestSingleFrameAllocator
+/**
+ * Unit test for the SingleFrameAllocator class
+ */
+class TestSingleFrameAllocator : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        // ---------- Methods ---------- //
+
+        /// Allocate a given number of bytes in blocks of 256 bytes, release them and reset the allocator
+        static void simulateFrame(SingleFrameAllocator& allocator, size_t nbBytes) {
+
+            std::vector<void*> blocks;
+            for (size_t i=0; i < nbBytes / 256; i++) {
+                blocks.push_back(allocator.allocate(256));
+            }
+            for (void* block : blocks) {
+                allocator.release(block, 256);
+            }
+
+            allocator.reset();
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSingleFrameAllocator(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testAdaptiveSize();
+        }
+
+        void testAdaptiveSize() {
+
+            const size_t initSize = 4096;
+            SingleFrameAllocator allocator(mAllocator, false, initSize);
+            rp3d_test(allocator.getTotalSizeBytes() == initSize);
+
+            // A frame that fits in the block does not change its size
+            simulateFrame(allocator, 2048);
+            rp3d_test(allocator.getTotalSizeBytes() == initSize);
+
+            // After a frame that does not fit, the block is large enough for the whole frame
+            simulateFrame(allocator, 40000);
+            rp3d_test(allocator.getTotalSizeBytes() >= 40000);
+            const size_t grownSize = allocator.getTotalSizeBytes();
+
+            // The next identical frame fits in the block
+            simulateFrame(allocator, 40000);
+            rp3d_test(allocator.getTotalSizeBytes() == grownSize);
+
+            // The block is only shrunk after many frames that use a small part of it
+            simulateFrame(allocator, 1024);
+            rp3d_test(allocator.getTotalSizeBytes() == grownSize);
+            for (int i=0; i < 1000; i++) {
+                simulateFrame(allocator, 1024);
+            }
+            rp3d_test(allocator.getTotalSizeBytes() < grownSize);
+            rp3d_test(allocator.getTotalSizeBytes() >= initSize);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef SHUFFLED_TASK_SCHEDULER_H
+#define SHUFFLED_TASK_SCHEDULER_H
+
+// Libraries
+#include <reactphysics3d/utils/TaskScheduler.h>
+#include <vector>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class ShuffledTaskScheduler
+/**
+ * Task scheduler used by the unit tests. It executes the chunks of a parallel-for on the
+ * calling thread but in a shuffled order and with a different worker index for consecutive
+ * chunks (as if several workers had stolen them). The parallel stages of the library must
+ * give the same results as with the chunks executed in order. The scheduler also records the
+ * parallel-for it has executed so that a test can check that a stage has been split into chunks.
+ */
+class ShuffledTaskScheduler : public TaskScheduler {
+
+    public:
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure ParallelForInfo
+        /**
+         * Parameters of an executed parallel-for
+         */
+        struct ParallelForInfo {
+
+            /// Number of items of the parallel-for
+            uint32 nbItems;
+
+            /// Maximum number of items in a chunk
+            uint32 chunkSize;
+
+            /// True if the parallel-for has been submitted from inside a task
+            bool isNested;
+        };
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Number of (simulated) workers
+        uint32 mNbWorkers;
+
+        /// State of the pseudo-random generator used to shuffle the chunks
+        uint32 mRandomState;
+
+        /// True while a chunk is executed
+        bool mIsInTask;
+
+        /// Worker index of the chunk that is executed
+        uint32 mCurrentWorkerIndex;
+
+        /// Executed parallel-for
+        std::vector<ParallelForInfo> mParallelFors;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the next pseudo-random number
+        uint32 nextRandom() {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return mRandomState >> 8;
+        }
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ShuffledTaskScheduler(uint32 nbWorkers, uint32 seed = 1)
+            : mNbWorkers(nbWorkers), mRandomState(seed), mIsInTask(false), mCurrentWorkerIndex(0) {
+            assert(nbWorkers > 0);
+        }
+
+        /// Return the number of workers
+        virtual uint32 getNbWorkers() const override {
+            return mNbWorkers;
+        }
+
+        /// Execute the chunks of a parallel-for in a shuffled order
+        virtual void parallelFor(uint32 nbItems, uint32 chunkSize, const ParallelForFunction& function) override {
+
+            const bool isNested = mIsInTask;
+            mParallelFors.push_back(ParallelForInfo{nbItems, chunkSize, isNested});
+
+            const uint32 nbChunks = computeNbChunks(nbItems, chunkSize);
+
+            std::vector<uint32> chunks(nbChunks);
+            for (uint32 c=0; c < nbChunks; c++) {
+                chunks[c] = c;
+            }
+            for (uint32 c=nbChunks; c > 1; c--) {
+                std::swap(chunks[c - 1], chunks[nextRandom() % c]);
+            }
+
+            const uint32 parentWorkerIndex = mCurrentWorkerIndex;
+
+            for (uint32 i=0; i < nbChunks; i++) {
+
+                const uint32 c = chunks[i];
+
+                // A nested parallel-for is executed by the current worker
+                mCurrentWorkerIndex = isNested ? parentWorkerIndex : i % mNbWorkers;
+                mIsInTask = true;
+
+                function(TaskRange{c, c * chunkSize, std::min((c + 1) * chunkSize, nbItems), mCurrentWorkerIndex});
+            }
+
+            mCurrentWorkerIndex = parentWorkerIndex;
+            mIsInTask = isNested;
+        }
+
+        /// Return the executed parallel-for
+        const std::vector<ParallelForInfo>& getParallelFors() const {
+            return mParallelFors;
+        }
+
+        /// Return the number of executed parallel-for with a given chunk size and at least a given number of chunks
+        uint32 getNbParallelFors(uint32 chunkSize, uint32 minNbChunks) const {
+
+            uint32 nbParallelFors = 0;
+            for (const ParallelForInfo& info : mParallelFors) {
+                if (info.chunkSize == chunkSize && computeNbChunks(info.nbItems, info.chunkSize) >= minNbChunks) {
+                    nbParallelFors++;
+                }
+            }
+
+            return nbParallelFors;
+        }
+
+        /// Forget the executed parallel-for
+        void clearParallelFors() {
+            mParallelFors.clear();
+        }
+};
+
+}
+
+#endif
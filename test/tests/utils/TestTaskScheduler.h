@@ -0,0 +1,280 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_TASK_SCHEDULER_H
+#define TEST_TASK_SCHEDULER_H
+
+// Libraries
+#include "Test.h"
+#include "tests/utils/ShuffledTaskScheduler.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <atomic>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Logger that counts the reported errors
+class ErrorsCountLogger : public Logger {
+
+    public:
+
+        uint32 nbErrors = 0;
+
+        virtual void log(Level level, const std::string& /*physicsWorldName*/, Category /*category*/, const std::string& /*message*/,
+                         const char* /*filename*/, int /*lineNumber*/) override {
+            if (level == Level::Error) nbErrors++;
+        }
+};
+
+// Class TestTaskScheduler
+/**
+ * Unit test for the DefaultTaskScheduler class
+ */
+class TestTaskScheduler : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestTaskScheduler(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testParallelFor(1);
+            testParallelFor(2);
+            testParallelFor(4);
+            testNestedParallelFor();
+            testWorldTaskScheduler();
+            testDefaultTaskScheduler();
+        }
+
+        void testParallelFor(uint32 nbWorkers) {
+
+            DefaultTaskScheduler* scheduler = mPhysicsCommon.createDefaultTaskScheduler(nbWorkers);
+            rp3d_test(scheduler->getNbWorkers() == nbWorkers);
+
+            rp3d_test(TaskScheduler::computeNbChunks(0, 10) == 0);
+            rp3d_test(TaskScheduler::computeNbChunks(10, 10) == 1);
+            rp3d_test(TaskScheduler::computeNbChunks(11, 10) == 2);
+
+            const uint32 nbItems = 1000;
+            const uint32 chunkSize = 7;
+            const uint32 nbChunks = TaskScheduler::computeNbChunks(nbItems, chunkSize);
+
+            std::atomic<uint32> nbCallsPerItem[nbItems];
+            for (uint32 i=0; i < nbItems; i++) {
+                nbCallsPerItem[i] = 0;
+            }
+            std::atomic<uint32> nbChunksCalls(0);
+            std::atomic<bool> isRangeValid(true);
+
+            // Each item must be processed exactly once
+            scheduler->parallelFor(nbItems, chunkSize, [&](const TaskScheduler::TaskRange& range) {
+
+                if (range.startIndex != range.chunkIndex * chunkSize || range.endIndex > nbItems ||
+                    range.startIndex >= range.endIndex || range.workerIndex >= nbWorkers) {
+                    isRangeValid = false;
+                }
+
+                for (uint32 i=range.startIndex; i < range.endIndex; i++) {
+                    nbCallsPerItem[i]++;
+                }
+
+                nbChunksCalls++;
+            });
+
+            rp3d_test(isRangeValid);
+            rp3d_test(nbChunksCalls == nbChunks);
+            for (uint32 i=0; i < nbItems; i++) {
+                rp3d_test(nbCallsPerItem[i] == 1);
+            }
+
+            // Nothing to do for an empty range
+            bool isCalled = false;
+            scheduler->parallelFor(0, chunkSize, [&](const TaskScheduler::TaskRange& /*range*/) {
+                isCalled = true;
+            });
+            rp3d_test(!isCalled);
+
+            // With a single worker, the chunks are processed in order
+            if (nbWorkers == 1) {
+
+                uint32 nextChunkIndex = 0;
+                bool isInOrder = true;
+                scheduler->parallelFor(nbItems, chunkSize, [&](const TaskScheduler::TaskRange& range) {
+                    isInOrder &= range.chunkIndex == nextChunkIndex;
+                    nextChunkIndex++;
+                });
+                rp3d_test(isInOrder);
+            }
+
+            // The scheduler can be reused for many parallel-for
+            std::atomic<uint32> sum(0);
+            for (uint32 j=0; j < 100; j++) {
+                scheduler->parallelFor(64, 1, [&](const TaskScheduler::TaskRange& range) {
+                    sum += range.startIndex;
+                });
+            }
+            rp3d_test(sum == 100 * (63 * 64 / 2));
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler);
+        }
+
+        void testNestedParallelFor() {
+
+            DefaultTaskScheduler* scheduler = mPhysicsCommon.createDefaultTaskScheduler(3);
+
+            std::atomic<uint32> nbCalls(0);
+            std::atomic<bool> isWorkerValid(true);
+
+            scheduler->parallelFor(10, 1, [&](const TaskScheduler::TaskRange& outerRange) {
+
+                // A nested parallel-for is executed by the current worker
+                scheduler->parallelFor(10, 3, [&](const TaskScheduler::TaskRange& innerRange) {
+
+                    if (innerRange.workerIndex != outerRange.workerIndex) {
+                        isWorkerValid = false;
+                    }
+
+                    nbCalls += innerRange.endIndex - innerRange.startIndex;
+                });
+            });
+
+            rp3d_test(isWorkerValid);
+            rp3d_test(nbCalls == 100);
+
+            mPhysicsCommon.destroyDefaultTaskScheduler(scheduler);
+        }
+
+        void testWorldTaskScheduler() {
+
+            ShuffledTaskScheduler worldScheduler(3);
+            ShuffledTaskScheduler commonScheduler(2);
+            DefaultTaskScheduler* referenceScheduler = mPhysicsCommon.createDefaultTaskScheduler(1);
+
+            // The first world uses the task scheduler of its settings, the second one uses the task scheduler
+            // of the PhysicsCommon object and the reference world executes the chunks in order
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = &worldScheduler;
+            PhysicsWorld::WorldSettings referenceSettings;
+            referenceSettings.taskScheduler = referenceScheduler;
+
+            TaskScheduler* previousCommonScheduler = mPhysicsCommon.getTaskScheduler();
+            mPhysicsCommon.setTaskScheduler(&commonScheduler);
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+            PhysicsWorld* commonWorld = mPhysicsCommon.createPhysicsWorld();
+            PhysicsWorld* referenceWorld = mPhysicsCommon.createPhysicsWorld(referenceSettings);
+
+            mPhysicsCommon.setTaskScheduler(previousCommonScheduler);
+
+            // Enough boxes to split the loops over the bodies into several chunks
+            const uint32 nbBodies = PARALLEL_FOR_CHUNK_SIZE + 50;
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(0.5, 0.5, 0.5));
+            std::vector<RigidBody*> bodies;
+            std::vector<RigidBody*> referenceBodies;
+            for (PhysicsWorld* w : {world, commonWorld, referenceWorld}) {
+                for (uint32 i=0; i < nbBodies; i++) {
+                    const Vector3 position(decimal(i % 20) * decimal(1.2), decimal(i / 20) * decimal(1.2), 0);
+                    RigidBody* body = w->createRigidBody(Transform(position, Quaternion::identity()));
+                    body->addCollider(boxShape, Transform::identity());
+                    if (w == world) bodies.push_back(body);
+                    if (w == referenceWorld) referenceBodies.push_back(body);
+                }
+            }
+
+            world->update(decimal(1.0) / decimal(60.0));
+            commonWorld->update(decimal(1.0) / decimal(60.0));
+            referenceWorld->update(decimal(1.0) / decimal(60.0));
+
+            // Each world has submitted its loops over the bodies to its own task scheduler
+            rp3d_test(worldScheduler.getNbParallelFors(PARALLEL_FOR_CHUNK_SIZE, 2) > 0);
+            rp3d_test(commonScheduler.getNbParallelFors(PARALLEL_FOR_CHUNK_SIZE, 2) > 0);
+            rp3d_test(worldScheduler.getParallelFors().size() == commonScheduler.getParallelFors().size());
+
+            // The chunks executed out of order by several workers give the same results
+            bool isSame = true;
+            for (size_t i=0; i < bodies.size(); i++) {
+                isSame &= bodies[i]->getTransform() == referenceBodies[i]->getTransform();
+            }
+            rp3d_test(isSame);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyPhysicsWorld(commonWorld);
+            mPhysicsCommon.destroyPhysicsWorld(referenceWorld);
+            mPhysicsCommon.destroyBoxShape(boxShape);
+            mPhysicsCommon.destroyDefaultTaskScheduler(referenceScheduler);
+        }
+
+        void testDefaultTaskScheduler() {
+
+            // A world created without a task scheduler is updated with a single worker
+            PhysicsCommon physicsCommon;
+            rp3d_test(physicsCommon.getTaskScheduler() == nullptr);
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+            world->createRigidBody(Transform::identity());
+            rp3d_test(physicsCommon.getTaskScheduler() != nullptr);
+            rp3d_test(physicsCommon.getTaskScheduler()->getNbWorkers() == 1);
+
+            // A task scheduler used by a world cannot be destroyed
+            ErrorsCountLogger logger;
+            Logger* previousLogger = PhysicsCommon::getLogger();
+            PhysicsCommon::setLogger(&logger);
+
+            DefaultTaskScheduler* scheduler = physicsCommon.createDefaultTaskScheduler(2);
+            PhysicsWorld::WorldSettings settings;
+            settings.taskScheduler = scheduler;
+            PhysicsWorld* schedulerWorld = physicsCommon.createPhysicsWorld(settings);
+            schedulerWorld->createRigidBody(Transform::identity());
+
+            physicsCommon.destroyDefaultTaskScheduler(scheduler);
+            rp3d_test(logger.nbErrors == 1);
+            rp3d_test(scheduler->getNbWorkers() == 2);
+            schedulerWorld->update(decimal(1.0) / decimal(60.0));
+
+            physicsCommon.destroyPhysicsWorld(schedulerWorld);
+            physicsCommon.destroyDefaultTaskScheduler(scheduler);
+            rp3d_test(logger.nbErrors == 1);
+
+            PhysicsCommon::setLogger(previousLogger);
+
+            physicsCommon.destroyPhysicsWorld(world);
+        }
+};
+
+}
+
+#endif